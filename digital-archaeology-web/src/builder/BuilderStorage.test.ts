@@ -0,0 +1,165 @@
+// src/builder/BuilderStorage.test.ts
+// Unit tests for chunked circuit storage
+
+import { describe, it, expect, beforeEach, afterEach, vi } from 'vitest';
+import { webcrypto } from 'node:crypto';
+import { BuilderStorage } from './BuilderStorage';
+import { CIRCUIT_CHUNK_SIZE } from './circuitCodec';
+import { FakeIndexedDB } from '../test-utils/indexeddb-mock';
+import type { BuilderCircuit, ComponentInstance, WireConnection } from './types';
+
+const DB_NAME = 'digital-archaeology-builder';
+
+/**
+ * Build a circuit with `count` relays chained by wires.
+ */
+function makeCircuit(count: number, id = 'circuit-1'): BuilderCircuit {
+  const components: ComponentInstance[] = [];
+  const wires: WireConnection[] = [];
+  for (let i = 0; i < count; i++) {
+    components.push({
+      id: `comp-${i}`,
+      definitionId: 'relay_no',
+      position: { x: i * 20, y: 100 },
+      rotation: 0,
+    });
+    if (i > 0) {
+      wires.push({
+        id: `wire-${i}`,
+        sourceComponent: `comp-${i - 1}`,
+        sourcePort: 'contact_out',
+        targetComponent: `comp-${i}`,
+        targetPort: 'coil_in',
+        waypoints: [],
+      });
+    }
+  }
+  return { id, name: 'Relay chain', era: 'relay', components, wires, inputs: [], outputs: [], createdAt: 1700000000000 };
+}
+
+/**
+ * Create a version 1 database (plain circuits, no chunk store) holding one circuit.
+ */
+function seedVersion1(fakeDb: FakeIndexedDB, circuit: BuilderCircuit): Promise<void> {
+  return new Promise((resolve) => {
+    const request = fakeDb.open(DB_NAME, 1);
+    request.onupgradeneeded = () => {
+      const db = request.result as IDBDatabase;
+      const store = db.createObjectStore('circuits', { keyPath: 'id' });
+      store.createIndex('name', 'name', { unique: false });
+      store.createIndex('modifiedAt', 'modifiedAt', { unique: false });
+      store.createIndex('era', 'era', { unique: false });
+    };
+    request.onsuccess = () => {
+      const transaction = (request.result as IDBDatabase).transaction(['circuits'], 'readwrite');
+      transaction.objectStore('circuits').put(circuit);
+      transaction.oncomplete = () => resolve();
+    };
+  });
+}
+
+describe('BuilderStorage', () => {
+  let fakeDb: FakeIndexedDB;
+  let storage: BuilderStorage;
+
+  /** Stored chunk records of the chunk store, by key */
+  const chunkRecords = () => fakeDb.records(DB_NAME, 'circuitChunks');
+
+  beforeEach(() => {
+    fakeDb = new FakeIndexedDB();
+    vi.stubGlobal('indexedDB', fakeDb);
+    // Use Node's WebCrypto in case the test DOM's crypto lacks subtle
+    vi.stubGlobal('crypto', webcrypto);
+    const items = new Map<string, string>();
+    vi.stubGlobal('localStorage', {
+      getItem: (key: string) => items.get(key) ?? null,
+      setItem: (key: string, value: string) => items.set(key, value),
+      removeItem: (key: string) => items.delete(key),
+    });
+    storage = new BuilderStorage();
+  });
+
+  afterEach(() => {
+    storage.close();
+    vi.unstubAllGlobals();
+  });
+
+  it('should load a circuit saved by version 1 and convert it to chunks on save', async () => {
+    const circuit = makeCircuit(CIRCUIT_CHUNK_SIZE + 1);
+    circuit.modifiedAt = 1700000500000;
+    await seedVersion1(fakeDb, circuit);
+    await storage.initialize();
+
+    expect(await storage.loadCircuit(circuit.id)).toEqual(circuit);
+    expect((await storage.listCircuits())[0].componentCount).toBe(CIRCUIT_CHUNK_SIZE + 1);
+
+    await storage.saveCircuit(circuit);
+
+    const record = fakeDb.records(DB_NAME, 'circuits').get(circuit.id) as Record<string, unknown>;
+    expect(Object.keys(record.chunks as object)).toEqual(['meta', 'c0', 'c1', 'w0']);
+    expect(record.components).toBeUndefined();
+    expect(Array.from(chunkRecords().keys()).sort()).toEqual(
+      ['circuit-1/c0', 'circuit-1/c1', 'circuit-1/meta', 'circuit-1/w0']
+    );
+    expect(await storage.loadCircuit(circuit.id)).toEqual(circuit);
+  });
+
+  it('should rewrite only the chunks that changed', async () => {
+    await storage.initialize();
+    const circuit = makeCircuit(CIRCUIT_CHUNK_SIZE * 3);
+    await storage.saveCircuit(circuit);
+    const before = new Map(chunkRecords());
+
+    circuit.components[CIRCUIT_CHUNK_SIZE + 5].position = { x: 999, y: 999 };
+    await storage.saveCircuit(circuit);
+
+    const rewritten = Array.from(before.keys()).filter((key) => chunkRecords().get(key) !== before.get(key));
+    expect(rewritten).toEqual(['circuit-1/c1']);
+    expect((await storage.loadCircuit(circuit.id))!.components[CIRCUIT_CHUNK_SIZE + 5].position).toEqual({
+      x: 999,
+      y: 999,
+    });
+  });
+
+  it('should rewrite every chunk when no digest is available', async () => {
+    vi.stubGlobal('crypto', {});
+    await storage.initialize();
+    const circuit = makeCircuit(CIRCUIT_CHUNK_SIZE * 2);
+    await storage.saveCircuit(circuit);
+    const before = new Map(chunkRecords());
+
+    await storage.saveCircuit(circuit);
+
+    for (const [key, value] of before) {
+      expect(chunkRecords().get(key)).not.toBe(value);
+    }
+    expect(await storage.loadCircuit(circuit.id)).toEqual(circuit);
+  });
+
+  it('should delete chunks a shrunk circuit no longer has', async () => {
+    await storage.initialize();
+    const circuit = makeCircuit(CIRCUIT_CHUNK_SIZE * 2 + 1);
+    await storage.saveCircuit(circuit);
+    expect(chunkRecords().has('circuit-1/c2')).toBe(true);
+
+    circuit.components = circuit.components.slice(0, 10);
+    circuit.wires = circuit.wires.slice(0, 9);
+    await storage.saveCircuit(circuit);
+
+    expect(Array.from(chunkRecords().keys()).sort()).toEqual(['circuit-1/c0', 'circuit-1/meta', 'circuit-1/w0']);
+    expect((await storage.loadCircuit(circuit.id))!.components).toHaveLength(10);
+  });
+
+  it('should delete a circuit with its chunks and leave other circuits', async () => {
+    await storage.initialize();
+    await storage.saveCircuit(makeCircuit(CIRCUIT_CHUNK_SIZE + 1, 'circuit-1'));
+    await storage.saveCircuit(makeCircuit(3, 'circuit-2'));
+
+    await storage.deleteCircuit('circuit-1');
+
+    expect(await storage.loadCircuit('circuit-1')).toBeNull();
+    expect(Array.from(chunkRecords().keys()).every((key) => String(key).startsWith('circuit-2/'))).toBe(true);
+    expect((await storage.loadCircuit('circuit-2'))!.components).toHaveLength(3);
+    expect(storage.getRecentCircuits()).toEqual(['circuit-2']);
+  });
+});
@@ -3,6 +3,14 @@
 // Uses IndexedDB for circuits and localStorage for progress
 
 import type { BuilderCircuit, UserProgress } from './types';
+import {
+  encodeCircuitChunks,
+  decodeCircuitChunks,
+  hashChunk,
+  compressChunk,
+  decompressChunk,
+} from './circuitCodec';
+import type { CircuitChunk } from './circuitCodec';
 
 /**
  * Storage keys for localStorage.
@@ -17,8 +25,9 @@ const STORAGE_KEYS = {
  * IndexedDB configuration.
  */
 const DB_NAME = 'digital-archaeology-builder';
-const DB_VERSION = 1;
+const DB_VERSION = 2;
 const CIRCUITS_STORE = 'circuits';
+const CIRCUIT_CHUNKS_STORE = 'circuitChunks';
 const USER_GATES_STORE = 'userGates';
 
 /**
@@ -34,6 +43,36 @@ export interface CircuitMetadata {
   wireCount: number;
 }
 
+/**
+ * Stored form of a circuit. The record holds the indexed fields and counts;
+ * the components, wires and ports are binary chunks (see circuitCodec).
+ * Circuits keep their chunks in CIRCUIT_CHUNKS_STORE so that a save only
+ * rewrites the chunks that changed; user gates are small and keep theirs
+ * inline in `data`.
+ */
+interface StoredCircuitRecord {
+  id: string;
+  name: string;
+  era: BuilderCircuit['era'];
+  createdAt?: number;
+  modifiedAt?: number;
+  componentCount: number;
+  wireCount: number;
+  /** Chunk key to SHA-256 of its uncompressed bytes ('' if none was taken) */
+  chunks: Record<string, string>;
+  /** Stored chunk bytes, for records that keep them inline */
+  data?: Record<string, Uint8Array>;
+}
+
+/**
+ * A stored circuit chunk. `key` is `${circuitId}/${chunk key}`.
+ */
+interface StoredChunk {
+  key: string;
+  circuitId: string;
+  data: Uint8Array;
+}
+
 /**
  * Builder settings.
  */
@@ -64,6 +103,8 @@ export class BuilderStorage {
   private dbReady: Promise<void>;
   private resolveDbReady!: () => void;
   private rejectDbReady!: (error: Error) => void;
+  /** Last pending save per circuit ID, so saves of one circuit run in order */
+  private pendingSaves = new Map<string, Promise<void>>();
 
   constructor() {
     this.dbReady = new Promise((resolve, reject) => {
@@ -104,6 +145,13 @@ export class BuilderStorage {
           circuitsStore.createIndex('era', 'era', { unique: false });
         }
 
+        // Create circuit chunks store (v2). Records saved by v1 stay as plain
+        // circuits and are converted when next saved.
+        if (!db.objectStoreNames.contains(CIRCUIT_CHUNKS_STORE)) {
+          const chunksStore = db.createObjectStore(CIRCUIT_CHUNKS_STORE, { keyPath: 'key' });
+          chunksStore.createIndex('circuitId', 'circuitId', { unique: false });
+        }
+
         // Create user gates store
         if (!db.objectStoreNames.contains(USER_GATES_STORE)) {
           const gatesStore = db.createObjectStore(USER_GATES_STORE, { keyPath: 'id' });
@@ -129,24 +177,80 @@ export class BuilderStorage {
   // ============================================================================
 
   /**
-   * Save a circuit.
+   * Save a circuit. Only chunks that differ from the stored ones are
+   * compressed and written.
    */
   async saveCircuit(circuit: BuilderCircuit): Promise<void> {
+    // Ensure modifiedAt is updated
+    circuit.modifiedAt = Date.now();
+    const chunks = encodeCircuitChunks(circuit);
+
+    const previous = this.pendingSaves.get(circuit.id) ?? Promise.resolve();
+    const save = previous.catch(() => undefined).then(() => this.writeCircuitChunks(circuit, chunks));
+    this.pendingSaves.set(circuit.id, save);
+    try {
+      await save;
+    } finally {
+      if (this.pendingSaves.get(circuit.id) === save) {
+        this.pendingSaves.delete(circuit.id);
+      }
+    }
+  }
+
+  /**
+   * Write a circuit record and its changed chunks in one transaction, and
+   * delete chunks the circuit no longer has.
+   */
+  private async writeCircuitChunks(circuit: BuilderCircuit, chunks: CircuitChunk[]): Promise<void> {
     const db = await this.waitForDb();
+    const savedHashes = await this.readChunkHashes(db, circuit.id);
+
+    const hashes: Record<string, string> = {};
+    const changed: CircuitChunk[] = [];
+    const digests = await Promise.all(chunks.map((chunk) => hashChunk(chunk.bytes)));
+    chunks.forEach((chunk, i) => {
+      hashes[chunk.key] = digests[i] ?? '';
+      // Without a digest the chunk cannot be shown unchanged
+      if (!digests[i] || savedHashes?.[chunk.key] !== digests[i]) changed.push(chunk);
+    });
+    const removed = Object.keys(savedHashes ?? {}).filter((key) => !(key in hashes));
+    // Compress before opening the transaction; it would commit while awaiting
+    const stored = await Promise.all(changed.map((chunk) => compressChunk(chunk.bytes)));
 
     return new Promise((resolve, reject) => {
-      const transaction = db.transaction([CIRCUITS_STORE], 'readwrite');
-      const store = transaction.objectStore(CIRCUITS_STORE);
+      const transaction = db.transaction([CIRCUITS_STORE, CIRCUIT_CHUNKS_STORE], 'readwrite');
+      const chunkStore = transaction.objectStore(CIRCUIT_CHUNKS_STORE);
+
+      changed.forEach((chunk, i) => {
+        const record: StoredChunk = { key: `${circuit.id}/${chunk.key}`, circuitId: circuit.id, data: stored[i] };
+        chunkStore.put(record);
+      });
+      for (const key of removed) {
+        chunkStore.delete(`${circuit.id}/${key}`);
+      }
+      transaction.objectStore(CIRCUITS_STORE).put(toStoredRecord(circuit, hashes));
 
-      // Ensure modifiedAt is updated
-      circuit.modifiedAt = Date.now();
+      // A full quota aborts the transaction without a request error
+      transaction.onerror = transaction.onabort = () => reject(new Error('Failed to save circuit'));
+      transaction.oncomplete = () => {
+        this.addToRecentCircuits(circuit.id);
+        resolve();
+      };
+    });
+  }
 
-      const request = store.put(circuit);
+  /**
+   * Read the chunk hashes of a stored circuit.
+   * @returns The hashes, or null if the circuit is not stored in chunks
+   */
+  private readChunkHashes(db: IDBDatabase, id: string): Promise<Record<string, string> | null> {
+    return new Promise((resolve, reject) => {
+      const request = db.transaction([CIRCUITS_STORE], 'readonly').objectStore(CIRCUITS_STORE).get(id);
 
       request.onerror = () => reject(new Error('Failed to save circuit'));
       request.onsuccess = () => {
-        this.addToRecentCircuits(circuit.id);
-        resolve();
+        const record = request.result as StoredCircuitRecord | BuilderCircuit | undefined;
+        resolve(record && isStoredRecord(record) ? record.chunks : null);
       };
     });
   }
@@ -157,17 +261,26 @@ export class BuilderStorage {
   async loadCircuit(id: string): Promise<BuilderCircuit | null> {
     const db = await this.waitForDb();
 
-    return new Promise((resolve, reject) => {
-      const transaction = db.transaction([CIRCUITS_STORE], 'readonly');
-      const store = transaction.objectStore(CIRCUITS_STORE);
-      const request = store.get(id);
+    const [record, storedChunks] = await new Promise<[StoredCircuitRecord | BuilderCircuit | undefined, StoredChunk[]]>(
+      (resolve, reject) => {
+        const transaction = db.transaction([CIRCUITS_STORE, CIRCUIT_CHUNKS_STORE], 'readonly');
+        const recordRequest = transaction.objectStore(CIRCUITS_STORE).get(id);
+        const chunksRequest = transaction.objectStore(CIRCUIT_CHUNKS_STORE).index('circuitId').getAll(id);
 
-      request.onerror = () => reject(new Error('Failed to load circuit'));
-      request.onsuccess = () => {
-        const circuit = request.result as BuilderCircuit | undefined;
-        resolve(circuit ?? null);
-      };
-    });
+        transaction.onerror = () => reject(new Error('Failed to load circuit'));
+        transaction.oncomplete = () => resolve([recordRequest.result, chunksRequest.result as StoredChunk[]]);
+      }
+    );
+
+    if (!record) return null;
+    // Circuits saved before chunked storage are plain objects
+    if (!isStoredRecord(record)) return record;
+
+    const prefix = `${id}/`;
+    return decodeStoredCircuit(
+      record,
+      storedChunks.map((chunk) => ({ key: chunk.key.slice(prefix.length), data: chunk.data }))
+    );
   }
 
   /**
@@ -177,12 +290,19 @@ export class BuilderStorage {
     const db = await this.waitForDb();
 
     return new Promise((resolve, reject) => {
-      const transaction = db.transaction([CIRCUITS_STORE], 'readwrite');
-      const store = transaction.objectStore(CIRCUITS_STORE);
-      const request = store.delete(id);
+      const transaction = db.transaction([CIRCUITS_STORE, CIRCUIT_CHUNKS_STORE], 'readwrite');
+      transaction.objectStore(CIRCUITS_STORE).delete(id);
+
+      const chunkStore = transaction.objectStore(CIRCUIT_CHUNKS_STORE);
+      const keysRequest = chunkStore.index('circuitId').getAllKeys(id);
+      keysRequest.onsuccess = () => {
+        for (const key of keysRequest.result) {
+          chunkStore.delete(key);
+        }
+      };
 
-      request.onerror = () => reject(new Error('Failed to delete circuit'));
-      request.onsuccess = () => {
+      transaction.onerror = () => reject(new Error('Failed to delete circuit'));
+      transaction.oncomplete = () => {
         this.removeFromRecentCircuits(id);
         resolve();
       };
@@ -208,16 +328,7 @@ export class BuilderStorage {
       request.onsuccess = () => {
         const cursor = request.result;
         if (cursor) {
-          const circuit = cursor.value as BuilderCircuit;
-          circuits.push({
-            id: circuit.id,
-            name: circuit.name,
-            era: circuit.era,
-            createdAt: circuit.createdAt ?? 0,
-            modifiedAt: circuit.modifiedAt ?? 0,
-            componentCount: circuit.components.length,
-            wireCount: circuit.wires.length,
-          });
+          circuits.push(toMetadata(cursor.value as StoredCircuitRecord | BuilderCircuit));
           cursor.continue();
         } else {
           resolve(circuits);
@@ -245,10 +356,19 @@ export class BuilderStorage {
   async saveUserGate(circuit: BuilderCircuit): Promise<void> {
     const db = await this.waitForDb();
 
+    const chunks = encodeCircuitChunks(circuit);
+    const hashes: Record<string, string> = {};
+    const data: Record<string, Uint8Array> = {};
+    for (const chunk of chunks) {
+      hashes[chunk.key] = (await hashChunk(chunk.bytes)) ?? '';
+      data[chunk.key] = await compressChunk(chunk.bytes);
+    }
+    const record = { ...toStoredRecord(circuit, hashes), data };
+
     return new Promise((resolve, reject) => {
       const transaction = db.transaction([USER_GATES_STORE], 'readwrite');
       const store = transaction.objectStore(USER_GATES_STORE);
-      const request = store.put(circuit);
+      const request = store.put(record);
 
       request.onerror = () => reject(new Error('Failed to save user gate'));
       request.onsuccess = () => resolve();
@@ -261,17 +381,19 @@ export class BuilderStorage {
   async loadUserGate(id: string): Promise<BuilderCircuit | null> {
     const db = await this.waitForDb();
 
-    return new Promise((resolve, reject) => {
+    const record = await new Promise<StoredCircuitRecord | BuilderCircuit | undefined>((resolve, reject) => {
       const transaction = db.transaction([USER_GATES_STORE], 'readonly');
       const store = transaction.objectStore(USER_GATES_STORE);
       const request = store.get(id);
 
       request.onerror = () => reject(new Error('Failed to load user gate'));
-      request.onsuccess = () => {
-        const gate = request.result as BuilderCircuit | undefined;
-        resolve(gate ?? null);
-      };
+      request.onsuccess = () => resolve(request.result);
     });
+
+    if (!record) return null;
+    if (!isStoredRecord(record)) return record;
+    const data = record.data ?? {};
+    return decodeStoredCircuit(record, Object.keys(data).map((key) => ({ key, data: data[key] })));
   }
 
   /**
@@ -303,16 +425,7 @@ export class BuilderStorage {
 
       request.onerror = () => reject(new Error('Failed to list user gates'));
       request.onsuccess = () => {
-        const gates = (request.result as BuilderCircuit[]).map((circuit) => ({
-          id: circuit.id,
-          name: circuit.name,
-          era: circuit.era,
-          createdAt: circuit.createdAt ?? 0,
-          modifiedAt: circuit.modifiedAt ?? 0,
-          componentCount: circuit.components.length,
-          wireCount: circuit.wires.length,
-        }));
-        resolve(gates);
+        resolve((request.result as (StoredCircuitRecord | BuilderCircuit)[]).map(toMetadata));
       };
     });
   }
@@ -473,10 +586,11 @@ export class BuilderStorage {
 
     await Promise.all([
       new Promise<void>((resolve, reject) => {
-        const transaction = db.transaction([CIRCUITS_STORE], 'readwrite');
-        const request = transaction.objectStore(CIRCUITS_STORE).clear();
-        request.onerror = () => reject(new Error('Failed to clear circuits'));
-        request.onsuccess = () => resolve();
+        const transaction = db.transaction([CIRCUITS_STORE, CIRCUIT_CHUNKS_STORE], 'readwrite');
+        transaction.objectStore(CIRCUITS_STORE).clear();
+        transaction.objectStore(CIRCUIT_CHUNKS_STORE).clear();
+        transaction.onerror = () => reject(new Error('Failed to clear circuits'));
+        transaction.oncomplete = () => resolve();
       }),
       new Promise<void>((resolve, reject) => {
         const transaction = db.transaction([USER_GATES_STORE], 'readwrite');
@@ -487,3 +601,68 @@ export class BuilderStorage {
     ]);
   }
 }
+
+// ============================================================================
+// Stored record helpers
+// ============================================================================
+
+/**
+ * Whether a stored value is a chunked record rather than a plain circuit
+ * saved before chunked storage.
+ */
+function isStoredRecord(value: StoredCircuitRecord | BuilderCircuit): value is StoredCircuitRecord {
+  return 'chunks' in value;
+}
+
+/**
+ * Build the stored record for a circuit with the given chunk hashes.
+ */
+function toStoredRecord(circuit: BuilderCircuit, chunks: Record<string, string>): StoredCircuitRecord {
+  return {
+    id: circuit.id,
+    name: circuit.name,
+    era: circuit.era,
+    createdAt: circuit.createdAt,
+    modifiedAt: circuit.modifiedAt,
+    componentCount: circuit.components.length,
+    wireCount: circuit.wires.length,
+    chunks,
+  };
+}
+
+/**
+ * Get listing metadata from a stored record or plain circuit.
+ */
+function toMetadata(value: StoredCircuitRecord | BuilderCircuit): CircuitMetadata {
+  const stored = isStoredRecord(value);
+  return {
+    id: value.id,
+    name: value.name,
+    era: value.era,
+    createdAt: value.createdAt ?? 0,
+    modifiedAt: value.modifiedAt ?? 0,
+    componentCount: stored ? value.componentCount : value.components.length,
+    wireCount: stored ? value.wireCount : value.wires.length,
+  };
+}
+
+/**
+ * Decompress and decode a stored circuit.
+ * @throws Error if a chunk listed in the record is missing
+ */
+async function decodeStoredCircuit(
+  record: StoredCircuitRecord,
+  stored: { key: string; data: Uint8Array }[]
+): Promise<BuilderCircuit> {
+  const byKey = new Map(stored.map((chunk) => [chunk.key, chunk.data]));
+  const chunks = await Promise.all(
+    Object.keys(record.chunks).map(async (key) => {
+      const data = byKey.get(key);
+      if (!data) {
+        throw new Error(`Corrupt circuit ${record.id}: missing chunk ${key}`);
+      }
+      return { key, bytes: await decompressChunk(data) };
+    })
+  );
+  return decodeCircuitChunks(record, chunks);
+}
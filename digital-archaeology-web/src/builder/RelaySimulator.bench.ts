@@ -0,0 +1,118 @@
+// src/builder/RelaySimulator.bench.ts
+// Benchmarks for RelaySimulator on large relay builds (run: npm run bench)
+
+import { bench, describe } from 'vitest';
+import { RelaySimulator } from './RelaySimulator';
+import type { BuilderCircuit, ComponentInstance, WireConnection } from './types';
+
+const SIZES = [1000, 5000, 10000];
+
+function component(id: string, definitionId: string): ComponentInstance {
+  return { id, definitionId, position: { x: 0, y: 0 }, rotation: 0 };
+}
+
+function wire(id: string, from: string, fromPort: string, to: string, toPort: string): WireConnection {
+  return { id, sourceComponent: from, sourcePort: fromPort, targetComponent: to, targetPort: toPort, waypoints: [] };
+}
+
+/**
+ * One input rippling through a chain of NC relay inverters (about
+ * `components` components): every stage switches on every toggle.
+ */
+function createChain(components: number): BuilderCircuit {
+  const circuit: BuilderCircuit = {
+    id: 'chain',
+    name: 'Inverter Chain',
+    era: 'relay',
+    components: [component('in', 'input'), component('vcc', 'power'), component('gnd', 'ground'), component('out', 'output')],
+    wires: [],
+    inputs: [{ id: 'in', name: 'A', direction: 'input', componentId: 'in' }],
+    outputs: [{ id: 'out', name: 'Q', direction: 'output', componentId: 'out' }],
+  };
+  let previous = ['in', 'out'];
+  for (let i = 0; circuit.components.length < components; i++) {
+    const id = `r${i}`;
+    circuit.components.push(component(id, 'relay_nc'));
+    circuit.wires.push(
+      wire(`${id}c`, previous[0], previous[1], id, 'coil_in'),
+      wire(`${id}g`, id, 'coil_out', 'gnd', 'in'),
+      wire(`${id}p`, 'vcc', 'out', id, 'contact_in')
+    );
+    previous = [id, 'contact_out'];
+  }
+  circuit.wires.push(wire('wq', previous[0], previous[1], 'out', 'in'));
+  return circuit;
+}
+
+/**
+ * Independent two-relay AND gates sharing one supply (about `components`
+ * components): a toggle touches one gate out of many.
+ */
+function createGateArray(components: number): BuilderCircuit {
+  const circuit: BuilderCircuit = {
+    id: 'array',
+    name: 'AND Array',
+    era: 'relay',
+    components: [component('vcc', 'power'), component('gnd', 'ground')],
+    wires: [],
+    inputs: [],
+    outputs: [],
+  };
+  for (let g = 0; circuit.components.length < components; g++) {
+    const [a, b, r1, r2, q] = ['a', 'b', 'r1', 'r2', 'q'].map((n) => `g${g}${n}`);
+    circuit.components.push(
+      component(a, 'input'), component(b, 'input'),
+      component(r1, 'relay_no'), component(r2, 'relay_no'), component(q, 'output')
+    );
+    circuit.wires.push(
+      wire(`${a}w`, a, 'out', r1, 'coil_in'),
+      wire(`${b}w`, b, 'out', r2, 'coil_in'),
+      wire(`${r1}g`, r1, 'coil_out', 'gnd', 'in'),
+      wire(`${r2}g`, r2, 'coil_out', 'gnd', 'in'),
+      wire(`${r1}p`, 'vcc', 'out', r1, 'contact_in'),
+      wire(`${r1}s`, r1, 'contact_out', r2, 'contact_in'),
+      wire(`${q}w`, r2, 'contact_out', q, 'in')
+    );
+    circuit.inputs.push(
+      { id: a, name: a, direction: 'input', componentId: a },
+      { id: b, name: b, direction: 'input', componentId: b }
+    );
+    circuit.outputs.push({ id: q, name: q, direction: 'output', componentId: q });
+  }
+  return circuit;
+}
+
+for (const size of SIZES) {
+  describe(`RelaySimulator, ${size} components`, () => {
+    const chain = createChain(size);
+    const array = createGateArray(size);
+
+    bench('load (build nets)', () => {
+      new RelaySimulator().loadCircuit(array);
+    });
+
+    bench('load and first step', () => {
+      const simulator = new RelaySimulator();
+      simulator.loadCircuit(array);
+      simulator.step();
+    });
+
+    const rippling = new RelaySimulator();
+    rippling.loadCircuit(chain);
+    rippling.step();
+    bench('toggle input, ripple through every relay', () => {
+      rippling.toggleInput('in');
+      rippling.step();
+    });
+
+    const gates = new RelaySimulator();
+    gates.loadCircuit(array);
+    gates.step();
+    let next = 0;
+    bench('toggle one input among many', () => {
+      gates.toggleInput(array.inputs[next].id);
+      next = (next + 1) % array.inputs.length;
+      gates.step();
+    });
+  });
+}
@@ -77,6 +77,40 @@ describe('RelaySimulator', () => {
     };
   }
 
+  /**
+   * Helper to create a chain of NC relay inverters: each stage's contact
+   * output drives the next stage's coil.
+   */
+  function createInverterChain(stages: number): BuilderCircuit {
+    const circuit: BuilderCircuit = {
+      id: 'chain',
+      name: 'Inverter Chain',
+      era: 'relay',
+      components: [
+        { id: 'input1', definitionId: 'input', position: { x: 0, y: 0 }, rotation: 0 },
+        { id: 'power1', definitionId: 'power', position: { x: 0, y: 100 }, rotation: 0 },
+        { id: 'ground1', definitionId: 'ground', position: { x: 0, y: 200 }, rotation: 0 },
+        { id: 'output1', definitionId: 'output', position: { x: 0, y: 300 }, rotation: 0 },
+      ],
+      wires: [],
+      inputs: [{ id: 'input1', name: 'A', direction: 'input', componentId: 'input1' }],
+      outputs: [{ id: 'output1', name: 'Q', direction: 'output', componentId: 'output1' }],
+    };
+    let previous = { component: 'input1', port: 'out' };
+    for (let i = 0; i < stages; i++) {
+      const id = `relay${i}`;
+      circuit.components.push({ id, definitionId: 'relay_nc', position: { x: i * 100, y: 0 }, rotation: 0 });
+      circuit.wires.push(
+        { id: `${id}_c`, sourceComponent: previous.component, sourcePort: previous.port, targetComponent: id, targetPort: 'coil_in', waypoints: [] },
+        { id: `${id}_g`, sourceComponent: id, sourcePort: 'coil_out', targetComponent: 'ground1', targetPort: 'in', waypoints: [] },
+        { id: `${id}_p`, sourceComponent: 'power1', sourcePort: 'out', targetComponent: id, targetPort: 'contact_in', waypoints: [] }
+      );
+      previous = { component: id, port: 'contact_out' };
+    }
+    circuit.wires.push({ id: 'w_out', sourceComponent: previous.component, sourcePort: previous.port, targetComponent: 'output1', targetPort: 'in', waypoints: [] });
+    return circuit;
+  }
+
   describe('loadCircuit', () => {
     it('loads a circuit for simulation', () => {
       const circuit = createNOTCircuit();
@@ -272,6 +306,96 @@ describe('RelaySimulator', () => {
     });
   });
 
+  describe('net building', () => {
+    it('merges two existing nets when a wire joins them', () => {
+      const circuit = createNOTCircuit();
+      // A second power source and output on separate wires, then a wire between them
+      circuit.components.push(
+        { id: 'power2', definitionId: 'power', position: { x: 0, y: 200 }, rotation: 0 },
+        { id: 'output2', definitionId: 'output', position: { x: 200, y: 200 }, rotation: 0 },
+        { id: 'output3', definitionId: 'output', position: { x: 200, y: 300 }, rotation: 0 }
+      );
+      circuit.wires.push(
+        { id: 'w5', sourceComponent: 'power2', sourcePort: 'out', targetComponent: 'output2', targetPort: 'in', waypoints: [] },
+        { id: 'w6', sourceComponent: 'output3', sourcePort: 'in', targetComponent: 'relay1', targetPort: 'coil_out', waypoints: [] },
+        { id: 'w7', sourceComponent: 'output2', sourcePort: 'in', targetComponent: 'output3', targetPort: 'in', waypoints: [] }
+      );
+      circuit.outputs.push({ id: 'output3', name: 'R', direction: 'output', componentId: 'output3' });
+      simulator.loadCircuit(circuit);
+
+      const result = simulator.step();
+      expect(simulator.getOutput('output3')).toBe(1);
+      expect(result.wireSignals.get('w2')).toBe(1);
+    });
+
+    it('reports unwired ports as unknown', () => {
+      simulator.loadCircuit(createNOTCircuit());
+      simulator.step();
+      expect(simulator.getComponentState('power1')?.portValues.get('out')).toBe(1);
+      expect(simulator.getComponentState('ground1')?.portValues.get('in')).toBe(0);
+
+      const circuit = createNOTCircuit();
+      circuit.wires = circuit.wires.filter((w) => w.id !== 'w4');
+      simulator.loadCircuit(circuit);
+      simulator.step();
+      expect(simulator.getOutput('output1')).toBe(2);
+    });
+  });
+
+  describe('event-driven propagation', () => {
+    it('settles a long inverter chain', () => {
+      simulator.loadCircuit(createInverterChain(2001));
+
+      // An odd number of inverters inverts
+      simulator.setInput('input1', 0);
+      let result = simulator.step();
+      expect(result.converged).toBe(true);
+      expect(simulator.getOutput('output1')).toBe(1);
+
+      simulator.setInput('input1', 1);
+      result = simulator.step();
+      expect(result.converged).toBe(true);
+      expect(simulator.getOutput('output1')).toBe(0);
+    });
+
+    it('re-evaluates only relays whose coil net changed', () => {
+      simulator.loadCircuit(createInverterChain(100));
+      simulator.step();
+
+      // Nothing changed: no relay is evaluated
+      expect(simulator.step().evaluations).toBe(0);
+
+      // The ripple reaches every stage once
+      simulator.setInput('input1', 1);
+      expect(simulator.step().evaluations).toBe(100);
+    });
+
+    it('reports an oscillating relay as not converged', () => {
+      // Buzzer: an NC relay whose contact output feeds its own coil
+      const circuit = createNOTCircuit();
+      circuit.wires = circuit.wires.filter((w) => w.id !== 'w1' && w.id !== 'w4');
+      circuit.wires.push({ id: 'w5', sourceComponent: 'relay1', sourcePort: 'contact_out', targetComponent: 'relay1', targetPort: 'coil_in', waypoints: [] });
+      simulator.loadCircuit(circuit);
+
+      const result = simulator.step();
+      expect(result.converged).toBe(false);
+      expect(result.error).toBe('Simulation did not converge');
+    });
+
+    it('matches the truth table after many input changes', () => {
+      simulator.loadCircuit(createANDCircuit());
+      const rows: Array<[SignalValue, SignalValue, SignalValue]> = [
+        [1, 1, 1], [0, 1, 0], [1, 1, 1], [1, 0, 0], [0, 0, 0], [1, 1, 1],
+      ];
+      for (const [a, b, q] of rows) {
+        simulator.setInput('inputA', a);
+        simulator.setInput('inputB', b);
+        simulator.step();
+        expect(simulator.getOutput('output1')).toBe(q);
+      }
+    });
+  });
+
   describe('getComponentState', () => {
     it('returns relay coil state', () => {
       const circuit = createNOTCircuit();
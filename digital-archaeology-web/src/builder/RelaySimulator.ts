@@ -12,7 +12,8 @@ import type {
 import { getComponentDefinition } from './ComponentDefinitions';
 
 /**
- * Maximum simulation iterations to prevent infinite loops.
+ * Maximum relay-switching waves per step, on top of one wave per relay
+ * (an acyclic chain of N relays needs N waves to settle).
  */
 const MAX_ITERATIONS = 1000;
 
@@ -24,6 +25,8 @@ export interface SimulationResult {
   converged: boolean;
   /** Number of iterations to converge */
   iterations: number;
+  /** Relays re-evaluated during this step */
+  evaluations: number;
   /** Updated component states */
   componentStates: Map<string, ComponentState>;
   /** Wire signal values */
@@ -33,28 +36,76 @@ export interface SimulationResult {
 }
 
 /**
- * Network node for signal propagation.
- * Represents a set of connected ports that share the same signal.
+ * Disjoint-set forest over integer port IDs (union by size, path halving).
  */
-interface NetNode {
-  /** Components and ports in this net */
-  connections: Array<{ componentId: string; portId: string }>;
-  /** Current signal value */
-  signal: SignalValue;
-  /** Whether this net is driven by a source */
-  hasDrive: boolean;
+class UnionFind {
+  private parent: Int32Array;
+  private size: Int32Array;
+
+  constructor(count: number) {
+    this.parent = new Int32Array(count);
+    this.size = new Int32Array(count).fill(1);
+    for (let i = 0; i < count; i++) this.parent[i] = i;
+  }
+
+  find(x: number): number {
+    const parent = this.parent;
+    while (parent[x] !== x) {
+      parent[x] = parent[parent[x]];
+      x = parent[x];
+    }
+    return x;
+  }
+
+  union(a: number, b: number): void {
+    let ra = this.find(a);
+    let rb = this.find(b);
+    if (ra === rb) return;
+    if (this.size[ra] < this.size[rb]) [ra, rb] = [rb, ra];
+    this.parent[rb] = ra;
+    this.size[ra] += this.size[rb];
+  }
+}
+
+/**
+ * Compressed adjacency: items of key k are items[start[k] .. start[k + 1]).
+ */
+interface Csr {
+  start: Int32Array;
+  items: Int32Array;
+}
+
+function buildCsr(keyCount: number, keys: ArrayLike<number>, values: ArrayLike<number>): Csr {
+  const start = new Int32Array(keyCount + 1);
+  for (let i = 0; i < keys.length; i++) {
+    if (keys[i] >= 0) start[keys[i] + 1]++;
+  }
+  for (let k = 0; k < keyCount; k++) start[k + 1] += start[k];
+  const fill = start.slice(0, keyCount);
+  const items = new Int32Array(start[keyCount]);
+  for (let i = 0; i < keys.length; i++) {
+    if (keys[i] >= 0) items[fill[keys[i]]++] = values[i];
+  }
+  return { start, items };
 }
 
 /**
  * RelaySimulator performs circuit simulation.
- * Uses event-driven simulation with signal propagation.
+ *
+ * Event-driven over integer IDs:
+ * - Every component port gets an integer ID; wires union ports into nets
+ *   (union-find), so building nets is near-linear in the wire count
+ * - Net levels, relay coil and switch states live in typed arrays
+ * - A net is HIGH when a closed path of relay contacts links it to a
+ *   power source or a HIGH input, otherwise LOW
+ * - Only relays whose coil net changed are re-evaluated; a closing switch
+ *   floods HIGH across it, an opening switch or falling input recomputes
+ *   just the region of nets still connected to it
  */
 export class RelaySimulator {
   private circuit: BuilderCircuit | null = null;
   private componentStates: Map<string, ComponentState> = new Map();
   private inputValues: Map<string, SignalValue> = new Map();
-  private nets: Map<string, NetNode> = new Map();
-  private wireToNet: Map<string, string> = new Map();
   private simulationState: SimulationState = {
     isRunning: false,
     speed: 1,
@@ -62,6 +113,47 @@ export class RelaySimulator {
     inputValues: new Map(),
   };
 
+  /** Per port ID: owning component index (-1 if not a defined port), port name, net */
+  private portComponent: Int32Array = new Int32Array(0);
+  private portName: string[] = [];
+  private portNet: Int32Array = new Int32Array(0);
+  private portConnected: Uint8Array = new Uint8Array(0);
+  private wireNet: Int32Array = new Int32Array(0);
+
+  /** Per net: level, directly attached HIGH sources, and indexes */
+  private netCount = 0;
+  private netHigh: Uint8Array = new Uint8Array(0);
+  private netSources: Int32Array = new Int32Array(0);
+  private netPorts: Csr = { start: new Int32Array(1), items: new Int32Array(0) };
+  private netContacts: Csr = { start: new Int32Array(1), items: new Int32Array(0) };
+  private netCoils: Csr = { start: new Int32Array(1), items: new Int32Array(0) };
+
+  /** Per relay */
+  private relayComponent: Int32Array = new Int32Array(0);
+  private relayCoil: Int32Array = new Int32Array(0);
+  private relayA: Int32Array = new Int32Array(0);
+  private relayB: Int32Array = new Int32Array(0);
+  private relayNC: Uint8Array = new Uint8Array(0);
+  private relayEnergized: Uint8Array = new Uint8Array(0);
+  private relayClosed: Uint8Array = new Uint8Array(0);
+
+  /** Per input component: its net and the level last applied */
+  private inputIds: string[] = [];
+  private inputNet: Int32Array = new Int32Array(0);
+  private inputApplied: Uint8Array = new Uint8Array(0);
+
+  private outputComponent: Map<string, string> = new Map();
+  private needsFullSolve = true;
+
+  /** Event queue and scratch */
+  private queue: number[] = [];
+  private relayQueued: Uint8Array = new Uint8Array(0);
+  private dirtyNets: number[] = [];
+  private netDirty: Uint8Array = new Uint8Array(0);
+  private netMark: Int32Array = new Int32Array(0);
+  private markEpoch = 0;
+  private evaluations = 0;
+
   /**
    * Load a circuit for simulation.
    * @param circuit The circuit to simulate
@@ -70,8 +162,6 @@ export class RelaySimulator {
     this.circuit = circuit;
     this.componentStates.clear();
     this.inputValues.clear();
-    this.nets.clear();
-    this.wireToNet.clear();
     this.simulationState.cycle = 0;
 
     // Initialize component states
@@ -101,60 +191,154 @@ export class RelaySimulator {
   }
 
   /**
-   * Build the net list by grouping connected ports.
+   * Number IDs for every component port, union the ports each wire joins,
+   * and index nets, relays and sources by integer ID.
    */
   private buildNetList(): void {
     if (!this.circuit) return;
+    const { components, wires } = this.circuit;
+
+    // Port IDs: each component's defined ports, in definition order
+    const componentIndex = new Map<string, number>();
+    const portBase = new Int32Array(components.length);
+    const definitions = components.map((c) => getComponentDefinition(c.definitionId));
+    let portCount = 0;
+    for (let i = 0; i < components.length; i++) {
+      componentIndex.set(components[i].id, i);
+      portBase[i] = portCount;
+      portCount += definitions[i]?.ports.length ?? 0;
+    }
+    const portComponent: number[] = new Array(portCount);
+    const portName: string[] = new Array(portCount);
+    for (let i = 0; i < components.length; i++) {
+      const ports = definitions[i]?.ports ?? [];
+      for (let p = 0; p < ports.length; p++) {
+        portComponent[portBase[i] + p] = i;
+        portName[portBase[i] + p] = ports[p].id;
+      }
+    }
 
-    this.nets.clear();
-    this.wireToNet.clear();
-
-    let netCounter = 0;
-
-    // Each wire potentially creates or joins nets
-    for (const wire of this.circuit.wires) {
-      const sourceKey = `${wire.sourceComponent}:${wire.sourcePort}`;
-      const targetKey = `${wire.targetComponent}:${wire.targetPort}`;
-
-      // Check if either endpoint already has a net
-      let existingNetId: string | undefined;
-      for (const [netId, net] of this.nets) {
-        if (
-          net.connections.some(
-            (c) =>
-              `${c.componentId}:${c.portId}` === sourceKey ||
-              `${c.componentId}:${c.portId}` === targetKey
-          )
-        ) {
-          existingNetId = netId;
-          break;
-        }
+    // Ports a wire names but no definition has get IDs of their own
+    const extraPorts = new Map<string, number>();
+    const resolvePort = (componentId: string, portId: string): number => {
+      const index = componentIndex.get(componentId);
+      if (index !== undefined) {
+        const p = definitions[index]?.ports.findIndex((port) => port.id === portId) ?? -1;
+        if (p >= 0) return portBase[index] + p;
+      }
+      const key = `${componentId}:${portId}`;
+      let id = extraPorts.get(key);
+      if (id === undefined) {
+        id = portComponent.length;
+        extraPorts.set(key, id);
+        portComponent.push(-1);
+        portName.push(portId);
       }
+      return id;
+    };
 
-      if (existingNetId) {
-        // Add to existing net
-        const net = this.nets.get(existingNetId)!;
-        if (!net.connections.some((c) => `${c.componentId}:${c.portId}` === sourceKey)) {
-          net.connections.push({ componentId: wire.sourceComponent, portId: wire.sourcePort });
-        }
-        if (!net.connections.some((c) => `${c.componentId}:${c.portId}` === targetKey)) {
-          net.connections.push({ componentId: wire.targetComponent, portId: wire.targetPort });
-        }
-        this.wireToNet.set(wire.id, existingNetId);
-      } else {
-        // Create new net
-        const netId = `net_${netCounter++}`;
-        this.nets.set(netId, {
-          connections: [
-            { componentId: wire.sourceComponent, portId: wire.sourcePort },
-            { componentId: wire.targetComponent, portId: wire.targetPort },
-          ],
-          signal: 2, // Unknown
-          hasDrive: false,
-        });
-        this.wireToNet.set(wire.id, netId);
+    const wireEnds = new Int32Array(wires.length * 2);
+    for (let w = 0; w < wires.length; w++) {
+      wireEnds[2 * w] = resolvePort(wires[w].sourceComponent, wires[w].sourcePort);
+      wireEnds[2 * w + 1] = resolvePort(wires[w].targetComponent, wires[w].targetPort);
+    }
+
+    const totalPorts = portComponent.length;
+    const sets = new UnionFind(totalPorts);
+    this.portConnected = new Uint8Array(totalPorts);
+    for (let w = 0; w < wires.length; w++) {
+      sets.union(wireEnds[2 * w], wireEnds[2 * w + 1]);
+      this.portConnected[wireEnds[2 * w]] = 1;
+      this.portConnected[wireEnds[2 * w + 1]] = 1;
+    }
+
+    // Dense net IDs from set roots
+    const rootNet = new Int32Array(totalPorts).fill(-1);
+    this.portNet = new Int32Array(totalPorts);
+    let netCount = 0;
+    for (let p = 0; p < totalPorts; p++) {
+      const root = sets.find(p);
+      if (rootNet[root] < 0) rootNet[root] = netCount++;
+      this.portNet[p] = rootNet[root];
+    }
+    this.netCount = netCount;
+    this.portComponent = Int32Array.from(portComponent);
+    this.portName = portName;
+    this.wireNet = new Int32Array(wires.length);
+    for (let w = 0; w < wires.length; w++) {
+      this.wireNet[w] = this.portNet[wireEnds[2 * w]];
+    }
+
+    const ports = new Int32Array(totalPorts);
+    for (let p = 0; p < totalPorts; p++) ports[p] = p;
+    this.netPorts = buildCsr(netCount, this.portNet, ports);
+
+    // Relays, sources and inputs
+    const netOf = (index: number, portId: string): number => {
+      const p = definitions[index]?.ports.findIndex((port) => port.id === portId) ?? -1;
+      return p >= 0 ? this.portNet[portBase[index] + p] : -1;
+    };
+    const relays: number[] = [];
+    const inputs: number[] = [];
+    this.netSources = new Int32Array(netCount);
+    for (let i = 0; i < components.length; i++) {
+      const type = definitions[i]?.type;
+      if (type === 'relay_no' || type === 'relay_nc') {
+        relays.push(i);
+      } else if (type === 'power') {
+        const net = netOf(i, 'out');
+        if (net >= 0) this.netSources[net]++;
+      } else if (type === 'input') {
+        inputs.push(i);
       }
     }
+
+    const relayCount = relays.length;
+    this.relayComponent = Int32Array.from(relays);
+    this.relayCoil = new Int32Array(relayCount);
+    this.relayA = new Int32Array(relayCount);
+    this.relayB = new Int32Array(relayCount);
+    this.relayNC = new Uint8Array(relayCount);
+    this.relayEnergized = new Uint8Array(relayCount);
+    this.relayClosed = new Uint8Array(relayCount);
+    for (let r = 0; r < relayCount; r++) {
+      const i = relays[r];
+      this.relayCoil[r] = netOf(i, 'coil_in');
+      this.relayA[r] = netOf(i, 'contact_in');
+      this.relayB[r] = netOf(i, 'contact_out');
+      this.relayNC[r] = definitions[i]?.type === 'relay_nc' ? 1 : 0;
+      this.relayClosed[r] = this.relayNC[r];
+    }
+
+    // Net -> relays touching it through contacts, and through coils
+    const contactKeys = new Int32Array(relayCount * 2);
+    const contactRelays = new Int32Array(relayCount * 2);
+    for (let r = 0; r < relayCount; r++) {
+      const sameNet = this.relayA[r] === this.relayB[r];
+      contactKeys[2 * r] = sameNet ? -1 : this.relayA[r];
+      contactKeys[2 * r + 1] = sameNet ? -1 : this.relayB[r];
+      contactRelays[2 * r] = r;
+      contactRelays[2 * r + 1] = r;
+    }
+    this.netContacts = buildCsr(netCount, contactKeys, contactRelays);
+    const relayIds = new Int32Array(relayCount);
+    for (let r = 0; r < relayCount; r++) relayIds[r] = r;
+    this.netCoils = buildCsr(netCount, this.relayCoil, relayIds);
+
+    this.inputIds = inputs.map((i) => components[i].id);
+    this.inputNet = Int32Array.from(inputs.map((i) => netOf(i, 'out')));
+    this.inputApplied = new Uint8Array(inputs.length);
+
+    this.outputComponent = new Map(this.circuit.outputs.map((o) => [o.id, o.componentId]));
+
+    this.netHigh = new Uint8Array(netCount);
+    this.netDirty = new Uint8Array(netCount);
+    this.netMark = new Int32Array(netCount);
+    this.markEpoch = 0;
+    this.relayQueued = new Uint8Array(relayCount);
+    this.queue = [];
+    this.dirtyNets = [];
+    this.needsFullSolve = true;
   }
 
   /**
@@ -193,266 +377,246 @@ export class RelaySimulator {
   getOutput(outputId: string): SignalValue {
     if (!this.circuit) return 2;
 
-    const output = this.circuit.outputs.find((o) => o.id === outputId);
-    if (!output) return 2;
+    const componentId = this.outputComponent.get(outputId);
+    if (componentId === undefined) return 2;
 
-    const state = this.componentStates.get(output.componentId);
+    const state = this.componentStates.get(componentId);
     return state?.portValues.get('in') ?? 2;
   }
 
   /**
    * Run one simulation step.
-   * Propagates signals until stable or max iterations reached.
+   * Applies input changes, then processes relay events until no coil
+   * changes or the iteration limit is reached.
    */
   step(): SimulationResult {
     if (!this.circuit) {
       return {
         converged: false,
         iterations: 0,
+        evaluations: 0,
         componentStates: new Map(),
         wireSignals: new Map(),
         error: 'No circuit loaded',
       };
     }
 
-    let iterations = 0;
-    let changed = true;
-
-    // Reset net signals
-    for (const net of this.nets.values()) {
-      net.signal = 2;
-      net.hasDrive = false;
-    }
+    this.evaluations = 0;
+    this.applyInputs();
 
-    while (changed && iterations < MAX_ITERATIONS) {
-      changed = false;
+    const limit = MAX_ITERATIONS + this.relayComponent.length;
+    let iterations = 0;
+    while (this.queue.length > 0 && iterations < limit) {
       iterations++;
-
-      // Phase 1: Update net signals from sources
-      changed = this.updateNetSignals() || changed;
-
-      // Phase 2: Update relay coil states
-      changed = this.updateRelayCoils() || changed;
-
-      // Phase 3: Update relay switch states
-      changed = this.updateRelaySwitches() || changed;
-
-      // Phase 4: Propagate signals through closed switches
-      changed = this.propagateSignals() || changed;
-
-      // Phase 5: Update component port values
-      this.updatePortValues();
+      this.processWave();
     }
+    const converged = this.queue.length === 0;
 
-    // Set undriven nets to LOW (0) instead of unknown (2)
-    // In digital circuits, an undriven wire is typically pulled to ground
-    for (const net of this.nets.values()) {
-      if (!net.hasDrive) {
-        net.signal = 0;
-      }
-    }
-
-    // Update port values again after setting undriven nets to LOW
     this.updatePortValues();
-
     this.simulationState.cycle++;
 
     // Build wire signals map
     const wireSignals = new Map<string, SignalValue>();
-    for (const wire of this.circuit.wires) {
-      const netId = this.wireToNet.get(wire.id);
-      if (netId) {
-        const net = this.nets.get(netId);
-        wireSignals.set(wire.id, net?.signal ?? 2);
-      }
+    const wires = this.circuit.wires;
+    for (let w = 0; w < wires.length; w++) {
+      wireSignals.set(wires[w].id, this.netHigh[this.wireNet[w]] as SignalValue);
     }
 
     return {
-      converged: iterations < MAX_ITERATIONS,
-      iterations,
+      converged,
+      iterations: Math.max(iterations, 1),
+      evaluations: this.evaluations,
       componentStates: new Map(this.componentStates),
       wireSignals,
-      error: iterations >= MAX_ITERATIONS ? 'Simulation did not converge' : undefined,
+      error: converged ? undefined : 'Simulation did not converge',
     };
   }
 
   /**
-   * Update net signals from power sources and inputs.
+   * Move input levels into the net source counts. The first step after
+   * loading solves every net and queues every relay.
    */
-  private updateNetSignals(): boolean {
-    if (!this.circuit) return false;
-
-    let changed = false;
-
-    for (const component of this.circuit.components) {
-      const def = getComponentDefinition(component.definitionId);
-      if (!def) continue;
-
-      // Power source always drives high
-      if (def.type === 'power') {
-        changed = this.driveNet(component.id, 'out', 1) || changed;
+  private applyInputs(): void {
+    const rising: number[] = [];
+    const falling: number[] = [];
+    for (let i = 0; i < this.inputIds.length; i++) {
+      const level = this.inputValues.get(this.inputIds[i]) === 1 ? 1 : 0;
+      const net = this.inputNet[i];
+      if (level === this.inputApplied[i] || net < 0) continue;
+      this.inputApplied[i] = level;
+      if (level) {
+        if (this.netSources[net]++ === 0) rising.push(net);
+      } else if (--this.netSources[net] === 0) {
+        falling.push(net);
       }
+    }
 
-      // Input components drive based on input value
-      if (def.type === 'input') {
-        const inputValue = this.inputValues.get(component.id) ?? 0;
-        changed = this.driveNet(component.id, 'out', inputValue) || changed;
+    if (this.needsFullSolve) {
+      this.needsFullSolve = false;
+      const all: number[] = [];
+      for (let n = 0; n < this.netCount; n++) {
+        this.netHigh[n] = 0;
+        this.markDirty(n);
+        if (this.netSources[n] > 0) all.push(n);
       }
+      this.flood(all);
+      for (let r = 0; r < this.relayComponent.length; r++) this.enqueue(r);
+      return;
     }
 
-    return changed;
+    if (rising.length > 0) this.flood(rising);
+    if (falling.length > 0) this.recomputeRegion(falling);
   }
 
   /**
-   * Drive a net from a component port.
+   * Re-evaluate the queued relays; switch changes queue the next wave.
    */
-  private driveNet(componentId: string, portId: string, value: SignalValue): boolean {
-    const portKey = `${componentId}:${portId}`;
-
-    for (const [, net] of this.nets) {
-      if (net.connections.some((c) => `${c.componentId}:${c.portId}` === portKey)) {
-        if (net.signal !== value || !net.hasDrive) {
-          net.signal = value;
-          net.hasDrive = true;
-          return true;
+  private processWave(): void {
+    const wave = this.queue;
+    this.queue = [];
+    const opened: number[] = [];
+
+    for (const r of wave) {
+      this.relayQueued[r] = 0;
+      this.evaluations++;
+      const coil = this.relayCoil[r];
+      const energized = coil >= 0 && this.netHigh[coil] === 1 ? 1 : 0;
+      const closed = this.relayNC[r] ? 1 - energized : energized;
+      this.relayEnergized[r] = energized;
+      if (closed === this.relayClosed[r]) continue;
+
+      this.relayClosed[r] = closed;
+      const a = this.relayA[r];
+      const b = this.relayB[r];
+      if (a < 0 || b < 0 || a === b) continue;
+      if (closed) {
+        if (this.netHigh[a] !== this.netHigh[b]) {
+          this.flood([this.netHigh[a] ? b : a]);
         }
+      } else {
+        opened.push(a, b);
       }
     }
 
-    return false;
-  }
-
-  /**
-   * Get the signal on a port.
-   */
-  private getPortSignal(componentId: string, portId: string): SignalValue {
-    const portKey = `${componentId}:${portId}`;
+    // Nets fed only through a contact that opened may have lost their source
+    if (opened.length > 0) this.recomputeRegion(opened);
 
-    for (const [, net] of this.nets) {
-      if (net.connections.some((c) => `${c.componentId}:${c.portId}` === portKey)) {
-        return net.signal;
-      }
+    for (const r of wave) {
+      const state = this.componentStates.get(this.circuit!.components[this.relayComponent[r]].id)!;
+      state.coilEnergized = this.relayEnergized[r] === 1;
+      state.switchClosed = this.relayClosed[r] === 1;
     }
-
-    return 2; // Unknown if not connected
   }
 
   /**
-   * Update relay coil states based on input signals.
+   * Drive HIGH from the given nets across closed contacts.
    */
-  private updateRelayCoils(): boolean {
-    if (!this.circuit) return false;
-
-    let changed = false;
-
-    for (const component of this.circuit.components) {
-      const def = getComponentDefinition(component.definitionId);
-      if (!def) continue;
-
-      // Check if this is a relay
-      if (def.type !== 'relay_no' && def.type !== 'relay_nc') continue;
-
-      const state = this.componentStates.get(component.id)!;
-
-      // Get coil input signal
-      const coilInSignal = this.getPortSignal(component.id, 'coil_in');
-      // Note: coil_out should be connected to ground for a complete circuit
-      // For simplicity, we check if coil_in is high to determine if coil is energized
-      const shouldBeEnergized = coilInSignal === 1;
-
-      if (state.coilEnergized !== shouldBeEnergized) {
-        state.coilEnergized = shouldBeEnergized;
-        changed = true;
+  private flood(seeds: number[]): void {
+    const stack: number[] = [];
+    for (const n of seeds) {
+      if (!this.netHigh[n]) this.setLevel(n, 1);
+      stack.push(n);
+    }
+    const { start, items } = this.netContacts;
+    while (stack.length > 0) {
+      const n = stack.pop()!;
+      for (let k = start[n]; k < start[n + 1]; k++) {
+        const r = items[k];
+        if (!this.relayClosed[r]) continue;
+        const other = this.relayA[r] === n ? this.relayB[r] : this.relayA[r];
+        if (!this.netHigh[other]) {
+          this.setLevel(other, 1);
+          stack.push(other);
+        }
       }
     }
-
-    return changed;
   }
 
   /**
-   * Update relay switch states based on coil states.
+   * Recompute levels after contacts opened or sources fell. Levels are
+   * uniform across nets joined by closed contacts, so a seed's region
+   * keeps its level as soon as a source is found in it; only a region
+   * left without a source is walked in full and driven LOW.
    */
-  private updateRelaySwitches(): boolean {
-    if (!this.circuit) return false;
-
-    let changed = false;
-
-    for (const component of this.circuit.components) {
-      const def = getComponentDefinition(component.definitionId);
-      if (!def) continue;
-
-      const state = this.componentStates.get(component.id)!;
-
-      if (def.type === 'relay_no') {
-        // Normally Open: closes when energized
-        const shouldBeClosed = state.coilEnergized === true;
-        if (state.switchClosed !== shouldBeClosed) {
-          state.switchClosed = shouldBeClosed;
-          changed = true;
+  private recomputeRegion(seeds: number[]): void {
+    const epoch = ++this.markEpoch;
+    const { start, items } = this.netContacts;
+    const region: number[] = [];
+
+    for (const seed of seeds) {
+      if (this.netMark[seed] === epoch) continue;
+      this.netMark[seed] = epoch;
+      region.length = 0;
+      region.push(seed);
+      let powered = false;
+      for (let i = 0; i < region.length && !powered; i++) {
+        const n = region[i];
+        if (this.netSources[n] > 0) {
+          powered = true;
+          break;
         }
-      } else if (def.type === 'relay_nc') {
-        // Normally Closed: opens when energized
-        const shouldBeClosed = state.coilEnergized !== true;
-        if (state.switchClosed !== shouldBeClosed) {
-          state.switchClosed = shouldBeClosed;
-          changed = true;
+        for (let k = start[n]; k < start[n + 1]; k++) {
+          const r = items[k];
+          if (!this.relayClosed[r]) continue;
+          const other = this.relayA[r] === n ? this.relayB[r] : this.relayA[r];
+          if (this.netMark[other] !== epoch) {
+            this.netMark[other] = epoch;
+            region.push(other);
+          }
         }
       }
-    }
 
-    return changed;
+      if (powered) {
+        if (!this.netHigh[seed]) this.flood([seed]);
+      } else {
+        for (const n of region) {
+          if (this.netHigh[n]) this.setLevel(n, 0);
+        }
+      }
+    }
   }
 
-  /**
-   * Propagate signals through closed relay switches.
-   */
-  private propagateSignals(): boolean {
-    if (!this.circuit) return false;
-
-    let changed = false;
-
-    for (const component of this.circuit.components) {
-      const def = getComponentDefinition(component.definitionId);
-      if (!def) continue;
-
-      const state = this.componentStates.get(component.id)!;
-
-      // Check relays with closed switches
-      if ((def.type === 'relay_no' || def.type === 'relay_nc') && state.switchClosed) {
-        // Propagate signal from contact_in to contact_out (and vice versa)
-        const contactInSignal = this.getPortSignal(component.id, 'contact_in');
-        const contactOutSignal = this.getPortSignal(component.id, 'contact_out');
+  private setLevel(net: number, level: number): void {
+    this.netHigh[net] = level;
+    this.markDirty(net);
+    const { start, items } = this.netCoils;
+    for (let k = start[net]; k < start[net + 1]; k++) this.enqueue(items[k]);
+  }
 
-        // Propagate the driven signal
-        if (contactInSignal === 1 || contactInSignal === 0) {
-          changed = this.driveNet(component.id, 'contact_out', contactInSignal) || changed;
-        }
-        if (contactOutSignal === 1 || contactOutSignal === 0) {
-          changed = this.driveNet(component.id, 'contact_in', contactOutSignal) || changed;
-        }
-      }
+  private markDirty(net: number): void {
+    if (!this.netDirty[net]) {
+      this.netDirty[net] = 1;
+      this.dirtyNets.push(net);
     }
+  }
 
-    return changed;
+  private enqueue(relay: number): void {
+    if (!this.relayQueued[relay]) {
+      this.relayQueued[relay] = 1;
+      this.queue.push(relay);
+    }
   }
 
   /**
-   * Update all component port values from net signals.
+   * Copy changed net levels to the ports on them. Unwired ports read unknown.
    */
   private updatePortValues(): void {
     if (!this.circuit) return;
-
-    for (const component of this.circuit.components) {
-      const def = getComponentDefinition(component.definitionId);
-      if (!def) continue;
-
-      const state = this.componentStates.get(component.id)!;
-
-      for (const port of def.ports) {
-        const signal = this.getPortSignal(component.id, port.id);
-        state.portValues.set(port.id, signal);
+    const components = this.circuit.components;
+    const { start, items } = this.netPorts;
+
+    for (const n of this.dirtyNets) {
+      this.netDirty[n] = 0;
+      const level = this.netHigh[n] as SignalValue;
+      for (let k = start[n]; k < start[n + 1]; k++) {
+        const p = items[k];
+        const c = this.portComponent[p];
+        if (c < 0) continue;
+        const state = this.componentStates.get(components[c].id);
+        state?.portValues.set(this.portName[p], this.portConnected[p] ? level : 2);
       }
     }
+    this.dirtyNets = [];
   }
 
   /**
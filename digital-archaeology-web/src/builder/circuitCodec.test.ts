@@ -0,0 +1,194 @@
+// src/builder/circuitCodec.test.ts
+// Unit tests for the binary circuit encoding
+
+import { describe, it, expect, beforeEach, afterEach, vi } from 'vitest';
+import { webcrypto } from 'node:crypto';
+import {
+  CIRCUIT_CHUNK_SIZE,
+  encodeCircuitChunks,
+  decodeCircuitChunks,
+  hashChunk,
+  compressChunk,
+  decompressChunk,
+} from './circuitCodec';
+import type { BuilderCircuit, ComponentInstance, WireConnection } from './types';
+
+/**
+ * Build a circuit with `count` relays chained by wires.
+ */
+function makeCircuit(count: number): BuilderCircuit {
+  const components: ComponentInstance[] = [];
+  const wires: WireConnection[] = [];
+  for (let i = 0; i < count; i++) {
+    components.push({
+      id: `comp-${i}`,
+      definitionId: i % 2 === 0 ? 'relay_no' : 'relay_nc',
+      position: { x: i * 20, y: 100 - i * 40 },
+      rotation: ([0, 90, 180, 270] as const)[i % 4],
+    });
+    if (i > 0) {
+      wires.push({
+        id: `wire-${i}`,
+        sourceComponent: `comp-${i - 1}`,
+        sourcePort: 'contact_out',
+        targetComponent: `comp-${i}`,
+        targetPort: 'coil_in',
+        waypoints: [{ x: i * 20, y: 10 }],
+      });
+    }
+  }
+  return {
+    id: 'circuit-1',
+    name: 'Relay chain',
+    era: 'relay',
+    components,
+    wires,
+    inputs: [{ id: 'in-a', name: 'A', direction: 'input', componentId: 'comp-0' }],
+    outputs: [{ id: 'out-y', name: 'Y', direction: 'output', componentId: `comp-${count - 1}` }],
+    createdAt: 1700000000000,
+    modifiedAt: 1700000500000,
+  };
+}
+
+/**
+ * Encode and decode a circuit.
+ */
+function roundTrip(circuit: BuilderCircuit): BuilderCircuit {
+  return decodeCircuitChunks(circuit, encodeCircuitChunks(circuit));
+}
+
+describe('circuitCodec', () => {
+  afterEach(() => {
+    vi.unstubAllGlobals();
+  });
+
+  describe('encodeCircuitChunks / decodeCircuitChunks', () => {
+    it('should round-trip a circuit', () => {
+      const circuit = makeCircuit(10);
+
+      expect(roundTrip(circuit)).toEqual(circuit);
+    });
+
+    it('should round-trip labels, descriptions and fractional positions', () => {
+      const circuit = makeCircuit(3);
+      circuit.description = 'Ünïcode ✓ description';
+      circuit.components[1].label = 'K1';
+      circuit.components[2].position = { x: 12.5, y: -0.25 };
+      circuit.wires[0].waypoints = [{ x: 1.5, y: 2 }, { x: 3, y: 4 }];
+
+      expect(roundTrip(circuit)).toEqual(circuit);
+    });
+
+    it('should round-trip an empty circuit', () => {
+      const circuit = makeCircuit(0);
+      circuit.outputs = [];
+
+      expect(roundTrip(circuit)).toEqual(circuit);
+    });
+
+    it('should not persist runtime simulation state', () => {
+      const circuit = makeCircuit(2);
+      circuit.components[0].state = { coilEnergized: true, portValues: new Map() };
+      circuit.wires[0].signal = 1;
+
+      const decoded = roundTrip(circuit);
+
+      expect(decoded.components[0].state).toBeUndefined();
+      expect(decoded.wires[0].signal).toBeUndefined();
+    });
+
+    it('should split components and wires into fixed-size chunks', () => {
+      const chunks = encodeCircuitChunks(makeCircuit(CIRCUIT_CHUNK_SIZE + 1));
+
+      expect(chunks.map((chunk) => chunk.key)).toEqual(['meta', 'c0', 'c1', 'w0']);
+    });
+
+    it('should only change the chunk containing an edited component', async () => {
+      const circuit = makeCircuit(CIRCUIT_CHUNK_SIZE * 3);
+      const before = await Promise.all(encodeCircuitChunks(circuit).map((chunk) => hashChunk(chunk.bytes)));
+
+      circuit.components[CIRCUIT_CHUNK_SIZE + 5].position = { x: 999, y: 999 };
+      const after = await Promise.all(encodeCircuitChunks(circuit).map((chunk) => hashChunk(chunk.bytes)));
+
+      const changed = before.filter((hash, i) => hash !== after[i]);
+      expect(changed).toHaveLength(1);
+      expect(before.indexOf(changed[0])).toBe(2); // c1
+    });
+
+    it('should be much smaller than JSON', () => {
+      const circuit = makeCircuit(1000);
+      const size = encodeCircuitChunks(circuit).reduce((sum, chunk) => sum + chunk.bytes.length, 0);
+
+      expect(size).toBeLessThan(JSON.stringify(circuit).length / 2);
+    });
+
+    it('should reject a circuit without a meta chunk', () => {
+      const chunks = encodeCircuitChunks(makeCircuit(2)).filter((chunk) => chunk.key !== 'meta');
+
+      expect(() => decodeCircuitChunks(makeCircuit(2), chunks)).toThrow('missing meta chunk');
+    });
+
+    it('should reject truncated chunks', () => {
+      const chunks = encodeCircuitChunks(makeCircuit(2));
+      chunks[1] = { key: chunks[1].key, bytes: chunks[1].bytes.subarray(0, chunks[1].bytes.length - 3) };
+
+      expect(() => decodeCircuitChunks(makeCircuit(2), chunks)).toThrow('unexpected end of data');
+    });
+  });
+
+  describe('hashChunk', () => {
+    beforeEach(() => {
+      // Use Node's WebCrypto in case the test DOM's crypto lacks subtle
+      vi.stubGlobal('crypto', webcrypto);
+    });
+
+    it('should be stable and content-sensitive', async () => {
+      const hash = await hashChunk(new Uint8Array([1, 2, 3]));
+
+      expect(await hashChunk(new Uint8Array([1, 2, 3]))).toBe(hash);
+      expect(await hashChunk(new Uint8Array([1, 2, 4]))).not.toBe(hash);
+    });
+
+    it('should be the SHA-256 of the bytes', async () => {
+      expect(await hashChunk(new TextEncoder().encode('abc'))).toBe(
+        'ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad'
+      );
+    });
+
+    it('should return null without crypto.subtle', async () => {
+      vi.stubGlobal('crypto', {});
+
+      expect(await hashChunk(new Uint8Array([1, 2, 3]))).toBeNull();
+    });
+  });
+
+  describe('compressChunk / decompressChunk', () => {
+    it('should round-trip chunk bytes', async () => {
+      const bytes = encodeCircuitChunks(makeCircuit(500))[1].bytes;
+
+      const stored = await compressChunk(bytes);
+
+      expect(await decompressChunk(stored)).toEqual(bytes);
+    });
+
+    it('should store small chunks uncompressed', async () => {
+      const stored = await compressChunk(new Uint8Array([7, 8, 9]));
+
+      expect(Array.from(stored)).toEqual([0, 7, 8, 9]);
+    });
+
+    it('should store uncompressed when CompressionStream is unavailable', async () => {
+      vi.stubGlobal('CompressionStream', undefined);
+      const bytes = encodeCircuitChunks(makeCircuit(500))[1].bytes;
+
+      const stored = await compressChunk(bytes);
+
+      expect(stored[0]).toBe(0);
+      expect(await decompressChunk(stored)).toEqual(bytes);
+    });
+
+    it('should reject unknown storage flags', async () => {
+      await expect(decompressChunk(new Uint8Array([9, 1]))).rejects.toThrow('unknown storage flag');
+    });
+  });
+});
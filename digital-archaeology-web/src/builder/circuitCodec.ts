@@ -0,0 +1,555 @@
+// src/builder/circuitCodec.ts
+// Compact binary encoding for persisted circuits
+
+import type {
+  BuilderCircuit,
+  ComponentInstance,
+  ExternalPort,
+  Position,
+  WireConnection,
+} from './types';
+
+/**
+ * Components or wires per chunk. Editing a circuit usually touches a single
+ * chunk, so a save only has to rewrite that chunk.
+ */
+export const CIRCUIT_CHUNK_SIZE = 256;
+
+/** Format version written as the first byte of every chunk */
+const CHUNK_FORMAT = 1;
+
+/** Compression flag written as the first byte of stored chunk data */
+const STORED_RAW = 0;
+const STORED_DEFLATE = 1;
+
+/** Chunks smaller than this are not worth compressing */
+const MIN_COMPRESS_BYTES = 64;
+
+const COMPRESSION_FORMAT = 'deflate-raw';
+
+const ROTATIONS: ComponentInstance['rotation'][] = [0, 90, 180, 270];
+
+/** Component flag bits */
+const COMPONENT_HAS_LABEL = 1;
+const COMPONENT_FLOAT_POSITION = 2;
+
+/** Wire flag bit */
+const WIRE_FLOAT_WAYPOINTS = 1;
+
+/**
+ * One independently encoded part of a circuit.
+ * Keys are 'meta' for description and external ports, 'c<n>' for component
+ * chunks and 'w<n>' for wire chunks.
+ */
+export interface CircuitChunk {
+  key: string;
+  /** Uncompressed binary encoding */
+  bytes: Uint8Array;
+}
+
+/**
+ * Circuit fields kept outside the chunks, in the stored circuit record.
+ */
+export type CircuitHeader = Pick<BuilderCircuit, 'id' | 'name' | 'era' | 'createdAt' | 'modifiedAt'>;
+
+// ============================================================================
+// Byte writer / reader
+// ============================================================================
+
+/**
+ * Appends varints, floats and interned strings to a growable buffer.
+ * Strings are written as indexes into a table that is emitted ahead of
+ * the body by finish().
+ */
+class ByteWriter {
+  private buffer = new Uint8Array(256);
+  private length = 0;
+  private readonly strings = new Map<string, number>();
+
+  /**
+   * Write an unsigned integer as a LEB128 varint (up to 2^53).
+   */
+  uint(value: number): void {
+    this.reserve(8);
+    let v = value;
+    while (v >= 0x80) {
+      this.buffer[this.length++] = (v % 0x80) | 0x80;
+      v = Math.floor(v / 0x80);
+    }
+    this.buffer[this.length++] = v;
+  }
+
+  /**
+   * Write a signed integer as a zigzag varint.
+   */
+  int(value: number): void {
+    this.uint(value < 0 ? -value * 2 - 1 : value * 2);
+  }
+
+  /**
+   * Write a 64-bit float.
+   */
+  float(value: number): void {
+    this.reserve(8);
+    new DataView(this.buffer.buffer).setFloat64(this.length, value, true);
+    this.length += 8;
+  }
+
+  /**
+   * Write a string as its index in the string table.
+   */
+  string(value: string): void {
+    let index = this.strings.get(value);
+    if (index === undefined) {
+      index = this.strings.size;
+      this.strings.set(value, index);
+    }
+    this.uint(index);
+  }
+
+  /**
+   * Write a position, as zigzag varints when integral and floats otherwise.
+   */
+  position(position: Position, integral: boolean): void {
+    if (integral) {
+      this.int(position.x);
+      this.int(position.y);
+    } else {
+      this.float(position.x);
+      this.float(position.y);
+    }
+  }
+
+  /**
+   * Get the encoded chunk: format byte, string table, then body.
+   */
+  finish(): Uint8Array {
+    const encoder = new TextEncoder();
+    const header = new ByteWriter();
+    header.uint(CHUNK_FORMAT);
+    header.uint(this.strings.size);
+    for (const value of this.strings.keys()) {
+      const bytes = encoder.encode(value);
+      header.uint(bytes.length);
+      header.bytes(bytes);
+    }
+
+    const out = new Uint8Array(header.length + this.length);
+    out.set(header.buffer.subarray(0, header.length), 0);
+    out.set(this.buffer.subarray(0, this.length), header.length);
+    return out;
+  }
+
+  /**
+   * Append raw bytes.
+   */
+  private bytes(bytes: Uint8Array): void {
+    this.reserve(bytes.length);
+    this.buffer.set(bytes, this.length);
+    this.length += bytes.length;
+  }
+
+  /**
+   * Grow the buffer so that `count` more bytes fit.
+   */
+  private reserve(count: number): void {
+    if (this.length + count <= this.buffer.length) return;
+    let size = this.buffer.length * 2;
+    while (size < this.length + count) size *= 2;
+    const grown = new Uint8Array(size);
+    grown.set(this.buffer.subarray(0, this.length));
+    this.buffer = grown;
+  }
+}
+
+/**
+ * Reads values written by ByteWriter. Throws on truncated or unknown data.
+ */
+class ByteReader {
+  private offset = 0;
+  private readonly data: Uint8Array;
+  private readonly view: DataView;
+  private readonly strings: string[] = [];
+
+  constructor(data: Uint8Array) {
+    this.data = data;
+    this.view = new DataView(data.buffer, data.byteOffset, data.byteLength);
+
+    const format = this.uint();
+    if (format !== CHUNK_FORMAT) {
+      throw new Error(`Unsupported circuit chunk format: ${format}`);
+    }
+    const decoder = new TextDecoder();
+    const count = this.uint();
+    for (let i = 0; i < count; i++) {
+      const length = this.uint();
+      this.need(length);
+      this.strings.push(decoder.decode(data.subarray(this.offset, this.offset + length)));
+      this.offset += length;
+    }
+  }
+
+  /**
+   * Read an unsigned varint.
+   */
+  uint(): number {
+    let value = 0;
+    let scale = 1;
+    for (;;) {
+      this.need(1);
+      const byte = this.data[this.offset++];
+      value += (byte & 0x7f) * scale;
+      if (byte < 0x80) return value;
+      scale *= 0x80;
+    }
+  }
+
+  /**
+   * Read a zigzag varint.
+   */
+  int(): number {
+    const value = this.uint();
+    return value % 2 === 0 ? value / 2 : -(value + 1) / 2;
+  }
+
+  /**
+   * Read a 64-bit float.
+   */
+  float(): number {
+    this.need(8);
+    const value = this.view.getFloat64(this.offset, true);
+    this.offset += 8;
+    return value;
+  }
+
+  /**
+   * Read an interned string.
+   */
+  string(): string {
+    const index = this.uint();
+    if (index >= this.strings.length) {
+      throw new Error('Corrupt circuit chunk: string index out of range');
+    }
+    return this.strings[index];
+  }
+
+  /**
+   * Read a position written with the same `integral` flag.
+   */
+  position(integral: boolean): Position {
+    return integral ? { x: this.int(), y: this.int() } : { x: this.float(), y: this.float() };
+  }
+
+  /**
+   * Throw unless `count` more bytes are available.
+   */
+  private need(count: number): void {
+    if (this.offset + count > this.data.length) {
+      throw new Error('Corrupt circuit chunk: unexpected end of data');
+    }
+  }
+}
+
+/**
+ * Whether a position can be stored as zigzag varints.
+ */
+function isIntegral(position: Position): boolean {
+  return Number.isSafeInteger(position.x) && Number.isSafeInteger(position.y);
+}
+
+// ============================================================================
+// Chunk encoding
+// ============================================================================
+
+/**
+ * Encode the description and external ports.
+ */
+function encodeMeta(circuit: BuilderCircuit): Uint8Array {
+  const writer = new ByteWriter();
+  const hasDescription = circuit.description !== undefined;
+  writer.uint(hasDescription ? 1 : 0);
+  if (hasDescription) writer.string(circuit.description!);
+
+  for (const ports of [circuit.inputs, circuit.outputs]) {
+    writer.uint(ports.length);
+    for (const port of ports) {
+      writer.string(port.id);
+      writer.string(port.name);
+      writer.uint(port.direction === 'input' ? 0 : 1);
+      writer.string(port.componentId);
+    }
+  }
+  return writer.finish();
+}
+
+/**
+ * Encode a run of components. Runtime simulation state is not persisted.
+ */
+function encodeComponents(components: ComponentInstance[]): Uint8Array {
+  const writer = new ByteWriter();
+  writer.uint(components.length);
+  for (const component of components) {
+    const integral = isIntegral(component.position);
+    let flags = Math.max(0, ROTATIONS.indexOf(component.rotation)) << 2;
+    if (component.label !== undefined) flags |= COMPONENT_HAS_LABEL;
+    if (!integral) flags |= COMPONENT_FLOAT_POSITION;
+
+    writer.uint(flags);
+    writer.string(component.id);
+    writer.string(component.definitionId);
+    writer.position(component.position, integral);
+    if (component.label !== undefined) writer.string(component.label);
+  }
+  return writer.finish();
+}
+
+/**
+ * Encode a run of wires. Runtime signal values are not persisted.
+ */
+function encodeWires(wires: WireConnection[]): Uint8Array {
+  const writer = new ByteWriter();
+  writer.uint(wires.length);
+  for (const wire of wires) {
+    const integral = wire.waypoints.every(isIntegral);
+    writer.uint(integral ? 0 : WIRE_FLOAT_WAYPOINTS);
+    writer.string(wire.id);
+    writer.string(wire.sourceComponent);
+    writer.string(wire.sourcePort);
+    writer.string(wire.targetComponent);
+    writer.string(wire.targetPort);
+    writer.uint(wire.waypoints.length);
+    for (const point of wire.waypoints) {
+      writer.position(point, integral);
+    }
+  }
+  return writer.finish();
+}
+
+/**
+ * Decode the description and external ports.
+ */
+function decodeMeta(bytes: Uint8Array): Pick<BuilderCircuit, 'description' | 'inputs' | 'outputs'> {
+  const reader = new ByteReader(bytes);
+  const description = reader.uint() === 1 ? reader.string() : undefined;
+
+  const [inputs, outputs] = [0, 1].map(() => {
+    const ports: ExternalPort[] = [];
+    const count = reader.uint();
+    for (let i = 0; i < count; i++) {
+      const id = reader.string();
+      const name = reader.string();
+      const direction = reader.uint() === 0 ? 'input' : 'output';
+      ports.push({ id, name, direction, componentId: reader.string() });
+    }
+    return ports;
+  });
+
+  return { description, inputs, outputs };
+}
+
+/**
+ * Decode a run of components into `out`.
+ */
+function decodeComponents(bytes: Uint8Array, out: ComponentInstance[]): void {
+  const reader = new ByteReader(bytes);
+  const count = reader.uint();
+  for (let i = 0; i < count; i++) {
+    const flags = reader.uint();
+    const component: ComponentInstance = {
+      id: reader.string(),
+      definitionId: reader.string(),
+      position: reader.position((flags & COMPONENT_FLOAT_POSITION) === 0),
+      rotation: ROTATIONS[(flags >> 2) & 3],
+    };
+    if (flags & COMPONENT_HAS_LABEL) component.label = reader.string();
+    out.push(component);
+  }
+}
+
+/**
+ * Decode a run of wires into `out`.
+ */
+function decodeWires(bytes: Uint8Array, out: WireConnection[]): void {
+  const reader = new ByteReader(bytes);
+  const count = reader.uint();
+  for (let i = 0; i < count; i++) {
+    const integral = (reader.uint() & WIRE_FLOAT_WAYPOINTS) === 0;
+    const wire: WireConnection = {
+      id: reader.string(),
+      sourceComponent: reader.string(),
+      sourcePort: reader.string(),
+      targetComponent: reader.string(),
+      targetPort: reader.string(),
+      waypoints: [],
+    };
+    const points = reader.uint();
+    for (let p = 0; p < points; p++) {
+      wire.waypoints.push(reader.position(integral));
+    }
+    out.push(wire);
+  }
+}
+
+/**
+ * Split a circuit into binary chunks: one for metadata, then one per
+ * CIRCUIT_CHUNK_SIZE components and wires. Header fields (id, name, era,
+ * timestamps) are not included; they belong in the stored record.
+ * @param circuit - The circuit to encode
+ * @returns Chunks in a stable order
+ */
+export function encodeCircuitChunks(circuit: BuilderCircuit): CircuitChunk[] {
+  const chunks: CircuitChunk[] = [{ key: 'meta', bytes: encodeMeta(circuit) }];
+  for (let i = 0; i * CIRCUIT_CHUNK_SIZE < circuit.components.length; i++) {
+    const slice = circuit.components.slice(i * CIRCUIT_CHUNK_SIZE, (i + 1) * CIRCUIT_CHUNK_SIZE);
+    chunks.push({ key: `c${i}`, bytes: encodeComponents(slice) });
+  }
+  for (let i = 0; i * CIRCUIT_CHUNK_SIZE < circuit.wires.length; i++) {
+    const slice = circuit.wires.slice(i * CIRCUIT_CHUNK_SIZE, (i + 1) * CIRCUIT_CHUNK_SIZE);
+    chunks.push({ key: `w${i}`, bytes: encodeWires(slice) });
+  }
+  return chunks;
+}
+
+/**
+ * Rebuild a circuit from its header and the chunks of encodeCircuitChunks.
+ * @param header - Fields stored outside the chunks
+ * @param chunks - Chunks in any order
+ * @returns The decoded circuit
+ * @throws Error if the meta chunk is missing or a chunk is corrupt
+ */
+export function decodeCircuitChunks(header: CircuitHeader, chunks: CircuitChunk[]): BuilderCircuit {
+  const byKey = new Map(chunks.map((chunk) => [chunk.key, chunk.bytes]));
+  const meta = byKey.get('meta');
+  if (!meta) {
+    throw new Error('Corrupt circuit: missing meta chunk');
+  }
+
+  const components: ComponentInstance[] = [];
+  for (let i = 0; byKey.has(`c${i}`); i++) {
+    decodeComponents(byKey.get(`c${i}`)!, components);
+  }
+  const wires: WireConnection[] = [];
+  for (let i = 0; byKey.has(`w${i}`); i++) {
+    decodeWires(byKey.get(`w${i}`)!, wires);
+  }
+
+  const { description, inputs, outputs } = decodeMeta(meta);
+  const circuit: BuilderCircuit = {
+    id: header.id,
+    name: header.name,
+    era: header.era,
+    components,
+    wires,
+    inputs,
+    outputs,
+  };
+  if (header.createdAt !== undefined) circuit.createdAt = header.createdAt;
+  if (header.modifiedAt !== undefined) circuit.modifiedAt = header.modifiedAt;
+  if (description !== undefined) circuit.description = description;
+  return circuit;
+}
+
+/**
+ * SHA-256 digest of a chunk's bytes, used to skip rewriting chunks that have
+ * not changed since the last save. crypto.subtle only exists in secure
+ * contexts; elsewhere there is no digest and every chunk is rewritten.
+ * @param bytes - Uncompressed chunk bytes
+ * @returns Hex digest, or null if crypto.subtle is unavailable
+ */
+export async function hashChunk(bytes: Uint8Array): Promise<string | null> {
+  if (typeof crypto === 'undefined' || !crypto.subtle) return null;
+  const digest = new Uint8Array(await crypto.subtle.digest('SHA-256', bytes as BufferSource));
+  let hex = '';
+  for (const byte of digest) hex += byte.toString(16).padStart(2, '0');
+  return hex;
+}
+
+// ============================================================================
+// Compression
+// ============================================================================
+
+/**
+ * Read a whole stream into one array.
+ */
+async function readAll(stream: ReadableStream<Uint8Array>): Promise<Uint8Array> {
+  const reader = stream.getReader();
+  const parts: Uint8Array[] = [];
+  let length = 0;
+  for (;;) {
+    const { done, value } = await reader.read();
+    if (done) break;
+    parts.push(value);
+    length += value.length;
+  }
+  const out = new Uint8Array(length);
+  let offset = 0;
+  for (const part of parts) {
+    out.set(part, offset);
+    offset += part.length;
+  }
+  return out;
+}
+
+/**
+ * Pipe bytes through a compression or decompression transform.
+ */
+function transform(bytes: Uint8Array, stream: GenericTransformStream): Promise<Uint8Array> {
+  const source = new ReadableStream<Uint8Array>({
+    start(controller) {
+      controller.enqueue(bytes);
+      controller.close();
+    },
+  });
+  return readAll(source.pipeThrough(stream as TransformStream<Uint8Array, Uint8Array>));
+}
+
+/**
+ * Prepare chunk bytes for storage, deflating them with CompressionStream
+ * where available and worthwhile. The first byte records which was done.
+ * @param bytes - Uncompressed chunk bytes
+ * @returns Stored form of the chunk
+ */
+export async function compressChunk(bytes: Uint8Array): Promise<Uint8Array> {
+  if (bytes.length >= MIN_COMPRESS_BYTES && typeof CompressionStream !== 'undefined') {
+    try {
+      const deflated = await transform(bytes, new CompressionStream(COMPRESSION_FORMAT));
+      if (deflated.length < bytes.length) {
+        return withFlag(STORED_DEFLATE, deflated);
+      }
+    } catch {
+      // Format unsupported in this browser; store uncompressed
+    }
+  }
+  return withFlag(STORED_RAW, bytes);
+}
+
+/**
+ * Reverse compressChunk.
+ * @param stored - Stored form of the chunk
+ * @returns Uncompressed chunk bytes
+ * @throws Error if the data is deflated and DecompressionStream is unavailable
+ */
+export async function decompressChunk(stored: Uint8Array): Promise<Uint8Array> {
+  const body = stored.subarray(1);
+  switch (stored[0]) {
+    case STORED_RAW:
+      return body;
+    case STORED_DEFLATE:
+      if (typeof DecompressionStream === 'undefined') {
+        throw new Error('Cannot decompress circuit: DecompressionStream unavailable');
+      }
+      return transform(body, new DecompressionStream(COMPRESSION_FORMAT));
+    default:
+      throw new Error(`Corrupt circuit chunk: unknown storage flag ${stored[0]}`);
+  }
+}
+
+/**
+ * Prefix bytes with a one-byte flag.
+ */
+function withFlag(flag: number, bytes: Uint8Array): Uint8Array {
+  const out = new Uint8Array(bytes.length + 1);
+  out[0] = flag;
+  out.set(bytes, 1);
+  return out;
+}
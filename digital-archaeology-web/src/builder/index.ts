@@ -99,3 +99,12 @@ export { ProgressTracker, UnlockChecker, ACHIEVEMENTS } from './ProgressTracker'
 // Storage
 export { BuilderStorage } from './BuilderStorage';
 export type { CircuitMetadata, BuilderSettings } from './BuilderStorage';
+export {
+  CIRCUIT_CHUNK_SIZE,
+  encodeCircuitChunks,
+  decodeCircuitChunks,
+  hashChunk,
+  compressChunk,
+  decompressChunk,
+} from './circuitCodec';
+export type { CircuitChunk, CircuitHeader } from './circuitCodec';
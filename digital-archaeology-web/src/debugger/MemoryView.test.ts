@@ -430,6 +430,136 @@ describe('MemoryView', () => {
     });
   });
 
+  describe('virtualization (large address spaces)', () => {
+    /**
+     * Give the scroll container a fixed viewport height, as layout would.
+     */
+    function setViewportHeight(view: HTMLElement, height: number): HTMLElement {
+      const scroll = view.querySelector('.da-memory-view__scroll') as HTMLElement;
+      Object.defineProperty(scroll, 'clientHeight', { value: height, configurable: true });
+      return scroll;
+    }
+
+    it('should render only a window of rows for a 64 KB address space', () => {
+      const largeView = new MemoryView({ size: 65536, valueDigits: 2 });
+      largeView.mount(container);
+
+      const rows = container.querySelectorAll('.da-memory-row:not(.da-memory-header)');
+      expect(rows.length).toBeGreaterThan(0);
+      expect(rows.length).toBeLessThan(64);
+      expect(rows[0].querySelector('.da-memory-addr')?.textContent).toBe('0x0000');
+      expect(rows[0].querySelector('.da-memory-cell')?.textContent).toBe('00');
+
+      largeView.destroy();
+    });
+
+    it('should recycle rows as the view scrolls', () => {
+      const largeView = new MemoryView({ size: 65536, valueDigits: 2 });
+      largeView.mount(container);
+      const scroll = setViewportHeight(container, 210);
+
+      scroll.scrollTop = 21 + 1000 * 21; // header + 1000 rows at the fallback height
+      scroll.dispatchEvent(new Event('scroll'));
+
+      const rows = container.querySelectorAll('.da-memory-row:not(.da-memory-header)');
+      expect(rows.length).toBeLessThan(64);
+      expect(container.querySelector('[data-address="0"]')).toBeNull();
+      const row = container.querySelector('[data-address="16000"]');
+      expect(row?.querySelector('.da-memory-addr')?.textContent).toBe('0x3E80');
+
+      largeView.destroy();
+    });
+
+    it('should keep rendered rows in address order after scrolling back', () => {
+      const largeView = new MemoryView({ size: 65536 });
+      largeView.mount(container);
+      const scroll = setViewportHeight(container, 210);
+
+      scroll.scrollTop = 21 + 20 * 21;
+      scroll.dispatchEvent(new Event('scroll'));
+      scroll.scrollTop = 0;
+      scroll.dispatchEvent(new Event('scroll'));
+
+      const rows = container.querySelectorAll('.da-memory-row:not(.da-memory-header)');
+      const addresses = Array.from(rows, (row) => Number(row.getAttribute('data-address')));
+      expect(addresses[0]).toBe(0);
+      expect(addresses).toEqual([...addresses].sort((a, b) => a - b));
+
+      largeView.destroy();
+    });
+
+    it('should show current values and PC in rows scrolled into view', () => {
+      const largeView = new MemoryView({ size: 65536, valueDigits: 2 });
+      largeView.mount(container);
+      const scroll = setViewportHeight(container, 210);
+
+      const memory = new Uint8Array(65536);
+      memory[16001] = 0xab;
+      largeView.updateState({ memory, pc: 16002 });
+
+      scroll.scrollTop = 21 + 1000 * 21;
+      scroll.dispatchEvent(new Event('scroll'));
+
+      const row = container.querySelector('[data-address="16000"]');
+      expect(row?.querySelector('[data-offset="1"]')?.textContent).toBe('AB');
+      expect(row?.classList.contains('da-memory-pc')).toBe(true);
+      expect(row?.querySelector('[data-offset="2"]')?.classList.contains('da-memory-pc-cell')).toBe(true);
+
+      largeView.destroy();
+    });
+
+    it('should render and highlight a far jump target even if the container cannot scroll', () => {
+      const largeView = new MemoryView({ size: 65536 });
+      largeView.mount(container);
+      const scroll = container.querySelector('.da-memory-view__scroll') as HTMLElement;
+      Object.defineProperty(scroll, 'scrollTop', { get: () => 0, set: () => {}, configurable: true });
+
+      expect(largeView.scrollToAddress(0x8000)).toBe(true);
+
+      const row = container.querySelector('[data-address="32768"]');
+      expect(row?.classList.contains('da-memory-jump-target')).toBe(true);
+
+      largeView.destroy();
+    });
+
+    it('should report the address range of the configured size', () => {
+      const largeView = new MemoryView({ size: 65536 });
+      largeView.mount(container);
+
+      const input = container.querySelector('.da-memory-jump__input') as HTMLInputElement;
+      const button = container.querySelector('.da-memory-jump__button') as HTMLButtonElement;
+      input.value = '0x10000';
+      button.click();
+
+      expect(container.querySelector('.da-memory-jump__error')?.textContent).toBe(
+        'Address out of range (0-65535)'
+      );
+      expect(largeView.parseAddress('0xFFFF')).toBe(65535);
+
+      largeView.destroy();
+    });
+
+    it('should only patch addresses marked in the dirty bitmap', () => {
+      memoryView.mount(container);
+      memoryView.updateState({ memory: new Uint8Array(256) });
+
+      const memory = new Uint8Array(256);
+      memory[0] = 5;
+      memory[1] = 6;
+      const dirty = new Uint32Array(8);
+      dirty[0] = 1 << 1;
+      memoryView.updateState({ memory, dirty });
+
+      const firstRow = container.querySelector('[data-address="0"]');
+      const cell0 = firstRow?.querySelector('[data-offset="0"]');
+      const cell1 = firstRow?.querySelector('[data-offset="1"]');
+      expect(cell0?.textContent).toBe('0');
+      expect(cell0?.classList.contains('da-memory-changed')).toBe(false);
+      expect(cell1?.textContent).toBe('6');
+      expect(cell1?.classList.contains('da-memory-changed')).toBe(true);
+    });
+  });
+
   // =========================================================================
   // Story 5.6: Jump to Address Tests
   // =========================================================================
@@ -1,15 +1,33 @@
 // src/debugger/MemoryView.ts
 // MemoryView component for displaying CPU memory contents (Story 5.5, 5.6)
 
+/** Default number of addressable cells (Micro4: 256 nibbles). */
+const DEFAULT_MEMORY_SIZE = 256;
+
+/** Rows rendered above and below the visible window. */
+const OVERSCAN_ROWS = 8;
+
+/** Rows assumed visible before the scroll container has been laid out. */
+const DEFAULT_VISIBLE_ROWS = 32;
+
+/** Row height in px used until a rendered row can be measured. */
+const FALLBACK_ROW_HEIGHT = 21;
+
 /**
  * State interface for MemoryView component.
  * Contains the CPU memory and PC for highlighting.
  */
 export interface MemoryViewState {
-  /** CPU memory (256 nibbles, 4-bit values 0-15) */
+  /** CPU memory, one cell per address (Micro4: 256 nibbles, 4-bit values 0-15) */
   memory: Uint8Array;
-  /** Program Counter for highlighting (0-255) */
+  /** Program Counter for highlighting (0 to size-1) */
   pc: number;
+  /**
+   * Addresses that changed since the previous updateState call, one bit per
+   * address (bit a & 31 of word a >> 5). When given, only those visible cells
+   * are checked; when omitted, every visible cell is.
+   */
+  dirty?: Uint32Array;
 }
 
 /**
@@ -18,24 +36,65 @@ export interface MemoryViewState {
 export interface MemoryViewOptions {
   /** Bytes per row (default: 16) */
   bytesPerRow?: number;
+  /** Number of addressable cells (default: 256; 65536 for Micro8, 1048576 for Micro16) */
+  size?: number;
+  /** Hex digits shown per cell (default: 1 for nibbles; 2 for bytes) */
+  valueDigits?: number;
   /** Optional callback when address is clicked */
   onAddressClick?: (address: number) => void;
 }
 
+/**
+ * A rendered memory row. Row elements are recycled while scrolling, so the
+ * values shown are cached to patch only cells that changed.
+ */
+interface MemoryRow {
+  element: HTMLElement;
+  addrCell: HTMLElement;
+  cells: HTMLElement[];
+  /** Value shown in each cell, -1 if the cell is past the end of memory */
+  shown: Int16Array;
+  /** Row index currently displayed */
+  index: number;
+}
+
 /**
  * MemoryView component displays CPU memory contents in the State panel.
- * Shows a scrollable hex dump with 16 nibbles per row.
+ * Shows a scrollable hex dump with 16 cells per row.
  * The current PC address is highlighted.
  * Changed cells flash briefly after each step.
  * Includes jump-to-address functionality (Story 5.6).
+ *
+ * The grid is virtualized so 64 KB and 1 MB address spaces stay cheap:
+ * DOM rows exist only for the visible window plus overscan, spacers stand in
+ * for the rest, rows are recycled while scrolling and updates patch only the
+ * visible cells whose values changed.
  */
 export class MemoryView {
   private container: HTMLElement | null = null;
   private element: HTMLElement | null = null;
-  private state: MemoryViewState = { memory: new Uint8Array(256), pc: 0 };
-  private previousState: MemoryViewState | null = null;
+  private state: MemoryViewState;
   private isFirstRender: boolean = true;
   private bytesPerRow: number;
+  private size: number;
+  private valueDigits: number;
+  private addressDigits: number;
+  private rowCount: number;
+
+  // Virtualized grid
+  private scroll: HTMLElement | null = null;
+  private table: HTMLElement | null = null;
+  private topSpacer: HTMLElement | null = null;
+  private bottomSpacer: HTMLElement | null = null;
+  private rows: Map<number, MemoryRow> = new Map();
+  private rowPool: MemoryRow[] = [];
+  private firstRow: number = 0;
+  private lastRow: number = 0;
+  private rowHeight: number = 0;
+  private headerHeight: number = 0;
+  private jumpTargetRow: number | null = null;
+  /** Row a jump centred the window on, until the user scrolls */
+  private anchorRow: number | null = null;
 
   // Jump UI elements (Story 5.6)
   private jumpInput: HTMLInputElement | null = null;
@@ -47,6 +106,7 @@ export class MemoryView {
   private boundJumpHandler: () => void;
   private boundKeydownHandler: (e: Event) => void;
   private boundInputHandler: () => void;
+  private boundScrollHandler: () => void;
 
   // Timeout ID for jump highlight cleanup (Story 5.6)
   private jumpHighlightTimeout: ReturnType<typeof setTimeout> | null = null;
@@ -56,12 +116,21 @@ export class MemoryView {
    * @param options - Optional configuration
    */
   constructor(options?: MemoryViewOptions) {
-    this.bytesPerRow = options?.bytesPerRow ?? 16;
+    this.bytesPerRow = Math.max(1, Math.floor(options?.bytesPerRow ?? 16));
+    this.size = Math.max(1, Math.floor(options?.size ?? DEFAULT_MEMORY_SIZE));
+    this.valueDigits = Math.max(1, Math.floor(options?.valueDigits ?? 1));
+    this.addressDigits = Math.max(2, (this.size - 1).toString(16).length);
+    this.rowCount = Math.ceil(this.size / this.bytesPerRow);
+    this.state = { memory: new Uint8Array(this.size), pc: 0 };
     // Bind handlers in constructor for proper add/remove listener pairing
     this.boundAnimationEndHandler = (e: Event) => this.handleAnimationEnd(e as AnimationEvent);
     this.boundJumpHandler = () => this.handleJump();
     this.boundKeydownHandler = (e: Event) => this.handleKeydown(e as KeyboardEvent);
     this.boundInputHandler = () => this.handleInputChange();
+    this.boundScrollHandler = () => {
+      this.anchorRow = null;
+      this.updateWindow();
+    };
   }
 
   /**
@@ -79,8 +148,9 @@ export class MemoryView {
     this.render();
     this.container.appendChild(this.element);
 
-    // Setup jump UI event listeners after render (Story 5.6)
-    this.setupJumpListeners();
+    // Rows can be measured once the element is in the document
+    this.measureRows();
+    this.updateWindow();
   }
 
   /**
@@ -114,29 +184,31 @@ export class MemoryView {
   /**
    * Update the displayed memory values.
    * Only updates values that are provided (partial updates supported).
+   * Work is proportional to the visible rows, not the memory size.
    * @param state - Partial state with values to update
    */
   updateState(state: Partial<MemoryViewState>): void {
-    // Store previous state for change detection (after first render)
-    if (!this.isFirstRender) {
-      this.previousState = {
-        memory: new Uint8Array(this.state.memory),
-        pc: this.state.pc,
-      };
-    }
+    // The first update only establishes values; later ones flash changes
+    const flash = !this.isFirstRender;
+    const previousPc = this.state.pc;
 
-    // Update state with provided values
+    // Keep a reference; changes are detected against the values on screen
     if (state.memory !== undefined) {
-      this.state.memory = new Uint8Array(state.memory);
+      this.state.memory = state.memory;
     }
     if (state.pc !== undefined) {
       // Clamp PC to valid range
       const pc = Number.isFinite(state.pc) ? state.pc : 0;
-      this.state.pc = Math.max(0, Math.min(255, Math.floor(pc)));
+      this.state.pc = Math.max(0, Math.min(this.size - 1, Math.floor(pc)));
     }
 
-    // Re-render with new values
-    this.render();
+    if (state.memory !== undefined) {
+      this.patchVisibleCells(flash, state.dirty);
+    }
+    if (this.state.pc !== previousPc) {
+      this.setPcHighlight(previousPc, false);
+      this.setPcHighlight(this.state.pc, true);
+    }
 
     // Clear first render flag after first updateState call
     if (this.isFirstRender) {
@@ -145,7 +217,8 @@ export class MemoryView {
   }
 
   /**
-   * Render the component using safe DOM methods.
+   * Render the component chrome using safe DOM methods.
+   * The memory rows themselves are created by updateWindow().
    * XSS-SAFE: Uses textContent for all dynamic values (nibbles rendered as hex).
    * @private
    */
@@ -157,6 +230,8 @@ export class MemoryView {
 
     // Clear existing content
     this.element.textContent = '';
+    this.rows.clear();
+    this.rowPool = [];
 
     // Create title
     const title = document.createElement('h3');
@@ -176,7 +251,7 @@ export class MemoryView {
     this.jumpInput = document.createElement('input');
     this.jumpInput.type = 'text';
     this.jumpInput.className = 'da-memory-jump__input';
-    this.jumpInput.placeholder = '0x00 or 0';
+    this.jumpInput.placeholder = '0x' + '0'.repeat(this.addressDigits) + ' or 0';
     this.jumpInput.setAttribute('aria-label', 'Memory address to jump to');
     jumpContainer.appendChild(this.jumpInput);
 
@@ -199,15 +274,16 @@ export class MemoryView {
     this.setupJumpListeners();
 
     // Create scrollable container
-    const scroll = document.createElement('div');
-    scroll.className = 'da-memory-view__scroll';
-    this.element.appendChild(scroll);
+    this.scroll = document.createElement('div');
+    this.scroll.className = 'da-memory-view__scroll';
+    this.scroll.addEventListener('scroll', this.boundScrollHandler, { passive: true });
+    this.element.appendChild(this.scroll);
 
     // Create table container
-    const table = document.createElement('div');
-    table.className = 'da-memory-view__table';
-    table.setAttribute('aria-live', 'polite');
-    scroll.appendChild(table);
+    this.table = document.createElement('div');
+    this.table.className = 'da-memory-view__table';
+    this.table.setAttribute('aria-live', 'polite');
+    this.scroll.appendChild(this.table);
 
     // Create header row
     const headerRow = document.createElement('div');
@@ -227,62 +303,242 @@ export class MemoryView {
       headerRow.appendChild(colHeader);
     }
 
-    table.appendChild(headerRow);
+    this.table.appendChild(headerRow);
+
+    // Spacers stand in for the rows outside the rendered window
+    this.topSpacer = document.createElement('div');
+    this.topSpacer.className = 'da-memory-view__spacer';
+    this.table.appendChild(this.topSpacer);
+
+    this.bottomSpacer = document.createElement('div');
+    this.bottomSpacer.className = 'da-memory-view__spacer';
+    this.table.appendChild(this.bottomSpacer);
+
+    this.firstRow = 0;
+    this.lastRow = 0;
+  }
+
+  /**
+   * Measure row and header heights from the laid-out DOM.
+   * Falls back to a fixed height when layout is unavailable (e.g. JSDOM).
+   * @private
+   */
+  private measureRows(): void {
+    const header = this.table?.firstElementChild as HTMLElement | null;
+    const headerHeight = header?.getBoundingClientRect().height ?? 0;
+
+    // Render one row to measure it if none exists yet
+    let row = this.rows.values().next().value as MemoryRow | undefined;
+    let probe: MemoryRow | null = null;
+    if (!row && this.table && this.bottomSpacer && this.rowCount > 0) {
+      probe = this.acquireRow(0);
+      this.table.insertBefore(probe.element, this.bottomSpacer);
+      row = probe;
+    }
+    const rowHeight = row?.element.getBoundingClientRect().height ?? 0;
+    if (probe) {
+      this.releaseRow(probe);
+    }
+
+    this.rowHeight = rowHeight > 0 ? rowHeight : FALLBACK_ROW_HEIGHT;
+    this.headerHeight = headerHeight > 0 ? headerHeight : this.rowHeight;
+  }
+
+  /**
+   * Compute the row range to render from the scroll position.
+   * @returns First row (inclusive) and last row (exclusive)
+   * @private
+   */
+  private getWindow(): { first: number; last: number } {
+    const rowHeight = this.rowHeight || FALLBACK_ROW_HEIGHT;
+    const viewport = this.scroll?.clientHeight ?? 0;
+    const visibleRows = viewport > 0 ? Math.ceil(viewport / rowHeight) + 1 : DEFAULT_VISIBLE_ROWS;
+    const scrollTop = Math.max(0, (this.scroll?.scrollTop ?? 0) - this.headerHeight);
+    // A jump pins the window even if the container could not scroll (hidden or not laid out)
+    const top = this.anchorRow !== null
+      ? Math.max(0, this.anchorRow - Math.floor(visibleRows / 2))
+      : Math.floor(scrollTop / rowHeight);
+
+    const first = Math.max(0, Math.min(top, this.rowCount - 1) - OVERSCAN_ROWS);
+    const last = Math.min(this.rowCount, top + visibleRows + OVERSCAN_ROWS);
+    return { first, last };
+  }
+
+  /**
+   * Bring the rendered rows in line with the scroll position.
+   * Rows leaving the window are recycled for rows entering it.
+   * @private
+   */
+  private updateWindow(): void {
+    if (!this.table || !this.topSpacer || !this.bottomSpacer) return;
+
+    const { first, last } = this.getWindow();
+    if (first === this.firstRow && last === this.lastRow && this.rows.size === last - first) {
+      return;
+    }
+
+    // Release rows that left the window
+    for (const [index, row] of this.rows) {
+      if (index < first || index >= last) {
+        this.rows.delete(index);
+        this.releaseRow(row);
+      }
+    }
+
+    // Fill rows that entered it, keeping DOM order by address
+    let next: Element = this.bottomSpacer;
+    for (let index = last - 1; index >= first; index--) {
+      let row = this.rows.get(index);
+      if (!row) {
+        row = this.acquireRow(index);
+        this.rows.set(index, row);
+      }
+      if (row.element.nextSibling !== next || row.element.parentNode !== this.table) {
+        this.table.insertBefore(row.element, next);
+      }
+      next = row.element;
+    }
+
+    this.firstRow = first;
+    this.lastRow = last;
+    this.topSpacer.style.height = `${first * this.rowHeight}px`;
+    this.bottomSpacer.style.height = `${(this.rowCount - last) * this.rowHeight}px`;
+  }
+
+  /**
+   * Take a row element from the pool (or create one) and fill it for a row index.
+   * @param index - Row index to display
+   * @returns The filled row
+   * @private
+   */
+  private acquireRow(index: number): MemoryRow {
+    const row = this.rowPool.pop() ?? this.createRow();
+    row.index = index;
+
+    const baseAddr = index * this.bytesPerRow;
+    row.element.setAttribute('data-address', baseAddr.toString());
+    row.addrCell.textContent = this.formatAddress(baseAddr);
 
-    // Calculate which row contains PC
     const pcRow = Math.floor(this.state.pc / this.bytesPerRow);
     const pcCol = this.state.pc % this.bytesPerRow;
-
-    // Create data rows
-    const numRows = Math.ceil(256 / this.bytesPerRow);
-    for (let row = 0; row < numRows; row++) {
-      const rowElement = document.createElement('div');
-      rowElement.className = 'da-memory-row';
-      const baseAddr = row * this.bytesPerRow;
-      rowElement.setAttribute('data-address', baseAddr.toString());
-
-      // Highlight row containing PC
-      if (row === pcRow) {
-        rowElement.classList.add('da-memory-pc');
+    row.element.classList.toggle('da-memory-pc', index === pcRow);
+    row.element.classList.toggle('da-memory-jump-target', index === this.jumpTargetRow);
+
+    for (let col = 0; col < this.bytesPerRow; col++) {
+      const cell = row.cells[col];
+      const addr = baseAddr + col;
+      cell.classList.remove('da-memory-changed');
+      if (addr >= this.size) {
+        // Partial last row
+        cell.textContent = '';
+        row.shown[col] = -1;
+        cell.classList.remove('da-memory-pc-cell');
+        continue;
       }
+      const value = this.state.memory[addr] ?? 0;
+      cell.textContent = this.formatValue(value);
+      row.shown[col] = value;
+      cell.classList.toggle('da-memory-pc-cell', index === pcRow && col === pcCol);
+    }
+    return row;
+  }
+
+  /**
+   * Detach a row element and return it to the pool.
+   * @param row - The row to recycle
+   * @private
+   */
+  private releaseRow(row: MemoryRow): void {
+    row.element.remove();
+    this.rowPool.push(row);
+  }
 
-      // Address column
-      const addrCell = document.createElement('span');
-      addrCell.className = 'da-memory-addr';
-      addrCell.textContent = '0x' + baseAddr.toString(16).toUpperCase().padStart(2, '0');
-      rowElement.appendChild(addrCell);
+  /**
+   * Create a row element with its address and value cells.
+   * @returns A new, unfilled row
+   * @private
+   */
+  private createRow(): MemoryRow {
+    const element = document.createElement('div');
+    element.className = 'da-memory-row';
+
+    // Address column
+    const addrCell = document.createElement('span');
+    addrCell.className = 'da-memory-addr';
+    element.appendChild(addrCell);
+
+    // Memory cells
+    const cells: HTMLElement[] = [];
+    for (let col = 0; col < this.bytesPerRow; col++) {
+      const cell = document.createElement('span');
+      cell.className = 'da-memory-cell';
+      cell.setAttribute('data-offset', col.toString());
+      element.appendChild(cell);
+      cells.push(cell);
+    }
 
-      // Memory cells
+    return { element, addrCell, cells, shown: new Int16Array(this.bytesPerRow), index: -1 };
+  }
+
+  /**
+   * Patch visible cells whose memory value differs from what is shown.
+   * @param flash - Whether changed cells should flash
+   * @param dirty - Optional bitmap limiting which addresses are checked
+   * @private
+   */
+  private patchVisibleCells(flash: boolean, dirty?: Uint32Array): void {
+    const memory = this.state.memory;
+    for (const row of this.rows.values()) {
+      const baseAddr = row.index * this.bytesPerRow;
       for (let col = 0; col < this.bytesPerRow; col++) {
         const addr = baseAddr + col;
-        if (addr >= 256) break;
+        if (row.shown[col] < 0) continue;
+        if (dirty && ((dirty[addr >>> 5] ?? 0) & (1 << (addr & 31))) === 0) continue;
 
-        const cell = document.createElement('span');
-        cell.className = 'da-memory-cell';
-        cell.setAttribute('data-offset', col.toString());
+        const value = memory[addr] ?? 0;
+        if (row.shown[col] === value) continue;
 
-        // Get nibble value (0-15)
-        const value = this.state.memory[addr] ?? 0;
-        cell.textContent = value.toString(16).toUpperCase();
-
-        // Highlight PC cell
-        if (row === pcRow && col === pcCol) {
-          cell.classList.add('da-memory-pc-cell');
+        row.shown[col] = value;
+        const cell = row.cells[col];
+        cell.textContent = this.formatValue(value);
+        if (flash) {
+          cell.classList.add('da-memory-changed');
         }
+      }
+    }
+  }
 
-        // Check if cell changed (not on first render)
-        if (this.previousState !== null) {
-          const prevValue = this.previousState.memory[addr] ?? 0;
-          if (prevValue !== value) {
-            cell.classList.add('da-memory-changed');
-          }
-        }
+  /**
+   * Set or clear the PC row and cell highlight, if that row is rendered.
+   * @param address - PC address
+   * @param on - Whether to add or remove the highlight
+   * @private
+   */
+  private setPcHighlight(address: number, on: boolean): void {
+    const row = this.rows.get(Math.floor(address / this.bytesPerRow));
+    if (!row) return;
+    row.element.classList.toggle('da-memory-pc', on);
+    row.cells[address % this.bytesPerRow]?.classList.toggle('da-memory-pc-cell', on);
+  }
 
-        rowElement.appendChild(cell);
-      }
+  /**
+   * Format an address for the address column.
+   * @param address - Memory address
+   * @returns Hex string such as 0x00 or 0x1F00
+   * @private
+   */
+  private formatAddress(address: number): string {
+    return '0x' + address.toString(16).toUpperCase().padStart(this.addressDigits, '0');
+  }
 
-      table.appendChild(rowElement);
-    }
+  /**
+   * Format a cell value.
+   * @param value - Cell value
+   * @returns Hex string, valueDigits wide
+   * @private
+   */
+  private formatValue(value: number): string {
+    return value.toString(16).toUpperCase().padStart(this.valueDigits, '0');
   }
 
   /**
@@ -311,7 +567,7 @@ export class MemoryView {
 
     let value: number;
 
-    // Hex format: 0x00 to 0xFF
+    // Hex format: 0x00 to 0xFF (wider for larger address spaces)
     if (trimmed.toLowerCase().startsWith('0x')) {
       value = parseInt(trimmed.slice(2), 16);
     } else {
@@ -324,8 +580,8 @@ export class MemoryView {
     }
 
     // Validate range
-    if (value < 0 || value > 255) {
-      return { address: null, error: 'Address out of range (0-255)' };
+    if (value < 0 || value > this.size - 1) {
+      return { address: null, error: `Address out of range (0-${this.size - 1})` };
     }
 
     return { address: Math.floor(value), error: null };
@@ -335,7 +591,7 @@ export class MemoryView {
    * Parse address input string to number (Story 5.6).
    * Supports hex (0x10, 0X10) and decimal (16) formats.
    * @param input - User input string
-   * @returns Parsed address 0-255, or null if invalid
+   * @returns Parsed address 0 to size-1, or null if invalid
    */
   parseAddress(input: string): number | null {
     return this.validateAddress(input).address;
@@ -343,36 +599,58 @@ export class MemoryView {
 
   /**
    * Scroll the memory view to show the specified address (Story 5.6).
-   * @param address - Memory address (0-255)
+   * The target row is scrolled into the rendered window first, since only
+   * rows near the viewport exist in the DOM.
+   * @param address - Memory address (0 to size-1)
    * @private
    */
   private jumpToAddress(address: number): void {
-    const rowAddress = Math.floor(address / this.bytesPerRow) * this.bytesPerRow;
-    const scroll = this.element?.querySelector('.da-memory-view__scroll');
-    const row = this.element?.querySelector(`[data-address="${rowAddress}"]`) as HTMLElement | null;
-
-    if (row && scroll) {
-      // scrollIntoView may not exist in JSDOM, check before calling
-      if (typeof row.scrollIntoView === 'function') {
-        row.scrollIntoView({ behavior: 'smooth', block: 'center' });
-      }
+    if (!this.scroll) return;
+
+    const rowIndex = Math.floor(address / this.bytesPerRow);
+    const viewport = this.scroll.clientHeight;
+    this.scroll.scrollTop = Math.max(
+      0,
+      this.headerHeight + rowIndex * this.rowHeight - Math.max(0, viewport - this.rowHeight) / 2
+    );
+    this.anchorRow = rowIndex;
+    this.updateWindow();
+
+    // Clear any previous highlight and timeout
+    if (this.jumpHighlightTimeout !== null) {
+      clearTimeout(this.jumpHighlightTimeout);
+      this.jumpHighlightTimeout = null;
+    }
+    this.setJumpTarget(null);
 
-      // Clear any previous highlight and timeout
-      if (this.jumpHighlightTimeout !== null) {
-        clearTimeout(this.jumpHighlightTimeout);
-        this.jumpHighlightTimeout = null;
-      }
-      const previousTarget = this.element?.querySelector('.da-memory-jump-target');
-      if (previousTarget) {
-        previousTarget.classList.remove('da-memory-jump-target');
-      }
+    const row = this.rows.get(rowIndex);
+    if (!row) return;
 
-      // Highlight target row briefly
-      row.classList.add('da-memory-jump-target');
-      this.jumpHighlightTimeout = setTimeout(() => {
-        row.classList.remove('da-memory-jump-target');
-        this.jumpHighlightTimeout = null;
-      }, 1000);
+    // scrollIntoView may not exist in JSDOM, check before calling
+    if (typeof row.element.scrollIntoView === 'function') {
+      row.element.scrollIntoView({ behavior: 'smooth', block: 'center' });
+    }
+
+    // Highlight target row briefly; recycled rows pick the highlight up by index
+    this.setJumpTarget(rowIndex);
+    this.jumpHighlightTimeout = setTimeout(() => {
+      this.setJumpTarget(null);
+      this.jumpHighlightTimeout = null;
+    }, 1000);
+  }
+
+  /**
+   * Move the jump highlight to a row index, or clear it.
+   * @param rowIndex - Row to highlight, or null
+   * @private
+   */
+  private setJumpTarget(rowIndex: number | null): void {
+    if (this.jumpTargetRow !== null) {
+      this.rows.get(this.jumpTargetRow)?.element.classList.remove('da-memory-jump-target');
+    }
+    this.jumpTargetRow = rowIndex;
+    if (rowIndex !== null) {
+      this.rows.get(rowIndex)?.element.classList.add('da-memory-jump-target');
     }
   }
 
@@ -429,13 +707,13 @@ export class MemoryView {
   /**
    * Public API: Scroll to a specific address (Story 5.6).
    * Can be called by App.ts or other components.
-   * @param address - Memory address (0-255), can be hex string or number
+   * @param address - Memory address (0 to size-1), can be hex string or number
    * @returns true if jump successful, false if address invalid
    */
   scrollToAddress(address: number | string): boolean {
     const parsed = typeof address === 'string'
       ? this.parseAddress(address)
-      : (Number.isFinite(address) && address >= 0 && address <= 255 ? Math.floor(address) : null);
+      : (Number.isFinite(address) && address >= 0 && address <= this.size - 1 ? Math.floor(address) : null);
 
     if (parsed === null) {
       return false;
@@ -462,6 +740,9 @@ export class MemoryView {
     if (this.element) {
       this.element.removeEventListener('animationend', this.boundAnimationEndHandler);
     }
+    if (this.scroll) {
+      this.scroll.removeEventListener('scroll', this.boundScrollHandler);
+    }
 
     // Remove from DOM
     if (this.element) {
@@ -470,7 +751,14 @@ export class MemoryView {
     }
 
     this.container = null;
-    this.previousState = null;
+    this.scroll = null;
+    this.table = null;
+    this.topSpacer = null;
+    this.bottomSpacer = null;
+    this.rows.clear();
+    this.rowPool = [];
+    this.jumpTargetRow = null;
+    this.anchorRow = null;
     this.isFirstRender = true;
     this.jumpInput = null;
     this.jumpButton = null;
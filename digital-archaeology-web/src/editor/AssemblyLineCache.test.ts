@@ -0,0 +1,148 @@
+// src/editor/AssemblyLineCache.test.ts
+// Unit tests for AssemblyLineCache
+
+import { describe, it, expect, beforeEach } from 'vitest';
+import { AssemblyLineCache, analyzeAssemblyLine } from './AssemblyLineCache';
+import { findLinesWithOpcodes } from './parseInstruction';
+
+const PROGRAM = [
+  '; Add two numbers',
+  'ORG 0x10',
+  'START: LDA 5',
+  '       ADD 6 ; add',
+  'LOOP:',
+  '       JZ LOOP',
+  'DATA:  DB 1, 2, 3',
+  '       DW 0x1234',
+  '       STA 7',
+  '       HLT',
+].join('\n');
+
+describe('analyzeAssemblyLine', () => {
+  it('should classify instructions', () => {
+    expect(analyzeAssemblyLine('  START: lda 5 ; go')).toEqual({ opcode: 'LDA', org: null, size: 2, steppable: true });
+  });
+
+  it('should parse ORG addresses in decimal and hex', () => {
+    expect(analyzeAssemblyLine('ORG 16').org).toBe(16);
+    expect(analyzeAssemblyLine('ORG 0x10').org).toBe(16);
+    expect(analyzeAssemblyLine('ORG $1F').org).toBe(31);
+    expect(analyzeAssemblyLine('ORG 1F').org).toBe(31);
+  });
+
+  it('should size DB and DW data', () => {
+    expect(analyzeAssemblyLine('DB 1, 2, 3')).toMatchObject({ size: 6, steppable: false });
+    expect(analyzeAssemblyLine('TABLE: DW 1, 2')).toMatchObject({ size: 8, steppable: false });
+  });
+
+  it('should ignore blank, comment and label-only lines', () => {
+    for (const line of ['', '   ', '; note', 'LOOP:', '  ; indented']) {
+      expect(analyzeAssemblyLine(line)).toMatchObject({ opcode: null, size: 0, steppable: false });
+    }
+  });
+});
+
+describe('AssemblyLineCache', () => {
+  let cache: AssemblyLineCache;
+
+  beforeEach(() => {
+    cache = new AssemblyLineCache();
+  });
+
+  describe('buildSourceMap', () => {
+    it('should lay out instructions and data from ORG', () => {
+      cache.update(PROGRAM);
+
+      const { addressToLine, lineToAddress } = cache.buildSourceMap();
+
+      expect([...lineToAddress]).toEqual([
+        [3, 0x10],
+        [4, 0x12],
+        [6, 0x14],
+        [9, 0x20],
+        [10, 0x22],
+      ]);
+      expect(addressToLine.get(0x20)).toBe(9);
+    });
+
+    it('should follow edits', () => {
+      cache.update(PROGRAM);
+      cache.update(PROGRAM.replace('ORG 0x10', 'ORG 0x20'));
+
+      expect(cache.buildSourceMap().lineToAddress.get(3)).toBe(0x20);
+    });
+  });
+
+  describe('findLinesWithOpcodes', () => {
+    it('should match the uncached search', () => {
+      cache.update(PROGRAM);
+
+      for (const opcodes of [['LDA'], ['add', 'hlt'], ['JZ', 'STA'], ['DB'], []]) {
+        expect(cache.findLinesWithOpcodes(opcodes)).toEqual(findLinesWithOpcodes(PROGRAM, opcodes));
+      }
+    });
+  });
+
+  describe('incremental updates', () => {
+    it('should analyze every distinct line on the first update', () => {
+      cache.update('LDA 5\nADD 6\nLDA 5');
+
+      expect(cache.getLastStats()).toEqual({ analyzed: 2, reused: 1 });
+      expect(cache.lineCount).toBe(3);
+    });
+
+    it('should only analyze the edited line', () => {
+      cache.update(PROGRAM);
+      cache.update(PROGRAM.replace('STA 7', 'STA 8'));
+
+      expect(cache.getLastStats()).toEqual({ analyzed: 1, reused: 9 });
+      expect(cache.getLineInfo(9)?.opcode).toBe('STA');
+    });
+
+    it('should shift following lines on insert and delete', () => {
+      cache.update('LDA 5\nHLT');
+      cache.update('LDA 5\nADD 6\nHLT');
+
+      expect(cache.getLastStats()).toEqual({ analyzed: 1, reused: 2 });
+      expect(cache.findLinesWithOpcodes(['HLT'])).toEqual([3]);
+
+      cache.update('HLT');
+      expect(cache.getLastStats()).toEqual({ analyzed: 0, reused: 1 });
+      expect(cache.findLinesWithOpcodes(['HLT'])).toEqual([1]);
+    });
+
+    it('should reuse moved and re-indented lines', () => {
+      cache.update('LDA 5\nADD 6\nSTA 7');
+      cache.update('STA 7\n    LDA 5\nADD 6');
+
+      expect(cache.getLastStats()).toEqual({ analyzed: 0, reused: 3 });
+      expect(cache.findLinesWithOpcodes(['LDA'])).toEqual([2]);
+    });
+
+    it('should stay consistent with a fresh cache over a series of edits', () => {
+      const edits = [
+        PROGRAM,
+        PROGRAM.replace('HLT', 'JMP START'),
+        `ORG 4\n${PROGRAM}`,
+        PROGRAM.split('\n').slice(3).join('\n'),
+        '',
+        PROGRAM,
+      ];
+
+      for (const source of edits) {
+        cache.update(source);
+        const fresh = new AssemblyLineCache();
+        fresh.update(source);
+        expect(cache.buildSourceMap()).toEqual(fresh.buildSourceMap());
+      }
+    });
+
+    it('should re-analyze everything after reset', () => {
+      cache.update(PROGRAM);
+      cache.reset();
+      cache.update(PROGRAM);
+
+      expect(cache.getLastStats().analyzed).toBe(10);
+    });
+  });
+});
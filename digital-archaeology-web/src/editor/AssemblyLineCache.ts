@@ -0,0 +1,231 @@
+// src/editor/AssemblyLineCache.ts
+// Per-line analysis cache for assembly source (source maps, code-circuit linking)
+
+import { parseInstruction } from './parseInstruction';
+
+/**
+ * What one assembly line contributes to the program.
+ */
+export interface AssemblyLineInfo {
+  /** Executable opcode (uppercase), or null (see parseInstruction) */
+  opcode: string | null;
+  /** Target address when the line is an ORG directive, otherwise null */
+  org: number | null;
+  /** Nibbles the line occupies in memory */
+  size: number;
+  /** Whether the line is an instruction the CPU can step to */
+  steppable: boolean;
+}
+
+/**
+ * PC-to-line correlation built from the cached lines.
+ */
+export interface AssemblySourceMap {
+  /** Map from memory address (PC value) to source line number (1-based) */
+  addressToLine: Map<number, number>;
+  /** Map from source line number (1-based) to memory address */
+  lineToAddress: Map<number, number>;
+}
+
+/**
+ * Line counts from the most recent update.
+ */
+export interface AssemblyLineCacheStats {
+  /** Lines analyzed because their content was not cached */
+  analyzed: number;
+  /** Lines whose cached analysis was reused */
+  reused: number;
+}
+
+/** Nibbles per Micro4 instruction (opcode + operand) */
+const INSTRUCTION_NIBBLES = 2;
+
+/** Shared result for lines that contribute nothing */
+const NOTHING: AssemblyLineInfo = Object.freeze({ opcode: null, org: null, size: 0, steppable: false });
+
+/**
+ * Analyze one line of assembly.
+ * @param line - The line content (leading/trailing whitespace is ignored)
+ * @returns What the line contributes to the program
+ */
+export function analyzeAssemblyLine(line: string): AssemblyLineInfo {
+  const trimmed = line.trim();
+
+  // Skip empty and comment-only lines
+  if (!trimmed || trimmed.startsWith(';')) return NOTHING;
+
+  // Strip inline comments for parsing
+  const codePart = trimmed.split(';')[0].trim();
+  if (!codePart) return NOTHING;
+
+  // ORG directive (supports decimal, 0x hex, and $ hex prefix)
+  const orgMatch = codePart.match(/^ORG\s+(?:0x|\$)?([0-9A-Fa-f]+)/i);
+  if (orgMatch) {
+    // Determine base: if original had 0x or $ prefix, or if contains a-f, use hex
+    const hasHexPrefix = /^ORG\s+(?:0x|\$)/i.test(codePart);
+    const hasHexDigits = /[A-Fa-f]/.test(orgMatch[1]);
+    const base = (hasHexPrefix || hasHexDigits) ? 16 : 10;
+    return { opcode: null, org: parseInt(orgMatch[1], base), size: 0, steppable: false };
+  }
+
+  // Label-only lines
+  const labelMatch = codePart.match(/^([A-Za-z_][A-Za-z0-9_]*):(.*)$/);
+  if (labelMatch && !labelMatch[2].trim()) return NOTHING;
+
+  // DB/DW consume 1 byte (2 nibbles) / 2 bytes (4 nibbles) per value
+  const dataMatch = codePart.match(/^(?:[A-Za-z_][A-Za-z0-9_]*:\s*)?(DB|DW)\s+(.+)/i);
+  if (dataMatch) {
+    const nibbles = dataMatch[1].toUpperCase() === 'DB' ? 2 : 4;
+    return { opcode: null, org: null, size: dataMatch[2].split(',').length * nibbles, steppable: false };
+  }
+
+  return { opcode: parseInstruction(trimmed), org: null, size: INSTRUCTION_NIBBLES, steppable: true };
+}
+
+/**
+ * Keeps the analysis of every line of an assembly source and, on update,
+ * re-analyzes only lines whose content is new. Unchanged leading and
+ * trailing lines are kept without lookups; other lines are looked up by
+ * trimmed content, so moved or duplicated lines are not re-analyzed either.
+ *
+ * Address layout is recomputed from the cached lines on demand; it is a
+ * single pass with no parsing.
+ *
+ * @example
+ * ```typescript
+ * const lines = new AssemblyLineCache();
+ * lines.update(editor.getValue());
+ * const { addressToLine } = lines.buildSourceMap();
+ * ```
+ */
+export class AssemblyLineCache {
+  private lines: string[] = [];
+  private infos: AssemblyLineInfo[] = [];
+  /** Analysis per trimmed line content */
+  private byContent = new Map<string, AssemblyLineInfo>();
+  private lastStats: AssemblyLineCacheStats = { analyzed: 0, reused: 0 };
+
+  /**
+   * Number of lines in the cached source.
+   */
+  get lineCount(): number {
+    return this.lines.length;
+  }
+
+  /**
+   * Bring the cache up to date with the source.
+   * @param source - The full assembly source
+   */
+  update(source: string): void {
+    const next = source.split('\n');
+    const prev = this.lines;
+
+    // Lines outside the edited region keep their analysis
+    let start = 0;
+    const maxCommon = Math.min(prev.length, next.length);
+    while (start < maxCommon && prev[start] === next[start]) start++;
+    let end = 0;
+    while (end < maxCommon - start && prev[prev.length - 1 - end] === next[next.length - 1 - end]) end++;
+
+    let analyzed = 0;
+    const changed: AssemblyLineInfo[] = [];
+    for (let i = start; i < next.length - end; i++) {
+      const key = next[i].trim();
+      let info = this.byContent.get(key);
+      if (!info) {
+        info = analyzeAssemblyLine(key);
+        this.byContent.set(key, info);
+        analyzed++;
+      }
+      changed.push(info);
+    }
+
+    this.infos = this.infos.slice(0, start).concat(changed, this.infos.slice(prev.length - end));
+    this.lines = next;
+    this.lastStats = { analyzed, reused: next.length - analyzed };
+    this.pruneContentCache();
+  }
+
+  /**
+   * Get the analysis of a line.
+   * @param lineNumber - 1-based line number
+   * @returns The line's analysis, or undefined if out of range
+   */
+  getLineInfo(lineNumber: number): AssemblyLineInfo | undefined {
+    return this.infos[lineNumber - 1];
+  }
+
+  /**
+   * Find all lines that contain one of the given opcodes.
+   * @param opcodes - Opcodes to search for (case-insensitive)
+   * @returns 1-based line numbers in ascending order
+   */
+  findLinesWithOpcodes(opcodes: string[]): number[] {
+    if (opcodes.length === 0) return [];
+
+    const wanted = new Set(opcodes.map((op) => op.toUpperCase()));
+    const matchingLines: number[] = [];
+    for (let i = 0; i < this.infos.length; i++) {
+      const opcode = this.infos[i].opcode;
+      if (opcode && wanted.has(opcode)) {
+        matchingLines.push(i + 1);
+      }
+    }
+    return matchingLines;
+  }
+
+  /**
+   * Lay out the cached lines in memory and map steppable lines to addresses.
+   * @returns Source map for PC-to-line correlation
+   */
+  buildSourceMap(): AssemblySourceMap {
+    const addressToLine = new Map<number, number>();
+    const lineToAddress = new Map<number, number>();
+    let address = 0;
+
+    for (let i = 0; i < this.infos.length; i++) {
+      const info = this.infos[i];
+      if (info.org !== null) {
+        address = info.org;
+        continue;
+      }
+      if (info.steppable) {
+        addressToLine.set(address, i + 1);
+        lineToAddress.set(i + 1, address);
+      }
+      address += info.size;
+    }
+
+    return { addressToLine, lineToAddress };
+  }
+
+  /**
+   * Get line counts from the most recent update.
+   */
+  getLastStats(): AssemblyLineCacheStats {
+    return { ...this.lastStats };
+  }
+
+  /**
+   * Forget all cached lines.
+   */
+  reset(): void {
+    this.lines = [];
+    this.infos = [];
+    this.byContent.clear();
+    this.lastStats = { analyzed: 0, reused: 0 };
+  }
+
+  /**
+   * Drop cached contents no longer in the source once the cache has grown
+   * well past the source size, so long editing sessions stay bounded.
+   */
+  private pruneContentCache(): void {
+    if (this.byContent.size <= 2 * this.lines.length + 256) return;
+
+    const live = new Set(this.lines.map((line) => line.trim()));
+    for (const key of this.byContent.keys()) {
+      if (!live.has(key)) this.byContent.delete(key);
+    }
+  }
+}
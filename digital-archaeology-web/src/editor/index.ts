@@ -14,3 +14,7 @@ export { parseInstruction } from './parseInstruction';
 
 // Story 6.10: Find lines with specific opcodes for circuit-to-code linking
 export { findLinesWithOpcodes } from './parseInstruction';
+
+// Per-line analysis cache for source maps and code-circuit linking
+export { AssemblyLineCache, analyzeAssemblyLine } from './AssemblyLineCache';
+export type { AssemblyLineInfo, AssemblySourceMap, AssemblyLineCacheStats } from './AssemblyLineCache';
@@ -7,7 +7,8 @@
 
 import { describe, it, expect, vi, beforeEach, afterEach } from 'vitest';
 import { EmulatorBridge } from './EmulatorBridge';
-import type { CPUState, EmulatorEvent } from './types';
+import type { CPUState, EmulatorEvent, EmulatorModule } from './types';
+import { StateRingWriter } from './stateRing';
 
 // Mock Worker class
 class MockWorker {
@@ -437,6 +438,49 @@ describe('EmulatorBridge', () => {
       });
     });
 
+    it('should not send SET_SPEED for the speed already running', () => {
+      bridge.run(60);
+      bridge.setSpeed(60);
+
+      const setSpeedCalls = mockWorker.postMessage.mock.calls.filter(
+        (call) => call[0]?.type === 'SET_SPEED'
+      );
+      expect(setSpeedCalls.length).toBe(0);
+    });
+
+    it('should coalesce rapid speed changes to the latest value per frame', async () => {
+      bridge.run(60);
+      bridge.setSpeed(100);
+      bridge.setSpeed(200);
+      bridge.setSpeed(300);
+
+      const speeds = () =>
+        mockWorker.postMessage.mock.calls
+          .filter((call) => call[0]?.type === 'SET_SPEED')
+          .map((call) => call[0].payload.speed);
+      expect(speeds()).toEqual([100]);
+
+      await new Promise((resolve) => setTimeout(resolve, 50));
+
+      expect(speeds()).toEqual([100, 300]);
+    });
+
+    it('should drop a held speed change when stopped', async () => {
+      bridge.run(60);
+      bridge.setSpeed(100);
+      bridge.setSpeed(200);
+      const stopPromise = bridge.stop();
+      mockWorker.simulateMessage({ type: 'STATE_UPDATE', payload: createMockCPUState() });
+      await stopPromise;
+
+      await new Promise((resolve) => setTimeout(resolve, 50));
+
+      const setSpeedCalls = mockWorker.postMessage.mock.calls.filter(
+        (call) => call[0]?.type === 'SET_SPEED'
+      );
+      expect(setSpeedCalls.length).toBe(1);
+    });
+
     it('should throw if not initialized', async () => {
       const uninitializedBridge = new EmulatorBridge();
 
@@ -491,6 +535,24 @@ describe('EmulatorBridge', () => {
       expect(result.instructions).toBe(21);
     });
 
+    it('should share one STOP request between concurrent calls', async () => {
+      bridge.run(60);
+      const first = bridge.stop();
+      const second = bridge.stop();
+
+      mockWorker.simulateMessage({
+        type: 'STATE_UPDATE',
+        payload: createMockCPUState({ pc: 3 }),
+      });
+
+      expect((await first).pc).toBe(3);
+      expect((await second).pc).toBe(3);
+      const stopCalls = mockWorker.postMessage.mock.calls.filter(
+        (call) => call[0]?.type === 'STOP'
+      );
+      expect(stopCalls.length).toBe(1);
+    });
+
     it('should clear isRunning flag', async () => {
       bridge.run(60);
 
@@ -608,6 +670,29 @@ describe('EmulatorBridge', () => {
       expect(mockWorker.postMessage).toHaveBeenCalledWith({ type: 'GET_STATE' });
     });
 
+    it('should share one GET_STATE request between concurrent calls', async () => {
+      const first = bridge.getState();
+      const second = bridge.getState();
+
+      mockWorker.simulateMessage({
+        type: 'STATE_UPDATE',
+        payload: createMockCPUState({ pc: 5 }),
+      });
+
+      expect((await first).pc).toBe(5);
+      expect((await second).pc).toBe(5);
+
+      // A later call sends a new request
+      const third = bridge.getState();
+      mockWorker.simulateMessage({ type: 'STATE_UPDATE', payload: createMockCPUState() });
+      await third;
+
+      const getStateCalls = mockWorker.postMessage.mock.calls.filter(
+        (call) => call[0]?.type === 'GET_STATE'
+      );
+      expect(getStateCalls.length).toBe(2);
+    });
+
     it('should return current CPUState', async () => {
       const getStatePromise = bridge.getState();
 
@@ -929,6 +1014,93 @@ describe('EmulatorBridge', () => {
     });
   });
 
+  describe('connectCircuitPort()', () => {
+    it('should transfer the port to the worker before WASM is ready', () => {
+      bridge.init();
+      const port = { close: vi.fn() } as unknown as MessagePort;
+
+      expect(bridge.connectCircuitPort(port)).toBe(true);
+      expect(mockWorker.postMessage).toHaveBeenCalledWith(
+        { type: 'CONNECT_CIRCUIT_PORT', payload: { port } },
+        [port]
+      );
+    });
+
+    it('should close the port when there is no worker', () => {
+      const port = { close: vi.fn() } as unknown as MessagePort;
+
+      expect(bridge.connectCircuitPort(port)).toBe(false);
+      expect(port.close).toHaveBeenCalled();
+    });
+  });
+
+  describe('shared state ring', () => {
+    it('should not attach a ring without cross-origin isolation', async () => {
+      vi.stubGlobal('crossOriginIsolated', false);
+      const initPromise = bridge.init();
+      mockWorker.simulateMessage({ type: 'EMULATOR_READY' });
+      await initPromise;
+
+      expect(bridge.usesStateRing).toBe(false);
+      expect(mockWorker.postMessage).not.toHaveBeenCalledWith(
+        expect.objectContaining({ type: 'ATTACH_STATE_RING' })
+      );
+    });
+
+    it('should deliver ring frames to subscribers once per animation frame while running', async () => {
+      vi.stubGlobal('crossOriginIsolated', true);
+      const frames: Array<() => void> = [];
+      vi.stubGlobal('requestAnimationFrame', vi.fn((cb: () => void) => frames.push(cb)));
+      vi.stubGlobal('cancelAnimationFrame', vi.fn());
+
+      const initPromise = bridge.init();
+      mockWorker.simulateMessage({ type: 'EMULATOR_READY' });
+      await initPromise;
+
+      expect(bridge.usesStateRing).toBe(true);
+      const attach = mockWorker.postMessage.mock.calls.find(
+        (call) => call[0].type === 'ATTACH_STATE_RING'
+      );
+      const writer = new StateRingWriter(attach![0].payload.buffer);
+      let pc = 0;
+      const module = {
+        HEAPU8: new Uint8Array(512),
+        _get_memory_ptr: () => 0,
+        _get_pc: () => pc,
+        _get_accumulator: () => 0,
+        _get_zero_flag: () => 0,
+        _is_halted: () => 0,
+        _has_error: () => 0,
+        _get_ir: () => 0,
+        _get_mar: () => 0,
+        _get_mdr: () => 0,
+        _get_cycles: () => 0,
+        _get_instructions: () => 0,
+      } as unknown as EmulatorModule;
+
+      const callback = vi.fn();
+      bridge.onStateUpdate(callback);
+      bridge.run(0);
+
+      // Several ticks between two frames reach subscribers as one update
+      for (pc = 1; pc <= 3; pc++) writer.write(module);
+      frames.shift()!();
+      expect(callback).toHaveBeenCalledTimes(1);
+      expect(callback.mock.calls[0][0].pc).toBe(3);
+
+      // No new ticks, no update
+      frames.shift()!();
+      expect(callback).toHaveBeenCalledTimes(1);
+
+      // Polling ends with the run
+      mockWorker.simulateMessage({ type: 'HALTED' });
+      writer.write(module);
+      frames.shift()!();
+      expect(callback).toHaveBeenCalledTimes(1);
+      expect(frames.length).toBe(0);
+    });
+  });
+
   describe('timeout handling', () => {
     beforeEach(async () => {
       const initPromise = bridge.init();
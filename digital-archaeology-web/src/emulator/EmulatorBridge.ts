@@ -14,6 +14,7 @@ import type {
   CPUState,
   RuntimeErrorContext,
 } from './types';
+import { StateRingReader, createStateRingBuffer, isStateRingSupported } from './stateRing';
 
 /**
  * Default timeout for emulator operations in milliseconds.
@@ -27,9 +28,31 @@ const DEFAULT_TIMEOUT_MS = 10000;
  */
 const INIT_TIMEOUT_MS = 30000;
 
+/**
+ * Run a callback on the next animation frame (or after ~16ms without one).
+ * @returns Handle for cancelFrame()
+ */
+function requestFrame(callback: () => void): number {
+  return typeof requestAnimationFrame === 'function'
+    ? requestAnimationFrame(callback)
+    : (setTimeout(callback, 16) as unknown as number);
+}
+
+/**
+ * Cancel a callback scheduled with requestFrame().
+ */
+function cancelFrame(handle: number): void {
+  if (typeof cancelAnimationFrame === 'function') {
+    cancelAnimationFrame(handle);
+  } else {
+    clearTimeout(handle);
+  }
+}
+
 /**
  * Callback type for CPU state updates.
- * Called during RUN mode with each state update from the worker.
+ * Called during RUN mode with each state update from the worker, or at most
+ * once per animation frame when the shared state ring is in use.
  * Also called after loadProgram, step, stop, reset, and getState operations.
  *
  * @param state - Complete CPU state snapshot including PC, accumulator, flags, and memory
@@ -123,6 +146,18 @@ export class EmulatorBridge {
   // Bound handler for cleanup
   private boundMessageHandler: ((e: MessageEvent) => void) | null = null;
 
+  // Shared state ring (null when not cross-origin isolated) and its poll loop
+  private stateRing: StateRingReader | null = null;
+  private stateRingPollId: number | null = null;
+
+  // Command coalescing: SET_SPEED is sent at most once per frame (latest value
+  // wins), and concurrent getState()/stop() calls share one request
+  private sentSpeed: number | null = null;
+  private pendingSpeed: number | null = null;
+  private speedFlushId: number | null = null;
+  private pendingGetState: Promise<CPUState> | null = null;
+  private pendingStop: Promise<CPUState> | null = null;
+
   /**
    * Whether the bridge is initialized and ready for use.
    */
@@ -172,6 +207,7 @@ export class EmulatorBridge {
           this.worker?.removeEventListener('error', handleError);
           this.initialized = true;
           this.setupPermanentListener();
+          this.attachStateRing();
           resolve();
         } else if (data.type === 'ERROR' && !this.initialized) {
           // Error during initialization
@@ -209,25 +245,123 @@ export class EmulatorBridge {
     this.worker.addEventListener('message', this.boundMessageHandler);
   }
 
+  /**
+   * Hand the worker a shared state ring, so RUN ticks are read from shared
+   * memory once per animation frame instead of arriving as messages.
+   * Skipped (postMessage is used) when the page is not cross-origin isolated.
+   */
+  private attachStateRing(): void {
+    if (!this.worker || !isStateRingSupported()) return;
+
+    const buffer = createStateRingBuffer();
+    this.worker.postMessage({
+      type: 'ATTACH_STATE_RING',
+      payload: { buffer },
+    } satisfies EmulatorCommand);
+    this.stateRing = new StateRingReader(buffer);
+  }
+
+  /**
+   * Whether RUN state updates come through the shared state ring.
+   */
+  get usesStateRing(): boolean {
+    return this.stateRing !== null;
+  }
+
+  /**
+   * Start polling the state ring once per animation frame while running.
+   */
+  private startStateRingPolling(): void {
+    if (!this.stateRing || this.stateRingPollId !== null) return;
+    this.scheduleStateRingPoll();
+  }
+
+  /**
+   * Schedule the next state ring poll.
+   */
+  private scheduleStateRingPoll(): void {
+    const poll = (): void => {
+      this.stateRingPollId = null;
+      if (!this.isRunning || !this.stateRing) return;
+
+      const state = this.stateRing.read();
+      if (state) {
+        this.stateUpdateSubscribers.forEach((cb) => cb(state));
+      }
+      this.scheduleStateRingPoll();
+    };
+
+    this.stateRingPollId = requestFrame(poll);
+  }
+
+  /**
+   * Stop polling the state ring.
+   */
+  private stopStateRingPolling(): void {
+    if (this.stateRingPollId === null) return;
+    cancelFrame(this.stateRingPollId);
+    this.stateRingPollId = null;
+  }
+
+  /**
+   * Send SET_SPEED unless the worker already runs at that speed, then hold
+   * further changes until the next frame.
+   */
+  private sendSpeed(speed: number): void {
+    if (!this.worker || speed === this.sentSpeed) return;
+
+    this.worker.postMessage({
+      type: 'SET_SPEED',
+      payload: { speed },
+    } satisfies EmulatorCommand);
+    this.sentSpeed = speed;
+
+    this.speedFlushId = requestFrame(() => {
+      this.speedFlushId = null;
+      const next = this.pendingSpeed;
+      this.pendingSpeed = null;
+      if (next !== null && this.isRunning) {
+        this.sendSpeed(next);
+      }
+    });
+  }
+
+  /**
+   * Drop any held speed change and forget the speed sent to the worker.
+   */
+  private cancelSpeedChanges(): void {
+    if (this.speedFlushId !== null) {
+      cancelFrame(this.speedFlushId);
+      this.speedFlushId = null;
+    }
+    this.pendingSpeed = null;
+    this.sentSpeed = null;
+  }
+
   /**
    * Handle worker events and dispatch to subscribers.
    */
   private handleWorkerEvent(event: EmulatorEvent): void {
     switch (event.type) {
       case 'STATE_UPDATE':
+        // A state sent by message is newer than anything left in the ring
+        this.stateRing?.skipPublished();
         this.stateUpdateSubscribers.forEach((cb) => cb(event.payload));
         break;
       case 'HALTED':
         this.isRunning = false;
+        this.cancelSpeedChanges();
         this.haltedSubscribers.forEach((cb) => cb());
         break;
       case 'ERROR':
         this.isRunning = false;
+        this.cancelSpeedChanges();
         this.errorSubscribers.forEach((cb) => cb(event.payload));
         break;
       case 'BREAKPOINT_HIT':
         // Breakpoint hit during RUN - stop execution (Story 5.8)
         this.isRunning = false;
+        this.cancelSpeedChanges();
         this.breakpointHitSubscribers.forEach((cb) => cb(event.payload.address));
         break;
       case 'BREAKPOINTS_LIST':
@@ -274,38 +408,47 @@ export class EmulatorBridge {
 
   /**
    * Start continuous execution.
+   * The worker paces itself to the requested rate and publishes at most one
+   * state per animation frame.
    *
-   * @param speed - Execution speed (0 = max speed, >0 = instructions per ~16ms tick)
+   * @param speed - Instructions per second (0 = as fast as possible)
    */
   run(speed: number): void {
     this.ensureInitialized();
     if (this.isRunning) return; // Already running
 
     this.isRunning = true;
+    this.sentSpeed = speed;
     this.worker!.postMessage({
       type: 'RUN',
       payload: { speed },
     } satisfies EmulatorCommand);
+    this.startStateRingPolling();
   }
 
   /**
    * Change execution speed while running.
-   * Only affects execution if currently running.
+   * Only affects execution if currently running. Changes arriving faster
+   * than once per animation frame (slider drags) are coalesced, and a speed
+   * equal to the current one is not sent.
    *
-   * @param speed - New execution speed (0 = max speed, >0 = instructions per ~16ms tick)
+   * @param speed - New execution speed in instructions per second (0 = as fast as possible)
    */
   setSpeed(speed: number): void {
     this.ensureInitialized();
     if (!this.isRunning || !this.worker) return;
 
-    this.worker.postMessage({
-      type: 'SET_SPEED',
-      payload: { speed },
-    } satisfies EmulatorCommand);
+    if (this.speedFlushId !== null) {
+      // A SET_SPEED already went out this frame; send the latest value next frame
+      this.pendingSpeed = speed;
+      return;
+    }
+    this.sendSpeed(speed);
   }
 
   /**
    * Stop continuous execution.
+   * Concurrent calls share one STOP request.
    *
    * @returns Promise resolving to current CPU state when stopped
    * @throws Error if bridge is not initialized or operation times out
@@ -315,7 +458,15 @@ export class EmulatorBridge {
     const worker = this.worker!;
 
     this.isRunning = false;
-    return this.sendCommandAndWaitForState(worker, { type: 'STOP' });
+    this.stopStateRingPolling();
+    this.cancelSpeedChanges();
+
+    if (!this.pendingStop) {
+      this.pendingStop = this.sendCommandAndWaitForState(worker, { type: 'STOP' }).finally(() => {
+        this.pendingStop = null;
+      });
+    }
+    return this.pendingStop;
   }
 
   /**
@@ -330,9 +481,8 @@ export class EmulatorBridge {
     const worker = this.worker!;
 
     if (this.isRunning) {
-      this.isRunning = false;
       // Wait for STOP to complete before sending RESET to avoid race condition
-      await this.sendCommandAndWaitForState(worker, { type: 'STOP' });
+      await this.stop();
     }
 
     return this.sendCommandAndWaitForState(worker, { type: 'RESET' });
@@ -340,6 +490,7 @@ export class EmulatorBridge {
 
   /**
    * Get current CPU state without modifying it.
+   * Concurrent calls share one GET_STATE request.
    *
    * @returns Promise resolving to current CPU state
    * @throws Error if bridge is not initialized or operation times out
@@ -348,7 +499,12 @@ export class EmulatorBridge {
     this.ensureInitialized();
     const worker = this.worker!;
 
-    return this.sendCommandAndWaitForState(worker, { type: 'GET_STATE' });
+    if (!this.pendingGetState) {
+      this.pendingGetState = this.sendCommandAndWaitForState(worker, { type: 'GET_STATE' }).finally(() => {
+        this.pendingGetState = null;
+      });
+    }
+    return this.pendingGetState;
   }
 
   /**
@@ -448,6 +604,27 @@ export class EmulatorBridge {
     });
   }
 
+  /**
+   * Also send every STATE_UPDATE to a MessagePort, so a consumer in another
+   * worker (the circuit render worker) gets CPU state without a hop through
+   * the main thread. Replaces any previously connected port.
+   * Works as soon as the worker exists; WASM need not be loaded yet.
+   *
+   * @param port - Port to transfer to the emulator worker
+   * @returns False (and the port is closed) if there is no worker
+   */
+  connectCircuitPort(port: MessagePort): boolean {
+    if (!this.worker) {
+      port.close();
+      return false;
+    }
+    this.worker.postMessage(
+      { type: 'CONNECT_CIRCUIT_PORT', payload: { port } } satisfies EmulatorCommand,
+      [port]
+    );
+    return true;
+  }
+
   /**
    * Subscribe to CPU state updates during RUN.
    *
@@ -512,6 +689,11 @@ export class EmulatorBridge {
    * After calling this, the bridge cannot be reused.
    */
   terminate(): void {
+    this.stopStateRingPolling();
+    this.cancelSpeedChanges();
+    this.pendingGetState = null;
+    this.pendingStop = null;
+    this.stateRing = null;
     if (this.worker) {
       if (this.boundMessageHandler) {
         this.worker.removeEventListener('message', this.boundMessageHandler);
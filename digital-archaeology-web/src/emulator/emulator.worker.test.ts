@@ -5,7 +5,7 @@
  * Uses mocked WASM module to test worker logic in isolation.
  */
 
-import { describe, it, expect, vi, beforeEach } from 'vitest';
+import { describe, it, expect, vi, beforeEach, afterEach } from 'vitest';
 import {
   isEmulatorCommand,
   readCPUState,
@@ -16,10 +16,13 @@ import {
   handleReset,
   handleGetState,
   handleSetSpeed,
+  handleConnectCircuitPort,
+  handleAttachStateRing,
   classifyError,
   buildErrorContext,
 } from './emulator.worker';
 import type { EmulatorModule, EmulatorCommand, CPUState } from './types';
+import { createStateRingBuffer, StateRingReader } from './stateRing';
 
 /**
  * Create a mock EmulatorModule for testing.
@@ -75,8 +78,8 @@ describe('Emulator Worker', () => {
     // Setup global mocks - self is the worker global scope
     vi.stubGlobal('self', {
       postMessage: mockPostMessage,
-      setInterval: vi.fn(() => 1),
-      clearInterval: vi.fn(),
+      setTimeout: vi.fn(() => 1),
+      clearTimeout: vi.fn(),
     });
   });
 
@@ -273,6 +276,24 @@ describe('Emulator Worker', () => {
       };
       expect(isEmulatorCommand(command)).toBe(false);
     });
+
+    it('should accept CONNECT_CIRCUIT_PORT with a port', () => {
+      const { port1 } = new MessageChannel();
+      expect(isEmulatorCommand({ type: 'CONNECT_CIRCUIT_PORT', payload: { port: port1 } })).toBe(true);
+      expect(isEmulatorCommand({ type: 'CONNECT_CIRCUIT_PORT', payload: {} })).toBe(false);
+      port1.close();
+    });
+
+    it('should accept ATTACH_STATE_RING only with a ring buffer', () => {
+      const buffer = createStateRingBuffer();
+      expect(isEmulatorCommand({ type: 'ATTACH_STATE_RING', payload: { buffer } })).toBe(true);
+      expect(
+        isEmulatorCommand({ type: 'ATTACH_STATE_RING', payload: { buffer: new ArrayBuffer(1024) } })
+      ).toBe(false);
+      expect(
+        isEmulatorCommand({ type: 'ATTACH_STATE_RING', payload: { buffer: new SharedArrayBuffer(8) } })
+      ).toBe(false);
+    });
   });
 
   describe('readCPUState', () => {
@@ -519,23 +540,13 @@ describe('Emulator Worker', () => {
   });
 
   describe('handleRun', () => {
-    it('should start interval with configured speed', () => {
+    it('should schedule the first tick immediately', () => {
       const module = createMockModule();
 
       handleRun(module, 100);
 
       // eslint-disable-next-line @typescript-eslint/no-explicit-any
-      expect((self as any).setInterval).toHaveBeenCalledWith(expect.any(Function), 16);
-      handleStop(); // Clean up
-    });
-
-    it('should use 0ms interval for max speed (speed=0)', () => {
-      const module = createMockModule();
-
-      handleRun(module, 0);
-
-      // eslint-disable-next-line @typescript-eslint/no-explicit-any
-      expect((self as any).setInterval).toHaveBeenCalledWith(expect.any(Function), 0);
+      expect((self as any).setTimeout).toHaveBeenCalledWith(expect.any(Function), 0);
       handleStop(); // Clean up
     });
 
@@ -547,7 +558,7 @@ describe('Emulator Worker', () => {
       handleStop(); // Clean up
 
       // eslint-disable-next-line @typescript-eslint/no-explicit-any
-      expect((self as any).setInterval).toHaveBeenCalledTimes(1);
+      expect((self as any).setTimeout).toHaveBeenCalledTimes(1);
     });
 
     it('should not start if already halted', () => {
@@ -558,7 +569,7 @@ describe('Emulator Worker', () => {
       handleRun(module, 100);
 
       // eslint-disable-next-line @typescript-eslint/no-explicit-any
-      expect((self as any).setInterval).not.toHaveBeenCalled();
+      expect((self as any).setTimeout).not.toHaveBeenCalled();
     });
 
     it('should not start if in error state', () => {
@@ -569,19 +580,19 @@ describe('Emulator Worker', () => {
       handleRun(module, 100);
 
       // eslint-disable-next-line @typescript-eslint/no-explicit-any
-      expect((self as any).setInterval).not.toHaveBeenCalled();
+      expect((self as any).setTimeout).not.toHaveBeenCalled();
     });
   });
 
   describe('handleStop', () => {
-    it('should clear interval when running', () => {
+    it('should cancel the scheduled tick when running', () => {
       const module = createMockModule();
       handleRun(module, 100);
 
       handleStop();
 
       // eslint-disable-next-line @typescript-eslint/no-explicit-any
-      expect((self as any).clearInterval).toHaveBeenCalled();
+      expect((self as any).clearTimeout).toHaveBeenCalled();
     });
 
     it('should be safe to call when not running', () => {
@@ -591,20 +602,35 @@ describe('Emulator Worker', () => {
   });
 
   describe('run loop callback execution', () => {
-    let intervalCallback: (() => void) | null = null;
+    let tickCallback: (() => void) | null = null;
+    let now = 0;
+
+    /** Delay passed to the most recent self.setTimeout call */
+    const lastDelay = (): number => {
+      // eslint-disable-next-line @typescript-eslint/no-explicit-any
+      const calls = (self as any).setTimeout.mock.calls;
+      return calls[calls.length - 1][1];
+    };
 
     beforeEach(() => {
-      intervalCallback = null;
+      tickCallback = null;
+      now = 1000;
+      vi.spyOn(performance, 'now').mockImplementation(() => now);
       vi.stubGlobal('self', {
         postMessage: mockPostMessage,
-        setInterval: vi.fn((cb: () => void) => {
-          intervalCallback = cb;
+        setTimeout: vi.fn((cb: () => void) => {
+          tickCallback = cb;
           return 1;
         }),
-        clearInterval: vi.fn(),
+        clearTimeout: vi.fn(),
       });
     });
 
+    afterEach(() => {
+      handleStop();
+      vi.restoreAllMocks();
+    });
+
     it('should stop and emit HALTED when CPU halts during run loop', () => {
       let stepCount = 0;
       const module = createMockModule({
@@ -615,17 +641,18 @@ describe('Emulator Worker', () => {
         }),
       });
 
-      handleRun(module, 100);
-      expect(intervalCallback).not.toBeNull();
+      handleRun(module, 0);
+      expect(tickCallback).not.toBeNull();
 
       // Execute the run loop callback
-      intervalCallback!();
+      tickCallback!();
 
       expect(mockPostMessage).toHaveBeenCalledWith(
         expect.objectContaining({ type: 'HALTED' })
       );
+      // No further tick is scheduled after the one from handleRun
       // eslint-disable-next-line @typescript-eslint/no-explicit-any
-      expect((self as any).clearInterval).toHaveBeenCalled();
+      expect((self as any).setTimeout).toHaveBeenCalledTimes(1);
     });
 
     it('should stop and emit ERROR when CPU errors during run loop', () => {
@@ -642,8 +669,8 @@ describe('Emulator Worker', () => {
         _get_pc: vi.fn(() => 42),
       });
 
-      handleRun(module, 100);
-      intervalCallback!();
+      handleRun(module, 0);
+      tickCallback!();
 
       expect(mockPostMessage).toHaveBeenCalledWith(
         expect.objectContaining({
@@ -654,56 +681,188 @@ describe('Emulator Worker', () => {
         })
       );
       // eslint-disable-next-line @typescript-eslint/no-explicit-any
-      expect((self as any).clearInterval).toHaveBeenCalled();
+      expect((self as any).setTimeout).toHaveBeenCalledTimes(1);
     });
 
-    it('should send STATE_UPDATE after each tick during run loop', () => {
+    it('should send one STATE_UPDATE after a tick', () => {
       const module = createMockModule({
         _is_halted: vi.fn(() => 0),
         _has_error: vi.fn(() => 0),
         _get_pc: vi.fn(() => 10),
       });
 
-      handleRun(module, 5); // 5 instructions per tick
+      handleRun(module, 0);
       mockPostMessage.mockClear();
-      intervalCallback!();
+      tickCallback!();
 
-      // Should send exactly one STATE_UPDATE per tick (throttled)
       const stateUpdates = mockPostMessage.mock.calls.filter(
         (call) => call[0].type === 'STATE_UPDATE'
       );
       expect(stateUpdates.length).toBe(1);
-      handleStop(); // Clean up
     });
 
-    it('should execute correct number of instructions per tick', () => {
+    it('should publish at most one state per frame', () => {
       const module = createMockModule({
         _is_halted: vi.fn(() => 0),
         _has_error: vi.fn(() => 0),
       });
+      const stateUpdateCount = () =>
+        mockPostMessage.mock.calls.filter((call) => call[0].type === 'STATE_UPDATE').length;
 
-      handleRun(module, 5); // 5 instructions per tick
-      intervalCallback!();
+      handleRun(module, 0);
+      mockPostMessage.mockClear();
+      tickCallback!();
+      tickCallback!(); // Same instant: state held back
+      expect(stateUpdateCount()).toBe(1);
 
-      expect(module._cpu_step_instance).toHaveBeenCalledTimes(5);
-      handleStop(); // Clean up
+      now += 16;
+      tickCallback!();
+      expect(stateUpdateCount()).toBe(2);
     });
 
-    it('should execute 1000 instructions per tick at max speed (speed=0)', () => {
+    it('should wake at the end of the frame to publish a held state', () => {
+      const module = createMockModule({
+        _is_halted: vi.fn(() => 0),
+        _has_error: vi.fn(() => 0),
+      });
+
+      handleRun(module, 1000);
+      tickCallback!(); // Published
+      now += 1;
+      tickCallback!(); // Held: only 1ms since the last publish
+
+      expect(lastDelay()).toBe(15);
+    });
+
+    it('should write ticks to an attached state ring instead of posting them', () => {
+      const buffer = createStateRingBuffer();
+      const reader = new StateRingReader(buffer);
+      const module = createMockModule({
+        _is_halted: vi.fn(() => 0),
+        _has_error: vi.fn(() => 0),
+        _get_pc: vi.fn(() => 10),
+      });
+
+      handleAttachStateRing(buffer);
+      try {
+        handleRun(module, 0);
+        mockPostMessage.mockClear();
+        tickCallback!();
+        now += 16;
+        tickCallback!();
+
+        const stateUpdates = mockPostMessage.mock.calls.filter(
+          (call) => call[0].type === 'STATE_UPDATE'
+        );
+        expect(stateUpdates.length).toBe(0);
+        expect(reader.read()?.pc).toBe(10);
+      } finally {
+        handleAttachStateRing(null);
+      }
+    });
+
+    it('should still post error states when a state ring is attached', () => {
+      let errorChecks = 0;
+      const module = createMockModule({
+        _is_halted: vi.fn(() => 0),
+        // Clean through the tick, then in error when the state is published
+        _has_error: vi.fn(() => (++errorChecks > 5 ? 1 : 0)),
+      });
+
+      handleAttachStateRing(createStateRingBuffer());
+      try {
+        handleRun(module, 1000);
+        errorChecks = 0;
+        mockPostMessage.mockClear();
+        now += 4; // 1 instruction due at start + 4 more at 1000 IPS
+        tickCallback!();
+
+        expect(mockPostMessage).toHaveBeenCalledWith(
+          expect.objectContaining({
+            type: 'STATE_UPDATE',
+            payload: expect.objectContaining({ error: true }),
+          })
+        );
+      } finally {
+        handleAttachStateRing(null);
+      }
+    });
+
+    it('should execute the instructions due at the target rate', () => {
+      const module = createMockModule({
+        _is_halted: vi.fn(() => 0),
+        _has_error: vi.fn(() => 0),
+      });
+
+      handleRun(module, 1000); // 1000 instructions per second
+      tickCallback!();
+      // The first instruction is due at once
+      expect(module._cpu_step_instance).toHaveBeenCalledTimes(1);
+
+      now += 16;
+      tickCallback!();
+      expect(module._cpu_step_instance).toHaveBeenCalledTimes(17);
+    });
+
+    it('should sleep until the next instruction is due at slow speeds', () => {
+      const module = createMockModule({
+        _is_halted: vi.fn(() => 0),
+        _has_error: vi.fn(() => 0),
+      });
+
+      handleRun(module, 1); // 1 instruction per second
+      tickCallback!();
+
+      expect(module._cpu_step_instance).toHaveBeenCalledTimes(1);
+      expect(lastDelay()).toBe(1000);
+    });
+
+    it('should not burst to catch up after a long stall', () => {
+      const module = createMockModule({
+        _is_halted: vi.fn(() => 0),
+        _has_error: vi.fn(() => 0),
+      });
+
+      handleRun(module, 1000);
+      now += 10000; // e.g. the tab was in the background
+      tickCallback!();
+
+      // Backlog is capped at 250ms worth of instructions
+      expect(module._cpu_step_instance).toHaveBeenCalledTimes(250);
+    });
+
+    it('should execute 1000 instructions on the first tick at max speed (speed=0)', () => {
       const module = createMockModule({
         _is_halted: vi.fn(() => 0),
         _has_error: vi.fn(() => 0),
       });
 
       handleRun(module, 0); // Max speed
-      intervalCallback!();
+      tickCallback!();
 
       expect(module._cpu_step_instance).toHaveBeenCalledTimes(1000);
-      handleStop(); // Clean up
+      expect(lastDelay()).toBe(0);
+    });
+
+    it('should size max-speed batches from the measured tick duration', () => {
+      const module = createMockModule({
+        _is_halted: vi.fn(() => 0),
+        _has_error: vi.fn(() => 0),
+        // Each instruction takes 24us, so 1000 take twice the 12ms tick budget
+        _cpu_step_instance: vi.fn(() => {
+          now += 0.024;
+        }),
+      });
+
+      handleRun(module, 0);
+      tickCallback!();
+      tickCallback!();
+
+      expect(module._cpu_step_instance).toHaveBeenCalledTimes(1500);
     });
 
     it('should check halt before each instruction in run loop', () => {
-      // handleRun() does an initial halt check before starting interval,
+      // handleRun() does an initial halt check before scheduling the first tick,
       // then the run loop checks before each step
       // haltCheckCount: 1 (handleRun), 2 (loop iter 1 -> step), 3 (loop iter 2 -> step), 4 (loop iter 3 -> halt)
       let haltCheckCount = 0;
@@ -715,15 +874,15 @@ describe('Emulator Worker', () => {
         _has_error: vi.fn(() => 0),
       });
 
-      handleRun(module, 10); // Would do 10 instructions
-      intervalCallback!();
+      handleRun(module, 0);
+      tickCallback!();
 
       // Should have stopped early due to halt
       expect(module._cpu_step_instance).toHaveBeenCalledTimes(2); // Only 2 steps before halt detected
     });
 
     it('should check error before each instruction in run loop', () => {
-      // handleRun() does an initial error check before starting interval,
+      // handleRun() does an initial error check before scheduling the first tick,
       // then the run loop checks before each step
       // errorCheckCount: 1 (handleRun), 2 (loop iter 1 -> step), 3 (loop iter 2 -> step),
       //                  4 (loop iter 3 -> step), 5 (loop iter 4 -> error)
@@ -738,8 +897,8 @@ describe('Emulator Worker', () => {
         UTF8ToString: vi.fn(() => 'Test error'),
       });
 
-      handleRun(module, 10);
-      intervalCallback!();
+      handleRun(module, 0);
+      tickCallback!();
 
       // Should have stopped early due to error
       expect(module._cpu_step_instance).toHaveBeenCalledTimes(3);
@@ -762,7 +921,7 @@ describe('Emulator Worker', () => {
       handleReset(module);
 
       // eslint-disable-next-line @typescript-eslint/no-explicit-any
-      expect((self as any).clearInterval).toHaveBeenCalled();
+      expect((self as any).clearTimeout).toHaveBeenCalled();
     });
 
     it('should send STATE_UPDATE after reset', () => {
@@ -811,6 +970,26 @@ describe('Emulator Worker', () => {
       );
     });
 
+    it('should also send STATE_UPDATE to a connected circuit port', () => {
+      const module = createMockModule({ _get_pc: vi.fn(() => 9) });
+      const port = { postMessage: vi.fn(), close: vi.fn() } as unknown as MessagePort;
+      handleConnectCircuitPort(port);
+
+      handleGetState(module);
+
+      expect(port.postMessage).toHaveBeenCalledWith(
+        expect.objectContaining({
+          type: 'STATE_UPDATE',
+          payload: expect.objectContaining({ pc: 9 }),
+        })
+      );
+
+      // A replacement port closes the old one
+      const next = { postMessage: vi.fn(), close: vi.fn() } as unknown as MessagePort;
+      handleConnectCircuitPort(next);
+      expect(port.close).toHaveBeenCalled();
+    });
+
     it('should not modify CPU state', () => {
       const module = createMockModule();
 
@@ -822,107 +1001,72 @@ describe('Emulator Worker', () => {
   });
 
   describe('handleSetSpeed (Story 4.8)', () => {
-    let intervalCallback: (() => void) | null = null;
+    let tickCallback: (() => void) | null = null;
+    let now = 0;
 
     beforeEach(() => {
-      intervalCallback = null;
+      tickCallback = null;
+      now = 1000;
+      vi.spyOn(performance, 'now').mockImplementation(() => now);
       vi.stubGlobal('self', {
         postMessage: mockPostMessage,
-        setInterval: vi.fn((cb: () => void) => {
-          intervalCallback = cb;
+        setTimeout: vi.fn((cb: () => void) => {
+          tickCallback = cb;
           return 1;
         }),
-        clearInterval: vi.fn(),
+        clearTimeout: vi.fn(),
       });
     });
 
+    afterEach(() => {
+      handleStop();
+      vi.restoreAllMocks();
+    });
+
     it('should do nothing if not currently running', () => {
       const module = createMockModule();
       // Don't call handleRun first - not running
 
       handleSetSpeed(module, 200);
 
-      // Should not have cleared or set any intervals
+      // Should not have cleared or scheduled any ticks
       // eslint-disable-next-line @typescript-eslint/no-explicit-any
-      expect((self as any).clearInterval).not.toHaveBeenCalled();
-      // setInterval should not have been called for setSpeed (only for run)
+      expect((self as any).clearTimeout).not.toHaveBeenCalled();
       // eslint-disable-next-line @typescript-eslint/no-explicit-any
-      expect((self as any).setInterval).not.toHaveBeenCalled();
+      expect((self as any).setTimeout).not.toHaveBeenCalled();
     });
 
-    it('should update running interval with new speed', () => {
+    it('should bring the next tick forward so the new speed applies at once', () => {
       const module = createMockModule({
         _is_halted: vi.fn(() => 0),
         _has_error: vi.fn(() => 0),
       });
 
-      // Start running at speed 100
-      handleRun(module, 100);
-      // eslint-disable-next-line @typescript-eslint/no-explicit-any
-      expect((self as any).setInterval).toHaveBeenCalledTimes(1);
+      handleRun(module, 1);
+      tickCallback!(); // Next instruction due in a second
 
-      // Change speed to 200
-      handleSetSpeed(module, 200);
+      handleSetSpeed(module, 1000);
 
-      // Should have cleared old interval and started new one
       // eslint-disable-next-line @typescript-eslint/no-explicit-any
-      expect((self as any).clearInterval).toHaveBeenCalled();
+      expect((self as any).clearTimeout).toHaveBeenCalled();
       // eslint-disable-next-line @typescript-eslint/no-explicit-any
-      expect((self as any).setInterval).toHaveBeenCalledTimes(2);
-
-      handleStop(); // Clean up
+      const calls = (self as any).setTimeout.mock.calls;
+      expect(calls[calls.length - 1][1]).toBe(0);
     });
 
-    it('should use 0ms interval for max speed (speed=0)', () => {
+    it('should execute at the new rate after speed change', () => {
       const module = createMockModule({
         _is_halted: vi.fn(() => 0),
         _has_error: vi.fn(() => 0),
       });
 
-      handleRun(module, 100);
-      handleSetSpeed(module, 0);
-
-      // Second setInterval call should use 0ms for max speed
-      // eslint-disable-next-line @typescript-eslint/no-explicit-any
-      const setIntervalCalls = (self as any).setInterval.mock.calls;
-      expect(setIntervalCalls[setIntervalCalls.length - 1][1]).toBe(0);
+      handleRun(module, 1000);
+      tickCallback!(); // 1 instruction
+      handleSetSpeed(module, 500);
+      now += 16;
+      tickCallback!(); // 16ms at 500 IPS = 8 instructions
 
-      handleStop(); // Clean up
-    });
-
-    it('should use 16ms interval for throttled speed', () => {
-      const module = createMockModule({
-        _is_halted: vi.fn(() => 0),
-        _has_error: vi.fn(() => 0),
-      });
-
-      handleRun(module, 0); // Start at max speed (0ms interval)
-      handleSetSpeed(module, 60); // Change to throttled speed
-
-      // Second setInterval call should use 16ms for throttled
-      // eslint-disable-next-line @typescript-eslint/no-explicit-any
-      const setIntervalCalls = (self as any).setInterval.mock.calls;
-      expect(setIntervalCalls[setIntervalCalls.length - 1][1]).toBe(16);
-
-      handleStop(); // Clean up
-    });
-
-    it('should execute correct number of instructions per tick after speed change', () => {
-      const module = createMockModule({
-        _is_halted: vi.fn(() => 0),
-        _has_error: vi.fn(() => 0),
-      });
-
-      handleRun(module, 5); // 5 instructions per tick
-      handleSetSpeed(module, 10); // Change to 10 instructions per tick
-
-      // Execute the run loop callback (from the new setInterval)
-      intervalCallback!();
-
-      // Should execute 10 instructions (new speed)
-      expect(module._cpu_step_instance).toHaveBeenCalledTimes(10);
-
-      handleStop(); // Clean up
+      expect(module._cpu_step_instance).toHaveBeenCalledTimes(9);
     });
 
     it('should execute 1000 instructions per tick at max speed after speed change', () => {
@@ -931,15 +1075,13 @@ describe('Emulator Worker', () => {
         _has_error: vi.fn(() => 0),
       });
 
-      handleRun(module, 5); // Start at 5 instructions per tick
+      handleRun(module, 5); // Start at 5 instructions per second
       handleSetSpeed(module, 0); // Change to max speed
 
       // Execute the run loop callback
-      intervalCallback!();
+      tickCallback!();
 
       expect(module._cpu_step_instance).toHaveBeenCalledTimes(1000);
-
-      handleStop(); // Clean up
     });
   });
 
@@ -21,6 +21,8 @@ import type {
   RuntimeErrorContext,
 } from './types';
 import { validateEmulatorModule } from './types';
+import { StateRingWriter, isStateRingBuffer } from './stateRing';
+import { RunPacer } from './runPacer';
 
 // Self is typed as DedicatedWorkerGlobalScope via reference lib above
 declare const self: DedicatedWorkerGlobalScope;
@@ -36,15 +38,32 @@ let wasmModule: EmulatorModule | null = null;
 let initError: string | null = null;
 
 /**
- * Run loop interval ID, null when not running.
+ * Timer for the next run-loop tick, null when no tick is scheduled.
  */
-let runIntervalId: number | null = null;
+let runTimerId: number | null = null;
+
+/**
+ * Pacing state of the current run, null when not running.
+ */
+let runPacer: RunPacer | null = null;
 
 /**
  * Breakpoints set by the user (addresses to stop at).
  */
 const breakpoints: Set<number> = new Set();
 
+/**
+ * Port that also receives every STATE_UPDATE (the circuit render worker),
+ * so circuit wire states never have to pass through the main thread.
+ */
+let circuitPort: MessagePort | null = null;
+
+/**
+ * Shared state ring for run-loop ticks, null when the page is not
+ * cross-origin isolated (ticks then post STATE_UPDATE as before).
+ */
+let stateRing: StateRingWriter | null = null;
+
 /**
  * Micro4 instruction mnemonics by opcode (Story 5.10).
  * Used for rich error context display.
@@ -152,6 +171,37 @@ export function buildErrorContext(
   };
 }
 
+/**
+ * Post the current CPU state to the main thread and the circuit port.
+ */
+function postStateUpdate(module: EmulatorModule): void {
+  const event = {
+    type: 'STATE_UPDATE',
+    payload: readCPUState(module),
+  } satisfies StateUpdateEvent;
+  self.postMessage(event);
+  circuitPort?.postMessage(event);
+}
+
+/**
+ * Publish the state during a run (at most once per frame, see RunPacer).
+ * With a state ring, the frame is written to shared memory and no message
+ * reaches the main thread; error states still go by message because their
+ * text does not fit the ring.
+ */
+function publishRunState(module: EmulatorModule): void {
+  if (!stateRing || module._has_error() === 1) {
+    postStateUpdate(module);
+    return;
+  }
+
+  stateRing.write(module);
+  circuitPort?.postMessage({
+    type: 'STATE_UPDATE',
+    payload: readCPUState(module),
+  } satisfies StateUpdateEvent);
+}
+
 /**
  * Type guard for EmulatorCommand messages.
  * Validates structure including payload fields where required.
@@ -243,6 +293,16 @@ export function isEmulatorCommand(data: unknown): data is EmulatorCommand {
     case 'GET_BREAKPOINTS':
       // No payload required (Story 5.8)
       return true;
+    case 'CONNECT_CIRCUIT_PORT': {
+      if (typeof obj.payload !== 'object' || obj.payload === null) return false;
+      const payload = obj.payload as Record<string, unknown>;
+      return typeof payload.port === 'object' && payload.port !== null;
+    }
+    case 'ATTACH_STATE_RING': {
+      if (typeof obj.payload !== 'object' || obj.payload === null) return false;
+      const payload = obj.payload as Record<string, unknown>;
+      return isStateRingBuffer(payload.buffer);
+    }
     default:
       return false;
   }
@@ -308,10 +368,7 @@ export function handleLoadProgram(
   module._free(programPtr);
 
   // Send state update
-  self.postMessage({
-    type: 'STATE_UPDATE',
-    payload: readCPUState(module),
-  } satisfies StateUpdateEvent);
+  postStateUpdate(module);
 }
 
 /**
@@ -328,10 +385,7 @@ export function handleLoadProgram(
 export function handleStep(module: EmulatorModule): void {
   // Don't step if already halted or in error state
   if (module._is_halted() === 1 || module._has_error() === 1) {
-    self.postMessage({
-      type: 'STATE_UPDATE',
-      payload: readCPUState(module),
-    } satisfies StateUpdateEvent);
+    postStateUpdate(module);
     return;
   }
 
@@ -340,10 +394,7 @@ export function handleStep(module: EmulatorModule): void {
 
   // Check for halt
   if (module._is_halted() === 1) {
-    self.postMessage({
-      type: 'STATE_UPDATE',
-      payload: readCPUState(module),
-    } satisfies StateUpdateEvent);
+    postStateUpdate(module);
     self.postMessage({ type: 'HALTED' } satisfies HaltedEvent);
     return;
   }
@@ -372,99 +423,103 @@ export function handleStep(module: EmulatorModule): void {
   }
 
   // Send state update
-  self.postMessage({
-    type: 'STATE_UPDATE',
-    payload: readCPUState(module),
-  } satisfies StateUpdateEvent);
+  postStateUpdate(module);
+}
+
+/**
+ * Schedule the next run-loop tick.
+ */
+function scheduleRunTick(module: EmulatorModule, delayMs: number): void {
+  runTimerId = self.setTimeout(() => runTick(module), delayMs);
 }
 
 /**
- * Start or restart the run interval with the given speed.
- * Shared logic used by both handleRun and handleSetSpeed.
+ * Execute one run-loop tick: the instructions the pacer plans, stopping at a
+ * halt, error, or breakpoint, then publish the state if a frame has passed.
+ * Exported for testing purposes.
  *
  * @param module - The WASM emulator module
- * @param speed - Instructions per ~16ms tick. 0 = max speed (1000 per tick, 0ms interval)
- */
-function startRunInterval(module: EmulatorModule, speed: number): void {
-  const instructionsPerTick = speed === 0 ? 1000 : Math.max(1, Math.floor(speed));
-  const intervalMs = speed === 0 ? 0 : 16; // ~60fps for throttled, 0 for max
-
-  runIntervalId = self.setInterval(() => {
-    for (let i = 0; i < instructionsPerTick; i++) {
-      // Check for halt
-      if (module._is_halted() === 1) {
-        handleStop();
-        self.postMessage({
-          type: 'STATE_UPDATE',
-          payload: readCPUState(module),
-        } satisfies StateUpdateEvent);
-        self.postMessage({ type: 'HALTED' } satisfies HaltedEvent);
-        return;
-      }
-
-      // Check for error
-      if (module._has_error() === 1) {
-        handleStop();
-        const errorMessage = module.UTF8ToString(module._get_error_message());
-        self.postMessage({
-          type: 'ERROR',
-          payload: {
-            message: errorMessage,
-            address: module._get_pc(),
-            context: buildErrorContext(module, errorMessage),
-          },
-        } satisfies EmulatorErrorEvent);
-        return;
-      }
-
-      // Check for breakpoint before stepping
-      const pc = module._get_pc();
-      if (breakpoints.has(pc)) {
-        handleStop();
-        self.postMessage({
-          type: 'STATE_UPDATE',
-          payload: readCPUState(module),
-        } satisfies StateUpdateEvent);
-        self.postMessage({
-          type: 'BREAKPOINT_HIT',
-          payload: { address: pc },
-        } satisfies BreakpointHitEvent);
-        return;
-      }
-
-      // Execute one instruction
-      module._cpu_step_instance();
+ */
+export function runTick(module: EmulatorModule): void {
+  runTimerId = null;
+  const pacer = runPacer;
+  if (!pacer) return;
+
+  const startedAt = performance.now();
+  const count = pacer.plan(startedAt);
+  let executed = 0;
+
+  for (; executed < count; executed++) {
+    // Check for halt
+    if (module._is_halted() === 1) {
+      handleStop();
+      postStateUpdate(module);
+      self.postMessage({ type: 'HALTED' } satisfies HaltedEvent);
+      return;
     }
 
-    // Send state update (throttled to once per tick)
-    self.postMessage({
-      type: 'STATE_UPDATE',
-      payload: readCPUState(module),
-    } satisfies StateUpdateEvent);
-  }, intervalMs);
+    // Check for error
+    if (module._has_error() === 1) {
+      handleStop();
+      const errorMessage = module.UTF8ToString(module._get_error_message());
+      self.postMessage({
+        type: 'ERROR',
+        payload: {
+          message: errorMessage,
+          address: module._get_pc(),
+          context: buildErrorContext(module, errorMessage),
+        },
+      } satisfies EmulatorErrorEvent);
+      return;
+    }
+
+    // Check for breakpoint before stepping
+    const pc = module._get_pc();
+    if (breakpoints.has(pc)) {
+      handleStop();
+      postStateUpdate(module);
+      self.postMessage({
+        type: 'BREAKPOINT_HIT',
+        payload: { address: pc },
+      } satisfies BreakpointHitEvent);
+      return;
+    }
+
+    // Execute one instruction
+    module._cpu_step_instance();
+  }
+
+  const endedAt = performance.now();
+  pacer.record(executed, startedAt, endedAt);
+
+  // Send state update (throttled to once per frame)
+  if (pacer.shouldPublish(endedAt)) {
+    publishRunState(module);
+    pacer.markPublished(endedAt);
+  }
+
+  scheduleRunTick(module, pacer.nextDelay(endedAt));
 }
 
 /**
  * Handle RUN command.
- * Start continuous execution with configurable speed.
- * @param speed - Instructions per ~16ms tick. 0 = max speed (1000 per tick, 0ms interval)
+ * Start continuous execution paced to the requested rate.
+ * @param speed - Instructions per second (0 = as fast as possible)
  */
 export function handleRun(module: EmulatorModule, speed: number): void {
   // Don't start if already running
-  if (runIntervalId !== null) {
+  if (runPacer !== null) {
     return;
   }
 
   // Don't start if halted or in error state
   if (module._is_halted() === 1 || module._has_error() === 1) {
-    self.postMessage({
-      type: 'STATE_UPDATE',
-      payload: readCPUState(module),
-    } satisfies StateUpdateEvent);
+    postStateUpdate(module);
     return;
   }
 
-  startRunInterval(module, speed);
+  runPacer = new RunPacer(speed, performance.now());
+  scheduleRunTick(module, 0);
 }
 
 /**
@@ -472,28 +527,32 @@ export function handleRun(module: EmulatorModule, speed: number): void {
  * Cancel run loop if active.
  */
 export function handleStop(): void {
-  if (runIntervalId !== null) {
-    self.clearInterval(runIntervalId);
-    runIntervalId = null;
+  if (runTimerId !== null) {
+    self.clearTimeout(runTimerId);
+    runTimerId = null;
   }
+  runPacer = null;
 }
 
 /**
  * Handle SET_SPEED command.
  * Change execution speed while running. Only affects execution if currently running.
+ * The pending tick is brought forward so a faster rate applies at once.
  *
  * @param module - The WASM emulator module
- * @param speed - New execution speed (0 = max speed, >0 = instructions per ~16ms tick)
+ * @param speed - New execution speed in instructions per second (0 = as fast as possible)
  */
 export function handleSetSpeed(module: EmulatorModule, speed: number): void {
   // Only update if currently running
-  if (runIntervalId === null) {
+  if (runPacer === null) {
     return;
   }
 
-  // Clear existing interval and restart with new speed
-  self.clearInterval(runIntervalId);
-  startRunInterval(module, speed);
+  runPacer.setSpeed(speed, performance.now());
+  if (runTimerId !== null) {
+    self.clearTimeout(runTimerId);
+    scheduleRunTick(module, 0);
+  }
 }
 
 /**
@@ -512,10 +571,7 @@ export function handleReset(module: EmulatorModule): void {
   breakpoints.clear();
 
   // Send state update
-  self.postMessage({
-    type: 'STATE_UPDATE',
-    payload: readCPUState(module),
-  } satisfies StateUpdateEvent);
+  postStateUpdate(module);
 
   // Notify main thread that breakpoints were cleared
   self.postMessage({
@@ -529,10 +585,7 @@ export function handleReset(module: EmulatorModule): void {
  * Return current CPU state without modifying anything.
  */
 export function handleGetState(module: EmulatorModule): void {
-  self.postMessage({
-    type: 'STATE_UPDATE',
-    payload: readCPUState(module),
-  } satisfies StateUpdateEvent);
+  postStateUpdate(module);
 }
 
 /**
@@ -577,10 +630,7 @@ export function handleRestoreState(
 
   // Send state update with the restored state
   // Note: PC and other registers are reset to initial values by cpu_reset_instance
-  self.postMessage({
-    type: 'STATE_UPDATE',
-    payload: readCPUState(module),
-  } satisfies StateUpdateEvent);
+  postStateUpdate(module);
 }
 
 /**
@@ -659,6 +709,24 @@ async function initializeWasm(): Promise<boolean> {
   }
 }
 
+/**
+ * Handle CONNECT_CIRCUIT_PORT command.
+ * Replaces any previously connected port.
+ */
+export function handleConnectCircuitPort(port: MessagePort): void {
+  circuitPort?.close();
+  circuitPort = port;
+}
+
+/**
+ * Handle ATTACH_STATE_RING command.
+ * Run-loop ticks are written to the ring from now on; null goes back to
+ * posting STATE_UPDATE every tick.
+ */
+export function handleAttachStateRing(buffer: SharedArrayBuffer | null): void {
+  stateRing = buffer ? new StateRingWriter(buffer) : null;
+}
+
 /**
  * Handle incoming messages from the main thread.
  */
@@ -670,6 +738,16 @@ function handleMessage(event: MessageEvent): void {
     return;
   }
 
+  // Connecting the circuit port or state ring does not need WASM, so they may come first
+  if (data.type === 'CONNECT_CIRCUIT_PORT') {
+    handleConnectCircuitPort(data.payload.port);
+    return;
+  }
+  if (data.type === 'ATTACH_STATE_RING') {
+    handleAttachStateRing(data.payload.buffer);
+    return;
+  }
+
   if (!wasmModule) {
     // WASM not loaded yet or failed
     self.postMessage({
@@ -702,10 +780,7 @@ function handleMessage(event: MessageEvent): void {
     case 'STOP': {
       handleStop();
       // Send state update so UI reflects current state after stopping
-      self.postMessage({
-        type: 'STATE_UPDATE',
-        payload: readCPUState(wasmModule),
-      } satisfies StateUpdateEvent);
+      postStateUpdate(wasmModule);
       break;
     }
     case 'SET_SPEED': {
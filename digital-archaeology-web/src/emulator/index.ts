@@ -33,6 +33,8 @@ export type {
   StopCommand,
   ResetCommand,
   GetStateCommand,
+  ConnectCircuitPortCommand,
+  AttachStateRingCommand,
   EmulatorCommand,
   StateUpdateEvent,
   HaltedEvent,
@@ -57,6 +59,19 @@ export {
   REQUIRED_EMULATOR_RUNTIME_METHODS,
 } from './types';
 
+// Shared state ring
+export {
+  StateRingReader,
+  StateRingWriter,
+  createStateRingBuffer,
+  isStateRingBuffer,
+  isStateRingSupported,
+  DEFAULT_STATE_RING_SLOTS,
+} from './stateRing';
+
+// Run-loop pacing
+export { RunPacer, FRAME_MS, TICK_BUDGET_MS } from './runPacer';
+
 // Bridge exports
 export { AssemblerBridge } from './AssemblerBridge';
 export { EmulatorBridge } from './EmulatorBridge';
@@ -0,0 +1,130 @@
+/**
+ * Run-Loop Pacer Tests
+ *
+ * Tests for instruction budgeting, adaptive batch sizing, and publish
+ * throttling, driven by explicit timestamps.
+ */
+
+import { describe, it, expect } from 'vitest';
+import { RunPacer, FRAME_MS } from './runPacer';
+
+describe('RunPacer', () => {
+  describe('paced mode', () => {
+    it('should make the first instruction due immediately', () => {
+      const pacer = new RunPacer(10, 0);
+
+      expect(pacer.isPaced).toBe(true);
+      expect(pacer.plan(0)).toBe(1);
+    });
+
+    it('should accrue instructions with elapsed time', () => {
+      const pacer = new RunPacer(100, 0);
+      pacer.record(pacer.plan(0), 0, 0);
+
+      // 100 IPS for 50ms = 5 instructions
+      expect(pacer.plan(50)).toBe(5);
+    });
+
+    it('should carry fractional instructions between ticks', () => {
+      const pacer = new RunPacer(30, 0);
+      pacer.record(pacer.plan(0), 0, 0);
+
+      // 30 IPS: 0.48 instructions per 16ms frame
+      expect(pacer.plan(16)).toBe(0);
+      pacer.record(0, 16, 16);
+      expect(pacer.plan(40)).toBe(1);
+    });
+
+    it('should cap the backlog at 250ms worth', () => {
+      const pacer = new RunPacer(1000, 0);
+
+      expect(pacer.plan(60000)).toBe(250);
+    });
+
+    it('should schedule the next tick when the next instruction is due', () => {
+      const pacer = new RunPacer(2, 0);
+      pacer.record(pacer.plan(0), 0, 0);
+      pacer.markPublished(0);
+
+      expect(pacer.nextDelay(0)).toBe(500);
+    });
+
+    it('should tick no more often than once per frame', () => {
+      const pacer = new RunPacer(10000, 0);
+      pacer.record(pacer.plan(0), 0, 0);
+      pacer.markPublished(0);
+
+      expect(pacer.nextDelay(0)).toBe(FRAME_MS);
+    });
+
+    it('should accrue at the old rate until the speed changes', () => {
+      const pacer = new RunPacer(100, 0);
+      pacer.record(pacer.plan(0), 0, 0);
+
+      pacer.setSpeed(1000, 100); // 10 instructions accrued at 100 IPS
+
+      expect(pacer.plan(110)).toBe(20); // + 10 at 1000 IPS
+    });
+  });
+
+  describe('unpaced mode', () => {
+    it('should start with 1000-instruction batches and no delay', () => {
+      const pacer = new RunPacer(0, 0);
+
+      expect(pacer.isPaced).toBe(false);
+      expect(pacer.plan(0)).toBe(1000);
+      expect(pacer.nextDelay(0)).toBe(0);
+    });
+
+    it('should grow batches that finish under budget, at most doubling', () => {
+      const pacer = new RunPacer(0, 0);
+
+      pacer.record(1000, 0, 1);
+
+      expect(pacer.batchSize).toBe(2000);
+    });
+
+    it('should shrink batches that overrun the budget, at most halving', () => {
+      const pacer = new RunPacer(0, 0);
+
+      pacer.record(1000, 0, 15); // 12ms budget / 15ms
+
+      expect(pacer.batchSize).toBe(800);
+    });
+
+    it('should ignore batches cut short', () => {
+      const pacer = new RunPacer(0, 0);
+
+      pacer.record(10, 0, 50);
+
+      expect(pacer.batchSize).toBe(1000);
+    });
+  });
+
+  describe('publishing', () => {
+    it('should publish only after executing, at most once per frame', () => {
+      const pacer = new RunPacer(0, 0);
+      expect(pacer.shouldPublish(0)).toBe(false);
+
+      pacer.record(1000, 0, 5);
+      expect(pacer.shouldPublish(5)).toBe(true);
+      pacer.markPublished(5);
+
+      pacer.record(1000, 5, 10);
+      expect(pacer.shouldPublish(10)).toBe(false);
+      expect(pacer.shouldPublish(5 + FRAME_MS)).toBe(true);
+    });
+
+    it('should shorten the delay to publish a held state at the end of the frame', () => {
+      const pacer = new RunPacer(1, 0);
+      pacer.record(pacer.plan(0), 0, 0);
+      pacer.markPublished(0);
+      pacer.setSpeed(1000, 1000);
+      pacer.record(pacer.plan(1004), 1004, 1004);
+      pacer.markPublished(1004);
+      pacer.record(pacer.plan(1010), 1010, 1010);
+
+      expect(pacer.nextDelay(1010)).toBe(10);
+    });
+  });
+});
@@ -0,0 +1,171 @@
+/**
+ * Run-Loop Pacer
+ *
+ * Decides how many instructions each emulator run-loop tick executes, when
+ * the next tick runs, and when a state is published, using performance.now()
+ * timestamps supplied by the caller.
+ *
+ * Paced mode (speed > 0): speed is a target in instructions per second.
+ * Instructions accrue with wall-clock time, and each tick executes the ones
+ * that are due. The next tick is scheduled for when the next instruction
+ * falls due, but never sooner than one frame. At 1 IPS the worker wakes once
+ * a second; at 1000 IPS it runs about 16 instructions per frame. The backlog
+ * is capped, so a throttled tab does not burst to catch up.
+ *
+ * Unpaced mode (speed = 0): the batch size follows the measured duration
+ * of the previous full batch, so each tick works for about TICK_BUDGET_MS.
+ * The worker stays free to handle STOP between ticks.
+ *
+ * In both modes, states are published at most once per frame.
+ */
+
+/** Minimum interval between published states (~60fps). */
+export const FRAME_MS = 16;
+
+/** Target duration of one unpaced tick in milliseconds. */
+export const TICK_BUDGET_MS = 12;
+
+/** Most wall-clock time that may accrue as owed instructions. */
+const MAX_BACKLOG_MS = 250;
+
+/** Unpaced batch size limits; the first batch uses INITIAL_BATCH. */
+const INITIAL_BATCH = 1000;
+const MIN_BATCH = 16;
+const MAX_BATCH = 1 << 20;
+
+/**
+ * Pacing state for one RUN, from start until stop.
+ */
+export class RunPacer {
+  private speed: number;
+  private lastAccrual: number;
+  /** Instructions due but not yet executed (paced mode; fractional) */
+  private owed: number;
+  /** Instructions per tick (unpaced mode) */
+  private batch = INITIAL_BATCH;
+  private lastPublish = -Infinity;
+  private unpublished = false;
+
+  /**
+   * @param speed - Instructions per second (0 = as fast as possible)
+   * @param now - Current time from performance.now()
+   */
+  constructor(speed: number, now: number) {
+    this.speed = speed;
+    this.lastAccrual = now;
+    // The first instruction is due immediately, so a slow run starts at once
+    this.owed = speed > 0 ? 1 : 0;
+  }
+
+  /**
+   * Whether execution is paced to a target rate.
+   */
+  get isPaced(): boolean {
+    return this.speed > 0;
+  }
+
+  /**
+   * Instructions per tick in unpaced mode.
+   */
+  get batchSize(): number {
+    return this.batch;
+  }
+
+  /**
+   * Change the target rate. Time before now accrues at the old rate.
+   * @param speed - Instructions per second (0 = as fast as possible)
+   * @param now - Current time from performance.now()
+   */
+  setSpeed(speed: number, now: number): void {
+    this.accrue(now);
+    this.speed = speed;
+    this.owed = speed > 0 ? Math.min(this.owed, this.maxOwed()) : 0;
+  }
+
+  /**
+   * Get the number of instructions the tick starting now should execute.
+   * @param now - Tick start time from performance.now()
+   */
+  plan(now: number): number {
+    if (!this.isPaced) return this.batch;
+    this.accrue(now);
+    return Math.floor(this.owed);
+  }
+
+  /**
+   * Record a finished tick.
+   * @param executed - Instructions the tick executed
+   * @param startedAt - Tick start time
+   * @param endedAt - Tick end time
+   */
+  record(executed: number, startedAt: number, endedAt: number): void {
+    if (executed > 0) this.unpublished = true;
+
+    if (this.isPaced) {
+      this.owed -= executed;
+      return;
+    }
+
+    // A short batch (halt, breakpoint) says nothing about throughput
+    if (executed < this.batch) return;
+
+    const elapsed = endedAt - startedAt;
+    const scale = elapsed > 0 ? TICK_BUDGET_MS / elapsed : 2;
+    // Adjust gradually so one slow tick (GC pause) does not collapse the batch
+    const next = Math.round(this.batch * Math.min(2, Math.max(0.5, scale)));
+    this.batch = Math.min(MAX_BATCH, Math.max(MIN_BATCH, next));
+  }
+
+  /**
+   * Whether the state should be published now.
+   * @param now - Current time from performance.now()
+   */
+  shouldPublish(now: number): boolean {
+    return this.unpublished && now - this.lastPublish >= FRAME_MS;
+  }
+
+  /**
+   * Record that the state was published.
+   * @param now - Current time from performance.now()
+   */
+  markPublished(now: number): void {
+    this.lastPublish = now;
+    this.unpublished = false;
+  }
+
+  /**
+   * Get the delay before the next tick. It is shortened when a state is
+   * waiting to be published, so the final state of a burst always shows.
+   * @param now - Current time from performance.now()
+   * @returns Delay in milliseconds
+   */
+  nextDelay(now: number): number {
+    let delay = 0;
+    if (this.isPaced) {
+      const untilDue = ((1 - this.owed) * 1000) / this.speed;
+      delay = Math.max(FRAME_MS, untilDue);
+    }
+    if (this.unpublished) {
+      delay = Math.min(delay, FRAME_MS - (now - this.lastPublish));
+    }
+    return Math.max(0, delay);
+  }
+
+  /**
+   * Add the instructions that fell due since the last accrual.
+   */
+  private accrue(now: number): void {
+    if (this.isPaced) {
+      const elapsed = Math.max(0, now - this.lastAccrual);
+      this.owed = Math.min(this.owed + (elapsed * this.speed) / 1000, this.maxOwed());
+    }
+    this.lastAccrual = now;
+  }
+
+  /**
+   * Cap on owed instructions: MAX_BACKLOG_MS worth, but at least one.
+   */
+  private maxOwed(): number {
+    return Math.max(1, (this.speed * MAX_BACKLOG_MS) / 1000);
+  }
+}
@@ -0,0 +1,204 @@
+/**
+ * State Ring Tests
+ *
+ * Tests for the SharedArrayBuffer CPU state ring shared by the emulator
+ * worker (writer) and the main thread (reader).
+ */
+
+import { describe, it, expect, vi, afterEach } from 'vitest';
+import {
+  StateRingReader,
+  StateRingWriter,
+  createStateRingBuffer,
+  isStateRingBuffer,
+  isStateRingSupported,
+} from './stateRing';
+import type { EmulatorModule } from './types';
+
+/**
+ * Create a mock module whose registers and memory can be changed between writes.
+ */
+function createMockModule() {
+  const heap = new Uint8Array(1024);
+  const regs = { pc: 0, acc: 0, zero: 0, halted: 0, cycles: 0, instructions: 0 };
+  const module = {
+    HEAPU8: heap,
+    _get_memory_ptr: () => 256,
+    _get_pc: () => regs.pc,
+    _get_accumulator: () => regs.acc,
+    _get_zero_flag: () => regs.zero,
+    _is_halted: () => regs.halted,
+    _has_error: () => 0,
+    _get_ir: () => 0x45,
+    _get_mar: () => 7,
+    _get_mdr: () => 3,
+    _get_cycles: () => regs.cycles,
+    _get_instructions: () => regs.instructions,
+  } as unknown as EmulatorModule;
+  const memory = heap.subarray(256, 512);
+  return { module, regs, memory };
+}
+
+describe('stateRing', () => {
+  afterEach(() => {
+    vi.unstubAllGlobals();
+  });
+
+  describe('isStateRingSupported()', () => {
+    it('should require cross-origin isolation', () => {
+      vi.stubGlobal('crossOriginIsolated', false);
+      expect(isStateRingSupported()).toBe(false);
+
+      vi.stubGlobal('crossOriginIsolated', true);
+      expect(isStateRingSupported()).toBe(true);
+    });
+  });
+
+  describe('isStateRingBuffer()', () => {
+    it('should accept ring buffers only', () => {
+      expect(isStateRingBuffer(createStateRingBuffer(3))).toBe(true);
+      expect(isStateRingBuffer(new ArrayBuffer(4096))).toBe(false);
+      expect(isStateRingBuffer(new SharedArrayBuffer(4096))).toBe(false);
+      expect(isStateRingBuffer(null)).toBe(false);
+    });
+  });
+
+  describe('StateRingReader', () => {
+    it('should return null before any frame is written', () => {
+      const reader = new StateRingReader(createStateRingBuffer());
+
+      expect(reader.read()).toBeNull();
+    });
+
+    it('should read back every field the writer wrote', () => {
+      const buffer = createStateRingBuffer();
+      const writer = new StateRingWriter(buffer);
+      const reader = new StateRingReader(buffer);
+      const { module, regs, memory } = createMockModule();
+      Object.assign(regs, { pc: 200, acc: 9, zero: 1, halted: 1, cycles: 2 ** 40, instructions: 12345 });
+      memory[0] = 0xf;
+      memory[255] = 0x3;
+
+      writer.write(module);
+      const state = reader.read();
+
+      expect(state).toEqual({
+        pc: 200,
+        accumulator: 9,
+        zeroFlag: true,
+        halted: true,
+        error: false,
+        errorMessage: null,
+        memory: expect.any(Uint8Array),
+        ir: 0x45,
+        mar: 7,
+        mdr: 3,
+        cycles: 2 ** 40,
+        instructions: 12345,
+        memoryDirty: expect.any(Uint32Array),
+      });
+      expect(state!.memory[0]).toBe(0xf);
+      expect(state!.memory[255]).toBe(0x3);
+      expect(state!.memory.length).toBe(256);
+    });
+
+    it('should return null until a newer frame is published', () => {
+      const buffer = createStateRingBuffer();
+      const writer = new StateRingWriter(buffer);
+      const reader = new StateRingReader(buffer);
+      const { module, regs } = createMockModule();
+
+      writer.write(module);
+      expect(reader.read()).not.toBeNull();
+      expect(reader.read()).toBeNull();
+
+      regs.pc = 1;
+      writer.write(module);
+      expect(reader.read()?.pc).toBe(1);
+    });
+
+    it('should keep memory changes from frames it skipped', () => {
+      const buffer = createStateRingBuffer(2);
+      const writer = new StateRingWriter(buffer);
+      const reader = new StateRingReader(buffer);
+      const { module, regs, memory } = createMockModule();
+
+      writer.write(module);
+      reader.read();
+
+      // Many frames, each touching a different address, lapping the ring
+      for (let addr = 10; addr < 20; addr++) {
+        memory[addr] = addr & 0xf;
+        regs.pc = addr;
+        writer.write(module);
+      }
+      const state = reader.read()!;
+
+      expect(state.pc).toBe(19);
+      for (let addr = 10; addr < 20; addr++) {
+        expect(state.memory[addr]).toBe(addr & 0xf);
+      }
+    });
+
+    it('should report the addresses changed since the last read', () => {
+      const buffer = createStateRingBuffer(2);
+      const writer = new StateRingWriter(buffer);
+      const reader = new StateRingReader(buffer);
+      const { module, regs, memory } = createMockModule();
+
+      writer.write(module);
+      expect(reader.read()!.memoryDirty![0]).toBe(0xffffffff);
+
+      memory[3] = 1;
+      writer.write(module);
+      memory[40] = 2;
+      regs.pc = 1;
+      writer.write(module);
+      const dirty = reader.read()!.memoryDirty!;
+
+      expect(dirty[0]).toBe(1 << 3);
+      expect(dirty[1]).toBe(1 << 8);
+      expect(Array.from(dirty.subarray(2))).toEqual([0, 0, 0, 0, 0, 0]);
+    });
+
+    it('should return independent memory copies', () => {
+      const buffer = createStateRingBuffer();
+      const writer = new StateRingWriter(buffer);
+      const reader = new StateRingReader(buffer);
+      const { module, regs, memory } = createMockModule();
+
+      memory[5] = 1;
+      writer.write(module);
+      const first = reader.read()!;
+
+      memory[5] = 2;
+      regs.pc = 1;
+      writer.write(module);
+      const second = reader.read()!;
+
+      expect(first.memory[5]).toBe(1);
+      expect(second.memory[5]).toBe(2);
+    });
+
+    it('should ignore published frames after skipPublished() but keep their memory', () => {
+      const buffer = createStateRingBuffer();
+      const writer = new StateRingWriter(buffer);
+      const reader = new StateRingReader(buffer);
+      const { module, regs, memory } = createMockModule();
+
+      writer.write(module);
+      reader.read();
+      memory[3] = 7;
+      writer.write(module);
+
+      reader.skipPublished();
+      expect(reader.read()).toBeNull();
+
+      regs.pc = 4;
+      writer.write(module);
+      const state = reader.read()!;
+      expect(state.pc).toBe(4);
+      expect(state.memory[3]).toBe(7);
+    });
+  });
+});
@@ -0,0 +1,325 @@
+/**
+ * CPU State Ring
+ *
+ * SharedArrayBuffer-backed ring of fixed-layout CPU state frames.
+ * The emulator worker writes one frame per run-loop tick without posting a
+ * message; the main thread reads the newest frame once per animation frame.
+ *
+ * Buffer layout (little-endian, byte offsets):
+ *
+ *   Header (64 bytes)
+ *     0   Int32  sequence number of the newest published frame (0 = none)
+ *     4   Int32  slot count
+ *     8   Int32[8] memory dirty bitmap (one bit per address, 256 bits)
+ *
+ *   Slot i (304 bytes, starting at 64 + i * 304)
+ *     0   Int32  version (odd while the writer is filling the slot)
+ *     4   Int32  flags (bit 0 zero, bit 1 halted, bit 2 error)
+ *     8   Int32  pc, acc, ir, mar, mdr (20 bytes) + 4 bytes padding
+ *     32  Float64 cycles
+ *     40  Float64 instructions
+ *     48  Uint8[256] memory
+ *
+ * Sequencing uses Atomics: each slot is a seqlock (readers retry while the
+ * version is odd or changes under them) and the header sequence is published
+ * after the slot is complete. The dirty bitmap accumulates changed addresses
+ * until the reader takes it, so the reader only copies memory that changed
+ * since its previous read, however many frames it skipped.
+ */
+
+import type { CPUState, EmulatorModule } from './types';
+
+/** Number of memory cells in a Micro4 CPU. */
+const MEMORY_SIZE = 256;
+
+/** Header size in bytes. */
+const HEADER_BYTES = 64;
+
+/** Header Int32 indices. */
+const SEQ_INDEX = 0;
+const SLOT_COUNT_INDEX = 1;
+const DIRTY_INDEX = 2;
+const DIRTY_WORDS = MEMORY_SIZE / 32;
+
+/** Slot size in bytes (multiple of 8 so Float64 fields stay aligned). */
+const SLOT_BYTES = 304;
+
+/** Slot field offsets in bytes. */
+const SLOT_VERSION = 0;
+const SLOT_FLAGS = 4;
+const SLOT_PC = 8;
+const SLOT_ACC = 12;
+const SLOT_IR = 16;
+const SLOT_MAR = 20;
+const SLOT_MDR = 24;
+const SLOT_CYCLES = 32;
+const SLOT_INSTRUCTIONS = 40;
+const SLOT_MEMORY = 48;
+
+/** Flag bits. */
+const FLAG_ZERO = 1;
+const FLAG_HALTED = 2;
+const FLAG_ERROR = 4;
+
+/** Default number of slots; enough that a reader is rarely lapped mid-read. */
+export const DEFAULT_STATE_RING_SLOTS = 4;
+
+/** Reads that are lapped this many times in a row give up until the next frame. */
+const MAX_READ_ATTEMPTS = 4;
+
+/**
+ * Whether the state ring can be used in this context.
+ * SharedArrayBuffer is only available when the page is cross-origin isolated
+ * (COOP/COEP headers); otherwise state updates fall back to postMessage.
+ */
+export function isStateRingSupported(): boolean {
+  return (
+    typeof SharedArrayBuffer === 'function' &&
+    typeof Atomics === 'object' &&
+    (globalThis as { crossOriginIsolated?: boolean }).crossOriginIsolated === true
+  );
+}
+
+/**
+ * Allocate a shared buffer for a state ring.
+ *
+ * @param slots - Number of frame slots (at least 2)
+ * @returns A zeroed SharedArrayBuffer with the slot count written to the header
+ */
+export function createStateRingBuffer(slots: number = DEFAULT_STATE_RING_SLOTS): SharedArrayBuffer {
+  const slotCount = Math.max(2, Math.floor(slots));
+  const buffer = new SharedArrayBuffer(HEADER_BYTES + slotCount * SLOT_BYTES);
+  new Int32Array(buffer, 0, HEADER_BYTES / 4)[SLOT_COUNT_INDEX] = slotCount;
+  return buffer;
+}
+
+/**
+ * Validate a buffer received over postMessage before using it as a ring.
+ *
+ * @param buffer - Candidate buffer
+ * @returns True if the buffer is shared and large enough for its slot count
+ */
+export function isStateRingBuffer(buffer: unknown): buffer is SharedArrayBuffer {
+  if (typeof SharedArrayBuffer !== 'function' || !(buffer instanceof SharedArrayBuffer)) {
+    return false;
+  }
+  if (buffer.byteLength < HEADER_BYTES) return false;
+  const slotCount = new Int32Array(buffer, 0, HEADER_BYTES / 4)[SLOT_COUNT_INDEX];
+  return slotCount >= 2 && buffer.byteLength >= HEADER_BYTES + slotCount * SLOT_BYTES;
+}
+
+/**
+ * Writes CPU state frames into a ring. Used by the emulator worker.
+ * Reads straight from the WASM module so no state object is allocated.
+ */
+export class StateRingWriter {
+  private readonly header: Int32Array;
+  private readonly slotCount: number;
+  private readonly slotInts: Int32Array;
+  private readonly slotView: DataView;
+  private readonly slotBytes: Uint8Array;
+
+  /** Memory as of the last published frame, for computing dirty addresses. */
+  private readonly shadow = new Uint8Array(MEMORY_SIZE);
+  /** Dirty words for the frame being written. */
+  private readonly dirty = new Int32Array(DIRTY_WORDS);
+  /** The first frame marks every address dirty. */
+  private hasShadow = false;
+
+  /**
+   * Create a writer over a buffer from createStateRingBuffer().
+   *
+   * @param buffer - The shared ring buffer
+   */
+  constructor(buffer: SharedArrayBuffer) {
+    this.header = new Int32Array(buffer, 0, HEADER_BYTES / 4);
+    this.slotCount = this.header[SLOT_COUNT_INDEX];
+    this.slotInts = new Int32Array(buffer, HEADER_BYTES);
+    this.slotView = new DataView(buffer, HEADER_BYTES);
+    this.slotBytes = new Uint8Array(buffer, HEADER_BYTES);
+  }
+
+  /**
+   * Write the module's current state as the next frame and publish it.
+   *
+   * @param module - The WASM emulator module
+   */
+  write(module: EmulatorModule): void {
+    const seq = (Atomics.load(this.header, SEQ_INDEX) + 1) | 0;
+    const base = ((seq >>> 0) % this.slotCount) * SLOT_BYTES;
+    const versionIndex = (base + SLOT_VERSION) / 4;
+
+    // Seqlock: odd version while the slot is being filled
+    Atomics.add(this.slotInts, versionIndex, 1);
+
+    const flags =
+      (module._get_zero_flag() === 1 ? FLAG_ZERO : 0) |
+      (module._is_halted() === 1 ? FLAG_HALTED : 0) |
+      (module._has_error() === 1 ? FLAG_ERROR : 0);
+    const view = this.slotView;
+    view.setInt32(base + SLOT_FLAGS, flags, true);
+    view.setInt32(base + SLOT_PC, module._get_pc(), true);
+    view.setInt32(base + SLOT_ACC, module._get_accumulator(), true);
+    view.setInt32(base + SLOT_IR, module._get_ir(), true);
+    view.setInt32(base + SLOT_MAR, module._get_mar(), true);
+    view.setInt32(base + SLOT_MDR, module._get_mdr(), true);
+    view.setFloat64(base + SLOT_CYCLES, module._get_cycles(), true);
+    view.setFloat64(base + SLOT_INSTRUCTIONS, module._get_instructions(), true);
+
+    // Fresh view each time - the WASM buffer can be replaced on memory growth
+    const memory = new Uint8Array(module.HEAPU8.buffer, module._get_memory_ptr(), MEMORY_SIZE);
+    this.slotBytes.set(memory, base + SLOT_MEMORY);
+    this.collectDirty(memory);
+
+    Atomics.add(this.slotInts, versionIndex, 1);
+    Atomics.store(this.header, SEQ_INDEX, seq);
+
+    // Dirty bits go out after the sequence, so a reader that takes them
+    // always finds a published frame at least as new as the change
+    for (let w = 0; w < DIRTY_WORDS; w++) {
+      if (this.dirty[w] !== 0) {
+        Atomics.or(this.header, DIRTY_INDEX + w, this.dirty[w]);
+      }
+    }
+  }
+
+  /**
+   * Compare memory against the shadow copy, recording changed addresses
+   * in this.dirty and updating the shadow.
+   */
+  private collectDirty(memory: Uint8Array): void {
+    this.dirty.fill(0);
+    const shadow = this.shadow;
+    if (!this.hasShadow) {
+      this.dirty.fill(-1);
+      shadow.set(memory);
+      this.hasShadow = true;
+      return;
+    }
+    for (let addr = 0; addr < MEMORY_SIZE; addr++) {
+      const value = memory[addr];
+      if (shadow[addr] !== value) {
+        shadow[addr] = value;
+        this.dirty[addr >> 5] |= 1 << (addr & 31);
+      }
+    }
+  }
+}
+
+/**
+ * Reads the newest CPU state frame from a ring. Used on the main thread,
+ * typically once per animation frame.
+ */
+export class StateRingReader {
+  private readonly header: Int32Array;
+  private readonly slotCount: number;
+  private readonly slotInts: Int32Array;
+  private readonly slotView: DataView;
+  private readonly slotBytes: Uint8Array;
+
+  /** Memory as of the last frame returned; only dirty addresses are copied in. */
+  private readonly memory = new Uint8Array(MEMORY_SIZE);
+  /** Dirty words taken from the header but not yet applied. */
+  private readonly pendingDirty = new Int32Array(DIRTY_WORDS);
+  /** Sequence number of the last frame returned. */
+  private lastSeq = 0;
+
+  /**
+   * Create a reader over a buffer from createStateRingBuffer().
+   *
+   * @param buffer - The shared ring buffer
+   */
+  constructor(buffer: SharedArrayBuffer) {
+    this.header = new Int32Array(buffer, 0, HEADER_BYTES / 4);
+    this.slotCount = this.header[SLOT_COUNT_INDEX];
+    this.slotInts = new Int32Array(buffer, HEADER_BYTES);
+    this.slotView = new DataView(buffer, HEADER_BYTES);
+    this.slotBytes = new Uint8Array(buffer, HEADER_BYTES);
+  }
+
+  /**
+   * Read the newest frame if one was published since the last read.
+   * Frames in between are skipped; memory changes in them are not lost.
+   *
+   * @returns A fresh CPUState, or null if nothing new (or the writer kept lapping the read)
+   */
+  read(): CPUState | null {
+    if (Atomics.load(this.header, SEQ_INDEX) === this.lastSeq) return null;
+
+    // Take dirty bits before loading the sequence (see StateRingWriter.write)
+    for (let w = 0; w < DIRTY_WORDS; w++) {
+      this.pendingDirty[w] |= Atomics.exchange(this.header, DIRTY_INDEX + w, 0);
+    }
+
+    for (let attempt = 0; attempt < MAX_READ_ATTEMPTS; attempt++) {
+      const seq = Atomics.load(this.header, SEQ_INDEX);
+      const base = ((seq >>> 0) % this.slotCount) * SLOT_BYTES;
+      const versionIndex = (base + SLOT_VERSION) / 4;
+
+      const before = Atomics.load(this.slotInts, versionIndex);
+      if ((before & 1) !== 0) continue;
+
+      const view = this.slotView;
+      const flags = view.getInt32(base + SLOT_FLAGS, true);
+      const pc = view.getInt32(base + SLOT_PC, true);
+      const accumulator = view.getInt32(base + SLOT_ACC, true);
+      const ir = view.getInt32(base + SLOT_IR, true);
+      const mar = view.getInt32(base + SLOT_MAR, true);
+      const mdr = view.getInt32(base + SLOT_MDR, true);
+      const cycles = view.getFloat64(base + SLOT_CYCLES, true);
+      const instructions = view.getFloat64(base + SLOT_INSTRUCTIONS, true);
+      this.copyDirtyMemory(base + SLOT_MEMORY);
+
+      if (Atomics.load(this.slotInts, versionIndex) !== before) continue;
+
+      const memoryDirty = new Uint32Array(this.pendingDirty);
+      this.pendingDirty.fill(0);
+      this.lastSeq = seq;
+      const error = (flags & FLAG_ERROR) !== 0;
+      return {
+        pc,
+        accumulator,
+        zeroFlag: (flags & FLAG_ZERO) !== 0,
+        halted: (flags & FLAG_HALTED) !== 0,
+        error,
+        // Strings do not fit the ring; the worker posts error states by message instead
+        errorMessage: null,
+        memory: this.memory.slice(),
+        ir,
+        mar,
+        mdr,
+        cycles,
+        instructions,
+        memoryDirty,
+      };
+    }
+
+    // Dirty bits stay pending, so the next read copies them again
+    return null;
+  }
+
+  /**
+   * Treat every frame published so far as read, so read() only returns
+   * newer ones. Used when a newer state arrived by message. Dirty memory
+   * bits are kept and applied by the next read.
+   */
+  skipPublished(): void {
+    this.lastSeq = Atomics.load(this.header, SEQ_INDEX);
+  }
+
+  /**
+   * Copy the addresses marked in pendingDirty from a slot's memory.
+   */
+  private copyDirtyMemory(offset: number): void {
+    const bytes = this.slotBytes;
+    for (let w = 0; w < DIRTY_WORDS; w++) {
+      let bits = this.pendingDirty[w];
+      while (bits !== 0) {
+        const bit = 31 - Math.clz32(bits & -bits);
+        const addr = (w << 5) | bit;
+        this.memory[addr] = bytes[offset + addr];
+        bits &= bits - 1;
+      }
+    }
+  }
+}
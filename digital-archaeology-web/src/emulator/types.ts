@@ -584,6 +584,12 @@ export interface CPUState {
   cycles: number;
   /** Total instructions executed */
   instructions: number;
+  /**
+   * Addresses whose memory may have changed since the previous state from the
+   * same source, one bit per address (bit a & 31 of word a >> 5). Present on
+   * states read from the shared state ring; absent means unknown.
+   */
+  memoryDirty?: Uint32Array;
 }
 
 /* ============================================================================
@@ -658,7 +664,7 @@ export interface RestoreStateCommand {
 export interface SetSpeedCommand {
   type: 'SET_SPEED';
   payload: {
-    /** New execution speed (0 = max speed, >0 = instructions per ~16ms tick) */
+    /** New execution speed in instructions per second (0 = max speed) */
     speed: number;
   };
 }
@@ -692,6 +698,30 @@ export interface GetBreakpointsCommand {
   type: 'GET_BREAKPOINTS';
 }
 
+/**
+ * Command to also send every STATE_UPDATE to a MessagePort, such as one
+ * connected to the circuit render worker.
+ */
+export interface ConnectCircuitPortCommand {
+  type: 'CONNECT_CIRCUIT_PORT';
+  payload: {
+    /** Port to receive STATE_UPDATE events (transferred) */
+    port: MessagePort;
+  };
+}
+
+/**
+ * Command to publish run-loop state through a shared state ring instead of
+ * one STATE_UPDATE message per tick. See stateRing.ts for the layout.
+ */
+export interface AttachStateRingCommand {
+  type: 'ATTACH_STATE_RING';
+  payload: {
+    /** Ring buffer from createStateRingBuffer() */
+    buffer: SharedArrayBuffer;
+  };
+}
+
 /**
  * Union of all emulator commands (main → worker).
  */
@@ -706,7 +736,9 @@ export type EmulatorCommand =
   | SetSpeedCommand
   | SetBreakpointCommand
   | ClearBreakpointCommand
-  | GetBreakpointsCommand;
+  | GetBreakpointsCommand
+  | ConnectCircuitPortCommand
+  | AttachStateRingCommand;
 
 /**
  * Event with updated CPU state.
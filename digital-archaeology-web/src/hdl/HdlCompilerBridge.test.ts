@@ -0,0 +1,127 @@
+// src/hdl/HdlCompilerBridge.test.ts
+// Unit tests for HdlCompilerBridge using a mock worker
+// Story 7.6: Implement HDL-to-Circuit Regeneration
+
+import { describe, it, expect, beforeEach, afterEach } from 'vitest';
+import { HdlCompilerBridge } from './HdlCompilerBridge';
+import { isHdlCompileCommand, handleCompile, handlePrime, handleReset } from './hdlCompile.worker';
+import type { HdlCompileWorkerEvent } from './types';
+
+const SOURCE = 'wire a\nwire b\nwire c\nand g1 (input: a, b; output: c)';
+
+/**
+ * Mock Worker that runs queued commands through the real worker handlers
+ * when the test calls flush().
+ */
+class MockWorker {
+  onmessage: ((event: MessageEvent<HdlCompileWorkerEvent>) => void) | null = null;
+  onerror: ((event: ErrorEvent) => void) | null = null;
+  public queue: unknown[] = [];
+  public terminated = false;
+
+  postMessage(data: unknown): void {
+    this.queue.push(data);
+  }
+
+  terminate(): void {
+    this.terminated = true;
+  }
+
+  // Test helpers
+  flush(): void {
+    const commands = this.queue.splice(0);
+    for (const data of commands) {
+      if (!isHdlCompileCommand(data)) continue;
+      if (data.type === 'COMPILE') {
+        const { requestId, content, generate } = data.payload;
+        this.onmessage?.({ data: handleCompile(requestId, content, generate) } as MessageEvent<HdlCompileWorkerEvent>);
+      } else if (data.type === 'PRIME') {
+        handlePrime(data.payload.content);
+      } else {
+        handleReset();
+      }
+    }
+  }
+
+  simulateError(message: string): void {
+    this.onerror?.({ message } as ErrorEvent);
+  }
+}
+
+// Store the original Worker constructor
+const OriginalWorker = globalThis.Worker;
+
+describe('HdlCompilerBridge', () => {
+  let mockWorker: MockWorker;
+
+  beforeEach(() => {
+    handleReset();
+    mockWorker = new MockWorker();
+    class MockWorkerConstructor {
+      constructor() {
+        return mockWorker;
+      }
+    }
+    globalThis.Worker = MockWorkerConstructor as unknown as typeof Worker;
+  });
+
+  afterEach(() => {
+    globalThis.Worker = OriginalWorker;
+  });
+
+  it('should compile inline when workers are unavailable', async () => {
+    globalThis.Worker = undefined as unknown as typeof Worker;
+    const bridge = new HdlCompilerBridge();
+
+    const result = await bridge.compile(SOURCE, true);
+
+    expect(bridge.usesWorker).toBe(false);
+    expect(result.validation.valid).toBe(true);
+    expect(result.circuitData?.gates).toHaveLength(1);
+  });
+
+  it('should compile in the worker and rebuild the circuit from patches', async () => {
+    const bridge = new HdlCompilerBridge();
+
+    const first = bridge.compile(SOURCE, true);
+    const second = bridge.compile(SOURCE.replace('and g1', 'or g1'), true);
+    mockWorker.flush();
+    const [a, b] = await Promise.all([first, second]);
+
+    expect(bridge.usesWorker).toBe(true);
+    expect(a.circuitData?.gates[0].type).toBe('AND');
+    expect(b.circuitData?.gates[0].type).toBe('OR');
+    // Unchanged wires are shared between the two circuits
+    expect(b.circuitData?.wires[0]).toBe(a.circuitData?.wires[0]);
+  });
+
+  it('should send prime commands to the worker', () => {
+    const bridge = new HdlCompilerBridge();
+
+    bridge.prime(SOURCE);
+
+    expect(mockWorker.queue).toEqual([{ type: 'PRIME', payload: { content: SOURCE } }]);
+  });
+
+  it('should finish pending compiles inline when the worker fails', async () => {
+    const bridge = new HdlCompilerBridge();
+
+    const pending = bridge.compile(SOURCE, true);
+    mockWorker.simulateError('boom');
+    const result = await pending;
+
+    expect(mockWorker.terminated).toBe(true);
+    expect(bridge.usesWorker).toBe(false);
+    expect(result.circuitData?.wires).toHaveLength(3);
+  });
+
+  it('should reject pending compiles on terminate', async () => {
+    const bridge = new HdlCompilerBridge();
+
+    const pending = bridge.compile(SOURCE, false);
+    bridge.terminate();
+
+    await expect(pending).rejects.toThrow('terminated');
+    expect(mockWorker.terminated).toBe(true);
+  });
+});
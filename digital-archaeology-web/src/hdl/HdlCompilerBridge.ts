@@ -0,0 +1,178 @@
+// src/hdl/HdlCompilerBridge.ts
+// Promise-based access to the HDL compile worker, with an inline fallback
+// Story 7.6: Implement HDL-to-Circuit Regeneration
+
+import { HdlIncrementalCompiler, applyCircuitPatch } from './HdlIncrementalCompiler';
+import type { HdlCompileResult } from './HdlIncrementalCompiler';
+import type { HdlCompileWorkerCommand, HdlCompileWorkerEvent } from './types';
+import type { CircuitData } from '../visualizer/types';
+
+/**
+ * A compile request waiting for the worker's answer.
+ */
+interface PendingCompile {
+  content: string;
+  generate: boolean;
+  resolve: (result: HdlCompileResult) => void;
+  reject: (error: Error) => void;
+}
+
+/**
+ * Runs HDL validation and circuit generation in a Web Worker so large edits
+ * never block typing. Circuits arrive as patches against the previous one and
+ * are rebuilt here, sharing unchanged wire and gate objects.
+ *
+ * Where workers are unavailable (tests, old browsers) or the worker fails,
+ * the same line-cached compiler runs on the calling thread instead.
+ *
+ * @example
+ * ```typescript
+ * const bridge = new HdlCompilerBridge();
+ * const { validation, circuitData } = await bridge.compile(source, true);
+ * bridge.terminate();
+ * ```
+ */
+export class HdlCompilerBridge {
+  private worker: Worker | null = null;
+  private workerFailed = false;
+  private readonly inlineCompiler = new HdlIncrementalCompiler();
+  private readonly pending = new Map<number, PendingCompile>();
+  private nextRequestId = 1;
+
+  /** The last circuit received from the worker, base for the next patch */
+  private circuitBase: CircuitData | null = null;
+
+  /**
+   * Whether compiles run in a worker (and compile() resolves asynchronously).
+   */
+  get usesWorker(): boolean {
+    return !this.workerFailed && typeof Worker !== 'undefined';
+  }
+
+  /**
+   * Validate HDL content and, optionally, generate its circuit.
+   * @param content - The HDL source code
+   * @param generate - Whether to generate the circuit when the content is valid
+   * @returns Promise resolving to the compile result
+   */
+  compile(content: string, generate: boolean): Promise<HdlCompileResult> {
+    const worker = this.ensureWorker();
+    if (!worker) {
+      return Promise.resolve(this.compileSync(content, generate));
+    }
+
+    return new Promise<HdlCompileResult>((resolve, reject) => {
+      const requestId = this.nextRequestId++;
+      this.pending.set(requestId, { content, generate, resolve, reject });
+      this.post(worker, { type: 'COMPILE', payload: { requestId, content, generate } });
+    });
+  }
+
+  /**
+   * Validate and generate on the calling thread.
+   * @param content - The HDL source code
+   * @param generate - Whether to generate the circuit when the content is valid
+   * @returns The compile result
+   */
+  compileSync(content: string, generate: boolean): HdlCompileResult {
+    return this.inlineCompiler.compile(content, generate);
+  }
+
+  /**
+   * Let the worker analyze content in the background so the next compile
+   * only re-analyzes lines edited since. Does nothing without a worker.
+   * @param content - The HDL source code
+   */
+  prime(content: string): void {
+    const worker = this.ensureWorker();
+    if (worker) {
+      this.post(worker, { type: 'PRIME', payload: { content } });
+    }
+  }
+
+  /**
+   * Terminate the worker. Pending compiles are rejected.
+   */
+  terminate(): void {
+    this.worker?.terminate();
+    this.worker = null;
+    this.circuitBase = null;
+    this.inlineCompiler.reset();
+    this.rejectPending(new Error('HDL compiler terminated'));
+  }
+
+  /**
+   * Get the worker, creating it on first use.
+   * @returns The worker, or null when compiles should run inline
+   */
+  private ensureWorker(): Worker | null {
+    if (this.worker || !this.usesWorker) return this.worker;
+
+    try {
+      this.worker = new Worker(new URL('./hdlCompile.worker.ts', import.meta.url), { type: 'module' });
+    } catch (error) {
+      console.warn('HDL compile worker unavailable, compiling on the main thread:', error);
+      this.workerFailed = true;
+      return null;
+    }
+
+    this.worker.onmessage = (event: MessageEvent<HdlCompileWorkerEvent>) => this.handleMessage(event.data);
+    this.worker.onerror = (event: ErrorEvent) => this.handleWorkerError(event);
+    return this.worker;
+  }
+
+  /**
+   * Post a command to the worker.
+   */
+  private post(worker: Worker, command: HdlCompileWorkerCommand): void {
+    worker.postMessage(command);
+  }
+
+  /**
+   * Handle a message from the worker. Results arrive in request order, so
+   * each patch applies to the circuit from the previous result.
+   */
+  private handleMessage(data: HdlCompileWorkerEvent): void {
+    if (data.type !== 'COMPILE_RESULT') return;
+
+    const { requestId, validation, patch, error } = data.payload;
+    let circuitData: CircuitData | null = null;
+    if (patch) {
+      circuitData = applyCircuitPatch(this.circuitBase, patch);
+      this.circuitBase = circuitData;
+    }
+
+    const request = this.pending.get(requestId);
+    if (!request) return;
+    this.pending.delete(requestId);
+    request.resolve({ validation, circuitData, error });
+  }
+
+  /**
+   * Stop using a failed worker and finish its pending compiles inline.
+   */
+  private handleWorkerError(event: ErrorEvent): void {
+    console.warn('HDL compile worker failed, compiling on the main thread:', event.message);
+    this.worker?.terminate();
+    this.worker = null;
+    this.workerFailed = true;
+    this.circuitBase = null;
+
+    const requests = [...this.pending.values()];
+    this.pending.clear();
+    for (const request of requests) {
+      request.resolve(this.compileSync(request.content, request.generate));
+    }
+  }
+
+  /**
+   * Reject and forget all pending compiles.
+   */
+  private rejectPending(error: Error): void {
+    const requests = [...this.pending.values()];
+    this.pending.clear();
+    for (const request of requests) {
+      request.reject(error);
+    }
+  }
+}
@@ -0,0 +1,170 @@
+// src/hdl/HdlIncrementalCompiler.test.ts
+// Unit tests for HdlIncrementalCompiler and circuit patches
+// Story 7.6: Implement HDL-to-Circuit Regeneration
+
+import { describe, it, expect, beforeEach } from 'vitest';
+import { HdlIncrementalCompiler, diffCircuit, applyCircuitPatch } from './HdlIncrementalCompiler';
+import { HdlValidator } from './HdlValidator';
+import { HdlParser } from './HdlParser';
+import { HdlToCircuitGenerator } from './HdlToCircuitGenerator';
+
+const HALF_ADDER = [
+  '# Half adder',
+  'wire a',
+  'wire b',
+  'wire sum',
+  'wire carry',
+  '',
+  'xor x1 (input: a, b; output: sum)',
+  'and a1 (input: a, b; output: carry)',
+].join('\n');
+
+describe('HdlIncrementalCompiler', () => {
+  let compiler: HdlIncrementalCompiler;
+
+  beforeEach(() => {
+    compiler = new HdlIncrementalCompiler();
+  });
+
+  describe('parity with the non-incremental pipeline', () => {
+    const samples = [
+      HALF_ADDER,
+      'wire a\nwire a',
+      'and g1 (input: undefined_wire; output: c)',
+      'wire a\nwire b\nfoo g1 (input: a; output: b)',
+      'wire a\nwire b\nnot n1 (input: a, b; output: b)',
+      'wire [4] data\nwire q\nbuf b1 (input: data[2]; output: q)',
+      'wire a\nwire b\nand g1 (input: a; output: b)\nand g1 (input: a; output: b)',
+      'wire unused\nwire x\nwire y\nnot n1 (input: x; output: y)',
+      'this is not hdl',
+    ];
+
+    it('should validate like HdlValidator', () => {
+      for (const content of samples) {
+        expect(compiler.compile(content, false).validation).toEqual(new HdlValidator().validate(content));
+      }
+    });
+
+    it('should generate the same circuit as parse + generate', () => {
+      const expected = new HdlToCircuitGenerator().generate(new HdlParser().parse(HALF_ADDER));
+
+      const result = compiler.compile(HALF_ADDER, true);
+
+      expect(result.error).toBeNull();
+      expect(result.circuitData).toEqual(expected);
+    });
+
+    it('should not generate a circuit for invalid content', () => {
+      const result = compiler.compile('and g1 (input: nope; output: c)', true);
+
+      expect(result.validation.valid).toBe(false);
+      expect(result.circuitData).toBeNull();
+      expect(result.error).toBeNull();
+    });
+
+    it('should not generate a circuit unless asked', () => {
+      expect(compiler.compile(HALF_ADDER, false).circuitData).toBeNull();
+    });
+  });
+
+  describe('line cache', () => {
+    it('should analyze every statement on the first compile', () => {
+      compiler.compile(HALF_ADDER, false);
+
+      expect(compiler.getLastStats()).toEqual({ analyzed: 6, reused: 0 });
+    });
+
+    it('should only analyze edited lines on the next compile', () => {
+      compiler.compile(HALF_ADDER, false);
+      compiler.compile(HALF_ADDER.replace('and a1', 'or a1'), false);
+
+      expect(compiler.getLastStats()).toEqual({ analyzed: 1, reused: 5 });
+    });
+
+    it('should ignore indentation changes', () => {
+      compiler.compile(HALF_ADDER, false);
+      compiler.compile(HALF_ADDER.replace('wire b', '   wire b'), false);
+
+      expect(compiler.getLastStats()).toEqual({ analyzed: 0, reused: 6 });
+    });
+
+    it('should drop lines that are no longer present', () => {
+      compiler.compile('wire a\nwire b', false);
+      compiler.compile('wire a', false);
+      compiler.compile('wire a\nwire b', false);
+
+      expect(compiler.getLastStats()).toEqual({ analyzed: 1, reused: 1 });
+    });
+
+    it('should report duplicates that come from identical cached lines', () => {
+      const result = compiler.compile('wire a\nwire a', false);
+
+      expect(result.validation.valid).toBe(false);
+      expect(result.validation.errors[0]).toMatchObject({ line: 2 });
+    });
+
+    it('should re-analyze everything after reset', () => {
+      compiler.compile(HALF_ADDER, false);
+      compiler.reset();
+      compiler.compile(HALF_ADDER, false);
+
+      expect(compiler.getLastStats()).toEqual({ analyzed: 6, reused: 0 });
+    });
+  });
+});
+
+describe('circuit patches', () => {
+  const generate = (content: string) => new HdlIncrementalCompiler().compile(content, true).circuitData!;
+
+  it('should include every wire and gate when there is no previous circuit', () => {
+    const circuit = generate(HALF_ADDER);
+
+    const patch = diffCircuit(null, circuit);
+
+    expect(patch.wires).toHaveLength(4);
+    expect(patch.gates).toHaveLength(2);
+    expect(applyCircuitPatch(null, patch)).toEqual(circuit);
+  });
+
+  it('should be empty for an identical circuit', () => {
+    const patch = diffCircuit(generate(HALF_ADDER), generate(HALF_ADDER));
+
+    expect(patch.wires).toHaveLength(0);
+    expect(patch.gates).toHaveLength(0);
+  });
+
+  it('should contain only the changed gate', () => {
+    const before = generate(HALF_ADDER);
+    const after = generate(HALF_ADDER.replace('and a1', 'or a1'));
+
+    const patch = diffCircuit(before, after);
+
+    expect(patch.wires).toHaveLength(0);
+    expect(patch.gates.map((g) => g.index)).toEqual([1]);
+  });
+
+  it('should rebuild the new circuit, sharing unchanged objects with the base', () => {
+    const before = generate(HALF_ADDER);
+    const after = generate(HALF_ADDER.replace('and a1', 'or a1'));
+
+    const rebuilt = applyCircuitPatch(before, diffCircuit(before, after));
+
+    expect(rebuilt).toEqual(after);
+    expect(rebuilt.wires[0]).toBe(before.wires[0]);
+    expect(rebuilt.gates[0]).toBe(before.gates[0]);
+    expect(before.gates[1].type).toBe('AND');
+  });
+
+  it('should handle circuits that shrink', () => {
+    const before = generate(HALF_ADDER);
+    const after = generate('wire a\nwire b\nnot n1 (input: a; output: b)');
+
+    expect(applyCircuitPatch(before, diffCircuit(before, after))).toEqual(after);
+  });
+
+  it('should reject a patch applied to the wrong base', () => {
+    const patch = diffCircuit(generate('wire a'), generate('wire a\nwire b'));
+
+    expect(() => applyCircuitPatch(null, patch)).toThrow('does not match');
+  });
+});
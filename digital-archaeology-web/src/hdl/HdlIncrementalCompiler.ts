@@ -0,0 +1,274 @@
+// src/hdl/HdlIncrementalCompiler.ts
+// Incremental HDL validation and circuit generation with per-line caching
+// Story 7.6: Implement HDL-to-Circuit Regeneration
+
+import { HdlParser } from './HdlParser';
+import type { HdlAst, HdlStatement, HdlWireNode, HdlGateNode } from './HdlParser';
+import { HdlValidator, checkHdlLine } from './HdlValidator';
+import type { HdlLineCheck, HdlValidationResult } from './HdlValidator';
+import { HdlToCircuitGenerator } from './HdlToCircuitGenerator';
+import type { CircuitData, CircuitWire, CircuitGate, GatePort } from '../visualizer/types';
+
+/**
+ * Result of compiling HDL content.
+ */
+export interface HdlCompileResult {
+  /** Validation result, identical to HdlValidator.validate() */
+  validation: HdlValidationResult;
+  /** Generated circuit, when requested and the content is valid */
+  circuitData: CircuitData | null;
+  /** Parse or generation failure message, when requested and it failed */
+  error: string | null;
+}
+
+/**
+ * The wires and gates that differ between two generated circuits.
+ * Wire and gate IDs are their indexes, so entries are keyed by index.
+ */
+export interface HdlCircuitPatch {
+  /** Number of wires in the new circuit */
+  wireCount: number;
+  /** Number of gates in the new circuit */
+  gateCount: number;
+  /** New or changed wires */
+  wires: Array<{ index: number; wire: CircuitWire }>;
+  /** New or changed gates */
+  gates: Array<{ index: number; gate: CircuitGate }>;
+}
+
+/**
+ * What a line contributes, cached by the line's trimmed text.
+ */
+interface CachedLine {
+  check: HdlLineCheck;
+  statement: HdlStatement | null;
+}
+
+/**
+ * Validates and generates circuits from HDL content, re-analyzing only lines
+ * whose text changed since the previous compile. M4HDL has one statement per
+ * line and a line's syntax does not depend on its neighbours, so per-line
+ * syntax checks and AST nodes are cached by line text. The cross-line checks
+ * and circuit generation run over the cached results without any regex work.
+ */
+export class HdlIncrementalCompiler {
+  private readonly parser = new HdlParser();
+  private readonly validator = new HdlValidator();
+  private readonly generator = new HdlToCircuitGenerator();
+
+  /** Line text to analysis, holding only lines present in the last compile */
+  private cache = new Map<string, CachedLine>();
+
+  /** Lines analyzed and lines served from the cache by the last compile */
+  private stats = { analyzed: 0, reused: 0 };
+
+  /**
+   * Compile HDL content.
+   * @param content - The HDL source code
+   * @param generate - Whether to generate the circuit when the content is valid
+   * @returns Validation result and, if requested, the generated circuit
+   */
+  compile(content: string, generate: boolean): HdlCompileResult {
+    const lines = content.split('\n');
+    const checks: Array<HdlLineCheck | null> = new Array(lines.length);
+    const statements: Array<HdlStatement | null> = new Array(lines.length);
+    const nextCache = new Map<string, CachedLine>();
+    let analyzed = 0;
+    let reused = 0;
+
+    for (let i = 0; i < lines.length; i++) {
+      const trimmedLine = lines[i].trim();
+
+      // Skip empty lines and comments
+      if (trimmedLine === '' || trimmedLine.startsWith('#')) {
+        checks[i] = null;
+        statements[i] = null;
+        continue;
+      }
+
+      let entry = nextCache.get(trimmedLine) ?? this.cache.get(trimmedLine);
+      if (entry) {
+        reused++;
+      } else {
+        entry = { check: checkHdlLine(trimmedLine), statement: this.parser.parseStatement(trimmedLine) };
+        analyzed++;
+      }
+      nextCache.set(trimmedLine, entry);
+      checks[i] = entry.check;
+      statements[i] = entry.statement;
+    }
+
+    this.cache = nextCache;
+    this.stats = { analyzed, reused };
+
+    const validation = this.validator.validateLines(checks);
+    if (!generate || !validation.valid) {
+      return { validation, circuitData: null, error: null };
+    }
+
+    try {
+      const ast = this.buildAst(lines, statements);
+
+      // Check for parse errors (shouldn't happen if validation passed, but be safe)
+      if (ast.errors.length > 0) {
+        throw new Error(`HDL parsing failed: ${ast.errors[0].message}`);
+      }
+
+      return { validation, circuitData: this.generator.generate(ast), error: null };
+    } catch (error) {
+      const message = error instanceof Error ? error.message : 'Unknown error';
+      return { validation, circuitData: null, error: message };
+    }
+  }
+
+  /**
+   * Get how many lines the last compile analyzed and how many it reused.
+   * @returns Line counts
+   */
+  getLastStats(): { analyzed: number; reused: number } {
+    return { ...this.stats };
+  }
+
+  /**
+   * Drop all cached lines.
+   */
+  reset(): void {
+    this.cache.clear();
+    this.stats = { analyzed: 0, reused: 0 };
+  }
+
+  /**
+   * Assemble an AST from cached statements, in source order.
+   * @param lines - Source lines
+   * @param statements - Parsed statement per line (null for blank, comment or unparsed)
+   * @returns The AST, with errors for non-blank lines that did not parse
+   */
+  private buildAst(lines: string[], statements: Array<HdlStatement | null>): HdlAst {
+    const wires: HdlWireNode[] = [];
+    const gates: HdlGateNode[] = [];
+    const errors: HdlAst['errors'] = [];
+
+    for (let i = 0; i < statements.length; i++) {
+      const statement = statements[i];
+      if (statement?.kind === 'wire') {
+        wires.push(statement.wire);
+      } else if (statement?.kind === 'gate') {
+        gates.push(statement.gate);
+      } else {
+        const trimmedLine = lines[i].trim();
+        if (trimmedLine !== '' && !trimmedLine.startsWith('#')) {
+          errors.push({ line: i + 1, column: 1, message: `Unrecognized statement: '${trimmedLine}'` });
+        }
+      }
+    }
+
+    return { wires, gates, errors };
+  }
+}
+
+/**
+ * Compute the patch that turns one generated circuit into another.
+ * @param previous - The circuit the receiver already has, or null
+ * @param next - The new circuit
+ * @returns Wires and gates that are new or differ from previous
+ */
+export function diffCircuit(previous: CircuitData | null, next: CircuitData): HdlCircuitPatch {
+  const wires: HdlCircuitPatch['wires'] = [];
+  for (let i = 0; i < next.wires.length; i++) {
+    const before = previous?.wires[i];
+    if (!before || !sameWire(before, next.wires[i])) {
+      wires.push({ index: i, wire: next.wires[i] });
+    }
+  }
+
+  const gates: HdlCircuitPatch['gates'] = [];
+  for (let i = 0; i < next.gates.length; i++) {
+    const before = previous?.gates[i];
+    if (!before || !sameGate(before, next.gates[i])) {
+      gates.push({ index: i, gate: next.gates[i] });
+    }
+  }
+
+  return { wireCount: next.wires.length, gateCount: next.gates.length, wires, gates };
+}
+
+/**
+ * Apply a patch to the circuit it was computed against. Unchanged wire and
+ * gate objects are shared with the base, which is not modified.
+ * @param base - The circuit the patch was computed against, or null
+ * @param patch - The patch
+ * @returns The new circuit
+ */
+export function applyCircuitPatch(base: CircuitData | null, patch: HdlCircuitPatch): CircuitData {
+  const wires = (base?.wires ?? []).slice(0, patch.wireCount);
+  for (const { index, wire } of patch.wires) {
+    wires[index] = wire;
+  }
+
+  const gates = (base?.gates ?? []).slice(0, patch.gateCount);
+  for (const { index, gate } of patch.gates) {
+    gates[index] = gate;
+  }
+
+  if (wires.length !== patch.wireCount || gates.length !== patch.gateCount) {
+    throw new Error('Circuit patch does not match its base circuit');
+  }
+  for (let i = 0; i < wires.length; i++) {
+    if (!wires[i]) throw new Error('Circuit patch does not match its base circuit');
+  }
+  for (let i = 0; i < gates.length; i++) {
+    if (!gates[i]) throw new Error('Circuit patch does not match its base circuit');
+  }
+
+  return { cycle: 0, stable: true, wires, gates };
+}
+
+/**
+ * Compare two wires field by field.
+ */
+function sameWire(a: CircuitWire, b: CircuitWire): boolean {
+  return (
+    a.id === b.id &&
+    a.name === b.name &&
+    a.width === b.width &&
+    a.is_input === b.is_input &&
+    a.is_output === b.is_output &&
+    sameNumbers(a.state, b.state)
+  );
+}
+
+/**
+ * Compare two gates field by field.
+ */
+function sameGate(a: CircuitGate, b: CircuitGate): boolean {
+  return (
+    a.id === b.id &&
+    a.name === b.name &&
+    a.type === b.type &&
+    a.stored === b.stored &&
+    samePorts(a.inputs, b.inputs) &&
+    samePorts(a.outputs, b.outputs)
+  );
+}
+
+/**
+ * Compare two number arrays.
+ */
+function sameNumbers(a: number[], b: number[]): boolean {
+  if (a.length !== b.length) return false;
+  for (let i = 0; i < a.length; i++) {
+    if (a[i] !== b[i]) return false;
+  }
+  return true;
+}
+
+/**
+ * Compare two port lists by wire and bit.
+ */
+function samePorts(a: GatePort[], b: GatePort[]): boolean {
+  if (a.length !== b.length) return false;
+  for (let i = 0; i < a.length; i++) {
+    if (a[i].wire !== b[i].wire || a[i].bit !== b[i].bit) return false;
+  }
+  return true;
+}
@@ -64,6 +64,13 @@ export interface HdlAst {
   errors: HdlParseError[];
 }
 
+/**
+ * A single parsed statement line.
+ */
+export type HdlStatement =
+  | { kind: 'wire'; wire: HdlWireNode }
+  | { kind: 'gate'; gate: HdlGateNode };
+
 /**
  * Parses M4HDL content into an Abstract Syntax Tree.
  * Reuses parsing patterns from HdlValidator for consistency.
@@ -91,17 +98,13 @@ export class HdlParser {
         continue;
       }
 
-      // Try to parse wire declaration
-      const wireNode = this.parseWireDeclaration(trimmedLine);
-      if (wireNode) {
-        wires.push(wireNode);
+      const statement = this.parseStatement(trimmedLine);
+      if (statement?.kind === 'wire') {
+        wires.push(statement.wire);
         continue;
       }
-
-      // Try to parse gate instantiation
-      const gateNode = this.parseGateInstantiation(trimmedLine);
-      if (gateNode) {
-        gates.push(gateNode);
+      if (statement?.kind === 'gate') {
+        gates.push(statement.gate);
         continue;
       }
 
@@ -116,6 +119,28 @@ export class HdlParser {
     return { wires, gates, errors };
   }
 
+  /**
+   * Parse one trimmed, non-empty, non-comment line.
+   * The result depends only on the line's text, so it can be cached per line.
+   * @param trimmedLine - The statement text
+   * @returns The wire or gate the line declares, or null if it matches neither
+   */
+  parseStatement(trimmedLine: string): HdlStatement | null {
+    // Try to parse wire declaration
+    const wire = this.parseWireDeclaration(trimmedLine);
+    if (wire) {
+      return { kind: 'wire', wire };
+    }
+
+    // Try to parse gate instantiation
+    const gate = this.parseGateInstantiation(trimmedLine);
+    if (gate) {
+      return { kind: 'gate', gate };
+    }
+
+    return null;
+  }
+
   /**
    * Parse a wire declaration line.
    * Formats:
@@ -55,6 +55,113 @@ const GATE_DEFINITIONS: Record<string, GateDefinition> = {
   latch: { minInputs: 2, maxInputs: 2, outputs: 1 },
 };
 
+/**
+ * Result of checking one statement line on its own, before the checks that
+ * depend on other lines (duplicates, undefined and unused wires). Line
+ * checks depend only on the line's text, so they can be cached per line.
+ */
+export type HdlLineCheck =
+  | {
+      kind: 'wire';
+      /** Declared wire name */
+      name: string;
+    }
+  | {
+      kind: 'gate';
+      /** Gate type (lowercase) */
+      type: string;
+      /** Gate instance name */
+      name: string;
+      /** Input wire references as written (e.g. bus[0]) */
+      inputs: string[];
+      /** Output wire references as written */
+      outputs: string[];
+      /** Port count errors, reported after any duplicate name error */
+      portErrors: string[];
+    }
+  | {
+      kind: 'error';
+      message: string;
+    };
+
+/**
+ * Check a single trimmed, non-empty, non-comment HDL line on its own.
+ * @param trimmedLine - The statement text
+ * @returns What the line declares, or the syntax error it contains
+ */
+export function checkHdlLine(trimmedLine: string): HdlLineCheck {
+  // Check for unmatched brackets in wire declarations
+  const openBrackets = (trimmedLine.match(/\[/g) || []).length;
+  const closeBrackets = (trimmedLine.match(/\]/g) || []).length;
+  if (openBrackets !== closeBrackets) {
+    return {
+      kind: 'error',
+      message: `Unmatched bracket in line: expected ${openBrackets} closing brackets, found ${closeBrackets}`,
+    };
+  }
+
+  // Check for unmatched parentheses
+  const openParens = (trimmedLine.match(/\(/g) || []).length;
+  const closeParens = (trimmedLine.match(/\)/g) || []).length;
+  if (openParens !== closeParens) {
+    return {
+      kind: 'error',
+      message: `Unmatched parenthesis in line: expected ${openParens} closing parentheses, found ${closeParens}`,
+    };
+  }
+
+  // Parse wire declaration: wire name or wire name[bits]
+  const wireMatch = trimmedLine.match(/^wire\s+([a-zA-Z_][a-zA-Z0-9_]*)(\[\d+(:\d+)?\])?$/i);
+  if (wireMatch) {
+    return { kind: 'wire', name: wireMatch[1] };
+  }
+
+  // Parse gate instantiation: gatetype name (input: wire1, wire2; output: wire3)
+  const gateMatch = trimmedLine.match(
+    /^([a-zA-Z_][a-zA-Z0-9_]*)\s+([a-zA-Z_][a-zA-Z0-9_]*)\s*\(\s*input:\s*([^;]+);\s*output:\s*([^)]+)\s*\)$/i
+  );
+  if (gateMatch) {
+    const gateType = gateMatch[1].toLowerCase();
+    const gateName = gateMatch[2];
+
+    // Check if gate type is valid
+    const gateDef = GATE_DEFINITIONS[gateType];
+    if (!gateDef) {
+      return { kind: 'error', message: `Unknown gate type: '${gateType}'` };
+    }
+
+    // Parse input and output wires
+    const inputs = gateMatch[3].split(',').map((w) => w.trim()).filter((w) => w);
+    const outputs = gateMatch[4].split(',').map((w) => w.trim()).filter((w) => w);
+
+    // Validate input count
+    const portErrors: string[] = [];
+    if (inputs.length < gateDef.minInputs) {
+      portErrors.push(
+        `Gate '${gateName}' (${gateType}) requires at least ${gateDef.minInputs} inputs, but got ${inputs.length}`
+      );
+    }
+    if (inputs.length > gateDef.maxInputs) {
+      portErrors.push(
+        `Gate '${gateName}' (${gateType}) accepts at most ${gateDef.maxInputs} inputs, but got ${inputs.length}`
+      );
+    }
+
+    return { kind: 'gate', type: gateType, name: gateName, inputs, outputs, portErrors };
+  }
+
+  // If we get here, the line doesn't match any known pattern
+  // Check if it looks like a wire or gate but has syntax errors
+  if (trimmedLine.toLowerCase().startsWith('wire ')) {
+    return { kind: 'error', message: `Invalid wire declaration syntax: '${trimmedLine}'` };
+  }
+  if (/^[a-zA-Z_][a-zA-Z0-9_]*\s+[a-zA-Z_][a-zA-Z0-9_]*/.test(trimmedLine)) {
+    // Looks like a gate instantiation but doesn't match the pattern
+    return { kind: 'error', message: `Invalid gate instantiation syntax: '${trimmedLine}'` };
+  }
+  return { kind: 'error', message: `Unrecognized statement: '${trimmedLine}'` };
+}
+
 /**
  * HDL Validator for M4HDL hardware description language.
  * Validates syntax and semantic correctness of HDL content.
@@ -66,6 +173,27 @@ export class HdlValidator {
    * @returns Validation result with errors and warnings
    */
   validate(content: string): HdlValidationResult {
+    const lines = content.split('\n');
+    const checks: Array<HdlLineCheck | null> = new Array(lines.length);
+
+    for (let lineIndex = 0; lineIndex < lines.length; lineIndex++) {
+      const trimmedLine = lines[lineIndex].trim();
+
+      // Skip empty lines and comments
+      checks[lineIndex] =
+        trimmedLine === '' || trimmedLine.startsWith('#') ? null : checkHdlLine(trimmedLine);
+    }
+
+    return this.validateLines(checks);
+  }
+
+  /**
+   * Validate pre-checked lines: adds the checks that span lines (duplicate
+   * wires and gates, undefined and unused wires) to each line's own result.
+   * @param checks - One entry per source line; null for blank and comment lines
+   * @returns Validation result with errors and warnings
+   */
+  validateLines(checks: ReadonlyArray<HdlLineCheck | null>): HdlValidationResult {
     const errors: HdlValidationError[] = [];
     const warnings: HdlValidationError[] = [];
 
@@ -74,175 +202,66 @@ export class HdlValidator {
     const declaredGates = new Map<string, number>(); // gate name -> line number
     const usedWires = new Set<string>();
 
-    const lines = content.split('\n');
+    const error = (line: number, message: string): void => {
+      errors.push({ line, column: 1, message, severity: 'error' });
+    };
 
-    for (let lineIndex = 0; lineIndex < lines.length; lineIndex++) {
+    for (let lineIndex = 0; lineIndex < checks.length; lineIndex++) {
       const lineNumber = lineIndex + 1;
-      const line = lines[lineIndex];
-      const trimmedLine = line.trim();
+      const check = checks[lineIndex];
+      if (!check) continue;
 
-      // Skip empty lines and comments
-      if (trimmedLine === '' || trimmedLine.startsWith('#')) {
+      if (check.kind === 'error') {
+        error(lineNumber, check.message);
         continue;
       }
 
-      // Check for unmatched brackets in wire declarations
-      const openBrackets = (trimmedLine.match(/\[/g) || []).length;
-      const closeBrackets = (trimmedLine.match(/\]/g) || []).length;
-      if (openBrackets !== closeBrackets) {
-        errors.push({
-          line: lineNumber,
-          column: 1,
-          message: `Unmatched bracket in line: expected ${openBrackets} closing brackets, found ${closeBrackets}`,
-          severity: 'error',
-        });
-        continue;
-      }
-
-      // Check for unmatched parentheses
-      const openParens = (trimmedLine.match(/\(/g) || []).length;
-      const closeParens = (trimmedLine.match(/\)/g) || []).length;
-      if (openParens !== closeParens) {
-        errors.push({
-          line: lineNumber,
-          column: 1,
-          message: `Unmatched parenthesis in line: expected ${openParens} closing parentheses, found ${closeParens}`,
-          severity: 'error',
-        });
-        continue;
-      }
-
-      // Parse wire declaration: wire name or wire name[bits]
-      const wireMatch = trimmedLine.match(/^wire\s+([a-zA-Z_][a-zA-Z0-9_]*)(\[\d+(:\d+)?\])?$/i);
-      if (wireMatch) {
-        const wireName = wireMatch[1];
-        if (declaredWires.has(wireName)) {
-          errors.push({
-            line: lineNumber,
-            column: 1,
-            message: `Duplicate wire declaration: '${wireName}' was already declared on line ${declaredWires.get(wireName)}`,
-            severity: 'error',
-          });
+      if (check.kind === 'wire') {
+        if (declaredWires.has(check.name)) {
+          error(
+            lineNumber,
+            `Duplicate wire declaration: '${check.name}' was already declared on line ${declaredWires.get(check.name)}`
+          );
         } else {
-          declaredWires.set(wireName, lineNumber);
+          declaredWires.set(check.name, lineNumber);
         }
         continue;
       }
 
-      // Parse gate instantiation: gatetype name (input: wire1, wire2; output: wire3)
-      const gateMatch = trimmedLine.match(
-        /^([a-zA-Z_][a-zA-Z0-9_]*)\s+([a-zA-Z_][a-zA-Z0-9_]*)\s*\(\s*input:\s*([^;]+);\s*output:\s*([^)]+)\s*\)$/i
-      );
-      if (gateMatch) {
-        const gateType = gateMatch[1].toLowerCase();
-        const gateName = gateMatch[2];
-        const inputsStr = gateMatch[3];
-        const outputsStr = gateMatch[4];
+      // Check for duplicate gate names
+      const gateName = check.name;
+      if (declaredGates.has(gateName)) {
+        error(
+          lineNumber,
+          `Duplicate gate name: '${gateName}' was already declared on line ${declaredGates.get(gateName)}`
+        );
+      } else {
+        declaredGates.set(gateName, lineNumber);
+      }
 
-        // Check if gate type is valid
-        if (!GATE_DEFINITIONS[gateType]) {
-          errors.push({
-            line: lineNumber,
-            column: 1,
-            message: `Unknown gate type: '${gateType}'`,
-            severity: 'error',
-          });
-          continue;
-        }
+      for (const message of check.portErrors) {
+        error(lineNumber, message);
+      }
 
-        // Check for duplicate gate names
-        if (declaredGates.has(gateName)) {
-          errors.push({
-            line: lineNumber,
-            column: 1,
-            message: `Duplicate gate name: '${gateName}' was already declared on line ${declaredGates.get(gateName)}`,
-            severity: 'error',
-          });
+      // Check that all input wires are declared
+      for (const wire of check.inputs) {
+        // Handle bit-indexed wires like bus[0]
+        const baseName = wire.replace(/\[\d+(:\d+)?\]$/, '');
+        if (!declaredWires.has(baseName)) {
+          error(lineNumber, `Undefined wire '${wire}' used as input to gate '${gateName}'`);
         } else {
-          declaredGates.set(gateName, lineNumber);
-        }
-
-        // Parse input wires
-        const inputWires = inputsStr.split(',').map((w) => w.trim()).filter((w) => w);
-        const outputWires = outputsStr.split(',').map((w) => w.trim()).filter((w) => w);
-
-        // Validate input count
-        const gateDef = GATE_DEFINITIONS[gateType];
-        if (inputWires.length < gateDef.minInputs) {
-          errors.push({
-            line: lineNumber,
-            column: 1,
-            message: `Gate '${gateName}' (${gateType}) requires at least ${gateDef.minInputs} inputs, but got ${inputWires.length}`,
-            severity: 'error',
-          });
-        }
-        if (inputWires.length > gateDef.maxInputs) {
-          errors.push({
-            line: lineNumber,
-            column: 1,
-            message: `Gate '${gateName}' (${gateType}) accepts at most ${gateDef.maxInputs} inputs, but got ${inputWires.length}`,
-            severity: 'error',
-          });
+          usedWires.add(baseName);
         }
-
-        // Check that all input wires are declared
-        for (const wire of inputWires) {
-          // Handle bit-indexed wires like bus[0]
-          const baseName = wire.replace(/\[\d+(:\d+)?\]$/, '');
-          if (!declaredWires.has(baseName)) {
-            errors.push({
-              line: lineNumber,
-              column: 1,
-              message: `Undefined wire '${wire}' used as input to gate '${gateName}'`,
-              severity: 'error',
-            });
-          } else {
-            usedWires.add(baseName);
-          }
-        }
-
-        // Check that all output wires are declared
-        for (const wire of outputWires) {
-          const baseName = wire.replace(/\[\d+(:\d+)?\]$/, '');
-          if (!declaredWires.has(baseName)) {
-            errors.push({
-              line: lineNumber,
-              column: 1,
-              message: `Undefined wire '${wire}' used as output of gate '${gateName}'`,
-              severity: 'error',
-            });
-          } else {
-            usedWires.add(baseName);
-          }
-        }
-
-        continue;
       }
 
-      // If we get here, the line doesn't match any known pattern
-      // Check if it looks like a wire or gate but has syntax errors
-      if (trimmedLine.toLowerCase().startsWith('wire ')) {
-        errors.push({
-          line: lineNumber,
-          column: 1,
-          message: `Invalid wire declaration syntax: '${trimmedLine}'`,
-          severity: 'error',
-        });
-      } else if (/^[a-zA-Z_][a-zA-Z0-9_]*\s+[a-zA-Z_][a-zA-Z0-9_]*/.test(trimmedLine)) {
-        // Looks like a gate instantiation but doesn't match the pattern
-        errors.push({
-          line: lineNumber,
-          column: 1,
-          message: `Invalid gate instantiation syntax: '${trimmedLine}'`,
-          severity: 'error',
-        });
-      } else {
-        errors.push({
-          line: lineNumber,
-          column: 1,
-          message: `Unrecognized statement: '${trimmedLine}'`,
-          severity: 'error',
-        });
+      // Check that all output wires are declared
+      for (const wire of check.outputs) {
+        const baseName = wire.replace(/\[\d+(:\d+)?\]$/, '');
+        if (!declaredWires.has(baseName)) {
+          error(lineNumber, `Undefined wire '${wire}' used as output of gate '${gateName}'`);
+        } else {
+          usedWires.add(baseName);
+        }
       }
     }
 
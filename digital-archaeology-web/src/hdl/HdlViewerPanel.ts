@@ -5,10 +5,9 @@
 import * as monaco from 'monaco-editor';
 import { HdlLoader, DEFAULT_HDL_PATH } from './HdlLoader';
 import { registerM4hdlLanguage, m4hdlLanguageId } from './m4hdl-language';
-import { HdlValidator } from './HdlValidator';
 import type { HdlValidationResult } from './HdlValidator';
-import { HdlParser } from './HdlParser';
-import { HdlToCircuitGenerator } from './HdlToCircuitGenerator';
+import { HdlCompilerBridge } from './HdlCompilerBridge';
+import type { HdlCompileResult } from './HdlIncrementalCompiler';
 import type { CircuitData } from '../visualizer/types';
 
 /**
@@ -62,6 +61,12 @@ const DA_DARK_THEME_COLORS = {
  */
 let hdlThemeRegistered = false;
 
+/**
+ * Delay after the last edit before the compile worker pre-analyzes the
+ * content, so typing bursts produce one background pass.
+ */
+const PRIME_DELAY_MS = 300;
+
 /**
  * Reset theme registration state (for testing).
  * @internal
@@ -100,13 +105,12 @@ export class HdlViewerPanel {
   // Story 7.4: Validation state
   private validateButton: HTMLButtonElement | null = null;
   private validationResultsContainer: HTMLElement | null = null;
-  private validator: HdlValidator = new HdlValidator();
   private isValidating = false;
   private lastValidationResult: HdlValidationResult | null = null;
 
-  // Story 7.6: HDL parsing and circuit generation
-  private parser: HdlParser = new HdlParser();
-  private circuitGenerator: HdlToCircuitGenerator = new HdlToCircuitGenerator();
+  // Story 7.6: HDL parsing and circuit generation (in a worker where available)
+  private compiler: HdlCompilerBridge = new HdlCompilerBridge();
+  private primeTimer: ReturnType<typeof setTimeout> | null = null;
 
   // Story 7.5: Reload circuit state
   private reloadButton: HTMLButtonElement | null = null;
@@ -366,6 +370,8 @@ export class HdlViewerPanel {
       this.updateDirtyIndicator();
       // Story 7.4: Clear stale validation markers on content change
       this.clearValidationMarkers();
+      // Let the compile worker analyze edited lines while the user types
+      this.schedulePrime();
     });
   }
 
@@ -746,8 +752,26 @@ export class HdlViewerPanel {
       this.validateButton.setAttribute('aria-disabled', 'true');
     }
 
-    // Perform validation (synchronous for now, could be async later)
-    const result = this.validator.validate(content);
+    // Validate on this thread when there is no worker, keeping results immediate
+    if (!this.compiler.usesWorker) {
+      this.finishValidation(this.compiler.compileSync(content, false).validation);
+      return;
+    }
+
+    this.compiler.compile(content, false).then(
+      (compiled) => this.finishValidation(compiled.validation),
+      () => {
+        // Panel destroyed while validating
+        this.isValidating = false;
+      }
+    );
+  }
+
+  /**
+   * Show a validation result and restore the validate button.
+   * Story 7.4: Sets markers, lists results, announces, and notifies onValidate.
+   */
+  private finishValidation(result: HdlValidationResult): void {
     this.lastValidationResult = result;
 
     // Update Monaco markers
@@ -816,6 +840,24 @@ export class HdlViewerPanel {
     monaco.editor.setModelMarkers(model, 'hdl-validation', markers);
   }
 
+  /**
+   * Pre-analyze edited content in the compile worker once typing pauses.
+   * Story 7.6: Keeps validate and reload fast on large files.
+   */
+  private schedulePrime(): void {
+    if (!this.editMode || !this.compiler.usesWorker) return;
+
+    if (this.primeTimer !== null) {
+      clearTimeout(this.primeTimer);
+    }
+    this.primeTimer = setTimeout(() => {
+      this.primeTimer = null;
+      if (this.editor) {
+        this.compiler.prime(this.editor.getValue());
+      }
+    }, PRIME_DELAY_MS);
+  }
+
   /**
    * Clear validation markers from the editor.
    * Story 7.4: Called when content changes to clear stale markers.
@@ -938,7 +980,8 @@ export class HdlViewerPanel {
   /**
    * Reload the circuit with the current HDL content.
    * Story 7.5: Validates content first, then calls onReloadCircuit callback.
-   * Story 7.6: Parses HDL and generates CircuitData before calling callback.
+   * Story 7.6: Parses HDL and generates CircuitData before calling callback,
+   * in the compile worker where available.
    */
   async reloadCircuit(): Promise<void> {
     // Don't reload if already reloading
@@ -946,8 +989,20 @@ export class HdlViewerPanel {
 
     const content = this.editor?.getValue() ?? '';
 
-    // Validate content first
-    const result = this.validator.validate(content);
+    // Validate (and generate) first; claim the reload while a worker compiles
+    this.isReloading = true;
+    let compiled: HdlCompileResult;
+    try {
+      compiled = this.compiler.usesWorker
+        ? await this.compiler.compile(content, true)
+        : this.compiler.compileSync(content, true);
+    } catch {
+      // Panel destroyed while compiling
+      this.isReloading = false;
+      return;
+    }
+
+    const result = compiled.validation;
     this.setValidationMarkers(result);
     this.displayValidationResults(result);
     this.lastValidationResult = result;
@@ -962,12 +1017,10 @@ export class HdlViewerPanel {
 
     // Don't reload if validation failed
     if (!result.valid) {
+      this.isReloading = false;
       return;
     }
 
-    // Set reloading state
-    this.isReloading = true;
-
     // Update button to loading state
     if (this.reloadButton) {
       this.reloadButton.textContent = 'Reloading...';
@@ -975,16 +1028,11 @@ export class HdlViewerPanel {
     }
 
     try {
-      // Story 7.6: Parse HDL to AST
-      const ast = this.parser.parse(content);
-
-      // Check for parse errors (shouldn't happen if validation passed, but be safe)
-      if (ast.errors.length > 0) {
-        throw new Error(`HDL parsing failed: ${ast.errors[0].message}`);
+      // Story 7.6: CircuitData was generated alongside validation
+      if (!compiled.circuitData) {
+        throw new Error(compiled.error ?? 'Circuit generation failed');
       }
-
-      // Story 7.6: Generate CircuitData from AST
-      const circuitData = this.circuitGenerator.generate(ast);
+      const circuitData = compiled.circuitData;
 
       // Call the reload callback with generated circuit data
       await this.options.onReloadCircuit?.(circuitData);
@@ -1022,6 +1070,13 @@ export class HdlViewerPanel {
     this.contentChangeDisposable?.dispose();
     this.contentChangeDisposable = null;
 
+    // Story 7.6: Stop background compiling
+    if (this.primeTimer !== null) {
+      clearTimeout(this.primeTimer);
+      this.primeTimer = null;
+    }
+    this.compiler.terminate();
+
     // Dispose Monaco editor
     this.editor?.dispose();
     this.editor = null;
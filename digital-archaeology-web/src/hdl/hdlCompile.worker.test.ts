@@ -0,0 +1,76 @@
+// src/hdl/hdlCompile.worker.test.ts
+// Unit tests for the HDL compile worker message handling
+// Story 7.6: Implement HDL-to-Circuit Regeneration
+
+import { describe, it, expect, beforeEach } from 'vitest';
+import {
+  isHdlCompileCommand,
+  handleCompile,
+  handlePrime,
+  handleReset,
+  getCompilerStats,
+} from './hdlCompile.worker';
+import { applyCircuitPatch } from './HdlIncrementalCompiler';
+
+const SOURCE = 'wire a\nwire b\nwire c\nand g1 (input: a, b; output: c)';
+
+describe('HDL Compile Worker', () => {
+  beforeEach(() => {
+    handleReset();
+  });
+
+  describe('isHdlCompileCommand', () => {
+    it('should accept valid commands', () => {
+      expect(isHdlCompileCommand({ type: 'COMPILE', payload: { requestId: 1, content: '', generate: true } })).toBe(true);
+      expect(isHdlCompileCommand({ type: 'PRIME', payload: { content: 'wire a' } })).toBe(true);
+      expect(isHdlCompileCommand({ type: 'RESET' })).toBe(true);
+    });
+
+    it('should reject malformed commands', () => {
+      expect(isHdlCompileCommand(null)).toBe(false);
+      expect(isHdlCompileCommand({ type: 'COMPILE', payload: { content: '' } })).toBe(false);
+      expect(isHdlCompileCommand({ type: 'PRIME' })).toBe(false);
+      expect(isHdlCompileCommand({ type: 'UNKNOWN', payload: {} })).toBe(false);
+    });
+  });
+
+  describe('handleCompile', () => {
+    it('should echo the request id with the validation result', () => {
+      const event = handleCompile(7, 'and g1 (input: x; output: y)', true);
+
+      expect(event.type).toBe('COMPILE_RESULT');
+      expect(event.payload.requestId).toBe(7);
+      expect(event.payload.validation.valid).toBe(false);
+      expect(event.payload.patch).toBeNull();
+    });
+
+    it('should send the full circuit first and only changes afterwards', () => {
+      const first = handleCompile(1, SOURCE, true);
+      const second = handleCompile(2, SOURCE.replace('and g1', 'or g1'), true);
+
+      expect(first.payload.patch?.wires).toHaveLength(3);
+      expect(first.payload.patch?.gates).toHaveLength(1);
+      expect(second.payload.patch?.wires).toHaveLength(0);
+      expect(second.payload.patch?.gates).toHaveLength(1);
+
+      const circuit = applyCircuitPatch(applyCircuitPatch(null, first.payload.patch!), second.payload.patch!);
+      expect(circuit.gates[0].type).toBe('OR');
+    });
+
+    it('should send the full circuit again after reset', () => {
+      handleCompile(1, SOURCE, true);
+      handleReset();
+
+      expect(handleCompile(2, SOURCE, true).payload.patch?.wires).toHaveLength(3);
+    });
+  });
+
+  describe('handlePrime', () => {
+    it('should let the next compile reuse analyzed lines', () => {
+      handlePrime(SOURCE);
+      handleCompile(1, `${SOURCE}\nwire d`, false);
+
+      expect(getCompilerStats()).toEqual({ analyzed: 1, reused: 4 });
+    });
+  });
+});
@@ -0,0 +1,142 @@
+// src/hdl/hdlCompile.worker.ts
+// Web Worker that validates HDL and generates circuits off the UI thread
+// Story 7.6: Implement HDL-to-Circuit Regeneration
+
+/// <reference lib="webworker" />
+
+import { HdlIncrementalCompiler, diffCircuit } from './HdlIncrementalCompiler';
+import type { HdlCompileWorkerCommand, HdlCompileResultEvent } from './types';
+import type { CircuitData } from '../visualizer/types';
+
+// Self is typed as DedicatedWorkerGlobalScope via reference lib above
+declare const self: DedicatedWorkerGlobalScope;
+
+/**
+ * Line-cached compiler, kept for the worker's lifetime.
+ */
+const compiler = new HdlIncrementalCompiler();
+
+/**
+ * The last circuit sent to the main thread; patches are computed against it.
+ */
+let lastSentCircuit: CircuitData | null = null;
+
+/**
+ * Type guard for HdlCompileWorkerCommand messages.
+ */
+export function isHdlCompileCommand(data: unknown): data is HdlCompileWorkerCommand {
+  if (!data || typeof data !== 'object') {
+    return false;
+  }
+  const obj = data as Record<string, unknown>;
+  if (obj.type === 'RESET') {
+    return true;
+  }
+  if (typeof obj.payload !== 'object' || !obj.payload) {
+    return false;
+  }
+  const payload = obj.payload as Record<string, unknown>;
+  if (obj.type === 'PRIME') {
+    return typeof payload.content === 'string';
+  }
+  if (obj.type === 'COMPILE') {
+    return (
+      typeof payload.requestId === 'number' &&
+      typeof payload.content === 'string' &&
+      typeof payload.generate === 'boolean'
+    );
+  }
+  return false;
+}
+
+/**
+ * Handle a COMPILE command.
+ * Exported for testing purposes.
+ * @param requestId - Request identifier to echo back
+ * @param content - The HDL source code
+ * @param generate - Whether to generate the circuit
+ * @returns The result event to post
+ */
+export function handleCompile(requestId: number, content: string, generate: boolean): HdlCompileResultEvent {
+  const result = compiler.compile(content, generate);
+
+  let patch = null;
+  if (result.circuitData) {
+    patch = diffCircuit(lastSentCircuit, result.circuitData);
+    lastSentCircuit = result.circuitData;
+  }
+
+  return {
+    type: 'COMPILE_RESULT',
+    payload: { requestId, validation: result.validation, patch, error: result.error },
+  };
+}
+
+/**
+ * Handle a PRIME command by warming the line cache.
+ * Exported for testing purposes.
+ * @param content - The HDL source code
+ */
+export function handlePrime(content: string): void {
+  compiler.compile(content, false);
+}
+
+/**
+ * Handle a RESET command.
+ * Exported for testing purposes.
+ */
+export function handleReset(): void {
+  compiler.reset();
+  lastSentCircuit = null;
+}
+
+/**
+ * Get the compiler statistics from the last compile or prime.
+ * Exported for testing purposes.
+ */
+export function getCompilerStats(): { analyzed: number; reused: number } {
+  return compiler.getLastStats();
+}
+
+/**
+ * Handle incoming messages from the main thread.
+ */
+function handleMessage(event: MessageEvent): void {
+  const data = event.data;
+
+  if (!isHdlCompileCommand(data)) {
+    console.warn('[HdlCompileWorker] Unknown message type:', data);
+    return;
+  }
+
+  switch (data.type) {
+    case 'COMPILE': {
+      const { requestId, content, generate } = data.payload;
+      self.postMessage(handleCompile(requestId, content, generate));
+      break;
+    }
+    case 'PRIME': {
+      handlePrime(data.payload.content);
+      break;
+    }
+    case 'RESET': {
+      handleReset();
+      break;
+    }
+    default: {
+      // Type system ensures this is exhaustive, but log just in case
+      console.warn('[HdlCompileWorker] Unhandled message type:', data);
+    }
+  }
+}
+
+// Only listen when in a real Web Worker context (not during testing)
+// Check for DedicatedWorkerGlobalScope by verifying importScripts exists (only in workers)
+const isWorkerContext =
+  typeof self !== 'undefined' &&
+  typeof self.postMessage === 'function' &&
+  typeof importScripts === 'function';
+
+if (isWorkerContext) {
+  self.onmessage = handleMessage;
+}
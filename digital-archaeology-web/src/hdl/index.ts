@@ -87,3 +87,13 @@ export type {
  * @see HdlToCircuitGenerator - Class for generating CircuitData from AST
  */
 export { HdlToCircuitGenerator } from './HdlToCircuitGenerator';
+
+/**
+ * HDL Compilation - Line-cached validation and circuit generation, off the UI thread
+ * @see HdlIncrementalCompiler - Re-analyzes only lines changed since the last compile
+ * @see HdlCompilerBridge - Runs the compiler in a Web Worker, falling back to inline
+ * @see diffCircuit / applyCircuitPatch - Send only changed wires and gates between threads
+ */
+export { HdlIncrementalCompiler, diffCircuit, applyCircuitPatch } from './HdlIncrementalCompiler';
+export type { HdlCompileResult, HdlCircuitPatch } from './HdlIncrementalCompiler';
+export { HdlCompilerBridge } from './HdlCompilerBridge';
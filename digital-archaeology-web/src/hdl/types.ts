@@ -0,0 +1,66 @@
+// src/hdl/types.ts
+// Message protocol for the HDL compile worker
+// Story 7.6: Implement HDL-to-Circuit Regeneration
+
+import type { HdlValidationResult } from './HdlValidator';
+import type { HdlCircuitPatch } from './HdlIncrementalCompiler';
+
+/**
+ * Command to validate HDL content and, optionally, generate its circuit.
+ */
+export interface HdlCompileCommand {
+  type: 'COMPILE';
+  payload: {
+    /** Echoed back in the result so replies can be matched to requests */
+    requestId: number;
+    /** The HDL source code */
+    content: string;
+    /** Whether to generate the circuit when the content is valid */
+    generate: boolean;
+  };
+}
+
+/**
+ * Command to analyze HDL content ahead of time so a later compile only has
+ * to look at the lines edited since. No result is sent back.
+ */
+export interface HdlPrimeCommand {
+  type: 'PRIME';
+  payload: {
+    content: string;
+  };
+}
+
+/**
+ * Command to drop the worker's line cache and its copy of the last circuit.
+ */
+export interface HdlResetCommand {
+  type: 'RESET';
+}
+
+/**
+ * Union of all HDL compile worker commands (main → worker).
+ */
+export type HdlCompileWorkerCommand = HdlCompileCommand | HdlPrimeCommand | HdlResetCommand;
+
+/**
+ * Event answering a COMPILE command. The circuit is sent as a patch against
+ * the previous circuit this worker sent, so unchanged wires and gates are not
+ * copied across the thread boundary again.
+ */
+export interface HdlCompileResultEvent {
+  type: 'COMPILE_RESULT';
+  payload: {
+    requestId: number;
+    validation: HdlValidationResult;
+    /** Circuit changes, when a circuit was generated */
+    patch: HdlCircuitPatch | null;
+    /** Parse or generation failure message */
+    error: string | null;
+  };
+}
+
+/**
+ * Union of all HDL compile worker events (worker → main).
+ */
+export type HdlCompileWorkerEvent = HdlCompileResultEvent;
@@ -25,3 +25,6 @@ export type {
   CursorPositionListener,
   ContentChangeListener,
 } from './monaco-mock';
+
+// In-memory IndexedDB (importable directly)
+export { FakeIndexedDB } from './indexeddb-mock';
@@ -0,0 +1,291 @@
+/**
+ * In-memory IndexedDB for Tests
+ *
+ * Covers the subset of IndexedDB that BuilderStorage uses: versioned open
+ * with upgrades, object stores with a keyPath, single-field indexes,
+ * get/put/delete/clear/getAll, index getAll/getAllKeys/openCursor, and
+ * transaction completion.
+ *
+ * Requests complete asynchronously in the order they were made, and a
+ * transaction completes once no requests are pending, so requests made
+ * from a success handler run in the same transaction. Writes are applied
+ * as they run and are not rolled back on error. Stored values are
+ * structured clones, so a record is a new object each time it is written.
+ *
+ * USAGE:
+ * ```typescript
+ * import { FakeIndexedDB } from '../test-utils/indexeddb-mock';
+ *
+ * const fakeDb = new FakeIndexedDB();
+ * vi.stubGlobal('indexedDB', fakeDb);
+ * // ...
+ * expect(fakeDb.records('my-db', 'my-store').size).toBe(1);
+ * ```
+ */
+
+type Handler = ((event: { target: unknown }) => void) | null;
+
+interface StoreData {
+  keyPath: string;
+  /** Index name to the record field it indexes */
+  indexes: Map<string, string>;
+  records: Map<IDBValidKey, unknown>;
+}
+
+interface DatabaseData {
+  version: number;
+  stores: Map<string, StoreData>;
+}
+
+/**
+ * Compare keys in IndexedDB order for the key types used in tests.
+ */
+function compareKeys(a: unknown, b: unknown): number {
+  if (typeof a === 'number' && typeof b === 'number') return a - b;
+  return String(a) < String(b) ? -1 : String(a) > String(b) ? 1 : 0;
+}
+
+/**
+ * A request whose result arrives on a later task.
+ */
+class FakeRequest {
+  result: unknown = undefined;
+  error: Error | null = null;
+  onsuccess: Handler = null;
+  onerror: Handler = null;
+  onupgradeneeded: Handler = null;
+}
+
+/**
+ * A transaction over one database.
+ */
+class FakeTransaction {
+  oncomplete: Handler = null;
+  onerror: Handler = null;
+  onabort: Handler = null;
+  private readonly database: DatabaseData;
+  private pending = 0;
+  private done = false;
+
+  constructor(database: DatabaseData) {
+    this.database = database;
+    // A transaction with no requests still completes
+    setTimeout(() => this.finish());
+  }
+
+  /**
+   * Get a store in this transaction.
+   * @throws Error if the store does not exist
+   */
+  objectStore(name: string): FakeObjectStore {
+    const store = this.database.stores.get(name);
+    if (!store) throw new Error(`No object store ${name}`);
+    return new FakeObjectStore(store, this);
+  }
+
+  /**
+   * Run an operation on a later task and report it through a request.
+   * @param operation - Produces the request result
+   * @param request - Request to reuse (cursor continuation)
+   */
+  run(operation: () => unknown, request = new FakeRequest()): FakeRequest {
+    this.pending++;
+    setTimeout(() => {
+      try {
+        request.result = operation();
+        request.onsuccess?.({ target: request });
+      } catch (error) {
+        request.error = error as Error;
+        request.onerror?.({ target: request });
+        this.onerror?.({ target: this });
+        this.done = true;
+      }
+      this.pending--;
+      setTimeout(() => this.finish());
+    });
+    return request;
+  }
+
+  private finish(): void {
+    if (this.done || this.pending > 0) return;
+    this.done = true;
+    this.oncomplete?.({ target: this });
+  }
+}
+
+/**
+ * An object store, bound to a transaction (or to none during an upgrade,
+ * where only createIndex is used).
+ */
+class FakeObjectStore {
+  private readonly store: StoreData;
+  private readonly transaction: FakeTransaction | null;
+
+  constructor(store: StoreData, transaction: FakeTransaction | null) {
+    this.store = store;
+    this.transaction = transaction;
+  }
+
+  createIndex(name: string, keyPath: string): void {
+    this.store.indexes.set(name, keyPath);
+  }
+
+  put(value: unknown): FakeRequest {
+    return this.tx().run(() => {
+      const key = (value as Record<string, IDBValidKey>)[this.store.keyPath];
+      this.store.records.set(key, structuredClone(value));
+      return key;
+    });
+  }
+
+  get(key: IDBValidKey): FakeRequest {
+    return this.tx().run(() => structuredClone(this.store.records.get(key)));
+  }
+
+  delete(key: IDBValidKey): FakeRequest {
+    return this.tx().run(() => {
+      this.store.records.delete(key);
+      return undefined;
+    });
+  }
+
+  clear(): FakeRequest {
+    return this.tx().run(() => {
+      this.store.records.clear();
+      return undefined;
+    });
+  }
+
+  getAll(): FakeRequest {
+    return this.tx().run(() => this.sorted(null).map(([, value]) => structuredClone(value)));
+  }
+
+  index(name: string): FakeIndex {
+    const field = this.store.indexes.get(name);
+    if (field === undefined) throw new Error(`No index ${name}`);
+    return new FakeIndex(this, field);
+  }
+
+  /**
+   * Records as [primary key, value], in primary key order, optionally
+   * filtered to those whose `field` equals `query`.
+   */
+  sorted(field: string | null, query?: unknown): [IDBValidKey, unknown][] {
+    return Array.from(this.store.records.entries())
+      .filter(([, value]) => field === null || query == null || (value as Record<string, unknown>)[field] === query)
+      .sort(([a], [b]) => compareKeys(a, b));
+  }
+
+  tx(): FakeTransaction {
+    if (!this.transaction) throw new Error('Object store used outside a transaction');
+    return this.transaction;
+  }
+}
+
+/**
+ * A single-field index.
+ */
+class FakeIndex {
+  private readonly store: FakeObjectStore;
+  private readonly field: string;
+
+  constructor(store: FakeObjectStore, field: string) {
+    this.store = store;
+    this.field = field;
+  }
+
+  getAll(query?: unknown): FakeRequest {
+    return this.store.tx().run(() => this.store.sorted(this.field, query).map(([, value]) => structuredClone(value)));
+  }
+
+  getAllKeys(query?: unknown): FakeRequest {
+    return this.store.tx().run(() => this.store.sorted(this.field, query).map(([key]) => key));
+  }
+
+  openCursor(query: unknown = null, direction: IDBCursorDirection = 'next'): FakeRequest {
+    const field = this.field;
+    const entries = this.store
+      .sorted(field, query)
+      .sort(([, a], [, b]) => compareKeys((a as Record<string, unknown>)[field], (b as Record<string, unknown>)[field]));
+    if (direction === 'prev') entries.reverse();
+
+    const transaction = this.store.tx();
+    const request = new FakeRequest();
+    let position = 0;
+    const step = () => {
+      if (position >= entries.length) return null;
+      const value = structuredClone(entries[position++][1]);
+      return { value, continue: () => transaction.run(step, request) };
+    };
+    return transaction.run(step, request);
+  }
+}
+
+/**
+ * An open database connection.
+ */
+class FakeDatabase {
+  private readonly database: DatabaseData;
+
+  constructor(database: DatabaseData) {
+    this.database = database;
+  }
+
+  get objectStoreNames(): { contains(name: string): boolean } {
+    return { contains: (name: string) => this.database.stores.has(name) };
+  }
+
+  createObjectStore(name: string, options: { keyPath: string }): FakeObjectStore {
+    const store: StoreData = { keyPath: options.keyPath, indexes: new Map(), records: new Map() };
+    this.database.stores.set(name, store);
+    return new FakeObjectStore(store, null);
+  }
+
+  transaction(_storeNames: string | string[], _mode?: IDBTransactionMode): FakeTransaction {
+    return new FakeTransaction(this.database);
+  }
+
+  close(): void {
+    // Nothing to release
+  }
+}
+
+/**
+ * In-memory stand-in for the global `indexedDB`.
+ */
+export class FakeIndexedDB {
+  private databases = new Map<string, DatabaseData>();
+
+  /**
+   * Open a database, running onupgradeneeded first if `version` is newer
+   * than the stored one.
+   */
+  open(name: string, version = 1): FakeRequest {
+    const request = new FakeRequest();
+    setTimeout(() => {
+      let database = this.databases.get(name);
+      if (!database) {
+        database = { version: 0, stores: new Map() };
+        this.databases.set(name, database);
+      }
+      request.result = new FakeDatabase(database);
+      if (version > database.version) {
+        database.version = version;
+        request.onupgradeneeded?.({ target: request });
+      }
+      request.onsuccess?.({ target: request });
+    });
+    return request;
+  }
+
+  /**
+   * Raw records of a store, keyed by primary key, for checking what was
+   * written. Values are the stored objects themselves, not copies.
+   * @throws Error if the database or store does not exist
+   */
+  records(databaseName: string, storeName: string): Map<IDBValidKey, unknown> {
+    const store = this.databases.get(databaseName)?.stores.get(storeName);
+    if (!store) throw new Error(`No object store ${databaseName}/${storeName}`);
+    return store.records;
+  }
+}
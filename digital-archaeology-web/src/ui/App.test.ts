@@ -3212,7 +3212,7 @@ describe('App', () => {
         const runBtn = container.querySelector('[data-action="run"]') as HTMLButtonElement;
         runBtn.click();
 
-        expect(mockEmulatorBridge.run).toHaveBeenCalledWith(1); // 60Hz / 60 = 1
+        expect(mockEmulatorBridge.run).toHaveBeenCalledWith(60); // 60Hz = 60 instructions per second
       });
 
       it('should not call run() if no valid assembly', () => {
@@ -3547,8 +3547,8 @@ describe('App', () => {
         const runBtn = container.querySelector('[data-action="run"]') as HTMLButtonElement;
         runBtn.click();
 
-        // 100Hz / 60 ≈ 1.67, rounded to 2
-        expect(mockEmulatorBridge.run).toHaveBeenCalledWith(2);
+        // Speed is passed through in instructions per second
+        expect(mockEmulatorBridge.run).toHaveBeenCalledWith(100);
       });
     });
 
@@ -4074,11 +4074,9 @@ describe('App', () => {
       speedSlider.value = '500';
       speedSlider.dispatchEvent(new Event('input', { bubbles: true }));
 
-      // Should call setSpeed with the converted worker speed
-      // Hz to worker speed: workerSpeed = Math.max(1, Math.round(Hz / 60))
-      // 500 Hz / 60 = ~8.3 -> 8
+      // Should call setSpeed with the new speed in instructions per second
       await vi.waitFor(() => {
-        expect(mockEmulatorBridge.setSpeed).toHaveBeenCalledWith(8);
+        expect(mockEmulatorBridge.setSpeed).toHaveBeenCalledWith(500);
       });
     });
 
@@ -4127,10 +4125,9 @@ describe('App', () => {
       const runBtn = container.querySelector('[data-action="run"]') as HTMLButtonElement;
       runBtn.click();
 
-      // run() should be called with the saved speed converted
-      // 200 Hz / 60 = ~3.3 -> 3
+      // run() should be called with the saved speed
       await vi.waitFor(() => {
-        expect(mockEmulatorBridge.run).toHaveBeenCalledWith(3);
+        expect(mockEmulatorBridge.run).toHaveBeenCalledWith(200);
       });
     });
   });
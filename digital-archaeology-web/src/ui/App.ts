@@ -11,7 +11,7 @@ import { PanelHeader } from './PanelHeader';
 import type { PanelId } from './PanelHeader';
 import { setTheme, initTheme } from './theme';
 import type { ThemeMode, LabStation } from './theme';
-import { Editor, parseInstruction, findLinesWithOpcodes } from '@editor/index';
+import { Editor, parseInstruction, AssemblyLineCache } from '@editor/index';
 import { KeyboardShortcutsDialog } from './KeyboardShortcutsDialog';
 import { ErrorPanel } from './ErrorPanel';
 import { BinaryOutputPanel } from './BinaryOutputPanel';
@@ -20,7 +20,7 @@ import type { AssembleResult, AssemblerError, CPUState } from '@emulator/index';
 import { StoryModeContainer } from '@story/index';
 import { RegisterView, FlagsView, MemoryView, BreakpointsView, RuntimeErrorPanel } from '@debugger/index';
 import type { BreakpointEntry, RuntimeErrorContext } from '@debugger/index';
-import { CircuitRenderer, ZoomControlsToolbar, getGatesForInstruction, getSignalPathForInstruction, getInstructionsForGate, SignalValuesPanel, BreadcrumbNav, CPUCircuitBridge } from '@visualizer/index';
+import { CircuitRenderer, ZoomControlsToolbar, getGatesForInstruction, getSignalPathForInstruction, getInstructionsForGate, SignalValuesPanel, BreadcrumbNav, CPUCircuitBridge, InstructionActivationIndex } from '@visualizer/index';
 import type { BreadcrumbItem, ZoomControlsCallbacks, CircuitData } from '@visualizer/index';
 import { CircuitBuilder, ComponentPalette } from '@builder/index';
 import { HdlViewerPanel } from '@hdl/index';
@@ -152,6 +152,8 @@ export class App {
 
   // Source map for PC-to-line correlation (Story 5.1)
   private sourceMap: SourceMap | null = null;
+  // Per-line analysis of the editor source, reused across assembles and gate clicks
+  private readonly assemblyLines = new AssemblyLineCache();
 
   // Flag indicating program is currently running (Story 4.5)
   private isRunning: boolean = false;
@@ -168,6 +170,10 @@ export class App {
   // Throttling for high-speed UI updates (Story 4.5)
   private lastStateUpdateTime: number = 0;
   private readonly STATE_UPDATE_THROTTLE_MS = 16; // ~60fps max UI updates
+  // Memory dirty bits of states skipped by the throttle, so MemoryView still
+  // learns every changed address; unknown once any skipped state had none
+  private pendingMemoryDirty: Uint32Array | null = null;
+  private pendingMemoryDirtyUnknown: boolean = false;
 
   // State history for step-back functionality (Story 5.2)
   private stateHistory: StateHistoryEntry[] = [];
@@ -207,6 +213,13 @@ export class App {
   // Flag indicating if circuit is loaded and ready (Story 6.13)
   private circuitLoaded: boolean = false;
 
+  // Precomputed gates each opcode activates; null when unavailable or the
+  // displayed circuit is not the one it was generated from
+  private activationIndex: InstructionActivationIndex | null = null;
+
+  // Whether emulator state reaches the circuit render worker directly
+  private circuitStatePortConnected: boolean = false;
+
   // HdlViewerPanel for viewing HDL files (Story 7.1)
   private hdlViewerPanel: HdlViewerPanel | null = null;
 
@@ -541,6 +554,8 @@ export class App {
   private handleModeChange(mode: ThemeMode): void {
     this.currentMode = mode;
     setTheme(mode);
+    // The circuit may be drawn in a worker, which cannot see the new colors
+    this.circuitRenderer?.refreshTheme();
     this.applyModeVisibility();
     this.announceModeChange(mode);
     // Sync the StoryNav's ModeToggle state (Story 10.3)
@@ -1246,6 +1261,8 @@ export class App {
       // Story 6.10: Circuit-to-code linking
       onGateClick: (gateId, gateName) => this.handleGateClick(gateId, gateName),
       onBackgroundClick: () => this.handleCircuitBackgroundClick(),
+      // Keep layout and drawing of large netlists off the UI thread
+      renderInWorker: true,
     });
 
     // Mount CircuitRenderer to circuit panel content
@@ -1299,6 +1316,26 @@ export class App {
       this.cpuCircuitBridge = null;
     }
     this.circuitLoaded = false;
+    this.activationIndex = null;
+    this.circuitStatePortConnected = false;
+  }
+
+  /**
+   * Connect the emulator worker to the circuit render worker with a
+   * MessageChannel, so wire state updates skip the UI thread.
+   * Needs both workers; called when either becomes available.
+   * @returns void
+   */
+  private connectCircuitStatePort(): void {
+    if (this.circuitStatePortConnected || !this.emulatorBridge) return;
+    if (!this.circuitRenderer?.isRenderingInWorker()) return;
+
+    const channel = new MessageChannel();
+    if (this.emulatorBridge.connectCircuitPort(channel.port1)) {
+      this.circuitStatePortConnected = this.circuitRenderer.connectStatePort(channel.port2);
+    } else {
+      channel.port2.close();
+    }
   }
 
   /**
@@ -1310,14 +1347,24 @@ export class App {
   private async loadCircuitAndInitializeBridge(): Promise<void> {
     if (!this.circuitRenderer) return;
 
+    // Fetch the activation index alongside the circuit
+    const activationIndex = this.loadActivationIndex();
+
     try {
       // Load the Micro4 circuit JSON
       await this.circuitRenderer.loadCircuit('/circuits/micro4-circuit.json');
       this.circuitLoaded = true;
 
+      const index = await activationIndex;
+      const model = this.circuitRenderer.getCircuitModel();
+      this.activationIndex = index && model && index.gateCount === model.gates.size ? index : null;
+
       // Initialize the CPU-Circuit bridge
       this.cpuCircuitBridge = new CPUCircuitBridge();
 
+      // Let emulator state flow straight to the render worker
+      this.connectCircuitStatePort();
+
       // Update the SignalValuesPanel with initial circuit state
       this.updateSignalValuesPanel();
 
@@ -1334,6 +1381,20 @@ export class App {
     }
   }
 
+  /**
+   * Load the precomputed instruction activation index.
+   * Highlighting falls back to diffing gate outputs when it is unavailable.
+   * @returns The index, or null if it could not be loaded
+   */
+  private async loadActivationIndex(): Promise<InstructionActivationIndex | null> {
+    try {
+      return await InstructionActivationIndex.load('/circuits/micro4-activation.bin');
+    } catch (error) {
+      console.warn('Instruction activation index unavailable:', error);
+      return null;
+    }
+  }
+
   /**
    * Update the circuit visualization from CPU state (Story 6.13).
    * Maps CPU state to circuit wire states and updates the renderer.
@@ -1349,9 +1410,10 @@ export class App {
     // Map CPU state to circuit data
     const newCircuitData = this.cpuCircuitBridge.mapStateToCircuit(cpuState, model);
 
-    // Update the circuit renderer
+    // Update the circuit renderer, pulsing the gates the instruction activates
     if (animate) {
-      this.circuitRenderer.animateTransition(newCircuitData);
+      const activeGates = this.activationIndex?.getInstructionGates((cpuState.ir >> 4) & 0xF);
+      this.circuitRenderer.animateTransition(newCircuitData, activeGates);
     } else {
       this.circuitRenderer.updateState({ circuitData: newCircuitData });
     }
@@ -1579,6 +1641,9 @@ export class App {
       this.cpuCircuitBridge = null;
     }
 
+    // The generated circuit may not match the precomputed index
+    this.activationIndex = null;
+
     // Update the circuit renderer with new circuit data
     this.circuitRenderer.updateState({ circuitData });
     this.circuitLoaded = true;
@@ -1786,8 +1851,8 @@ export class App {
 
     if (opcodes.length > 0) {
       // Find lines containing these opcodes
-      const editorContent = this.editor.getValue();
-      const matchingLines = findLinesWithOpcodes(editorContent, opcodes);
+      this.assemblyLines.update(this.editor.getValue());
+      const matchingLines = this.assemblyLines.findLinesWithOpcodes(opcodes);
 
       if (matchingLines.length > 0) {
         // Highlight the matching lines in the editor
@@ -1920,7 +1985,12 @@ export class App {
     this.emulatorBridge = new EmulatorBridge();
 
     // Initialize asynchronously - don't block UI
-    this.emulatorBridge.init().catch((error) => {
+    const initPromise = this.emulatorBridge.init();
+
+    // The worker exists once init() has started; wire it to the render worker
+    this.connectCircuitStatePort();
+
+    initPromise.catch((error) => {
       console.error('Failed to initialize EmulatorBridge:', error);
       // Show warning in status bar so user knows emulator won't work (Issue #4 fix)
       this.statusBar?.updateState({
@@ -1942,6 +2012,7 @@ export class App {
       this.emulatorBridge.terminate();
       this.emulatorBridge = null;
     }
+    this.circuitStatePortConnected = false;
     this.cpuState = null;
   }
 
@@ -2037,10 +2108,8 @@ export class App {
     // Set up event subscriptions before starting
     this.setupEmulatorSubscriptions();
 
-    // Start execution - convert Hz to speed parameter
-    // speed = instructions per ~16ms tick = Hz / 60
-    const speed = Math.max(1, Math.round(this.executionSpeed / 60));
-    this.emulatorBridge.run(speed);
+    // Start execution - the worker paces itself to the speed in instructions per second
+    this.emulatorBridge.run(this.executionSpeed);
 
     // Update running state
     this.isRunning = true;
@@ -2205,10 +2274,8 @@ export class App {
     // Update status bar if currently running
     if (this.isRunning) {
       this.statusBar?.updateState({ speed: this.executionSpeed });
-      // Story 4.8: Update running emulator speed in real-time
-      // Convert Hz to worker speed (instructions per ~16ms tick)
-      const workerSpeed = Math.max(1, Math.round(this.executionSpeed / 60));
-      this.emulatorBridge?.setSpeed(workerSpeed);
+      // Story 4.8: Update running emulator speed in real-time (Hz = instructions per second)
+      this.emulatorBridge?.setSpeed(this.executionSpeed);
     }
     // Story 9.1: Persist speed setting to localStorage
     this.saveSettings();
@@ -2435,70 +2502,9 @@ export class App {
    * @returns SourceMap object with address-to-line and line-to-address mappings
    */
   private buildSourceMap(source: string): SourceMap {
-    const lines = source.split('\n');
-    const addressToLine = new Map<number, number>();
-    const lineToAddress = new Map<number, number>();
-    let address = 0;
-
-    for (let lineNum = 1; lineNum <= lines.length; lineNum++) {
-      const line = lines[lineNum - 1].trim();
-
-      // Skip empty lines
-      if (!line) continue;
-
-      // Skip comment-only lines
-      if (line.startsWith(';')) continue;
-
-      // Strip inline comments for parsing
-      const codePart = line.split(';')[0].trim();
-      if (!codePart) continue;
-
-      // Check for ORG directive (supports decimal, 0x hex, and $ hex prefix)
-      const orgMatch = codePart.match(/^ORG\s+(?:0x|\$)?([0-9A-Fa-f]+)/i);
-      if (orgMatch) {
-        // Determine base: if original had 0x or $ prefix, or if contains a-f, use hex
-        const hasHexPrefix = /^ORG\s+(?:0x|\$)/i.test(codePart);
-        const hasHexDigits = /[A-Fa-f]/.test(orgMatch[1]);
-        const base = (hasHexPrefix || hasHexDigits) ? 16 : 10;
-        address = parseInt(orgMatch[1], base);
-        continue;
-      }
-
-      // Skip label-only lines (ends with : and nothing else meaningful after)
-      const labelMatch = codePart.match(/^([A-Za-z_][A-Za-z0-9_]*):(.*)$/);
-      if (labelMatch) {
-        const afterLabel = labelMatch[2].trim();
-        if (!afterLabel) continue; // Label only, no instruction on this line
-        // Otherwise, there's an instruction after the label on the same line
-      }
-
-      // Handle DB/DW directives (data, not executable instructions)
-      // They consume address space but aren't "steppable" instructions
-      const dbMatch = codePart.match(/^(?:[A-Za-z_][A-Za-z0-9_]*:\s*)?(DB)\s+(.+)/i);
-      const dwMatch = codePart.match(/^(?:[A-Za-z_][A-Za-z0-9_]*:\s*)?(DW)\s+(.+)/i);
-      if (dbMatch) {
-        // DB consumes 1 byte (2 nibbles) per value
-        const values = dbMatch[2].split(',').length;
-        address += values * 2;
-        continue;
-      }
-      if (dwMatch) {
-        // DW consumes 2 bytes (4 nibbles) per value
-        const values = dwMatch[2].split(',').length;
-        address += values * 4;
-        continue;
-      }
-
-      // This line has an instruction at current address
-      addressToLine.set(address, lineNum);
-      lineToAddress.set(lineNum, address);
-
-      // Advance address by 2 nibbles (1 byte) for Micro4 instructions
-      // Each instruction is 2 nibbles = 8 bits = 1 byte in memory
-      address += 2;
-    }
-
-    return { addressToLine, lineToAddress };
+    // Only lines edited since the last update are re-analyzed
+    this.assemblyLines.update(source);
+    return this.assemblyLines.buildSourceMap();
   }
 
   /**
@@ -2513,8 +2519,11 @@ export class App {
     this.cleanupEmulatorSubscriptions();
 
     // Subscribe to state updates with throttling for high-speed execution
+    this.pendingMemoryDirty = null;
+    this.pendingMemoryDirtyUnknown = false;
     this.unsubscribeStateUpdate = this.emulatorBridge.onStateUpdate((state) => {
       this.cpuState = state;
+      this.collectMemoryDirty(state.memoryDirty);
 
       // Throttle UI updates to prevent performance issues at high speeds
       const now = performance.now();
@@ -2540,6 +2549,7 @@ export class App {
         this.memoryView?.updateState({
           memory: state.memory,
           pc: state.pc,
+          dirty: this.takeMemoryDirty(),
         });
 
         // Story 6.13: Update circuit during RUN mode (no animation for performance)
@@ -2563,6 +2573,37 @@ export class App {
     });
   }
 
+  /**
+   * Accumulate a state's memory dirty bits until the next MemoryView update.
+   * @param dirty - Dirty bitmap from the state, if it has one
+   * @returns void
+   */
+  private collectMemoryDirty(dirty: Uint32Array | undefined): void {
+    if (!dirty) {
+      this.pendingMemoryDirtyUnknown = true;
+      return;
+    }
+    if (!this.pendingMemoryDirty) {
+      this.pendingMemoryDirty = new Uint32Array(dirty);
+      return;
+    }
+    const pending = this.pendingMemoryDirty;
+    for (let i = 0; i < pending.length && i < dirty.length; i++) {
+      pending[i] |= dirty[i];
+    }
+  }
+
+  /**
+   * Take the accumulated memory dirty bits for a MemoryView update.
+   * @returns The bitmap, or undefined when MemoryView must check every visible cell
+   */
+  private takeMemoryDirty(): Uint32Array | undefined {
+    const dirty = this.pendingMemoryDirtyUnknown ? undefined : this.pendingMemoryDirty ?? undefined;
+    this.pendingMemoryDirty = null;
+    this.pendingMemoryDirtyUnknown = false;
+    return dirty;
+  }
+
   /**
    * Clean up emulator event subscriptions (Story 4.5).
    * @returns void
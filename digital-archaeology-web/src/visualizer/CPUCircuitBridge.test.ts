@@ -345,6 +345,55 @@ describe('CPUCircuitBridge', () => {
     });
   });
 
+  describe('mapStateToModel', () => {
+    it('returns a model sharing the source structure', () => {
+      const result = bridge.mapStateToModel(createTestCPUState({ pc: 5 }), circuitModel);
+
+      expect(result.structure).toBe(circuitModel.structure);
+      expect(result.hasSameStructure(circuitModel)).toBe(true);
+      expect(result.getWireByName('pc')?.state).toEqual(numberToBitArray(5, 8));
+    });
+
+    it('keeps unchanged wire objects', () => {
+      const first = bridge.mapStateToModel(createTestCPUState({ pc: 1, accumulator: 3 }), circuitModel);
+      const second = bridge.mapStateToModel(createTestCPUState({ pc: 2, accumulator: 3 }), first);
+
+      expect(second.getWireByName('acc')).toBe(first.getWireByName('acc'));
+      expect(second.getWireByName('pc')).not.toBe(first.getWireByName('pc'));
+    });
+
+    it('fills registers to the wire width of wider circuits', () => {
+      const data = createTestCircuitData();
+      data.wires[0] = { ...data.wires[0], width: 16, state: new Array(16).fill(0) };
+      const wide = new CircuitModel(data);
+
+      const result = bridge.mapStateToModel(createTestCPUState({ pc: 0x1234 }), wide);
+
+      expect(result.getWireByName('pc')?.state).toEqual(numberToBitArray(0x1234, 16));
+    });
+
+    it('re-resolves wires when the circuit changes', () => {
+      bridge.mapStateToModel(createTestCPUState(), circuitModel);
+
+      const data = createTestCircuitData();
+      data.wires.reverse();
+      const reordered = new CircuitModel(data);
+      const result = bridge.mapStateToModel(createTestCPUState({ accumulator: 9 }), reordered);
+
+      expect(result.getWireByName('acc')?.state).toEqual([1, 0, 0, 1]);
+    });
+
+    it('skips wires the circuit does not have', () => {
+      const data = createTestCircuitData();
+      data.wires = data.wires.filter((w) => w.name !== 'ir');
+      const partial = new CircuitModel(data);
+
+      const result = bridge.mapStateToModel(createTestCPUState({ ir: 0x10 }), partial);
+
+      expect(result.getWireByName('is_lda')?.state).toEqual([1]);
+    });
+  });
+
   describe('clearCache', () => {
     it('allows re-caching after clear', () => {
       // First mapping builds cache
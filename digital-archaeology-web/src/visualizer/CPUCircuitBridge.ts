@@ -2,8 +2,8 @@
 // Bridge between CPU emulator state and circuit visualization (Story 6.13)
 
 import type { CPUState } from '@emulator/types';
-import type { CircuitModel } from './CircuitModel';
-import type { CircuitData, CircuitWire } from './types';
+import type { CircuitModel, CircuitStructure } from './CircuitModel';
+import type { CircuitData } from './types';
 
 /**
  * Wire name mapping from CPUState fields to circuit wire names.
@@ -76,16 +76,33 @@ export function numberToBitArray(value: number, width: number): number[] {
   return Array.from({ length: width }, (_, i) => (value >> i) & 1);
 }
 
+/** A CPU signal's resolved place in the packed wire state vector. */
+interface SignalSlot {
+  /** First slot of the wire, or -1 if the circuit has no such wire */
+  start: number;
+  /** Wire width in bits */
+  width: number;
+}
+
+/** WIRE_NAMES resolved against one circuit structure. */
+type SignalSlots = Record<keyof typeof WIRE_NAMES, SignalSlot>;
+
 /**
  * Bridge class that maps CPU emulator state to circuit wire states.
  *
  * This class translates CPUState (from the emulator) into CircuitData
  * (for the visualizer), enabling the circuit diagram to reflect the
  * actual CPU state during execution.
+ *
+ * Wire names are resolved to state vector slots once per circuit
+ * structure; each step then copies the model's packed wire states, writes
+ * the signal bits in place and applies the vector in one call
+ * (CircuitModel.withWireStates()).
  */
 export class CPUCircuitBridge {
-  /** Cache of wire name to ID mappings for performance */
-  private wireNameToId: Map<string, number> = new Map();
+  /** Signal slots and the structure they were resolved against */
+  private slots: SignalSlots | null = null;
+  private slotsStructure: CircuitStructure | null = null;
 
   /**
    * Maps CPUState to CircuitData wire states.
@@ -95,166 +112,170 @@ export class CPUCircuitBridge {
    * @returns Updated CircuitData with new wire states reflecting CPU state
    */
   mapStateToCircuit(cpuState: CPUState, circuitModel: CircuitModel): CircuitData {
-    // Build wire name cache if not already done
-    if (this.wireNameToId.size === 0) {
-      this.buildWireNameCache(circuitModel);
-    }
+    return this.mapStateToModel(cpuState, circuitModel).data;
+  }
 
-    // Clone the circuit data to avoid mutating the original
-    const circuitData = this.cloneCircuitData(circuitModel);
+  /**
+   * Maps CPUState onto a circuit model, returning a model that shares the
+   * source's structure so renderers keep their layout.
+   *
+   * @param cpuState - Current emulator state
+   * @param circuitModel - Circuit model to base the output on (not modified)
+   * @returns A model with wire states reflecting CPU state
+   */
+  mapStateToModel(cpuState: CPUState, circuitModel: CircuitModel): CircuitModel {
+    const slots = this.resolveSlots(circuitModel);
+    const states = circuitModel.wireStates.slice();
 
     // Map register values
-    this.setWireState(circuitData, WIRE_NAMES.PC, numberToBitArray(cpuState.pc, 8));
-    this.setWireState(circuitData, WIRE_NAMES.ACC, numberToBitArray(cpuState.accumulator, 4));
-    this.setWireState(circuitData, WIRE_NAMES.IR, numberToBitArray(cpuState.ir, 8));
-    this.setWireState(circuitData, WIRE_NAMES.MAR, numberToBitArray(cpuState.mar, 8));
-    this.setWireState(circuitData, WIRE_NAMES.MDR, numberToBitArray(cpuState.mdr, 4));
+    writeSignal(states, slots.PC, cpuState.pc);
+    writeSignal(states, slots.ACC, cpuState.accumulator);
+    writeSignal(states, slots.IR, cpuState.ir);
+    writeSignal(states, slots.MAR, cpuState.mar);
+    writeSignal(states, slots.MDR, cpuState.mdr);
 
     // Map flags
-    this.setWireState(circuitData, WIRE_NAMES.Z_FLAG, [cpuState.zeroFlag ? 1 : 0]);
-    this.setWireState(circuitData, WIRE_NAMES.HALT, [cpuState.halted ? 1 : 0]);
+    writeSignal(states, slots.Z_FLAG, cpuState.zeroFlag ? 1 : 0);
+    writeSignal(states, slots.HALT, cpuState.halted ? 1 : 0);
 
     // Extract and map opcode from IR
     const opcode = (cpuState.ir >> 4) & 0xF;
-    this.setWireState(circuitData, WIRE_NAMES.OPCODE, numberToBitArray(opcode, 4));
+    writeSignal(states, slots.OPCODE, opcode);
 
     // Map instruction decode signals
-    this.mapInstructionDecodeSignals(circuitData, opcode);
+    this.mapInstructionDecodeSignals(states, slots, opcode);
 
     // Map control signals (derived from instruction and state)
-    this.mapControlSignals(circuitData, opcode, cpuState);
+    this.mapControlSignals(states, slots, opcode, cpuState);
 
-    return circuitData;
+    return circuitModel.withWireStates(states);
   }
 
   /**
-   * Build a cache mapping wire names to wire IDs for fast lookup.
-   * @param circuitModel - The circuit model to cache
+   * Resolve WIRE_NAMES to state vector slots, once per circuit structure.
+   * @param circuitModel - The circuit model being mapped onto
+   * @returns The slots
    */
-  private buildWireNameCache(circuitModel: CircuitModel): void {
-    this.wireNameToId.clear();
-    for (const wire of circuitModel.wires.values()) {
-      this.wireNameToId.set(wire.name, wire.id);
+  private resolveSlots(circuitModel: CircuitModel): SignalSlots {
+    const structure = circuitModel.structure;
+    if (this.slots && this.slotsStructure === structure) {
+      return this.slots;
     }
-  }
-
-  /**
-   * Clear the wire name cache.
-   * Call this when switching to a different circuit.
-   */
-  clearCache(): void {
-    this.wireNameToId.clear();
-  }
 
-  /**
-   * Clone circuit data from the model for modification.
-   * @param circuitModel - The circuit model to clone
-   * @returns A new CircuitData object with cloned wire states
-   */
-  private cloneCircuitData(circuitModel: CircuitModel): CircuitData {
-    const wires: CircuitWire[] = [];
-
-    for (const wire of circuitModel.wires.values()) {
-      wires.push({
-        id: wire.id,
-        name: wire.name,
-        width: wire.width,
-        is_input: wire.is_input,
-        is_output: wire.is_output,
-        state: [...wire.state], // Clone the state array
-      });
+    const { wireIndexByName, wireBitStart } = structure;
+    const slots = {} as SignalSlots;
+    for (const key of Object.keys(WIRE_NAMES) as (keyof typeof WIRE_NAMES)[]) {
+      const index = wireIndexByName.get(WIRE_NAMES[key]);
+      slots[key] = index === undefined
+        ? { start: -1, width: 0 }
+        : { start: wireBitStart[index], width: wireBitStart[index + 1] - wireBitStart[index] };
     }
-
-    // Gates don't change, we can reference them directly
-    const gates = Array.from(circuitModel.gates.values());
-
-    return {
-      cycle: 0,
-      stable: true,
-      wires,
-      gates,
-    };
+    this.slots = slots;
+    this.slotsStructure = structure;
+    return slots;
   }
 
   /**
-   * Set the state of a wire by name.
-   * @param circuitData - The circuit data to modify
-   * @param wireName - The name of the wire
-   * @param state - The new state (bit array)
+   * Clear the resolved wire slots.
+   * Switching circuits also re-resolves them, so this is only needed to
+   * release the previous circuit.
    */
-  private setWireState(circuitData: CircuitData, wireName: string, state: number[]): void {
-    const wireId = this.wireNameToId.get(wireName);
-    if (wireId === undefined) return;
-
-    const wire = circuitData.wires.find(w => w.id === wireId);
-    if (wire && wire.state.length === state.length) {
-      wire.state = state;
-    }
+  clearCache(): void {
+    this.slots = null;
+    this.slotsStructure = null;
   }
 
   /**
    * Map instruction decode signals based on the opcode.
    * Sets is_hlt, is_lda, is_sta, etc. to 1 or 0.
-   * @param circuitData - The circuit data to modify
+   * @param states - Packed wire states to modify
+   * @param slots - Resolved signal slots
    * @param opcode - The current opcode (0-15)
    */
-  private mapInstructionDecodeSignals(circuitData: CircuitData, opcode: number): void {
-    this.setWireState(circuitData, WIRE_NAMES.IS_HLT, [opcode === OPCODES.HLT ? 1 : 0]);
-    this.setWireState(circuitData, WIRE_NAMES.IS_LDA, [opcode === OPCODES.LDA ? 1 : 0]);
-    this.setWireState(circuitData, WIRE_NAMES.IS_STA, [opcode === OPCODES.STA ? 1 : 0]);
-    this.setWireState(circuitData, WIRE_NAMES.IS_ADD, [opcode === OPCODES.ADD ? 1 : 0]);
-    this.setWireState(circuitData, WIRE_NAMES.IS_SUB, [opcode === OPCODES.SUB ? 1 : 0]);
-    this.setWireState(circuitData, WIRE_NAMES.IS_JMP, [opcode === OPCODES.JMP ? 1 : 0]);
-    this.setWireState(circuitData, WIRE_NAMES.IS_JZ, [opcode === OPCODES.JZ ? 1 : 0]);
-    this.setWireState(circuitData, WIRE_NAMES.IS_LDI, [opcode === OPCODES.LDI ? 1 : 0]);
+  private mapInstructionDecodeSignals(states: Uint8Array, slots: SignalSlots, opcode: number): void {
+    writeSignal(states, slots.IS_HLT, opcode === OPCODES.HLT ? 1 : 0);
+    writeSignal(states, slots.IS_LDA, opcode === OPCODES.LDA ? 1 : 0);
+    writeSignal(states, slots.IS_STA, opcode === OPCODES.STA ? 1 : 0);
+    writeSignal(states, slots.IS_ADD, opcode === OPCODES.ADD ? 1 : 0);
+    writeSignal(states, slots.IS_SUB, opcode === OPCODES.SUB ? 1 : 0);
+    writeSignal(states, slots.IS_JMP, opcode === OPCODES.JMP ? 1 : 0);
+    writeSignal(states, slots.IS_JZ, opcode === OPCODES.JZ ? 1 : 0);
+    writeSignal(states, slots.IS_LDI, opcode === OPCODES.LDI ? 1 : 0);
   }
 
   /**
    * Map control signals based on the instruction and CPU state.
    * These signals control register loads, memory access, etc.
-   * @param circuitData - The circuit data to modify
+   * @param states - Packed wire states to modify
+   * @param slots - Resolved signal slots
    * @param opcode - The current opcode
    * @param cpuState - The current CPU state
    */
-  private mapControlSignals(circuitData: CircuitData, opcode: number, cpuState: CPUState): void {
+  private mapControlSignals(states: Uint8Array, slots: SignalSlots, opcode: number, cpuState: CPUState): void {
     // PC control signals
     // PC_LOAD is active for JMP, or JZ when zero flag is set
     const pcLoad = opcode === OPCODES.JMP || (opcode === OPCODES.JZ && cpuState.zeroFlag);
-    this.setWireState(circuitData, WIRE_NAMES.PC_LOAD, [pcLoad ? 1 : 0]);
+    writeSignal(states, slots.PC_LOAD, pcLoad ? 1 : 0);
 
     // PC_INC is active when not halted and not loading PC
     const pcInc = !cpuState.halted && !pcLoad;
-    this.setWireState(circuitData, WIRE_NAMES.PC_INC, [pcInc ? 1 : 0]);
+    writeSignal(states, slots.PC_INC, pcInc ? 1 : 0);
 
     // ACC_LOAD is active for LDA, LDI, and ALU operations
-    const accLoadOpcodes: number[] = [
-      OPCODES.LDA, OPCODES.LDI, OPCODES.ADD, OPCODES.SUB,
-      OPCODES.AND, OPCODES.OR, OPCODES.XOR, OPCODES.NOT,
-      OPCODES.SHL, OPCODES.SHR, OPCODES.INC, OPCODES.DEC
-    ];
-    const accLoad = accLoadOpcodes.includes(opcode);
-    this.setWireState(circuitData, WIRE_NAMES.ACC_LOAD, [accLoad ? 1 : 0]);
+    const accLoad = (ACC_LOAD_OPCODES >> opcode) & 1;
+    writeSignal(states, slots.ACC_LOAD, accLoad);
 
     // Z_LOAD follows ACC_LOAD (zero flag updated when accumulator changes)
-    this.setWireState(circuitData, WIRE_NAMES.Z_LOAD, [accLoad ? 1 : 0]);
+    writeSignal(states, slots.Z_LOAD, accLoad);
 
     // IR_LOAD - active during fetch cycle (simplified: always active for visualization)
-    this.setWireState(circuitData, WIRE_NAMES.IR_LOAD, [1]);
+    writeSignal(states, slots.IR_LOAD, 1);
 
     // MAR_LOAD - active when accessing memory
-    const marLoadOpcodes: number[] = [
-      OPCODES.LDA, OPCODES.STA, OPCODES.ADD, OPCODES.SUB,
-      OPCODES.AND, OPCODES.OR, OPCODES.XOR
-    ];
-    const marLoad = marLoadOpcodes.includes(opcode);
-    this.setWireState(circuitData, WIRE_NAMES.MAR_LOAD, [marLoad ? 1 : 0]);
+    writeSignal(states, slots.MAR_LOAD, (MAR_LOAD_OPCODES >> opcode) & 1);
 
     // MDR_LOAD - active during memory read operations
-    const mdrLoadOpcodes: number[] = [
-      OPCODES.LDA, OPCODES.ADD, OPCODES.SUB,
-      OPCODES.AND, OPCODES.OR, OPCODES.XOR
-    ];
-    const mdrLoad = mdrLoadOpcodes.includes(opcode);
-    this.setWireState(circuitData, WIRE_NAMES.MDR_LOAD, [mdrLoad ? 1 : 0]);
+    writeSignal(states, slots.MDR_LOAD, (MDR_LOAD_OPCODES >> opcode) & 1);
+  }
+}
+
+/**
+ * Build an opcode bit set (bit n set for opcode n).
+ * @param opcodes - Opcodes in the set
+ * @returns The bit set
+ */
+function opcodeSet(...opcodes: number[]): number {
+  return opcodes.reduce((set, opcode) => set | (1 << opcode), 0);
+}
+
+/** Opcodes that load the accumulator: LDA, LDI and ALU operations */
+const ACC_LOAD_OPCODES = opcodeSet(
+  OPCODES.LDA, OPCODES.LDI, OPCODES.ADD, OPCODES.SUB,
+  OPCODES.AND, OPCODES.OR, OPCODES.XOR, OPCODES.NOT,
+  OPCODES.SHL, OPCODES.SHR, OPCODES.INC, OPCODES.DEC
+);
+
+/** Opcodes that access memory */
+const MAR_LOAD_OPCODES = opcodeSet(
+  OPCODES.LDA, OPCODES.STA, OPCODES.ADD, OPCODES.SUB,
+  OPCODES.AND, OPCODES.OR, OPCODES.XOR
+);
+
+/** Opcodes that read memory */
+const MDR_LOAD_OPCODES = opcodeSet(
+  OPCODES.LDA, OPCODES.ADD, OPCODES.SUB,
+  OPCODES.AND, OPCODES.OR, OPCODES.XOR
+);
+
+/**
+ * Write a value's bits (LSB first) into a signal's wire slots.
+ * Wider registers (Micro8/Micro16 circuits) take as many bits as the wire has.
+ * @param states - Packed wire states to modify
+ * @param slot - The signal's slot; ignored if the wire does not exist
+ * @param value - The value to write
+ */
+function writeSignal(states: Uint8Array, slot: SignalSlot, value: number): void {
+  for (let bit = 0; bit < slot.width; bit++) {
+    states[slot.start + bit] = bit < 32 ? (value >>> bit) & 1 : 0;
   }
 }
@@ -419,4 +419,60 @@ describe('CircuitLayout', () => {
       expect(layout.wirePositionCount).toBe(0);
     });
   });
+
+  describe('spatial queries', () => {
+    // AND -> wire0 -> OR, plus a lone NOT
+    const createQueryCircuit = (): CircuitData => ({
+      cycle: 0,
+      stable: true,
+      wires: [{ id: 0, name: 'wire0', width: 1, is_input: false, is_output: false, state: [0] }],
+      gates: [
+        { id: 0, name: 'AND0', type: 'AND', inputs: [], outputs: [{ wire: 0, bit: 0 }] },
+        { id: 1, name: 'OR1', type: 'OR', inputs: [{ wire: 0, bit: 0 }], outputs: [] },
+        { id: 2, name: 'NOT2', type: 'NOT', inputs: [], outputs: [] },
+      ],
+    });
+
+    beforeEach(() => {
+      layout.calculate(new CircuitModel(createQueryCircuit()), 800, 600);
+    });
+
+    it('should return gates intersecting a rectangle in model order', () => {
+      // Columns at x = 20 (AND), 100 (OR), 180 (NOT)
+      const slots = layout.queryGates({ x: 0, y: 0, width: 170, height: 100 });
+      expect(slots.map((slot) => layout.getGateIdAt(slot))).toEqual([0, 1]);
+    });
+
+    it('should return no gates for a rectangle outside the layout', () => {
+      expect(layout.queryGates({ x: 2000, y: 2000, width: 100, height: 100 })).toEqual([]);
+    });
+
+    it('should return wire segments intersecting a rectangle', () => {
+      expect(layout.segmentSlotCount).toBe(1);
+
+      const slots = layout.querySegments({ x: 85, y: 0, width: 10, height: 100 });
+      expect(slots).toHaveLength(1);
+      const ref = layout.getSegmentAt(slots[0]);
+      expect(ref.wireId).toBe(0);
+      expect(ref.width).toBe(1);
+      expect(ref.segment.startX).toBe(80);
+      expect(ref.segment.endX).toBe(100);
+
+      expect(layout.querySegments({ x: 200, y: 0, width: 10, height: 100 })).toEqual([]);
+    });
+
+    it('should find the gate at a point', () => {
+      expect(layout.gateAt(30, 30)).toBe(0);
+      expect(layout.gateAt(130, 30)).toBe(1);
+      expect(layout.gateAt(90, 30)).toBeNull();
+    });
+
+    it('should clear the index on clear()', () => {
+      layout.clear();
+
+      expect(layout.gateSlotCount).toBe(0);
+      expect(layout.segmentSlotCount).toBe(0);
+      expect(layout.gateAt(30, 30)).toBeNull();
+    });
+  });
 });
@@ -3,6 +3,8 @@
 
 import type { CircuitModel } from './CircuitModel';
 import type { GateType } from './types';
+import { SpatialIndex } from './SpatialIndex';
+import type { Rect } from './SpatialIndex';
 
 /**
  * Position of a gate in the layout.
@@ -42,6 +44,18 @@ export interface WirePosition {
   segments: WireSegment[];
 }
 
+/**
+ * A positioned wire segment as stored in the spatial index.
+ */
+export interface WireSegmentRef {
+  /** Wire ID */
+  wireId: number;
+  /** Wire bit width */
+  width: number;
+  /** Segment geometry */
+  segment: WireSegment;
+}
+
 /**
  * Layout configuration options.
  */
@@ -85,6 +99,13 @@ export class CircuitLayout {
   private wirePositions: Map<number, WirePosition> = new Map();
   private config: CircuitLayoutConfig;
 
+  // Spatial indexes for viewport culling and hit testing.
+  // Slots are render order: model gate order, then model wire order by segment.
+  private gateIndex: SpatialIndex = new SpatialIndex();
+  private gateSlots: number[] = [];
+  private segmentIndex: SpatialIndex = new SpatialIndex();
+  private segmentSlots: WireSegmentRef[] = [];
+
   /**
    * Create a new CircuitLayout.
    * @param config - Optional custom layout configuration
@@ -134,6 +155,51 @@ export class CircuitLayout {
 
     // Second pass: calculate wire positions based on gate connections
     this.calculateWirePositions(model);
+
+    // Index everything for viewport queries
+    this.buildSpatialIndex(model);
+  }
+
+  /**
+   * Build the gate and wire segment spatial indexes in render order.
+   * @param model - The circuit model
+   * @private
+   */
+  private buildSpatialIndex(model: CircuitModel): void {
+    const { gateWidth, gateHeight } = this.config;
+    this.clearSpatialIndex();
+
+    for (const gate of model.gates.values()) {
+      const pos = this.positions.get(gate.id);
+      if (!pos) continue;
+      this.gateIndex.insert(pos.x, pos.y, pos.x + gateWidth, pos.y + gateHeight);
+      this.gateSlots.push(gate.id);
+    }
+
+    for (const wire of model.wires.values()) {
+      const wirePosition = this.wirePositions.get(wire.id);
+      if (!wirePosition) continue;
+      for (const segment of wirePosition.segments) {
+        this.segmentIndex.insert(
+          Math.min(segment.startX, segment.endX),
+          Math.min(segment.startY, segment.endY),
+          Math.max(segment.startX, segment.endX),
+          Math.max(segment.startY, segment.endY)
+        );
+        this.segmentSlots.push({ wireId: wire.id, width: wirePosition.width, segment });
+      }
+    }
+  }
+
+  /**
+   * Clear the spatial indexes.
+   * @private
+   */
+  private clearSpatialIndex(): void {
+    this.gateIndex.clear();
+    this.gateSlots = [];
+    this.segmentIndex.clear();
+    this.segmentSlots = [];
   }
 
   /**
@@ -262,6 +328,69 @@ export class CircuitLayout {
     return new Map(this.wirePositions);
   }
 
+  /**
+   * Find the gates whose bounds intersect a rectangle.
+   * @param rect - Query rectangle in layout coordinates
+   * @returns Gate slots in render order (see getGateIdAt)
+   */
+  queryGates(rect: Rect): number[] {
+    return this.gateIndex.query(rect);
+  }
+
+  /**
+   * Find the wire segments whose bounds intersect a rectangle.
+   * @param rect - Query rectangle in layout coordinates
+   * @returns Segment slots in render order (see getSegmentAt)
+   */
+  querySegments(rect: Rect): number[] {
+    return this.segmentIndex.query(rect);
+  }
+
+  /**
+   * Find the first gate (in render order) containing a point.
+   * @param x - X coordinate in layout space
+   * @param y - Y coordinate in layout space
+   * @returns The gate ID, or null if no gate contains the point
+   */
+  gateAt(x: number, y: number): number | null {
+    const slots = this.gateIndex.queryPoint(x, y);
+    return slots.length > 0 ? this.gateSlots[slots[0]] : null;
+  }
+
+  /**
+   * Get the gate ID stored in a slot.
+   * @param slot - Slot from queryGates()
+   * @returns The gate ID
+   */
+  getGateIdAt(slot: number): number {
+    return this.gateSlots[slot];
+  }
+
+  /**
+   * Get the wire segment stored in a slot.
+   * @param slot - Slot from querySegments()
+   * @returns The segment with its wire ID and width
+   */
+  getSegmentAt(slot: number): WireSegmentRef {
+    return this.segmentSlots[slot];
+  }
+
+  /**
+   * Get the number of gate slots (one per positioned gate).
+   * @returns The gate slot count
+   */
+  get gateSlotCount(): number {
+    return this.gateSlots.length;
+  }
+
+  /**
+   * Get the number of segment slots (one per wire segment).
+   * @returns The segment slot count
+   */
+  get segmentSlotCount(): number {
+    return this.segmentSlots.length;
+  }
+
   /**
    * Get the number of gates with calculated positions.
    * @returns The count of positioned gates
@@ -302,6 +431,7 @@ export class CircuitLayout {
   clear(): void {
     this.positions.clear();
     this.wirePositions.clear();
+    this.clearSpatialIndex();
   }
 
   /**
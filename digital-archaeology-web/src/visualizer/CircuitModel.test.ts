@@ -301,4 +301,144 @@ describe('CircuitModel', () => {
       expect(emptyModel.getGatesByType('AND')).toHaveLength(0);
     });
   });
+
+  describe('structure', () => {
+    it('should lay out wire bits in one packed vector', () => {
+      expect(Array.from(model.structure.wireBitStart)).toEqual([0, 1, 2, 10, 14, 15]);
+      expect(Array.from(model.wireStates)).toEqual([0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 0, 0]);
+    });
+
+    it('should resolve wire names to indexes once', () => {
+      expect(model.structure.wireIndexByName.get('acc')).toBe(3);
+      expect(model.structure.wireIndexByName.has('nonexistent')).toBe(false);
+    });
+
+    it('should store gate types as codes', () => {
+      const { gateType, gateTypeNames } = model.structure;
+      expect(Array.from(gateType, (code) => gateTypeNames[code])).toEqual([
+        'AND', 'AND', 'OR', 'NOT', 'DFF', 'DFF',
+      ]);
+    });
+
+    it('should resolve gate pins to wire indexes and state slots', () => {
+      const s = model.structure;
+      // AND2 (index 1): inputs vdd.0, pc.0; output acc.0
+      expect(Array.from(s.inputWire.subarray(s.gateInputStart[1], s.gateInputStart[2]))).toEqual([1, 2]);
+      expect(Array.from(s.inputSlot.subarray(s.gateInputStart[1], s.gateInputStart[2]))).toEqual([1, 2]);
+      expect(Array.from(s.outputSlot.subarray(s.gateOutputStart[1], s.gateOutputStart[2]))).toEqual([10]);
+    });
+
+    it('should mark pins on unknown wires or bits as unresolved', () => {
+      testData.gates[0].inputs = [{ wire: 99, bit: 0 }, { wire: 0, bit: 3 }];
+      const s = new CircuitModel(testData).structure;
+
+      expect(Array.from(s.inputWire.subarray(0, 2))).toEqual([-1, 0]);
+      expect(Array.from(s.inputSlot.subarray(0, 2))).toEqual([-1, -1]);
+    });
+  });
+
+  describe('withWireStates()', () => {
+    it('should apply a packed state vector', () => {
+      const states = model.wireStates.slice();
+      states[2] = 1; // pc bit 0
+      states[14] = 1; // z_flag
+
+      const next = model.withWireStates(states);
+
+      expect(next.getWireByName('pc')?.state).toEqual([1, 0, 0, 0, 0, 0, 0, 0]);
+      expect(next.getWire(4)?.state).toEqual([1]);
+      expect(next.wireStates).toBe(states);
+    });
+
+    it('should not modify the source model', () => {
+      const states = model.wireStates.slice();
+      states[2] = 1;
+      model.withWireStates(states);
+
+      expect(model.getWireByName('pc')?.state).toEqual([0, 0, 0, 0, 0, 0, 0, 0]);
+      expect(model.wireStates[2]).toBe(0);
+    });
+
+    it('should reuse unchanged wire objects and share the structure', () => {
+      const states = model.wireStates.slice();
+      states[14] = 1;
+      const next = model.withWireStates(states);
+
+      expect(next.getWire(2)).toBe(model.getWire(2));
+      expect(next.getWire(4)).not.toBe(model.getWire(4));
+      expect(next.structure).toBe(model.structure);
+      expect(next.gates).toBe(model.gates);
+      expect(next.data.gates).toBe(model.data.gates);
+      expect(next.hasSameStructure(model)).toBe(true);
+    });
+
+    it('should keep lookups working on the derived model', () => {
+      const next = model.withWireStates(model.wireStates.slice());
+
+      expect(next.getGatesByType('DFF').map((g) => g.name)).toEqual(['DFF1', 'DFF2']);
+      expect(next.wires.size).toBe(5);
+      expect(next.wiresByName.get('acc')?.state).toEqual([1, 0, 1, 0]);
+      expect(next.cycle).toBe(5);
+    });
+
+    it('should reject a vector of the wrong length', () => {
+      expect(() => model.withWireStates(new Uint8Array(3))).toThrow();
+    });
+  });
+
+  describe('fromData()', () => {
+    it('should return the model that produced the data', () => {
+      const next = model.withWireStates(model.wireStates.slice());
+
+      expect(CircuitModel.fromData(next.data)).toBe(next);
+    });
+
+    it('should index data it has not seen', () => {
+      const fresh = CircuitModel.fromData(testData);
+
+      expect(fresh).not.toBe(model);
+      expect(fresh.gateCount).toBe(6);
+    });
+  });
+
+  describe('hasSameStructure()', () => {
+    const copy = (): CircuitData => JSON.parse(JSON.stringify(testData)) as CircuitData;
+
+    it('should ignore state, cycle and stored values', () => {
+      const data = copy();
+      data.cycle = 99;
+      data.wires[0].state = [1];
+      data.gates[0].stored = 1;
+
+      expect(model.hasSameStructure(new CircuitModel(data))).toBe(true);
+    });
+
+    it('should detect a changed gate type', () => {
+      const data = copy();
+      data.gates[0].type = 'XOR';
+
+      expect(model.hasSameStructure(new CircuitModel(data))).toBe(false);
+    });
+
+    it('should detect a changed connection', () => {
+      const data = copy();
+      data.gates[0].inputs = [...data.gates[0].inputs, { wire: 0, bit: 0 }];
+
+      expect(model.hasSameStructure(new CircuitModel(data))).toBe(false);
+    });
+
+    it('should detect a changed wire width', () => {
+      const data = copy();
+      data.wires[0].width = 2;
+
+      expect(model.hasSameStructure(new CircuitModel(data))).toBe(false);
+    });
+
+    it('should detect added gates', () => {
+      const data = copy();
+      data.gates.push({ id: 999, name: 'EXTRA', type: 'AND', inputs: [], outputs: [] });
+
+      expect(model.hasSameStructure(new CircuitModel(data))).toBe(false);
+    });
+  });
 });
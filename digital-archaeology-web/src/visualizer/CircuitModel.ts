@@ -1,46 +1,158 @@
 // src/visualizer/CircuitModel.ts
 // Indexed access to circuit data (Story 6.2)
 
-import type { CircuitData, CircuitWire, CircuitGate } from './types';
+import type { CircuitData, CircuitWire, CircuitGate, GatePort } from './types';
+
+/**
+ * Columnar, typed-array view of a circuit's structure, built once per
+ * loaded circuit and shared by every model derived from it with
+ * CircuitModel.withWireStates(). Indexes refer to positions in
+ * CircuitData.gates and CircuitData.wires.
+ *
+ * Wire states are packed into one vector with a byte per bit (0 = low,
+ * 1 = high, 2 = undefined/X); wire i occupies slots
+ * wireBitStart[i] to wireBitStart[i + 1].
+ */
+export interface CircuitStructure {
+  /** Gate type names; gateType values index into this table */
+  readonly gateTypeNames: readonly string[];
+  /** Type code of each gate */
+  readonly gateType: Uint16Array;
+  /** Gate i's inputs are pins gateInputStart[i] to gateInputStart[i + 1] */
+  readonly gateInputStart: Uint32Array;
+  /** Gate i's outputs are pins gateOutputStart[i] to gateOutputStart[i + 1] */
+  readonly gateOutputStart: Uint32Array;
+  /** Wire index of each input pin, -1 if the wire does not exist */
+  readonly inputWire: Int32Array;
+  /** State vector slot of each input pin, -1 if unresolved */
+  readonly inputSlot: Int32Array;
+  /** Wire index of each output pin, -1 if the wire does not exist */
+  readonly outputWire: Int32Array;
+  /** State vector slot of each output pin, -1 if unresolved */
+  readonly outputSlot: Int32Array;
+  /** First state vector slot of each wire, plus the vector length at the end */
+  readonly wireBitStart: Uint32Array;
+  /** Wire ID to wire index */
+  readonly wireIndexById: ReadonlyMap<number, number>;
+  /** Wire name to wire index, resolved once at load */
+  readonly wireIndexByName: ReadonlyMap<string, number>;
+  /** Gate ID to gate index */
+  readonly gateIndexById: ReadonlyMap<number, number>;
+}
+
+/**
+ * Models created by withWireStates(), by their data, so a renderer handed
+ * only the data can recover the model without re-indexing it.
+ */
+const derivedModels = new WeakMap<CircuitData, CircuitModel>();
 
 /**
  * Provides indexed access to circuit data for efficient lookups.
- * Creates Maps for O(1) access to gates and wires by ID or name.
+ * Creates Maps for O(1) access to gates and wires by ID or name, and a
+ * typed-array structure (see CircuitStructure) with the wire states packed
+ * into a single vector so emulator state can be applied in bulk.
  */
 export class CircuitModel {
   /** Map of gate ID to gate data for O(1) lookup */
   public readonly gates: Map<number, CircuitGate>;
 
-  /** Map of wire ID to wire data for O(1) lookup */
-  public readonly wires: Map<number, CircuitWire>;
-
-  /** Map of wire name to wire data for name-based lookup */
-  public readonly wiresByName: Map<string, CircuitWire>;
-
   /** Original circuit data reference */
   public readonly data: CircuitData;
 
+  /** Typed-array structure, shared with models derived from this one */
+  public readonly structure: CircuitStructure;
+
+  /** Gate indexes per type name, built on first use (shared) */
+  private readonly gatesByType: Map<string, number[]>;
+
+  /** Lazily built wire Maps */
+  private wireMap: Map<number, CircuitWire> | null = null;
+  private wireNameMap: Map<string, CircuitWire> | null = null;
+
+  /** Packed wire states, built on first use unless given */
+  private packedStates: Uint8Array | null;
+
   /**
    * Create a CircuitModel from circuit data.
-   * Builds indexed Maps for efficient access.
+   * Builds indexed Maps and the typed-array structure.
    * @param data - The circuit data to index
    */
-  constructor(data: CircuitData) {
+  constructor(data: CircuitData);
+  /**
+   * Create a model sharing another model's indexes (see withWireStates()).
+   * @param data - Circuit data with the same structure as the source
+   * @param source - Model whose gates Map and structure are shared
+   * @param states - Packed wire states of data
+   * @internal
+   */
+  constructor(data: CircuitData, source: CircuitModel, states: Uint8Array);
+  constructor(data: CircuitData, source?: CircuitModel, states?: Uint8Array) {
     this.data = data;
 
+    if (source) {
+      this.gates = source.gates;
+      this.structure = source.structure;
+      this.gatesByType = source.gatesByType;
+      this.packedStates = states ?? null;
+      return;
+    }
+
     // Build gates Map
     this.gates = new Map();
     for (const gate of data.gates) {
       this.gates.set(gate.id, gate);
     }
 
-    // Build wires Map and wiresByName Map
-    this.wires = new Map();
-    this.wiresByName = new Map();
-    for (const wire of data.wires) {
-      this.wires.set(wire.id, wire);
-      this.wiresByName.set(wire.name, wire);
+    this.structure = buildStructure(data);
+    this.gatesByType = new Map();
+    this.packedStates = null;
+  }
+
+  /**
+   * Get the model for circuit data, reusing the model that produced it
+   * with withWireStates() instead of indexing it again.
+   * @param data - The circuit data
+   * @returns A model for the data
+   */
+  static fromData(data: CircuitData): CircuitModel {
+    return derivedModels.get(data) ?? new CircuitModel(data);
+  }
+
+  /**
+   * Map of wire ID to wire data for O(1) lookup.
+   */
+  get wires(): Map<number, CircuitWire> {
+    if (!this.wireMap) {
+      this.wireMap = new Map();
+      for (const wire of this.data.wires) {
+        this.wireMap.set(wire.id, wire);
+      }
+    }
+    return this.wireMap;
+  }
+
+  /**
+   * Map of wire name to wire data for name-based lookup.
+   */
+  get wiresByName(): Map<string, CircuitWire> {
+    if (!this.wireNameMap) {
+      this.wireNameMap = new Map();
+      for (const wire of this.data.wires) {
+        this.wireNameMap.set(wire.name, wire);
+      }
+    }
+    return this.wireNameMap;
+  }
+
+  /**
+   * Wire states packed into one vector (see CircuitStructure).
+   * Treat as read-only; copy it to build the vector for withWireStates().
+   */
+  get wireStates(): Uint8Array {
+    if (!this.packedStates) {
+      this.packedStates = packWireStates(this.data.wires, this.structure.wireBitStart);
     }
+    return this.packedStates;
   }
 
   /**
@@ -58,7 +170,8 @@ export class CircuitModel {
    * @returns The wire or undefined if not found
    */
   getWire(id: number): CircuitWire | undefined {
-    return this.wires.get(id);
+    const index = this.structure.wireIndexById.get(id);
+    return index === undefined ? undefined : this.data.wires[index];
   }
 
   /**
@@ -67,7 +180,8 @@ export class CircuitModel {
    * @returns The wire or undefined if not found
    */
   getWireByName(name: string): CircuitWire | undefined {
-    return this.wiresByName.get(name);
+    const index = this.structure.wireIndexByName.get(name);
+    return index === undefined ? undefined : this.data.wires[index];
   }
 
   /**
@@ -76,13 +190,95 @@ export class CircuitModel {
    * @returns Array of gates matching the type
    */
   getGatesByType(type: string): CircuitGate[] {
-    const result: CircuitGate[] = [];
-    for (const gate of this.gates.values()) {
-      if (gate.type === type) {
-        result.push(gate);
+    if (this.gatesByType.size === 0) {
+      this.indexGatesByType();
+    }
+    const indexes = this.gatesByType.get(type);
+    if (!indexes) return [];
+    return indexes.map((i) => this.data.gates[i]);
+  }
+
+  /**
+   * Create a model with the same structure and new wire states.
+   * Wires whose bits are unchanged keep their objects; only changed wires
+   * get new ones, so applying an emulator step costs one pass over the
+   * packed vector rather than a rebuild of the model.
+   * @param states - Packed wire states, laid out like wireStates; adopted, not copied
+   * @returns The new model
+   */
+  withWireStates(states: Uint8Array): CircuitModel {
+    const { wireBitStart } = this.structure;
+    if (states.length !== this.wireStates.length) {
+      throw new RangeError(
+        `Wire state vector has ${states.length} bits, circuit has ${this.wireStates.length}`
+      );
+    }
+
+    const current = this.wireStates;
+    const source = this.data.wires;
+    const wires: CircuitWire[] = new Array(source.length);
+    for (let i = 0; i < source.length; i++) {
+      const start = wireBitStart[i];
+      const end = wireBitStart[i + 1];
+      let same = true;
+      for (let s = start; s < end; s++) {
+        if (states[s] !== current[s]) {
+          same = false;
+          break;
+        }
       }
+      wires[i] = same ? source[i] : { ...source[i], state: Array.from(states.subarray(start, end)) };
     }
-    return result;
+
+    const data: CircuitData = {
+      cycle: this.data.cycle,
+      stable: this.data.stable,
+      wires,
+      gates: this.data.gates,
+    };
+    const model = new CircuitModel(data, this, states);
+    derivedModels.set(data, model);
+    return model;
+  }
+
+  /**
+   * Check whether another model has the same gates, wires and connections,
+   * so a layout computed for one is valid for the other. Signal state,
+   * cycle and DFF contents are not compared.
+   * @param other - The model to compare against
+   * @returns True if only state differs between the two models
+   */
+  hasSameStructure(other: CircuitModel): boolean {
+    // Models derived from one another share their structure
+    if (this.structure === other.structure) {
+      return true;
+    }
+
+    const a = this.data;
+    const b = other.data;
+    if (a.gates.length !== b.gates.length || a.wires.length !== b.wires.length) {
+      return false;
+    }
+
+    for (let i = 0; i < a.wires.length; i++) {
+      if (a.wires[i].id !== b.wires[i].id || a.wires[i].width !== b.wires[i].width) {
+        return false;
+      }
+    }
+
+    for (let i = 0; i < a.gates.length; i++) {
+      const ga = a.gates[i];
+      const gb = b.gates[i];
+      if (
+        ga.id !== gb.id ||
+        ga.type !== gb.type ||
+        !samePorts(ga.inputs, gb.inputs) ||
+        !samePorts(ga.outputs, gb.outputs)
+      ) {
+        return false;
+      }
+    }
+    return true;
   }
 
   /**
@@ -96,7 +292,7 @@ export class CircuitModel {
    * Get the total number of wires.
    */
   get wireCount(): number {
-    return this.wires.size;
+    return this.structure.wireIndexById.size;
   }
 
   /**
@@ -112,4 +308,130 @@ export class CircuitModel {
   get isStable(): boolean {
     return this.data.stable;
   }
+
+  /**
+   * Group gate indexes by type from the type column.
+   * Gates with duplicate IDs appear once, as in the gates Map.
+   * @private
+   */
+  private indexGatesByType(): void {
+    const { gateType, gateTypeNames, gateIndexById } = this.structure;
+    const gates = this.data.gates;
+    for (let i = 0; i < gates.length; i++) {
+      if (gateIndexById.get(gates[i].id) !== i) continue;
+      const name = gateTypeNames[gateType[i]];
+      let list = this.gatesByType.get(name);
+      if (!list) {
+        list = [];
+        this.gatesByType.set(name, list);
+      }
+      list.push(i);
+    }
+  }
+}
+
+/**
+ * Build the typed-array structure of circuit data.
+ * @param data - The circuit data
+ * @returns The structure
+ */
+function buildStructure(data: CircuitData): CircuitStructure {
+  const { wires, gates } = data;
+
+  // Wires: index maps and bit layout of the packed state vector
+  const wireIndexById = new Map<number, number>();
+  const wireIndexByName = new Map<string, number>();
+  const wireBitStart = new Uint32Array(wires.length + 1);
+  for (let i = 0; i < wires.length; i++) {
+    wireIndexById.set(wires[i].id, i);
+    wireIndexByName.set(wires[i].name, i);
+    wireBitStart[i + 1] = wireBitStart[i] + Math.max(0, wires[i].width);
+  }
+
+  // Gates: type codes and pin offsets
+  const gateTypeNames: string[] = [];
+  const typeCodes = new Map<string, number>();
+  const gateType = new Uint16Array(gates.length);
+  const gateIndexById = new Map<number, number>();
+  const gateInputStart = new Uint32Array(gates.length + 1);
+  const gateOutputStart = new Uint32Array(gates.length + 1);
+  for (let i = 0; i < gates.length; i++) {
+    const gate = gates[i];
+    let code = typeCodes.get(gate.type);
+    if (code === undefined) {
+      code = gateTypeNames.length;
+      typeCodes.set(gate.type, code);
+      gateTypeNames.push(gate.type);
+    }
+    gateType[i] = code;
+    gateIndexById.set(gate.id, i);
+    gateInputStart[i + 1] = gateInputStart[i] + gate.inputs.length;
+    gateOutputStart[i + 1] = gateOutputStart[i] + gate.outputs.length;
+  }
+
+  // Pins: wire index and state slot
+  const inputWire = new Int32Array(gateInputStart[gates.length]);
+  const inputSlot = new Int32Array(inputWire.length);
+  const outputWire = new Int32Array(gateOutputStart[gates.length]);
+  const outputSlot = new Int32Array(outputWire.length);
+  const resolvePins = (ports: GatePort[], start: number, wireCol: Int32Array, slotCol: Int32Array): void => {
+    for (let p = 0; p < ports.length; p++) {
+      const index = wireIndexById.get(ports[p].wire) ?? -1;
+      const bit = ports[p].bit;
+      wireCol[start + p] = index;
+      slotCol[start + p] =
+        index >= 0 && bit >= 0 && bit < wireBitStart[index + 1] - wireBitStart[index]
+          ? wireBitStart[index] + bit
+          : -1;
+    }
+  };
+  for (let i = 0; i < gates.length; i++) {
+    resolvePins(gates[i].inputs, gateInputStart[i], inputWire, inputSlot);
+    resolvePins(gates[i].outputs, gateOutputStart[i], outputWire, outputSlot);
+  }
+
+  return {
+    gateTypeNames,
+    gateType,
+    gateInputStart,
+    gateOutputStart,
+    inputWire,
+    inputSlot,
+    outputWire,
+    outputSlot,
+    wireBitStart,
+    wireIndexById,
+    wireIndexByName,
+    gateIndexById,
+  };
+}
+
+/**
+ * Pack wire state arrays into one vector. Missing bits read as 0.
+ * @param wires - Wires in structure order
+ * @param wireBitStart - Slot offsets from the structure
+ * @returns The packed states
+ */
+function packWireStates(wires: CircuitWire[], wireBitStart: Uint32Array): Uint8Array {
+  const states = new Uint8Array(wireBitStart[wires.length]);
+  for (let i = 0; i < wires.length; i++) {
+    const start = wireBitStart[i];
+    const width = wireBitStart[i + 1] - start;
+    const state = wires[i].state;
+    for (let b = 0; b < width && b < state.length; b++) {
+      states[start + b] = state[b];
+    }
+  }
+  return states;
+}
+
+/**
+ * Compare two port lists by wire and bit.
+ */
+function samePorts(a: GatePort[], b: GatePort[]): boolean {
+  if (a.length !== b.length) return false;
+  for (let i = 0; i < a.length; i++) {
+    if (a[i].wire !== b[i].wire || a[i].bit !== b[i].bit) return false;
+  }
+  return true;
 }
@@ -843,10 +843,14 @@ describe('CircuitRenderer', () => {
       const model = renderer.getCircuitModel();
       expect(model?.gateCount).toBe(150);
 
-      // Verify gates were rendered (at least roundRect was called for each)
+      // Only gates inside the 800px viewport are drawn at 100% zoom
       expect(mockRoundRect).toHaveBeenCalled();
-      // Should have rendered all 150 gates (called once per gate)
-      expect(mockRoundRect.mock.calls.length).toBeGreaterThanOrEqual(150);
+      expect(mockRoundRect.mock.calls.length).toBeLessThan(150);
+
+      // Zoomed to fit, every gate is visible and rendered once
+      mockRoundRect.mockClear();
+      renderer.zoomToFit();
+      expect(mockRoundRect.mock.calls.length).toBe(150);
     });
 
     it('should cache layout and only recalculate when circuit or dimensions change', () => {
@@ -2848,4 +2852,145 @@ describe('CircuitRenderer', () => {
       });
     });
   });
+
+  describe('incremental rendering', () => {
+    // AND -> w0 -> OR -> w1 -> NOT, laid out left to right in one row
+    const createChainData = (w0: number, w1: number): CircuitData => ({
+      cycle: 0,
+      stable: true,
+      wires: [
+        { id: 0, name: 'w0', width: 1, is_input: false, is_output: false, state: [w0] },
+        { id: 1, name: 'w1', width: 1, is_input: false, is_output: false, state: [w1] },
+      ],
+      gates: [
+        { id: 0, name: 'AND0', type: 'AND', inputs: [], outputs: [{ wire: 0, bit: 0 }] },
+        { id: 1, name: 'OR1', type: 'OR', inputs: [{ wire: 0, bit: 0 }], outputs: [{ wire: 1, bit: 0 }] },
+        { id: 2, name: 'NOT2', type: 'NOT', inputs: [{ wire: 1, bit: 0 }], outputs: [] },
+      ],
+    });
+
+    let mockMoveTo: ReturnType<typeof vi.fn>;
+    let mockRoundRect: ReturnType<typeof vi.fn>;
+    let mockFillText: ReturnType<typeof vi.fn>;
+    let mockClip: ReturnType<typeof vi.fn>;
+
+    const drawnLabels = (): string[] => mockFillText.mock.calls.map((call) => call[0] as string);
+
+    const clearDrawCalls = (): void => {
+      mockFillRect.mockClear();
+      mockMoveTo.mockClear();
+      mockRoundRect.mockClear();
+      mockFillText.mockClear();
+      mockClip.mockClear();
+    };
+
+    beforeEach(() => {
+      mockMoveTo = vi.fn();
+      mockRoundRect = vi.fn();
+      mockFillText = vi.fn();
+      mockClip = vi.fn();
+
+      // A context that supports clipping and bitmap copies retains frames
+      mockCtx = {
+        fillRect: mockFillRect,
+        scale: mockScale,
+        setTransform: mockSetTransform,
+        translate: vi.fn(),
+        fillStyle: '',
+        strokeStyle: '',
+        lineWidth: 0,
+        lineCap: 'butt' as CanvasLineCap,
+        beginPath: vi.fn(),
+        moveTo: mockMoveTo,
+        lineTo: vi.fn(),
+        stroke: vi.fn(),
+        roundRect: mockRoundRect,
+        fill: vi.fn(),
+        fillText: mockFillText,
+        font: '',
+        textAlign: '' as CanvasTextAlign,
+        textBaseline: '' as CanvasTextBaseline,
+        save: vi.fn(),
+        restore: vi.fn(),
+        shadowBlur: 0,
+        shadowColor: '',
+        rect: vi.fn(),
+        clip: mockClip,
+        drawImage: vi.fn(),
+      } as unknown as CanvasRenderingContext2D;
+
+      vi.spyOn(HTMLCanvasElement.prototype, 'getContext').mockImplementation(
+        (contextId: string) => {
+          if (contextId === '2d') {
+            return mockCtx;
+          }
+          return null;
+        }
+      );
+    });
+
+    it('should draw nothing when nothing changed since the last frame', () => {
+      renderer.mount(container);
+      renderer.updateState({ circuitData: createChainData(0, 0) });
+      clearDrawCalls();
+
+      renderer.render();
+
+      expect(mockFillRect).not.toHaveBeenCalled();
+      expect(mockMoveTo).not.toHaveBeenCalled();
+      expect(mockRoundRect).not.toHaveBeenCalled();
+    });
+
+    it('should redraw only the region around a wire whose value changed', () => {
+      renderer.mount(container);
+      renderer.updateState({ circuitData: createChainData(0, 0) });
+      clearDrawCalls();
+
+      // Same structure, new state: w1 (OR -> NOT) goes high
+      renderer.updateState({ circuitData: createChainData(0, 1) });
+
+      expect(mockClip).toHaveBeenCalledTimes(1);
+      expect(mockMoveTo).toHaveBeenCalledTimes(1);
+      expect(drawnLabels()).toContain('OR');
+      expect(drawnLabels()).toContain('NOT');
+      expect(drawnLabels()).not.toContain('AND');
+    });
+
+    it('should redraw only the region around a newly highlighted gate', () => {
+      renderer.mount(container);
+      renderer.updateState({ circuitData: createChainData(0, 0) });
+      clearDrawCalls();
+
+      renderer.setHighlightedGates([0]);
+
+      expect(mockClip).toHaveBeenCalledTimes(1);
+      expect(drawnLabels()).toContain('AND');
+      expect(drawnLabels()).not.toContain('NOT');
+    });
+
+    it('should redraw the whole view when the zoom changes', () => {
+      renderer.mount(container);
+      renderer.updateState({ circuitData: createChainData(0, 0) });
+      clearDrawCalls();
+
+      renderer.setZoom(2);
+
+      expect(mockClip).not.toHaveBeenCalled();
+      expect(mockFillRect).toHaveBeenCalled();
+      expect(drawnLabels()).toEqual(['AND', 'OR', 'NOT']);
+    });
+
+    it('should redraw the whole view when the circuit structure changes', () => {
+      renderer.mount(container);
+      renderer.updateState({ circuitData: createChainData(0, 0) });
+      clearDrawCalls();
+
+      const data = createChainData(0, 0);
+      data.gates[2] = { ...data.gates[2], type: 'BUF' };
+      renderer.updateState({ circuitData: data });
+
+      expect(mockClip).not.toHaveBeenCalled();
+      expect(drawnLabels()).toEqual(['AND', 'OR', 'BUF']);
+    });
+  });
 });
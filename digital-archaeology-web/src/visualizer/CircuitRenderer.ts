@@ -1,25 +1,19 @@
 // src/visualizer/CircuitRenderer.ts
 // Canvas circuit renderer component for visualizing CPU circuits (Story 6.1, 6.2, 6.3, 6.4, 6.5, 6.6, 6.7, 6.8)
+// Layout and drawing live in CircuitScene, on this thread or in a render worker
 
-import type { CircuitData, CircuitGate } from './types';
+import type { CircuitData, CircuitGate, RenderWorkerCommand, RenderWorkerEvent } from './types';
 import { CircuitModel } from './CircuitModel';
 import { CircuitLoader, CircuitLoadError } from './CircuitLoader';
-import { GateRenderer } from './GateRenderer';
-import { CircuitLayout } from './CircuitLayout';
-import { WireRenderer } from './WireRenderer';
+import { CircuitScene, CIRCUIT_THEME_VARS, getThemeBackground } from './CircuitScene';
+import type { SceneAppearance, SceneView } from './CircuitScene';
 import { AnimationController } from './AnimationController';
 import { SignalAnimator } from './SignalAnimator';
-import { calculatePulseScale, prefersReducedMotion } from './animationUtils';
+import { prefersReducedMotion } from './animationUtils';
 import { ZoomController } from './ZoomController';
 import type { ZoomChangeCallback } from './ZoomController';
 import { GateTooltip } from './GateTooltip';
-
-/**
- * Default background color matching --da-bg-primary in Lab Mode.
- * Used as fallback when CSS variable is not available (e.g., in tests).
- * This constant mirrors the CSS variable to maintain single source of truth in CSS.
- */
-const DEFAULT_BG_PRIMARY = '#1a1a2e';
+import { captureThemeVars } from './themeVars';
 
 /**
  * Animation configuration for CircuitRenderer.
@@ -67,6 +61,12 @@ export interface CircuitRendererOptions {
   onGateClick?: (gateId: number, gateName: string) => void;
   /** Callback when background (not a gate) is clicked (Story 6.10) */
   onBackgroundClick?: () => void;
+  /**
+   * Lay out and draw in a worker on an OffscreenCanvas, when the browser
+   * supports it (default: false). The UI thread then only forwards view and
+   * input state, and transitions are applied without animation.
+   */
+  renderInWorker?: boolean;
 }
 
 /**
@@ -103,12 +103,17 @@ export class CircuitRenderer {
   private circuitModel: CircuitModel | null = null;
   private loader: CircuitLoader | null = null;
 
-  // Gate rendering (Story 6.3)
-  private gateRenderer: GateRenderer | null = null;
-  private layout: CircuitLayout | null = null;
+  // Layout and drawing (Story 6.3, 6.4)
+  private scene: CircuitScene = new CircuitScene();
 
-  // Wire rendering (Story 6.4)
-  private wireRenderer: WireRenderer | null = null;
+  // Off-main-thread rendering: the worker owns the scene and the canvas
+  private renderWorker: Worker | null = null;
+  private boundWorkerMessageHandler: ((e: MessageEvent) => void) | null = null;
+  private workerContentBounds: { width: number; height: number } | null = null;
+  private statePortConnected: boolean = false;
+  private hitTestRequestId: number = 0;
+  private hoverRequestId: number = 0;
+  private hitTestCallbacks: Map<number, (gateId: number | null) => void> = new Map();
 
   // Animation (Story 6.5)
   private animationController: AnimationController | null = null;
@@ -144,11 +149,6 @@ export class CircuitRenderer {
   // Circuit-to-code linking (Story 6.10)
   private clickedGateId: number | null = null;
 
-  // Layout cache tracking - only recalculate when needed
-  private lastLayoutWidth: number = 0;
-  private lastLayoutHeight: number = 0;
-  private lastLayoutModelId: number = 0; // Tracks which circuit model was used
-
   // Bound event handler for cleanup
   private boundHandleResize: (entries: ResizeObserverEntry[]) => void;
 
@@ -202,10 +202,13 @@ export class CircuitRenderer {
     this.canvas.setAttribute('role', 'img');
     this.canvas.setAttribute('aria-label', 'CPU circuit diagram');
 
-    // Get 2D rendering context
-    this.ctx = this.canvas.getContext('2d');
-    if (!this.ctx) {
-      throw new Error('Failed to get 2D canvas context');
+    // Hand the canvas to a render worker, or draw into it on this thread
+    if (!this.startRenderWorker(this.canvas)) {
+      this.ctx = this.canvas.getContext('2d');
+      if (!this.ctx) {
+        throw new Error('Failed to get 2D canvas context');
+      }
+      this.scene.attach(this.ctx);
     }
 
     // Append canvas to container
@@ -430,9 +433,22 @@ export class CircuitRenderer {
     // Convert screen to canvas coordinates
     const canvasCoords = this.screenToCanvas(e.clientX, e.clientY);
 
-    // Hit test against gates
-    const gate = this.hitTestGate(canvasCoords.x, canvasCoords.y);
+    // Hit test against gates (asynchronously when the worker owns the layout)
+    if (this.renderWorker) {
+      this.requestHitTest(canvasCoords.x, canvasCoords.y, (gateId) => {
+        this.applyClick(gateId === null ? null : this.circuitModel?.getGate(gateId) ?? null);
+      });
+      return;
+    }
+    this.applyClick(this.hitTestGate(canvasCoords.x, canvasCoords.y));
+  }
 
+  /**
+   * Apply the result of a click hit test (Story 6.9, 6.10).
+   * @param gate - The clicked gate, or null for background
+   * @private
+   */
+  private applyClick(gate: CircuitGate | null): void {
     if (gate) {
       // Gate was clicked - Story 6.10
       this.clickedGateId = gate.id;
@@ -465,10 +481,28 @@ export class CircuitRenderer {
 
     // Convert screen to canvas coordinates
     const canvasCoords = this.screenToCanvas(e.clientX, e.clientY);
+    const { clientX, clientY } = e;
 
-    // Hit test against gates
-    const gate = this.hitTestGate(canvasCoords.x, canvasCoords.y);
+    // Hit test against gates; only the latest worker answer is applied
+    if (this.renderWorker) {
+      const requestId = this.requestHitTest(canvasCoords.x, canvasCoords.y, (gateId) => {
+        if (requestId !== this.hoverRequestId || this.isDragging) return;
+        this.applyHover(gateId === null ? null : this.circuitModel?.getGate(gateId) ?? null, clientX, clientY);
+      });
+      this.hoverRequestId = requestId;
+      return;
+    }
+    this.applyHover(this.hitTestGate(canvasCoords.x, canvasCoords.y), clientX, clientY);
+  }
 
+  /**
+   * Apply the result of a hover hit test (Story 6.8).
+   * @param gate - The gate under the pointer, or null
+   * @param clientX - Pointer X in viewport pixels, for the tooltip
+   * @param clientY - Pointer Y in viewport pixels, for the tooltip
+   * @private
+   */
+  private applyHover(gate: CircuitGate | null, clientX: number, clientY: number): void {
     // Check if hover state changed
     const newGateId = gate?.id ?? null;
     if (newGateId !== this.hoveredGateId) {
@@ -478,7 +512,7 @@ export class CircuitRenderer {
       if (gate && this.tooltip) {
         // Get wire states from circuit model for output display
         const wireStates = this.getWireStates();
-        this.tooltip.show(e.clientX, e.clientY, gate, wireStates);
+        this.tooltip.show(clientX, clientY, gate, wireStates);
       } else if (this.tooltip) {
         this.tooltip.hide();
       }
@@ -488,7 +522,7 @@ export class CircuitRenderer {
     } else if (gate && this.tooltip?.isVisible()) {
       // Update tooltip position if still hovering same gate
       const wireStates = this.getWireStates();
-      this.tooltip.show(e.clientX, e.clientY, gate, wireStates);
+      this.tooltip.show(clientX, clientY, gate, wireStates);
     }
   }
 
@@ -498,6 +532,8 @@ export class CircuitRenderer {
    * @private
    */
   private handleMouseLeave(_e: MouseEvent): void {
+    // Drop any hover answer still on its way from the render worker
+    this.hoverRequestId = 0;
     if (this.hoveredGateId !== null) {
       this.hoveredGateId = null;
       this.tooltip?.hide();
@@ -530,32 +566,15 @@ export class CircuitRenderer {
 
   /**
    * Hit test against all gates to find one at the given canvas coordinates (Story 6.8).
+   * When rendering in a worker the layout lives there, so this returns null;
+   * pointer handling then asks the worker instead.
    * @param canvasX - X coordinate in canvas space
    * @param canvasY - Y coordinate in canvas space
    * @returns The gate at the coordinates, or null if none
    */
   hitTestGate(canvasX: number, canvasY: number): CircuitGate | null {
-    if (!this.circuitModel || !this.layout) return null;
-
-    const config = this.layout.getConfig();
-    const { gateWidth, gateHeight } = config;
-
-    for (const gate of this.circuitModel.gates.values()) {
-      const pos = this.layout.getPosition(gate.id);
-      if (!pos) continue;
-
-      // Check if point is within gate bounds
-      if (
-        canvasX >= pos.x &&
-        canvasX <= pos.x + gateWidth &&
-        canvasY >= pos.y &&
-        canvasY <= pos.y + gateHeight
-      ) {
-        return gate;
-      }
-    }
-
-    return null;
+    if (!this.circuitModel || this.renderWorker) return null;
+    return this.scene.hitTestGate(canvasX, canvasY);
   }
 
   /**
@@ -603,7 +622,7 @@ export class CircuitRenderer {
    * @private
    */
   private updateDimensions(width: number, height: number): void {
-    if (!this.canvas || !this.ctx) return;
+    if (!this.canvas) return;
 
     // Store display dimensions
     this.displayWidth = width;
@@ -613,8 +632,13 @@ export class CircuitRenderer {
     this.devicePixelRatio = window.devicePixelRatio || 1;
 
     // Set internal canvas size (scaled for HiDPI)
-    this.canvas.width = width * this.devicePixelRatio;
-    this.canvas.height = height * this.devicePixelRatio;
+    // Resizing clears the bitmap, so the next render must be a full one.
+    // A transferred canvas is sized by the render worker from the view.
+    if (this.ctx) {
+      this.canvas.width = width * this.devicePixelRatio;
+      this.canvas.height = height * this.devicePixelRatio;
+      this.scene.invalidateFrame();
+    }
 
     // Set display size via CSS
     this.canvas.style.width = `${width}px`;
@@ -633,62 +657,63 @@ export class CircuitRenderer {
    */
   private applyCanvasTransform(): void {
     if (!this.ctx) return;
+    this.scene.applyTransform(this.ctx, this.getView());
+  }
 
-    const zoom = this.zoomController.getScale();
+  /**
+   * Current view size and transform.
+   * @private
+   */
+  private getView(): SceneView {
     const offset = this.zoomController.getOffset();
-    const combinedScale = this.devicePixelRatio * zoom;
-
-    this.ctx.setTransform(1, 0, 0, 1, 0, 0); // Reset transform
-    // Apply offset BEFORE scaling so it's in screen coordinates (Story 6.7)
-    this.ctx.translate(offset.x * this.devicePixelRatio, offset.y * this.devicePixelRatio);
-    this.ctx.scale(combinedScale, combinedScale);
+    return {
+      width: this.displayWidth,
+      height: this.displayHeight,
+      dpr: this.devicePixelRatio,
+      scale: this.zoomController.getScale(),
+      offsetX: offset.x,
+      offsetY: offset.y,
+    };
   }
 
   /**
-   * Get the theme background color from CSS custom properties.
-   * Falls back to DEFAULT_BG_PRIMARY if variable is unavailable.
-   * @returns The background color string
+   * Current hover, highlight and animation state, as the scene draws it.
    * @private
    */
-  private getThemeBackground(): string {
-    const style = getComputedStyle(document.documentElement);
-    const bgColor = style.getPropertyValue('--da-bg-primary').trim();
-    return bgColor || DEFAULT_BG_PRIMARY;
+  private getAppearance(): SceneAppearance {
+    return {
+      hoveredGateId: this.hoveredGateId,
+      clickedGateId: this.clickedGateId,
+      highlightedGateIds: this.highlightedGateIds,
+      highlightedWireSegments: this.highlightedWireSegments,
+      changedGates: this.changedGates,
+      animationProgress: this.animationProgress,
+      interpolatedWireStates: this.interpolatedWireStates,
+      enableGatePulse: this.options.animation?.enableGatePulse !== false,
+    };
   }
 
   /**
    * Render the canvas with theme background and circuit elements.
-   * This is the main render method that clears the canvas and draws all elements.
+   * Drawing is incremental (see CircuitScene.draw()). With a render worker,
+   * the view and appearance are posted and the worker draws on its next
+   * animation frame; onRenderComplete then fires when it reports back.
    */
   render(): void {
-    if (!this.ctx || !this.canvas) return;
-
-    // Apply canvas transform with current zoom (Story 6.6)
-    this.applyCanvasTransform();
+    if (this.renderWorker) {
+      this.postToRenderWorker({
+        type: 'RENDER',
+        payload: { view: this.getView(), appearance: this.getAppearance() },
+      });
+      return;
+    }
 
-    // Clear canvas with theme background
-    // Note: fillRect coordinates are in transformed space, so we need to account for
-    // both zoom and pan offset to ensure the entire visible area is filled (Story 6.7)
-    const bgColor = this.getThemeBackground();
-    this.ctx.fillStyle = bgColor;
-    const zoom = this.zoomController.getScale();
-    const offset = this.zoomController.getOffset();
-    // Calculate fill area to cover entire viewport in transformed coordinates
-    // Use (0 - x) instead of -x to avoid JavaScript's -0 edge case
-    const fillX = (0 - offset.x) / zoom;
-    const fillY = (0 - offset.y) / zoom;
-    const fillWidth = this.displayWidth / zoom;
-    const fillHeight = this.displayHeight / zoom;
-    this.ctx.fillRect(fillX, fillY, fillWidth, fillHeight);
+    if (!this.ctx || !this.canvas) return;
 
     // Ensure layout is calculated before rendering (Story 6.4)
     this.ensureLayoutCalculated();
 
-    // Render wires BEFORE gates so gates appear on top (Story 6.4)
-    this.renderWires();
-
-    // Render gates if circuit data is loaded (Story 6.3)
-    this.renderGates();
+    this.scene.draw(this.ctx, this.canvas, this.getView(), this.getAppearance(), getThemeBackground());
 
     // Call render complete callback if provided
     this.options.onRenderComplete?.();
@@ -696,136 +721,169 @@ export class CircuitRenderer {
 
   /**
    * Ensure layout is calculated and up-to-date.
-   * Shared by both wire and gate rendering.
    * Updates content bounds for pan clamping when layout changes (Story 6.7).
    * @private
    */
   private ensureLayoutCalculated(): void {
-    if (!this.circuitModel) return;
-
-    // Lazily create layout on first use
-    if (!this.layout) {
-      this.layout = new CircuitLayout();
+    if (this.scene.updateLayout(this.displayWidth, this.displayHeight)) {
+      this.applyContentBounds(this.scene.getLayout()?.getBounds() ?? null);
     }
+  }
 
-    // Only recalculate layout when circuit or dimensions change
-    const needsLayoutRecalc =
-      this.displayWidth !== this.lastLayoutWidth ||
-      this.displayHeight !== this.lastLayoutHeight ||
-      this.lastLayoutModelId !== this.circuitModel.gates.size;
-
-    if (needsLayoutRecalc && this.displayWidth > 0 && this.displayHeight > 0) {
-      this.layout.calculate(this.circuitModel, this.displayWidth, this.displayHeight);
-      this.lastLayoutWidth = this.displayWidth;
-      this.lastLayoutHeight = this.displayHeight;
-      this.lastLayoutModelId = this.circuitModel.gates.size;
-
-      // Update content bounds for pan clamping (Story 6.7)
-      const bounds = this.layout.getBounds();
-      if (bounds && bounds.width > 0 && bounds.height > 0) {
-        this.zoomController.setContentBounds(bounds.width, bounds.height);
-      }
+  /**
+   * Update content bounds for pan clamping (Story 6.7).
+   * @param bounds - Laid-out circuit size, or null if empty
+   * @private
+   */
+  private applyContentBounds(bounds: { width: number; height: number } | null): void {
+    if (bounds && bounds.width > 0 && bounds.height > 0) {
+      this.zoomController.setContentBounds(bounds.width, bounds.height);
     }
   }
 
   /**
-   * Render all wires in the circuit.
-   * Wires are rendered before gates so gates appear on top.
-   * Uses interpolated wire states during animation.
+   * Laid-out circuit size, from the scene or as last reported by the worker.
    * @private
    */
-  private renderWires(): void {
-    if (!this.ctx || !this.circuitModel || !this.layout) return;
+  private getContentBounds(): { width: number; height: number } | null {
+    if (this.renderWorker) return this.workerContentBounds;
+    return this.scene.getLayout()?.getBounds() ?? null;
+  }
+
+  // ============================================================================
+  // Render Worker
+  // ============================================================================
 
-    // Lazily create wire renderer on first use
-    if (!this.wireRenderer) {
-      this.wireRenderer = new WireRenderer();
+  /**
+   * Transfer the canvas to a render worker, if enabled and supported.
+   * @param canvas - The freshly created canvas
+   * @returns True if the worker now owns the canvas
+   * @private
+   */
+  private startRenderWorker(canvas: HTMLCanvasElement): boolean {
+    if (
+      !this.options.renderInWorker ||
+      typeof Worker === 'undefined' ||
+      typeof canvas.transferControlToOffscreen !== 'function'
+    ) {
+      return false;
     }
 
-    // Render each wire at its calculated positions
-    for (const wire of this.circuitModel.wires.values()) {
-      const wirePosition = this.layout.getWirePosition(wire.id);
-      if (!wirePosition) continue;
-
-      const isMultiBit = wire.width > 1;
-
-      // Use interpolated states during animation, otherwise use actual wire state
-      const wireState =
-        this.interpolatedWireStates?.get(wire.id) ?? wire.state;
-
-      // Render each segment of the wire
-      for (const segment of wirePosition.segments) {
-        // Get the signal value for this bit
-        const signalValue = wireState[segment.bitIndex] ?? 2; // Default to unknown
-
-        // Check if this wire segment is highlighted for signal path (Story 6.9)
-        const isPathHighlight = this.isWireSegmentHighlighted(wire.id, segment.bitIndex);
-
-        this.wireRenderer.renderWire(
-          this.ctx,
-          signalValue,
-          segment.startX,
-          segment.startY,
-          segment.endX,
-          segment.endY,
-          isMultiBit,
-          isPathHighlight
-        );
-      }
+    try {
+      this.renderWorker = new Worker(new URL('./circuitRender.worker.ts', import.meta.url), {
+        type: 'module',
+      });
+    } catch {
+      // Worker creation can fail (e.g., CSP); draw on this thread instead
+      this.renderWorker = null;
+      return false;
     }
+
+    this.boundWorkerMessageHandler = this.handleWorkerMessage.bind(this);
+    this.renderWorker.addEventListener('message', this.boundWorkerMessageHandler);
+
+    const offscreen = canvas.transferControlToOffscreen();
+    this.postToRenderWorker(
+      { type: 'INIT', payload: { canvas: offscreen, theme: captureThemeVars(CIRCUIT_THEME_VARS) } },
+      [offscreen]
+    );
+    return true;
   }
 
   /**
-   * Render all gates in the circuit.
-   * Gates are positioned by CircuitLayout and drawn by GateRenderer.
-   * Layout calculation is handled by ensureLayoutCalculated().
-   * Applies pulse effect during animation for gates with changed outputs.
-   * Applies hover highlight for the currently hovered gate (Story 6.8).
+   * Post a command to the render worker.
    * @private
    */
-  private renderGates(): void {
-    if (!this.ctx || !this.circuitModel || !this.layout) return;
+  private postToRenderWorker(command: RenderWorkerCommand, transfer: Transferable[] = []): void {
+    this.renderWorker?.postMessage(command, transfer);
+  }
 
-    // Lazily create gate renderer on first use
-    if (!this.gateRenderer) {
-      this.gateRenderer = new GateRenderer();
+  /**
+   * Handle events from the render worker.
+   * @private
+   */
+  private handleWorkerMessage(e: MessageEvent): void {
+    const event = e.data as RenderWorkerEvent | null;
+    if (!event) return;
+
+    switch (event.type) {
+      case 'LAYOUT_CHANGED': {
+        this.workerContentBounds = event.payload.bounds;
+        const offset = this.zoomController.getOffset();
+        this.applyContentBounds(event.payload.bounds);
+        // Clamping may have moved the view
+        const clamped = this.zoomController.getOffset();
+        if (clamped.x !== offset.x || clamped.y !== offset.y) {
+          this.render();
+        }
+        this.updatePanCursor();
+        break;
+      }
+      case 'FRAME_COMPLETE': {
+        this.options.onRenderComplete?.();
+        break;
+      }
+      case 'HIT_RESULT': {
+        const callback = this.hitTestCallbacks.get(event.payload.requestId);
+        this.hitTestCallbacks.delete(event.payload.requestId);
+        callback?.(event.payload.gateId);
+        break;
+      }
     }
+  }
 
-    // Get gate dimensions from layout config
-    const layoutConfig = this.layout.getConfig();
-
-    // Check if gate pulse is enabled
-    const enablePulse = this.options.animation?.enableGatePulse !== false;
-
-    // Render each gate at its calculated position
-    for (const gate of this.circuitModel.gates.values()) {
-      const position = this.layout.getPosition(gate.id);
-      if (position) {
-        // Calculate pulse scale for animation
-        const isActive = enablePulse && this.changedGates.has(gate.id);
-        const pulseScale = calculatePulseScale(this.animationProgress, isActive);
-
-        // Check if this gate is hovered (Story 6.8)
-        const isHovered = this.hoveredGateId === gate.id;
-
-        // Check if this gate is highlighted for code-to-circuit linking (Story 6.9)
-        // Also include clicked gate for circuit-to-code linking (Story 6.10)
-        const isLinkedHighlight =
-          this.highlightedGateIds.has(gate.id) || this.clickedGateId === gate.id;
-
-        this.gateRenderer.renderGate(
-          this.ctx,
-          gate,
-          position.x,
-          position.y,
-          layoutConfig.gateWidth,
-          layoutConfig.gateHeight,
-          pulseScale,
-          isHovered,
-          isLinkedHighlight
-        );
-      }
+  /**
+   * Ask the render worker which gate is at a point.
+   * @param x - X coordinate in canvas space
+   * @param y - Y coordinate in canvas space
+   * @param callback - Receives the gate ID, or null for background
+   * @returns The request ID
+   * @private
+   */
+  private requestHitTest(x: number, y: number, callback: (gateId: number | null) => void): number {
+    const requestId = ++this.hitTestRequestId;
+    this.hitTestCallbacks.set(requestId, callback);
+    this.postToRenderWorker({ type: 'HIT_TEST', payload: { requestId, x, y } });
+    return requestId;
+  }
+
+  /**
+   * Check whether drawing happens in a render worker.
+   * @returns True if the canvas was transferred to a worker
+   */
+  isRenderingInWorker(): boolean {
+    return this.renderWorker !== null;
+  }
+
+  /**
+   * Feed emulator STATE_UPDATE events straight to the render worker.
+   * The other end of the channel goes to EmulatorBridge.connectCircuitPort().
+   * Afterwards updateState() and animateTransition() with the same circuit
+   * structure only refresh this thread's copy of the model (used for
+   * tooltips and getCircuitModel()); the worker maps state itself.
+   * @param port - Port receiving STATE_UPDATE events
+   * @returns False (and the port is closed) if not rendering in a worker
+   */
+  connectStatePort(port: MessagePort): boolean {
+    if (!this.renderWorker) {
+      port.close();
+      return false;
     }
+    this.postToRenderWorker({ type: 'CONNECT_STATE_PORT', payload: { port } }, [port]);
+    this.statePortConnected = true;
+    return true;
+  }
+
+  /**
+   * Re-send theme colors to the render worker after a theme switch.
+   * On this thread colors are read while drawing, so only a re-render is needed.
+   */
+  refreshTheme(): void {
+    this.postToRenderWorker({
+      type: 'SET_THEME',
+      payload: { theme: captureThemeVars(CIRCUIT_THEME_VARS) },
+    });
+    this.render();
   }
 
   /**
@@ -837,9 +895,7 @@ export class CircuitRenderer {
   updateState(state: CircuitRendererState): void {
     // Update circuit model if circuit data is provided
     if (state.circuitData) {
-      this.circuitModel = new CircuitModel(state.circuitData);
-      // Invalidate layout cache when circuit data changes
-      this.lastLayoutModelId = 0;
+      this.setCircuitModel(state.circuitData);
     }
 
     // Clear animation state for immediate update
@@ -851,18 +907,49 @@ export class CircuitRenderer {
     this.render();
   }
 
+  /**
+   * Replace the circuit model. The layout (and with it the retained frame)
+   * is only invalidated when the structure changed; a state-only update
+   * keeps both so just the changed wires are redrawn.
+   * With a render worker the data is forwarded, unless only wire states
+   * changed and the worker already gets those from the emulator.
+   * @param circuitData - The new circuit data
+   * @private
+   */
+  private setCircuitModel(circuitData: CircuitData): void {
+    // Data mapped from emulator state reuses its source model's indexes
+    const model = CircuitModel.fromData(circuitData);
+    if (!this.renderWorker) {
+      this.circuitModel = model;
+      this.scene.setModel(model);
+      return;
+    }
+
+    const structureChanged = !this.circuitModel || !this.circuitModel.hasSameStructure(model);
+    this.circuitModel = model;
+    if (structureChanged) {
+      this.workerContentBounds = null;
+    }
+    if (structureChanged || !this.statePortConnected) {
+      this.postToRenderWorker({ type: 'LOAD_CIRCUIT', payload: { circuitData } });
+    }
+  }
+
   /**
    * Animate transition from current state to new circuit data.
    * Provides smooth visual transition with wire color interpolation and gate pulse effects.
    * Respects user's reduced motion preference.
    * @param newData - The new circuit data to transition to
+   * @param activeGates - Gate IDs to pulse, when known in advance (see
+   *   InstructionActivationIndex); otherwise gates with changed outputs pulse
    */
-  animateTransition(newData: CircuitData): void {
+  animateTransition(newData: CircuitData, activeGates?: ReadonlySet<number>): void {
     // Check if animation is enabled
     const enableAnimation = this.options.animation?.enableAnimation !== false;
 
-    // Skip animation if disabled or user prefers reduced motion
-    if (!enableAnimation || prefersReducedMotion()) {
+    // Skip animation if disabled or user prefers reduced motion; the render
+    // worker may be drawing states this thread has not seen, so it never animates
+    if (!enableAnimation || prefersReducedMotion() || this.renderWorker) {
       this.updateState({ circuitData: newData });
       return;
     }
@@ -891,11 +978,10 @@ export class CircuitRenderer {
     }
 
     // Update to new circuit model
-    this.circuitModel = new CircuitModel(newData);
-    this.lastLayoutModelId = 0; // Invalidate layout cache
+    this.setCircuitModel(newData);
 
     // Set target state and get changed gates
-    this.signalAnimator.setTargetState(this.circuitModel);
+    this.signalAnimator.setTargetState(this.circuitModel, activeGates);
     this.changedGates = this.signalAnimator.getChangedGates();
 
     // If no changes, skip animation
@@ -968,7 +1054,7 @@ export class CircuitRenderer {
 
   /**
    * Get the 2D rendering context.
-   * @returns The canvas 2D context or null if not mounted
+   * @returns The canvas 2D context, or null if not mounted or rendering in a worker
    */
   getContext(): CanvasRenderingContext2D | null {
     return this.ctx;
@@ -1013,7 +1099,7 @@ export class CircuitRenderer {
     const oldScale = this.zoomController.getScale();
     this.zoomController.setScale(scale);
     // Only re-render if zoom actually changed and we're mounted
-    if (this.ctx && this.zoomController.getScale() !== oldScale) {
+    if (this.canvas && this.zoomController.getScale() !== oldScale) {
       // Update cursor state since pan availability may change (Story 6.7)
       this.updatePanCursor();
       this.render();
@@ -1035,12 +1121,12 @@ export class CircuitRenderer {
    * @returns The calculated zoom scale
    */
   zoomToFit(): number {
-    if (!this.circuitModel || !this.layout) {
+    if (!this.circuitModel) {
       return 1.0;
     }
 
     // Calculate circuit bounds from layout
-    const bounds = this.layout.getBounds();
+    const bounds = this.getContentBounds();
     if (!bounds || bounds.width <= 0 || bounds.height <= 0) {
       return 1.0;
     }
@@ -1251,6 +1337,20 @@ export class CircuitRenderer {
       this.canvas.parentNode.removeChild(this.canvas);
     }
 
+    // Stop the render worker; it owns the transferred canvas
+    if (this.renderWorker) {
+      if (this.boundWorkerMessageHandler) {
+        this.renderWorker.removeEventListener('message', this.boundWorkerMessageHandler);
+        this.boundWorkerMessageHandler = null;
+      }
+      this.renderWorker.terminate();
+      this.renderWorker = null;
+    }
+    this.hitTestCallbacks.clear();
+    this.hoverRequestId = 0;
+    this.workerContentBounds = null;
+    this.statePortConnected = false;
+
     // Clear references
     this.canvas = null;
     this.ctx = null;
@@ -1258,15 +1358,8 @@ export class CircuitRenderer {
     this.circuitModel = null;
     this.loader = null;
 
-    // Clean up gate rendering (Story 6.3)
-    this.gateRenderer = null;
-    if (this.layout) {
-      this.layout.clear();
-      this.layout = null;
-    }
-
-    // Clean up wire rendering (Story 6.4)
-    this.wireRenderer = null;
+    // Clean up layout, gate and wire rendering, and the retained frame (Story 6.3, 6.4)
+    this.scene.clear();
 
     // Clean up animation (Story 6.5)
     if (this.animationController) {
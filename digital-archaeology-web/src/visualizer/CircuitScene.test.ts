@@ -0,0 +1,194 @@
+// src/visualizer/CircuitScene.test.ts
+// Unit tests for CircuitScene
+
+import { describe, it, expect, beforeEach, vi } from 'vitest';
+import { CircuitScene, createSceneAppearance } from './CircuitScene';
+import type { SceneAppearance, SceneCanvas, SceneView } from './CircuitScene';
+import { CircuitModel } from './CircuitModel';
+import type { CircuitData } from './types';
+
+// AND -> w0 -> OR -> w1 -> NOT, laid out left to right in one row
+const createChainData = (w0: number, w1: number, lastType: 'NOT' | 'BUF' = 'NOT'): CircuitData => ({
+  cycle: 0,
+  stable: true,
+  wires: [
+    { id: 0, name: 'w0', width: 1, is_input: false, is_output: false, state: [w0] },
+    { id: 1, name: 'w1', width: 1, is_input: false, is_output: false, state: [w1] },
+  ],
+  gates: [
+    { id: 0, name: 'AND0', type: 'AND', inputs: [], outputs: [{ wire: 0, bit: 0 }] },
+    { id: 1, name: 'OR1', type: 'OR', inputs: [{ wire: 0, bit: 0 }], outputs: [{ wire: 1, bit: 0 }] },
+    { id: 2, name: `${lastType}2`, type: lastType, inputs: [{ wire: 1, bit: 0 }], outputs: [] },
+  ],
+});
+
+const VIEW: SceneView = { width: 800, height: 600, dpr: 1, scale: 1, offsetX: 0, offsetY: 0 };
+const BG = '#000000';
+
+describe('CircuitScene', () => {
+  let scene: CircuitScene;
+  let ctx: CanvasRenderingContext2D;
+  let canvas: SceneCanvas;
+  let mockFillText: ReturnType<typeof vi.fn>;
+  let mockClip: ReturnType<typeof vi.fn>;
+
+  const drawnLabels = (): string[] => mockFillText.mock.calls.map((call) => call[0] as string);
+
+  const createContext = (retainFrames: boolean): CanvasRenderingContext2D => {
+    mockFillText = vi.fn();
+    mockClip = vi.fn();
+    const base = {
+      fillRect: vi.fn(),
+      scale: vi.fn(),
+      setTransform: vi.fn(),
+      translate: vi.fn(),
+      fillStyle: '',
+      strokeStyle: '',
+      lineWidth: 0,
+      beginPath: vi.fn(),
+      moveTo: vi.fn(),
+      lineTo: vi.fn(),
+      stroke: vi.fn(),
+      roundRect: vi.fn(),
+      fill: vi.fn(),
+      fillText: mockFillText,
+      font: '',
+      save: vi.fn(),
+      restore: vi.fn(),
+      shadowBlur: 0,
+      shadowColor: '',
+    };
+    const retain = { rect: vi.fn(), clip: mockClip, drawImage: vi.fn() };
+    return (retainFrames ? { ...base, ...retain } : base) as unknown as CanvasRenderingContext2D;
+  };
+
+  const draw = (appearance: SceneAppearance = createSceneAppearance()): void => {
+    scene.updateLayout(VIEW.width, VIEW.height);
+    scene.draw(ctx, canvas, VIEW, appearance, BG);
+  };
+
+  beforeEach(() => {
+    scene = new CircuitScene();
+    ctx = createContext(true);
+    canvas = { width: 800, height: 600 } as SceneCanvas;
+    scene.attach(ctx);
+  });
+
+  describe('setModel()', () => {
+    it('should report structure changes only', () => {
+      expect(scene.setModel(new CircuitModel(createChainData(0, 0)))).toBe(true);
+      expect(scene.setModel(new CircuitModel(createChainData(1, 0)))).toBe(false);
+      expect(scene.setModel(new CircuitModel(createChainData(1, 0, 'BUF')))).toBe(true);
+      expect(scene.setModel(null)).toBe(true);
+    });
+  });
+
+  describe('updateLayout()', () => {
+    it('should recalculate only when the structure or size changes', () => {
+      scene.setModel(new CircuitModel(createChainData(0, 0)));
+
+      expect(scene.updateLayout(800, 600)).toBe(true);
+      expect(scene.updateLayout(800, 600)).toBe(false);
+
+      scene.setModel(new CircuitModel(createChainData(1, 1)));
+      expect(scene.updateLayout(800, 600)).toBe(false);
+
+      scene.setModel(new CircuitModel(createChainData(1, 1, 'BUF')));
+      expect(scene.updateLayout(800, 600)).toBe(true);
+      expect(scene.updateLayout(1024, 600)).toBe(true);
+    });
+
+    it('should not lay out without a model or a size', () => {
+      expect(scene.updateLayout(800, 600)).toBe(false);
+
+      scene.setModel(new CircuitModel(createChainData(0, 0)));
+      expect(scene.updateLayout(0, 0)).toBe(false);
+      expect(scene.getLayout()?.getBounds()).toBeNull();
+    });
+  });
+
+  describe('draw()', () => {
+    beforeEach(() => {
+      scene.setModel(new CircuitModel(createChainData(0, 0)));
+    });
+
+    it('should draw every gate on the first frame', () => {
+      draw();
+
+      expect(drawnLabels()).toEqual(['AND', 'OR', 'NOT']);
+    });
+
+    it('should draw nothing for an unchanged frame', () => {
+      draw();
+      mockFillText.mockClear();
+
+      draw();
+
+      expect(drawnLabels()).toEqual([]);
+      expect(mockClip).not.toHaveBeenCalled();
+    });
+
+    it('should redraw only around elements whose appearance changed', () => {
+      draw();
+      mockFillText.mockClear();
+
+      draw({ ...createSceneAppearance(), hoveredGateId: 2 });
+
+      expect(mockClip).toHaveBeenCalledTimes(1);
+      expect(drawnLabels()).toContain('NOT');
+      expect(drawnLabels()).not.toContain('AND');
+    });
+
+    it('should redraw fully after the frame is invalidated', () => {
+      draw();
+      mockFillText.mockClear();
+
+      scene.invalidateFrame();
+      draw();
+
+      expect(drawnLabels()).toEqual(['AND', 'OR', 'NOT']);
+      expect(mockClip).not.toHaveBeenCalled();
+    });
+
+    it('should redraw fully every frame on contexts that cannot retain frames', () => {
+      ctx = createContext(false);
+      scene.attach(ctx);
+      draw();
+      mockFillText.mockClear();
+
+      draw();
+
+      expect(drawnLabels()).toEqual(['AND', 'OR', 'NOT']);
+    });
+  });
+
+  describe('hitTestGate()', () => {
+    it('should find the gate at a layout position', () => {
+      scene.setModel(new CircuitModel(createChainData(0, 0)));
+      scene.updateLayout(800, 600);
+
+      const pos = scene.getLayout()!.getPosition(1)!;
+
+      expect(scene.hitTestGate(pos.x + 1, pos.y + 1)?.name).toBe('OR1');
+      expect(scene.hitTestGate(-100, -100)).toBeNull();
+    });
+
+    it('should return null before a layout exists', () => {
+      scene.setModel(new CircuitModel(createChainData(0, 0)));
+
+      expect(scene.hitTestGate(0, 0)).toBeNull();
+    });
+  });
+
+  describe('clear()', () => {
+    it('should drop the model and layout', () => {
+      scene.setModel(new CircuitModel(createChainData(0, 0)));
+      scene.updateLayout(800, 600);
+
+      scene.clear();
+
+      expect(scene.getModel()).toBeNull();
+      expect(scene.getLayout()).toBeNull();
+    });
+  });
+});
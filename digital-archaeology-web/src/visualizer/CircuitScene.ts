@@ -0,0 +1,811 @@
+// src/visualizer/CircuitScene.ts
+// DOM-free circuit layout and drawing, shared by CircuitRenderer and its render worker
+// Viewport culling and dirty-region redraws keep large circuits at frame rate
+
+import type { CircuitGate } from './types';
+import type { CircuitModel } from './CircuitModel';
+import { CircuitLayout } from './CircuitLayout';
+import { GateRenderer } from './GateRenderer';
+import { WireRenderer } from './WireRenderer';
+import { calculatePulseScale } from './animationUtils';
+import { GATE_COLOR_VARS, GATE_STYLE_VARS } from './gateColors';
+import { WIRE_COLOR_VARS } from './wireColors';
+import { readThemeVar } from './themeVars';
+import type { Rect } from './SpatialIndex';
+
+/**
+ * Default background color matching --da-bg-primary in Lab Mode.
+ * Used as fallback when CSS variable is not available (e.g., in tests).
+ * This constant mirrors the CSS variable to maintain single source of truth in CSS.
+ */
+export const DEFAULT_BG_PRIMARY = '#1a1a2e';
+
+/**
+ * Theme variables read while drawing the circuit.
+ * A render worker has no document, so the main thread captures these
+ * and sends them over as a snapshot.
+ */
+export const CIRCUIT_THEME_VARS: readonly string[] = [
+  '--da-bg-primary',
+  '--da-accent',
+  '--da-link-highlight',
+  '--da-gate-pulse-scale',
+  ...Object.values(GATE_COLOR_VARS),
+  ...Object.values(GATE_STYLE_VARS),
+  ...Object.values(WIRE_COLOR_VARS),
+];
+
+/**
+ * How far a wire or gate may paint outside its layout bounds.
+ * Layout margins cover line width and pulse growth and scale with zoom;
+ * screen margins cover shadow blur, which does not.
+ */
+const WIRE_PAINT_MARGIN = 4;
+const GATE_PAINT_MARGIN = 16;
+const SHADOW_PAINT_MARGIN_PX = 16;
+
+/**
+ * Above this many dirty regions, or this fraction of the viewport,
+ * a full redraw is cheaper than clipping region by region.
+ */
+const MAX_DIRTY_REGIONS = 256;
+const MAX_DIRTY_AREA_FRACTION = 0.5;
+
+/** Canvas the scene draws into: on-page, or transferred to a worker */
+export type SceneCanvas = HTMLCanvasElement | OffscreenCanvas;
+
+/** Offscreen bitmap used to scroll the retained frame when panning */
+type FrameBuffer = OffscreenCanvas | HTMLCanvasElement;
+type FrameBufferContext = OffscreenCanvasRenderingContext2D | CanvasRenderingContext2D;
+
+/**
+ * Size and transform of the view being drawn.
+ */
+export interface SceneView {
+  /** Display width in CSS pixels */
+  width: number;
+  /** Display height in CSS pixels */
+  height: number;
+  /** Device pixel ratio */
+  dpr: number;
+  /** Zoom scale */
+  scale: number;
+  /** Pan offset in CSS pixels */
+  offsetX: number;
+  /** Pan offset in CSS pixels */
+  offsetY: number;
+}
+
+/**
+ * Per-frame interaction and animation state that changes how elements look.
+ * Plain data, so it can be posted to a render worker as-is.
+ */
+export interface SceneAppearance {
+  /** Gate under the pointer (Story 6.8) */
+  hoveredGateId: number | null;
+  /** Gate clicked for circuit-to-code linking (Story 6.10) */
+  clickedGateId: number | null;
+  /** Gates highlighted for code-to-circuit linking (Story 6.9) */
+  highlightedGateIds: ReadonlySet<number>;
+  /** [wireId, bitIndex] pairs on the highlighted signal path (Story 6.9) */
+  highlightedWireSegments: number[][] | null;
+  /** Gates pulsing in the current transition (Story 6.5) */
+  changedGates: ReadonlySet<number>;
+  /** Transition progress, 1.0 when idle (Story 6.5) */
+  animationProgress: number;
+  /** Wire states interpolated for the current transition, if any */
+  interpolatedWireStates: ReadonlyMap<number, number[]> | null;
+  /** Whether changed gates pulse */
+  enableGatePulse: boolean;
+}
+
+/**
+ * Appearance with nothing hovered, highlighted or animating.
+ */
+export function createSceneAppearance(): SceneAppearance {
+  return {
+    hoveredGateId: null,
+    clickedGateId: null,
+    highlightedGateIds: new Set(),
+    highlightedWireSegments: null,
+    changedGates: new Set(),
+    animationProgress: 1.0,
+    interpolatedWireStates: null,
+    enableGatePulse: true,
+  };
+}
+
+/**
+ * Get the theme background color from CSS custom properties.
+ * Falls back to DEFAULT_BG_PRIMARY if variable is unavailable.
+ * @returns The background color string
+ */
+export function getThemeBackground(): string {
+  return readThemeVar('--da-bg-primary') || DEFAULT_BG_PRIMARY;
+}
+
+/**
+ * CircuitScene owns a circuit's layout and draws it onto a 2D context.
+ * It keeps the last frame on the canvas and remembers each element's drawn
+ * style by layout slot, so unchanged views cost nothing and state changes
+ * repaint only the regions of the wires and gates that changed.
+ * It touches no DOM, so the same code runs on the page or in a worker.
+ */
+export class CircuitScene {
+  private model: CircuitModel | null = null;
+  private layout: CircuitLayout | null = null;
+  private gateRenderer: GateRenderer | null = null;
+  private wireRenderer: WireRenderer | null = null;
+
+  // Layout cache tracking - only recalculate when needed
+  private lastLayoutWidth: number = 0;
+  private lastLayoutHeight: number = 0;
+  private lastLayoutModelId: number = 0; // Tracks which circuit model was used
+  private layoutVersion: number = 0;
+
+  // Incremental rendering: the canvas keeps the last frame, and each element's
+  // drawn style is remembered by layout slot so only changed ones are redrawn
+  private canRetainFrame: boolean = false;
+  private frameKey: string = '';
+  private frameOffsetX: number = 0;
+  private frameOffsetY: number = 0;
+  private frameNumber: number = 0;
+  private segmentDrawnFrame: Uint32Array = new Uint32Array(0);
+  private segmentDrawnStyle: Float64Array = new Float64Array(0);
+  private gateDrawnFrame: Uint32Array = new Uint32Array(0);
+  private gateDrawnStyle: Float64Array = new Float64Array(0);
+  private frameBuffer: FrameBuffer | null = null;
+  private frameBufferCtx: FrameBufferContext | null = null;
+
+  // Inputs of the frame being drawn
+  private view: SceneView = { width: 0, height: 0, dpr: 1, scale: 1, offsetX: 0, offsetY: 0 };
+  private appearance: SceneAppearance = createSceneAppearance();
+
+  /**
+   * Decide whether frames can be retained on a context.
+   * Partial redraws need clipping and bitmap copies; contexts without
+   * them (minimal shims, test doubles) redraw the whole view every frame.
+   * @param ctx - The context the scene will draw into
+   */
+  attach(ctx: CanvasRenderingContext2D): void {
+    this.canRetainFrame = typeof ctx.clip === 'function' && typeof ctx.drawImage === 'function';
+    this.frameKey = '';
+  }
+
+  /**
+   * Replace the circuit model. The layout (and with it the retained frame)
+   * is only invalidated when the structure changed; a state-only update
+   * keeps both so just the changed wires are redrawn.
+   * @param model - The new circuit model, or null to clear
+   * @returns True if the structure changed
+   */
+  setModel(model: CircuitModel | null): boolean {
+    const structureChanged = !this.model || !model || !this.model.hasSameStructure(model);
+    if (structureChanged) {
+      // Invalidate layout cache when circuit structure changes
+      this.lastLayoutModelId = 0;
+    }
+    this.model = model;
+    return structureChanged;
+  }
+
+  /**
+   * Get the current circuit model.
+   * @returns The model or null if none is set
+   */
+  getModel(): CircuitModel | null {
+    return this.model;
+  }
+
+  /**
+   * Get the layout, once one has been calculated.
+   * @returns The layout or null
+   */
+  getLayout(): CircuitLayout | null {
+    return this.layout;
+  }
+
+  /**
+   * Ensure layout is calculated and up-to-date for a display size.
+   * Shared by both wire and gate rendering.
+   * @param width - Display width in CSS pixels
+   * @param height - Display height in CSS pixels
+   * @returns True if the layout was recalculated (content bounds may have changed)
+   */
+  updateLayout(width: number, height: number): boolean {
+    if (!this.model) return false;
+
+    // Lazily create layout on first use
+    if (!this.layout) {
+      this.layout = new CircuitLayout();
+    }
+
+    // Only recalculate layout when circuit or dimensions change
+    const needsLayoutRecalc =
+      width !== this.lastLayoutWidth ||
+      height !== this.lastLayoutHeight ||
+      this.lastLayoutModelId !== this.model.gates.size;
+
+    if (!needsLayoutRecalc || width <= 0 || height <= 0) return false;
+
+    this.layout.calculate(this.model, width, height);
+    this.lastLayoutWidth = width;
+    this.lastLayoutHeight = height;
+    this.lastLayoutModelId = this.model.gates.size;
+
+    // New slots invalidate the retained frame and the per-slot drawn styles
+    this.layoutVersion++;
+    this.segmentDrawnFrame = new Uint32Array(this.layout.segmentSlotCount);
+    this.segmentDrawnStyle = new Float64Array(this.layout.segmentSlotCount);
+    this.gateDrawnFrame = new Uint32Array(this.layout.gateSlotCount);
+    this.gateDrawnStyle = new Float64Array(this.layout.gateSlotCount);
+    return true;
+  }
+
+  /**
+   * Hit test against all gates to find one at the given layout coordinates (Story 6.8).
+   * @param x - X coordinate in layout space
+   * @param y - Y coordinate in layout space
+   * @returns The gate at the coordinates, or null if none
+   */
+  hitTestGate(x: number, y: number): CircuitGate | null {
+    if (!this.model || !this.layout) return null;
+
+    // Only gates in the point's grid cell are tested
+    const gateId = this.layout.gateAt(x, y);
+    return gateId === null ? null : this.model.getGate(gateId) ?? null;
+  }
+
+  /**
+   * Forget the retained frame, e.g. after the canvas was resized (which clears it).
+   */
+  invalidateFrame(): void {
+    this.frameKey = '';
+  }
+
+  /**
+   * Apply the view transform: device pixel ratio, zoom scale and pan offset.
+   * @param ctx - Context to transform
+   * @param view - The view
+   */
+  applyTransform(ctx: CanvasRenderingContext2D, view: SceneView): void {
+    const combinedScale = view.dpr * view.scale;
+
+    ctx.setTransform(1, 0, 0, 1, 0, 0); // Reset transform
+    // Apply offset BEFORE scaling so it's in screen coordinates (Story 6.7)
+    ctx.translate(view.offsetX * view.dpr, view.offsetY * view.dpr);
+    ctx.scale(combinedScale, combinedScale);
+  }
+
+  /**
+   * Draw a frame with theme background and circuit elements.
+   * Only elements intersecting the viewport are drawn. When the view is
+   * unchanged since the last frame, only regions around wires and gates
+   * whose drawn appearance changed are cleared and redrawn; a pan scrolls
+   * the previous frame and draws just the newly exposed strips.
+   * The layout must be current (see updateLayout()).
+   * @param ctx - Context to draw into
+   * @param canvas - The context's canvas
+   * @param view - Size and transform of the view
+   * @param appearance - Hover, highlight and animation state
+   * @param bgColor - Background color
+   */
+  draw(
+    ctx: CanvasRenderingContext2D,
+    canvas: SceneCanvas,
+    view: SceneView,
+    appearance: SceneAppearance,
+    bgColor: string
+  ): void {
+    this.view = view;
+    this.appearance = appearance;
+
+    // Apply canvas transform with current zoom (Story 6.6)
+    this.applyTransform(ctx, view);
+
+    const viewport = this.getViewportRect();
+
+    // The previous frame can be reused unless zoom, size, layout or theme changed
+    const frameKey = [
+      view.scale,
+      view.dpr,
+      view.width,
+      view.height,
+      this.layoutVersion,
+      bgColor,
+    ].join('|');
+    let fullRedraw = !this.canRetainFrame || frameKey !== this.frameKey;
+
+    // Pans reuse the previous frame shifted, leaving strips to redraw
+    const regions: Rect[] = [];
+    if (!fullRedraw && (view.offsetX !== this.frameOffsetX || view.offsetY !== this.frameOffsetY)) {
+      fullRedraw = !this.scrollFrame(
+        ctx,
+        canvas,
+        view.offsetX - this.frameOffsetX,
+        view.offsetY - this.frameOffsetY,
+        regions
+      );
+    }
+
+    // Diff what is visible now against what was drawn last frame
+    const prevFrame = this.frameNumber;
+    const frame = ++this.frameNumber;
+    const segmentSlots = this.queryVisibleSegments(viewport);
+    const gateSlots = this.queryVisibleGates(viewport);
+    if (this.model && this.layout) {
+      this.diffSegments(segmentSlots, prevFrame, frame, fullRedraw ? null : regions);
+      this.diffGates(gateSlots, prevFrame, frame, fullRedraw ? null : regions);
+    }
+
+    let visibleRegions: Rect[] = [];
+    if (!fullRedraw) {
+      // Long wires have long bounds; only their on-screen part needs redrawing
+      visibleRegions = regions
+        .map((r) => this.intersectRect(r, viewport))
+        .filter((r): r is Rect => r !== null);
+      let dirtyArea = 0;
+      for (const r of visibleRegions) dirtyArea += r.width * r.height;
+      fullRedraw =
+        visibleRegions.length > MAX_DIRTY_REGIONS ||
+        dirtyArea > viewport.width * viewport.height * MAX_DIRTY_AREA_FRACTION;
+    }
+
+    if (fullRedraw) {
+      // Clear canvas with theme background
+      // Note: fillRect coordinates are in transformed space, so the viewport rect
+      // accounts for both zoom and pan offset to fill the entire visible area (Story 6.7)
+      ctx.fillStyle = bgColor;
+      ctx.fillRect(viewport.x, viewport.y, viewport.width, viewport.height);
+
+      // Render wires BEFORE gates so gates appear on top (Story 6.4)
+      this.renderWires(ctx, segmentSlots);
+
+      // Render gates if circuit data is loaded (Story 6.3)
+      this.renderGates(ctx, gateSlots);
+    } else if (visibleRegions.length > 0) {
+      this.redrawRegions(ctx, visibleRegions, bgColor);
+    }
+
+    this.frameKey = frameKey;
+    this.frameOffsetX = view.offsetX;
+    this.frameOffsetY = view.offsetY;
+  }
+
+  /**
+   * Check if a wire segment is highlighted for signal path emphasis.
+   * @param wireId - The wire ID
+   * @param bitIndex - The bit index within the wire
+   * @returns True if the segment is highlighted
+   */
+  isWireSegmentHighlighted(wireId: number, bitIndex: number): boolean {
+    const segments = this.appearance.highlightedWireSegments;
+    if (!segments) return false;
+    return segments.some(([wId, bIdx]) => wId === wireId && bIdx === bitIndex);
+  }
+
+  /**
+   * Drop the model, layout and retained frame.
+   */
+  clear(): void {
+    this.model = null;
+    this.gateRenderer = null;
+    this.wireRenderer = null;
+    if (this.layout) {
+      this.layout.clear();
+      this.layout = null;
+    }
+    this.lastLayoutModelId = 0;
+    this.frameKey = '';
+    this.frameBuffer = null;
+    this.frameBufferCtx = null;
+    this.canRetainFrame = false;
+    this.appearance = createSceneAppearance();
+  }
+
+  /**
+   * Get the visible area in layout coordinates.
+   * Uses (0 - x) instead of -x to avoid JavaScript's -0 edge case.
+   * @returns The viewport rectangle
+   * @private
+   */
+  private getViewportRect(): Rect {
+    const { scale, offsetX, offsetY } = this.view;
+    return {
+      x: (0 - offsetX) / scale,
+      y: (0 - offsetY) / scale,
+      width: this.view.width / scale,
+      height: this.view.height / scale,
+    };
+  }
+
+  /**
+   * Grow a rectangle on every side.
+   * @private
+   */
+  private expandRect(rect: Rect, margin: number): Rect {
+    return {
+      x: rect.x - margin,
+      y: rect.y - margin,
+      width: rect.width + margin * 2,
+      height: rect.height + margin * 2,
+    };
+  }
+
+  /**
+   * Intersection of two rectangles.
+   * @returns The overlap, or null if they do not overlap
+   * @private
+   */
+  private intersectRect(a: Rect, b: Rect): Rect | null {
+    const x = Math.max(a.x, b.x);
+    const y = Math.max(a.y, b.y);
+    const right = Math.min(a.x + a.width, b.x + b.width);
+    const bottom = Math.min(a.y + a.height, b.y + b.height);
+    if (right <= x || bottom <= y) return null;
+    return { x, y, width: right - x, height: bottom - y };
+  }
+
+  /**
+   * Paint margins in layout units at the current zoom.
+   * @private
+   */
+  private getPaintMargins(): { wire: number; gate: number } {
+    const shadow = SHADOW_PAINT_MARGIN_PX / this.view.scale;
+    return { wire: WIRE_PAINT_MARGIN + shadow, gate: GATE_PAINT_MARGIN + shadow };
+  }
+
+  /**
+   * Wire segment slots that may paint inside a rectangle.
+   * @private
+   */
+  private queryVisibleSegments(rect: Rect): number[] {
+    if (!this.model || !this.layout) return [];
+    return this.layout.querySegments(this.expandRect(rect, this.getPaintMargins().wire));
+  }
+
+  /**
+   * Gate slots that may paint inside a rectangle.
+   * @private
+   */
+  private queryVisibleGates(rect: Rect): number[] {
+    if (!this.model || !this.layout) return [];
+    return this.layout.queryGates(this.expandRect(rect, this.getPaintMargins().gate));
+  }
+
+  /**
+   * Scroll the previous frame by a pan delta and record the exposed strips.
+   * Fractional device-pixel shifts would resample the bitmap, so those and
+   * deltas larger than the canvas fall back to a full redraw.
+   * @param ctx - Context being drawn
+   * @param canvas - The context's canvas
+   * @param dx - Pan delta in CSS pixels
+   * @param dy - Pan delta in CSS pixels
+   * @param regions - Receives the exposed strips in layout coordinates
+   * @returns False if the frame could not be scrolled
+   * @private
+   */
+  private scrollFrame(
+    ctx: CanvasRenderingContext2D,
+    canvas: SceneCanvas,
+    dx: number,
+    dy: number,
+    regions: Rect[]
+  ): boolean {
+    const { dpr, scale, offsetX, offsetY } = this.view;
+    const deviceWidth = canvas.width;
+    const deviceHeight = canvas.height;
+    const ddx = dx * dpr;
+    const ddy = dy * dpr;
+    if (
+      !Number.isInteger(ddx) ||
+      !Number.isInteger(ddy) ||
+      Math.abs(ddx) >= deviceWidth ||
+      Math.abs(ddy) >= deviceHeight
+    ) {
+      return false;
+    }
+
+    const buffer = this.getFrameBuffer(deviceWidth, deviceHeight);
+    const bufferCtx = this.frameBufferCtx;
+    if (!buffer || !bufferCtx) return false;
+
+    // The frame is opaque, so plain source-over copies replace every pixel
+    bufferCtx.setTransform(1, 0, 0, 1, 0, 0);
+    bufferCtx.drawImage(canvas, 0, 0);
+    ctx.save();
+    ctx.setTransform(1, 0, 0, 1, 0, 0);
+    ctx.drawImage(buffer, ddx, ddy);
+    ctx.restore();
+
+    // Strips uncovered by the shift, as device-pixel rects
+    const strips: Array<[number, number, number, number]> = [];
+    if (ddx > 0) strips.push([0, 0, ddx, deviceHeight]);
+    if (ddx < 0) strips.push([deviceWidth + ddx, 0, -ddx, deviceHeight]);
+    if (ddy > 0) strips.push([0, 0, deviceWidth, ddy]);
+    if (ddy < 0) strips.push([0, deviceHeight + ddy, deviceWidth, -ddy]);
+
+    for (const [x, y, w, h] of strips) {
+      regions.push({
+        x: (x / dpr - offsetX) / scale,
+        y: (y / dpr - offsetY) / scale,
+        width: w / dpr / scale,
+        height: h / dpr / scale,
+      });
+    }
+    return true;
+  }
+
+  /**
+   * Get (or resize) the offscreen bitmap used for scrolling.
+   * @returns The buffer, or null if neither OffscreenCanvas nor a document is available
+   * @private
+   */
+  private getFrameBuffer(width: number, height: number): FrameBuffer | null {
+    if (!this.frameBuffer) {
+      if (typeof OffscreenCanvas !== 'undefined') {
+        const buffer = new OffscreenCanvas(width, height);
+        this.frameBufferCtx = buffer.getContext('2d');
+        this.frameBuffer = buffer;
+      } else if (typeof document !== 'undefined') {
+        const buffer = document.createElement('canvas');
+        this.frameBufferCtx = buffer.getContext('2d');
+        this.frameBuffer = buffer;
+      } else {
+        return null;
+      }
+    }
+    if (this.frameBuffer.width !== width || this.frameBuffer.height !== height) {
+      this.frameBuffer.width = width;
+      this.frameBuffer.height = height;
+    }
+    return this.frameBuffer;
+  }
+
+  /**
+   * Drawn style of a wire segment: signal value plus path highlight.
+   * @private
+   */
+  private getSegmentStyle(wireId: number, bitIndex: number, state: number[]): number {
+    const value = state[bitIndex];
+    const signal = value === 0 || value === 1 ? value : 2;
+    return signal + (this.isWireSegmentHighlighted(wireId, bitIndex) ? 4 : 0);
+  }
+
+  /**
+   * Drawn style of a gate: pulse scale plus hover and link highlight flags.
+   * @private
+   */
+  private getGateStyle(gateId: number): number {
+    const { pulseScale, isHovered, isLinkedHighlight } = this.getGateLook(gateId);
+    return pulseScale + (isHovered ? 16 : 0) + (isLinkedHighlight ? 32 : 0);
+  }
+
+  /**
+   * Pulse scale and highlight flags a gate is drawn with.
+   * @private
+   */
+  private getGateLook(gateId: number): { pulseScale: number; isHovered: boolean; isLinkedHighlight: boolean } {
+    const appearance = this.appearance;
+
+    // Calculate pulse scale for animation
+    const isActive = appearance.enableGatePulse && appearance.changedGates.has(gateId);
+    const pulseScale = calculatePulseScale(appearance.animationProgress, isActive);
+
+    // Check if this gate is hovered (Story 6.8)
+    const isHovered = appearance.hoveredGateId === gateId;
+
+    // Check if this gate is highlighted for code-to-circuit linking (Story 6.9)
+    // Also include clicked gate for circuit-to-code linking (Story 6.10)
+    const isLinkedHighlight =
+      appearance.highlightedGateIds.has(gateId) || appearance.clickedGateId === gateId;
+
+    return { pulseScale, isHovered, isLinkedHighlight };
+  }
+
+  /**
+   * Record the style of each visible segment for this frame, adding a dirty
+   * region for each one that was visible last frame with a different style.
+   * @param slots - Visible segment slots
+   * @param prevFrame - Previous frame number
+   * @param frame - Current frame number
+   * @param regions - Dirty regions to append to, or null on a full redraw
+   * @private
+   */
+  private diffSegments(slots: number[], prevFrame: number, frame: number, regions: Rect[] | null): void {
+    const layout = this.layout!;
+    const model = this.model!;
+    const margin = this.getPaintMargins().wire;
+
+    for (const slot of slots) {
+      const { wireId, segment } = layout.getSegmentAt(slot);
+      const wire = model.getWire(wireId);
+      const state = this.appearance.interpolatedWireStates?.get(wireId) ?? wire?.state ?? [];
+      const style = this.getSegmentStyle(wireId, segment.bitIndex, state);
+
+      if (
+        regions &&
+        this.segmentDrawnFrame[slot] === prevFrame &&
+        this.segmentDrawnStyle[slot] !== style
+      ) {
+        const x = Math.min(segment.startX, segment.endX);
+        const y = Math.min(segment.startY, segment.endY);
+        regions.push(
+          this.expandRect(
+            { x, y, width: Math.abs(segment.endX - segment.startX), height: Math.abs(segment.endY - segment.startY) },
+            margin
+          )
+        );
+      }
+      this.segmentDrawnFrame[slot] = frame;
+      this.segmentDrawnStyle[slot] = style;
+    }
+  }
+
+  /**
+   * Record the style of each visible gate for this frame, adding a dirty
+   * region for each one that was visible last frame with a different style.
+   * @param slots - Visible gate slots
+   * @param prevFrame - Previous frame number
+   * @param frame - Current frame number
+   * @param regions - Dirty regions to append to, or null on a full redraw
+   * @private
+   */
+  private diffGates(slots: number[], prevFrame: number, frame: number, regions: Rect[] | null): void {
+    const layout = this.layout!;
+    const { gateWidth, gateHeight } = layout.getConfig();
+    const margin = this.getPaintMargins().gate;
+
+    for (const slot of slots) {
+      const gateId = layout.getGateIdAt(slot);
+      const style = this.getGateStyle(gateId);
+
+      if (regions && this.gateDrawnFrame[slot] === prevFrame && this.gateDrawnStyle[slot] !== style) {
+        const pos = layout.getPosition(gateId);
+        if (pos) {
+          regions.push(this.expandRect({ x: pos.x, y: pos.y, width: gateWidth, height: gateHeight }, margin));
+        }
+      }
+      this.gateDrawnFrame[slot] = frame;
+      this.gateDrawnStyle[slot] = style;
+    }
+  }
+
+  /**
+   * Clear and redraw the given regions, clipped so pixels outside them are
+   * untouched. Regions are snapped outward to device pixels so the clip
+   * edges do not antialias against the retained frame.
+   * @param ctx - Context being drawn
+   * @param regions - Dirty regions in layout coordinates
+   * @param bgColor - Background color
+   * @private
+   */
+  private redrawRegions(ctx: CanvasRenderingContext2D, regions: Rect[], bgColor: string): void {
+    const { dpr, scale: zoom, offsetX, offsetY } = this.view;
+    const toDevice = dpr * zoom;
+
+    const snapped = regions.map((r) => {
+      const x0 = Math.floor((r.x * zoom + offsetX) * dpr);
+      const y0 = Math.floor((r.y * zoom + offsetY) * dpr);
+      const x1 = Math.ceil(((r.x + r.width) * zoom + offsetX) * dpr);
+      const y1 = Math.ceil(((r.y + r.height) * zoom + offsetY) * dpr);
+      return {
+        x: (x0 / dpr - offsetX) / zoom,
+        y: (y0 / dpr - offsetY) / zoom,
+        width: (x1 - x0) / toDevice,
+        height: (y1 - y0) / toDevice,
+      };
+    });
+
+    // Everything painting into any region, merged back into render order
+    const segmentSet = new Set<number>();
+    const gateSet = new Set<number>();
+    for (const r of snapped) {
+      for (const slot of this.queryVisibleSegments(r)) segmentSet.add(slot);
+      for (const slot of this.queryVisibleGates(r)) gateSet.add(slot);
+    }
+    const byOrder = (a: number, b: number): number => a - b;
+
+    ctx.save();
+    ctx.beginPath();
+    for (const r of snapped) {
+      ctx.rect(r.x, r.y, r.width, r.height);
+    }
+    ctx.clip();
+
+    ctx.fillStyle = bgColor;
+    for (const r of snapped) {
+      ctx.fillRect(r.x, r.y, r.width, r.height);
+    }
+    this.renderWires(ctx, [...segmentSet].sort(byOrder));
+    this.renderGates(ctx, [...gateSet].sort(byOrder));
+    ctx.restore();
+  }
+
+  /**
+   * Render wire segments, given as layout slots in render order.
+   * Wires are rendered before gates so gates appear on top.
+   * Uses interpolated wire states during animation.
+   * @param ctx - Context being drawn
+   * @param slots - Segment slots from the layout's spatial index
+   * @private
+   */
+  private renderWires(ctx: CanvasRenderingContext2D, slots: number[]): void {
+    if (!this.model || !this.layout) return;
+
+    // Lazily create wire renderer on first use
+    if (!this.wireRenderer) {
+      this.wireRenderer = new WireRenderer();
+    }
+
+    for (const slot of slots) {
+      const { wireId, width, segment } = this.layout.getSegmentAt(slot);
+      const wire = this.model.getWire(wireId);
+      if (!wire) continue;
+
+      const isMultiBit = width > 1;
+
+      // Use interpolated states during animation, otherwise use actual wire state
+      const wireState = this.appearance.interpolatedWireStates?.get(wireId) ?? wire.state;
+
+      // Get the signal value for this bit
+      const signalValue = wireState[segment.bitIndex] ?? 2; // Default to unknown
+
+      // Check if this wire segment is highlighted for signal path (Story 6.9)
+      const isPathHighlight = this.isWireSegmentHighlighted(wireId, segment.bitIndex);
+
+      this.wireRenderer.renderWire(
+        ctx,
+        signalValue,
+        segment.startX,
+        segment.startY,
+        segment.endX,
+        segment.endY,
+        isMultiBit,
+        isPathHighlight
+      );
+    }
+  }
+
+  /**
+   * Render gates, given as layout slots in render order.
+   * Gates are positioned by CircuitLayout and drawn by GateRenderer.
+   * Applies pulse effect during animation for gates with changed outputs,
+   * and hover and link highlights (Story 6.8, 6.9, 6.10).
+   * @param ctx - Context being drawn
+   * @param slots - Gate slots from the layout's spatial index
+   * @private
+   */
+  private renderGates(ctx: CanvasRenderingContext2D, slots: number[]): void {
+    if (!this.model || !this.layout) return;
+
+    // Lazily create gate renderer on first use
+    if (!this.gateRenderer) {
+      this.gateRenderer = new GateRenderer();
+    }
+
+    // Get gate dimensions from layout config
+    const layoutConfig = this.layout.getConfig();
+
+    for (const slot of slots) {
+      const gateId = this.layout.getGateIdAt(slot);
+      const gate = this.model.getGate(gateId);
+      const position = this.layout.getPosition(gateId);
+      if (!gate || !position) continue;
+
+      const { pulseScale, isHovered, isLinkedHighlight } = this.getGateLook(gate.id);
+
+      this.gateRenderer.renderGate(
+        ctx,
+        gate,
+        position.x,
+        position.y,
+        layoutConfig.gateWidth,
+        layoutConfig.gateHeight,
+        pulseScale,
+        isHovered,
+        isLinkedHighlight
+      );
+    }
+  }
+}
@@ -4,6 +4,7 @@
 import type { CircuitGate } from './types';
 import { getGateColor, getGateBorderColor, getGateTextColor } from './gateColors';
 import { getLinkHighlightColor } from './highlightColors';
+import { readThemeVar } from './themeVars';
 
 /**
  * Default hover highlight color (--da-accent fallback).
@@ -16,9 +17,7 @@ const DEFAULT_HOVER_COLOR = '#00b4d8';
  * @returns The hover color string
  */
 function getHoverColor(): string {
-  if (typeof document === 'undefined') return DEFAULT_HOVER_COLOR;
-  const style = getComputedStyle(document.documentElement);
-  const color = style.getPropertyValue('--da-accent').trim();
+  const color = readThemeVar('--da-accent');
   return color || DEFAULT_HOVER_COLOR;
 }
 
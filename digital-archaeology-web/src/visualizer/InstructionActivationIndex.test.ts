@@ -0,0 +1,134 @@
+// src/visualizer/InstructionActivationIndex.test.ts
+// Unit tests for the precomputed instruction activation index
+
+import { describe, it, expect, afterEach, vi } from 'vitest';
+import { InstructionActivationIndex, ActivationIndexError, INSTRUCTION_PHASES } from './InstructionActivationIndex';
+
+/**
+ * Build an index file in the generator's format.
+ * @param gateCount - Gates per bitset
+ * @param wireBitCount - Wire bits per bitset
+ * @param active - Per opcode, per phase: [gate IDs, wire bits]
+ */
+function buildIndex(gateCount: number, wireBitCount: number, active: number[][][][]): ArrayBuffer {
+  const gateWords = Math.ceil(gateCount / 32);
+  const wireWords = Math.ceil(wireBitCount / 32);
+  const phaseCount = active[0].length;
+  const buffer = new ArrayBuffer(12 + active.length * phaseCount * (gateWords + wireWords) * 4);
+  const view = new DataView(buffer);
+  [0x4d, 0x34, 0x41, 0x49, 1, active.length, phaseCount, 0].forEach((b, i) => view.setUint8(i, b));
+  view.setUint16(8, gateCount, true);
+  view.setUint16(10, wireBitCount, true);
+
+  let offset = 12;
+  const writeBits = (bits: number[], words: number) => {
+    const set = new Uint32Array(words);
+    for (const bit of bits) set[bit >>> 5] |= 1 << (bit & 31);
+    for (const word of set) {
+      view.setUint32(offset, word, true);
+      offset += 4;
+    }
+  };
+  for (const phases of active) {
+    for (const [gates, wireBits] of phases) {
+      writeBits(gates, gateWords);
+      writeBits(wireBits, wireWords);
+    }
+  }
+  return buffer;
+}
+
+/** Two opcodes, five phases, 40 gates, 10 wire bits */
+function sampleIndex(): InstructionActivationIndex {
+  return new InstructionActivationIndex(buildIndex(40, 10, [
+    [[[0, 31], [0]], [[32], [9]], [[], []], [[39], [3, 4]], [[0], []]],
+    [[[1], []], [[], []], [[], []], [[], []], [[], []]],
+  ]));
+}
+
+describe('InstructionActivationIndex', () => {
+  afterEach(() => {
+    vi.unstubAllGlobals();
+  });
+
+  it('should read the header', () => {
+    const index = sampleIndex();
+
+    expect(index.opcodeCount).toBe(2);
+    expect(index.phaseCount).toBe(INSTRUCTION_PHASES.length);
+    expect(index.gateCount).toBe(40);
+    expect(index.wireBitCount).toBe(10);
+  });
+
+  it('should list gates active in a phase, across word boundaries', () => {
+    const index = sampleIndex();
+
+    expect(index.getPhaseGates(0, 0)).toEqual([0, 31]);
+    expect(index.getPhaseGates(0, 1)).toEqual([32]);
+    expect(index.getPhaseGates(0, 2)).toEqual([]);
+    expect(index.isGateActive(0, 3, 39)).toBe(true);
+    expect(index.isGateActive(0, 3, 38)).toBe(false);
+    expect(index.isGateActive(0, 3, 400)).toBe(false);
+  });
+
+  it('should union gates across phases per opcode', () => {
+    const index = sampleIndex();
+
+    expect(Array.from(index.getInstructionGates(0)).sort((a, b) => a - b)).toEqual([0, 31, 32, 39]);
+    expect(Array.from(index.getInstructionGates(1))).toEqual([1]);
+    expect(index.getInstructionGates(1)).toBe(index.getInstructionGates(1));
+    expect(index.getInstructionGates(99).size).toBe(0);
+  });
+
+  it('should map wire bits to [wire, bit] pairs', () => {
+    const index = sampleIndex();
+    // Wires of width 1, 4, 1, 4
+    const wireBitStart = [0, 1, 5, 6, 10];
+
+    expect(index.getPhaseSignalPath(0, 0, wireBitStart)).toEqual([[0, 0]]);
+    expect(index.getPhaseSignalPath(0, 1, wireBitStart)).toEqual([[3, 3]]);
+    expect(index.getPhaseSignalPath(0, 3, wireBitStart)).toEqual([[1, 2], [1, 3]]);
+  });
+
+  it('should reject out-of-range lookups', () => {
+    const index = sampleIndex();
+
+    expect(() => index.getGateBits(2, 0)).toThrow(RangeError);
+    expect(() => index.getWireBits(0, 5)).toThrow(RangeError);
+  });
+
+  it('should reject a bad magic', () => {
+    const buffer = buildIndex(8, 8, [[[[], []]]]);
+    new DataView(buffer).setUint8(0, 0);
+
+    expect(() => new InstructionActivationIndex(buffer)).toThrow(ActivationIndexError);
+  });
+
+  it('should reject an unsupported version', () => {
+    const buffer = buildIndex(8, 8, [[[[], []]]]);
+    new DataView(buffer).setUint8(4, 2);
+
+    expect(() => new InstructionActivationIndex(buffer)).toThrow('Unsupported activation index version 2');
+  });
+
+  it('should reject a truncated file', () => {
+    const buffer = buildIndex(8, 8, [[[[], []]]]).slice(0, 16);
+
+    expect(() => new InstructionActivationIndex(buffer)).toThrow('size does not match header');
+  });
+
+  it('should load an index with fetch', async () => {
+    const buffer = buildIndex(8, 8, [[[[3], []]]]);
+    vi.stubGlobal('fetch', vi.fn(() => Promise.resolve({ ok: true, arrayBuffer: () => Promise.resolve(buffer) })));
+
+    const index = await InstructionActivationIndex.load('circuits/test.bin');
+
+    expect(index.getPhaseGates(0, 0)).toEqual([3]);
+  });
+
+  it('should reject when the fetch fails', async () => {
+    vi.stubGlobal('fetch', vi.fn(() => Promise.resolve({ ok: false, status: 404, statusText: 'Not Found' })));
+
+    await expect(InstructionActivationIndex.load('circuits/missing.bin')).rejects.toThrow('404 Not Found');
+  });
+});
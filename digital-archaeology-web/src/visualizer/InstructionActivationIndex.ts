@@ -0,0 +1,231 @@
+// src/visualizer/InstructionActivationIndex.ts
+// Precomputed per-opcode, per-phase gate activation from the gate simulator
+
+/** File magic: "M4AI" */
+const MAGIC = [0x4d, 0x34, 0x41, 0x49];
+
+/** Supported format version */
+const VERSION = 1;
+
+/** Bytes before the first bitset */
+const HEADER_BYTES = 12;
+
+/**
+ * Micro4 instruction phases, in state machine order (state register value).
+ */
+export const INSTRUCTION_PHASES = ['FETCH', 'DECODE', 'FETCH_ADDR', 'EXECUTE', 'WRITEBACK'] as const;
+
+/**
+ * Error thrown when an activation index cannot be loaded or parsed.
+ */
+export class ActivationIndexError extends Error {
+  constructor(message: string) {
+    super(message);
+    this.name = 'ActivationIndexError';
+  }
+}
+
+/**
+ * Gates and wire bits that toggle in each phase of each opcode, generated
+ * offline by `m4sim activation hdl/04_micro4_cpu.m4hdl <out.bin>`.
+ *
+ * The file is kept as one Uint32Array of bitsets: per opcode, per phase, a
+ * gate bitset (bit i = circuit JSON gate i) followed by a wire-bit bitset
+ * (bit i = state vector slot i, wires in order). Per-opcode unions across
+ * all phases are built once at parse time, so a lookup while stepping is
+ * an array access.
+ *
+ * @example
+ * ```typescript
+ * const index = await InstructionActivationIndex.load('/circuits/micro4-activation.bin');
+ * renderer.animateTransition(data, index.getInstructionGates(opcode));
+ * ```
+ */
+export class InstructionActivationIndex {
+  /** Number of opcodes in the index */
+  readonly opcodeCount: number;
+  /** Number of phases per opcode */
+  readonly phaseCount: number;
+  /** Number of gates the bitsets cover */
+  readonly gateCount: number;
+  /** Number of wire bits the bitsets cover */
+  readonly wireBitCount: number;
+
+  private readonly words: Uint32Array;
+  private readonly gateWords: number;
+  private readonly wireWords: number;
+  /** Gate IDs active in any phase, per opcode */
+  private readonly instructionGates: ReadonlySet<number>[];
+
+  /**
+   * Parse an index from the generator's output.
+   * @param buffer - File contents
+   * @throws ActivationIndexError if the header or size is invalid
+   */
+  constructor(buffer: ArrayBuffer) {
+    const bytes = new Uint8Array(buffer);
+    if (bytes.length < HEADER_BYTES || MAGIC.some((b, i) => bytes[i] !== b)) {
+      throw new ActivationIndexError('Invalid activation index: bad magic');
+    }
+    const view = new DataView(buffer);
+    if (view.getUint8(4) !== VERSION) {
+      throw new ActivationIndexError(`Unsupported activation index version ${view.getUint8(4)}`);
+    }
+
+    this.opcodeCount = view.getUint8(5);
+    this.phaseCount = view.getUint8(6);
+    this.gateCount = view.getUint16(8, true);
+    this.wireBitCount = view.getUint16(10, true);
+    this.gateWords = Math.ceil(this.gateCount / 32);
+    this.wireWords = Math.ceil(this.wireBitCount / 32);
+
+    const wordCount = this.opcodeCount * this.phaseCount * (this.gateWords + this.wireWords);
+    if (bytes.length !== HEADER_BYTES + wordCount * 4) {
+      throw new ActivationIndexError('Invalid activation index: size does not match header');
+    }
+
+    // Copy so the bitsets are aligned and little-endian on every host
+    this.words = new Uint32Array(wordCount);
+    for (let i = 0; i < wordCount; i++) {
+      this.words[i] = view.getUint32(HEADER_BYTES + i * 4, true);
+    }
+
+    this.instructionGates = [];
+    for (let opcode = 0; opcode < this.opcodeCount; opcode++) {
+      const union = new Uint32Array(this.gateWords);
+      for (let phase = 0; phase < this.phaseCount; phase++) {
+        const bits = this.getGateBits(opcode, phase);
+        for (let w = 0; w < this.gateWords; w++) union[w] |= bits[w];
+      }
+      this.instructionGates.push(new Set(bitsToIndices(union, this.gateCount)));
+    }
+  }
+
+  /**
+   * Fetch and parse an index.
+   * @param path - Path to the index file (relative to public/)
+   * @returns The parsed index
+   * @throws ActivationIndexError on fetch failure or invalid contents
+   */
+  static async load(path: string): Promise<InstructionActivationIndex> {
+    // Prepend base URL for paths starting with /
+    const resolvedPath = path.startsWith('/')
+      ? `${import.meta.env.BASE_URL}${path.slice(1)}`
+      : path;
+
+    const response = await fetch(resolvedPath);
+    if (!response.ok) {
+      throw new ActivationIndexError(
+        `Failed to load activation index: ${response.status} ${response.statusText}`
+      );
+    }
+    return new InstructionActivationIndex(await response.arrayBuffer());
+  }
+
+  /**
+   * Get the gate bitset for one phase of an opcode.
+   * @param opcode - Opcode (0 to opcodeCount - 1)
+   * @param phase - Phase (index into INSTRUCTION_PHASES)
+   * @returns View of the bitset (bit i = gate ID i); do not modify
+   */
+  getGateBits(opcode: number, phase: number): Uint32Array {
+    const start = this.offset(opcode, phase);
+    return this.words.subarray(start, start + this.gateWords);
+  }
+
+  /**
+   * Get the wire-bit bitset for one phase of an opcode.
+   * @param opcode - Opcode (0 to opcodeCount - 1)
+   * @param phase - Phase (index into INSTRUCTION_PHASES)
+   * @returns View of the bitset (bit i = state vector slot i); do not modify
+   */
+  getWireBits(opcode: number, phase: number): Uint32Array {
+    const start = this.offset(opcode, phase) + this.gateWords;
+    return this.words.subarray(start, start + this.wireWords);
+  }
+
+  /**
+   * Check whether a gate toggles in one phase of an opcode.
+   * @param opcode - Opcode (0 to opcodeCount - 1)
+   * @param phase - Phase (index into INSTRUCTION_PHASES)
+   * @param gateId - Gate ID
+   * @returns True if the gate's output toggles
+   */
+  isGateActive(opcode: number, phase: number, gateId: number): boolean {
+    if (gateId < 0 || gateId >= this.gateCount) return false;
+    const bits = this.getGateBits(opcode, phase);
+    return (bits[gateId >>> 5] & (1 << (gateId & 31))) !== 0;
+  }
+
+  /**
+   * Get the gates that toggle in one phase of an opcode.
+   * @param opcode - Opcode (0 to opcodeCount - 1)
+   * @param phase - Phase (index into INSTRUCTION_PHASES)
+   * @returns Gate IDs in ascending order
+   */
+  getPhaseGates(opcode: number, phase: number): number[] {
+    return bitsToIndices(this.getGateBits(opcode, phase), this.gateCount);
+  }
+
+  /**
+   * Get the gates that toggle in any phase of an opcode.
+   * @param opcode - Opcode (0 to opcodeCount - 1)
+   * @returns Shared set of gate IDs; empty for an unknown opcode
+   */
+  getInstructionGates(opcode: number): ReadonlySet<number> {
+    return this.instructionGates[opcode] ?? EMPTY_SET;
+  }
+
+  /**
+   * Get the wire bits that toggle in one phase of an opcode, in the
+   * [wireIndex, bit] form of InstructionMapping.signalPath.
+   * @param opcode - Opcode (0 to opcodeCount - 1)
+   * @param phase - Phase (index into INSTRUCTION_PHASES)
+   * @param wireBitStart - First state vector slot of each wire, plus the total
+   *   (CircuitStructure.wireBitStart)
+   * @returns [wireIndex, bit] pairs in ascending order
+   */
+  getPhaseSignalPath(opcode: number, phase: number, wireBitStart: ArrayLike<number>): number[][] {
+    const path: number[][] = [];
+    let wire = 0;
+    for (const slot of bitsToIndices(this.getWireBits(opcode, phase), this.wireBitCount)) {
+      while (wire + 1 < wireBitStart.length && wireBitStart[wire + 1] <= slot) wire++;
+      path.push([wire, slot - wireBitStart[wire]]);
+    }
+    return path;
+  }
+
+  /**
+   * Word offset of an opcode/phase record.
+   * @throws RangeError if the opcode or phase is out of range
+   */
+  private offset(opcode: number, phase: number): number {
+    if (opcode < 0 || opcode >= this.opcodeCount || phase < 0 || phase >= this.phaseCount) {
+      throw new RangeError(`No activation record for opcode ${opcode}, phase ${phase}`);
+    }
+    return (opcode * this.phaseCount + phase) * (this.gateWords + this.wireWords);
+  }
+}
+
+/** Shared result for unknown opcodes */
+const EMPTY_SET: ReadonlySet<number> = new Set();
+
+/**
+ * List the set bits of a bitset.
+ * @param bits - Bitset words (bit i is bit i & 31 of word i >> 5)
+ * @param count - Number of valid bits
+ * @returns Indices of set bits in ascending order
+ */
+function bitsToIndices(bits: Uint32Array, count: number): number[] {
+  const indices: number[] = [];
+  for (let w = 0; w < bits.length; w++) {
+    let word = bits[w];
+    while (word !== 0) {
+      const bit = 31 - Math.clz32(word & -word);
+      const index = w * 32 + bit;
+      if (index < count) indices.push(index);
+      word &= word - 1;
+    }
+  }
+  return indices;
+}
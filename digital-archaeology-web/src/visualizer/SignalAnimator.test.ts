@@ -220,6 +220,17 @@ describe('SignalAnimator', () => {
       expect(changedGates.has(0)).toBe(true); // AND0 output changed
       expect(changedGates.has(1)).toBe(false); // OR0 output unchanged
     });
+
+    it('should use precomputed changed gates when given', () => {
+      const startData = createMockCircuitData([{ id: 0, name: 'wire0', width: 1, state: [0] }]);
+      const endData = createMockCircuitData([{ id: 0, name: 'wire0', width: 1, state: [1] }]);
+
+      animator.captureState(new CircuitModel(startData));
+      animator.setTargetState(new CircuitModel(endData), new Set([7, 9]));
+
+      expect(Array.from(animator.getChangedGates())).toEqual([7, 9]);
+      expect(animator.hasChanges()).toBe(true);
+    });
   });
 
   describe('hasChanges()', () => {
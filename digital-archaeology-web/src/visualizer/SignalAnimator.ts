@@ -33,12 +33,18 @@ export class SignalAnimator {
 
   /**
    * Set the target circuit state as the animation end point.
-   * Also calculates which gates have changed outputs.
+   * Also calculates which gates have changed outputs, unless the caller
+   * already knows them (e.g. from an InstructionActivationIndex).
    * @param model - The circuit model with target state
+   * @param changedGates - Precomputed gate IDs to pulse; skips the per-gate diff
    */
-  setTargetState(model: CircuitModel): void {
+  setTargetState(model: CircuitModel, changedGates?: ReadonlySet<number>): void {
     this.endState = this.createSnapshot(model);
-    this.calculateChangedGates();
+    if (changedGates) {
+      this.changedGates = new Set(changedGates);
+    } else {
+      this.calculateChangedGates();
+    }
   }
 
   /**
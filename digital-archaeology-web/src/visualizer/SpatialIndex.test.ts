@@ -0,0 +1,148 @@
+// src/visualizer/SpatialIndex.test.ts
+// Unit tests for SpatialIndex
+
+import { describe, it, expect, beforeEach } from 'vitest';
+import { SpatialIndex, rectsIntersect } from './SpatialIndex';
+
+describe('SpatialIndex', () => {
+  let index: SpatialIndex;
+
+  beforeEach(() => {
+    index = new SpatialIndex(100);
+  });
+
+  describe('insert()', () => {
+    it('should return sequential item indices', () => {
+      expect(index.insert(0, 0, 10, 10)).toBe(0);
+      expect(index.insert(20, 20, 30, 30)).toBe(1);
+      expect(index.size).toBe(2);
+    });
+
+    it('should store the item rectangle', () => {
+      index.insert(5, 10, 25, 50);
+      expect(index.getRect(0)).toEqual({ x: 5, y: 10, width: 20, height: 40 });
+      expect(index.getRect(1)).toBeUndefined();
+    });
+  });
+
+  describe('query()', () => {
+    it('should return an empty array for an empty index', () => {
+      expect(index.query({ x: 0, y: 0, width: 1000, height: 1000 })).toEqual([]);
+    });
+
+    it('should return only items intersecting the query rectangle', () => {
+      index.insert(0, 0, 10, 10);
+      index.insert(500, 500, 510, 510);
+      index.insert(50, 50, 60, 60);
+
+      expect(index.query({ x: 0, y: 0, width: 100, height: 100 })).toEqual([0, 2]);
+      expect(index.query({ x: 400, y: 400, width: 200, height: 200 })).toEqual([1]);
+    });
+
+    it('should reject items sharing a cell but outside the rectangle', () => {
+      index.insert(0, 0, 10, 10);
+      index.insert(80, 80, 90, 90);
+
+      expect(index.query({ x: 70, y: 70, width: 5, height: 5 })).toEqual([]);
+    });
+
+    it('should report items spanning several cells once', () => {
+      index.insert(0, 0, 450, 450);
+
+      expect(index.query({ x: 0, y: 0, width: 1000, height: 1000 })).toEqual([0]);
+    });
+
+    it('should return items in insertion order', () => {
+      index.insert(350, 0, 360, 10);
+      index.insert(0, 0, 10, 10);
+      index.insert(150, 250, 160, 260);
+
+      expect(index.query({ x: 0, y: 0, width: 400, height: 400 })).toEqual([0, 1, 2]);
+    });
+
+    it('should treat touching edges as intersecting', () => {
+      index.insert(0, 0, 10, 10);
+
+      expect(index.query({ x: 10, y: 10, width: 5, height: 5 })).toEqual([0]);
+    });
+
+    it('should handle negative coordinates', () => {
+      index.insert(-250, -250, -200, -200);
+
+      expect(index.query({ x: -300, y: -300, width: 60, height: 60 })).toEqual([0]);
+      expect(index.query({ x: 0, y: 0, width: 60, height: 60 })).toEqual([]);
+    });
+
+    it('should handle zero-size items such as straight wire segments', () => {
+      index.insert(50, 20, 150, 20);
+
+      expect(index.query({ x: 120, y: 15, width: 10, height: 10 })).toEqual([0]);
+      expect(index.query({ x: 120, y: 25, width: 10, height: 10 })).toEqual([]);
+    });
+
+    it('should handle query rectangles far larger than the content', () => {
+      for (let i = 0; i < 10; i++) {
+        index.insert(i * 10, 0, i * 10 + 5, 5);
+      }
+
+      const result = index.query({ x: -1e9, y: -1e9, width: 2e9, height: 2e9 });
+      expect(result).toHaveLength(10);
+    });
+  });
+
+  describe('queryPoint()', () => {
+    it('should return items containing the point', () => {
+      index.insert(0, 0, 60, 40);
+      index.insert(100, 0, 160, 40);
+
+      expect(index.queryPoint(30, 20)).toEqual([0]);
+      expect(index.queryPoint(130, 20)).toEqual([1]);
+      expect(index.queryPoint(80, 20)).toEqual([]);
+    });
+  });
+
+  describe('clear()', () => {
+    it('should remove all items', () => {
+      index.insert(0, 0, 10, 10);
+      index.clear();
+
+      expect(index.size).toBe(0);
+      expect(index.query({ x: 0, y: 0, width: 100, height: 100 })).toEqual([]);
+      expect(index.insert(0, 0, 10, 10)).toBe(0);
+    });
+  });
+
+  describe('large layouts', () => {
+    it('should match a brute-force scan', () => {
+      const rects: Array<[number, number, number, number]> = [];
+      let seed = 12345;
+      const random = (): number => {
+        seed = (seed * 1103515245 + 12345) % 2147483648;
+        return seed / 2147483648;
+      };
+      for (let i = 0; i < 2000; i++) {
+        const x = random() * 5000;
+        const y = random() * 5000;
+        const rect: [number, number, number, number] = [x, y, x + random() * 200, y + random() * 200];
+        rects.push(rect);
+        index.insert(...rect);
+      }
+
+      const query = { x: 1200, y: 800, width: 900, height: 700 };
+      const expected = rects
+        .map((r, i) => (rectsIntersect(query, { x: r[0], y: r[1], width: r[2] - r[0], height: r[3] - r[1] }) ? i : -1))
+        .filter((i) => i >= 0);
+      expect(index.query(query)).toEqual(expected);
+    });
+  });
+});
+
+describe('rectsIntersect', () => {
+  it('should detect overlapping and separate rectangles', () => {
+    const a = { x: 0, y: 0, width: 10, height: 10 };
+
+    expect(rectsIntersect(a, { x: 5, y: 5, width: 10, height: 10 })).toBe(true);
+    expect(rectsIntersect(a, { x: 11, y: 0, width: 10, height: 10 })).toBe(false);
+    expect(rectsIntersect(a, { x: 0, y: 11, width: 10, height: 10 })).toBe(false);
+  });
+});
@@ -0,0 +1,230 @@
+// src/visualizer/SpatialIndex.ts
+// Uniform-grid spatial index for viewport culling and hit testing
+
+/**
+ * Axis-aligned rectangle in layout coordinates.
+ */
+export interface Rect {
+  /** X coordinate of left edge */
+  x: number;
+  /** Y coordinate of top edge */
+  y: number;
+  /** Width (non-negative) */
+  width: number;
+  /** Height (non-negative) */
+  height: number;
+}
+
+/**
+ * Default grid cell size in layout pixels.
+ * About two gate columns wide, so a gate touches at most four cells.
+ */
+export const DEFAULT_CELL_SIZE = 128;
+
+/** Cell coordinates are packed into one number key; this bounds the grid. */
+const CELL_KEY_SPAN = 1 << 20;
+const CELL_KEY_BIAS = 1 << 19;
+
+/**
+ * Check whether two rectangles overlap (edges touching counts as overlap).
+ * @param a - First rectangle
+ * @param b - Second rectangle
+ * @returns True if the rectangles intersect
+ */
+export function rectsIntersect(a: Rect, b: Rect): boolean {
+  return (
+    a.x <= b.x + b.width &&
+    b.x <= a.x + a.width &&
+    a.y <= b.y + b.height &&
+    b.y <= a.y + a.height
+  );
+}
+
+/**
+ * SpatialIndex buckets rectangles into a uniform grid of square cells.
+ * Items are identified by their insertion index, so callers can keep
+ * parallel arrays and get query results back in insertion (draw) order.
+ */
+export class SpatialIndex {
+  private cellSize: number;
+  private cells: Map<number, number[]> = new Map();
+  private minX: number[] = [];
+  private minY: number[] = [];
+  private maxX: number[] = [];
+  private maxY: number[] = [];
+  /** Per-item query stamp, so an item spanning several cells is reported once */
+  private seen: number[] = [];
+  private queryStamp = 0;
+  /** Occupied cell range, so huge query rects scan only populated cells */
+  private minCellX = Infinity;
+  private minCellY = Infinity;
+  private maxCellX = -Infinity;
+  private maxCellY = -Infinity;
+
+  /**
+   * Create a new SpatialIndex.
+   * @param cellSize - Grid cell size in layout pixels
+   */
+  constructor(cellSize: number = DEFAULT_CELL_SIZE) {
+    this.cellSize = cellSize;
+  }
+
+  /**
+   * Add a rectangle to the index.
+   * @param minX - Left edge
+   * @param minY - Top edge
+   * @param maxX - Right edge
+   * @param maxY - Bottom edge
+   * @returns The item index (0 for the first insert, then 1, 2, ...)
+   */
+  insert(minX: number, minY: number, maxX: number, maxY: number): number {
+    const item = this.minX.length;
+    this.minX.push(minX);
+    this.minY.push(minY);
+    this.maxX.push(maxX);
+    this.maxY.push(maxY);
+    this.seen.push(0);
+
+    const x0 = this.cellOf(minX);
+    const y0 = this.cellOf(minY);
+    const x1 = this.cellOf(maxX);
+    const y1 = this.cellOf(maxY);
+    for (let cy = y0; cy <= y1; cy++) {
+      for (let cx = x0; cx <= x1; cx++) {
+        const key = cellKey(cx, cy);
+        const cell = this.cells.get(key);
+        if (cell) {
+          cell.push(item);
+        } else {
+          this.cells.set(key, [item]);
+        }
+      }
+    }
+
+    this.minCellX = Math.min(this.minCellX, x0);
+    this.minCellY = Math.min(this.minCellY, y0);
+    this.maxCellX = Math.max(this.maxCellX, x1);
+    this.maxCellY = Math.max(this.maxCellY, y1);
+    return item;
+  }
+
+  /**
+   * Find all items whose rectangle intersects the query rectangle.
+   * @param rect - Query rectangle
+   * @returns Item indices in ascending (insertion) order
+   */
+  query(rect: Rect): number[] {
+    const result: number[] = [];
+    if (this.minX.length === 0) return result;
+
+    const x0 = Math.max(this.cellOf(rect.x), this.minCellX);
+    const y0 = Math.max(this.cellOf(rect.y), this.minCellY);
+    const x1 = Math.min(this.cellOf(rect.x + rect.width), this.maxCellX);
+    const y1 = Math.min(this.cellOf(rect.y + rect.height), this.maxCellY);
+    const rx1 = rect.x + rect.width;
+    const ry1 = rect.y + rect.height;
+
+    const stamp = this.nextStamp();
+    for (let cy = y0; cy <= y1; cy++) {
+      for (let cx = x0; cx <= x1; cx++) {
+        const cell = this.cells.get(cellKey(cx, cy));
+        if (!cell) continue;
+        for (const item of cell) {
+          if (this.seen[item] === stamp) continue;
+          this.seen[item] = stamp;
+          if (
+            this.minX[item] <= rx1 &&
+            rect.x <= this.maxX[item] &&
+            this.minY[item] <= ry1 &&
+            rect.y <= this.maxY[item]
+          ) {
+            result.push(item);
+          }
+        }
+      }
+    }
+
+    // Cells are visited in grid order, not insertion order
+    result.sort((a, b) => a - b);
+    return result;
+  }
+
+  /**
+   * Find all items whose rectangle contains a point.
+   * @param x - X coordinate
+   * @param y - Y coordinate
+   * @returns Item indices in ascending (insertion) order
+   */
+  queryPoint(x: number, y: number): number[] {
+    return this.query({ x, y, width: 0, height: 0 });
+  }
+
+  /**
+   * Get the rectangle stored for an item.
+   * @param item - Item index returned by insert()
+   * @returns The item's rectangle, or undefined if out of range
+   */
+  getRect(item: number): Rect | undefined {
+    if (item < 0 || item >= this.minX.length) return undefined;
+    return {
+      x: this.minX[item],
+      y: this.minY[item],
+      width: this.maxX[item] - this.minX[item],
+      height: this.maxY[item] - this.minY[item],
+    };
+  }
+
+  /**
+   * Remove all items.
+   */
+  clear(): void {
+    this.cells.clear();
+    this.minX = [];
+    this.minY = [];
+    this.maxX = [];
+    this.maxY = [];
+    this.seen = [];
+    this.queryStamp = 0;
+    this.minCellX = Infinity;
+    this.minCellY = Infinity;
+    this.maxCellX = -Infinity;
+    this.maxCellY = -Infinity;
+  }
+
+  /**
+   * Get the number of items in the index.
+   * @returns The item count
+   */
+  get size(): number {
+    return this.minX.length;
+  }
+
+  /**
+   * Grid cell coordinate for a layout coordinate, clamped to the key range.
+   * @private
+   */
+  private cellOf(value: number): number {
+    const cell = Math.floor(value / this.cellSize);
+    return Math.max(-CELL_KEY_BIAS, Math.min(CELL_KEY_BIAS - 1, cell));
+  }
+
+  /**
+   * Advance the query stamp, resetting stamps on the (rare) wrap-around.
+   * @private
+   */
+  private nextStamp(): number {
+    this.queryStamp++;
+    if (this.queryStamp >= Number.MAX_SAFE_INTEGER) {
+      this.seen.fill(0);
+      this.queryStamp = 1;
+    }
+    return this.queryStamp;
+  }
+}
+
+/**
+ * Pack cell coordinates into a single Map key.
+ */
+function cellKey(cx: number, cy: number): number {
+  return (cy + CELL_KEY_BIAS) * CELL_KEY_SPAN + (cx + CELL_KEY_BIAS);
+}
@@ -1,6 +1,8 @@
 // src/visualizer/animationUtils.ts
 // Animation utility functions for circuit visualization (Story 6.5)
 
+import { readThemeVar } from './themeVars';
+
 /**
  * Default maximum scale for gate pulse animation.
  * Gates scale up to this value and back during pulse effect.
@@ -29,9 +31,7 @@ export function easeOutQuad(t: number): number {
  * @returns Scale factor for gate pulse
  */
 export function getPulseScaleFromCSS(): number {
-  if (typeof document === 'undefined') return DEFAULT_PULSE_MAX_SCALE;
-  const style = getComputedStyle(document.documentElement);
-  const value = style.getPropertyValue('--da-gate-pulse-scale').trim();
+  const value = readThemeVar('--da-gate-pulse-scale');
   if (!value) return DEFAULT_PULSE_MAX_SCALE;
   const parsed = parseFloat(value);
   return isNaN(parsed) ? DEFAULT_PULSE_MAX_SCALE : parsed;
@@ -0,0 +1,115 @@
+// src/visualizer/circuitRender.worker.test.ts
+// Unit tests for the circuit render worker message handling
+
+import { describe, it, expect, beforeEach, vi } from 'vitest';
+import {
+  isRenderWorkerCommand,
+  handleInit,
+  handleLoadCircuit,
+  handleRender,
+  handleHitTest,
+  drawFrame,
+} from './circuitRender.worker';
+import { createSceneAppearance } from './CircuitScene';
+import type { SceneView } from './CircuitScene';
+import { CircuitLayout } from './CircuitLayout';
+import { CircuitModel } from './CircuitModel';
+import type { CircuitData } from './types';
+
+const circuitData: CircuitData = {
+  cycle: 0,
+  stable: true,
+  wires: [{ id: 0, name: 'acc', width: 1, is_input: false, is_output: false, state: [0] }],
+  gates: [
+    { id: 0, name: 'AND0', type: 'AND', inputs: [], outputs: [{ wire: 0, bit: 0 }] },
+    { id: 1, name: 'NOT1', type: 'NOT', inputs: [{ wire: 0, bit: 0 }], outputs: [] },
+  ],
+};
+
+const view: SceneView = { width: 400, height: 300, dpr: 2, scale: 1, offsetX: 0, offsetY: 0 };
+
+describe('Circuit Render Worker', () => {
+  const mockPostMessage = vi.fn();
+
+  beforeEach(() => {
+    vi.clearAllMocks();
+    // Frames are scheduled but never run on their own; tests call drawFrame()
+    vi.stubGlobal('self', {
+      postMessage: mockPostMessage,
+      setTimeout: vi.fn(() => 1),
+    });
+  });
+
+  describe('isRenderWorkerCommand', () => {
+    it('should accept well-formed commands', () => {
+      expect(isRenderWorkerCommand({ type: 'SET_THEME', payload: { theme: {} } })).toBe(true);
+      expect(isRenderWorkerCommand({ type: 'LOAD_CIRCUIT', payload: { circuitData } })).toBe(true);
+      expect(
+        isRenderWorkerCommand({ type: 'RENDER', payload: { view, appearance: createSceneAppearance() } })
+      ).toBe(true);
+      expect(isRenderWorkerCommand({ type: 'HIT_TEST', payload: { requestId: 1, x: 0, y: 0 } })).toBe(true);
+    });
+
+    it('should reject unknown types and malformed payloads', () => {
+      expect(isRenderWorkerCommand(null)).toBe(false);
+      expect(isRenderWorkerCommand({ type: 'DRAW', payload: {} })).toBe(false);
+      expect(isRenderWorkerCommand({ type: 'LOAD_CIRCUIT', payload: { circuitData: {} } })).toBe(false);
+      expect(
+        isRenderWorkerCommand({
+          type: 'RENDER',
+          payload: { view: { ...view, scale: NaN }, appearance: createSceneAppearance() },
+        })
+      ).toBe(false);
+      expect(isRenderWorkerCommand({ type: 'HIT_TEST', payload: { requestId: 1, x: 'a', y: 0 } })).toBe(false);
+    });
+  });
+
+  describe('message handling', () => {
+    it('should answer hit tests against the laid-out circuit', () => {
+      handleLoadCircuit(circuitData);
+      handleRender(view, createSceneAppearance());
+
+      const layout = new CircuitLayout();
+      layout.calculate(new CircuitModel(circuitData), view.width, view.height);
+      const pos = layout.getPosition(1)!;
+
+      handleHitTest(7, pos.x + 1, pos.y + 1);
+      handleHitTest(8, -50, -50);
+
+      expect(mockPostMessage).toHaveBeenCalledWith(
+        expect.objectContaining({ type: 'LAYOUT_CHANGED', payload: { bounds: layout.getBounds() } })
+      );
+      expect(mockPostMessage).toHaveBeenCalledWith({ type: 'HIT_RESULT', payload: { requestId: 7, gateId: 1 } });
+      expect(mockPostMessage).toHaveBeenCalledWith({ type: 'HIT_RESULT', payload: { requestId: 8, gateId: null } });
+    });
+
+    it('should size the offscreen canvas from the view and report the frame', () => {
+      const ctx = {
+        fillRect: vi.fn(),
+        setTransform: vi.fn(),
+        translate: vi.fn(),
+        scale: vi.fn(),
+        beginPath: vi.fn(),
+        moveTo: vi.fn(),
+        lineTo: vi.fn(),
+        stroke: vi.fn(),
+        roundRect: vi.fn(),
+        fill: vi.fn(),
+        fillText: vi.fn(),
+        save: vi.fn(),
+        restore: vi.fn(),
+      };
+      const offscreen = { width: 0, height: 0, getContext: () => ctx } as unknown as OffscreenCanvas;
+
+      handleInit(offscreen, { '--da-bg-primary': '#101010' });
+      handleLoadCircuit(circuitData);
+      handleRender(view, createSceneAppearance());
+      drawFrame();
+
+      expect(offscreen.width).toBe(800);
+      expect(offscreen.height).toBe(600);
+      expect(ctx.fillText).toHaveBeenCalledWith('AND', expect.any(Number), expect.any(Number));
+      expect(mockPostMessage).toHaveBeenCalledWith({ type: 'FRAME_COMPLETE' });
+    });
+  });
+});
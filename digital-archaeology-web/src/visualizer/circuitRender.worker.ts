@@ -0,0 +1,271 @@
+// src/visualizer/circuitRender.worker.ts
+// Web Worker that lays out and draws the circuit on an OffscreenCanvas
+// The UI thread only forwards view and input state; emulator state can arrive directly on a MessagePort
+
+/// <reference lib="webworker" />
+
+import type { CPUState } from '@emulator/types';
+import type { CircuitData, RenderWorkerCommand, RenderWorkerEvent } from './types';
+import { CircuitModel } from './CircuitModel';
+import { CircuitScene, createSceneAppearance, getThemeBackground } from './CircuitScene';
+import type { SceneAppearance, SceneView } from './CircuitScene';
+import { CPUCircuitBridge } from './CPUCircuitBridge';
+import { setThemeSnapshot } from './themeVars';
+
+// Self is typed as DedicatedWorkerGlobalScope via reference lib above
+declare const self: DedicatedWorkerGlobalScope;
+
+// Worker state
+let canvas: OffscreenCanvas | null = null;
+let ctx: CanvasRenderingContext2D | null = null;
+const scene = new CircuitScene();
+const stateBridge = new CPUCircuitBridge();
+let statePort: MessagePort | null = null;
+
+// Latest inputs; several may arrive between two animation frames
+let view: SceneView | null = null;
+let appearance: SceneAppearance = createSceneAppearance();
+let pendingState: CPUState | null = null;
+let framePending = false;
+
+/**
+ * Type guard for RenderWorkerCommand messages.
+ * Validates structure including payload fields where required.
+ */
+export function isRenderWorkerCommand(data: unknown): data is RenderWorkerCommand {
+  if (!data || typeof data !== 'object') return false;
+  const obj = data as Record<string, unknown>;
+  if (typeof obj.payload !== 'object' || obj.payload === null) return false;
+  const payload = obj.payload as Record<string, unknown>;
+
+  switch (obj.type) {
+    case 'INIT':
+      return (
+        typeof payload.canvas === 'object' &&
+        payload.canvas !== null &&
+        typeof payload.theme === 'object' &&
+        payload.theme !== null
+      );
+    case 'SET_THEME':
+      return typeof payload.theme === 'object' && payload.theme !== null;
+    case 'LOAD_CIRCUIT': {
+      const circuitData = payload.circuitData as Record<string, unknown> | null;
+      return (
+        typeof circuitData === 'object' &&
+        circuitData !== null &&
+        Array.isArray(circuitData.gates) &&
+        Array.isArray(circuitData.wires)
+      );
+    }
+    case 'RENDER': {
+      const v = payload.view as Record<string, unknown> | null;
+      return (
+        typeof v === 'object' &&
+        v !== null &&
+        ['width', 'height', 'dpr', 'scale', 'offsetX', 'offsetY'].every((k) => Number.isFinite(v[k])) &&
+        typeof payload.appearance === 'object' &&
+        payload.appearance !== null
+      );
+    }
+    case 'CONNECT_STATE_PORT':
+      return typeof payload.port === 'object' && payload.port !== null;
+    case 'HIT_TEST':
+      return (
+        typeof payload.requestId === 'number' &&
+        Number.isFinite(payload.x) &&
+        Number.isFinite(payload.y)
+      );
+    default:
+      return false;
+  }
+}
+
+/**
+ * Post an event to the main thread.
+ */
+function post(event: RenderWorkerEvent): void {
+  self.postMessage(event);
+}
+
+/**
+ * Handle INIT command.
+ * Take over the transferred canvas and install the theme snapshot.
+ */
+export function handleInit(offscreen: OffscreenCanvas, theme: Record<string, string>): void {
+  canvas = offscreen;
+  // The offscreen context supports every call the scene and renderers make
+  ctx = offscreen.getContext('2d') as unknown as CanvasRenderingContext2D | null;
+  if (ctx) {
+    scene.attach(ctx);
+  }
+  setThemeSnapshot(theme);
+  scheduleFrame();
+}
+
+/**
+ * Handle LOAD_CIRCUIT command.
+ * A new structure drops the wire name cache used to map emulator state.
+ */
+export function handleLoadCircuit(circuitData: CircuitData): void {
+  if (scene.setModel(new CircuitModel(circuitData))) {
+    stateBridge.clearCache();
+  }
+  scheduleFrame();
+}
+
+/**
+ * Handle RENDER command.
+ * Only the latest view and appearance are drawn, at the next frame.
+ */
+export function handleRender(nextView: SceneView, nextAppearance: SceneAppearance): void {
+  view = nextView;
+  appearance = nextAppearance;
+  scheduleFrame();
+}
+
+/**
+ * Handle a STATE_UPDATE from the emulator port.
+ * Only the latest state is mapped onto the circuit, at the next frame.
+ */
+export function handleStateUpdate(state: CPUState): void {
+  pendingState = state;
+  scheduleFrame();
+}
+
+/**
+ * Handle CONNECT_STATE_PORT command.
+ * Replaces any previously connected port.
+ */
+export function handleConnectStatePort(port: MessagePort): void {
+  statePort?.close();
+  statePort = port;
+  port.onmessage = (event: MessageEvent) => {
+    const data = event.data as { type?: unknown; payload?: unknown } | null;
+    if (data?.type === 'STATE_UPDATE' && typeof data.payload === 'object' && data.payload !== null) {
+      handleStateUpdate(data.payload as CPUState);
+    }
+  };
+}
+
+/**
+ * Handle HIT_TEST command.
+ * Answers against the layout of the most recent view.
+ */
+export function handleHitTest(requestId: number, x: number, y: number): void {
+  if (view && scene.updateLayout(view.width, view.height)) {
+    postLayoutChanged();
+  }
+  const gate = scene.hitTestGate(x, y);
+  post({ type: 'HIT_RESULT', payload: { requestId, gateId: gate?.id ?? null } });
+}
+
+/**
+ * Request a frame, coalescing requests made before it runs.
+ */
+function scheduleFrame(): void {
+  if (framePending) return;
+  framePending = true;
+
+  const run = (): void => {
+    framePending = false;
+    drawFrame();
+  };
+  if (typeof self.requestAnimationFrame === 'function') {
+    self.requestAnimationFrame(run);
+  } else {
+    self.setTimeout(run, 16);
+  }
+}
+
+/**
+ * Tell the main thread the content size, for pan clamping and zoom-to-fit.
+ */
+function postLayoutChanged(): void {
+  post({ type: 'LAYOUT_CHANGED', payload: { bounds: scene.getLayout()?.getBounds() ?? null } });
+}
+
+/**
+ * Draw the latest view: apply pending emulator state, resize the canvas
+ * if the view size changed, refresh the layout and draw.
+ */
+export function drawFrame(): void {
+  // State that arrives before the circuit waits for it
+  const model = scene.getModel();
+  if (pendingState && model) {
+    scene.setModel(stateBridge.mapStateToModel(pendingState, model));
+    pendingState = null;
+  }
+
+  if (!canvas || !ctx || !view) return;
+
+  // Resizing clears the bitmap, so the next frame must be a full one
+  const deviceWidth = Math.trunc(view.width * view.dpr);
+  const deviceHeight = Math.trunc(view.height * view.dpr);
+  if (canvas.width !== deviceWidth || canvas.height !== deviceHeight) {
+    canvas.width = deviceWidth;
+    canvas.height = deviceHeight;
+    scene.invalidateFrame();
+  }
+
+  if (scene.updateLayout(view.width, view.height)) {
+    postLayoutChanged();
+  }
+  scene.draw(ctx, canvas, view, appearance, getThemeBackground());
+  post({ type: 'FRAME_COMPLETE' });
+}
+
+/**
+ * Handle incoming messages from the main thread.
+ */
+function handleMessage(event: MessageEvent): void {
+  const data = event.data;
+
+  if (!isRenderWorkerCommand(data)) {
+    console.warn('[CircuitRenderWorker] Unknown message type:', data);
+    return;
+  }
+
+  // Route by message type
+  switch (data.type) {
+    case 'INIT': {
+      handleInit(data.payload.canvas, data.payload.theme);
+      break;
+    }
+    case 'SET_THEME': {
+      setThemeSnapshot(data.payload.theme);
+      scheduleFrame();
+      break;
+    }
+    case 'LOAD_CIRCUIT': {
+      handleLoadCircuit(data.payload.circuitData);
+      break;
+    }
+    case 'RENDER': {
+      handleRender(data.payload.view, data.payload.appearance);
+      break;
+    }
+    case 'CONNECT_STATE_PORT': {
+      handleConnectStatePort(data.payload.port);
+      break;
+    }
+    case 'HIT_TEST': {
+      handleHitTest(data.payload.requestId, data.payload.x, data.payload.y);
+      break;
+    }
+    default: {
+      // Type system ensures this is exhaustive, but log just in case
+      console.warn('[CircuitRenderWorker] Unhandled message type:', data);
+    }
+  }
+}
+
+// Only listen when in a real Web Worker context (not during testing)
+// Check for DedicatedWorkerGlobalScope by verifying importScripts exists (only in workers)
+const isWorkerContext =
+  typeof self !== 'undefined' &&
+  typeof self.postMessage === 'function' &&
+  typeof importScripts === 'function';
+
+if (isWorkerContext) {
+  self.onmessage = handleMessage;
+}
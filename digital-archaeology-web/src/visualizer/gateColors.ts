@@ -2,6 +2,7 @@
 // Gate color constants and lookup function (Story 6.3)
 
 import type { GateType } from './types';
+import { readThemeVar } from './themeVars';
 
 /**
  * Default gate colors matching CSS variables.
@@ -56,14 +57,11 @@ export function getGateColor(type: string): string {
   const normalizedType = type.toUpperCase() as GateType;
 
   // Try to get color from CSS variables
-  if (typeof document !== 'undefined') {
-    const style = getComputedStyle(document.documentElement);
-    const varName = GATE_COLOR_VARS[normalizedType];
-    if (varName) {
-      const color = style.getPropertyValue(varName).trim();
-      if (color) {
-        return color;
-      }
+  const varName = GATE_COLOR_VARS[normalizedType];
+  if (varName) {
+    const color = readThemeVar(varName);
+    if (color) {
+      return color;
     }
   }
 
@@ -90,12 +88,9 @@ export function isValidGateType(type: string): type is GateType {
  * @returns The border color string (hex format)
  */
 export function getGateBorderColor(): string {
-  if (typeof document !== 'undefined') {
-    const style = getComputedStyle(document.documentElement);
-    const color = style.getPropertyValue(GATE_STYLE_VARS.border).trim();
-    if (color) {
-      return color;
-    }
+  const color = readThemeVar(GATE_STYLE_VARS.border);
+  if (color) {
+    return color;
   }
   return DEFAULT_GATE_STYLE.border;
 }
@@ -105,12 +100,9 @@ export function getGateBorderColor(): string {
  * @returns The text color string (hex format)
  */
 export function getGateTextColor(): string {
-  if (typeof document !== 'undefined') {
-    const style = getComputedStyle(document.documentElement);
-    const color = style.getPropertyValue(GATE_STYLE_VARS.text).trim();
-    if (color) {
-      return color;
-    }
+  const color = readThemeVar(GATE_STYLE_VARS.text);
+  if (color) {
+    return color;
   }
   return DEFAULT_GATE_STYLE.text;
 }
@@ -1,6 +1,8 @@
 // src/visualizer/highlightColors.ts
 // Shared highlight color utilities for circuit visualization (Story 6.9)
 
+import { readThemeVar } from './themeVars';
+
 /**
  * Default link highlight color (--da-link-highlight fallback).
  * Orange color distinct from hover for code-to-circuit linking.
@@ -13,8 +15,6 @@ export const DEFAULT_LINK_HIGHLIGHT_COLOR = '#ff9f43';
  * @returns The link highlight color string
  */
 export function getLinkHighlightColor(): string {
-  if (typeof document === 'undefined') return DEFAULT_LINK_HIGHLIGHT_COLOR;
-  const style = getComputedStyle(document.documentElement);
-  const color = style.getPropertyValue('--da-link-highlight').trim();
+  const color = readThemeVar('--da-link-highlight');
   return color || DEFAULT_LINK_HIGHLIGHT_COLOR;
 }
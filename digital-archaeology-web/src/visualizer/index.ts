@@ -8,6 +8,7 @@ export type { CircuitRendererOptions, CircuitRendererState, AnimationOptions } f
 // Story 6.2: Circuit Data Loading
 export { CircuitLoader, CircuitLoadError } from './CircuitLoader';
 export { CircuitModel } from './CircuitModel';
+export type { CircuitStructure } from './CircuitModel';
 export type {
   CircuitData,
   CircuitWire,
@@ -36,7 +37,7 @@ export {
 export { WireRenderer, DEFAULT_WIRE_CONFIG } from './WireRenderer';
 export type { WireRenderConfig } from './WireRenderer';
 export { getWireColor, DEFAULT_WIRE_COLORS, WIRE_COLOR_VARS } from './wireColors';
-export type { WirePosition, WireSegment } from './CircuitLayout';
+export type { WirePosition, WireSegment, WireSegmentRef } from './CircuitLayout';
 
 // Story 6.5: Animation
 export { AnimationController, DEFAULT_ANIMATION_CONFIG, getAnimationDurationFromCSS } from './AnimationController';
@@ -74,6 +75,9 @@ export type { InstructionMapping } from './InstructionGateMapping';
 // Story 6.10: Circuit-to-Code Linking
 export { getInstructionsForGate } from './InstructionGateMapping';
 
+// Precomputed instruction activation (generated by m4sim activation)
+export { InstructionActivationIndex, ActivationIndexError, INSTRUCTION_PHASES } from './InstructionActivationIndex';
+
 // Story 6.11: Signal Values Panel
 export { SignalValuesPanel } from './SignalValuesPanel';
 export type { SignalValuesPanelOptions, SignalDefinition } from './SignalValuesPanel';
@@ -92,3 +96,13 @@ export type { BreadcrumbNavOptions, BreadcrumbItem } from './BreadcrumbNav';
 
 // Story 6.13: CPU-Circuit Integration
 export { CPUCircuitBridge, numberToBitArray } from './CPUCircuitBridge';
+
+// Off-main-thread rendering
+export { CircuitScene, CIRCUIT_THEME_VARS, DEFAULT_BG_PRIMARY, createSceneAppearance, getThemeBackground } from './CircuitScene';
+export type { SceneView, SceneAppearance, SceneCanvas } from './CircuitScene';
+export { readThemeVar, setThemeSnapshot, captureThemeVars } from './themeVars';
+export type { RenderWorkerCommand, RenderWorkerEvent } from './types';
+
+// Viewport culling and hit testing
+export { SpatialIndex, rectsIntersect, DEFAULT_CELL_SIZE } from './SpatialIndex';
+export type { Rect } from './SpatialIndex';
@@ -0,0 +1,52 @@
+// src/visualizer/themeVars.test.ts
+// Unit tests for theme variable access
+
+import { describe, it, expect, vi, afterEach } from 'vitest';
+import { readThemeVar, setThemeSnapshot, captureThemeVars } from './themeVars';
+import { getWireColor, DEFAULT_WIRE_COLORS } from './wireColors';
+
+describe('themeVars', () => {
+  afterEach(() => {
+    setThemeSnapshot(null);
+    vi.restoreAllMocks();
+  });
+
+  describe('readThemeVar()', () => {
+    it('should read and trim computed style values', () => {
+      vi.spyOn(window, 'getComputedStyle').mockReturnValue({
+        getPropertyValue: (name: string) => (name === '--da-accent' ? '  #123456 ' : ''),
+      } as CSSStyleDeclaration);
+
+      expect(readThemeVar('--da-accent')).toBe('#123456');
+      expect(readThemeVar('--da-unset')).toBe('');
+    });
+
+    it('should prefer an installed snapshot over computed style', () => {
+      const spy = vi.spyOn(window, 'getComputedStyle');
+      setThemeSnapshot({ '--da-accent': '#abcdef' });
+
+      expect(readThemeVar('--da-accent')).toBe('#abcdef');
+      expect(readThemeVar('--da-unset')).toBe('');
+      expect(spy).not.toHaveBeenCalled();
+    });
+
+    it('should feed the color lookups, so a worker can use a snapshot', () => {
+      setThemeSnapshot({ '--da-wire-high': '#010203' });
+
+      expect(getWireColor(1)).toBe('#010203');
+      expect(getWireColor(0)).toBe(DEFAULT_WIRE_COLORS.low);
+    });
+  });
+
+  describe('captureThemeVars()', () => {
+    it('should capture set variables and omit unset ones', () => {
+      vi.spyOn(window, 'getComputedStyle').mockReturnValue({
+        getPropertyValue: (name: string) => (name === '--da-bg-primary' ? ' #0a0a0a' : ''),
+      } as CSSStyleDeclaration);
+
+      expect(captureThemeVars(['--da-bg-primary', '--da-accent'])).toEqual({
+        '--da-bg-primary': '#0a0a0a',
+      });
+    });
+  });
+});
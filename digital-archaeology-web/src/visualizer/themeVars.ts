@@ -0,0 +1,43 @@
+// src/visualizer/themeVars.ts
+// CSS custom property access that also works off the main thread
+
+/** Variable values used instead of computed style, when set */
+let themeSnapshot: Record<string, string> | null = null;
+
+/**
+ * Read a CSS custom property from the document root.
+ * Uses the installed snapshot when there is one.
+ * @param name - Variable name including the leading dashes
+ * @returns The trimmed value, or '' if unavailable
+ */
+export function readThemeVar(name: string): string {
+  if (themeSnapshot) return themeSnapshot[name] ?? '';
+  if (typeof document === 'undefined') return '';
+  return getComputedStyle(document.documentElement).getPropertyValue(name).trim();
+}
+
+/**
+ * Install (or with null, remove) a snapshot of theme variable values.
+ * @param snapshot - Variable name to value map
+ */
+export function setThemeSnapshot(snapshot: Record<string, string> | null): void {
+  themeSnapshot = snapshot;
+}
+
+/**
+ * Capture the current values of a set of theme variables, so they can be
+ * installed with setThemeSnapshot() where there is no document (workers).
+ * @param names - Variable names to capture
+ * @returns Variable name to value map (unset variables are omitted)
+ */
+export function captureThemeVars(names: readonly string[]): Record<string, string> {
+  const snapshot: Record<string, string> = {};
+  if (typeof document === 'undefined') return snapshot;
+
+  const style = getComputedStyle(document.documentElement);
+  for (const name of names) {
+    const value = style.getPropertyValue(name).trim();
+    if (value) snapshot[name] = value;
+  }
+  return snapshot;
+}
@@ -1,6 +1,8 @@
 // src/visualizer/types.ts
 // TypeScript interfaces for circuit data (Story 6.2)
 
+import type { SceneAppearance, SceneView } from './CircuitScene';
+
 /**
  * Represents a connection port on a gate (input or output).
  * Links to a specific bit on a wire.
@@ -70,3 +72,123 @@ export interface CircuitData {
  * Used for type-safe gate type filtering.
  */
 export type GateType = 'AND' | 'OR' | 'NOT' | 'BUF' | 'DFF' | 'XOR';
+
+/* ============================================================================
+ * Circuit Render Worker Message Protocol
+ * ============================================================================ */
+
+/**
+ * Command to take over a canvas transferred with transferControlToOffscreen().
+ */
+export interface RenderInitCommand {
+  type: 'INIT';
+  payload: {
+    /** The canvas's offscreen drawing surface */
+    canvas: OffscreenCanvas;
+    /** Theme variable values captured on the main thread */
+    theme: Record<string, string>;
+  };
+}
+
+/**
+ * Command to replace the theme variable snapshot.
+ */
+export interface RenderSetThemeCommand {
+  type: 'SET_THEME';
+  payload: {
+    /** Theme variable values captured on the main thread */
+    theme: Record<string, string>;
+  };
+}
+
+/**
+ * Command to load (or replace) the circuit. A circuit with the same
+ * structure keeps the current layout and only updates wire states.
+ */
+export interface RenderLoadCircuitCommand {
+  type: 'LOAD_CIRCUIT';
+  payload: {
+    circuitData: CircuitData;
+  };
+}
+
+/**
+ * Command to draw a frame. Frames are coalesced: only the latest view and
+ * appearance are drawn, once per animation frame.
+ */
+export interface RenderFrameCommand {
+  type: 'RENDER';
+  payload: {
+    view: SceneView;
+    appearance: SceneAppearance;
+  };
+}
+
+/**
+ * Command to receive emulator STATE_UPDATE events directly on a port,
+ * so wire state changes never pass through the UI thread.
+ */
+export interface RenderConnectStatePortCommand {
+  type: 'CONNECT_STATE_PORT';
+  payload: {
+    port: MessagePort;
+  };
+}
+
+/**
+ * Command to find the gate at a point in layout coordinates.
+ */
+export interface RenderHitTestCommand {
+  type: 'HIT_TEST';
+  payload: {
+    /** Echoed back in the result so stale answers can be dropped */
+    requestId: number;
+    x: number;
+    y: number;
+  };
+}
+
+/**
+ * Union of all render worker commands (main → worker).
+ */
+export type RenderWorkerCommand =
+  | RenderInitCommand
+  | RenderSetThemeCommand
+  | RenderLoadCircuitCommand
+  | RenderFrameCommand
+  | RenderConnectStatePortCommand
+  | RenderHitTestCommand;
+
+/**
+ * Event sent when the layout was recalculated, with the new content size.
+ */
+export interface RenderLayoutChangedEvent {
+  type: 'LAYOUT_CHANGED';
+  payload: {
+    bounds: { width: number; height: number } | null;
+  };
+}
+
+/**
+ * Event sent after a frame was drawn.
+ */
+export interface RenderFrameCompleteEvent {
+  type: 'FRAME_COMPLETE';
+}
+
+/**
+ * Event answering a HIT_TEST command.
+ */
+export interface RenderHitResultEvent {
+  type: 'HIT_RESULT';
+  payload: {
+    requestId: number;
+    /** Gate at the point, or null for background */
+    gateId: number | null;
+  };
+}
+
+/**
+ * Union of all render worker events (worker → main).
+ */
+export type RenderWorkerEvent = RenderLayoutChangedEvent | RenderFrameCompleteEvent | RenderHitResultEvent;
@@ -1,6 +1,8 @@
 // src/visualizer/wireColors.ts
 // Wire color constants and lookup function (Story 6.4)
 
+import { readThemeVar } from './themeVars';
+
 /**
  * Default wire colors matching CSS variables.
  * Used as fallback when CSS variables are not available (e.g., in tests).
@@ -44,12 +46,9 @@ export function getWireColor(signalValue: number): string {
   }
 
   // Try to get color from CSS variables
-  if (typeof document !== 'undefined') {
-    const style = getComputedStyle(document.documentElement);
-    const color = style.getPropertyValue(varName).trim();
-    if (color) {
-      return color;
-    }
+  const color = readThemeVar(varName);
+  if (color) {
+    return color;
   }
 
   return defaultColor;
@@ -7,6 +7,15 @@ import { createAliases } from './vite.aliases';
 // Handle both ESM and CJS module formats
 const monacoEditorPlugin = (monacoEditorPluginModule as unknown as { default: typeof monacoEditorPluginModule }).default || monacoEditorPluginModule;
 
+// Cross-origin isolation makes SharedArrayBuffer available, which the emulator
+// uses for its state ring. credentialless (rather than require-corp) still lets
+// the Google Fonts stylesheet load. Hosts that cannot send these headers fall
+// back to postMessage state updates.
+const crossOriginIsolationHeaders = {
+  'Cross-Origin-Opener-Policy': 'same-origin',
+  'Cross-Origin-Embedder-Policy': 'credentialless',
+};
+
 export default defineConfig({
   // Base path for GitHub Pages deployment
   // Set to '/' for custom domain or root deployment
@@ -22,4 +31,10 @@ export default defineConfig({
   resolve: {
     alias: createAliases(__dirname),
   },
+  server: {
+    headers: crossOriginIsolationHeaders,
+  },
+  preview: {
+    headers: crossOriginIsolationHeaders,
+  },
 });
@@ -32,7 +32,7 @@ static Micro4CPU g_cpu;
  */
 EMSCRIPTEN_KEEPALIVE
 void cpu_init_instance(void) {
-    cpu_init(&g_cpu);
+    m4_cpu_init(&g_cpu);
 }
 
 /**
@@ -41,7 +41,7 @@ void cpu_init_instance(void) {
  */
 EMSCRIPTEN_KEEPALIVE
 void cpu_reset_instance(void) {
-    cpu_reset(&g_cpu);
+    m4_cpu_reset(&g_cpu);
 }
 
 /**
@@ -51,7 +51,7 @@ void cpu_reset_instance(void) {
  */
 EMSCRIPTEN_KEEPALIVE
 int cpu_step_instance(void) {
-    return cpu_step(&g_cpu);
+    return m4_cpu_step(&g_cpu);
 }
 
 /**
@@ -67,7 +67,7 @@ int cpu_step_instance(void) {
 EMSCRIPTEN_KEEPALIVE
 void cpu_load_program_instance(const uint8_t* program, int size, uint8_t start_addr) {
     if (size < 0) return;  /* Silently ignore invalid size */
-    cpu_load_program(&g_cpu, program, (uint16_t)size, start_addr);
+    m4_cpu_load_program(&g_cpu, program, (uint16_t)size, start_addr);
 }
 
 /* ============================================================================
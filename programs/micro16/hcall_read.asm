@@ -0,0 +1,57 @@
+; hcall_read.asm - Test the Micro16 read-file hypercall sandbox
+; Tests: read file inside the sandbox, refused absolute and ".." paths
+;
+; Needs hypercalls enabled and a sandbox holding hcall_read.txt:
+;   micro16 run -H --hcall-root <dir> hcall_read.bin
+;
+; Prints the file's first line, then the error codes for the two paths
+; that escape the sandbox:
+;   <file contents>
+;   fffc fffc
+; Expected final state: BX = CX = 0xFFFC (HC_ERR_ACCESS)
+
+        .org 0x0100             ; Default PC start location
+
+START:
+        ; ===== read a file inside the sandbox =====
+        MOV AX, #5              ; HC_READ_FILE
+        MOV SI, #INSIDE
+        MOV DI, #BUF
+        MOV CX, #15
+        MOV DX, #0
+        INT #0x80
+
+        ; ===== ".." must not climb out =====
+        MOV AX, #5
+        MOV SI, #PARENT
+        MOV CX, #15
+        INT #0x80
+        ST AX, [ERR_PARENT]
+
+        ; ===== neither may an absolute path =====
+        MOV AX, #5
+        MOV SI, #ABSOLUTE
+        MOV CX, #15
+        INT #0x80
+        ST AX, [ERR_ABSOLUTE]
+
+        MOV AX, #4              ; HC_PRINT
+        MOV SI, #FORMAT
+        MOV BX, #ARGS
+        INT #0x80
+
+        LD BX, [ERR_PARENT]
+        LD CX, [ERR_ABSOLUTE]
+        HLT
+
+INSIDE: .db "hcall_read.txt", 0
+PARENT: .db "sub/../../hcall_read.txt", 0
+ABSOLUTE:
+        .db "/etc/hostname", 0
+FORMAT: .db "%s%x %x", 10, 0
+ARGS:   .dw BUF
+ERR_PARENT:
+        .dw 0
+ERR_ABSOLUTE:
+        .dw 0
+BUF:    .ds 16
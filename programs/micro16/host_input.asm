@@ -0,0 +1,40 @@
+; host_input.asm - Test console input in Micro16 host mode
+; Tests: WAIT for an external interrupt, parking and waking a session
+;
+; Run with input:  micro16 host host_input.bin -I <file>
+;
+; The program sleeps in WAIT with nothing scheduled, so its session
+; parks. For each input byte the host posts the byte at port 0x0040,
+; raises vector 0x41 and wakes the session; 0xFFFF marks the end of
+; the input. The handler sums the bytes into BX and counts them in CX.
+;
+; Expected final state for the input "hello": BX = 0x0214, CX = 5
+
+        .org 0x0100             ; Default PC start location
+
+START:
+        MOV AX, #INPUT_ISR      ; Vector 0x41 -> IVT 0x0104
+        ST AX, [0x0104]
+        MOV AX, CS
+        ST AX, [0x0106]
+        MOV BX, #0
+        MOV CX, #0
+        MOV DX, #0              ; DX = 1 once the input has ended
+        STI
+
+WAIT_LOOP:
+        WAIT
+        CMP DX, #0
+        JZ WAIT_LOOP
+        HLT
+
+INPUT_ISR:
+        IN AX, 0x0040
+        CMP AX, #0xFFFF
+        JZ INPUT_END
+        ADD BX, AX
+        INC CX
+        IRET
+INPUT_END:
+        MOV DX, #1
+        IRET
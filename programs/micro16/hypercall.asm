@@ -0,0 +1,52 @@
+; hypercall.asm - Test the Micro16 hypercall services
+; Tests: memset, memcpy, strlen and print hypercalls (INT 0x80 and port)
+;
+; Needs hypercalls enabled:  micro16 run -H hypercall.bin
+;
+; Builds "*****Micro16" in BUF with memset + memcpy, measures it with
+; strlen and prints:
+;   *****Micro16 has 12 chars (0xc)
+; Expected final state: DX = 0x000C, carry clear
+
+        .org 0x0100             ; Default PC start location
+
+START:
+        ; ===== memset: five '*' at BUF =====
+        MOV AX, #2              ; HC_MEMSET
+        MOV BX, #0x2A           ; '*'
+        MOV CX, #5
+        MOV DI, #BUF
+        INT #0x80
+
+        ; ===== memcpy: NAME (with its NUL) after them =====
+        MOV AX, #1              ; HC_MEMCPY
+        MOV SI, #NAME
+        MOV DI, #BUF_TAIL
+        MOV CX, #8
+        INT #0x80
+
+        ; ===== strlen: DX = length of BUF =====
+        MOV AX, #3              ; HC_STRLEN
+        MOV SI, #BUF
+        INT #0x80
+        MOV DX, AX
+        ST AX, [ARG_LEN]
+        ST AX, [ARG_HEX]
+
+        ; ===== print, through the port this time =====
+        MOV AX, #4              ; HC_PRINT
+        MOV SI, #FORMAT
+        MOV BX, #ARGS
+        OUT 0xFF12, AX
+        HLT
+
+NAME:   .db "Micro16", 0
+FORMAT: .db "%s has %d chars (0x%x)", 10, 0
+ARGS:   .dw BUF
+ARG_LEN:
+        .dw 0
+ARG_HEX:
+        .dw 0
+BUF:    .ds 5
+BUF_TAIL:
+        .ds 16
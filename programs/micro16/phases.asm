@@ -0,0 +1,73 @@
+; phases.asm - Phased workload for Micro16 sampled simulation
+; Tests: `micro16 sample` basic-block clustering and extrapolation
+;
+; Repeats three phases with different behaviour six times:
+;   A. Tight arithmetic loop (one hot block, predictable branch)
+;   B. Word copy loop between two buffers (loads/stores)
+;   C. Subroutine calls with an alternating branch (hard to predict)
+;      to a routine that maps onto the caller's I-cache lines (misses)
+; Each phase spans several 1000-instruction intervals, so clustering
+; should find one cluster per phase.
+;
+; Usage: micro16 sample -i 1000 -k 3 --full phases.bin
+
+        .org 0x0100             ; Default PC start location
+
+START:
+        MOV R7, #6              ; Outer repetitions
+
+OUTER:
+        ; ===== Phase A: arithmetic =====
+        MOV CX, #3000
+        MOV AX, #1
+PHASE_A:
+        ADD AX, #3
+        SHL AX, #1
+        DEC CX
+        JNZ PHASE_A
+
+        ; ===== Phase B: copy SRC to DST, 512 words, 4 times =====
+        MOV DX, #4
+COPY_PASS:
+        MOV SI, #SRC
+        MOV DI, #DST
+        MOV CX, #512
+PHASE_B:
+        LD AX, [SI+0]
+        ST AX, [DI+0]
+        ADD SI, #2
+        ADD DI, #2
+        DEC CX
+        JNZ PHASE_B
+        DEC DX
+        JNZ COPY_PASS
+
+        ; ===== Phase C: calls with an alternating branch =====
+        MOV CX, #1500
+        MOV BX, #0
+PHASE_C:
+        CALL STEP
+        DEC CX
+        JNZ PHASE_C
+
+        DEC R7
+        JNZ OUTER
+        HLT
+
+        .org 0x0400
+SRC:    .ds 1024
+DST:    .ds 1024
+
+; BX += 1 on even CX, BX += 3 on odd CX
+; Placed 3 KB above PHASE_C (0x0149) so both fall on the same lines of
+; the 1 KB direct-mapped I-cache and every call and return misses
+        .org 0x0D40
+STEP:
+        MOV AX, CX
+        AND AX, #1
+        JZ STEP_EVEN
+        ADD BX, #3
+        RET
+STEP_EVEN:
+        INC BX
+        RET
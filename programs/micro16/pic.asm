@@ -0,0 +1,109 @@
+; pic.asm - Test the Micro16 priority interrupt controller
+; Tests: PIC mask/request/in-service registers, priority, nesting, EOI
+;
+; Lines are raised in software through the IRR port. Each handler
+; appends its line number to BX as one hex digit, so BX records the
+; order in which handlers started.
+;
+; Sequence:
+;   1. Lines 3, 1 and 2 raised with interrupts off, then STI
+;      -> served by priority: 1, 2, 3
+;   2. Line 4 raised; its handler raises line 6 (lower priority, must
+;      wait) and line 0 (higher priority, nests), then enables interrupts
+;      -> 4, 0, then 6 after line 4's EOI
+;   3. Line 7 is masked, so it stays pending in IRR
+;
+; Expected final state: BX = 0x0123 from step 1, AX = 0x0406 from
+; step 2 (digits 4, 0, 6), DX = 0x0080 (line 7 still requested)
+
+        .org 0x0100             ; Default PC start location
+
+START:
+        CLI
+        ; Lines 0-15 raise vectors 0x30-0x3F (IVT 0x00C0-0x00FF)
+        MOV AX, #ISR0
+        ST AX, [0x00C0]
+        MOV AX, #ISR1
+        ST AX, [0x00C4]
+        MOV AX, #ISR2
+        ST AX, [0x00C8]
+        MOV AX, #ISR3
+        ST AX, [0x00CC]
+        MOV AX, #ISR4
+        ST AX, [0x00D0]
+        MOV AX, #ISR6
+        ST AX, [0x00D8]
+        MOV AX, CS
+        ST AX, [0x00C2]
+        ST AX, [0x00C6]
+        ST AX, [0x00CA]
+        ST AX, [0x00CE]
+        ST AX, [0x00D2]
+        ST AX, [0x00DA]
+
+        MOV AX, #0x0080         ; Unmask every line but 7
+        OUT 0xFF0A, AX
+
+        ; ===== Step 1: priority order =====
+        MOV BX, #0
+        MOV AX, #0x000E         ; Lines 3, 2, 1
+        OUT 0xFF0C, AX
+        STI
+        NOP                     ; All three are served here
+        ST BX, [ORDER1]
+
+        ; ===== Step 2: nesting =====
+        MOV BX, #0
+        MOV AX, #0x0010         ; Line 4
+        OUT 0xFF0C, AX
+        NOP
+        ST BX, [ORDER2]
+
+        ; ===== Step 3: masked line stays pending =====
+        MOV AX, #0x0080         ; Line 7
+        OUT 0xFF0C, AX
+        NOP
+        IN DX, 0xFF0C           ; DX = IRR
+
+        LD AX, [ORDER2]
+        LD BX, [ORDER1]
+        HLT
+
+; Each ISR: BX = BX * 16 + line, then EOI
+ISR0:
+        SHL BX, #4
+        OR BX, #0
+        OUT 0xFF08, BX
+        IRET
+ISR1:
+        SHL BX, #4
+        OR BX, #1
+        OUT 0xFF08, BX
+        IRET
+ISR2:
+        SHL BX, #4
+        OR BX, #2
+        OUT 0xFF08, BX
+        IRET
+ISR3:
+        SHL BX, #4
+        OR BX, #3
+        OUT 0xFF08, BX
+        IRET
+ISR4:
+        SHL BX, #4
+        OR BX, #4
+        MOV CX, #0x0041         ; Lines 6 and 0
+        OUT 0xFF0C, CX
+        STI                     ; Line 0 nests here, line 6 must wait
+        NOP
+        OUT 0xFF08, BX          ; EOI for line 4
+        IRET                    ; Line 6 is taken after this
+ISR6:
+        SHL BX, #4
+        OR BX, #6
+        OUT 0xFF08, BX
+        IRET
+
+ORDER1: .dw 0
+ORDER2: .dw 0
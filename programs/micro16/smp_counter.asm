@@ -0,0 +1,46 @@
+; smp_counter.asm - Locked shared counter for the Micro16 SMP runner
+; Tests: LOCK INC, LOCK ADD, LOCK XCHG, core ID / core count ports
+;
+; Every core adds 1000 to COUNTER with LOCK INC, then checks in on DONE.
+; Core 0 waits until all cores have checked in and leaves the final
+; count in AX, so `micro16 smp -n 4 smp_counter.bin` ends with
+; AX=0FA0 (4 x 1000) on core 0 whatever order the cores ran in.
+;
+; Usage: micro16 smp [-n cores] [-d] smp_counter.bin
+
+        .org 0x0100             ; Default PC start location
+
+START:
+        IN BX, 0xFF00           ; BX = this core's ID
+        IN DX, 0xFF02           ; DX = number of cores
+
+        MOV CX, #1000           ; Iterations per core
+INC_LOOP:
+        LOCK INC [COUNTER]      ; Atomic COUNTER++
+        DEC CX
+        JNZ INC_LOOP
+
+        ; Check in: DONE += 1
+        MOV AX, #1
+        LOCK ADD [DONE], AX
+
+        CMP BX, #0
+        JNZ FINISHED            ; Only core 0 collects the result
+
+WAIT_ALL:
+        LD AX, [DONE]
+        CMP AX, DX
+        JNZ WAIT_ALL
+
+        ; Swap the count out, leaving COUNTER = 0 for a rerun
+        MOV AX, #0
+        LOCK XCHG AX, [COUNTER]
+
+FINISHED:
+        HLT
+
+        .org 0x0200
+COUNTER:
+        .dw 0
+DONE:
+        .dw 0
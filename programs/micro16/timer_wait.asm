@@ -0,0 +1,41 @@
+; timer_wait.asm - Idle guest driven by the CPU timer for Micro16
+; Tests: PORT_TIMER one-shot timer, WAIT, HLT waiting on a pending timer
+;
+; The main loop sleeps in WAIT between 100 timer ticks of 50000 cycles
+; each. The emulator skips straight to each deadline, so the 5M guest
+; cycles take almost no host time. A final tick is armed before HLT,
+; which waits for it instead of stopping the CPU.
+;
+; Expected final state: BX = 0x0065 (101 ticks), CPU halted
+
+        .org 0x0100             ; Default PC start location
+
+START:
+        CLI
+        MOV AX, #TIMER_ISR      ; Timer raises vector 0x08 by default
+        ST AX, [0x0020]         ; Vector 0x08 offset
+        MOV AX, CS
+        ST AX, [0x0022]         ; Vector 0x08 segment
+
+        MOV BX, #0              ; Tick counter
+        MOV DX, #50000          ; Cycles per tick
+        OUT 0xFF04, DX          ; Arm the timer
+        STI
+
+IDLE:
+        WAIT                    ; Sleep until the next tick
+        CMP BX, #100
+        JNZ IDLE
+
+        ; One more tick: HLT waits for it because it is pending
+        OUT 0xFF04, DX
+        HLT
+        HLT                     ; Nothing pending any more: really halt
+
+TIMER_ISR:
+        INC BX
+        CMP BX, #100
+        JNC ISR_DONE            ; Stop re-arming from tick 100 on
+        OUT 0xFF04, DX          ; Re-arm for the next tick
+ISR_DONE:
+        IRET
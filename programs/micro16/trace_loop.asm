@@ -0,0 +1,15 @@
+; trace_loop.asm - Countdown loop for debugger tracepoint tests
+; Runs 5000 iterations, more than the 4096-record trace buffer holds.
+; Expected: AX = 0x1388, CX = 0
+;
+; Micro16 Architecture Test Program
+
+        .org 0x0100             ; Default PC start location
+
+START:
+        MOV CX, #5000           ; Iterations
+LOOP1:
+        INC AX                  ; 0x0104: loop head
+        DEC CX
+        JNZ LOOP1
+        HLT                     ; 0x010B
@@ -0,0 +1,19 @@
+; trace_loop.asm - Nested countdown for debugger tracepoint tests
+; Inner loop runs 255 times per outer pass, 20 passes: 5100 inner
+; iterations, more than the 4096-record trace buffer holds.
+;
+; Micro8 Architecture Test Program
+
+        .org 0x0200             ; Start after reserved area
+
+START:
+        LDI R1, 20              ; Outer passes
+OUTER:
+        LDI R0, 0               ; Inner counter
+INNER:
+        INC R0                  ; 0x0204: inner loop head
+        CMPI R0, 255
+        JNZ INNER
+        DEC R1
+        JNZ OUTER               ; 0x020B: once per outer pass
+        HLT
@@ -0,0 +1,80 @@
+# Compare benchmark results against a baseline (see Makefile `bench`)
+#
+# Usage: awk -F, -v threshold=15 [-v idle="prog ..."] -f bench-compare.awk \
+#            baseline.csv results.csv
+#
+# Prints MIPS per program and per CPU next to the baseline. Programs
+# that slowed down by more than `threshold` percent are flagged; the
+# run fails when a CPU's total MIPS (all its instructions over all its
+# time) drops by more than that, since single short programs are noisy.
+# Programs listed in `idle` are shown but kept out of the totals.
+
+BEGIN {
+    n = split(idle, names, " ")
+    for (i = 1; i <= n; i++) is_idle[names[i]] = 1
+}
+
+FNR == 1 { next }
+
+NR == FNR {
+    base_mips[$1 "," $2] = $7
+    if (!($2 in is_idle)) {
+        base_instr[$1] += $4
+        base_time[$1] += $6
+    }
+    next
+}
+
+{
+    key = $1 "," $2
+    if (!($1 in instr)) cpus[++ncpus] = $1
+    note = ($9 != "ok") ? $9 : ""
+    if ($2 in is_idle) {
+        note = note " idle, not in totals"
+    } else {
+        instr[$1] += $4
+        cycles[$1] += $5
+        time[$1] += $6
+    }
+    change = ""
+    if (key in base_mips && base_mips[key] > 0) {
+        pct = ($7 - base_mips[key]) / base_mips[key] * 100
+        change = sprintf("%+6.1f%%", pct)
+        if (pct < -threshold) note = note " slower"
+    } else {
+        change = "    new"
+    }
+    rows[++nrows] = sprintf("%-8s %-18s %10.2f %10.2f  %s %s", $1, $2, $7,
+                            (key in base_mips) ? base_mips[key] : 0, change, note)
+}
+
+END {
+    printf "%-8s %-18s %10s %10s  %s\n", "CPU", "Program", "MIPS", "Baseline", "Change"
+    for (i = 1; i <= nrows; i++) print rows[i]
+
+    printf "\n%-8s %10s %12s %10s %10s  %s\n", "CPU", "Wall s", "M cycles/s", "MIPS", "Baseline", "Change"
+    failed = 0
+    for (i = 1; i <= ncpus; i++) {
+        c = cpus[i]
+        mips = time[c] > 0 ? instr[c] / time[c] / 1e6 : 0
+        mcps = time[c] > 0 ? cycles[c] / time[c] / 1e6 : 0
+        base = base_time[c] > 0 ? base_instr[c] / base_time[c] / 1e6 : 0
+        status = ""
+        change = "    new"
+        if (base > 0) {
+            pct = (mips - base) / base * 100
+            change = sprintf("%+6.1f%%", pct)
+            if (pct < -threshold) {
+                status = "REGRESSION"
+                failed = 1
+            }
+        }
+        printf "%-8s %10.3f %12.2f %10.2f %10.2f  %s %s\n", c, time[c], mcps, mips, base, change, status
+    }
+
+    if (failed) {
+        printf "\nFAIL: MIPS dropped more than %s%% against the baseline\n", threshold
+        exit 1
+    }
+    printf "\nPASS: within %s%% of the baseline\n", threshold
+}
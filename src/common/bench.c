@@ -0,0 +1,104 @@
+/*
+ * Guest Benchmark Support - Implementation
+ */
+
+#define _GNU_SOURCE
+#include "bench.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_CSV_HEADER "cpu,program,iterations,instructions,cycles,wall_s,mips,mcps,status"
+
+double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int bench_dirty_spans(const uint8_t *image, const uint8_t *memory, uint32_t size,
+                      BenchSpan *spans, int max) {
+    int n = 0;
+
+    for (uint32_t page = 0; page < size; page += BENCH_PAGE_SIZE) {
+        uint32_t len = size - page < BENCH_PAGE_SIZE ? size - page : BENCH_PAGE_SIZE;
+        if (memcmp(image + page, memory + page, len) == 0) continue;
+
+        if (n > 0 && spans[n - 1].start + spans[n - 1].length == page) {
+            spans[n - 1].length += len;
+        } else if (n < max) {
+            spans[n].start = page;
+            spans[n].length = len;
+            n++;
+        } else {
+            spans[0].start = 0;
+            spans[0].length = size;
+            return 1;
+        }
+    }
+    return n;
+}
+
+/* "../../programs/micro8/fibonacci.bin" -> "fibonacci" */
+static void program_name(const char *path, char *out, size_t size) {
+    const char *base = strrchr(path, '/');
+    base = base ? base + 1 : path;
+    snprintf(out, size, "%s", base);
+
+    char *dot = strrchr(out, '.');
+    if (dot != NULL && dot != out) {
+        *dot = '\0';
+    }
+}
+
+static double rate_millions(uint64_t count, double seconds) {
+    return seconds > 0.0 ? (double)count / seconds / 1e6 : 0.0;
+}
+
+bool bench_write_csv(const BenchResult *r, const char *csv_path) {
+    FILE *f = stdout;
+    bool header = true;
+
+    if (csv_path != NULL) {
+        f = fopen(csv_path, "a");
+        if (f == NULL) {
+            printf("Error: Cannot open '%s' for writing\n", csv_path);
+            return false;
+        }
+        fseek(f, 0, SEEK_END);
+        header = ftell(f) == 0;
+    }
+
+    char name[64];
+    program_name(r->program, name, sizeof(name));
+
+    if (header) {
+        fprintf(f, "%s\n", BENCH_CSV_HEADER);
+    }
+    fprintf(f, "%s,%s,%d,%llu,%llu,%.6f,%.3f,%.3f,%s\n",
+            r->cpu, name, r->iterations,
+            (unsigned long long)r->instructions, (unsigned long long)r->cycles,
+            r->seconds,
+            rate_millions(r->instructions, r->seconds),
+            rate_millions(r->cycles, r->seconds),
+            r->status);
+
+    if (f != stdout) {
+        fclose(f);
+    }
+    return true;
+}
+
+void bench_print_summary(const BenchResult *r) {
+    char name[64];
+    program_name(r->program, name, sizeof(name));
+
+    printf("%-8s %-14s %d iterations, %llu instructions, %llu cycles in %.3f s "
+           "(%.2f MIPS, %.2f M cycles/s) [%s]\n",
+           r->cpu, name, r->iterations,
+           (unsigned long long)r->instructions, (unsigned long long)r->cycles,
+           r->seconds,
+           rate_millions(r->instructions, r->seconds),
+           rate_millions(r->cycles, r->seconds),
+           r->status);
+}
@@ -0,0 +1,68 @@
+/*
+ * Guest Benchmark Support
+ *
+ * Shared by the `bench` command of every CPU emulator. A benchmark runs
+ * one program to completion again and again from a fresh image and
+ * appends one CSV row per program to a results file:
+ *
+ *   cpu,program,iterations,instructions,cycles,wall_s,mips,mcps,status
+ *
+ * Micro4 and Micro8 programs are a few dozen instructions long, so they
+ * time the whole repeat loop with one clock pair, resets included, after
+ * an untimed first run. Micro4 reloads its 256-nibble image; Micro8
+ * copies back only the pages the first run dirtied (bench_dirty_spans),
+ * since runs are deterministic and every run dirties the same pages.
+ * Micro16 restores a full 1 MB snapshot and times each cpu_run alone.
+ *
+ * status is "ok" when every iteration halted cleanly, "error" when the
+ * CPU reported an error, and "timeout" when an iteration used up its
+ * cycle budget (the bench command's -c) without halting. The run stops
+ * at the first iteration that does not end in "ok", and a timed-out run
+ * is not timed.
+ *
+ * src/Makefile `bench` drives this over programs/ and compares the
+ * results against bench-baseline.csv.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define BENCH_DEFAULT_REPEAT    1000
+#define BENCH_PAGE_SIZE         256     /* Restore granularity */
+#define BENCH_MAX_SPANS         32
+
+typedef struct {
+    const char *cpu;            /* "micro4", "micro8", ... */
+    const char *program;        /* Path; the row uses its base name */
+    int         iterations;     /* Completed */
+    uint64_t    instructions;
+    uint64_t    cycles;
+    double      seconds;        /* Timed runs (see above) */
+    const char *status;         /* "ok", "error" or "timeout" */
+} BenchResult;
+
+/* A stretch of guest memory to restore between runs */
+typedef struct {
+    uint32_t start;
+    uint32_t length;
+} BenchSpan;
+
+/* Monotonic wall clock in seconds */
+double bench_now(void);
+
+/* Find the BENCH_PAGE_SIZE pages where memory differs from image, merged
+ * into spans. Returns the number of spans; if they do not fit in max,
+ * returns one span covering all of memory. */
+int bench_dirty_spans(const uint8_t *image, const uint8_t *memory, uint32_t size,
+                      BenchSpan *spans, int max);
+
+/* Append a row to csv_path (NULL: stdout), writing the header to a new file */
+bool bench_write_csv(const BenchResult *r, const char *csv_path);
+
+/* One-line human summary on stdout */
+void bench_print_summary(const BenchResult *r);
+
+#endif /* BENCH_H */
@@ -0,0 +1,82 @@
+/*
+ * Embeddable CPU Core Interface - Shared Helpers
+ */
+
+#include "core.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const CoreVTable *const cores[] = { &m4_core, &m8_core, &m16_core };
+
+const CoreVTable *core_find(const char *name) {
+    for (size_t i = 0; i < sizeof(cores) / sizeof(cores[0]); i++) {
+        if (strcmp(cores[i]->name, name) == 0) {
+            return cores[i];
+        }
+    }
+    return NULL;
+}
+
+Core *core_create(const CoreVTable *vt) {
+    Core *core = malloc(sizeof(Core));
+    void *cpu = calloc(1, vt->cpu_size);
+    if (core == NULL || cpu == NULL || !vt->init(cpu)) {
+        free(cpu);
+        free(core);
+        return NULL;
+    }
+    core->vt = vt;
+    core->cpu = cpu;
+    return core;
+}
+
+void core_destroy(Core *core) {
+    if (core == NULL) return;
+    if (core->vt->free) {
+        core->vt->free(core->cpu);
+    }
+    free(core->cpu);
+    free(core);
+}
+
+int core_register_index(const Core *core, const char *name) {
+    for (int i = 0; i < core->vt->num_registers; i++) {
+        if (strcmp(core->vt->registers[i].name, name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+uint32_t core_get_register(const Core *core, int index) {
+    const CoreRegister *reg = &core->vt->registers[index];
+    const uint8_t *p = (const uint8_t *)core->cpu + reg->offset;
+
+    switch (reg->size) {
+    case 1: return *p;
+    case 2: { uint16_t v; memcpy(&v, p, 2); return v; }
+    default: { uint32_t v; memcpy(&v, p, 4); return v; }
+    }
+}
+
+void core_set_register(Core *core, int index, uint32_t value) {
+    const CoreRegister *reg = &core->vt->registers[index];
+    uint8_t *p = (uint8_t *)core->cpu + reg->offset;
+    if (reg->bits < 32) {
+        value &= (1u << reg->bits) - 1;
+    }
+
+    switch (reg->size) {
+    case 1: *p = (uint8_t)value; break;
+    case 2: { uint16_t v = (uint16_t)value; memcpy(p, &v, 2); break; }
+    default: memcpy(p, &value, 4); break;
+    }
+}
+
+void *core_snapshot(const Core *core) {
+    void *buf = malloc(core->vt->snapshot_size);
+    if (buf != NULL) {
+        core->vt->snapshot_save(core->cpu, buf);
+    }
+    return buf;
+}
@@ -0,0 +1,126 @@
+/*
+ * Embeddable CPU Core Interface
+ *
+ * One shape for every emulator core, so a host (batch runner, profiler,
+ * scheduler, visualizer bridge) is written once and drives Micro4,
+ * Micro8 and Micro16 alike, all linked into the same process:
+ * - Each core exports a CoreVTable (m4_core, m8_core, m16_core)
+ * - Every global symbol a core defines carries its prefix (m4_, m8_,
+ *   m16_), so the three link together; `make -C src libcores.a` builds
+ *   them into one static library
+ * - Registers are described by a table of name/width/offset entries,
+ *   so hosts can list and edit them without knowing the CPU struct
+ * - Memory is exposed as a raw view; Micro4 cells hold one nibble each
+ * - Snapshots are flat buffers of snapshot_size bytes
+ * - Events: interrupts and, where the core has a scheduler, timed
+ *   interrupts; either entry is NULL when the core has no such thing
+ */
+
+#ifndef CORE_H
+#define CORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Why run_until returned */
+typedef enum {
+    CORE_LIMIT = 0,     /* Reached the cycle limit */
+    CORE_HALTED,        /* Executed HLT */
+    CORE_IDLE,          /* Waiting for an interrupt with nothing scheduled */
+    CORE_ERROR          /* See CoreVTable.error */
+} CoreStop;
+
+typedef struct {
+    const char *name;   /* As the assembler spells it */
+    uint8_t  bits;      /* Architectural width */
+    uint8_t  size;      /* Storage size in the CPU struct: 1, 2 or 4 bytes */
+    uint16_t offset;    /* Byte offset in the CPU struct */
+} CoreRegister;
+
+typedef struct {
+    uint8_t *base;
+    uint32_t size;      /* Cells */
+    uint8_t  cell_bits; /* Bits used per cell (4 for Micro4, else 8) */
+} CoreMemory;
+
+typedef struct CoreVTable {
+    const char *name;
+    size_t cpu_size;    /* Bytes to allocate for the CPU struct */
+
+    /* Lifecycle */
+    bool (*init)(void *cpu);
+    void (*free)(void *cpu);
+    void (*reset)(void *cpu);   /* Registers only; memory is kept */
+
+    /* Copy an image to the core's default load address */
+    bool (*load)(void *cpu, const uint8_t *image, uint32_t size);
+
+    /* Run until the cycle counter reaches cycle_limit or the core stops */
+    CoreStop (*run_until)(void *cpu, uint64_t cycle_limit);
+
+    CoreMemory (*memory)(void *cpu);
+    void (*counters)(const void *cpu, uint64_t *cycles, uint64_t *instructions);
+    const char *(*error)(const void *cpu);  /* Message, or NULL */
+
+    /* Register descriptor table */
+    const CoreRegister *registers;
+    int num_registers;
+
+    /* Snapshots */
+    size_t snapshot_size;
+    void (*snapshot_save)(const void *cpu, void *buf);
+    void (*snapshot_restore)(void *cpu, const void *buf);
+
+    /* Events (NULL if unsupported) */
+    void (*interrupt)(void *cpu, uint8_t vector);
+    bool (*schedule)(void *cpu, uint64_t delay, uint8_t vector);
+} CoreVTable;
+
+/* The cores */
+extern const CoreVTable m4_core;
+extern const CoreVTable m8_core;
+extern const CoreVTable m16_core;
+
+/* A core instance */
+typedef struct {
+    const CoreVTable *vt;
+    void *cpu;
+} Core;
+
+/* Look a core up by name ("micro4", "micro8", "micro16"); NULL if unknown */
+const CoreVTable *core_find(const char *name);
+
+/* Allocate and initialize; NULL on failure */
+Core *core_create(const CoreVTable *vt);
+void  core_destroy(Core *core);
+
+/* Register access through the descriptor table */
+int      core_register_index(const Core *core, const char *name);   /* -1 if none */
+uint32_t core_get_register(const Core *core, int index);
+void     core_set_register(Core *core, int index, uint32_t value);
+
+/* Snapshot into a newly allocated buffer (free() it); NULL on failure */
+void *core_snapshot(const Core *core);
+
+static inline void core_reset(Core *core) {
+    core->vt->reset(core->cpu);
+}
+
+static inline bool core_load(Core *core, const uint8_t *image, uint32_t size) {
+    return core->vt->load(core->cpu, image, size);
+}
+
+static inline CoreStop core_run_until(Core *core, uint64_t cycle_limit) {
+    return core->vt->run_until(core->cpu, cycle_limit);
+}
+
+static inline CoreMemory core_memory(Core *core) {
+    return core->vt->memory(core->cpu);
+}
+
+static inline void core_restore(Core *core, const void *snapshot) {
+    core->vt->snapshot_restore(core->cpu, snapshot);
+}
+
+#endif /* CORE_H */
@@ -0,0 +1,123 @@
+/*
+ * Host-Side Self-Profiler - Implementation
+ */
+
+#define _GNU_SOURCE
+#include "hostprof.h"
+
+#ifdef HOST_PROFILE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#if defined(HOSTPROF_RDTSC) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define HOSTPROF_USE_TSC 1
+#endif
+
+static HostProfTable *tables;
+static uint32_t rate;
+
+/* TSC calibration: wall time and TSC at the first sample */
+static uint64_t start_ns;
+static uint64_t start_ticks;
+
+static uint64_t wall_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+uint64_t hostprof_now(void) {
+#ifdef HOSTPROF_USE_TSC
+    return __rdtsc();
+#else
+    return wall_ns();
+#endif
+}
+
+/* Nanoseconds per tick, measured over the whole run */
+static double ns_per_tick(void) {
+#ifdef HOSTPROF_USE_TSC
+    uint64_t ticks = hostprof_now() - start_ticks;
+    return ticks > 0 ? (double)(wall_ns() - start_ns) / (double)ticks : 0.0;
+#else
+    return 1.0;
+#endif
+}
+
+static void report_table(const HostProfTable *t, double scale) {
+    int order[HOSTPROF_MAX_SLOTS];
+    double total_ns[HOSTPROF_MAX_SLOTS];
+    double sum = 0.0;
+    int n = 0;
+
+    for (int i = 0; i < t->num_slots; i++) {
+        const HostProfSlot *s = &t->slots[i];
+        if (s->events == 0) continue;
+        double per_event = s->sampled ? (double)s->ticks * scale / (double)s->sampled : 0.0;
+        total_ns[i] = per_event * (double)s->events;
+        sum += total_ns[i];
+        order[n++] = i;
+    }
+
+    /* Most expensive first (insertion sort; at most 256 entries) */
+    for (int i = 1; i < n; i++) {
+        int key = order[i];
+        int j = i - 1;
+        while (j >= 0 && total_ns[order[j]] < total_ns[key]) {
+            order[j + 1] = order[j];
+            j--;
+        }
+        order[j + 1] = key;
+    }
+
+    fprintf(stderr, "\n=== Host profile: %s (1 in %u timed) ===\n", t->title, rate);
+    fprintf(stderr, "%-12s %14s %10s %12s %7s\n", "Slot", "Events", "ns/event", "Total ms", "Share");
+    for (int k = 0; k < n; k++) {
+        int i = order[k];
+        const HostProfSlot *s = &t->slots[i];
+        char label[16];
+        if (t->slot_name) {
+            snprintf(label, sizeof(label), "%s", t->slot_name(i));
+        } else {
+            snprintf(label, sizeof(label), "0x%02X", i);
+        }
+        fprintf(stderr, "%-12s %14lu %10.1f %12.3f %6.1f%%\n",
+                label, (unsigned long)s->events,
+                s->sampled ? total_ns[i] / (double)s->events : 0.0,
+                total_ns[i] / 1e6,
+                sum > 0.0 ? 100.0 * total_ns[i] / sum : 0.0);
+    }
+    fprintf(stderr, "%-12s %14s %10s %12.3f\n", "Total", "", "", sum / 1e6);
+}
+
+static void report_all(void) {
+    double scale = ns_per_tick();
+    for (const HostProfTable *t = tables; t != NULL; t = t->next) {
+        report_table(t, scale);
+    }
+}
+
+uint64_t hostprof_arm(HostProfTable *t) {
+    if (rate == 0) {
+        const char *env = getenv("HOSTPROF_RATE");
+        rate = env ? (uint32_t)strtoul(env, NULL, 10) : HOSTPROF_DEFAULT_RATE;
+        if (rate == 0) rate = 1;
+        start_ns = wall_ns();
+        start_ticks = hostprof_now();
+        atexit(report_all);
+    }
+    if (!t->registered) {
+        t->registered = true;
+        t->next = tables;
+        tables = t;
+    }
+
+    t->countdown = rate - 1;
+    uint64_t now = hostprof_now();
+    return now != 0 ? now : 1;
+}
+
+#endif /* HOST_PROFILE */
@@ -0,0 +1,92 @@
+/*
+ * Host-Side Self-Profiler
+ *
+ * Measures where the emulators themselves spend host time, as opposed to
+ * what the guest program does. Built only with `make PROFILE=1` (or
+ * PROFILE=rdtsc), which defines HOST_PROFILE; otherwise every macro
+ * below compiles to nothing.
+ *
+ * A table holds one slot per event kind (opcode, gate type, memory
+ * helper). Every event is counted, and 1 in HOSTPROF_RATE events is
+ * timed (the HOSTPROF_RATE environment variable overrides the default).
+ * Totals are extrapolated from the timed sample. Tables register
+ * themselves on first use and are printed to stderr at exit.
+ *
+ * Not thread-safe: profile SMP runs in deterministic mode.
+ *
+ * Usage:
+ *   HOSTPROF_TABLE(op_prof, "Micro16 opcodes", 256, NULL);
+ *   ...
+ *   HOSTPROF_BEGIN(op_prof);
+ *   switch (opcode) { ... }
+ *   HOSTPROF_END(op_prof, opcode);
+ */
+
+#ifndef HOSTPROF_H
+#define HOSTPROF_H
+
+#ifdef HOST_PROFILE
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define HOSTPROF_MAX_SLOTS      256
+#ifndef HOSTPROF_DEFAULT_RATE
+#define HOSTPROF_DEFAULT_RATE   64
+#endif
+
+typedef struct {
+    uint64_t events;        /* Every event */
+    uint64_t sampled;       /* Events that were timed */
+    uint64_t ticks;         /* Timer ticks across the timed events */
+} HostProfSlot;
+
+typedef struct HostProfTable {
+    const char *title;
+    const char *(*slot_name)(int slot);     /* NULL: print the slot number */
+    int num_slots;
+    uint32_t countdown;                     /* Events until the next timed one */
+    bool registered;
+    struct HostProfTable *next;
+    HostProfSlot slots[HOSTPROF_MAX_SLOTS];
+} HostProfTable;
+
+#define HOSTPROF_TABLE(var, title, nslots, namefn) \
+    static HostProfTable var = { title, namefn, nslots, 0, false, NULL, {{0, 0, 0}} }
+
+/* Timer in ticks (nanoseconds, or TSC cycles with HOSTPROF_RDTSC) */
+uint64_t hostprof_now(void);
+
+/* Slow path of hostprof_start: registers the table, rearms the countdown */
+uint64_t hostprof_arm(HostProfTable *t);
+
+/* Returns a start timestamp if this event is timed, else 0 */
+static inline uint64_t hostprof_start(HostProfTable *t) {
+    if (t->countdown != 0) {
+        t->countdown--;
+        return 0;
+    }
+    return hostprof_arm(t);
+}
+
+static inline void hostprof_stop(HostProfTable *t, int slot, uint64_t start) {
+    HostProfSlot *s = &t->slots[slot];
+    s->events++;
+    if (start != 0) {
+        s->sampled++;
+        s->ticks += hostprof_now() - start;
+    }
+}
+
+#define HOSTPROF_BEGIN(t)       uint64_t hostprof_t0_ = hostprof_start(&(t))
+#define HOSTPROF_END(t, slot)   hostprof_stop(&(t), (slot), hostprof_t0_)
+
+#else
+
+#define HOSTPROF_TABLE(var, title, nslots, namefn)
+#define HOSTPROF_BEGIN(t)       ((void)0)
+#define HOSTPROF_END(t, slot)   ((void)0)
+
+#endif /* HOST_PROFILE */
+
+#endif /* HOSTPROF_H */
@@ -0,0 +1,214 @@
+/*
+ * Cooperative Time-Sliced Session Scheduler - Implementation
+ */
+
+#define _GNU_SOURCE
+#include "sched.h"
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+static uint64_t thread_cpu_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/* ========================================================================
+ * Run Queue (caller holds the lock)
+ * ======================================================================== */
+
+static void enqueue(Scheduler *s, SchedSession *session) {
+    session->next = NULL;
+    if (s->tail) {
+        s->tail->next = session;
+    } else {
+        s->head = session;
+    }
+    s->tail = session;
+    pthread_cond_signal(&s->work);
+}
+
+static SchedSession *dequeue(Scheduler *s) {
+    SchedSession *session = s->head;
+    if (session) {
+        s->head = session->next;
+        if (s->head == NULL) s->tail = NULL;
+    }
+    return session;
+}
+
+/* ========================================================================
+ * Workers
+ * ======================================================================== */
+
+static void *worker(void *arg) {
+    Scheduler *s = arg;
+
+    pthread_mutex_lock(&s->lock);
+    for (;;) {
+        while (s->head == NULL && !s->stop) {
+            pthread_cond_wait(&s->work, &s->lock);
+        }
+        if (s->stop) break;
+
+        SchedSession *session = dequeue(s);
+        session->running = true;
+        session->wake_pending = false;
+        s->running++;
+        pthread_mutex_unlock(&s->lock);
+
+        /* The slice runs unlocked; only this worker owns the session now */
+        uint64_t cycles = 0;
+        uint64_t t0 = thread_cpu_ns();
+        SessionState state = session->slice(session->core, s->quantum, &cycles);
+        uint64_t spent = thread_cpu_ns() - t0;
+
+        pthread_mutex_lock(&s->lock);
+        session->slices++;
+        session->cycles += cycles;
+        session->host_ns += spent;
+        session->running = false;
+        s->running--;
+
+        if (state == SESSION_IDLE && session->wake_pending) {
+            state = SESSION_RUNNABLE;   /* Woken during the slice */
+        }
+        session->state = state;
+
+        switch (state) {
+        case SESSION_RUNNABLE:
+            enqueue(s, session);
+            break;
+        case SESSION_IDLE:
+            s->idle++;
+            break;
+        case SESSION_DONE:
+            s->live--;
+            break;
+        }
+
+        if (s->head == NULL && s->running == 0) {
+            pthread_cond_broadcast(&s->quiet);
+        }
+    }
+    pthread_mutex_unlock(&s->lock);
+    return NULL;
+}
+
+/* ========================================================================
+ * Public API
+ * ======================================================================== */
+
+bool sched_init(Scheduler *s, int threads, int quantum) {
+    if (threads <= 0) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cores > 0 ? (int)cores : 1;
+    }
+    if (threads > SCHED_MAX_THREADS) threads = SCHED_MAX_THREADS;
+
+    s->quantum = quantum > 0 ? quantum : SCHED_DEFAULT_QUANTUM;
+    s->num_threads = 0;
+    s->head = s->tail = NULL;
+    s->running = s->idle = s->live = 0;
+    s->stop = false;
+
+    pthread_mutex_init(&s->lock, NULL);
+    pthread_cond_init(&s->work, NULL);
+    pthread_cond_init(&s->quiet, NULL);
+
+    for (int i = 0; i < threads; i++) {
+        if (pthread_create(&s->threads[i], NULL, worker, s) != 0) {
+            sched_shutdown(s);
+            return false;
+        }
+        s->num_threads++;
+    }
+    return true;
+}
+
+void sched_shutdown(Scheduler *s) {
+    pthread_mutex_lock(&s->lock);
+    s->stop = true;
+    pthread_cond_broadcast(&s->work);
+    pthread_mutex_unlock(&s->lock);
+
+    for (int i = 0; i < s->num_threads; i++) {
+        pthread_join(s->threads[i], NULL);
+    }
+    s->num_threads = 0;
+
+    pthread_mutex_destroy(&s->lock);
+    pthread_cond_destroy(&s->work);
+    pthread_cond_destroy(&s->quiet);
+}
+
+void sched_add(Scheduler *s, SchedSession *session, int id, void *core, SchedSliceFn slice) {
+    session->id = id;
+    session->core = core;
+    session->slice = slice;
+    session->state = SESSION_RUNNABLE;
+    session->wake_pending = false;
+    session->running = false;
+    session->slices = 0;
+    session->cycles = 0;
+    session->host_ns = 0;
+
+    pthread_mutex_lock(&s->lock);
+    s->live++;
+    enqueue(s, session);
+    pthread_mutex_unlock(&s->lock);
+}
+
+void sched_wake(Scheduler *s, SchedSession *session) {
+    pthread_mutex_lock(&s->lock);
+    if (session->running) {
+        session->wake_pending = true;
+    } else if (session->state == SESSION_IDLE) {
+        session->state = SESSION_RUNNABLE;
+        s->idle--;
+        enqueue(s, session);
+    }
+    pthread_mutex_unlock(&s->lock);
+}
+
+int sched_wait(Scheduler *s) {
+    pthread_mutex_lock(&s->lock);
+    while (s->head != NULL || s->running > 0) {
+        pthread_cond_wait(&s->quiet, &s->lock);
+    }
+    int idle = s->idle;
+    pthread_mutex_unlock(&s->lock);
+    return idle;
+}
+
+void sched_print_report(const SchedSession *sessions, int count, double wall_seconds) {
+    uint64_t cycles = 0, slices = 0, host_ns = 0;
+    uint64_t min_slices = UINT64_MAX, max_slices = 0;
+    uint64_t min_ns = UINT64_MAX, max_ns = 0;
+    int done = 0, idle = 0;
+
+    for (int i = 0; i < count; i++) {
+        const SchedSession *ss = &sessions[i];
+        cycles += ss->cycles;
+        slices += ss->slices;
+        host_ns += ss->host_ns;
+        if (ss->slices < min_slices) min_slices = ss->slices;
+        if (ss->slices > max_slices) max_slices = ss->slices;
+        if (ss->host_ns < min_ns) min_ns = ss->host_ns;
+        if (ss->host_ns > max_ns) max_ns = ss->host_ns;
+        if (ss->state == SESSION_DONE) done++;
+        if (ss->state == SESSION_IDLE) idle++;
+    }
+    if (count == 0) min_slices = min_ns = 0;
+
+    printf("\n=== Scheduler Report ===\n");
+    printf("Sessions:       %d (%d done, %d idle)\n", count, done, idle);
+    printf("Slices:         %lu (per session %lu..%lu)\n",
+           (unsigned long)slices, (unsigned long)min_slices, (unsigned long)max_slices);
+    printf("Guest cycles:   %lu (%.2f M/s)\n", (unsigned long)cycles,
+           wall_seconds > 0 ? (double)cycles / wall_seconds / 1e6 : 0.0);
+    printf("Host CPU time:  %.3f s over %.3f s wall\n", (double)host_ns / 1e9, wall_seconds);
+    printf("Per session:    %.3f..%.3f ms CPU\n", (double)min_ns / 1e6, (double)max_ns / 1e6);
+    printf("========================\n");
+}
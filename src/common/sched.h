@@ -0,0 +1,93 @@
+/*
+ * Cooperative Time-Sliced Session Scheduler
+ *
+ * Multiplexes many emulator sessions (one CPU instance each) over a
+ * fixed pool of host threads, so the number of sessions scales with
+ * host cores rather than needing a thread or process per session:
+ * - Sessions sit on a FIFO run queue; a worker takes the head, runs it
+ *   for one quantum of guest cycles and puts it back on the tail, so
+ *   every runnable session gets the same number of cycles per round
+ * - A slice can end with the session idle (waiting for input, stopped
+ *   at a breakpoint, WAIT with nothing scheduled); idle sessions leave
+ *   the run queue until sched_wake() is called from any thread
+ * - Finished sessions (halted or error) leave the scheduler for good
+ * - Every session accounts slices, guest cycles and host CPU time
+ *
+ * The scheduler does not know the CPU type: each session carries its
+ * core pointer and a slice function that runs it.
+ */
+
+#ifndef SCHED_H
+#define SCHED_H
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SCHED_MAX_THREADS       64
+#define SCHED_DEFAULT_QUANTUM   10000   /* Guest cycles per slice */
+
+typedef enum {
+    SESSION_RUNNABLE = 0,   /* On the run queue or running */
+    SESSION_IDLE,           /* Parked until sched_wake() */
+    SESSION_DONE            /* Halted or failed; never runs again */
+} SessionState;
+
+/*
+ * Run `core` for up to `quantum` guest cycles. Returns the cycles used
+ * and the state the session is in afterwards.
+ */
+typedef SessionState (*SchedSliceFn)(void *core, int quantum, uint64_t *cycles);
+
+typedef struct SchedSession {
+    int id;
+    void *core;
+    SchedSliceFn slice;
+
+    SessionState state;
+    bool wake_pending;          /* Woken while its slice was running */
+    bool running;
+
+    /* Accounting */
+    uint64_t slices;
+    uint64_t cycles;            /* Guest cycles */
+    uint64_t host_ns;           /* Host thread CPU time */
+
+    struct SchedSession *next;  /* Run queue link */
+} SchedSession;
+
+typedef struct {
+    int quantum;
+    int num_threads;
+    pthread_t threads[SCHED_MAX_THREADS];
+
+    pthread_mutex_t lock;
+    pthread_cond_t  work;       /* Run queue became non-empty, or stop */
+    pthread_cond_t  quiet;      /* Nothing runnable and nothing running */
+
+    SchedSession *head, *tail;  /* Run queue */
+    int running;                /* Slices in progress */
+    int idle;                   /* Parked sessions */
+    int live;                   /* Sessions not yet done */
+    bool stop;
+} Scheduler;
+
+/* Start `threads` workers (0 = one per online host core) */
+bool sched_init(Scheduler *s, int threads, int quantum);
+
+/* Stop the workers; sessions are left as they are */
+void sched_shutdown(Scheduler *s);
+
+/* Add a session; it becomes runnable at once */
+void sched_add(Scheduler *s, SchedSession *session, int id, void *core, SchedSliceFn slice);
+
+/* Make an idle session runnable again (I/O arrived, breakpoint resumed) */
+void sched_wake(Scheduler *s, SchedSession *session);
+
+/* Block until no session is runnable; returns the number still idle */
+int sched_wait(Scheduler *s);
+
+/* Totals and fairness across sessions */
+void sched_print_report(const SchedSession *sessions, int count, double wall_seconds);
+
+#endif /* SCHED_H */
@@ -690,6 +690,88 @@ static bool process_line(Assembler *as, char *line, bool pass2) {
         return true;
     }
 
+    /* LOCK prefix - atomic read-modify-write forms on a DS word */
+    if (strcasecmp(mnemonic, "LOCK") == 0) {
+        p = skip_whitespace(p);
+        char next_mnemonic[16];
+        int ni = 0;
+        while (p[ni] && isalnum((unsigned char)p[ni]) && ni < 15) {
+            next_mnemonic[ni] = p[ni];
+            ni++;
+        }
+        next_mnemonic[ni] = '\0';
+        p = skip_whitespace(p + ni);
+
+        int reg_len;
+        int reg = -1;
+        uint8_t op;
+        if (strcasecmp(next_mnemonic, "INC") == 0) {
+            op = OP_INC;
+        } else if (strcasecmp(next_mnemonic, "DEC") == 0) {
+            op = OP_DEC;
+        } else if (strcasecmp(next_mnemonic, "ADD") == 0) {
+            op = OP_ADD_RR;
+        } else if (strcasecmp(next_mnemonic, "XCHG") == 0) {
+            /* LOCK XCHG Rd, [addr] */
+            op = OP_XCHG;
+            reg = parse_register(p, &reg_len);
+            if (reg < 0) {
+                snprintf(as->error_msg, sizeof(as->error_msg), "Expected register");
+                as->error = true;
+                return false;
+            }
+            p = skip_whitespace(p + reg_len);
+            if (*p == ',') p++;
+            p = skip_whitespace(p);
+        } else {
+            snprintf(as->error_msg, sizeof(as->error_msg),
+                     "LOCK supports INC, DEC, ADD and XCHG, not: %s", next_mnemonic);
+            as->error = true;
+            return false;
+        }
+
+        /* Memory operand [addr] */
+        if (*p != '[') {
+            snprintf(as->error_msg, sizeof(as->error_msg), "LOCK needs a [addr] operand");
+            as->error = true;
+            return false;
+        }
+        p++;
+        uint32_t addr;
+        int addr_len = parse_operand(as, p, &addr, pass2);
+        if (addr_len == 0 && pass2) {
+            snprintf(as->error_msg, sizeof(as->error_msg), "Expected address");
+            as->error = true;
+            return false;
+        }
+
+        /* LOCK ADD [addr], Rs */
+        if (op == OP_ADD_RR) {
+            p += addr_len;
+            while (*p && *p != ']') p++;
+            if (*p == ']') p++;
+            p = skip_whitespace(p);
+            if (*p == ',') p++;
+            p = skip_whitespace(p);
+            reg = parse_register(p, &reg_len);
+            if (reg < 0) {
+                snprintf(as->error_msg, sizeof(as->error_msg), "Expected register");
+                as->error = true;
+                return false;
+            }
+        }
+
+        if (pass2) {
+            emit_byte(as, OP_LOCK);
+            emit_byte(as, op);
+            if (reg >= 0) emit_byte(as, (uint8_t)reg);
+            emit_word(as, (uint16_t)addr);
+        } else {
+            as->current_addr += (reg >= 0) ? 5 : 4;
+        }
+        return true;
+    }
+
     /* REPZ/REPE prefix */
     if (strcasecmp(mnemonic, "REPZ") == 0 || strcasecmp(mnemonic, "REPE") == 0) {
         p = skip_whitespace(p);
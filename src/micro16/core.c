@@ -0,0 +1,121 @@
+/*
+ * Micro16 Core Interface (see ../common/core.h)
+ */
+
+#include "cpu.h"
+#include "../common/core.h"
+#include <limits.h>
+#include <stddef.h>
+#include <string.h>
+
+static bool m16_core_init(void *cpu) {
+    return m16_cpu_init(cpu);
+}
+
+static void m16_core_free(void *cpu) {
+    m16_cpu_free(cpu);
+}
+
+static void m16_core_reset(void *cpu) {
+    m16_cpu_reset(cpu);
+}
+
+/* Images load at CS:PC after reset (physical 0x00100), like `micro16 run` */
+static bool m16_core_load(void *p, const uint8_t *image, uint32_t size) {
+    Micro16CPU *cpu = p;
+    uint32_t phys = seg_offset_to_phys(cpu->seg[SEG_CS], cpu->pc);
+    if (phys + size > MEM_SIZE) return false;
+    m16_cpu_load_program(cpu, image, size, phys);
+    return true;
+}
+
+static CoreStop m16_core_run_until(void *p, uint64_t cycle_limit) {
+    Micro16CPU *cpu = p;
+
+    while (!cpu->halted && !cpu->error && cpu->cycles < cycle_limit) {
+        if (m16_cpu_is_idle(cpu)) return CORE_IDLE;
+        uint64_t left = cycle_limit - cpu->cycles;
+        m16_cpu_run(cpu, left > INT_MAX ? INT_MAX : (int)left);
+    }
+
+    if (cpu->error) return CORE_ERROR;
+    if (cpu->halted) return CORE_HALTED;
+    return m16_cpu_is_idle(cpu) ? CORE_IDLE : CORE_LIMIT;
+}
+
+static CoreMemory m16_core_memory(void *p) {
+    Micro16CPU *cpu = p;
+    CoreMemory m = { cpu->memory, MEM_SIZE, 8 };
+    return m;
+}
+
+static void m16_core_counters(const void *p, uint64_t *cycles, uint64_t *instructions) {
+    const Micro16CPU *cpu = p;
+    *cycles = cpu->cycles;
+    *instructions = cpu->instructions;
+}
+
+static const char *m16_core_error(const void *p) {
+    const Micro16CPU *cpu = p;
+    return cpu->error ? cpu->error_msg : NULL;
+}
+
+/* Snapshot layout: the CPU struct, then all of memory */
+static void m16_core_snapshot_save(const void *p, void *buf) {
+    const Micro16CPU *cpu = p;
+    memcpy(buf, cpu, sizeof(Micro16CPU));
+    memcpy((uint8_t *)buf + sizeof(Micro16CPU), cpu->memory, MEM_SIZE);
+}
+
+static void m16_core_snapshot_restore(void *p, const void *buf) {
+    Micro16CPU *cpu = p;
+    uint8_t *memory = cpu->memory;
+    bool shared = cpu->shared_memory;
+
+    memcpy(cpu, buf, sizeof(Micro16CPU));
+    cpu->memory = memory;
+    cpu->shared_memory = shared;
+    memcpy(cpu->memory, (const uint8_t *)buf + sizeof(Micro16CPU), MEM_SIZE);
+}
+
+static void m16_core_interrupt(void *cpu, uint8_t vector) {
+    m16_cpu_request_interrupt(cpu, vector);
+}
+
+static bool m16_core_schedule(void *cpu, uint64_t delay, uint8_t vector) {
+    return m16_cpu_schedule_interrupt(cpu, delay, vector) >= 0;
+}
+
+#define REG16(name, field)  { name, 16, 2, offsetof(Micro16CPU, field) }
+
+static const CoreRegister registers[] = {
+    REG16("AX", r[REG_R0]), REG16("BX", r[REG_R1]), REG16("CX", r[REG_R2]),
+    REG16("DX", r[REG_R3]), REG16("SI", r[REG_R4]), REG16("DI", r[REG_R5]),
+    REG16("BP", r[REG_R6]), REG16("R7", r[REG_R7]),
+    REG16("CS", seg[SEG_CS]), REG16("DS", seg[SEG_DS]),
+    REG16("SS", seg[SEG_SS]), REG16("ES", seg[SEG_ES]),
+    REG16("PC", pc), REG16("SP", sp), REG16("FLAGS", flags),
+    { "IR", 8, 1, offsetof(Micro16CPU, ir) },
+    { "MAR", 20, 4, offsetof(Micro16CPU, mar) },
+    REG16("MDR", mdr),
+};
+
+const CoreVTable m16_core = {
+    .name = "micro16",
+    .cpu_size = sizeof(Micro16CPU),
+    .init = m16_core_init,
+    .free = m16_core_free,
+    .reset = m16_core_reset,
+    .load = m16_core_load,
+    .run_until = m16_core_run_until,
+    .memory = m16_core_memory,
+    .counters = m16_core_counters,
+    .error = m16_core_error,
+    .registers = registers,
+    .num_registers = sizeof(registers) / sizeof(registers[0]),
+    .snapshot_size = sizeof(Micro16CPU) + MEM_SIZE,
+    .snapshot_save = m16_core_snapshot_save,
+    .snapshot_restore = m16_core_snapshot_restore,
+    .interrupt = m16_core_interrupt,
+    .schedule = m16_core_schedule,
+};
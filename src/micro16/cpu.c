@@ -12,6 +12,8 @@
  */
 
 #include "cpu.h"
+#include "hypercall.h"
+#include "../common/hostprof.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -87,7 +89,7 @@ static void update_flags_logic(Micro16CPU *cpu, uint16_t result) {
  * CPU Lifecycle
  * ======================================================================== */
 
-bool cpu_init(Micro16CPU *cpu) {
+bool m16_cpu_init(Micro16CPU *cpu) {
     memset(cpu, 0, sizeof(Micro16CPU));
 
     cpu->memory = (uint8_t *)calloc(MEM_SIZE, sizeof(uint8_t));
@@ -97,18 +99,56 @@ bool cpu_init(Micro16CPU *cpu) {
         return false;
     }
 
-    cpu_reset(cpu);
+    cpu->core_count = 1;
+    m16_cpu_reset(cpu);
     return true;
 }
 
-void cpu_free(Micro16CPU *cpu) {
-    if (cpu->memory != NULL) {
+/*
+ * Initialize a CPU over memory it does not own (e.g. one core of an SMP
+ * system). m16_cpu_free() leaves the memory alone.
+ */
+void m16_cpu_init_shared(Micro16CPU *cpu, uint8_t *memory) {
+    memset(cpu, 0, sizeof(Micro16CPU));
+    cpu->memory = memory;
+    cpu->shared_memory = true;
+    cpu->core_count = 1;
+    m16_cpu_reset(cpu);
+}
+
+void m16_cpu_free(Micro16CPU *cpu) {
+    if (cpu->memory != NULL && !cpu->shared_memory) {
         free(cpu->memory);
-        cpu->memory = NULL;
     }
+    cpu->memory = NULL;
+}
+
+bool m16_cpu_snapshot_save(const Micro16CPU *cpu, Micro16Snapshot *snap) {
+    if (snap->memory == NULL) {
+        snap->memory = (uint8_t *)malloc(MEM_SIZE);
+        if (snap->memory == NULL) return false;
+    }
+    memcpy(snap->memory, cpu->memory, MEM_SIZE);
+    snap->cpu = *cpu;
+    return true;
+}
+
+void m16_cpu_snapshot_restore(Micro16CPU *cpu, const Micro16Snapshot *snap) {
+    uint8_t *memory = cpu->memory;
+    bool shared = cpu->shared_memory;
+
+    *cpu = snap->cpu;
+    cpu->memory = memory;
+    cpu->shared_memory = shared;
+    memcpy(cpu->memory, snap->memory, MEM_SIZE);
+}
+
+void m16_cpu_snapshot_free(Micro16Snapshot *snap) {
+    free(snap->memory);
+    snap->memory = NULL;
 }
 
-void cpu_reset(Micro16CPU *cpu) {
+void m16_cpu_reset(Micro16CPU *cpu) {
     /* Clear general purpose registers */
     for (int i = 0; i < 8; i++) {
         cpu->r[i] = 0;
@@ -126,8 +166,15 @@ void cpu_reset(Micro16CPU *cpu) {
     cpu->flags = 0;
 
     /* Clear interrupt state */
-    cpu->int_pending = false;
-    cpu->int_vector = 0;
+    m16_pic_reset(&cpu->pic);
+
+    /* Clear scheduled events */
+    for (int i = 0; i < MAX_EVENTS; i++) {
+        cpu->events[i].active = false;
+    }
+    cpu->next_event = NO_EVENT;
+    cpu->timer_slot = -1;
+    cpu->timer_vector = TIMER_DEFAULT_VECTOR;
 
     /* Clear internal registers */
     cpu->ir = 0;
@@ -145,11 +192,27 @@ void cpu_reset(Micro16CPU *cpu) {
     cpu->instructions = 0;
 }
 
+/* ========================================================================
+ * Host Self-Profiling (make PROFILE=1)
+ * ======================================================================== */
+
+enum { MEMPROF_READ, MEMPROF_WRITE, MEMPROF_SLOTS };
+
+#ifdef HOST_PROFILE
+static const char *mem_slot_name(int slot) {
+    static const char *names[MEMPROF_SLOTS] = { "read", "write" };
+    return names[slot];
+}
+
+HOSTPROF_TABLE(opcode_prof, "Micro16 opcodes", 256, NULL);
+HOSTPROF_TABLE(mem_prof, "Micro16 memory helpers", MEMPROF_SLOTS, mem_slot_name);
+#endif
+
 /* ========================================================================
  * Memory Operations - Physical Address
  * ======================================================================== */
 
-uint8_t cpu_read_phys_byte(Micro16CPU *cpu, uint32_t addr) {
+uint8_t m16_cpu_read_phys_byte(Micro16CPU *cpu, uint32_t addr) {
     if (addr >= MEM_SIZE) {
         cpu->error = true;
         snprintf(cpu->error_msg, sizeof(cpu->error_msg),
@@ -157,6 +220,7 @@ uint8_t cpu_read_phys_byte(Micro16CPU *cpu, uint32_t addr) {
         return 0;
     }
 
+    HOSTPROF_BEGIN(mem_prof);
     cpu->mar = addr;
     cpu->mdr = cpu->memory[addr];
 
@@ -165,16 +229,17 @@ uint8_t cpu_read_phys_byte(Micro16CPU *cpu, uint32_t addr) {
         /* TODO: Handle memory-mapped I/O reads */
     }
 
+    HOSTPROF_END(mem_prof, MEMPROF_READ);
     return cpu->memory[addr];
 }
 
-uint16_t cpu_read_phys_word(Micro16CPU *cpu, uint32_t addr) {
-    uint8_t low = cpu_read_phys_byte(cpu, addr);
-    uint8_t high = cpu_read_phys_byte(cpu, addr + 1);
+uint16_t m16_cpu_read_phys_word(Micro16CPU *cpu, uint32_t addr) {
+    uint8_t low = m16_cpu_read_phys_byte(cpu, addr);
+    uint8_t high = m16_cpu_read_phys_byte(cpu, addr + 1);
     return (uint16_t)low | ((uint16_t)high << 8);
 }
 
-void cpu_write_phys_byte(Micro16CPU *cpu, uint32_t addr, uint8_t value) {
+void m16_cpu_write_phys_byte(Micro16CPU *cpu, uint32_t addr, uint8_t value) {
     if (addr >= MEM_SIZE) {
         cpu->error = true;
         snprintf(cpu->error_msg, sizeof(cpu->error_msg),
@@ -182,6 +247,7 @@ void cpu_write_phys_byte(Micro16CPU *cpu, uint32_t addr, uint8_t value) {
         return;
     }
 
+    HOSTPROF_BEGIN(mem_prof);
     cpu->mar = addr;
     cpu->mdr = value;
 
@@ -191,46 +257,47 @@ void cpu_write_phys_byte(Micro16CPU *cpu, uint32_t addr, uint8_t value) {
     }
 
     cpu->memory[addr] = value;
+    HOSTPROF_END(mem_prof, MEMPROF_WRITE);
 }
 
-void cpu_write_phys_word(Micro16CPU *cpu, uint32_t addr, uint16_t value) {
-    cpu_write_phys_byte(cpu, addr, (uint8_t)(value & 0xFF));
-    cpu_write_phys_byte(cpu, addr + 1, (uint8_t)(value >> 8));
+void m16_cpu_write_phys_word(Micro16CPU *cpu, uint32_t addr, uint16_t value) {
+    m16_cpu_write_phys_byte(cpu, addr, (uint8_t)(value & 0xFF));
+    m16_cpu_write_phys_byte(cpu, addr + 1, (uint8_t)(value >> 8));
 }
 
 /* ========================================================================
  * Memory Operations - Segmented Address
  * ======================================================================== */
 
-uint32_t cpu_seg_to_phys(uint16_t segment, uint16_t offset) {
+uint32_t m16_cpu_seg_to_phys(uint16_t segment, uint16_t offset) {
     return seg_offset_to_phys(segment, offset);
 }
 
-uint8_t cpu_read_byte(Micro16CPU *cpu, uint16_t segment, uint16_t offset) {
+uint8_t m16_cpu_read_byte(Micro16CPU *cpu, uint16_t segment, uint16_t offset) {
     uint32_t phys = seg_offset_to_phys(segment, offset);
-    return cpu_read_phys_byte(cpu, phys);
+    return m16_cpu_read_phys_byte(cpu, phys);
 }
 
-uint16_t cpu_read_word(Micro16CPU *cpu, uint16_t segment, uint16_t offset) {
+uint16_t m16_cpu_read_word(Micro16CPU *cpu, uint16_t segment, uint16_t offset) {
     uint32_t phys = seg_offset_to_phys(segment, offset);
-    return cpu_read_phys_word(cpu, phys);
+    return m16_cpu_read_phys_word(cpu, phys);
 }
 
-void cpu_write_byte(Micro16CPU *cpu, uint16_t segment, uint16_t offset, uint8_t value) {
+void m16_cpu_write_byte(Micro16CPU *cpu, uint16_t segment, uint16_t offset, uint8_t value) {
     uint32_t phys = seg_offset_to_phys(segment, offset);
-    cpu_write_phys_byte(cpu, phys, value);
+    m16_cpu_write_phys_byte(cpu, phys, value);
 }
 
-void cpu_write_word(Micro16CPU *cpu, uint16_t segment, uint16_t offset, uint16_t value) {
+void m16_cpu_write_word(Micro16CPU *cpu, uint16_t segment, uint16_t offset, uint16_t value) {
     uint32_t phys = seg_offset_to_phys(segment, offset);
-    cpu_write_phys_word(cpu, phys, value);
+    m16_cpu_write_phys_word(cpu, phys, value);
 }
 
 /* ========================================================================
  * Program Loading
  * ======================================================================== */
 
-void cpu_load_program(Micro16CPU *cpu, const uint8_t *program, uint32_t size, uint32_t phys_addr) {
+void m16_cpu_load_program(Micro16CPU *cpu, const uint8_t *program, uint32_t size, uint32_t phys_addr) {
     for (uint32_t i = 0; i < size && (phys_addr + i) < MEM_SIZE; i++) {
         cpu->memory[phys_addr + i] = program[i];
     }
@@ -241,7 +308,7 @@ void cpu_load_program(Micro16CPU *cpu, const uint8_t *program, uint32_t size, ui
  * ======================================================================== */
 
 static uint8_t fetch_byte(Micro16CPU *cpu) {
-    uint8_t value = cpu_read_byte(cpu, cpu->seg[SEG_CS], cpu->pc);
+    uint8_t value = m16_cpu_read_byte(cpu, cpu->seg[SEG_CS], cpu->pc);
     cpu->pc++;
     return value;
 }
@@ -258,11 +325,11 @@ static uint16_t fetch_word(Micro16CPU *cpu) {
 
 static void push_word(Micro16CPU *cpu, uint16_t value) {
     cpu->sp -= 2;
-    cpu_write_word(cpu, cpu->seg[SEG_SS], cpu->sp, value);
+    m16_cpu_write_word(cpu, cpu->seg[SEG_SS], cpu->sp, value);
 }
 
 static uint16_t pop_word(Micro16CPU *cpu) {
-    uint16_t value = cpu_read_word(cpu, cpu->seg[SEG_SS], cpu->sp);
+    uint16_t value = m16_cpu_read_word(cpu, cpu->seg[SEG_SS], cpu->sp);
     cpu->sp += 2;
     return value;
 }
@@ -271,9 +338,8 @@ static uint16_t pop_word(Micro16CPU *cpu) {
  * Interrupt Support
  * ======================================================================== */
 
-void cpu_request_interrupt(Micro16CPU *cpu, uint8_t vector) {
-    cpu->int_pending = true;
-    cpu->int_vector = vector;
+void m16_cpu_request_interrupt(Micro16CPU *cpu, uint8_t vector) {
+    m16_pic_raise_vector(&cpu->pic, vector);
 }
 
 static void handle_interrupt(Micro16CPU *cpu, uint8_t vector) {
@@ -288,33 +354,196 @@ static void handle_interrupt(Micro16CPU *cpu, uint8_t vector) {
 
     /* Read interrupt vector from IVT */
     uint32_t ivt_entry = IVT_BASE + (vector * 4);
-    uint16_t new_pc = cpu_read_phys_word(cpu, ivt_entry);
-    uint16_t new_cs = cpu_read_phys_word(cpu, ivt_entry + 2);
+    uint16_t new_pc = m16_cpu_read_phys_word(cpu, ivt_entry);
+    uint16_t new_cs = m16_cpu_read_phys_word(cpu, ivt_entry + 2);
 
     cpu->pc = new_pc;
     cpu->seg[SEG_CS] = new_cs;
 }
 
+void m16_cpu_raise_irq(Micro16CPU *cpu, int line) {
+    m16_pic_raise(&cpu->pic, line);
+}
+
+/* Interrupt latched in the PIC, vectored or on a line */
+static inline bool interrupt_ready(const Micro16CPU *cpu) {
+    return cpu->pic.pending;
+}
+
 static void check_interrupt(Micro16CPU *cpu) {
-    if (cpu->int_pending && cpu_get_flag(cpu, FLAG_I)) {
-        cpu->int_pending = false;
-        handle_interrupt(cpu, cpu->int_vector);
+    if (!interrupt_ready(cpu) || !cpu_get_flag(cpu, FLAG_I)) return;
+    handle_interrupt(cpu, m16_pic_acknowledge(&cpu->pic));
+}
+
+/* ========================================================================
+ * Event Scheduler
+ * ======================================================================== */
+
+static void update_next_event(Micro16CPU *cpu) {
+    cpu->next_event = NO_EVENT;
+    for (int i = 0; i < MAX_EVENTS; i++) {
+        if (cpu->events[i].active && cpu->events[i].when < cpu->next_event) {
+            cpu->next_event = cpu->events[i].when;
+        }
     }
 }
 
+int m16_cpu_schedule_interrupt(Micro16CPU *cpu, uint64_t delay, uint8_t vector) {
+    for (int i = 0; i < MAX_EVENTS; i++) {
+        if (!cpu->events[i].active) {
+            cpu->events[i].active = true;
+            cpu->events[i].when = cpu->cycles + delay;
+            cpu->events[i].vector = vector;
+            if (cpu->events[i].when < cpu->next_event) {
+                cpu->next_event = cpu->events[i].when;
+            }
+            return i;
+        }
+    }
+    return -1;
+}
+
+void m16_cpu_cancel_event(Micro16CPU *cpu, int slot) {
+    if (slot < 0 || slot >= MAX_EVENTS || !cpu->events[slot].active) return;
+    cpu->events[slot].active = false;
+    if (slot == cpu->timer_slot) cpu->timer_slot = -1;
+    update_next_event(cpu);
+}
+
+/* Raise every due event. The PIC latches each vector, so events that
+ * come due together are all delivered, in vector priority order. */
+static void fire_due_events(Micro16CPU *cpu) {
+    for (int i = 0; i < MAX_EVENTS; i++) {
+        if (cpu->events[i].active && cpu->events[i].when <= cpu->cycles) {
+            cpu->events[i].active = false;
+            if (i == cpu->timer_slot) cpu->timer_slot = -1;
+            m16_cpu_request_interrupt(cpu, cpu->events[i].vector);
+        }
+    }
+    update_next_event(cpu);
+}
+
+bool m16_cpu_is_idle(const Micro16CPU *cpu) {
+    if (!cpu->waiting || cpu->halted || cpu->error) return false;
+    if (interrupt_ready(cpu)) {
+        /* A latched interrupt wakes it once interrupts are enabled */
+        return !cpu_get_flag(cpu, FLAG_I);
+    }
+    return cpu->next_event == NO_EVENT;
+}
+
+/* ========================================================================
+ * Locked Memory Operations
+ * ======================================================================== */
+
+/* Guest memory is little-endian; convert for host-native atomic words */
+static inline uint16_t le16_to_host(uint16_t v) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return (uint16_t)((v >> 8) | (v << 8));
+#else
+    return v;
+#endif
+}
+
+/*
+ * Resolve DS:offset to a host pointer usable with atomics.
+ * Returns NULL (and flags an error) for unaligned or out-of-range words.
+ */
+static uint16_t *locked_word_ptr(Micro16CPU *cpu, uint16_t offset) {
+    uint32_t phys = seg_offset_to_phys(cpu->seg[SEG_DS], offset);
+    if ((phys & 1) != 0 || phys + 1 >= MEM_SIZE) {
+        cpu->error = true;
+        snprintf(cpu->error_msg, sizeof(cpu->error_msg),
+                 "LOCK operand must be an aligned word: 0x%05X", phys);
+        return NULL;
+    }
+    cpu->mar = phys;
+    return (uint16_t *)(void *)&cpu->memory[phys];
+}
+
+/* Atomically add `delta` to a guest word; returns the value before the add */
+static uint16_t locked_fetch_add(uint16_t *word, uint16_t delta) {
+    uint16_t old_raw = __atomic_load_n(word, __ATOMIC_RELAXED);
+    uint16_t new_raw;
+    do {
+        new_raw = le16_to_host((uint16_t)(le16_to_host(old_raw) + delta));
+    } while (!__atomic_compare_exchange_n(word, &old_raw, new_raw, true,
+                                          __ATOMIC_SEQ_CST, __ATOMIC_RELAXED));
+    return le16_to_host(old_raw);
+}
+
+/* Execute the instruction following a LOCK prefix; returns extra cycles */
+static int execute_locked(Micro16CPU *cpu) {
+    uint8_t op = fetch_byte(cpu);
+    uint8_t reg = 0;
+    uint16_t *word;
+    uint16_t old, delta;
+
+    if (op == OP_ADD_RR || op == OP_XCHG) {
+        reg = fetch_byte(cpu) & 0x07;
+    } else if (op != OP_INC && op != OP_DEC) {
+        cpu->error = true;
+        snprintf(cpu->error_msg, sizeof(cpu->error_msg),
+                 "Invalid opcode after LOCK: 0x%02X", op);
+        cpu->halted = true;
+        return 0;
+    }
+
+    word = locked_word_ptr(cpu, fetch_word(cpu));
+    if (word == NULL) {
+        cpu->halted = true;
+        return 0;
+    }
+
+    if (op == OP_XCHG) {
+        /* XCHG leaves flags alone */
+        uint16_t raw = __atomic_exchange_n(word, le16_to_host(cpu->r[reg]), __ATOMIC_SEQ_CST);
+        cpu->r[reg] = le16_to_host(raw);
+        cpu->mdr = cpu->r[reg];
+        return 6;
+    }
+
+    delta = (op == OP_DEC) ? 0xFFFF : (op == OP_INC) ? 1 : cpu->r[reg];
+    old = locked_fetch_add(word, delta);
+    cpu->mdr = (uint16_t)(old + delta);
+
+    /* INC/DEC preserve carry, like their register forms */
+    bool old_c = cpu_get_flag(cpu, FLAG_C);
+    if (op == OP_DEC) {
+        update_flags_sub16(cpu, old, 1, (uint32_t)old - 1);
+    } else {
+        update_flags_add16(cpu, old, delta, (uint32_t)old + delta);
+    }
+    if (op != OP_ADD_RR) {
+        cpu_set_flag(cpu, FLAG_C, old_c);
+    }
+    return 7;
+}
+
 /* ========================================================================
  * Instruction Execution
  * ======================================================================== */
 
-int cpu_step(Micro16CPU *cpu) {
+int m16_cpu_step(Micro16CPU *cpu) {
     if (cpu->halted || cpu->error) {
         return 0;
     }
 
+    /* Raise scheduled events that have come due */
+    if (cpu->cycles >= cpu->next_event) {
+        fire_due_events(cpu);
+    }
+
     /* If waiting, check for interrupt */
     if (cpu->waiting) {
-        if (cpu->int_pending && cpu_get_flag(cpu, FLAG_I)) {
+        if (interrupt_ready(cpu) && cpu_get_flag(cpu, FLAG_I)) {
             cpu->waiting = false;
+        } else if (!interrupt_ready(cpu) && cpu->next_event != NO_EVENT) {
+            /* Idle skip: nothing runs until the next event, so jump to it */
+            uint64_t skip = cpu->next_event - cpu->cycles;
+            if (skip > IDLE_SKIP_MAX) skip = IDLE_SKIP_MAX;
+            cpu->cycles += skip;
+            return (int)skip;
         } else {
             return 1;  /* Still waiting */
         }
@@ -339,6 +568,7 @@ int cpu_step(Micro16CPU *cpu) {
     (void)offset16;
 
     /* Decode and execute */
+    HOSTPROF_BEGIN(opcode_prof);
     switch (opcode) {
 
     /* ========== System Instructions (0x00-0x0E) ========== */
@@ -347,7 +577,13 @@ int cpu_step(Micro16CPU *cpu) {
         break;
 
     case OP_HLT:
-        cpu->halted = true;
+        /* With interrupts enabled and an event on the way, HLT waits for it */
+        if (cpu_get_flag(cpu, FLAG_I) &&
+            (interrupt_ready(cpu) || cpu->next_event != NO_EVENT)) {
+            cpu->waiting = true;
+        } else {
+            cpu->halted = true;
+        }
         cycles += 1;
         break;
 
@@ -356,8 +592,22 @@ int cpu_step(Micro16CPU *cpu) {
         cycles += 1;
         break;
 
+    case OP_LOCK:
+        {
+            int locked_cycles = execute_locked(cpu);
+            if (locked_cycles == 0) {
+                return cycles;
+            }
+            cycles += locked_cycles;
+        }
+        break;
+
     case OP_INT:
         imm16 = fetch_byte(cpu);  /* Interrupt vector number */
+        if (cpu->hcall.enabled && imm16 == HCALL_VECTOR) {
+            cycles += m16_hypercall_dispatch(cpu);
+            break;
+        }
         handle_interrupt(cpu, (uint8_t)imm16);
         cycles += 5;
         break;
@@ -489,7 +739,7 @@ int cpu_step(Micro16CPU *cpu) {
         /* LD Rd, [addr] - Load 16-bit word from memory */
         reg = fetch_byte(cpu) & 0x07;
         addr16 = fetch_word(cpu);
-        cpu->r[reg] = cpu_read_word(cpu, cpu->seg[SEG_DS], addr16);
+        cpu->r[reg] = m16_cpu_read_word(cpu, cpu->seg[SEG_DS], addr16);
         cycles += 4;
         break;
 
@@ -497,7 +747,7 @@ int cpu_step(Micro16CPU *cpu) {
         /* ST [addr], Rs - Store 16-bit word to memory */
         reg = fetch_byte(cpu) & 0x07;
         addr16 = fetch_word(cpu);
-        cpu_write_word(cpu, cpu->seg[SEG_DS], addr16, cpu->r[reg]);
+        m16_cpu_write_word(cpu, cpu->seg[SEG_DS], addr16, cpu->r[reg]);
         cycles += 4;
         break;
 
@@ -505,7 +755,7 @@ int cpu_step(Micro16CPU *cpu) {
         /* LDB Rd, [addr] - Load byte from memory (zero-extend) */
         reg = fetch_byte(cpu) & 0x07;
         addr16 = fetch_word(cpu);
-        cpu->r[reg] = cpu_read_byte(cpu, cpu->seg[SEG_DS], addr16);
+        cpu->r[reg] = m16_cpu_read_byte(cpu, cpu->seg[SEG_DS], addr16);
         cycles += 4;
         break;
 
@@ -513,7 +763,7 @@ int cpu_step(Micro16CPU *cpu) {
         /* STB [addr], Rs - Store low byte to memory */
         reg = fetch_byte(cpu) & 0x07;
         addr16 = fetch_word(cpu);
-        cpu_write_byte(cpu, cpu->seg[SEG_DS], addr16, (uint8_t)(cpu->r[reg] & 0xFF));
+        m16_cpu_write_byte(cpu, cpu->seg[SEG_DS], addr16, (uint8_t)(cpu->r[reg] & 0xFF));
         cycles += 4;
         break;
 
@@ -525,7 +775,7 @@ int cpu_step(Micro16CPU *cpu) {
             reg2 = regs & 0x07;         /* Base register */
             int16_t offset = (int16_t)fetch_word(cpu);
             uint16_t eff_addr = cpu->r[reg2] + offset;
-            cpu->r[reg] = cpu_read_word(cpu, cpu->seg[SEG_DS], eff_addr);
+            cpu->r[reg] = m16_cpu_read_word(cpu, cpu->seg[SEG_DS], eff_addr);
         }
         cycles += 5;
         break;
@@ -538,7 +788,7 @@ int cpu_step(Micro16CPU *cpu) {
             reg2 = regs & 0x07;         /* Source register */
             int16_t offset = (int16_t)fetch_word(cpu);
             uint16_t eff_addr = cpu->r[reg] + offset;
-            cpu_write_word(cpu, cpu->seg[SEG_DS], eff_addr, cpu->r[reg2]);
+            m16_cpu_write_word(cpu, cpu->seg[SEG_DS], eff_addr, cpu->r[reg2]);
         }
         cycles += 5;
         break;
@@ -555,8 +805,8 @@ int cpu_step(Micro16CPU *cpu) {
         /* LDS Rd, [addr] - Load pointer into DS:Rd */
         reg = fetch_byte(cpu) & 0x07;
         addr16 = fetch_word(cpu);
-        cpu->r[reg] = cpu_read_word(cpu, cpu->seg[SEG_DS], addr16);
-        cpu->seg[SEG_DS] = cpu_read_word(cpu, cpu->seg[SEG_DS], addr16 + 2);
+        cpu->r[reg] = m16_cpu_read_word(cpu, cpu->seg[SEG_DS], addr16);
+        cpu->seg[SEG_DS] = m16_cpu_read_word(cpu, cpu->seg[SEG_DS], addr16 + 2);
         cycles += 6;
         break;
 
@@ -564,8 +814,8 @@ int cpu_step(Micro16CPU *cpu) {
         /* LES Rd, [addr] - Load pointer into ES:Rd */
         reg = fetch_byte(cpu) & 0x07;
         addr16 = fetch_word(cpu);
-        cpu->r[reg] = cpu_read_word(cpu, cpu->seg[SEG_DS], addr16);
-        cpu->seg[SEG_ES] = cpu_read_word(cpu, cpu->seg[SEG_DS], addr16 + 2);
+        cpu->r[reg] = m16_cpu_read_word(cpu, cpu->seg[SEG_DS], addr16);
+        cpu->seg[SEG_ES] = m16_cpu_read_word(cpu, cpu->seg[SEG_DS], addr16 + 2);
         cycles += 6;
         break;
 
@@ -574,7 +824,7 @@ int cpu_step(Micro16CPU *cpu) {
         reg = fetch_byte(cpu) & 0x07;
         offset16 = (int16_t)fetch_word(cpu);
         addr16 = cpu->sp + offset16;
-        cpu->r[reg] = cpu_read_word(cpu, cpu->seg[SEG_SS], addr16);
+        cpu->r[reg] = m16_cpu_read_word(cpu, cpu->seg[SEG_SS], addr16);
         cycles += 5;
         break;
 
@@ -583,7 +833,7 @@ int cpu_step(Micro16CPU *cpu) {
         reg = fetch_byte(cpu) & 0x07;
         offset16 = (int16_t)fetch_word(cpu);
         addr16 = cpu->sp + offset16;
-        cpu_write_word(cpu, cpu->seg[SEG_SS], addr16, cpu->r[reg]);
+        m16_cpu_write_word(cpu, cpu->seg[SEG_SS], addr16, cpu->r[reg]);
         cycles += 5;
         break;
 
@@ -638,7 +888,7 @@ int cpu_step(Micro16CPU *cpu) {
             if (level > 0) {
                 for (int i = 1; i < level; i++) {
                     cpu->r[REG_R6] -= 2;
-                    push_word(cpu, cpu_read_word(cpu, cpu->seg[SEG_SS], cpu->r[REG_R6]));
+                    push_word(cpu, m16_cpu_read_word(cpu, cpu->seg[SEG_SS], cpu->r[REG_R6]));
                 }
                 push_word(cpu, frame_ptr);
             }
@@ -1214,8 +1464,8 @@ int cpu_step(Micro16CPU *cpu) {
     case OP_MOVSB:
         /* Move string byte: ES:[DI] = DS:[SI], update SI/DI */
         {
-            uint8_t byte = cpu_read_byte(cpu, cpu->seg[SEG_DS], cpu->r[REG_R4]);
-            cpu_write_byte(cpu, cpu->seg[SEG_ES], cpu->r[REG_R5], byte);
+            uint8_t byte = m16_cpu_read_byte(cpu, cpu->seg[SEG_DS], cpu->r[REG_R4]);
+            m16_cpu_write_byte(cpu, cpu->seg[SEG_ES], cpu->r[REG_R5], byte);
             if (cpu_get_flag(cpu, FLAG_D)) {
                 cpu->r[REG_R4]--;
                 cpu->r[REG_R5]--;
@@ -1230,8 +1480,8 @@ int cpu_step(Micro16CPU *cpu) {
     case OP_MOVSW:
         /* Move string word: ES:[DI] = DS:[SI], update SI/DI by 2 */
         {
-            uint16_t word = cpu_read_word(cpu, cpu->seg[SEG_DS], cpu->r[REG_R4]);
-            cpu_write_word(cpu, cpu->seg[SEG_ES], cpu->r[REG_R5], word);
+            uint16_t word = m16_cpu_read_word(cpu, cpu->seg[SEG_DS], cpu->r[REG_R4]);
+            m16_cpu_write_word(cpu, cpu->seg[SEG_ES], cpu->r[REG_R5], word);
             if (cpu_get_flag(cpu, FLAG_D)) {
                 cpu->r[REG_R4] -= 2;
                 cpu->r[REG_R5] -= 2;
@@ -1246,8 +1496,8 @@ int cpu_step(Micro16CPU *cpu) {
     case OP_CMPSB:
         /* Compare string byte: DS:[SI] - ES:[DI], update SI/DI */
         {
-            uint8_t src = cpu_read_byte(cpu, cpu->seg[SEG_DS], cpu->r[REG_R4]);
-            uint8_t dst = cpu_read_byte(cpu, cpu->seg[SEG_ES], cpu->r[REG_R5]);
+            uint8_t src = m16_cpu_read_byte(cpu, cpu->seg[SEG_DS], cpu->r[REG_R4]);
+            uint8_t dst = m16_cpu_read_byte(cpu, cpu->seg[SEG_ES], cpu->r[REG_R5]);
             result32 = (uint32_t)src - (uint32_t)dst;
             update_flags_sub16(cpu, src, dst, result32);
             if (cpu_get_flag(cpu, FLAG_D)) {
@@ -1264,8 +1514,8 @@ int cpu_step(Micro16CPU *cpu) {
     case OP_CMPSW:
         /* Compare string word */
         {
-            uint16_t src = cpu_read_word(cpu, cpu->seg[SEG_DS], cpu->r[REG_R4]);
-            uint16_t dst = cpu_read_word(cpu, cpu->seg[SEG_ES], cpu->r[REG_R5]);
+            uint16_t src = m16_cpu_read_word(cpu, cpu->seg[SEG_DS], cpu->r[REG_R4]);
+            uint16_t dst = m16_cpu_read_word(cpu, cpu->seg[SEG_ES], cpu->r[REG_R5]);
             result32 = (uint32_t)src - (uint32_t)dst;
             update_flags_sub16(cpu, src, dst, result32);
             if (cpu_get_flag(cpu, FLAG_D)) {
@@ -1281,7 +1531,7 @@ int cpu_step(Micro16CPU *cpu) {
 
     case OP_STOSB:
         /* Store string byte: ES:[DI] = AL, update DI */
-        cpu_write_byte(cpu, cpu->seg[SEG_ES], cpu->r[REG_R5], (uint8_t)(cpu->r[REG_R0] & 0xFF));
+        m16_cpu_write_byte(cpu, cpu->seg[SEG_ES], cpu->r[REG_R5], (uint8_t)(cpu->r[REG_R0] & 0xFF));
         if (cpu_get_flag(cpu, FLAG_D)) {
             cpu->r[REG_R5]--;
         } else {
@@ -1292,7 +1542,7 @@ int cpu_step(Micro16CPU *cpu) {
 
     case OP_STOSW:
         /* Store string word: ES:[DI] = AX, update DI by 2 */
-        cpu_write_word(cpu, cpu->seg[SEG_ES], cpu->r[REG_R5], cpu->r[REG_R0]);
+        m16_cpu_write_word(cpu, cpu->seg[SEG_ES], cpu->r[REG_R5], cpu->r[REG_R0]);
         if (cpu_get_flag(cpu, FLAG_D)) {
             cpu->r[REG_R5] -= 2;
         } else {
@@ -1303,7 +1553,7 @@ int cpu_step(Micro16CPU *cpu) {
 
     case OP_LODSB:
         /* Load string byte: AL = DS:[SI], update SI */
-        cpu->r[REG_R0] = (cpu->r[REG_R0] & 0xFF00) | cpu_read_byte(cpu, cpu->seg[SEG_DS], cpu->r[REG_R4]);
+        cpu->r[REG_R0] = (cpu->r[REG_R0] & 0xFF00) | m16_cpu_read_byte(cpu, cpu->seg[SEG_DS], cpu->r[REG_R4]);
         if (cpu_get_flag(cpu, FLAG_D)) {
             cpu->r[REG_R4]--;
         } else {
@@ -1314,7 +1564,7 @@ int cpu_step(Micro16CPU *cpu) {
 
     case OP_LODSW:
         /* Load string word: AX = DS:[SI], update SI by 2 */
-        cpu->r[REG_R0] = cpu_read_word(cpu, cpu->seg[SEG_DS], cpu->r[REG_R4]);
+        cpu->r[REG_R0] = m16_cpu_read_word(cpu, cpu->seg[SEG_DS], cpu->r[REG_R4]);
         if (cpu_get_flag(cpu, FLAG_D)) {
             cpu->r[REG_R4] -= 2;
         } else {
@@ -1331,36 +1581,36 @@ int cpu_step(Micro16CPU *cpu) {
                 /* Execute the string operation */
                 switch (next_op) {
                     case OP_MOVSB: {
-                        uint8_t byte = cpu_read_byte(cpu, cpu->seg[SEG_DS], cpu->r[REG_R4]);
-                        cpu_write_byte(cpu, cpu->seg[SEG_ES], cpu->r[REG_R5], byte);
+                        uint8_t byte = m16_cpu_read_byte(cpu, cpu->seg[SEG_DS], cpu->r[REG_R4]);
+                        m16_cpu_write_byte(cpu, cpu->seg[SEG_ES], cpu->r[REG_R5], byte);
                         if (cpu_get_flag(cpu, FLAG_D)) { cpu->r[REG_R4]--; cpu->r[REG_R5]--; }
                         else { cpu->r[REG_R4]++; cpu->r[REG_R5]++; }
                         break;
                     }
                     case OP_MOVSW: {
-                        uint16_t word = cpu_read_word(cpu, cpu->seg[SEG_DS], cpu->r[REG_R4]);
-                        cpu_write_word(cpu, cpu->seg[SEG_ES], cpu->r[REG_R5], word);
+                        uint16_t word = m16_cpu_read_word(cpu, cpu->seg[SEG_DS], cpu->r[REG_R4]);
+                        m16_cpu_write_word(cpu, cpu->seg[SEG_ES], cpu->r[REG_R5], word);
                         if (cpu_get_flag(cpu, FLAG_D)) { cpu->r[REG_R4] -= 2; cpu->r[REG_R5] -= 2; }
                         else { cpu->r[REG_R4] += 2; cpu->r[REG_R5] += 2; }
                         break;
                     }
                     case OP_STOSB:
-                        cpu_write_byte(cpu, cpu->seg[SEG_ES], cpu->r[REG_R5], (uint8_t)(cpu->r[REG_R0] & 0xFF));
+                        m16_cpu_write_byte(cpu, cpu->seg[SEG_ES], cpu->r[REG_R5], (uint8_t)(cpu->r[REG_R0] & 0xFF));
                         if (cpu_get_flag(cpu, FLAG_D)) cpu->r[REG_R5]--;
                         else cpu->r[REG_R5]++;
                         break;
                     case OP_STOSW:
-                        cpu_write_word(cpu, cpu->seg[SEG_ES], cpu->r[REG_R5], cpu->r[REG_R0]);
+                        m16_cpu_write_word(cpu, cpu->seg[SEG_ES], cpu->r[REG_R5], cpu->r[REG_R0]);
                         if (cpu_get_flag(cpu, FLAG_D)) cpu->r[REG_R5] -= 2;
                         else cpu->r[REG_R5] += 2;
                         break;
                     case OP_LODSB:
-                        cpu->r[REG_R0] = (cpu->r[REG_R0] & 0xFF00) | cpu_read_byte(cpu, cpu->seg[SEG_DS], cpu->r[REG_R4]);
+                        cpu->r[REG_R0] = (cpu->r[REG_R0] & 0xFF00) | m16_cpu_read_byte(cpu, cpu->seg[SEG_DS], cpu->r[REG_R4]);
                         if (cpu_get_flag(cpu, FLAG_D)) cpu->r[REG_R4]--;
                         else cpu->r[REG_R4]++;
                         break;
                     case OP_LODSW:
-                        cpu->r[REG_R0] = cpu_read_word(cpu, cpu->seg[SEG_DS], cpu->r[REG_R4]);
+                        cpu->r[REG_R0] = m16_cpu_read_word(cpu, cpu->seg[SEG_DS], cpu->r[REG_R4]);
                         if (cpu_get_flag(cpu, FLAG_D)) cpu->r[REG_R4] -= 2;
                         else cpu->r[REG_R4] += 2;
                         break;
@@ -1383,8 +1633,8 @@ int cpu_step(Micro16CPU *cpu) {
             while (cpu->r[REG_R2] != 0) {
                 switch (next_op) {
                     case OP_CMPSB: {
-                        uint8_t src = cpu_read_byte(cpu, cpu->seg[SEG_DS], cpu->r[REG_R4]);
-                        uint8_t dst = cpu_read_byte(cpu, cpu->seg[SEG_ES], cpu->r[REG_R5]);
+                        uint8_t src = m16_cpu_read_byte(cpu, cpu->seg[SEG_DS], cpu->r[REG_R4]);
+                        uint8_t dst = m16_cpu_read_byte(cpu, cpu->seg[SEG_ES], cpu->r[REG_R5]);
                         result32 = (uint32_t)src - (uint32_t)dst;
                         update_flags_sub16(cpu, src, dst, result32);
                         if (cpu_get_flag(cpu, FLAG_D)) { cpu->r[REG_R4]--; cpu->r[REG_R5]--; }
@@ -1392,8 +1642,8 @@ int cpu_step(Micro16CPU *cpu) {
                         break;
                     }
                     case OP_CMPSW: {
-                        uint16_t src = cpu_read_word(cpu, cpu->seg[SEG_DS], cpu->r[REG_R4]);
-                        uint16_t dst = cpu_read_word(cpu, cpu->seg[SEG_ES], cpu->r[REG_R5]);
+                        uint16_t src = m16_cpu_read_word(cpu, cpu->seg[SEG_DS], cpu->r[REG_R4]);
+                        uint16_t dst = m16_cpu_read_word(cpu, cpu->seg[SEG_ES], cpu->r[REG_R5]);
                         result32 = (uint32_t)src - (uint32_t)dst;
                         update_flags_sub16(cpu, src, dst, result32);
                         if (cpu_get_flag(cpu, FLAG_D)) { cpu->r[REG_R4] -= 2; cpu->r[REG_R5] -= 2; }
@@ -1420,8 +1670,8 @@ int cpu_step(Micro16CPU *cpu) {
             while (cpu->r[REG_R2] != 0) {
                 switch (next_op) {
                     case OP_CMPSB: {
-                        uint8_t src = cpu_read_byte(cpu, cpu->seg[SEG_DS], cpu->r[REG_R4]);
-                        uint8_t dst = cpu_read_byte(cpu, cpu->seg[SEG_ES], cpu->r[REG_R5]);
+                        uint8_t src = m16_cpu_read_byte(cpu, cpu->seg[SEG_DS], cpu->r[REG_R4]);
+                        uint8_t dst = m16_cpu_read_byte(cpu, cpu->seg[SEG_ES], cpu->r[REG_R5]);
                         result32 = (uint32_t)src - (uint32_t)dst;
                         update_flags_sub16(cpu, src, dst, result32);
                         if (cpu_get_flag(cpu, FLAG_D)) { cpu->r[REG_R4]--; cpu->r[REG_R5]--; }
@@ -1429,8 +1679,8 @@ int cpu_step(Micro16CPU *cpu) {
                         break;
                     }
                     case OP_CMPSW: {
-                        uint16_t src = cpu_read_word(cpu, cpu->seg[SEG_DS], cpu->r[REG_R4]);
-                        uint16_t dst = cpu_read_word(cpu, cpu->seg[SEG_ES], cpu->r[REG_R5]);
+                        uint16_t src = m16_cpu_read_word(cpu, cpu->seg[SEG_DS], cpu->r[REG_R4]);
+                        uint16_t dst = m16_cpu_read_word(cpu, cpu->seg[SEG_ES], cpu->r[REG_R5]);
                         result32 = (uint32_t)src - (uint32_t)dst;
                         update_flags_sub16(cpu, src, dst, result32);
                         if (cpu_get_flag(cpu, FLAG_D)) { cpu->r[REG_R4] -= 2; cpu->r[REG_R5] -= 2; }
@@ -1455,10 +1705,25 @@ int cpu_step(Micro16CPU *cpu) {
         /* IN Rd, port - Input word from port */
         reg = fetch_byte(cpu) & 0x07;
         imm16 = fetch_word(cpu);  /* Port number */
-        /* For now, just read from MMIO region */
-        {
+        if (imm16 == PORT_CORE_ID) {
+            cpu->r[reg] = cpu->core_id;
+        } else if (imm16 == PORT_CORE_COUNT) {
+            cpu->r[reg] = cpu->core_count;
+        } else if (imm16 == PORT_TIMER) {
+            uint64_t left = 0;
+            if (cpu->timer_slot >= 0) {
+                uint64_t when = cpu->events[cpu->timer_slot].when;
+                left = when > cpu->cycles ? when - cpu->cycles : 0;
+            }
+            cpu->r[reg] = left > 0xFFFF ? 0xFFFF : (uint16_t)left;
+        } else if (imm16 == PORT_TIMER_VEC) {
+            cpu->r[reg] = cpu->timer_vector;
+        } else if (m16_pic_port_read(&cpu->pic, imm16, &cpu->r[reg])) {
+            /* Interrupt controller register */
+        } else {
+            /* Other ports read from the MMIO region */
             uint32_t io_addr = MMIO_BASE + (imm16 & 0xFFFF);
-            cpu->r[reg] = cpu_read_phys_word(cpu, io_addr);
+            cpu->r[reg] = m16_cpu_read_phys_word(cpu, io_addr);
         }
         cycles += 4;
         break;
@@ -1467,9 +1732,21 @@ int cpu_step(Micro16CPU *cpu) {
         /* OUT port, Rs - Output word to port */
         reg = fetch_byte(cpu) & 0x07;
         imm16 = fetch_word(cpu);  /* Port number */
-        {
+        if (imm16 == PORT_TIMER) {
+            /* Re-arming replaces any timer still pending */
+            m16_cpu_cancel_event(cpu, cpu->timer_slot);
+            if (cpu->r[reg] != 0) {
+                cpu->timer_slot = m16_cpu_schedule_interrupt(cpu, cpu->r[reg], cpu->timer_vector);
+            }
+        } else if (imm16 == PORT_TIMER_VEC) {
+            cpu->timer_vector = (uint8_t)(cpu->r[reg] & 0xFF);
+        } else if (m16_pic_port_write(&cpu->pic, imm16, cpu->r[reg])) {
+            /* Interrupt controller register */
+        } else if (imm16 == PORT_HCALL && cpu->hcall.enabled) {
+            cycles += m16_hypercall_dispatch(cpu);
+        } else {
             uint32_t io_addr = MMIO_BASE + (imm16 & 0xFFFF);
-            cpu_write_phys_word(cpu, io_addr, cpu->r[reg]);
+            m16_cpu_write_phys_word(cpu, io_addr, cpu->r[reg]);
         }
         cycles += 4;
         break;
@@ -1480,7 +1757,7 @@ int cpu_step(Micro16CPU *cpu) {
         imm16 = fetch_word(cpu);  /* Port number */
         {
             uint32_t io_addr = MMIO_BASE + (imm16 & 0xFFFF);
-            cpu->r[reg] = cpu_read_phys_byte(cpu, io_addr);
+            cpu->r[reg] = m16_cpu_read_phys_byte(cpu, io_addr);
         }
         cycles += 4;
         break;
@@ -1491,7 +1768,7 @@ int cpu_step(Micro16CPU *cpu) {
         imm16 = fetch_word(cpu);  /* Port number */
         {
             uint32_t io_addr = MMIO_BASE + (imm16 & 0xFFFF);
-            cpu_write_phys_byte(cpu, io_addr, (uint8_t)(cpu->r[reg] & 0xFF));
+            m16_cpu_write_phys_byte(cpu, io_addr, (uint8_t)(cpu->r[reg] & 0xFF));
         }
         cycles += 4;
         break;
@@ -1507,6 +1784,7 @@ int cpu_step(Micro16CPU *cpu) {
         return cycles;
     }
 
+    HOSTPROF_END(opcode_prof, opcode);
     cpu->instructions++;
     cpu->cycles += cycles;
 
@@ -1517,11 +1795,13 @@ int cpu_step(Micro16CPU *cpu) {
  * Run CPU
  * ======================================================================== */
 
-int cpu_run(Micro16CPU *cpu, int max_cycles) {
+int m16_cpu_run(Micro16CPU *cpu, int max_cycles) {
     int total_cycles = 0;
 
     while (!cpu->halted && !cpu->error && (max_cycles <= 0 || total_cycles < max_cycles)) {
-        int cycles = cpu_step(cpu);
+        /* Nothing inside the CPU can end a WAIT now; hand control back */
+        if (m16_cpu_is_idle(cpu)) break;
+        int cycles = m16_cpu_step(cpu);
         if (cycles == 0) break;
         total_cycles += cycles;
     }
@@ -1533,7 +1813,7 @@ int cpu_run(Micro16CPU *cpu, int max_cycles) {
  * Debug Support
  * ======================================================================== */
 
-void cpu_dump_state(const Micro16CPU *cpu) {
+void m16_cpu_dump_state(const Micro16CPU *cpu) {
     printf("=== Micro16 CPU State ===\n");
     printf("CS:PC = %04X:%04X (phys %05X)    SS:SP = %04X:%04X (phys %05X)\n",
            cpu->seg[SEG_CS], cpu->pc, seg_offset_to_phys(cpu->seg[SEG_CS], cpu->pc),
@@ -1569,10 +1849,22 @@ void cpu_dump_state(const Micro16CPU *cpu) {
     printf("Cycles: %lu  Instructions: %lu\n",
            (unsigned long)cpu->cycles,
            (unsigned long)cpu->instructions);
+    if (cpu->pic.irr != 0 || cpu->pic.isr != 0 || cpu->pic.imr != 0xFFFF) {
+        printf("PIC: IRR=%04X IMR=%04X ISR=%04X Base=%02X\n",
+               cpu->pic.irr, cpu->pic.imr, cpu->pic.isr, cpu->pic.base);
+    }
+    for (int v = 0; v < 256; v++) {
+        if (cpu->pic.virr[v >> 6] & (1ull << (v & 63))) {
+            printf("Pending vector: %02X\n", v);
+        }
+    }
+    if (cpu->next_event != NO_EVENT) {
+        printf("Next event at cycle: %lu\n", (unsigned long)cpu->next_event);
+    }
     printf("=========================\n");
 }
 
-void cpu_dump_memory(const Micro16CPU *cpu, uint32_t phys_start, uint32_t phys_end) {
+void m16_cpu_dump_memory(const Micro16CPU *cpu, uint32_t phys_start, uint32_t phys_end) {
     printf("Memory [0x%05X - 0x%05X]:\n", phys_start, phys_end);
 
     for (uint32_t addr = phys_start; addr <= phys_end && addr < MEM_SIZE; addr += 16) {
@@ -1595,7 +1887,7 @@ void cpu_dump_memory(const Micro16CPU *cpu, uint32_t phys_start, uint32_t phys_e
  */
 static char disasm_buf[64];
 
-const char* cpu_disassemble(const Micro16CPU *cpu, uint32_t phys_addr, int *instr_len) {
+const char* m16_cpu_disassemble(const Micro16CPU *cpu, uint32_t phys_addr, int *instr_len) {
     uint8_t opcode = cpu->memory[phys_addr];
     *instr_len = 1;
 
@@ -18,6 +18,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "pic.h"
 
 /* ========================================================================
  * Memory Configuration
@@ -50,6 +51,57 @@
 #define MMIO_BASE       0xF0000
 #define MMIO_SIZE       0x10000
 
+/* ========================================================================
+ * CPU-Internal I/O Ports
+ * Serviced by the core itself instead of the MMIO region
+ * ======================================================================== */
+
+#define PORT_CORE_ID    0xFF00      /* IN: this core's ID (0 on uniprocessor) */
+#define PORT_CORE_COUNT 0xFF02      /* IN: number of cores sharing memory */
+#define PORT_TIMER      0xFF04      /* OUT: one-shot timer in N cycles (0 cancels)
+                                       IN: cycles left until it fires */
+#define PORT_TIMER_VEC  0xFF06      /* OUT/IN: vector the timer raises */
+
+#define TIMER_DEFAULT_VECTOR 0x08
+
+/* Interrupt controller ports 0xFF08-0xFF10 are listed in pic.h */
+
+#define PORT_HCALL      0xFF12      /* OUT: hypercall (function in AX), if enabled */
+
+/* ========================================================================
+ * Hypercalls
+ * Opt-in host services for guest runtimes: `INT 0x80` or a write to
+ * PORT_HCALL is handled natively instead of through the IVT. Function
+ * numbers and register conventions are listed in hypercall.h.
+ * ======================================================================== */
+
+#define HCALL_VECTOR    0x80
+#define HCALL_DEFAULT_BASE_CYCLES 10
+
+typedef struct {
+    bool enabled;
+    int  base_cycles;       /* Charged for every call */
+    int  byte_cycles;       /* Charged per byte copied, filled or scanned */
+    const char *root;       /* Read-file sandbox directory (NULL = ".") */
+} HypercallConfig;
+
+/* ========================================================================
+ * Event Scheduler
+ * Interrupts scheduled for a future cycle count (timer, devices). WAIT,
+ * and HLT with interrupts enabled while an event is pending, skip the
+ * cycle counter straight to the next event instead of spinning.
+ * ======================================================================== */
+
+#define MAX_EVENTS      8
+#define NO_EVENT        UINT64_MAX
+#define IDLE_SKIP_MAX   0x1000000   /* Largest single idle skip (cycles) */
+
+typedef struct {
+    bool     active;
+    uint64_t when;          /* Cycle count at which the event fires */
+    uint8_t  vector;        /* Interrupt raised when it fires */
+} Micro16Event;
+
 /* ========================================================================
  * Register Definitions
  * ======================================================================== */
@@ -91,9 +143,9 @@
 
 /* System Instructions (0x00-0x0F) */
 #define OP_NOP      0x00    /* No operation */
-#define OP_HLT      0x01    /* Halt CPU */
+#define OP_HLT      0x01    /* Halt CPU (waits instead if I=1 and an event is pending) */
 #define OP_WAIT     0x02    /* Wait for interrupt */
-#define OP_LOCK     0x03    /* Bus lock prefix */
+#define OP_LOCK     0x03    /* Bus lock prefix (see locked forms below) */
 #define OP_INT      0x04    /* Software interrupt */
 #define OP_IRET     0x05    /* Return from interrupt */
 #define OP_CLI      0x06    /* Clear interrupt flag */
@@ -233,6 +285,16 @@
 #define OP_INB      0xF2    /* IN byte */
 #define OP_OUTB     0xF3    /* OUT byte */
 
+/*
+ * Locked read-modify-write forms (LOCK prefix + opcode, DS-relative word):
+ *   LOCK INC [addr]        03 5B lo hi
+ *   LOCK DEC [addr]        03 5C lo hi
+ *   LOCK ADD [addr], Rs    03 50 rs lo hi
+ *   LOCK XCHG Rd, [addr]   03 12 rd lo hi
+ * The memory word must be at an even physical address. These are the only
+ * instructions that are atomic with respect to other cores.
+ */
+
 /* ========================================================================
  * CPU State Structure
  * ======================================================================== */
@@ -250,16 +312,29 @@ typedef struct {
     uint16_t flags;         /* Flags register */
 
     /* Interrupt state */
-    bool    int_pending;    /* Hardware interrupt pending */
-    uint8_t int_vector;     /* Pending interrupt vector number */
+    Micro16PIC pic;         /* Interrupt controller (all pending requests) */
+
+    /* Scheduled events */
+    Micro16Event events[MAX_EVENTS];
+    uint64_t next_event;    /* Earliest active event, NO_EVENT if none */
+    int      timer_slot;    /* Event slot armed through PORT_TIMER, or -1 */
+    uint8_t  timer_vector;
 
     /* Internal registers (for debugging/visualization) */
     uint8_t  ir;            /* Instruction Register */
     uint32_t mar;           /* Memory Address Register (20-bit) */
     uint16_t mdr;           /* Memory Data Register */
 
-    /* Memory (1MB, dynamically allocated) */
+    /* Memory (1MB, dynamically allocated or shared between SMP cores) */
     uint8_t *memory;
+    bool    shared_memory;  /* memory is owned by someone else (SMP) */
+
+    /* Hypercall services (off unless the host enables them) */
+    HypercallConfig hcall;
+
+    /* Multiprocessor identity (reported through PORT_CORE_ID/COUNT) */
+    uint16_t core_id;
+    uint16_t core_count;
 
     /* State */
     bool    halted;         /* CPU has executed HLT */
@@ -272,42 +347,60 @@ typedef struct {
     uint64_t instructions;  /* Instructions executed */
 } Micro16CPU;
 
+/* Saved machine state: registers, devices and a copy of memory */
+typedef struct {
+    Micro16CPU cpu;
+    uint8_t   *memory;      /* MEM_SIZE bytes, allocated on first save */
+} Micro16Snapshot;
+
 /* ========================================================================
  * Function Declarations
  * ======================================================================== */
 
 /* CPU Lifecycle */
-bool cpu_init(Micro16CPU *cpu);
-void cpu_free(Micro16CPU *cpu);
-void cpu_reset(Micro16CPU *cpu);
+bool m16_cpu_init(Micro16CPU *cpu);
+void m16_cpu_init_shared(Micro16CPU *cpu, uint8_t *memory);   /* Use caller-owned memory */
+void m16_cpu_free(Micro16CPU *cpu);
+void m16_cpu_reset(Micro16CPU *cpu);
 
 /* Memory Operations (segmented) */
-uint32_t cpu_seg_to_phys(uint16_t segment, uint16_t offset);
-uint8_t  cpu_read_byte(Micro16CPU *cpu, uint16_t segment, uint16_t offset);
-uint16_t cpu_read_word(Micro16CPU *cpu, uint16_t segment, uint16_t offset);
-void     cpu_write_byte(Micro16CPU *cpu, uint16_t segment, uint16_t offset, uint8_t value);
-void     cpu_write_word(Micro16CPU *cpu, uint16_t segment, uint16_t offset, uint16_t value);
+uint32_t m16_cpu_seg_to_phys(uint16_t segment, uint16_t offset);
+uint8_t  m16_cpu_read_byte(Micro16CPU *cpu, uint16_t segment, uint16_t offset);
+uint16_t m16_cpu_read_word(Micro16CPU *cpu, uint16_t segment, uint16_t offset);
+void     m16_cpu_write_byte(Micro16CPU *cpu, uint16_t segment, uint16_t offset, uint8_t value);
+void     m16_cpu_write_word(Micro16CPU *cpu, uint16_t segment, uint16_t offset, uint16_t value);
 
 /* Memory Operations (physical - for DMA, debugging) */
-uint8_t  cpu_read_phys_byte(Micro16CPU *cpu, uint32_t addr);
-uint16_t cpu_read_phys_word(Micro16CPU *cpu, uint32_t addr);
-void     cpu_write_phys_byte(Micro16CPU *cpu, uint32_t addr, uint8_t value);
-void     cpu_write_phys_word(Micro16CPU *cpu, uint32_t addr, uint16_t value);
+uint8_t  m16_cpu_read_phys_byte(Micro16CPU *cpu, uint32_t addr);
+uint16_t m16_cpu_read_phys_word(Micro16CPU *cpu, uint32_t addr);
+void     m16_cpu_write_phys_byte(Micro16CPU *cpu, uint32_t addr, uint8_t value);
+void     m16_cpu_write_phys_word(Micro16CPU *cpu, uint32_t addr, uint16_t value);
 
 /* Program Loading */
-void cpu_load_program(Micro16CPU *cpu, const uint8_t *program, uint32_t size, uint32_t phys_addr);
+void m16_cpu_load_program(Micro16CPU *cpu, const uint8_t *program, uint32_t size, uint32_t phys_addr);
 
 /* Execution */
-int cpu_step(Micro16CPU *cpu);              /* Execute one instruction, returns cycles */
-int cpu_run(Micro16CPU *cpu, int max_cycles); /* Run until halt or max_cycles */
+int m16_cpu_step(Micro16CPU *cpu);              /* Execute one instruction, returns cycles */
+int m16_cpu_run(Micro16CPU *cpu, int max_cycles); /* Run until halt or max_cycles */
 
 /* Interrupts */
-void cpu_request_interrupt(Micro16CPU *cpu, uint8_t vector);
+void m16_cpu_request_interrupt(Micro16CPU *cpu, uint8_t vector);  /* Vectored */
+void m16_cpu_raise_irq(Micro16CPU *cpu, int line);  /* PIC line */
+
+/* Event scheduling: returns the event slot, or -1 if the table is full */
+int  m16_cpu_schedule_interrupt(Micro16CPU *cpu, uint64_t delay, uint8_t vector);
+void m16_cpu_cancel_event(Micro16CPU *cpu, int slot);
+bool m16_cpu_is_idle(const Micro16CPU *cpu);    /* Only an external interrupt can wake it */
+
+/* Snapshots (checkpoint/restore; restore keeps the CPU's own memory buffer) */
+bool m16_cpu_snapshot_save(const Micro16CPU *cpu, Micro16Snapshot *snap);
+void m16_cpu_snapshot_restore(Micro16CPU *cpu, const Micro16Snapshot *snap);
+void m16_cpu_snapshot_free(Micro16Snapshot *snap);
 
 /* Debugging */
-void cpu_dump_state(const Micro16CPU *cpu);
-void cpu_dump_memory(const Micro16CPU *cpu, uint32_t phys_start, uint32_t phys_end);
-const char* cpu_disassemble(const Micro16CPU *cpu, uint32_t phys_addr, int *instr_len);
+void m16_cpu_dump_state(const Micro16CPU *cpu);
+void m16_cpu_dump_memory(const Micro16CPU *cpu, uint32_t phys_start, uint32_t phys_end);
+const char* m16_cpu_disassemble(const Micro16CPU *cpu, uint32_t phys_addr, int *instr_len);
 
 /* ========================================================================
  * Inline Helpers
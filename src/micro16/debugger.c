@@ -4,6 +4,7 @@
  * Provides interactive debugging for the Micro16 CPU with:
  * - Breakpoint management (set, list, delete, conditional)
  * - Watchpoints on registers
+ * - Tracepoints that log values to a ring buffer without stopping
  * - Single-step execution
  * - Run until halt/breakpoint/watchpoint
  * - Register display (R0-R7/AX-R7, CS/DS/SS/ES, SP, PC, flags)
@@ -64,6 +65,13 @@ void dbg_init(Micro16Debugger *dbg, Micro16CPU *cpu) {
         dbg->watchpoints[i].active = false;
     }
 
+    dbg->tp_count = 0;
+    dbg->trace_total = 0;
+    for (int i = 0; i < MAX_TRACEPOINTS; i++) {
+        dbg->tracepoints[i].active = false;
+        dbg->tracepoints[i].hits = 0;
+    }
+
     /* Initialize previous state */
     dbg_save_prev_state(dbg);
 
@@ -371,6 +379,196 @@ void dbg_list_watchpoints(Micro16Debugger *dbg) {
     }
 }
 
+/* ========================================================================
+ * Tracepoint Management
+ * ======================================================================== */
+
+/* Name of a trace item for display (returns static buffer) */
+static const char *trace_item_name(const TraceItem *item) {
+    static char buf[16];
+
+    if (item->kind == TRACE_ITEM_MEM) {
+        snprintf(buf, sizeof(buf), "[%05X]", item->which);
+    } else if (item->which == TRACE_REG_SP) {
+        snprintf(buf, sizeof(buf), "SP");
+    } else if (item->which == TRACE_REG_FLAGS) {
+        snprintf(buf, sizeof(buf), "FLAGS");
+    } else if (item->which < 8) {
+        snprintf(buf, sizeof(buf), "%s", cpu_reg_name(item->which));
+    } else {
+        snprintf(buf, sizeof(buf), "%s", cpu_seg_name(item->which - 8));
+    }
+    return buf;
+}
+
+bool dbg_set_tracepoint(Micro16Debugger *dbg, uint16_t segment, uint16_t offset,
+                        const TraceItem *items, int item_count) {
+    if (item_count <= 0 || item_count > TRACE_MAX_ITEMS) {
+        printf("Error: Tracepoint needs 1-%d items\n", TRACE_MAX_ITEMS);
+        return false;
+    }
+
+    /* Deleted slots with hits still label buffered records; keep them until tclear */
+    for (int i = 0; i < MAX_TRACEPOINTS; i++) {
+        Tracepoint *tp = &dbg->tracepoints[i];
+        if (!tp->active && tp->hits == 0) {
+            tp->active = true;
+            tp->segment = segment;
+            tp->offset = offset;
+            tp->item_count = item_count;
+            memcpy(tp->items, items, sizeof(TraceItem) * item_count);
+            dbg->tp_count++;
+            printf("Tracepoint %d set at %04X:%04X\n", i, segment, offset);
+            return true;
+        }
+    }
+
+    printf("Error: Maximum tracepoints (%d) reached (tclear frees deleted ones)\n",
+           MAX_TRACEPOINTS);
+    return false;
+}
+
+bool dbg_clear_tracepoint(Micro16Debugger *dbg, int index) {
+    if (index < 0 || index >= MAX_TRACEPOINTS) {
+        printf("Invalid tracepoint index: %d\n", index);
+        return false;
+    }
+
+    if (!dbg->tracepoints[index].active) {
+        printf("Tracepoint %d is not active\n", index);
+        return false;
+    }
+
+    dbg->tracepoints[index].active = false;
+    dbg->tp_count--;
+    printf("Tracepoint %d cleared\n", index);
+    return true;
+}
+
+void dbg_list_tracepoints(Micro16Debugger *dbg) {
+    if (dbg->tp_count == 0) {
+        printf("No tracepoints set\n");
+        return;
+    }
+
+    printf("Tracepoints (%d active):\n", dbg->tp_count);
+    for (int i = 0; i < MAX_TRACEPOINTS; i++) {
+        Tracepoint *tp = &dbg->tracepoints[i];
+        if (!tp->active) continue;
+
+        printf("  [%2d] %04X:%04X  records:", i, tp->segment, tp->offset);
+        for (int j = 0; j < tp->item_count; j++) {
+            printf(" %s", trace_item_name(&tp->items[j]));
+        }
+        printf("  (%lu hits)\n", (unsigned long)tp->hits);
+    }
+}
+
+/* Record a trace entry for every tracepoint at the current CS:PC */
+void dbg_check_tracepoints(Micro16Debugger *dbg) {
+    Micro16CPU *cpu = dbg->cpu;
+
+    for (int i = 0; i < MAX_TRACEPOINTS; i++) {
+        Tracepoint *tp = &dbg->tracepoints[i];
+        if (!tp->active ||
+            tp->segment != cpu->seg[SEG_CS] || tp->offset != cpu->pc) {
+            continue;
+        }
+
+        TraceRecord *rec = &dbg->trace_buf[dbg->trace_total & (TRACE_BUFFER_SIZE - 1)];
+        rec->cycles = cpu->cycles;
+        rec->cs = cpu->seg[SEG_CS];
+        rec->pc = cpu->pc;
+        rec->tp_index = (uint8_t)i;
+
+        for (int j = 0; j < tp->item_count; j++) {
+            const TraceItem *item = &tp->items[j];
+            uint32_t w = item->which;
+
+            /* Read memory directly so tracing leaves MAR/MDR untouched */
+            if (item->kind == TRACE_ITEM_MEM) {
+                rec->values[j] = cpu->memory[w] |
+                                 ((uint16_t)cpu->memory[(w + 1) % MEM_SIZE] << 8);
+            } else if (w == TRACE_REG_SP) {
+                rec->values[j] = cpu->sp;
+            } else if (w == TRACE_REG_FLAGS) {
+                rec->values[j] = cpu->flags;
+            } else if (w < 8) {
+                rec->values[j] = cpu->r[w];
+            } else {
+                rec->values[j] = cpu->seg[w - 8];
+            }
+        }
+
+        tp->hits++;
+        dbg->trace_total++;
+    }
+}
+
+/*
+ * Write the newest `count` trace records (all if count <= 0) to `out`,
+ * oldest first. A non-negative `filter` keeps only that tracepoint.
+ */
+void dbg_dump_trace(Micro16Debugger *dbg, FILE *out, int count, int filter) {
+    uint64_t first = 0;
+    if (dbg->trace_total > TRACE_BUFFER_SIZE) {
+        first = dbg->trace_total - TRACE_BUFFER_SIZE;
+    }
+
+    /* Walk backwards to find where the newest `count` matches start */
+    uint64_t start = dbg->trace_total;
+    int matched = 0;
+    while (start > first && (count <= 0 || matched < count)) {
+        start--;
+        const TraceRecord *rec = &dbg->trace_buf[start & (TRACE_BUFFER_SIZE - 1)];
+        if (filter < 0 || rec->tp_index == filter) matched++;
+    }
+
+    if (matched == 0) {
+        fprintf(out, "Trace buffer is empty\n");
+        return;
+    }
+
+    for (uint64_t seq = start; seq < dbg->trace_total; seq++) {
+        const TraceRecord *rec = &dbg->trace_buf[seq & (TRACE_BUFFER_SIZE - 1)];
+        if (filter >= 0 && rec->tp_index != filter) continue;
+
+        const Tracepoint *tp = &dbg->tracepoints[rec->tp_index];
+        fprintf(out, "#%-6lu cyc=%-10lu tp%-2d %04X:%04X:",
+                (unsigned long)seq, (unsigned long)rec->cycles,
+                rec->tp_index, rec->cs, rec->pc);
+        for (int j = 0; j < tp->item_count; j++) {
+            fprintf(out, " %s=%04X", trace_item_name(&tp->items[j]), rec->values[j]);
+        }
+        fprintf(out, "\n");
+    }
+
+    if (first > 0) {
+        fprintf(out, "(%lu older records overwritten)\n", (unsigned long)first);
+    }
+}
+
+bool dbg_save_trace(Micro16Debugger *dbg, const char *filename, int filter) {
+    FILE *f = fopen(filename, "w");
+    if (!f) {
+        printf("Error: Cannot create file '%s'\n", filename);
+        return false;
+    }
+
+    dbg_dump_trace(dbg, f, 0, filter);
+    fclose(f);
+
+    printf("Trace written to '%s'\n", filename);
+    return true;
+}
+
+void dbg_clear_trace(Micro16Debugger *dbg) {
+    dbg->trace_total = 0;
+    for (int i = 0; i < MAX_TRACEPOINTS; i++) {
+        dbg->tracepoints[i].hits = 0;
+    }
+}
+
 /* ========================================================================
  * Execution Control
  * ======================================================================== */
@@ -381,8 +579,12 @@ int dbg_step(Micro16Debugger *dbg) {
         return 0;
     }
 
+    if (dbg->tp_count > 0) {
+        dbg_check_tracepoints(dbg);
+    }
+
     dbg_save_prev_state(dbg);
-    int cycles = cpu_step(dbg->cpu);
+    int cycles = m16_cpu_step(dbg->cpu);
     return cycles;
 }
 
@@ -407,8 +609,13 @@ int dbg_run_until_break(Micro16Debugger *dbg, int max_cycles) {
         }
         first = false;
 
+        /* Tracepoints record and fall through without stopping */
+        if (dbg->tp_count > 0) {
+            dbg_check_tracepoints(dbg);
+        }
+
         /* Execute one instruction */
-        int cycles = cpu_step(dbg->cpu);
+        int cycles = m16_cpu_step(dbg->cpu);
         if (cycles == 0) break;
         total_cycles += cycles;
 
@@ -620,7 +827,7 @@ void dbg_show_stack(Micro16Debugger *dbg, int count) {
 
     uint16_t sp = cpu->sp;
     for (int i = 0; i < count && sp < 0xFFFE; i++, sp += 2) {
-        uint16_t word = cpu_read_word((Micro16CPU*)cpu, cpu->seg[SEG_SS], sp);
+        uint16_t word = m16_cpu_read_word((Micro16CPU*)cpu, cpu->seg[SEG_SS], sp);
         printf("%04X:%04X  %04X      %02X %02X",
                cpu->seg[SEG_SS], sp, word,
                (uint8_t)(word & 0xFF), (uint8_t)(word >> 8));
@@ -646,7 +853,7 @@ void dbg_show_current_instruction(Micro16Debugger *dbg) {
 
     uint32_t phys = seg_offset_to_phys(cpu->seg[SEG_CS], cpu->pc);
     int instr_len;
-    const char *disasm = cpu_disassemble(cpu, phys, &instr_len);
+    const char *disasm = m16_cpu_disassemble(cpu, phys, &instr_len);
 
     char bp_marker = dbg_has_breakpoint(dbg, cpu->seg[SEG_CS], cpu->pc) ? '*' : ' ';
 
@@ -676,7 +883,7 @@ void dbg_disassemble_at(Micro16Debugger *dbg, uint16_t segment, uint16_t offset,
         if (phys >= MEM_SIZE) break;
 
         int instr_len;
-        const char *disasm = cpu_disassemble(cpu, phys, &instr_len);
+        const char *disasm = m16_cpu_disassemble(cpu, phys, &instr_len);
 
         char bp_marker = dbg_has_breakpoint(dbg, segment, offset) ? '*' : ' ';
         char pc_marker = (segment == cpu->seg[SEG_CS] && offset == cpu->pc) ? '>' : ' ';
@@ -713,6 +920,15 @@ void dbg_show_help(void) {
     printf("    unwatch <n>            Remove watchpoint by index\n");
     printf("    watchlist, wl          List all watchpoints\n");
     printf("\n");
+    printf("  Tracepoints:\n");
+    printf("    trace <seg:off> <items>  Record items at address without stopping\n");
+    printf("                           items: registers, SP, FLAGS, [seg:off] (word)\n");
+    printf("    untrace <n>            Remove tracepoint by index\n");
+    printf("    tracelist, tl          List all tracepoints\n");
+    printf("    tdump [count] [n]      Show newest trace records (only tracepoint n)\n");
+    printf("    tsave <file> [n]       Write trace records to file\n");
+    printf("    tclear                 Discard recorded trace records\n");
+    printf("\n");
     printf("  Display:\n");
     printf("    regs, reg              Show general purpose registers\n");
     printf("    segs, seg              Show segment registers\n");
@@ -850,6 +1066,42 @@ static int parse_register(const char *str) {
     return -1;
 }
 
+/* Parse a tracepoint item: register name, SP, FLAGS or [seg:off] */
+static bool parse_trace_item(Micro16Debugger *dbg, const char *str, TraceItem *item) {
+    if (str[0] == '[') {
+        char buf[24];
+        size_t len = strlen(str);
+        if (len < 3 || len - 2 >= sizeof(buf) || str[len - 1] != ']') {
+            return false;
+        }
+        memcpy(buf, str + 1, len - 2);
+        buf[len - 2] = '\0';
+
+        uint16_t segment, offset;
+        if (!parse_seg_offset(dbg, buf, &segment, &offset)) {
+            return false;
+        }
+        item->kind = TRACE_ITEM_MEM;
+        item->which = seg_offset_to_phys(segment, offset) % MEM_SIZE;
+        return true;
+    }
+
+    item->kind = TRACE_ITEM_REG;
+    if (strcasecmp(str, "SP") == 0) {
+        item->which = TRACE_REG_SP;
+        return true;
+    }
+    if (strcasecmp(str, "FLAGS") == 0 || strcasecmp(str, "F") == 0) {
+        item->which = TRACE_REG_FLAGS;
+        return true;
+    }
+
+    int reg = parse_register(str);
+    if (reg < 0) return false;
+    item->which = (uint32_t)reg;
+    return true;
+}
+
 /* Parse hex value */
 static bool parse_hex(const char *str, uint16_t *value) {
     if (str == NULL || *str == '\0') return false;
@@ -925,7 +1177,7 @@ static void process_command(Micro16Debugger *dbg, char *line) {
         dbg_show_current_instruction(dbg);
     }
     else if (strcmp(cmd, "reset") == 0) {
-        cpu_reset(dbg->cpu);
+        m16_cpu_reset(dbg->cpu);
         dbg_save_prev_state(dbg);
         printf("CPU reset. CS:PC=%04X:%04X SS:SP=%04X:%04X\n",
                dbg->cpu->seg[SEG_CS], dbg->cpu->pc,
@@ -1046,6 +1298,69 @@ static void process_command(Micro16Debugger *dbg, char *line) {
         dbg_list_watchpoints(dbg);
     }
 
+    /* ===== Tracepoint Commands ===== */
+    else if (strcmp(cmd, "trace") == 0 || strcmp(cmd, "t") == 0) {
+        char *arg = strtok(NULL, " \t");
+        if (arg == NULL) {
+            printf("Usage: trace <seg:off> <item> [item...]\n");
+            return;
+        }
+
+        uint16_t segment, offset;
+        if (!parse_seg_offset(dbg, arg, &segment, &offset)) {
+            printf("Invalid address: %s\n", arg);
+            return;
+        }
+
+        TraceItem items[TRACE_MAX_ITEMS];
+        int item_count = 0;
+        char *tok;
+        while ((tok = strtok(NULL, " \t")) != NULL) {
+            if (item_count >= TRACE_MAX_ITEMS) {
+                printf("Too many items (max %d)\n", TRACE_MAX_ITEMS);
+                return;
+            }
+            if (!parse_trace_item(dbg, tok, &items[item_count])) {
+                printf("Invalid trace item: %s\n", tok);
+                return;
+            }
+            item_count++;
+        }
+        dbg_set_tracepoint(dbg, segment, offset, items, item_count);
+    }
+    else if (strcmp(cmd, "untrace") == 0) {
+        char *arg = strtok(NULL, " \t");
+        if (arg == NULL) {
+            printf("Usage: untrace <tracepoint_index>\n");
+            return;
+        }
+        int index = atoi(arg);
+        dbg_clear_tracepoint(dbg, index);
+    }
+    else if (strcmp(cmd, "tracelist") == 0 || strcmp(cmd, "tl") == 0) {
+        dbg_list_tracepoints(dbg);
+    }
+    else if (strcmp(cmd, "tdump") == 0) {
+        char *arg1 = strtok(NULL, " \t");
+        char *arg2 = strtok(NULL, " \t");
+        int count = arg1 ? atoi(arg1) : 20;
+        int filter = arg2 ? atoi(arg2) : -1;
+        dbg_dump_trace(dbg, stdout, count, filter);
+    }
+    else if (strcmp(cmd, "tsave") == 0) {
+        char *filename = strtok(NULL, " \t");
+        char *arg = strtok(NULL, " \t");
+        if (filename == NULL) {
+            printf("Usage: tsave <filename> [tracepoint_index]\n");
+            return;
+        }
+        dbg_save_trace(dbg, filename, arg ? atoi(arg) : -1);
+    }
+    else if (strcmp(cmd, "tclear") == 0) {
+        dbg_clear_trace(dbg);
+        printf("Trace buffer cleared\n");
+    }
+
     /* ===== Display Commands ===== */
     else if (strcmp(cmd, "regs") == 0 || strcmp(cmd, "reg") == 0 ||
              strcmp(cmd, "registers") == 0) {
@@ -1194,7 +1509,7 @@ int main(int argc, char *argv[]) {
     Micro16CPU cpu;
     Micro16Debugger dbg;
 
-    if (!cpu_init(&cpu)) {
+    if (!m16_cpu_init(&cpu)) {
         fprintf(stderr, "Failed to initialize CPU\n");
         return 1;
     }
@@ -1207,13 +1522,13 @@ int main(int argc, char *argv[]) {
         if (argc >= 3) {
             if (!parse_phys_addr(argv[2], &load_addr)) {
                 fprintf(stderr, "Invalid load address: %s\n", argv[2]);
-                cpu_free(&cpu);
+                m16_cpu_free(&cpu);
                 return 1;
             }
         }
 
         if (!dbg_load_binary(&dbg, argv[1], load_addr)) {
-            cpu_free(&cpu);
+            m16_cpu_free(&cpu);
             return 1;
         }
     } else {
@@ -1222,7 +1537,7 @@ int main(int argc, char *argv[]) {
 
     dbg_run(&dbg);
 
-    cpu_free(&cpu);
+    m16_cpu_free(&cpu);
     return cpu.error ? 1 : 0;
 }
 #endif /* DEBUGGER_AS_LIBRARY */
@@ -2,8 +2,8 @@
  * Micro16 Interactive Debugger/Monitor
  *
  * Provides an interactive debugging interface for the Micro16 CPU
- * with breakpoints, watchpoints, single-stepping, memory inspection,
- * segment viewing, and disassembly.
+ * with breakpoints, watchpoints, tracepoints, single-stepping, memory
+ * inspection, segment viewing, and disassembly.
  *
  * Key differences from Micro8 debugger:
  * - 20-bit physical addresses (segment:offset format)
@@ -11,6 +11,7 @@
  * - 8 x 16-bit general purpose registers
  * - Conditional breakpoints
  * - Register watchpoints
+ * - Non-stopping tracepoints logging to a ring buffer
  */
 
 #ifndef MICRO16_DEBUGGER_H
@@ -18,10 +19,20 @@
 
 #include "cpu.h"
 #include <stdbool.h>
+#include <stdio.h>
 
-/* Maximum breakpoints and watchpoints */
+/* Maximum breakpoints, watchpoints and tracepoints */
 #define MAX_BREAKPOINTS 32
 #define MAX_WATCHPOINTS 16
+#define MAX_TRACEPOINTS 16
+
+/* Trace ring buffer sizing */
+#define TRACE_MAX_ITEMS   8         /* Values recorded per tracepoint hit */
+#define TRACE_BUFFER_SIZE 4096      /* Ring buffer records (power of two) */
+
+/* Register numbers for trace items beyond R0-R7 and CS/DS/SS/ES (8-11) */
+#define TRACE_REG_SP      12
+#define TRACE_REG_FLAGS   13
 
 /* Condition operators for conditional breakpoints */
 typedef enum {
@@ -52,6 +63,36 @@ typedef struct {
     uint16_t last_value;        /* Last known value (for change detection) */
 } Watchpoint;
 
+/* What a trace item samples */
+typedef enum {
+    TRACE_ITEM_REG = 0,     /* Register (0-7 GP, 8-11 segment, SP, FLAGS) */
+    TRACE_ITEM_MEM          /* Memory word at a physical address */
+} TraceItemKind;
+
+typedef struct {
+    TraceItemKind kind;
+    uint32_t which;         /* Register number or physical address */
+} TraceItem;
+
+/* Tracepoint structure (record values and continue) */
+typedef struct {
+    bool active;                        /* Whether this tracepoint is enabled */
+    uint16_t segment;                   /* Segment of trigger address */
+    uint16_t offset;                    /* Offset of trigger address */
+    int item_count;                     /* Number of items to record */
+    TraceItem items[TRACE_MAX_ITEMS];   /* Items to record */
+    uint64_t hits;                      /* Times this tracepoint fired */
+} Tracepoint;
+
+/* One entry in the trace ring buffer */
+typedef struct {
+    uint64_t cycles;                    /* CPU cycle count at the hit */
+    uint16_t cs;                        /* CS at the hit */
+    uint16_t pc;                        /* PC at the hit */
+    uint8_t  tp_index;                  /* Tracepoint that produced it */
+    uint16_t values[TRACE_MAX_ITEMS];   /* Recorded values */
+} TraceRecord;
+
 /* Debugger state */
 typedef struct {
     Micro16CPU *cpu;                        /* Pointer to CPU being debugged */
@@ -59,6 +100,10 @@ typedef struct {
     int bp_count;                           /* Number of active breakpoints */
     Watchpoint watchpoints[MAX_WATCHPOINTS]; /* Watchpoint list */
     int wp_count;                           /* Number of active watchpoints */
+    Tracepoint tracepoints[MAX_TRACEPOINTS]; /* Tracepoint list */
+    int tp_count;                           /* Number of active tracepoints */
+    TraceRecord trace_buf[TRACE_BUFFER_SIZE]; /* Preallocated trace ring buffer */
+    uint64_t trace_total;                   /* Records written since last clear */
     bool running;                           /* Debugger is running (not quit) */
 
     /* Previous register values for highlighting changes */
@@ -91,6 +136,16 @@ int  dbg_check_watchpoints(Micro16Debugger *dbg);  /* Returns watchpoint index o
 void dbg_list_watchpoints(Micro16Debugger *dbg);
 void dbg_update_watchpoint_values(Micro16Debugger *dbg);
 
+/* Tracepoint management */
+bool dbg_set_tracepoint(Micro16Debugger *dbg, uint16_t segment, uint16_t offset,
+                        const TraceItem *items, int item_count);
+bool dbg_clear_tracepoint(Micro16Debugger *dbg, int index);
+void dbg_list_tracepoints(Micro16Debugger *dbg);
+void dbg_check_tracepoints(Micro16Debugger *dbg);   /* Record hits at current CS:PC */
+void dbg_dump_trace(Micro16Debugger *dbg, FILE *out, int count, int filter);
+bool dbg_save_trace(Micro16Debugger *dbg, const char *filename, int filter);
+void dbg_clear_trace(Micro16Debugger *dbg);
+
 /* Execution control */
 int dbg_step(Micro16Debugger *dbg);                       /* Execute one instruction */
 int dbg_run_until_break(Micro16Debugger *dbg, int max_cycles); /* Run until halt/breakpoint/watchpoint */
@@ -213,7 +213,6 @@ static int get_instruction_length(const uint8_t *bytes, int remaining) {
     case OP_NOP:
     case OP_HLT:
     case OP_WAIT:
-    case OP_LOCK:
     case OP_IRET:
     case OP_CLI:
     case OP_STI:
@@ -284,6 +283,12 @@ static int get_instruction_length(const uint8_t *bytes, int remaining) {
     case OP_REPNZ:      /* REPNZ string_op */
         return 2;
 
+    case OP_LOCK:       /* LOCK op [addr16] / LOCK op reg, [addr16] */
+        if (remaining < 2) return 1;
+        if (bytes[1] == OP_INC || bytes[1] == OP_DEC) return 4;
+        if (bytes[1] == OP_ADD_RR || bytes[1] == OP_XCHG) return 5;
+        return 1;
+
     /* 3-byte instructions */
     case OP_JMP:        /* JMP addr16 */
     case OP_JZ:         /* JZ addr16 */
@@ -537,6 +542,22 @@ static int disassemble_instruction(int offset, char *mnemonic, size_t mnem_size,
 
     case OP_LOCK:
         snprintf(mnemonic, mnem_size, "LOCK");
+        switch (BYTE1) {
+        case OP_INC:
+            snprintf(operands, oper_size, "INC [0x%04X]", WORD23);
+            return 4;
+        case OP_DEC:
+            snprintf(operands, oper_size, "DEC [0x%04X]", WORD23);
+            return 4;
+        case OP_ADD_RR:
+            snprintf(operands, oper_size, "ADD [0x%04X], %s",
+                     WORD34, REG_NAMES[BYTE2 & 0x07]);
+            return 5;
+        case OP_XCHG:
+            snprintf(operands, oper_size, "XCHG %s, [0x%04X]",
+                     REG_NAMES[BYTE2 & 0x07], WORD34);
+            return 5;
+        }
         return 1;
 
     case OP_INT:
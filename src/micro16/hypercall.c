@@ -0,0 +1,199 @@
+/*
+ * Micro16 Hypercalls - Implementation
+ */
+
+#include "hypercall.h"
+#include <stdio.h>
+#include <string.h>
+
+/* ========================================================================
+ * Guest Memory Access
+ * ======================================================================== */
+
+/* Host pointer to `len` guest bytes at seg:off, or NULL if the run wraps */
+static uint8_t *guest_span(Micro16CPU *cpu, uint16_t seg, uint16_t off, uint32_t len) {
+    uint32_t phys = seg_offset_to_phys(seg, off);
+    if ((uint32_t)off + len > SEGMENT_SIZE || phys + len > MEM_SIZE) {
+        return NULL;
+    }
+    return &cpu->memory[phys];
+}
+
+/* Length of the NUL-terminated string at seg:off, or -1 if unterminated */
+static int guest_strlen(Micro16CPU *cpu, uint16_t seg, uint16_t off) {
+    uint32_t phys = seg_offset_to_phys(seg, off);
+    uint32_t limit = SEGMENT_SIZE - off;
+    if (phys >= MEM_SIZE) return -1;
+    if (phys + limit > MEM_SIZE) limit = MEM_SIZE - phys;
+
+    const uint8_t *nul = memchr(&cpu->memory[phys], 0, limit);
+    return nul ? (int)(nul - &cpu->memory[phys]) : -1;
+}
+
+/* ========================================================================
+ * Services
+ * ======================================================================== */
+
+/* Each service returns the number of bytes it touched, or -1 with AX set */
+
+static int hc_memcpy(Micro16CPU *cpu) {
+    uint16_t len = cpu->r[REG_R2];
+    uint8_t *src = guest_span(cpu, cpu->seg[SEG_DS], cpu->r[REG_R4], len);
+    uint8_t *dst = guest_span(cpu, cpu->seg[SEG_ES], cpu->r[REG_R5], len);
+    if (src == NULL || dst == NULL) {
+        cpu->r[REG_R0] = HC_ERR_BUFFER;
+        return -1;
+    }
+    memmove(dst, src, len);
+    cpu->r[REG_R0] = 0;
+    return len;
+}
+
+static int hc_memset(Micro16CPU *cpu) {
+    uint16_t len = cpu->r[REG_R2];
+    uint8_t *dst = guest_span(cpu, cpu->seg[SEG_ES], cpu->r[REG_R5], len);
+    if (dst == NULL) {
+        cpu->r[REG_R0] = HC_ERR_BUFFER;
+        return -1;
+    }
+    memset(dst, cpu->r[REG_R1] & 0xFF, len);
+    cpu->r[REG_R0] = 0;
+    return len;
+}
+
+static int hc_strlen(Micro16CPU *cpu) {
+    int len = guest_strlen(cpu, cpu->seg[SEG_DS], cpu->r[REG_R4]);
+    if (len < 0) {
+        cpu->r[REG_R0] = HC_ERR_BUFFER;
+        return -1;
+    }
+    cpu->r[REG_R0] = (uint16_t)len;
+    return len + 1;
+}
+
+static int hc_print(Micro16CPU *cpu) {
+    uint16_t ds = cpu->seg[SEG_DS];
+    int fmt_len = guest_strlen(cpu, ds, cpu->r[REG_R4]);
+    if (fmt_len < 0) {
+        cpu->r[REG_R0] = HC_ERR_BUFFER;
+        return -1;
+    }
+
+    const char *fmt = (const char *)guest_span(cpu, ds, cpu->r[REG_R4], (uint32_t)fmt_len);
+    uint16_t arg = cpu->r[REG_R1];
+    int written = 0;
+    int touched = fmt_len + 1;
+
+    for (int i = 0; i < fmt_len; i++) {
+        if (fmt[i] != '%' || i + 1 >= fmt_len) {
+            putchar(fmt[i]);
+            written++;
+            continue;
+        }
+
+        char spec = fmt[++i];
+        if (spec == '%') {
+            putchar('%');
+            written++;
+            continue;
+        }
+
+        uint16_t value = m16_cpu_read_word(cpu, ds, arg);
+        arg += 2;
+        switch (spec) {
+        case 'd': written += printf("%d", (int16_t)value); break;
+        case 'u': written += printf("%u", value); break;
+        case 'x': written += printf("%x", value); break;
+        case 'X': written += printf("%X", value); break;
+        case 'c': putchar(value & 0xFF); written++; break;
+        case 's': {
+            int len = guest_strlen(cpu, ds, value);
+            if (len > 0) {
+                fwrite(guest_span(cpu, ds, value, (uint32_t)len), 1, (size_t)len, stdout);
+                written += len;
+                touched += len;
+            }
+            break;
+        }
+        default:
+            /* Unknown conversion: print it as-is */
+            putchar('%');
+            putchar(spec);
+            written += 2;
+            arg -= 2;
+            break;
+        }
+    }
+
+    cpu->r[REG_R0] = (uint16_t)written;
+    return touched;
+}
+
+/* A relative path with no ".." component stays inside the sandbox */
+static bool path_in_sandbox(const char *path) {
+    if (path[0] == '\0' || path[0] == '/') return false;
+    for (const char *p = path; *p; ) {
+        size_t n = strcspn(p, "/");
+        if (n == 2 && p[0] == '.' && p[1] == '.') return false;
+        p += n;
+        if (*p == '/') p++;
+    }
+    return true;
+}
+
+static int hc_read_file(Micro16CPU *cpu) {
+    uint16_t ds = cpu->seg[SEG_DS];
+    uint16_t len = cpu->r[REG_R2];
+    int path_len = guest_strlen(cpu, ds, cpu->r[REG_R4]);
+    uint8_t *dst = guest_span(cpu, cpu->seg[SEG_ES], cpu->r[REG_R5], len);
+    if (path_len < 0 || dst == NULL) {
+        cpu->r[REG_R0] = HC_ERR_BUFFER;
+        return -1;
+    }
+
+    const char *path = (const char *)guest_span(cpu, ds, cpu->r[REG_R4], (uint32_t)path_len + 1);
+    const char *root = cpu->hcall.root ? cpu->hcall.root : ".";
+    char host_path[1024];
+    if (!path_in_sandbox(path) ||
+        snprintf(host_path, sizeof(host_path), "%s/%s", root, path) >= (int)sizeof(host_path)) {
+        cpu->r[REG_R0] = HC_ERR_ACCESS;
+        return -1;
+    }
+
+    FILE *f = fopen(host_path, "rb");
+    if (f == NULL || fseek(f, cpu->r[REG_R3], SEEK_SET) != 0) {
+        if (f) fclose(f);
+        cpu->r[REG_R0] = HC_ERR_IO;
+        return -1;
+    }
+
+    size_t got = fread(dst, 1, len, f);
+    fclose(f);
+
+    cpu->r[REG_R0] = (uint16_t)got;
+    return (int)got;
+}
+
+/* ========================================================================
+ * Dispatch
+ * ======================================================================== */
+
+int m16_hypercall_dispatch(Micro16CPU *cpu) {
+    int touched;
+
+    switch (cpu->r[REG_R0]) {
+    case HC_MEMCPY:     touched = hc_memcpy(cpu); break;
+    case HC_MEMSET:     touched = hc_memset(cpu); break;
+    case HC_STRLEN:     touched = hc_strlen(cpu); break;
+    case HC_PRINT:      touched = hc_print(cpu); break;
+    case HC_READ_FILE:  touched = hc_read_file(cpu); break;
+    default:
+        cpu->r[REG_R0] = HC_ERR_FUNCTION;
+        touched = -1;
+        break;
+    }
+
+    cpu_set_flag(cpu, FLAG_C, touched < 0);
+    if (touched < 0) touched = 0;
+    return cpu->hcall.base_cycles + cpu->hcall.byte_cycles * touched;
+}
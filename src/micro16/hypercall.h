@@ -0,0 +1,50 @@
+/*
+ * Micro16 Hypercalls
+ *
+ * Native implementations of common runtime services. A guest selects
+ * the function in AX and traps with `INT 0x80` or `OUT 0xFF12, AX`;
+ * the emulator services the call in C and resumes at the next
+ * instruction. Failures set the carry flag; success clears it.
+ *
+ *   AX  Function     Arguments                          Result
+ *   01  memcpy       DS:SI source, ES:DI dest, CX len   AX = 0
+ *   02  memset       ES:DI dest, BL byte, CX len        AX = 0
+ *   03  strlen       DS:SI string                       AX = length
+ *   04  print        DS:SI format, DS:BX word args      AX = chars written
+ *                    (%d %u %x %X %c %s %%; %s takes a DS offset)
+ *   05  read file    DS:SI path, ES:DI buffer, CX max,  AX = bytes read
+ *                    DX file offset
+ *
+ * Buffers must not wrap past the end of their segment.
+ *
+ * Read-file paths are relative to the sandbox directory (--hcall-root,
+ * default the current directory). Absolute paths and ".." components
+ * are refused with HC_ERR_ACCESS. Symlinks inside the sandbox are
+ * followed, so keep it free of links that point out.
+ * With hypercalls disabled, INT 0x80 goes through the IVT like any other
+ * vector and PORT_HCALL is an ordinary MMIO port, so the pure-ISA path
+ * behaves exactly as before.
+ */
+
+#ifndef MICRO16_HYPERCALL_H
+#define MICRO16_HYPERCALL_H
+
+#include "cpu.h"
+
+/* Function numbers (AX) */
+#define HC_MEMCPY       0x01
+#define HC_MEMSET       0x02
+#define HC_STRLEN       0x03
+#define HC_PRINT        0x04
+#define HC_READ_FILE    0x05
+
+/* Error codes returned in AX with carry set */
+#define HC_ERR_FUNCTION 0xFFFF      /* Unknown function number */
+#define HC_ERR_BUFFER   0xFFFE      /* Buffer wraps a segment or memory */
+#define HC_ERR_IO       0xFFFD      /* Host file error */
+#define HC_ERR_ACCESS   0xFFFC      /* Path escapes the sandbox */
+
+/* Service the call selected by AX; returns cycles to charge */
+int m16_hypercall_dispatch(Micro16CPU *cpu);
+
+#endif /* MICRO16_HYPERCALL_H */
@@ -4,13 +4,22 @@
  * Usage:
  *   micro16 run <file.bin>     - Load and run binary
  *   micro16 debug <file.bin>   - Load and debug interactively
+ *   micro16 smp <file.bin>     - Run on several cores sharing memory
+ *   micro16 sample <file.bin>  - Sampled simulation (BBV clustering)
+ *   micro16 bench <file.bin>   - Time repeated runs
+ *   micro16 host <file.bin>    - Many sessions over a thread pool
  *   micro16 help               - Show help
  */
 
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include "cpu.h"
+#include "smp.h"
+#include "sample.h"
+#include "../common/bench.h"
+#include "../common/sched.h"
 
 /* Print usage */
 static void print_usage(const char *prog) {
@@ -19,12 +28,36 @@ static void print_usage(const char *prog) {
     printf("Usage:\n");
     printf("  %s run <file.bin>     Load and run binary program\n", prog);
     printf("  %s debug <file.bin>   Load and run in debug mode (TODO)\n", prog);
+    printf("  %s smp <file.bin>     Run on several cores sharing memory\n", prog);
+    printf("  %s sample <file.bin>  Estimate detailed-model stats from sampled intervals\n", prog);
+    printf("  %s bench <file.bin>   Time repeated runs, append a CSV row\n", prog);
+    printf("  %s host <file.bin>    Run many sessions time-sliced over a thread pool\n", prog);
     printf("  %s help               Show this help\n", prog);
     printf("\n");
     printf("Options:\n");
     printf("  -v, --verbose         Verbose output during execution\n");
     printf("  -c, --cycles <n>      Maximum cycles to execute (default: 10M)\n");
     printf("  -a, --addr <hex>      Load address (default: CS:0100)\n");
+    printf("  -n, --cores <n>       SMP: number of cores (default: 2, max %d)\n", SMP_MAX_CORES);
+    printf("  -q, --quantum <n>     SMP: cycles per core per round (default: %d)\n",
+           SMP_DEFAULT_QUANTUM);
+    printf("                        Host: cycles per slice (default: %d)\n", SCHED_DEFAULT_QUANTUM);
+    printf("  -d, --deterministic   SMP: run cores in order on one thread\n");
+    printf("  -i, --interval <n>    Sample: instructions per interval (default: %d)\n",
+           SAMPLE_DEFAULT_INTERVAL);
+    printf("  -k, --clusters <n>    Sample: intervals to simulate in detail (default: %d)\n",
+           SAMPLE_DEFAULT_CLUSTERS);
+    printf("  --full                Sample: also run everything in detail to compare\n");
+    printf("  -r, --repeat <n>      Bench: runs to time (default: %d)\n", BENCH_DEFAULT_REPEAT);
+    printf("  --csv <file>          Bench: append the result row to file\n");
+    printf("  -s, --sessions <n>    Host: sessions to run (default: 64)\n");
+    printf("  -t, --threads <n>     Host: worker threads (default: one per host core)\n");
+    printf("  -I, --input <file>    Host: console input, one byte per wake of a parked\n");
+    printf("                        session (port 0x0040, vector 0x41)\n");
+    printf("  -H, --hypercalls      Service INT 0x80 / port 0xFF12 natively (see hypercall.h)\n");
+    printf("  --hcall-cost <b[,n]>  Cycles per hypercall (b) and per byte (n) (default: %d,0)\n",
+           HCALL_DEFAULT_BASE_CYCLES);
+    printf("  --hcall-root <dir>    Directory the read-file hypercall is confined to (default: .)\n");
     printf("\n");
     printf("Architecture:\n");
     printf("  16-bit data bus, 20-bit address bus (1MB)\n");
@@ -88,16 +121,18 @@ static bool load_binary(const char *filename, Micro16CPU *cpu, uint32_t load_add
 }
 
 /* Run mode */
-static int cmd_run(const char *filename, int max_cycles, uint32_t load_addr, bool verbose) {
+static int cmd_run(const char *filename, int max_cycles, uint32_t load_addr, bool verbose,
+                   const HypercallConfig *hcall) {
     Micro16CPU cpu;
 
-    if (!cpu_init(&cpu)) {
+    if (!m16_cpu_init(&cpu)) {
         printf("Error: Failed to initialize CPU\n");
         return 1;
     }
+    cpu.hcall = *hcall;
 
     if (!load_binary(filename, &cpu, load_addr)) {
-        cpu_free(&cpu);
+        m16_cpu_free(&cpu);
         return 1;
     }
 
@@ -108,22 +143,319 @@ static int cmd_run(const char *filename, int max_cycles, uint32_t load_addr, boo
     printf("\nRunning...\n");
     if (verbose) {
         printf("Initial state:\n");
-        cpu_dump_state(&cpu);
+        m16_cpu_dump_state(&cpu);
     }
     printf("----------------------------------------\n");
 
-    int cycles = cpu_run(&cpu, max_cycles);
+    int cycles = m16_cpu_run(&cpu, max_cycles);
 
     printf("----------------------------------------\n");
     printf("Execution complete. (%d cycles)\n\n", cycles);
-    cpu_dump_state(&cpu);
+    m16_cpu_dump_state(&cpu);
 
     if (cpu.error) {
         printf("\nERROR: %s\n", cpu.error_msg);
     }
 
     int result = cpu.error ? 1 : 0;
-    cpu_free(&cpu);
+    m16_cpu_free(&cpu);
+    return result;
+}
+
+/* SMP mode - every core starts at the load address */
+static int cmd_smp(const char *filename, int max_cycles, uint32_t load_addr,
+                   int num_cores, int quantum, bool deterministic,
+                   const HypercallConfig *hcall) {
+    static Micro16SMP smp;  /* Large; keep it off the stack */
+
+    if (!smp_init(&smp, num_cores, quantum,
+                  deterministic ? SMP_MODE_DETERMINISTIC : SMP_MODE_PARALLEL)) {
+        return 1;
+    }
+
+    /* Load through a CPU view of the shared memory */
+    Micro16CPU loader;
+    m16_cpu_init_shared(&loader, smp.memory);
+    if (!load_binary(filename, &loader, load_addr)) {
+        smp_free(&smp);
+        return 1;
+    }
+
+    smp_set_entry(&smp, DEFAULT_CS, (uint16_t)(load_addr - ((uint32_t)DEFAULT_CS << 4)));
+    for (int i = 0; i < smp.num_cores; i++) {
+        smp.cores[i].cpu.hcall = *hcall;
+    }
+
+    printf("\nRunning on %d cores...\n", num_cores);
+    printf("----------------------------------------\n");
+
+    uint64_t cycles = smp_run(&smp, max_cycles > 0 ? (uint64_t)max_cycles : 0);
+
+    printf("----------------------------------------\n");
+    printf("Execution complete. (%lu cycles per core)\n\n", (unsigned long)cycles);
+    smp_dump_state(&smp);
+
+    int result = 0;
+    for (int i = 0; i < smp.num_cores; i++) {
+        if (smp.cores[i].cpu.error) result = 1;
+    }
+    smp_free(&smp);
+    return result;
+}
+
+/* Sample mode - detailed model on representative intervals only */
+/* |estimate - actual| as a percentage of actual */
+static double relative_error(double estimate, double actual) {
+    return actual > 0.0 ? 100.0 * fabs(estimate - actual) / actual : 0.0;
+}
+
+static int cmd_sample(const char *filename, uint32_t load_addr, const SampleConfig *cfg,
+                      bool full, const HypercallConfig *hcall) {
+    Micro16CPU cpu;
+    Micro16Snapshot start = {0};
+    SampleReport report;
+
+    if (!m16_cpu_init(&cpu)) {
+        printf("Error: Failed to initialize CPU\n");
+        return 1;
+    }
+    cpu.hcall = *hcall;
+
+    if (!load_binary(filename, &cpu, load_addr)) {
+        m16_cpu_free(&cpu);
+        return 1;
+    }
+    cpu.pc = load_addr - ((uint32_t)cpu.seg[SEG_CS] << 4);
+
+    if (full && !m16_cpu_snapshot_save(&cpu, &start)) {
+        printf("Error: Failed to allocate snapshot\n");
+        m16_cpu_free(&cpu);
+        return 1;
+    }
+
+    int result = 1;
+    if (sample_run(&cpu, cfg, &report)) {
+        printf("\n");
+        sample_print_report(&report);
+        result = 0;
+
+        if (full) {
+            DetailStats all;
+            m16_cpu_snapshot_restore(&cpu, &start);
+            sample_run_detailed(&cpu, report.instructions, &all);
+            double cpi = (double)all.cycles / (double)all.instructions;
+            double icache = (double)all.icache_misses / (double)all.instructions;
+            double mispredict = all.branches ? (double)all.mispredicts / (double)all.branches : 0.0;
+            printf("\nFull detailed run:\n");
+            printf("CPI:                      %.4f (CPI error: %.2f%%)\n",
+                   cpi, relative_error(report.cpi, cpi));
+            printf("I-cache misses per instr: %.4f (I-cache error: %.2f%%)\n",
+                   icache, relative_error(report.icache_miss_rate, icache));
+            printf("Branch mispredict rate:   %.2f%% (mispredict error: %.2f%%)\n",
+                   mispredict * 100.0, relative_error(report.mispredict_rate, mispredict));
+        }
+    }
+
+    m16_cpu_snapshot_free(&start);
+    m16_cpu_free(&cpu);
+    return result;
+}
+
+/* Bench mode - rerun from a snapshot of the loaded program, timing only m16_cpu_run */
+static int cmd_bench(const char *filename, int max_cycles, uint32_t load_addr, int repeat,
+                     const char *csv_path, const HypercallConfig *hcall) {
+    Micro16CPU cpu;
+    Micro16Snapshot start = {0};
+
+    if (!m16_cpu_init(&cpu)) {
+        printf("Error: Failed to initialize CPU\n");
+        return 1;
+    }
+    cpu.hcall = *hcall;
+
+    if (!load_binary(filename, &cpu, load_addr)) {
+        m16_cpu_free(&cpu);
+        return 1;
+    }
+    cpu.pc = load_addr - ((uint32_t)cpu.seg[SEG_CS] << 4);
+
+    if (!m16_cpu_snapshot_save(&cpu, &start)) {
+        printf("Error: Failed to allocate snapshot\n");
+        m16_cpu_free(&cpu);
+        return 1;
+    }
+
+    BenchResult r = { "micro16", filename, 0, 0, 0, 0.0, "ok" };
+
+    for (int i = 0; i < repeat; i++) {
+        m16_cpu_snapshot_restore(&cpu, &start);
+
+        double t0 = bench_now();
+        m16_cpu_run(&cpu, max_cycles);
+        r.seconds += bench_now() - t0;
+
+        r.iterations++;
+        r.instructions += cpu.instructions;
+        r.cycles += cpu.cycles;
+
+        if (cpu.error || !cpu.halted) {
+            r.status = cpu.error ? "error" : "timeout";
+            break;
+        }
+    }
+
+    bench_print_summary(&r);
+    int result = bench_write_csv(&r, csv_path) && strcmp(r.status, "ok") == 0 ? 0 : 1;
+    m16_cpu_snapshot_free(&start);
+    m16_cpu_free(&cpu);
+    return result;
+}
+
+/* Host mode: one scheduler slice of a session */
+static SessionState host_slice(void *core, int quantum, uint64_t *cycles) {
+    Micro16CPU *cpu = core;
+    uint64_t before = cpu->cycles;
+
+    m16_cpu_run(cpu, quantum);
+    *cycles = cpu->cycles - before;
+
+    if (cpu->halted || cpu->error) return SESSION_DONE;
+    if (m16_cpu_is_idle(cpu)) return SESSION_IDLE;
+    return SESSION_RUNNABLE;
+}
+
+/*
+ * Host console input (-I): when a session parks waiting for an
+ * interrupt, the host posts its next input byte at HOST_INPUT_PORT
+ * (HOST_INPUT_END once the input is used up), raises HOST_INPUT_VECTOR
+ * and wakes the session. Every session reads the whole input.
+ */
+#define HOST_INPUT_PORT     0x0040
+#define HOST_INPUT_VECTOR   0x41
+#define HOST_INPUT_END      0xFFFF
+
+/* Post one input event to each parked session that has input left;
+ * returns the number woken. The scheduler must be quiet (sched_wait). */
+static int host_feed_input(Scheduler *sched, SchedSession *sessions, Micro16CPU *cpus,
+                           int count, const uint8_t *input, long len, long *pos) {
+    int woken = 0;
+    for (int i = 0; i < count; i++) {
+        if (sessions[i].state != SESSION_IDLE || pos[i] > len) continue;
+
+        uint16_t value = pos[i] < len ? input[pos[i]] : HOST_INPUT_END;
+        pos[i]++;
+        m16_cpu_write_phys_word(&cpus[i], MMIO_BASE + HOST_INPUT_PORT, value);
+        m16_cpu_request_interrupt(&cpus[i], HOST_INPUT_VECTOR);
+        sched_wake(sched, &sessions[i]);
+        woken++;
+    }
+    return woken;
+}
+
+/* Whole file into a new buffer; NULL on error */
+static uint8_t *read_file(const char *filename, long *len) {
+    FILE *f = fopen(filename, "rb");
+    if (!f) {
+        printf("Error: Cannot open file '%s'\n", filename);
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    *len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    uint8_t *buf = malloc(*len > 0 ? (size_t)*len : 1);
+    if (buf != NULL && fread(buf, 1, (size_t)*len, f) != (size_t)*len) {
+        free(buf);
+        buf = NULL;
+    }
+    fclose(f);
+    return buf;
+}
+
+/* Host mode - many independent sessions of one program over a thread pool */
+static int cmd_host(const char *filename, uint32_t load_addr, int num_sessions,
+                    int threads, int quantum, const char *input_path,
+                    const HypercallConfig *hcall) {
+    Micro16Snapshot start = {0};
+    Micro16CPU *cpus = calloc((size_t)num_sessions, sizeof(Micro16CPU));
+    SchedSession *sessions = calloc((size_t)num_sessions, sizeof(SchedSession));
+    long *input_pos = calloc((size_t)num_sessions, sizeof(long));
+    uint8_t *input = NULL;
+    long input_len = 0;
+    Scheduler sched;
+    int ready = 0;
+    int result = 1;
+
+    if (input_path != NULL && (input = read_file(input_path, &input_len)) == NULL) {
+        goto out;
+    }
+    if (cpus == NULL || sessions == NULL || input_pos == NULL || !m16_cpu_init(&cpus[0])) {
+        printf("Error: Failed to allocate %d sessions\n", num_sessions);
+        goto out;
+    }
+    ready = 1;
+    cpus[0].hcall = *hcall;
+
+    if (!load_binary(filename, &cpus[0], load_addr)) goto out;
+    cpus[0].pc = load_addr - ((uint32_t)cpus[0].seg[SEG_CS] << 4);
+
+    if (!m16_cpu_snapshot_save(&cpus[0], &start)) {
+        printf("Error: Failed to allocate snapshot\n");
+        goto out;
+    }
+    for (; ready < num_sessions; ready++) {
+        if (!m16_cpu_init(&cpus[ready])) {
+            printf("Error: Out of memory after %d sessions\n", ready);
+            goto out;
+        }
+        m16_cpu_snapshot_restore(&cpus[ready], &start);
+    }
+
+    if (!sched_init(&sched, threads, quantum)) {
+        printf("Error: Failed to start worker threads\n");
+        goto out;
+    }
+    printf("Running %d sessions on %d threads, %d cycles per slice...\n",
+           num_sessions, sched.num_threads, sched.quantum);
+
+    double t0 = bench_now();
+    for (int i = 0; i < num_sessions; i++) {
+        sched_add(&sched, &sessions[i], i, &cpus[i], host_slice);
+    }
+    uint64_t wakes = 0;
+    for (;;) {
+        sched_wait(&sched);
+        if (input == NULL) break;
+        int woken = host_feed_input(&sched, sessions, cpus, num_sessions,
+                                    input, input_len, input_pos);
+        if (woken == 0) break;
+        wakes += (uint64_t)woken;
+    }
+    double wall = bench_now() - t0;
+    sched_shutdown(&sched);
+
+    sched_print_report(sessions, num_sessions, wall);
+    if (input != NULL) {
+        printf("Input: %ld bytes per session, %lu wakes\n", input_len, (unsigned long)wakes);
+    }
+
+    result = 0;
+    for (int i = 0; i < num_sessions; i++) {
+        if (cpus[i].error) {
+            printf("Session %d: ERROR: %s\n", i, cpus[i].error_msg);
+            result = 1;
+        }
+    }
+
+out:
+    for (int i = 0; i < ready; i++) {
+        m16_cpu_free(&cpus[i]);
+    }
+    m16_cpu_snapshot_free(&start);
+    free(input);
+    free(input_pos);
+    free(sessions);
+    free(cpus);
     return result;
 }
 
@@ -131,13 +463,13 @@ static int cmd_run(const char *filename, int max_cycles, uint32_t load_addr, boo
 static int cmd_debug(const char *filename, uint32_t load_addr) {
     Micro16CPU cpu;
 
-    if (!cpu_init(&cpu)) {
+    if (!m16_cpu_init(&cpu)) {
         printf("Error: Failed to initialize CPU\n");
         return 1;
     }
 
     if (!load_binary(filename, &cpu, load_addr)) {
-        cpu_free(&cpu);
+        m16_cpu_free(&cpu);
         return 1;
     }
 
@@ -155,7 +487,7 @@ static int cmd_debug(const char *filename, uint32_t load_addr) {
         /* Show current instruction */
         uint32_t phys_pc = seg_offset_to_phys(cpu.seg[SEG_CS], cpu.pc);
         int len;
-        const char *disasm = cpu_disassemble(&cpu, phys_pc, &len);
+        const char *disasm = m16_cpu_disassemble(&cpu, phys_pc, &len);
         printf("%04X:%04X  %s\n", cpu.seg[SEG_CS], cpu.pc, disasm);
 
         /* Get command */
@@ -171,10 +503,10 @@ static int cmd_debug(const char *filename, uint32_t load_addr) {
 
         /* Parse command */
         if (line[0] == '\0' || strcmp(line, "s") == 0 || strcmp(line, "step") == 0) {
-            cpu_step(&cpu);
+            m16_cpu_step(&cpu);
         }
         else if (strcmp(line, "r") == 0 || strcmp(line, "run") == 0) {
-            int cycles = cpu_run(&cpu, 1000000);
+            int cycles = m16_cpu_run(&cpu, 1000000);
             printf("Ran %d cycles\n", cycles);
         }
         else if (strcmp(line, "q") == 0 || strcmp(line, "quit") == 0) {
@@ -182,13 +514,13 @@ static int cmd_debug(const char *filename, uint32_t load_addr) {
         }
         else if (strcmp(line, "reg") == 0 || strcmp(line, "regs") == 0 ||
                  strcmp(line, "registers") == 0) {
-            cpu_dump_state(&cpu);
+            m16_cpu_dump_state(&cpu);
         }
         else if (strncmp(line, "mem ", 4) == 0) {
             uint32_t addr = 0;
             int count = 64;
             if (sscanf(line + 4, "%x %d", &addr, &count) >= 1) {
-                cpu_dump_memory(&cpu, addr, addr + count - 1);
+                m16_cpu_dump_memory(&cpu, addr, addr + count - 1);
             } else {
                 printf("Usage: mem <addr> [count]\n");
             }
@@ -214,10 +546,10 @@ static int cmd_debug(const char *filename, uint32_t load_addr) {
         printf("\nERROR: %s\n", cpu.error_msg);
     }
 
-    cpu_dump_state(&cpu);
+    m16_cpu_dump_state(&cpu);
 
     int result = cpu.error ? 1 : 0;
-    cpu_free(&cpu);
+    m16_cpu_free(&cpu);
     return result;
 }
 
@@ -233,6 +565,17 @@ int main(int argc, char *argv[]) {
     int max_cycles = 10000000;  /* 10M default */
     uint32_t load_addr = seg_offset_to_phys(DEFAULT_CS, DEFAULT_PC);  /* 0x00100 */
     bool verbose = false;
+    int num_cores = 2;
+    int quantum = 0;            /* 0 = the command's own default */
+    bool deterministic = false;
+    HypercallConfig hcall = { false, HCALL_DEFAULT_BASE_CYCLES, 0, NULL };
+    SampleConfig sample = { SAMPLE_DEFAULT_INTERVAL, SAMPLE_DEFAULT_CLUSTERS, 0 };
+    bool sample_full = false;
+    int repeat = BENCH_DEFAULT_REPEAT;
+    const char *csv_path = NULL;
+    int num_sessions = 64;
+    int threads = 0;
+    const char *input_path = NULL;
 
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "help") == 0 || strcmp(argv[i], "--help") == 0 ||
@@ -251,6 +594,58 @@ int main(int argc, char *argv[]) {
                  i + 1 < argc) {
             load_addr = strtoul(argv[++i], NULL, 16);
         }
+        else if ((strcmp(argv[i], "-n") == 0 || strcmp(argv[i], "--cores") == 0) &&
+                 i + 1 < argc) {
+            num_cores = atoi(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "-q") == 0 || strcmp(argv[i], "--quantum") == 0) &&
+                 i + 1 < argc) {
+            quantum = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-d") == 0 || strcmp(argv[i], "--deterministic") == 0) {
+            deterministic = true;
+        }
+        else if ((strcmp(argv[i], "-i") == 0 || strcmp(argv[i], "--interval") == 0) &&
+                 i + 1 < argc) {
+            sample.interval = atoi(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "-k") == 0 || strcmp(argv[i], "--clusters") == 0) &&
+                 i + 1 < argc) {
+            sample.clusters = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--full") == 0) {
+            sample_full = true;
+        }
+        else if ((strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--repeat") == 0) &&
+                 i + 1 < argc) {
+            repeat = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            csv_path = argv[++i];
+        }
+        else if ((strcmp(argv[i], "-s") == 0 || strcmp(argv[i], "--sessions") == 0) &&
+                 i + 1 < argc) {
+            num_sessions = atoi(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "-t") == 0 || strcmp(argv[i], "--threads") == 0) &&
+                 i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "-I") == 0 || strcmp(argv[i], "--input") == 0) &&
+                 i + 1 < argc) {
+            input_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "-H") == 0 || strcmp(argv[i], "--hypercalls") == 0) {
+            hcall.enabled = true;
+        }
+        else if (strcmp(argv[i], "--hcall-cost") == 0 && i + 1 < argc) {
+            char *end;
+            hcall.base_cycles = (int)strtol(argv[++i], &end, 10);
+            hcall.byte_cycles = (*end == ',') ? atoi(end + 1) : 0;
+        }
+        else if (strcmp(argv[i], "--hcall-root") == 0 && i + 1 < argc) {
+            hcall.root = argv[++i];
+        }
         else if (cmd == NULL) {
             cmd = argv[i];
         }
@@ -271,7 +666,7 @@ int main(int argc, char *argv[]) {
             print_usage(argv[0]);
             return 1;
         }
-        return cmd_run(filename, max_cycles, load_addr, verbose);
+        return cmd_run(filename, max_cycles, load_addr, verbose, &hcall);
     }
     else if (strcmp(cmd, "debug") == 0) {
         if (filename == NULL) {
@@ -281,6 +676,50 @@ int main(int argc, char *argv[]) {
         }
         return cmd_debug(filename, load_addr);
     }
+    else if (strcmp(cmd, "smp") == 0) {
+        if (filename == NULL) {
+            printf("Error: Missing filename\n\n");
+            print_usage(argv[0]);
+            return 1;
+        }
+        return cmd_smp(filename, max_cycles, load_addr, num_cores,
+                       quantum > 0 ? quantum : SMP_DEFAULT_QUANTUM, deterministic,
+                       &hcall);
+    }
+    else if (strcmp(cmd, "sample") == 0) {
+        if (filename == NULL) {
+            printf("Error: Missing filename\n\n");
+            print_usage(argv[0]);
+            return 1;
+        }
+        if (sample.interval < 1) {
+            printf("Error: Interval must be at least 1 instruction\n");
+            return 1;
+        }
+        sample.max_cycles = max_cycles > 0 ? (uint64_t)max_cycles : 0;
+        return cmd_sample(filename, load_addr, &sample, sample_full, &hcall);
+    }
+    else if (strcmp(cmd, "bench") == 0) {
+        if (filename == NULL) {
+            printf("Error: Missing filename\n\n");
+            print_usage(argv[0]);
+            return 1;
+        }
+        return cmd_bench(filename, max_cycles, load_addr, repeat, csv_path, &hcall);
+    }
+    else if (strcmp(cmd, "host") == 0) {
+        if (filename == NULL) {
+            printf("Error: Missing filename\n\n");
+            print_usage(argv[0]);
+            return 1;
+        }
+        if (num_sessions < 1) {
+            printf("Error: Need at least 1 session\n");
+            return 1;
+        }
+        return cmd_host(filename, load_addr, num_sessions, threads,
+                        quantum > 0 ? quantum : SCHED_DEFAULT_QUANTUM, input_path, &hcall);
+    }
     else {
         printf("Unknown command: %s\n\n", cmd);
         print_usage(argv[0]);
@@ -0,0 +1,95 @@
+/*
+ * Micro16 Programmable Interrupt Controller - Implementation
+ */
+
+#include "pic.h"
+
+/* Recompute which requests may interrupt right now */
+static void pic_update(Micro16PIC *pic) {
+    uint16_t requests = pic->irr & (uint16_t)~pic->imr;
+
+    /* Only lines above the highest-priority one in service may nest */
+    uint16_t allowed = 0xFFFF;
+    if (pic->isr != 0) {
+        uint16_t top = pic->isr & (uint16_t)-pic->isr;
+        allowed = (uint16_t)(top - 1);
+    }
+
+    pic->ready = requests & allowed;
+    pic->pending = pic->ready != 0 ||
+                   (pic->virr[0] | pic->virr[1] | pic->virr[2] | pic->virr[3]) != 0;
+}
+
+void m16_pic_reset(Micro16PIC *pic) {
+    pic->irr = 0;
+    pic->imr = 0xFFFF;      /* All lines masked until software sets up vectors */
+    pic->isr = 0;
+    pic->ready = 0;
+    pic->base = PIC_DEFAULT_BASE;
+    for (int i = 0; i < 4; i++) pic->virr[i] = 0;
+    pic->pending = false;
+}
+
+void m16_pic_raise(Micro16PIC *pic, int line) {
+    if (line < 0 || line >= PIC_LINES) return;
+    pic->irr |= (uint16_t)(1u << line);
+    pic_update(pic);
+}
+
+void m16_pic_raise_vector(Micro16PIC *pic, uint8_t vector) {
+    pic->virr[vector >> 6] |= 1ull << (vector & 63);
+    pic->pending = true;
+}
+
+uint8_t m16_pic_acknowledge(Micro16PIC *pic) {
+    for (int i = 0; i < 4; i++) {
+        if (pic->virr[i] != 0) {
+            int bit = __builtin_ctzll(pic->virr[i]);
+            pic->virr[i] &= pic->virr[i] - 1;
+            pic_update(pic);
+            return (uint8_t)(i * 64 + bit);
+        }
+    }
+
+    int line = __builtin_ctz(pic->ready);
+    uint16_t bit = (uint16_t)(1u << line);
+
+    pic->irr &= (uint16_t)~bit;
+    pic->isr |= bit;
+    pic_update(pic);
+
+    return (uint8_t)(pic->base + line);
+}
+
+bool m16_pic_port_read(const Micro16PIC *pic, uint16_t port, uint16_t *value) {
+    switch (port) {
+    case PORT_PIC_IMR:  *value = pic->imr;  return true;
+    case PORT_PIC_IRR:  *value = pic->irr;  return true;
+    case PORT_PIC_ISR:  *value = pic->isr;  return true;
+    case PORT_PIC_BASE: *value = pic->base; return true;
+    case PORT_PIC_EOI:  *value = 0;         return true;
+    default:            return false;
+    }
+}
+
+bool m16_pic_port_write(Micro16PIC *pic, uint16_t port, uint16_t value) {
+    switch (port) {
+    case PORT_PIC_EOI:
+        /* Non-specific EOI: retire the highest-priority line in service */
+        pic->isr &= (uint16_t)(pic->isr - 1);
+        break;
+    case PORT_PIC_IMR:
+        pic->imr = value;
+        break;
+    case PORT_PIC_IRR:
+        pic->irr |= value;
+        break;
+    case PORT_PIC_BASE:
+        pic->base = (uint8_t)(value & 0xFF);
+        break;
+    default:
+        return false;
+    }
+    pic_update(pic);
+    return true;
+}
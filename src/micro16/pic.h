@@ -0,0 +1,65 @@
+/*
+ * Micro16 Programmable Interrupt Controller
+ *
+ * 16 interrupt request lines in front of the CPU's interrupt input:
+ * - Line 0 has the highest priority, line 15 the lowest
+ * - IRR latches requests, so raising a line never loses an earlier one
+ * - IMR masks lines; ISR tracks lines whose handlers are running
+ * - A handler can be interrupted only by a higher-priority line
+ *   (nested interrupts); EOI retires the highest-priority ISR bit
+ * - Line n raises vector base + n
+ *
+ * Timer events, IPIs and host-injected interrupts name a vector rather
+ * than a line. They latch in a 256-bit vectored IRR (one bit per vector),
+ * are taken before line requests, lowest vector first, and need no EOI.
+ * Any number of them can be pending at once.
+ *
+ * The registers are bitmasks. `ready` and `pending` are recomputed
+ * whenever they change, so the CPU's per-instruction check is a single
+ * test of `pending`.
+ */
+
+#ifndef MICRO16_PIC_H
+#define MICRO16_PIC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define PIC_LINES           16
+#define PIC_DEFAULT_BASE    0x30    /* Vectors 0x30-0x3F (IVT 0x000C0-0x000FF) */
+
+/* Ports (serviced by the CPU, see cpu.h) */
+#define PORT_PIC_EOI        0xFF08  /* OUT: end of interrupt (any value) */
+#define PORT_PIC_IMR        0xFF0A  /* IN/OUT: mask register (1 = masked) */
+#define PORT_PIC_IRR        0xFF0C  /* IN: requests; OUT: raise lines (software IRQ) */
+#define PORT_PIC_ISR        0xFF0E  /* IN: lines in service */
+#define PORT_PIC_BASE       0xFF10  /* IN/OUT: vector of line 0 */
+
+typedef struct {
+    uint16_t irr;           /* Interrupt request register */
+    uint16_t imr;           /* Interrupt mask register */
+    uint16_t isr;           /* In-service register */
+    uint16_t ready;         /* Unmasked requests allowed to interrupt now */
+    uint8_t  base;          /* Vector for line 0 */
+    uint64_t virr[4];       /* Vectored requests, bit n = vector n */
+    bool     pending;       /* Something is ready or vectored */
+} Micro16PIC;
+
+/* Lifecycle */
+void m16_pic_reset(Micro16PIC *pic);
+
+/* Device side: raise a request line (latched until acknowledged) */
+void m16_pic_raise(Micro16PIC *pic, int line);
+
+/* Timer/IPI/host side: request a vector directly (latched until taken) */
+void m16_pic_raise_vector(Micro16PIC *pic, uint8_t vector);
+
+/* CPU side: take the lowest vectored request, else the highest-priority
+ * ready line; returns its vector. Only valid when pic->pending is set. */
+uint8_t m16_pic_acknowledge(Micro16PIC *pic);
+
+/* Port access; return false if the port does not belong to the PIC */
+bool m16_pic_port_read(const Micro16PIC *pic, uint16_t port, uint16_t *value);
+bool m16_pic_port_write(Micro16PIC *pic, uint16_t port, uint16_t value);
+
+#endif /* MICRO16_PIC_H */
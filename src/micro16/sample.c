@@ -0,0 +1,523 @@
+/*
+ * Micro16 Sampled Simulation - Implementation
+ */
+
+#include "sample.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Per-interval profile from the fast pass */
+typedef struct {
+    float    bbv[SAMPLE_BBV_DIM];
+    uint64_t start;         /* cpu->instructions at the interval start */
+    uint64_t instructions;
+    uint64_t cycles;
+    int      cluster;
+} IntervalProfile;
+
+/* ========================================================================
+ * Instruction Classes
+ * ======================================================================== */
+
+/* Jumps, calls, returns, loops and software interrupts end a basic block */
+static bool ends_block(uint8_t op) {
+    return (op >= OP_JMP && op <= OP_LOOPNZ) || op == OP_INT || op == OP_IRET;
+}
+
+/* Length of a conditional branch, 0 for anything else */
+static int branch_length(uint8_t op) {
+    if (op >= OP_JZ && op <= OP_JBE) return 3;          /* opcode + addr16 */
+    if (op >= OP_LOOP && op <= OP_LOOPNZ) return 2;     /* opcode + rel8 */
+    return 0;
+}
+
+/* Random projection of a block address onto the BBV */
+static int bbv_bucket(uint32_t block_addr) {
+    return (int)(((block_addr * 2654435761u) >> 16) % SAMPLE_BBV_DIM);
+}
+
+/* Stop when the CPU can no longer make progress on its own */
+static bool cpu_stopped(const Micro16CPU *cpu) {
+    return cpu->halted || cpu->error || m16_cpu_is_idle(cpu);
+}
+
+/* ========================================================================
+ * Detailed Model
+ * ======================================================================== */
+
+typedef struct {
+    uint32_t icache_tag[DETAIL_ICACHE_LINES];
+    bool     icache_valid[DETAIL_ICACHE_LINES];
+    uint8_t  bp[DETAIL_BP_ENTRIES];     /* 2-bit saturating counters */
+} DetailModel;
+
+static void detail_init(DetailModel *m) {
+    memset(m, 0, sizeof(DetailModel));
+    memset(m->bp, 1, sizeof(m->bp));    /* Weakly not taken */
+}
+
+/* Execute one step under the model; returns false when the CPU stops */
+static bool detail_step(DetailModel *m, Micro16CPU *cpu, DetailStats *st) {
+    uint16_t cs = cpu->seg[SEG_CS];
+    uint16_t pc = cpu->pc;
+    uint32_t addr = seg_offset_to_phys(cs, pc);
+    uint64_t before = cpu->instructions;
+
+    int cycles = m16_cpu_step(cpu);
+    if (cycles == 0) return false;
+    st->cycles += cycles;
+    if (cpu->instructions == before) return true;   /* Waiting */
+    st->instructions++;
+
+    /* Instruction cache (one access per instruction) */
+    uint32_t line = addr / DETAIL_ICACHE_LINE_SIZE;
+    int idx = (int)(line % DETAIL_ICACHE_LINES);
+    if (!m->icache_valid[idx] || m->icache_tag[idx] != line) {
+        st->icache_misses++;
+        st->cycles += DETAIL_ICACHE_MISS_CYCLES;
+        m->icache_valid[idx] = true;
+        m->icache_tag[idx] = line;
+    }
+
+    /* Branch predictor */
+    int len = branch_length(cpu->ir);
+    if (len > 0) {
+        bool taken = cpu->seg[SEG_CS] != cs || cpu->pc != (uint16_t)(pc + len);
+        uint8_t *ctr = &m->bp[addr % DETAIL_BP_ENTRIES];
+        st->branches++;
+        if ((*ctr >= 2) != taken) {
+            st->mispredicts++;
+            st->cycles += DETAIL_MISPREDICT_CYCLES;
+        }
+        if (taken && *ctr < 3) (*ctr)++;
+        if (!taken && *ctr > 0) (*ctr)--;
+    }
+    return true;
+}
+
+/* Run `count` instructions (0 = until the CPU stops) under the model */
+static void detail_run(DetailModel *m, Micro16CPU *cpu, uint64_t count, DetailStats *st) {
+    uint64_t end = cpu->instructions + count;
+    while (!cpu_stopped(cpu) && (count == 0 || cpu->instructions < end)) {
+        if (!detail_step(m, cpu, st)) break;
+    }
+}
+
+void sample_run_detailed(Micro16CPU *cpu, uint64_t max_instructions, DetailStats *stats) {
+    DetailModel model;
+    detail_init(&model);
+    memset(stats, 0, sizeof(DetailStats));
+    detail_run(&model, cpu, max_instructions, stats);
+}
+
+/* ========================================================================
+ * Profiling (fast mode + basic-block vectors)
+ * ======================================================================== */
+
+static IntervalProfile *profile(Micro16CPU *cpu, const SampleConfig *cfg, int *count) {
+    int cap = 64;
+    int n = 0;
+    IntervalProfile *iv = (IntervalProfile *)malloc(cap * sizeof(IntervalProfile));
+    if (iv == NULL) return NULL;
+
+    float bbv[SAMPLE_BBV_DIM] = {0};
+    uint64_t start = cpu->instructions;
+    uint64_t start_cycles = cpu->cycles;
+    uint32_t block_addr = 0;
+    uint32_t block_len = 0;
+
+    for (;;) {
+        bool done = cpu_stopped(cpu) ||
+                    (cfg->max_cycles > 0 && cpu->cycles >= cfg->max_cycles);
+
+        if (!done) {
+            uint32_t pc = cpu_get_code_addr(cpu);
+            uint64_t before = cpu->instructions;
+            if (m16_cpu_step(cpu) == 0) {
+                done = true;
+            } else if (cpu->instructions != before) {
+                if (block_len++ == 0) block_addr = pc;
+                if (ends_block(cpu->ir)) {
+                    bbv[bbv_bucket(block_addr)] += (float)block_len;
+                    block_len = 0;
+                }
+            }
+        }
+
+        if (!done && cpu->instructions - start < (uint64_t)cfg->interval) continue;
+
+        /* Close the interval; a block straddling the edge counts in both */
+        if (block_len > 0) {
+            bbv[bbv_bucket(block_addr)] += (float)block_len;
+            block_len = 0;
+        }
+        if (cpu->instructions > start) {
+            if (n == cap) {
+                cap *= 2;
+                IntervalProfile *grown = (IntervalProfile *)realloc(iv, cap * sizeof(IntervalProfile));
+                if (grown == NULL) {
+                    free(iv);
+                    return NULL;
+                }
+                iv = grown;
+            }
+            memcpy(iv[n].bbv, bbv, sizeof(bbv));
+            iv[n].start = start;
+            iv[n].instructions = cpu->instructions - start;
+            iv[n].cycles = cpu->cycles - start_cycles;
+            iv[n].cluster = 0;
+            n++;
+        }
+        if (done) break;
+
+        memset(bbv, 0, sizeof(bbv));
+        start = cpu->instructions;
+        start_cycles = cpu->cycles;
+    }
+
+    *count = n;
+    return iv;
+}
+
+/* ========================================================================
+ * Clustering (k-means over normalized BBVs)
+ * ======================================================================== */
+
+static float bbv_distance(const float *a, const float *b) {
+    float d = 0.0f;
+    for (int i = 0; i < SAMPLE_BBV_DIM; i++) {
+        float diff = a[i] - b[i];
+        d += diff * diff;
+    }
+    return d;
+}
+
+static void normalize(IntervalProfile *iv, int n) {
+    for (int i = 0; i < n; i++) {
+        float sum = 0.0f;
+        for (int j = 0; j < SAMPLE_BBV_DIM; j++) sum += iv[i].bbv[j];
+        if (sum > 0.0f) {
+            for (int j = 0; j < SAMPLE_BBV_DIM; j++) iv[i].bbv[j] /= sum;
+        }
+    }
+}
+
+static int nearest(const float *bbv, float (*cent)[SAMPLE_BBV_DIM], int k) {
+    int best = 0;
+    float best_d = bbv_distance(bbv, cent[0]);
+    for (int c = 1; c < k; c++) {
+        float d = bbv_distance(bbv, cent[c]);
+        if (d < best_d) {
+            best_d = d;
+            best = c;
+        }
+    }
+    return best;
+}
+
+/* Returns the number of clusters actually formed (<= k), all non-empty */
+static int kmeans(IntervalProfile *iv, int n, int k, float (*cent)[SAMPLE_BBV_DIM]) {
+    /* Deterministic farthest-point seeding */
+    int used = 1;
+    memcpy(cent[0], iv[0].bbv, sizeof(cent[0]));
+    while (used < k) {
+        int far = -1;
+        float far_d = 0.0f;
+        for (int i = 0; i < n; i++) {
+            float d = bbv_distance(iv[i].bbv, cent[nearest(iv[i].bbv, cent, used)]);
+            if (d > far_d) {
+                far_d = d;
+                far = i;
+            }
+        }
+        if (far < 0) break;     /* Every interval already sits on a centroid */
+        memcpy(cent[used++], iv[far].bbv, sizeof(cent[0]));
+    }
+
+    for (int iter = 0; iter < 100; iter++) {
+        bool changed = false;
+        for (int i = 0; i < n; i++) {
+            int c = nearest(iv[i].bbv, cent, used);
+            if (c != iv[i].cluster || iter == 0) changed = true;
+            iv[i].cluster = c;
+        }
+        if (!changed) break;
+
+        for (int c = 0; c < used; c++) {
+            float sum[SAMPLE_BBV_DIM] = {0};
+            int members = 0;
+            for (int i = 0; i < n; i++) {
+                if (iv[i].cluster != c) continue;
+                for (int j = 0; j < SAMPLE_BBV_DIM; j++) sum[j] += iv[i].bbv[j];
+                members++;
+            }
+            if (members == 0) continue;     /* Keep the old centroid */
+            for (int j = 0; j < SAMPLE_BBV_DIM; j++) cent[c][j] = sum[j] / members;
+        }
+    }
+
+    /* Drop clusters left empty, renumbering the rest */
+    int remap[SAMPLE_MAX_CLUSTERS];
+    int formed = 0;
+    for (int c = 0; c < used; c++) {
+        remap[c] = -1;
+        for (int i = 0; i < n; i++) {
+            if (iv[i].cluster == c) {
+                remap[c] = formed;
+                break;
+            }
+        }
+        if (remap[c] < 0) continue;
+        if (formed != c) memcpy(cent[formed], cent[c], sizeof(cent[0]));
+        formed++;
+    }
+    for (int i = 0; i < n; i++) iv[i].cluster = remap[iv[i].cluster];
+    return formed;
+}
+
+/* ========================================================================
+ * Sampling Pipeline
+ * ======================================================================== */
+
+static double interval_cpi(const IntervalProfile *p) {
+    return (double)p->cycles / (double)p->instructions;
+}
+
+/* Running mean and spread of one metric */
+typedef struct {
+    int    n;
+    double sum, sum_sq;
+} Spread;
+
+static void spread_add(Spread *s, double x) {
+    s->n++;
+    s->sum += x;
+    s->sum_sq += x * x;
+}
+
+static double spread_stddev(const Spread *s) {
+    if (s->n < 2) return 0.0;
+    double mean = s->sum / s->n;
+    double var = s->sum_sq / s->n - mean * mean;
+    return var > 0.0 ? sqrt(var) : 0.0;
+}
+
+/* Detail the representative in DETAIL_CHUNKS pieces, recording the spread
+ * of each metric across the pieces */
+static void detail_representative(DetailModel *m, Micro16CPU *cpu, uint64_t count,
+                                  SampleCluster *cl) {
+    Spread cpi = {0}, icache = {0}, mispredict = {0};
+
+    for (int i = 0; i < DETAIL_CHUNKS; i++) {
+        uint64_t n = count * (i + 1) / DETAIL_CHUNKS - count * i / DETAIL_CHUNKS;
+        DetailStats piece = {0};
+        if (n == 0) continue;
+
+        detail_run(m, cpu, n, &piece);
+        if (piece.instructions == 0) break;
+
+        double instr = (double)piece.instructions;
+        spread_add(&cpi, (double)piece.cycles / instr);
+        spread_add(&icache, (double)piece.icache_misses / instr);
+        if (piece.branches > 0) {
+            spread_add(&mispredict, (double)piece.mispredicts / (double)piece.branches);
+        }
+
+        cl->detail.instructions += piece.instructions;
+        cl->detail.cycles += piece.cycles;
+        cl->detail.icache_misses += piece.icache_misses;
+        cl->detail.branches += piece.branches;
+        cl->detail.mispredicts += piece.mispredicts;
+    }
+
+    cl->detail_cpi_stddev = spread_stddev(&cpi);
+    cl->icache_miss_stddev = spread_stddev(&icache);
+    cl->mispredict_stddev = spread_stddev(&mispredict);
+}
+
+static int compare_start(const void *a, const void *b) {
+    uint64_t sa = ((const SampleCluster *)a)->start;
+    uint64_t sb = ((const SampleCluster *)b)->start;
+    return (sa > sb) - (sa < sb);
+}
+
+static void extrapolate(SampleReport *r) {
+    double cpi_var = 0.0, icache_var = 0.0, mispredict_var = 0.0;
+    double est_branches = 0.0, est_mispredicts = 0.0;
+
+    r->cpi = 0.0;
+    r->icache_miss_rate = 0.0;
+    for (int c = 0; c < r->num_clusters; c++) {
+        const SampleCluster *cl = &r->clusters[c];
+        const DetailStats *d = &cl->detail;
+        if (d->instructions == 0) continue;
+
+        double instr = (double)d->instructions;
+        r->cpi += cl->weight * (double)d->cycles / instr;
+        r->icache_miss_rate += cl->weight * (double)d->icache_misses / instr;
+        est_branches += cl->weight * (double)d->branches / instr;
+        est_mispredicts += cl->weight * (double)d->mispredicts / instr;
+
+        double w2 = cl->weight * cl->weight;
+        cpi_var += w2 * cl->detail_cpi_stddev * cl->detail_cpi_stddev;
+        icache_var += w2 * cl->icache_miss_stddev * cl->icache_miss_stddev;
+    }
+    r->mispredict_rate = est_branches > 0.0 ? est_mispredicts / est_branches : 0.0;
+
+    /* The mispredict rate is per branch, so a cluster counts by its share
+     * of the branches rather than of the instructions */
+    for (int c = 0; c < r->num_clusters && est_branches > 0.0; c++) {
+        const SampleCluster *cl = &r->clusters[c];
+        const DetailStats *d = &cl->detail;
+        if (d->instructions == 0) continue;
+
+        double share = cl->weight * (double)d->branches / (double)d->instructions / est_branches;
+        mispredict_var += share * share * cl->mispredict_stddev * cl->mispredict_stddev;
+    }
+
+    r->cpi_err = sqrt(cpi_var);
+    r->icache_miss_rate_err = sqrt(icache_var);
+    r->mispredict_rate_err = sqrt(mispredict_var);
+}
+
+bool sample_run(Micro16CPU *cpu, const SampleConfig *cfg, SampleReport *report) {
+    Micro16Snapshot start_snap = {0};
+    Micro16Snapshot snaps[SAMPLE_MAX_CLUSTERS];
+    float cent[SAMPLE_MAX_CLUSTERS][SAMPLE_BBV_DIM];
+    SampleReport *r = report;
+    bool ok = false;
+
+    memset(r, 0, sizeof(SampleReport));
+    memset(snaps, 0, sizeof(snaps));
+    int k = cfg->clusters;
+    if (k < 1) k = 1;
+    if (k > SAMPLE_MAX_CLUSTERS) k = SAMPLE_MAX_CLUSTERS;
+
+    if (!m16_cpu_snapshot_save(cpu, &start_snap)) {
+        fprintf(stderr, "Error: Failed to allocate snapshot\n");
+        return false;
+    }
+
+    /* 1. Profile */
+    int n = 0;
+    IntervalProfile *iv = profile(cpu, cfg, &n);
+    if (iv == NULL || n == 0) {
+        fprintf(stderr, "Error: Profiling produced no intervals\n");
+        goto out;
+    }
+    r->intervals = n;
+    for (int i = 0; i < n; i++) {
+        r->instructions += iv[i].instructions;
+        r->cycles += iv[i].cycles;
+    }
+    r->fast_cpi = (double)r->cycles / (double)r->instructions;
+
+    /* 2. Cluster and pick representatives */
+    normalize(iv, n);
+    if (k > n) k = n;
+    r->num_clusters = kmeans(iv, n, k, cent);
+
+    for (int c = 0; c < r->num_clusters; c++) {
+        SampleCluster *cl = &r->clusters[c];
+        uint64_t instr = 0;
+        double sum = 0.0, sum_sq = 0.0;
+        float best_d = 0.0f;
+
+        cl->representative = -1;
+        for (int i = 0; i < n; i++) {
+            if (iv[i].cluster != c) continue;
+            float d = bbv_distance(iv[i].bbv, cent[c]);
+            if (cl->representative < 0 || d < best_d) {
+                best_d = d;
+                cl->representative = i;
+            }
+            double cpi = interval_cpi(&iv[i]);
+            sum += cpi;
+            sum_sq += cpi * cpi;
+            instr += iv[i].instructions;
+            cl->members++;
+        }
+
+        double mean = sum / cl->members;
+        double var = sum_sq / cl->members - mean * mean;
+        cl->cpi_stddev = var > 0.0 ? sqrt(var) : 0.0;
+        cl->weight = (double)instr / (double)r->instructions;
+        cl->start = iv[cl->representative].start;
+    }
+
+    /* 3. Fast-forward, snapshotting each representative, in program order */
+    qsort(r->clusters, r->num_clusters, sizeof(SampleCluster), compare_start);
+    m16_cpu_snapshot_restore(cpu, &start_snap);
+    for (int c = 0; c < r->num_clusters; c++) {
+        SampleCluster *cl = &r->clusters[c];
+        uint64_t target = cl->start;
+        /* Start one interval early so the model warms up */
+        uint64_t warm = target >= (uint64_t)cfg->interval ? target - cfg->interval : 0;
+
+        while (cpu->instructions < warm && !cpu_stopped(cpu)) {
+            if (m16_cpu_step(cpu) == 0) break;
+        }
+        if (!m16_cpu_snapshot_save(cpu, &snaps[c])) {
+            fprintf(stderr, "Error: Failed to allocate snapshot\n");
+            goto out;
+        }
+    }
+
+    /* 4. Detailed runs of the representatives only */
+    for (int c = 0; c < r->num_clusters; c++) {
+        SampleCluster *cl = &r->clusters[c];
+        DetailModel model;
+        DetailStats warmup = {0};
+
+        m16_cpu_snapshot_restore(cpu, &snaps[c]);
+        detail_init(&model);
+        if (cl->start > cpu->instructions) {
+            detail_run(&model, cpu, cl->start - cpu->instructions, &warmup);
+        }
+        detail_representative(&model, cpu, iv[cl->representative].instructions, cl);
+    }
+
+    /* 5. Extrapolate */
+    extrapolate(r);
+    ok = true;
+
+out:
+    free(iv);
+    for (int c = 0; c < SAMPLE_MAX_CLUSTERS; c++) {
+        m16_cpu_snapshot_free(&snaps[c]);
+    }
+    m16_cpu_snapshot_free(&start_snap);
+    return ok;
+}
+
+/* ========================================================================
+ * Report
+ * ======================================================================== */
+
+void sample_print_report(const SampleReport *r) {
+    uint64_t detailed = 0;
+
+    printf("=== Micro16 Sampled Simulation ===\n");
+    printf("Intervals: %d (%lu instructions, %lu cycles)\n",
+           r->intervals, (unsigned long)r->instructions, (unsigned long)r->cycles);
+    printf("\n");
+    printf("Cluster  Interval  Members  Weight   CPI spread\n");
+    for (int c = 0; c < r->num_clusters; c++) {
+        const SampleCluster *cl = &r->clusters[c];
+        printf("%7d  %8d  %7d  %6.2f%%  %10.4f\n",
+               c, cl->representative, cl->members, cl->weight * 100.0, cl->cpi_stddev);
+        detailed += cl->detail.instructions;
+    }
+    printf("\n");
+    printf("Detailed: %lu instructions (%.2f%% of the run)\n",
+           (unsigned long)detailed,
+           r->instructions ? 100.0 * (double)detailed / (double)r->instructions : 0.0);
+    printf("Estimated CPI:            %.4f +/- %.4f\n", r->cpi, r->cpi_err);
+    printf("Fast-pass CPI:            %.4f (no cache or predictor penalties)\n", r->fast_cpi);
+    printf("I-cache misses per instr: %.4f +/- %.4f\n",
+           r->icache_miss_rate, r->icache_miss_rate_err);
+    printf("Branch mispredict rate:   %.2f%% +/- %.2f%%\n",
+           r->mispredict_rate * 100.0, r->mispredict_rate_err * 100.0);
+}
@@ -0,0 +1,98 @@
+/*
+ * Micro16 Sampled Simulation
+ *
+ * Estimates detailed-model statistics for a long run without running
+ * all of it under the detailed model:
+ * 1. Profile: run the whole program in fast mode, collecting a
+ *    basic-block vector (BBV) for every interval of N instructions
+ * 2. Cluster: k-means over the normalized BBVs; the interval closest to
+ *    each centroid represents its cluster
+ * 3. Fast-forward: rerun from the start and snapshot the machine at the
+ *    start of every representative interval
+ * 4. Detail: restore each snapshot and run only that interval under the
+ *    detailed model (instruction cache + branch predictor, whose misses
+ *    and mispredicts cost cycles on top of the fast model's)
+ * 5. Extrapolate: weight each representative by its cluster's share of
+ *    the instructions
+ *
+ * Each representative is detailed in DETAIL_CHUNKS equal pieces. The
+ * spread of every metric across the pieces stands in for its spread
+ * across the cluster's members and gives that metric's error estimate;
+ * a piece varies more than a whole interval, so the bound is cautious.
+ * `micro16 sample --full` runs everything in detail to check the result.
+ */
+
+#ifndef MICRO16_SAMPLE_H
+#define MICRO16_SAMPLE_H
+
+#include "cpu.h"
+
+#define SAMPLE_BBV_DIM          32      /* Projected basic-block vector size */
+#define SAMPLE_MAX_CLUSTERS     16
+#define SAMPLE_DEFAULT_INTERVAL 10000   /* Instructions per interval */
+#define SAMPLE_DEFAULT_CLUSTERS 4
+
+/* Detailed model geometry */
+#define DETAIL_ICACHE_LINES     64      /* Direct-mapped */
+#define DETAIL_ICACHE_LINE_SIZE 16      /* Bytes */
+#define DETAIL_BP_ENTRIES       256     /* 2-bit counters, indexed by PC */
+#define DETAIL_ICACHE_MISS_CYCLES 8     /* Line refill */
+#define DETAIL_MISPREDICT_CYCLES  3     /* Pipeline refill after a wrong guess */
+#define DETAIL_CHUNKS           8       /* Pieces per representative interval */
+
+typedef struct {
+    int      interval;      /* Instructions per interval */
+    int      clusters;      /* k for k-means */
+    uint64_t max_cycles;    /* Stop profiling here (0 = run to HLT) */
+} SampleConfig;
+
+/* Detailed-model counters for a stretch of execution */
+typedef struct {
+    uint64_t instructions;
+    uint64_t cycles;
+    uint64_t icache_misses;
+    uint64_t branches;      /* Conditional branches */
+    uint64_t mispredicts;
+} DetailStats;
+
+typedef struct {
+    int         representative; /* Interval index */
+    uint64_t    start;          /* Instruction count where it begins */
+    int         members;
+    double      weight;         /* Share of all instructions */
+    double      cpi_stddev;     /* Fast-pass CPI spread across the members */
+    DetailStats detail;         /* Detailed run of the representative */
+    /* Spread of the detailed metrics across the representative's chunks */
+    double      detail_cpi_stddev;
+    double      icache_miss_stddev;     /* Per instruction */
+    double      mispredict_stddev;      /* Per branch */
+} SampleCluster;
+
+typedef struct {
+    int      intervals;
+    uint64_t instructions;  /* Whole run (fast pass) */
+    uint64_t cycles;
+
+    int           num_clusters;
+    SampleCluster clusters[SAMPLE_MAX_CLUSTERS];
+
+    /* Extrapolated detailed-model rates and their estimated standard errors */
+    double cpi, cpi_err;
+    double icache_miss_rate, icache_miss_rate_err;      /* Per instruction */
+    double mispredict_rate, mispredict_rate_err;        /* Per branch */
+    double fast_cpi;                                    /* Whole fast pass */
+} SampleReport;
+
+/*
+ * Run the sampling pipeline on a CPU that has its program loaded and is
+ * ready to start. The CPU is left somewhere inside the run; snapshot it
+ * first to run it again.
+ */
+bool sample_run(Micro16CPU *cpu, const SampleConfig *cfg, SampleReport *report);
+
+/* Run up to max_instructions (0 = to HLT) entirely under the detailed model */
+void sample_run_detailed(Micro16CPU *cpu, uint64_t max_instructions, DetailStats *stats);
+
+void sample_print_report(const SampleReport *report);
+
+#endif /* MICRO16_SAMPLE_H */
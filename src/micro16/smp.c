@@ -0,0 +1,329 @@
+/*
+ * Micro16 Symmetric Multiprocessing - Implementation
+ *
+ * Cores advance in rounds of `quantum` cycles. In parallel mode the
+ * coordinator (the thread calling smp_run) releases all core threads
+ * through a start barrier, each thread runs its core up to the round
+ * target, and everyone meets again at an end barrier. Shared memory is
+ * only synchronized by LOCK-prefixed instructions and by the barriers
+ * between rounds, which matches what guest software may rely on.
+ */
+
+#define _GNU_SOURCE
+#include "smp.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ========================================================================
+ * Barrier
+ * ======================================================================== */
+
+static void barrier_init(SMPBarrier *b, int count) {
+    pthread_mutex_init(&b->lock, NULL);
+    pthread_cond_init(&b->cond, NULL);
+    b->count = count;
+    b->waiting = 0;
+    b->generation = 0;
+}
+
+static void barrier_destroy(SMPBarrier *b) {
+    pthread_mutex_destroy(&b->lock);
+    pthread_cond_destroy(&b->cond);
+}
+
+static void barrier_wait(SMPBarrier *b) {
+    pthread_mutex_lock(&b->lock);
+    unsigned gen = b->generation;
+    if (++b->waiting == b->count) {
+        b->waiting = 0;
+        b->generation++;
+        pthread_cond_broadcast(&b->cond);
+    } else {
+        while (gen == b->generation) {
+            pthread_cond_wait(&b->cond, &b->lock);
+        }
+    }
+    pthread_mutex_unlock(&b->lock);
+}
+
+/* ========================================================================
+ * Core Execution
+ * ======================================================================== */
+
+/* Run one core until its time reaches `target` or it stops */
+static void run_quantum(SMPCore *core, uint64_t target) {
+    Micro16CPU *cpu = &core->cpu;
+
+    /* Latch every vector queued for this core in its PIC */
+    for (int i = 0; i < 4; i++) {
+        uint64_t irqs = __atomic_exchange_n(&core->irq_mailbox[i], 0, __ATOMIC_ACQ_REL);
+        for (; irqs != 0; irqs &= irqs - 1) {
+            m16_cpu_request_interrupt(cpu, (uint8_t)(i * 64 + __builtin_ctzll(irqs)));
+        }
+    }
+
+    while (!cpu->halted && !cpu->error && core->time < target) {
+        if (m16_cpu_is_idle(cpu)) {
+            /* Only another core or the host can wake it: sit the round out */
+            core->time = target;
+            break;
+        }
+        int cycles = m16_cpu_step(cpu);
+        if (cycles == 0) break;
+        core->time += cycles;
+    }
+}
+
+static void *core_thread(void *arg) {
+    SMPCore *core = (SMPCore *)arg;
+    Micro16SMP *smp = core->smp;
+
+    for (;;) {
+        barrier_wait(&smp->start_barrier);
+        if (smp->stop) break;
+        run_quantum(core, smp->round_target);
+        barrier_wait(&smp->end_barrier);
+    }
+    return NULL;
+}
+
+static bool start_threads(Micro16SMP *smp) {
+    barrier_init(&smp->start_barrier, smp->num_cores + 1);
+    barrier_init(&smp->end_barrier, smp->num_cores + 1);
+    smp->stop = false;
+
+    for (int i = 0; i < smp->num_cores; i++) {
+        if (pthread_create(&smp->cores[i].thread, NULL, core_thread, &smp->cores[i]) != 0) {
+            fprintf(stderr, "Error: Failed to start thread for core %d\n", i);
+            /* Shrink the barrier to release the threads already waiting */
+            pthread_mutex_lock(&smp->start_barrier.lock);
+            smp->start_barrier.count = i + 1;
+            pthread_mutex_unlock(&smp->start_barrier.lock);
+            smp->stop = true;
+            barrier_wait(&smp->start_barrier);
+            for (int j = 0; j < i; j++) {
+                pthread_join(smp->cores[j].thread, NULL);
+            }
+            barrier_destroy(&smp->start_barrier);
+            barrier_destroy(&smp->end_barrier);
+            return false;
+        }
+    }
+
+    smp->threads_started = true;
+    return true;
+}
+
+static void stop_threads(Micro16SMP *smp) {
+    if (!smp->threads_started) return;
+
+    smp->stop = true;
+    barrier_wait(&smp->start_barrier);
+    for (int i = 0; i < smp->num_cores; i++) {
+        pthread_join(smp->cores[i].thread, NULL);
+    }
+    barrier_destroy(&smp->start_barrier);
+    barrier_destroy(&smp->end_barrier);
+    smp->threads_started = false;
+}
+
+/* ========================================================================
+ * Lifecycle
+ * ======================================================================== */
+
+bool smp_init(Micro16SMP *smp, int num_cores, int quantum, SMPMode mode) {
+    memset(smp, 0, sizeof(Micro16SMP));
+
+    if (num_cores < 1 || num_cores > SMP_MAX_CORES) {
+        fprintf(stderr, "Error: Core count must be 1-%d\n", SMP_MAX_CORES);
+        return false;
+    }
+
+    smp->memory = (uint8_t *)calloc(MEM_SIZE, sizeof(uint8_t));
+    if (smp->memory == NULL) {
+        fprintf(stderr, "Error: Failed to allocate shared memory\n");
+        return false;
+    }
+
+    pthread_mutex_init(&smp->wake_lock, NULL);
+    pthread_cond_init(&smp->wake_cond, NULL);
+
+    smp->num_cores = num_cores;
+    smp->quantum = quantum > 0 ? quantum : SMP_DEFAULT_QUANTUM;
+    smp->mode = mode;
+    smp->entry_cs = DEFAULT_CS;
+    smp->entry_pc = DEFAULT_PC;
+
+    for (int i = 0; i < num_cores; i++) {
+        SMPCore *core = &smp->cores[i];
+        m16_cpu_init_shared(&core->cpu, smp->memory);
+        core->cpu.core_id = (uint16_t)i;
+        core->cpu.core_count = (uint16_t)num_cores;
+        core->smp = smp;
+    }
+
+    smp_reset(smp);
+    return true;
+}
+
+void smp_free(Micro16SMP *smp) {
+    stop_threads(smp);
+
+    for (int i = 0; i < smp->num_cores; i++) {
+        m16_cpu_free(&smp->cores[i].cpu);
+    }
+    free(smp->memory);
+    smp->memory = NULL;
+
+    pthread_mutex_destroy(&smp->wake_lock);
+    pthread_cond_destroy(&smp->wake_cond);
+}
+
+void smp_reset(Micro16SMP *smp) {
+    for (int i = 0; i < smp->num_cores; i++) {
+        SMPCore *core = &smp->cores[i];
+        m16_cpu_reset(&core->cpu);
+        core->cpu.seg[SEG_CS] = smp->entry_cs;
+        core->cpu.pc = smp->entry_pc;
+        core->cpu.seg[SEG_SS] = (uint16_t)(DEFAULT_SS + i * SMP_STACK_STRIDE);
+        core->time = 0;
+        memset(core->irq_mailbox, 0, sizeof(core->irq_mailbox));
+    }
+    smp->rounds = 0;
+}
+
+void smp_load_program(Micro16SMP *smp, const uint8_t *program, uint32_t size, uint32_t phys_addr) {
+    for (uint32_t i = 0; i < size && (phys_addr + i) < MEM_SIZE; i++) {
+        smp->memory[phys_addr + i] = program[i];
+    }
+}
+
+void smp_set_entry(Micro16SMP *smp, uint16_t cs, uint16_t pc) {
+    smp->entry_cs = cs;
+    smp->entry_pc = pc;
+    for (int i = 0; i < smp->num_cores; i++) {
+        smp->cores[i].cpu.seg[SEG_CS] = cs;
+        smp->cores[i].cpu.pc = pc;
+    }
+}
+
+/* ========================================================================
+ * Execution
+ * ======================================================================== */
+
+bool smp_all_stopped(const Micro16SMP *smp) {
+    for (int i = 0; i < smp->num_cores; i++) {
+        const Micro16CPU *cpu = &smp->cores[i].cpu;
+        if (!cpu->halted && !cpu->error) return false;
+    }
+    return true;
+}
+
+/* True when no core can make progress until an interrupt is posted */
+static bool all_idle(Micro16SMP *smp) {
+    for (int i = 0; i < smp->num_cores; i++) {
+        SMPCore *core = &smp->cores[i];
+        for (int j = 0; j < 4; j++) {
+            if (__atomic_load_n(&core->irq_mailbox[j], __ATOMIC_ACQUIRE) != 0) return false;
+        }
+        if (!core->cpu.halted && !core->cpu.error && !m16_cpu_is_idle(&core->cpu)) return false;
+    }
+    return true;
+}
+
+/* Block until an interrupt is posted; false if none can arrive */
+static bool wait_for_interrupt(Micro16SMP *smp) {
+    bool woken = false;
+
+    pthread_mutex_lock(&smp->wake_lock);
+    while (smp->external_irqs) {
+        if (!all_idle(smp)) {
+            woken = true;
+            break;
+        }
+        pthread_cond_wait(&smp->wake_cond, &smp->wake_lock);
+    }
+    pthread_mutex_unlock(&smp->wake_lock);
+    return woken;
+}
+
+uint64_t smp_run(Micro16SMP *smp, uint64_t max_cycles) {
+    uint64_t start = smp->rounds * (uint64_t)smp->quantum;
+    uint64_t elapsed = 0;
+
+    if (smp->mode == SMP_MODE_PARALLEL && !smp->threads_started) {
+        if (!start_threads(smp)) {
+            /* Fall back to running the cores on this thread */
+            smp->mode = SMP_MODE_DETERMINISTIC;
+        }
+    }
+
+    while (!smp_all_stopped(smp) && (max_cycles == 0 || elapsed < max_cycles)) {
+        /* Idle guests cost no host time: sleep until the host posts an IRQ */
+        if (all_idle(smp) && !wait_for_interrupt(smp)) {
+            break;
+        }
+
+        uint64_t target = (smp->rounds + 1) * (uint64_t)smp->quantum;
+
+        if (smp->mode == SMP_MODE_PARALLEL) {
+            smp->round_target = target;
+            barrier_wait(&smp->start_barrier);
+            barrier_wait(&smp->end_barrier);
+        } else {
+            for (int i = 0; i < smp->num_cores; i++) {
+                run_quantum(&smp->cores[i], target);
+            }
+        }
+
+        smp->rounds++;
+        elapsed = target - start;
+    }
+
+    return elapsed;
+}
+
+void smp_raise_interrupt(Micro16SMP *smp, int core, uint8_t vector) {
+    if (core < 0 || core >= smp->num_cores) return;
+    __atomic_fetch_or(&smp->cores[core].irq_mailbox[vector >> 6], 1ull << (vector & 63),
+                      __ATOMIC_RELEASE);
+
+    pthread_mutex_lock(&smp->wake_lock);
+    pthread_cond_broadcast(&smp->wake_cond);
+    pthread_mutex_unlock(&smp->wake_lock);
+}
+
+void smp_set_external_interrupts(Micro16SMP *smp, bool enabled) {
+    pthread_mutex_lock(&smp->wake_lock);
+    smp->external_irqs = enabled;
+    pthread_cond_broadcast(&smp->wake_cond);
+    pthread_mutex_unlock(&smp->wake_lock);
+}
+
+/* ========================================================================
+ * Debug Support
+ * ======================================================================== */
+
+void smp_dump_state(const Micro16SMP *smp) {
+    printf("=== Micro16 SMP State (%d cores, quantum %d, %s) ===\n",
+           smp->num_cores, smp->quantum,
+           smp->mode == SMP_MODE_PARALLEL ? "parallel" : "deterministic");
+
+    for (int i = 0; i < smp->num_cores; i++) {
+        const SMPCore *core = &smp->cores[i];
+        const Micro16CPU *cpu = &core->cpu;
+
+        printf("Core %d: CS:PC=%04X:%04X  AX=%04X BX=%04X CX=%04X DX=%04X  "
+               "Cycles: %lu  Instructions: %lu  %s\n",
+               i, cpu->seg[SEG_CS], cpu->pc,
+               cpu->r[REG_R0], cpu->r[REG_R1], cpu->r[REG_R2], cpu->r[REG_R3],
+               (unsigned long)core->time, (unsigned long)cpu->instructions,
+               cpu->error ? "ERROR" : cpu->halted ? "HALTED" :
+               cpu->waiting ? "WAITING" : "RUNNING");
+        if (cpu->error) {
+            printf("        Error: %s\n", cpu->error_msg);
+        }
+    }
+    printf("Rounds: %lu\n", (unsigned long)smp->rounds);
+}
@@ -0,0 +1,105 @@
+/*
+ * Micro16 Symmetric Multiprocessing
+ *
+ * Runs N Micro16 cores over one shared 1MB physical memory:
+ * - Quantum-based lockstep: every core runs `quantum` cycles per round,
+ *   then all cores meet at a barrier before the next round starts
+ * - Parallel mode gives each core its own host thread
+ * - Deterministic mode runs the cores one after another in core order
+ *   on the calling thread, so results repeat exactly run to run
+ * - LOCK-prefixed instructions are host atomics (see cpu.h)
+ * - Each core has its own interrupt line; interrupts raised from any
+ *   thread are delivered at the start of the target core's next quantum
+ * - Guests read their identity from PORT_CORE_ID / PORT_CORE_COUNT
+ * - Idle cores (WAIT with nothing scheduled) sit rounds out; when every
+ *   core is idle, smp_run sleeps until the host raises an interrupt, or
+ *   returns if external interrupts are not enabled
+ */
+
+#ifndef MICRO16_SMP_H
+#define MICRO16_SMP_H
+
+#include "cpu.h"
+#include <pthread.h>
+
+/* Limits and defaults */
+#define SMP_MAX_CORES       8
+#define SMP_DEFAULT_QUANTUM 1000    /* Cycles per core per round */
+
+/* Each core gets its own 64KB stack segment above the default one */
+#define SMP_STACK_STRIDE    0x1000  /* Segment units (64KB) between stacks */
+
+/* Execution modes */
+typedef enum {
+    SMP_MODE_PARALLEL = 0,  /* One host thread per core */
+    SMP_MODE_DETERMINISTIC  /* Cores run in order on the calling thread */
+} SMPMode;
+
+/* Simple reusable barrier (pthread_barrier_t is optional in POSIX) */
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+    int count;              /* Threads that must arrive */
+    int waiting;            /* Threads arrived this generation */
+    unsigned generation;
+} SMPBarrier;
+
+/* Per-core bookkeeping */
+typedef struct {
+    Micro16CPU cpu;
+    uint64_t time;          /* Cycles consumed, including WAIT cycles */
+    uint64_t irq_mailbox[4]; /* Queued vectors, bit n = vector n */
+    pthread_t thread;
+    struct Micro16SMP *smp;
+} SMPCore;
+
+/* SMP system state */
+typedef struct Micro16SMP {
+    int num_cores;
+    SMPCore cores[SMP_MAX_CORES];
+    uint8_t *memory;        /* Shared physical memory (MEM_SIZE bytes) */
+
+    int quantum;            /* Cycles per core per round */
+    SMPMode mode;
+    uint16_t entry_cs;      /* Where every core starts after reset */
+    uint16_t entry_pc;
+    uint64_t rounds;        /* Rounds completed */
+
+    /* Thread coordination (parallel mode) */
+    SMPBarrier start_barrier;
+    SMPBarrier end_barrier;
+    uint64_t round_target;  /* Core time at which the current round ends */
+    bool stop;              /* Tells worker threads to exit */
+    bool threads_started;
+
+    /* Idle wakeup: smp_run sleeps here while every core is idle */
+    pthread_mutex_t wake_lock;
+    pthread_cond_t  wake_cond;
+    bool external_irqs;     /* Host may raise interrupts from another thread */
+} Micro16SMP;
+
+/* Lifecycle */
+bool smp_init(Micro16SMP *smp, int num_cores, int quantum, SMPMode mode);
+void smp_free(Micro16SMP *smp);
+void smp_reset(Micro16SMP *smp);
+
+/* Program loading (shared memory) and entry point for every core */
+void smp_load_program(Micro16SMP *smp, const uint8_t *program, uint32_t size, uint32_t phys_addr);
+void smp_set_entry(Micro16SMP *smp, uint16_t cs, uint16_t pc);
+
+/* Execution: run until every core halts/errors or max_cycles per core */
+uint64_t smp_run(Micro16SMP *smp, uint64_t max_cycles);
+
+/* Queue a vector on a core; vectors accumulate until the core takes
+ * them (safe to call from any thread) */
+void smp_raise_interrupt(Micro16SMP *smp, int core, uint8_t vector);
+
+/* Let smp_run block for smp_raise_interrupt when all cores are idle.
+ * Disabling it from another thread releases a blocked smp_run. */
+void smp_set_external_interrupts(Micro16SMP *smp, bool enabled);
+
+/* Status */
+bool smp_all_stopped(const Micro16SMP *smp);
+void smp_dump_state(const Micro16SMP *smp);
+
+#endif /* MICRO16_SMP_H */
@@ -0,0 +1,93 @@
+/*
+ * Micro4 Core Interface (see ../common/core.h)
+ */
+
+#include "cpu.h"
+#include "../common/core.h"
+#include <limits.h>
+#include <stddef.h>
+#include <string.h>
+
+static bool m4_core_init(void *cpu) {
+    m4_cpu_init(cpu);
+    return true;
+}
+
+static void m4_core_reset(void *cpu) {
+    m4_cpu_reset(cpu);
+}
+
+/* The image holds one nibble per byte, loaded at address 0 */
+static bool m4_core_load(void *cpu, const uint8_t *image, uint32_t size) {
+    if (size > MEM_SIZE) return false;
+    m4_cpu_load_program(cpu, image, (uint16_t)size, 0);
+    return true;
+}
+
+static CoreStop m4_core_run_until(void *p, uint64_t cycle_limit) {
+    Micro4CPU *cpu = p;
+
+    while (!cpu->halted && !cpu->error && cpu->cycles < cycle_limit) {
+        uint64_t left = cycle_limit - cpu->cycles;
+        m4_cpu_run(cpu, left > INT_MAX ? INT_MAX : (int)left);
+    }
+
+    if (cpu->error) return CORE_ERROR;
+    if (cpu->halted) return CORE_HALTED;
+    return CORE_LIMIT;
+}
+
+static CoreMemory m4_core_memory(void *p) {
+    Micro4CPU *cpu = p;
+    CoreMemory m = { cpu->memory, MEM_SIZE, 4 };
+    return m;
+}
+
+static void m4_core_counters(const void *p, uint64_t *cycles, uint64_t *instructions) {
+    const Micro4CPU *cpu = p;
+    *cycles = cpu->cycles;
+    *instructions = cpu->instructions;
+}
+
+static const char *m4_core_error(const void *p) {
+    const Micro4CPU *cpu = p;
+    return cpu->error ? cpu->error_msg : NULL;
+}
+
+/* Memory lives inside the struct, so a snapshot is a plain copy */
+static void m4_core_snapshot_save(const void *cpu, void *buf) {
+    memcpy(buf, cpu, sizeof(Micro4CPU));
+}
+
+static void m4_core_snapshot_restore(void *cpu, const void *buf) {
+    memcpy(cpu, buf, sizeof(Micro4CPU));
+}
+
+static const CoreRegister registers[] = {
+    { "A",   4, 1, offsetof(Micro4CPU, a) },
+    { "PC",  8, 1, offsetof(Micro4CPU, pc) },
+    { "Z",   1, 1, offsetof(Micro4CPU, z) },
+    { "IR",  8, 1, offsetof(Micro4CPU, ir) },
+    { "MAR", 8, 1, offsetof(Micro4CPU, mar) },
+    { "MDR", 4, 1, offsetof(Micro4CPU, mdr) },
+};
+
+const CoreVTable m4_core = {
+    .name = "micro4",
+    .cpu_size = sizeof(Micro4CPU),
+    .init = m4_core_init,
+    .free = NULL,
+    .reset = m4_core_reset,
+    .load = m4_core_load,
+    .run_until = m4_core_run_until,
+    .memory = m4_core_memory,
+    .counters = m4_core_counters,
+    .error = m4_core_error,
+    .registers = registers,
+    .num_registers = sizeof(registers) / sizeof(registers[0]),
+    .snapshot_size = sizeof(Micro4CPU),
+    .snapshot_save = m4_core_snapshot_save,
+    .snapshot_restore = m4_core_snapshot_restore,
+    .interrupt = NULL,
+    .schedule = NULL,
+};
@@ -3,11 +3,12 @@
  */
 
 #include "cpu.h"
+#include "../common/hostprof.h"
 #include <stdio.h>
 #include <string.h>
 
 /* Instruction names */
-const char* OPCODE_NAMES[16] = {
+const char* M4_OPCODE_NAMES[16] = {
     "HLT", "LDA", "STA", "ADD", "SUB", "JMP", "JZ", "LDI",
     "AND", "OR",  "XOR", "NOT", "SHL", "SHR", "INC", "DEC"
 };
@@ -15,18 +16,35 @@ const char* OPCODE_NAMES[16] = {
 /* Mask to keep values to 4 bits */
 #define NIBBLE_MASK 0x0F
 
+/* Host self-profiling (make PROFILE=1) */
+enum { MEMPROF_READ, MEMPROF_WRITE, MEMPROF_FETCH, MEMPROF_SLOTS };
+
+#ifdef HOST_PROFILE
+static const char *opcode_slot_name(int slot) {
+    return M4_OPCODE_NAMES[slot];
+}
+
+static const char *mem_slot_name(int slot) {
+    static const char *names[MEMPROF_SLOTS] = { "read", "write", "fetch" };
+    return names[slot];
+}
+
+HOSTPROF_TABLE(opcode_prof, "Micro4 opcodes", 16, opcode_slot_name);
+HOSTPROF_TABLE(mem_prof, "Micro4 memory helpers", MEMPROF_SLOTS, mem_slot_name);
+#endif
+
 /*
  * Initialize CPU to default state
  */
-void cpu_init(Micro4CPU *cpu) {
+void m4_cpu_init(Micro4CPU *cpu) {
     memset(cpu, 0, sizeof(Micro4CPU));
-    cpu_reset(cpu);
+    m4_cpu_reset(cpu);
 }
 
 /*
  * Reset CPU (but keep memory contents)
  */
-void cpu_reset(Micro4CPU *cpu) {
+void m4_cpu_reset(Micro4CPU *cpu) {
     cpu->pc = 0;
     cpu->a = 0;
     cpu->z = false;
@@ -43,7 +61,7 @@ void cpu_reset(Micro4CPU *cpu) {
 /*
  * Load a program into memory
  */
-void cpu_load_program(Micro4CPU *cpu, const uint8_t *program, uint16_t size, uint8_t start_addr) {
+void m4_cpu_load_program(Micro4CPU *cpu, const uint8_t *program, uint16_t size, uint8_t start_addr) {
     for (uint16_t i = 0; i < size && (start_addr + i) < MEM_SIZE; i++) {
         cpu->memory[start_addr + i] = program[i] & NIBBLE_MASK;
     }
@@ -52,15 +70,20 @@ void cpu_load_program(Micro4CPU *cpu, const uint8_t *program, uint16_t size, uin
 /*
  * Read from memory
  */
-uint8_t cpu_read_mem(Micro4CPU *cpu, uint8_t addr) {
-    return cpu->memory[addr] & NIBBLE_MASK;
+uint8_t m4_cpu_read_mem(Micro4CPU *cpu, uint8_t addr) {
+    HOSTPROF_BEGIN(mem_prof);
+    uint8_t value = cpu->memory[addr] & NIBBLE_MASK;
+    HOSTPROF_END(mem_prof, MEMPROF_READ);
+    return value;
 }
 
 /*
  * Write to memory
  */
-void cpu_write_mem(Micro4CPU *cpu, uint8_t addr, uint8_t value) {
+void m4_cpu_write_mem(Micro4CPU *cpu, uint8_t addr, uint8_t value) {
+    HOSTPROF_BEGIN(mem_prof);
     cpu->memory[addr] = value & NIBBLE_MASK;
+    HOSTPROF_END(mem_prof, MEMPROF_WRITE);
 }
 
 /*
@@ -68,10 +91,12 @@ void cpu_write_mem(Micro4CPU *cpu, uint8_t addr, uint8_t value) {
  * Returns the full 8-bit value (two nibbles packed)
  */
 static uint8_t fetch_byte(Micro4CPU *cpu) {
+    HOSTPROF_BEGIN(mem_prof);
     uint8_t high = cpu->memory[cpu->pc] & NIBBLE_MASK;
     cpu->pc++;
     uint8_t low = cpu->memory[cpu->pc] & NIBBLE_MASK;
     cpu->pc++;
+    HOSTPROF_END(mem_prof, MEMPROF_FETCH);
     return (high << 4) | low;
 }
 
@@ -79,7 +104,7 @@ static uint8_t fetch_byte(Micro4CPU *cpu) {
  * Execute one instruction
  * Returns number of cycles used
  */
-int cpu_step(Micro4CPU *cpu) {
+int m4_cpu_step(Micro4CPU *cpu) {
     if (cpu->halted) {
         return 0;
     }
@@ -104,6 +129,7 @@ int cpu_step(Micro4CPU *cpu) {
     uint8_t addr;
     uint8_t value;
 
+    HOSTPROF_BEGIN(opcode_prof);
     switch (opcode) {
         case OP_HLT:  /* Halt */
             cpu->halted = true;
@@ -116,7 +142,7 @@ int cpu_step(Micro4CPU *cpu) {
             cycles += 2;
             /* Read from memory */
             cpu->mar = addr;
-            cpu->mdr = cpu_read_mem(cpu, addr);
+            cpu->mdr = m4_cpu_read_mem(cpu, addr);
             cpu->a = cpu->mdr;
             cpu->z = (cpu->a == 0);
             cycles += 1;
@@ -129,7 +155,7 @@ int cpu_step(Micro4CPU *cpu) {
             /* Write to memory */
             cpu->mar = addr;
             cpu->mdr = cpu->a;
-            cpu_write_mem(cpu, addr, cpu->a);
+            m4_cpu_write_mem(cpu, addr, cpu->a);
             cycles += 1;
             break;
 
@@ -139,7 +165,7 @@ int cpu_step(Micro4CPU *cpu) {
             cycles += 2;
             /* Read and add */
             cpu->mar = addr;
-            cpu->mdr = cpu_read_mem(cpu, addr);
+            cpu->mdr = m4_cpu_read_mem(cpu, addr);
             cpu->a = (cpu->a + cpu->mdr) & NIBBLE_MASK;
             cpu->z = (cpu->a == 0);
             cycles += 1;
@@ -151,7 +177,7 @@ int cpu_step(Micro4CPU *cpu) {
             cycles += 2;
             /* Read and subtract */
             cpu->mar = addr;
-            cpu->mdr = cpu_read_mem(cpu, addr);
+            cpu->mdr = m4_cpu_read_mem(cpu, addr);
             cpu->a = (cpu->a - cpu->mdr) & NIBBLE_MASK;
             cpu->z = (cpu->a == 0);
             cycles += 1;
@@ -188,7 +214,7 @@ int cpu_step(Micro4CPU *cpu) {
             cycles += 2;
             /* Read and AND */
             cpu->mar = addr;
-            cpu->mdr = cpu_read_mem(cpu, addr);
+            cpu->mdr = m4_cpu_read_mem(cpu, addr);
             cpu->a = (cpu->a & cpu->mdr) & NIBBLE_MASK;
             cpu->z = (cpu->a == 0);
             cycles += 1;
@@ -200,7 +226,7 @@ int cpu_step(Micro4CPU *cpu) {
             cycles += 2;
             /* Read and OR */
             cpu->mar = addr;
-            cpu->mdr = cpu_read_mem(cpu, addr);
+            cpu->mdr = m4_cpu_read_mem(cpu, addr);
             cpu->a = (cpu->a | cpu->mdr) & NIBBLE_MASK;
             cpu->z = (cpu->a == 0);
             cycles += 1;
@@ -212,7 +238,7 @@ int cpu_step(Micro4CPU *cpu) {
             cycles += 2;
             /* Read and XOR */
             cpu->mar = addr;
-            cpu->mdr = cpu_read_mem(cpu, addr);
+            cpu->mdr = m4_cpu_read_mem(cpu, addr);
             cpu->a = (cpu->a ^ cpu->mdr) & NIBBLE_MASK;
             cpu->z = (cpu->a == 0);
             cycles += 1;
@@ -257,6 +283,8 @@ int cpu_step(Micro4CPU *cpu) {
             return cycles;
     }
 
+    HOSTPROF_END(opcode_prof, opcode);
+
     cpu->instructions++;
     cpu->cycles += cycles;
 
@@ -267,11 +295,11 @@ int cpu_step(Micro4CPU *cpu) {
  * Run CPU until halted or max_cycles reached
  * Returns total cycles executed
  */
-int cpu_run(Micro4CPU *cpu, int max_cycles) {
+int m4_cpu_run(Micro4CPU *cpu, int max_cycles) {
     int total_cycles = 0;
 
     while (!cpu->halted && (max_cycles <= 0 || total_cycles < max_cycles)) {
-        int cycles = cpu_step(cpu);
+        int cycles = m4_cpu_step(cpu);
         if (cycles == 0) break;
         total_cycles += cycles;
     }
@@ -282,7 +310,7 @@ int cpu_run(Micro4CPU *cpu, int max_cycles) {
 /*
  * Dump CPU state for debugging
  */
-void cpu_dump_state(const Micro4CPU *cpu) {
+void m4_cpu_dump_state(const Micro4CPU *cpu) {
     printf("=== Micro4 CPU State ===\n");
     printf("PC: 0x%02X  A: 0x%X  Z: %d\n",
            cpu->pc, cpu->a, cpu->z);
@@ -303,7 +331,7 @@ void cpu_dump_state(const Micro4CPU *cpu) {
 /*
  * Dump memory range
  */
-void cpu_dump_memory(const Micro4CPU *cpu, uint8_t start, uint8_t end) {
+void m4_cpu_dump_memory(const Micro4CPU *cpu, uint8_t start, uint8_t end) {
     printf("Memory [0x%02X - 0x%02X]:\n", start, end);
 
     for (uint16_t addr = start; addr <= end; addr += 16) {
@@ -320,7 +348,7 @@ void cpu_dump_memory(const Micro4CPU *cpu, uint8_t start, uint8_t end) {
  */
 static char disasm_buf[64];
 
-const char* cpu_disassemble(uint8_t opcode, uint8_t operand) {
+const char* m4_cpu_disassemble(uint8_t opcode, uint8_t operand) {
     uint8_t op = (opcode >> 4) & NIBBLE_MASK;
     uint8_t imm = opcode & NIBBLE_MASK;
 
@@ -61,24 +61,24 @@ typedef struct {
 } Micro4CPU;
 
 /* CPU Lifecycle */
-void cpu_init(Micro4CPU *cpu);
-void cpu_reset(Micro4CPU *cpu);
+void m4_cpu_init(Micro4CPU *cpu);
+void m4_cpu_reset(Micro4CPU *cpu);
 
 /* Memory Operations */
-void cpu_load_program(Micro4CPU *cpu, const uint8_t *program, uint16_t size, uint8_t start_addr);
-uint8_t cpu_read_mem(Micro4CPU *cpu, uint8_t addr);
-void cpu_write_mem(Micro4CPU *cpu, uint8_t addr, uint8_t value);
+void m4_cpu_load_program(Micro4CPU *cpu, const uint8_t *program, uint16_t size, uint8_t start_addr);
+uint8_t m4_cpu_read_mem(Micro4CPU *cpu, uint8_t addr);
+void m4_cpu_write_mem(Micro4CPU *cpu, uint8_t addr, uint8_t value);
 
 /* Execution */
-int cpu_step(Micro4CPU *cpu);           /* Execute one instruction, returns cycles used */
-int cpu_run(Micro4CPU *cpu, int max_cycles);  /* Run until halt or max_cycles */
+int m4_cpu_step(Micro4CPU *cpu);           /* Execute one instruction, returns cycles used */
+int m4_cpu_run(Micro4CPU *cpu, int max_cycles);  /* Run until halt or max_cycles */
 
 /* Debugging */
-void cpu_dump_state(const Micro4CPU *cpu);
-void cpu_dump_memory(const Micro4CPU *cpu, uint8_t start, uint8_t end);
-const char* cpu_disassemble(uint8_t opcode, uint8_t operand);
+void m4_cpu_dump_state(const Micro4CPU *cpu);
+void m4_cpu_dump_memory(const Micro4CPU *cpu, uint8_t start, uint8_t end);
+const char* m4_cpu_disassemble(uint8_t opcode, uint8_t operand);
 
 /* Instruction names for debugging */
-extern const char* OPCODE_NAMES[16];
+extern const char* M4_OPCODE_NAMES[16];
 
 #endif /* MICRO4_CPU_H */
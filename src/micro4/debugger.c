@@ -92,7 +92,7 @@ int dbg_step(Debugger *dbg) {
         return 0;
     }
 
-    int cycles = cpu_step(dbg->cpu);
+    int cycles = m4_cpu_step(dbg->cpu);
     return cycles;
 }
 
@@ -107,7 +107,7 @@ int dbg_run_until_break(Debugger *dbg, int max_cycles) {
             return total_cycles;
         }
 
-        int cycles = cpu_step(dbg->cpu);
+        int cycles = m4_cpu_step(dbg->cpu);
         if (cycles == 0) break;
         total_cycles += cycles;
     }
@@ -121,12 +121,12 @@ int dbg_run_until_break(Debugger *dbg, int max_cycles) {
 
 /* Show register state */
 void dbg_show_regs(Debugger *dbg) {
-    cpu_dump_state(dbg->cpu);
+    m4_cpu_dump_state(dbg->cpu);
 }
 
 /* Show memory range */
 void dbg_show_memory(Debugger *dbg, uint8_t start, uint8_t end) {
-    cpu_dump_memory(dbg->cpu, start, end);
+    m4_cpu_dump_memory(dbg->cpu, start, end);
 }
 
 /* Show current instruction */
@@ -148,7 +148,7 @@ void dbg_show_current_instruction(Debugger *dbg) {
 
     char bp_marker = dbg_has_breakpoint(dbg, cpu->pc) ? '*' : ' ';
     printf("%c[PC=0x%02X A=%X Z=%d] %s\n",
-           bp_marker, cpu->pc, cpu->a, cpu->z, cpu_disassemble(opcode, operand));
+           bp_marker, cpu->pc, cpu->a, cpu->z, m4_cpu_disassemble(opcode, operand));
 }
 
 /* Show help message */
@@ -182,7 +182,7 @@ bool dbg_load_file(Debugger *dbg, const char *filename) {
     printf("Assembly successful: %d nibbles generated\n", asm_get_output_size(&as));
 
     /* Reset CPU and load program */
-    cpu_init(dbg->cpu);
+    m4_cpu_init(dbg->cpu);
     memcpy(dbg->cpu->memory, asm_get_output(&as), asm_get_output_size(&as));
 
     return true;
@@ -322,7 +322,7 @@ static void process_command(Debugger *dbg, char *line) {
         }
     }
     else if (strcmp(cmd, "reset") == 0) {
-        cpu_reset(dbg->cpu);
+        m4_cpu_reset(dbg->cpu);
         printf("CPU reset\n");
         dbg_show_current_instruction(dbg);
     }
@@ -376,7 +376,7 @@ int main(int argc, char *argv[]) {
     Micro4CPU cpu;
     Debugger dbg;
 
-    cpu_init(&cpu);
+    m4_cpu_init(&cpu);
     dbg_init(&dbg, &cpu);
 
     if (argc >= 2) {
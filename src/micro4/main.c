@@ -5,6 +5,8 @@
  *   micro4 run <file.asm>     - Assemble and run
  *   micro4 asm <file.asm>     - Assemble and show output
  *   micro4 debug <file.asm>   - Assemble and debug interactively
+ *   micro4 bench <file.asm>   - Assemble and time repeated runs
+ *   micro4 host <file.asm>    - Many sessions over a thread pool
  *   micro4 help               - Show help
  */
 
@@ -13,6 +15,11 @@
 #include <string.h>
 #include "cpu.h"
 #include "assembler.h"
+#include "../common/bench.h"
+#include "../common/sched.h"
+
+/* Bench: cycles a run may take before it is reported as a timeout */
+#define BENCH_MAX_CYCLES 10000
 
 /* Print usage */
 static void print_usage(const char *prog) {
@@ -22,6 +29,12 @@ static void print_usage(const char *prog) {
     printf("  %s run <file.asm>     Assemble and run program\n", prog);
     printf("  %s asm <file.asm>     Assemble and show machine code\n", prog);
     printf("  %s debug <file.asm>   Assemble and run in debug mode\n", prog);
+    printf("  %s bench <file.asm> [-r n] [-c n] [--csv file]\n", prog);
+    printf("                        Time n runs (default %d) of at most c cycles\n",
+           BENCH_DEFAULT_REPEAT);
+    printf("                        (default %d), append a CSV row\n", BENCH_MAX_CYCLES);
+    printf("  %s host <file.asm> [-s n] [-t n] [-q n]\n", prog);
+    printf("                        Run n sessions over a thread pool, q cycles per slice\n");
     printf("  %s help               Show this help\n", prog);
     printf("\n");
     printf("Debug mode commands:\n");
@@ -62,7 +75,7 @@ static bool assemble_and_load(const char *filename, Assembler *as, Micro4CPU *cp
     printf("Assembly successful: %d nibbles generated\n", asm_get_output_size(as));
 
     /* Load into CPU */
-    cpu_init(cpu);
+    m4_cpu_init(cpu);
     memcpy(cpu->memory, asm_get_output(as), asm_get_output_size(as));
 
     return true;
@@ -80,14 +93,14 @@ static int cmd_run(const char *filename) {
     printf("\nRunning...\n");
     printf("----------------------------------------\n");
 
-    int cycles = cpu_run(&cpu, 10000);  /* Max 10000 cycles to prevent infinite loops */
+    int cycles = m4_cpu_run(&cpu, 10000);  /* Max 10000 cycles to prevent infinite loops */
 
     printf("----------------------------------------\n");
     printf("Execution complete.\n\n");
-    cpu_dump_state(&cpu);
+    m4_cpu_dump_state(&cpu);
 
     printf("\nMemory at 0x20-0x2F (typical data area):\n");
-    cpu_dump_memory(&cpu, 0x20, 0x2F);
+    m4_cpu_dump_memory(&cpu, 0x20, 0x2F);
 
     return cpu.error ? 1 : 0;
 }
@@ -123,14 +136,14 @@ static int cmd_asm(const char *filename) {
         if (op == OP_HLT || op == OP_LDI) {
             /* 1-byte instruction */
             printf("0x%02X: %02X       %s\n", addr, opcode,
-                   cpu_disassemble(opcode, 0));
+                   m4_cpu_disassemble(opcode, 0));
             addr += 2;
         } else if (op >= OP_LDA && op <= OP_JZ) {
             /* 2-byte instruction */
             if (addr + 3 < size) {
                 uint8_t operand = (out[addr + 2] << 4) | out[addr + 3];
                 printf("0x%02X: %02X %02X    %s\n", addr, opcode, operand,
-                       cpu_disassemble(opcode, operand));
+                       m4_cpu_disassemble(opcode, operand));
                 addr += 4;
             } else {
                 printf("0x%02X: %02X       (incomplete)\n", addr, opcode);
@@ -172,7 +185,7 @@ static int cmd_debug(const char *filename) {
         }
 
         printf("\n[PC=0x%02X A=%X Z=%d] %s\n",
-               cpu.pc, cpu.a, cpu.z, cpu_disassemble(opcode, operand));
+               cpu.pc, cpu.a, cpu.z, m4_cpu_disassemble(opcode, operand));
         printf("debug> ");
 
         if (!fgets(line, sizeof(line), stdin)) {
@@ -184,17 +197,17 @@ static int cmd_debug(const char *filename) {
 
         /* Parse command */
         if (strcmp(line, "s") == 0 || strcmp(line, "step") == 0) {
-            int cycles = cpu_step(&cpu);
+            int cycles = m4_cpu_step(&cpu);
             printf("Executed in %d cycles\n", cycles);
         } else if (strcmp(line, "r") == 0 || strcmp(line, "run") == 0 ||
                    strcmp(line, "c") == 0 || strcmp(line, "continue") == 0) {
             printf("Running...\n");
-            cpu_run(&cpu, 10000);
+            m4_cpu_run(&cpu, 10000);
             printf("Stopped.\n");
         } else if (strcmp(line, "d") == 0 || strcmp(line, "dump") == 0) {
-            cpu_dump_state(&cpu);
+            m4_cpu_dump_state(&cpu);
         } else if (strcmp(line, "m") == 0 || strcmp(line, "memory") == 0) {
-            cpu_dump_memory(&cpu, 0x00, 0x3F);
+            m4_cpu_dump_memory(&cpu, 0x00, 0x3F);
         } else if (strcmp(line, "q") == 0 || strcmp(line, "quit") == 0) {
             running = false;
         } else if (strcmp(line, "help") == 0 || strcmp(line, "h") == 0) {
@@ -211,12 +224,111 @@ static int cmd_debug(const char *filename) {
 
     if (cpu.halted) {
         printf("\nCPU halted.\n");
-        cpu_dump_state(&cpu);
+        m4_cpu_dump_state(&cpu);
     }
 
     return 0;
 }
 
+/* Benchmark mode: rerun from the assembled image, timing the whole loop */
+static int cmd_bench(const char *filename, int repeat, int max_cycles, const char *csv_path) {
+    Assembler as;
+    Micro4CPU cpu;
+
+    if (!assemble_and_load(filename, &as, &cpu)) {
+        return 1;
+    }
+
+    BenchResult r = { "micro4", filename, 0, 0, 0, 0.0, "ok" };
+    const uint8_t *image = asm_get_output(&as);
+    int size = asm_get_output_size(&as);
+
+    /* Untimed first run: a program that errors or hits the cap is not timed */
+    m4_cpu_init(&cpu);
+    memcpy(cpu.memory, image, size);
+    m4_cpu_run(&cpu, max_cycles);
+    if (cpu.error || !cpu.halted) {
+        r.status = cpu.error ? "error" : "timeout";
+        repeat = 0;
+    }
+
+    double start = bench_now();
+    for (int i = 0; i < repeat; i++) {
+        m4_cpu_init(&cpu);
+        memcpy(cpu.memory, image, size);
+        m4_cpu_run(&cpu, max_cycles);
+    }
+    if (repeat > 0) {
+        r.seconds = bench_now() - start;
+        r.iterations = repeat;
+        r.instructions = cpu.instructions * (uint64_t)repeat;
+        r.cycles = cpu.cycles * (uint64_t)repeat;
+    }
+
+    bench_print_summary(&r);
+    return bench_write_csv(&r, csv_path) && strcmp(r.status, "ok") == 0 ? 0 : 1;
+}
+
+/* Host mode: one scheduler slice of a session */
+static SessionState host_slice(void *core, int quantum, uint64_t *cycles) {
+    Micro4CPU *cpu = core;
+    uint64_t before = cpu->cycles;
+
+    m4_cpu_run(cpu, quantum);
+    *cycles = cpu->cycles - before;
+
+    return (cpu->halted || cpu->error) ? SESSION_DONE : SESSION_RUNNABLE;
+}
+
+/* Host mode - many independent sessions of one program over a thread pool */
+static int cmd_host(const char *filename, int num_sessions, int threads, int quantum) {
+    Assembler as;
+    Micro4CPU *cpus = calloc((size_t)num_sessions, sizeof(Micro4CPU));
+    SchedSession *sessions = calloc((size_t)num_sessions, sizeof(SchedSession));
+    Scheduler sched;
+    int result = 1;
+
+    if (cpus == NULL || sessions == NULL) {
+        printf("Error: Failed to allocate %d sessions\n", num_sessions);
+        goto out;
+    }
+    if (!assemble_and_load(filename, &as, &cpus[0])) goto out;
+
+    for (int i = 1; i < num_sessions; i++) {
+        cpus[i] = cpus[0];
+    }
+
+    if (!sched_init(&sched, threads, quantum)) {
+        printf("Error: Failed to start worker threads\n");
+        goto out;
+    }
+    printf("Running %d sessions on %d threads, %d cycles per slice...\n",
+           num_sessions, sched.num_threads, sched.quantum);
+
+    double t0 = bench_now();
+    for (int i = 0; i < num_sessions; i++) {
+        sched_add(&sched, &sessions[i], i, &cpus[i], host_slice);
+    }
+    sched_wait(&sched);
+    double wall = bench_now() - t0;
+    sched_shutdown(&sched);
+
+    sched_print_report(sessions, num_sessions, wall);
+
+    result = 0;
+    for (int i = 0; i < num_sessions; i++) {
+        if (cpus[i].error) {
+            printf("Session %d: ERROR\n", i);
+            result = 1;
+        }
+    }
+
+out:
+    free(sessions);
+    free(cpus);
+    return result;
+}
+
 int main(int argc, char *argv[]) {
     if (argc < 2) {
         print_usage(argv[0]);
@@ -244,6 +356,35 @@ int main(int argc, char *argv[]) {
         return cmd_asm(filename);
     } else if (strcmp(cmd, "debug") == 0) {
         return cmd_debug(filename);
+    } else if (strcmp(cmd, "bench") == 0) {
+        int repeat = BENCH_DEFAULT_REPEAT, max_cycles = BENCH_MAX_CYCLES;
+        const char *csv_path = NULL;
+        for (int i = 3; i + 1 < argc; i += 2) {
+            if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--repeat") == 0) {
+                repeat = atoi(argv[i + 1]);
+            } else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--cycles") == 0) {
+                max_cycles = atoi(argv[i + 1]);
+            } else if (strcmp(argv[i], "--csv") == 0) {
+                csv_path = argv[i + 1];
+            }
+        }
+        return cmd_bench(filename, repeat, max_cycles, csv_path);
+    } else if (strcmp(cmd, "host") == 0) {
+        int num_sessions = 64, threads = 0, quantum = SCHED_DEFAULT_QUANTUM;
+        for (int i = 3; i + 1 < argc; i += 2) {
+            if (strcmp(argv[i], "-s") == 0 || strcmp(argv[i], "--sessions") == 0) {
+                num_sessions = atoi(argv[i + 1]);
+            } else if (strcmp(argv[i], "-t") == 0 || strcmp(argv[i], "--threads") == 0) {
+                threads = atoi(argv[i + 1]);
+            } else if (strcmp(argv[i], "-q") == 0 || strcmp(argv[i], "--quantum") == 0) {
+                quantum = atoi(argv[i + 1]);
+            }
+        }
+        if (num_sessions < 1) {
+            printf("Error: Need at least 1 session\n");
+            return 1;
+        }
+        return cmd_host(filename, num_sessions, threads, quantum);
     } else {
         printf("Unknown command: %s\n\n", cmd);
         print_usage(argv[0]);
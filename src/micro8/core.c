@@ -0,0 +1,113 @@
+/*
+ * Micro8 Core Interface (see ../common/core.h)
+ */
+
+#include "cpu.h"
+#include "../common/core.h"
+#include <limits.h>
+#include <stddef.h>
+#include <string.h>
+
+static bool m8_core_init(void *cpu) {
+    return m8_cpu_init(cpu);
+}
+
+static void m8_core_free(void *cpu) {
+    m8_cpu_free(cpu);
+}
+
+static void m8_core_reset(void *cpu) {
+    m8_cpu_reset(cpu);
+}
+
+/* Images load at DEFAULT_PC, like `micro8 run` */
+static bool m8_core_load(void *cpu, const uint8_t *image, uint32_t size) {
+    if (DEFAULT_PC + size > MEM_SIZE) return false;
+    m8_cpu_load_program(cpu, image, (uint16_t)size, DEFAULT_PC);
+    return true;
+}
+
+static CoreStop m8_core_run_until(void *p, uint64_t cycle_limit) {
+    Micro8CPU *cpu = p;
+
+    while (!cpu->halted && !cpu->error && cpu->cycles < cycle_limit) {
+        uint64_t left = cycle_limit - cpu->cycles;
+        m8_cpu_run(cpu, left > INT_MAX ? INT_MAX : (int)left);
+    }
+
+    if (cpu->error) return CORE_ERROR;
+    if (cpu->halted) return CORE_HALTED;
+    return CORE_LIMIT;
+}
+
+static CoreMemory m8_core_memory(void *p) {
+    Micro8CPU *cpu = p;
+    CoreMemory m = { cpu->memory, MEM_SIZE, 8 };
+    return m;
+}
+
+static void m8_core_counters(const void *p, uint64_t *cycles, uint64_t *instructions) {
+    const Micro8CPU *cpu = p;
+    *cycles = cpu->cycles;
+    *instructions = cpu->instructions;
+}
+
+static const char *m8_core_error(const void *p) {
+    const Micro8CPU *cpu = p;
+    return cpu->error ? cpu->error_msg : NULL;
+}
+
+/* Snapshot layout: the CPU struct, then all of memory */
+static void m8_core_snapshot_save(const void *p, void *buf) {
+    const Micro8CPU *cpu = p;
+    memcpy(buf, cpu, sizeof(Micro8CPU));
+    memcpy((uint8_t *)buf + sizeof(Micro8CPU), cpu->memory, MEM_SIZE);
+}
+
+static void m8_core_snapshot_restore(void *p, const void *buf) {
+    Micro8CPU *cpu = p;
+    uint8_t *memory = cpu->memory;
+
+    memcpy(cpu, buf, sizeof(Micro8CPU));
+    cpu->memory = memory;
+    memcpy(cpu->memory, (const uint8_t *)buf + sizeof(Micro8CPU), MEM_SIZE);
+}
+
+/* Micro8 has one interrupt line; the vector is fixed at INT_VECTOR */
+static void m8_core_interrupt(void *cpu, uint8_t vector) {
+    (void)vector;
+    m8_cpu_request_interrupt(cpu);
+}
+
+#define REG8(name, field)   { name, 8, 1, offsetof(Micro8CPU, field) }
+
+static const CoreRegister registers[] = {
+    REG8("R0", r[0]), REG8("R1", r[1]), REG8("R2", r[2]), REG8("R3", r[3]),
+    REG8("R4", r[4]), REG8("R5", r[5]), REG8("R6", r[6]), REG8("R7", r[7]),
+    { "PC", 16, 2, offsetof(Micro8CPU, pc) },
+    { "SP", 16, 2, offsetof(Micro8CPU, sp) },
+    REG8("FLAGS", flags),
+    REG8("IR", ir),
+    { "MAR", 16, 2, offsetof(Micro8CPU, mar) },
+    REG8("MDR", mdr),
+};
+
+const CoreVTable m8_core = {
+    .name = "micro8",
+    .cpu_size = sizeof(Micro8CPU),
+    .init = m8_core_init,
+    .free = m8_core_free,
+    .reset = m8_core_reset,
+    .load = m8_core_load,
+    .run_until = m8_core_run_until,
+    .memory = m8_core_memory,
+    .counters = m8_core_counters,
+    .error = m8_core_error,
+    .registers = registers,
+    .num_registers = sizeof(registers) / sizeof(registers[0]),
+    .snapshot_size = sizeof(Micro8CPU) + MEM_SIZE,
+    .snapshot_save = m8_core_snapshot_save,
+    .snapshot_restore = m8_core_snapshot_restore,
+    .interrupt = m8_core_interrupt,
+    .schedule = NULL,
+};
@@ -11,10 +11,24 @@
  */
 
 #include "cpu.h"
+#include "../common/hostprof.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+/* Host self-profiling (make PROFILE=1) */
+enum { MEMPROF_READ, MEMPROF_WRITE, MEMPROF_SLOTS };
+
+#ifdef HOST_PROFILE
+static const char *mem_slot_name(int slot) {
+    static const char *names[MEMPROF_SLOTS] = { "read", "write" };
+    return names[slot];
+}
+
+HOSTPROF_TABLE(opcode_prof, "Micro8 opcodes", 256, NULL);
+HOSTPROF_TABLE(mem_prof, "Micro8 memory helpers", MEMPROF_SLOTS, mem_slot_name);
+#endif
+
 /* Register names */
 static const char* REG_NAMES[] = {
     "R0", "R1", "R2", "R3", "R4", "R5", "R6", "R7"
@@ -97,7 +111,7 @@ static void update_flags_logic(Micro8CPU *cpu, uint8_t result) {
  * CPU Lifecycle
  * ======================================================================== */
 
-bool cpu_init(Micro8CPU *cpu) {
+bool m8_cpu_init(Micro8CPU *cpu) {
     memset(cpu, 0, sizeof(Micro8CPU));
 
     cpu->memory = (uint8_t *)calloc(MEM_SIZE, sizeof(uint8_t));
@@ -107,18 +121,18 @@ bool cpu_init(Micro8CPU *cpu) {
         return false;
     }
 
-    cpu_reset(cpu);
+    m8_cpu_reset(cpu);
     return true;
 }
 
-void cpu_free(Micro8CPU *cpu) {
+void m8_cpu_free(Micro8CPU *cpu) {
     if (cpu->memory != NULL) {
         free(cpu->memory);
         cpu->memory = NULL;
     }
 }
 
-void cpu_reset(Micro8CPU *cpu) {
+void m8_cpu_reset(Micro8CPU *cpu) {
     for (int i = 0; i < 8; i++) {
         cpu->r[i] = 0;
     }
@@ -147,22 +161,26 @@ void cpu_reset(Micro8CPU *cpu) {
  * Memory Operations
  * ======================================================================== */
 
-void cpu_load_program(Micro8CPU *cpu, const uint8_t *program, uint16_t size, uint16_t start_addr) {
+void m8_cpu_load_program(Micro8CPU *cpu, const uint8_t *program, uint16_t size, uint16_t start_addr) {
     for (uint32_t i = 0; i < size && (start_addr + i) < MEM_SIZE; i++) {
         cpu->memory[start_addr + i] = program[i];
     }
 }
 
-uint8_t cpu_read_mem(Micro8CPU *cpu, uint16_t addr) {
+uint8_t m8_cpu_read_mem(Micro8CPU *cpu, uint16_t addr) {
+    HOSTPROF_BEGIN(mem_prof);
     cpu->mar = addr;
     cpu->mdr = cpu->memory[addr];
+    HOSTPROF_END(mem_prof, MEMPROF_READ);
     return cpu->mdr;
 }
 
-void cpu_write_mem(Micro8CPU *cpu, uint16_t addr, uint8_t value) {
+void m8_cpu_write_mem(Micro8CPU *cpu, uint16_t addr, uint8_t value) {
+    HOSTPROF_BEGIN(mem_prof);
     cpu->mar = addr;
     cpu->mdr = value;
     cpu->memory[addr] = value;
+    HOSTPROF_END(mem_prof, MEMPROF_WRITE);
 }
 
 /* ========================================================================
@@ -170,7 +188,7 @@ void cpu_write_mem(Micro8CPU *cpu, uint16_t addr, uint8_t value) {
  * ======================================================================== */
 
 static uint8_t fetch_byte(Micro8CPU *cpu) {
-    uint8_t value = cpu_read_mem(cpu, cpu->pc);
+    uint8_t value = m8_cpu_read_mem(cpu, cpu->pc);
     cpu->pc++;
     return value;
 }
@@ -186,13 +204,13 @@ static uint16_t fetch_word(Micro8CPU *cpu) {
  * ======================================================================== */
 
 static void push_byte(Micro8CPU *cpu, uint8_t value) {
-    cpu_write_mem(cpu, cpu->sp, value);
+    m8_cpu_write_mem(cpu, cpu->sp, value);
     cpu->sp--;
 }
 
 static uint8_t pop_byte(Micro8CPU *cpu) {
     cpu->sp++;
-    return cpu_read_mem(cpu, cpu->sp);
+    return m8_cpu_read_mem(cpu, cpu->sp);
 }
 
 static void push_word(Micro8CPU *cpu, uint16_t value) {
@@ -210,7 +228,7 @@ static uint16_t pop_word(Micro8CPU *cpu) {
  * Interrupt Support
  * ======================================================================== */
 
-void cpu_request_interrupt(Micro8CPU *cpu) {
+void m8_cpu_request_interrupt(Micro8CPU *cpu) {
     cpu->int_pending = true;
 }
 
@@ -228,7 +246,7 @@ static void handle_interrupt(Micro8CPU *cpu) {
  * Instruction Execution
  * ======================================================================== */
 
-int cpu_step(Micro8CPU *cpu) {
+int m8_cpu_step(Micro8CPU *cpu) {
     if (cpu->halted) {
         return 0;
     }
@@ -241,6 +259,7 @@ int cpu_step(Micro8CPU *cpu) {
     /* Fetch opcode */
     cpu->ir = fetch_byte(cpu);
     uint8_t opcode = cpu->ir;
+    HOSTPROF_BEGIN(opcode_prof);
 
     uint8_t reg, src, imm8;
     int8_t offset;
@@ -268,7 +287,7 @@ int cpu_step(Micro8CPU *cpu) {
     else if (opcode >= OP_LD_BASE && opcode <= OP_LD_BASE + 7) {
         reg = opcode - OP_LD_BASE;
         addr16 = fetch_word(cpu);
-        cpu->r[reg] = cpu_read_mem(cpu, addr16);
+        cpu->r[reg] = m8_cpu_read_mem(cpu, addr16);
         cycles += 4;
     }
 
@@ -276,7 +295,7 @@ int cpu_step(Micro8CPU *cpu) {
     else if (opcode >= OP_LDZ_BASE && opcode <= OP_LDZ_BASE + 7) {
         reg = opcode - OP_LDZ_BASE;
         imm8 = fetch_byte(cpu);
-        cpu->r[reg] = cpu_read_mem(cpu, (uint16_t)imm8);
+        cpu->r[reg] = m8_cpu_read_mem(cpu, (uint16_t)imm8);
         cycles += 3;
     }
 
@@ -284,7 +303,7 @@ int cpu_step(Micro8CPU *cpu) {
     else if (opcode >= OP_ST_BASE && opcode <= OP_ST_BASE + 7) {
         reg = opcode - OP_ST_BASE;
         addr16 = fetch_word(cpu);
-        cpu_write_mem(cpu, addr16, cpu->r[reg]);
+        m8_cpu_write_mem(cpu, addr16, cpu->r[reg]);
         cycles += 4;
     }
 
@@ -292,21 +311,21 @@ int cpu_step(Micro8CPU *cpu) {
     else if (opcode >= OP_STZ_BASE && opcode <= OP_STZ_BASE + 7) {
         reg = opcode - OP_STZ_BASE;
         imm8 = fetch_byte(cpu);
-        cpu_write_mem(cpu, (uint16_t)imm8, cpu->r[reg]);
+        m8_cpu_write_mem(cpu, (uint16_t)imm8, cpu->r[reg]);
         cycles += 3;
     }
 
     /* ========== LD Rd, [HL] (0x2E) ========== */
     else if (opcode == OP_LD_HL) {
         reg = fetch_byte(cpu) & 0x07;
-        cpu->r[reg] = cpu_read_mem(cpu, cpu_get_hl(cpu));
+        cpu->r[reg] = m8_cpu_read_mem(cpu, cpu_get_hl(cpu));
         cycles += 3;
     }
 
     /* ========== ST [HL], Rs (0x2F) ========== */
     else if (opcode == OP_ST_HL) {
         reg = fetch_byte(cpu) & 0x07;
-        cpu_write_mem(cpu, cpu_get_hl(cpu), cpu->r[reg]);
+        m8_cpu_write_mem(cpu, cpu_get_hl(cpu), cpu->r[reg]);
         cycles += 3;
     }
 
@@ -315,7 +334,7 @@ int cpu_step(Micro8CPU *cpu) {
         reg = fetch_byte(cpu) & 0x07;
         offset = (int8_t)fetch_byte(cpu);
         addr16 = cpu_get_hl(cpu) + offset;
-        cpu->r[reg] = cpu_read_mem(cpu, addr16);
+        cpu->r[reg] = m8_cpu_read_mem(cpu, addr16);
         cycles += 4;
     }
 
@@ -324,7 +343,7 @@ int cpu_step(Micro8CPU *cpu) {
         reg = fetch_byte(cpu) & 0x07;
         offset = (int8_t)fetch_byte(cpu);
         addr16 = cpu_get_hl(cpu) + offset;
-        cpu_write_mem(cpu, addr16, cpu->r[reg]);
+        m8_cpu_write_mem(cpu, addr16, cpu->r[reg]);
         cycles += 4;
     }
 
@@ -792,6 +811,7 @@ int cpu_step(Micro8CPU *cpu) {
         return cycles;
     }
 
+    HOSTPROF_END(opcode_prof, opcode);
     cpu->instructions++;
     cpu->cycles += cycles;
 
@@ -802,11 +822,11 @@ int cpu_step(Micro8CPU *cpu) {
  * Run CPU
  * ======================================================================== */
 
-int cpu_run(Micro8CPU *cpu, int max_cycles) {
+int m8_cpu_run(Micro8CPU *cpu, int max_cycles) {
     int total_cycles = 0;
 
     while (!cpu->halted && (max_cycles <= 0 || total_cycles < max_cycles)) {
-        int cycles = cpu_step(cpu);
+        int cycles = m8_cpu_step(cpu);
         if (cycles == 0) break;
         total_cycles += cycles;
     }
@@ -818,7 +838,7 @@ int cpu_run(Micro8CPU *cpu, int max_cycles) {
  * Debug Support
  * ======================================================================== */
 
-void cpu_dump_state(const Micro8CPU *cpu) {
+void m8_cpu_dump_state(const Micro8CPU *cpu) {
     printf("=== Micro8 CPU State ===\n");
     printf("PC: 0x%04X  SP: 0x%04X  IE: %s\n",
            cpu->pc, cpu->sp, cpu->ie ? "ON" : "OFF");
@@ -848,7 +868,7 @@ void cpu_dump_state(const Micro8CPU *cpu) {
     printf("========================\n");
 }
 
-void cpu_dump_memory(const Micro8CPU *cpu, uint16_t start, uint16_t end) {
+void m8_cpu_dump_memory(const Micro8CPU *cpu, uint16_t start, uint16_t end) {
     printf("Memory [0x%04X - 0x%04X]:\n", start, end);
 
     for (uint32_t addr = start; addr <= end; addr += 16) {
@@ -871,7 +891,7 @@ void cpu_dump_memory(const Micro8CPU *cpu, uint16_t start, uint16_t end) {
  */
 static char disasm_buf[64];
 
-const char* cpu_disassemble(const Micro8CPU *cpu, uint16_t addr, int *instr_len) {
+const char* m8_cpu_disassemble(const Micro8CPU *cpu, uint16_t addr, int *instr_len) {
     uint8_t opcode = cpu->memory[addr];
     *instr_len = 1;
 
@@ -251,26 +251,26 @@ typedef struct {
  * ======================================================================== */
 
 /* CPU Lifecycle */
-bool cpu_init(Micro8CPU *cpu);
-void cpu_free(Micro8CPU *cpu);
-void cpu_reset(Micro8CPU *cpu);
+bool m8_cpu_init(Micro8CPU *cpu);
+void m8_cpu_free(Micro8CPU *cpu);
+void m8_cpu_reset(Micro8CPU *cpu);
 
 /* Memory Operations */
-void cpu_load_program(Micro8CPU *cpu, const uint8_t *program, uint16_t size, uint16_t start_addr);
-uint8_t cpu_read_mem(Micro8CPU *cpu, uint16_t addr);
-void cpu_write_mem(Micro8CPU *cpu, uint16_t addr, uint8_t value);
+void m8_cpu_load_program(Micro8CPU *cpu, const uint8_t *program, uint16_t size, uint16_t start_addr);
+uint8_t m8_cpu_read_mem(Micro8CPU *cpu, uint16_t addr);
+void m8_cpu_write_mem(Micro8CPU *cpu, uint16_t addr, uint8_t value);
 
 /* Execution */
-int cpu_step(Micro8CPU *cpu);           /* Execute one instruction, returns cycles used */
-int cpu_run(Micro8CPU *cpu, int max_cycles);  /* Run until halt or max_cycles */
+int m8_cpu_step(Micro8CPU *cpu);           /* Execute one instruction, returns cycles used */
+int m8_cpu_run(Micro8CPU *cpu, int max_cycles);  /* Run until halt or max_cycles */
 
 /* Interrupts */
-void cpu_request_interrupt(Micro8CPU *cpu);
+void m8_cpu_request_interrupt(Micro8CPU *cpu);
 
 /* Debugging */
-void cpu_dump_state(const Micro8CPU *cpu);
-void cpu_dump_memory(const Micro8CPU *cpu, uint16_t start, uint16_t end);
-const char* cpu_disassemble(const Micro8CPU *cpu, uint16_t addr, int *instr_len);
+void m8_cpu_dump_state(const Micro8CPU *cpu);
+void m8_cpu_dump_memory(const Micro8CPU *cpu, uint16_t start, uint16_t end);
+const char* m8_cpu_disassemble(const Micro8CPU *cpu, uint16_t addr, int *instr_len);
 
 /* Register pair helpers */
 static inline uint16_t cpu_get_hl(const Micro8CPU *cpu) {
@@ -3,6 +3,7 @@
  *
  * Provides interactive debugging for the Micro8 CPU with:
  * - Breakpoint management (set, list, delete)
+ * - Tracepoints that log values to a ring buffer without stopping
  * - Single-step execution
  * - Run until halt/breakpoint
  * - Register display (R0-R7, SP, PC, flags)
@@ -21,11 +22,17 @@
 void dbg_init(Micro8Debugger *dbg, Micro8CPU *cpu) {
     dbg->cpu = cpu;
     dbg->bp_count = 0;
+    dbg->tp_count = 0;
+    dbg->trace_total = 0;
     dbg->running = true;
     for (int i = 0; i < MAX_BREAKPOINTS; i++) {
         dbg->bp_active[i] = false;
         dbg->breakpoints[i] = 0;
     }
+    for (int i = 0; i < MAX_TRACEPOINTS; i++) {
+        dbg->tracepoints[i].active = false;
+        dbg->tracepoints[i].hits = 0;
+    }
 }
 
 /* Set a breakpoint at the given address */
@@ -93,6 +100,180 @@ void dbg_list_breakpoints(Micro8Debugger *dbg) {
     }
 }
 
+/* Name of a trace item for display (returns static buffer) */
+static const char *trace_item_name(const TraceItem *item) {
+    static char buf[16];
+
+    if (item->kind == TRACE_ITEM_MEM) {
+        snprintf(buf, sizeof(buf), "[%04X]", item->which);
+    } else if (item->which == TRACE_REG_SP) {
+        snprintf(buf, sizeof(buf), "SP");
+    } else if (item->which == TRACE_REG_FLAGS) {
+        snprintf(buf, sizeof(buf), "F");
+    } else {
+        snprintf(buf, sizeof(buf), "R%d", item->which);
+    }
+    return buf;
+}
+
+/* Set a tracepoint at the given address */
+bool dbg_set_tracepoint(Micro8Debugger *dbg, uint16_t addr,
+                        const TraceItem *items, int item_count) {
+    if (item_count <= 0 || item_count > TRACE_MAX_ITEMS) {
+        printf("Error: Tracepoint needs 1-%d items\n", TRACE_MAX_ITEMS);
+        return false;
+    }
+
+    /* Deleted slots with hits still label buffered records; keep them until tclear */
+    for (int i = 0; i < MAX_TRACEPOINTS; i++) {
+        Tracepoint *tp = &dbg->tracepoints[i];
+        if (!tp->active && tp->hits == 0) {
+            tp->active = true;
+            tp->addr = addr;
+            tp->item_count = item_count;
+            tp->hits = 0;
+            memcpy(tp->items, items, sizeof(TraceItem) * item_count);
+            dbg->tp_count++;
+            printf("Tracepoint %d set at 0x%04X\n", i, addr);
+            return true;
+        }
+    }
+
+    printf("Error: Maximum tracepoints (%d) reached (tclear frees deleted ones)\n",
+           MAX_TRACEPOINTS);
+    return false;
+}
+
+/* Clear a tracepoint by index */
+bool dbg_clear_tracepoint(Micro8Debugger *dbg, int index) {
+    if (index < 0 || index >= MAX_TRACEPOINTS || !dbg->tracepoints[index].active) {
+        printf("No tracepoint %d\n", index);
+        return false;
+    }
+
+    dbg->tracepoints[index].active = false;
+    dbg->tp_count--;
+    printf("Tracepoint %d cleared\n", index);
+    return true;
+}
+
+/* List all tracepoints */
+void dbg_list_tracepoints(Micro8Debugger *dbg) {
+    if (dbg->tp_count == 0) {
+        printf("No tracepoints set\n");
+        return;
+    }
+
+    printf("Tracepoints (%d active):\n", dbg->tp_count);
+    for (int i = 0; i < MAX_TRACEPOINTS; i++) {
+        Tracepoint *tp = &dbg->tracepoints[i];
+        if (!tp->active) continue;
+
+        printf("  [%2d] 0x%04X  records:", i, tp->addr);
+        for (int j = 0; j < tp->item_count; j++) {
+            printf(" %s", trace_item_name(&tp->items[j]));
+        }
+        printf("  (%lu hits)\n", (unsigned long)tp->hits);
+    }
+}
+
+/* Record a trace entry for every tracepoint at the current PC */
+void dbg_check_tracepoints(Micro8Debugger *dbg) {
+    Micro8CPU *cpu = dbg->cpu;
+
+    for (int i = 0; i < MAX_TRACEPOINTS; i++) {
+        Tracepoint *tp = &dbg->tracepoints[i];
+        if (!tp->active || tp->addr != cpu->pc) continue;
+
+        TraceRecord *rec = &dbg->trace_buf[dbg->trace_total & (TRACE_BUFFER_SIZE - 1)];
+        rec->cycles = cpu->cycles;
+        rec->pc = cpu->pc;
+        rec->tp_index = (uint8_t)i;
+
+        for (int j = 0; j < tp->item_count; j++) {
+            const TraceItem *item = &tp->items[j];
+            if (item->kind == TRACE_ITEM_MEM) {
+                rec->values[j] = cpu->memory[item->which];
+            } else if (item->which == TRACE_REG_SP) {
+                rec->values[j] = cpu->sp;
+            } else if (item->which == TRACE_REG_FLAGS) {
+                rec->values[j] = cpu->flags;
+            } else {
+                rec->values[j] = cpu->r[item->which];
+            }
+        }
+
+        tp->hits++;
+        dbg->trace_total++;
+    }
+}
+
+/*
+ * Write the newest `count` trace records (all if count <= 0) to `out`,
+ * oldest first. A non-negative `filter` keeps only that tracepoint.
+ */
+void dbg_dump_trace(Micro8Debugger *dbg, FILE *out, int count, int filter) {
+    uint64_t first = 0;
+    if (dbg->trace_total > TRACE_BUFFER_SIZE) {
+        first = dbg->trace_total - TRACE_BUFFER_SIZE;
+    }
+
+    /* Walk backwards to find where the newest `count` matches start */
+    uint64_t start = dbg->trace_total;
+    int matched = 0;
+    while (start > first && (count <= 0 || matched < count)) {
+        start--;
+        const TraceRecord *rec = &dbg->trace_buf[start & (TRACE_BUFFER_SIZE - 1)];
+        if (filter < 0 || rec->tp_index == filter) matched++;
+    }
+
+    if (matched == 0) {
+        fprintf(out, "Trace buffer is empty\n");
+        return;
+    }
+
+    for (uint64_t seq = start; seq < dbg->trace_total; seq++) {
+        const TraceRecord *rec = &dbg->trace_buf[seq & (TRACE_BUFFER_SIZE - 1)];
+        if (filter >= 0 && rec->tp_index != filter) continue;
+
+        const Tracepoint *tp = &dbg->tracepoints[rec->tp_index];
+        fprintf(out, "#%-6lu cyc=%-10lu tp%-2d 0x%04X:",
+                (unsigned long)seq, (unsigned long)rec->cycles,
+                rec->tp_index, rec->pc);
+        for (int j = 0; j < tp->item_count; j++) {
+            fprintf(out, " %s=%02X", trace_item_name(&tp->items[j]), rec->values[j]);
+        }
+        fprintf(out, "\n");
+    }
+
+    if (first > 0) {
+        fprintf(out, "(%lu older records overwritten)\n", (unsigned long)first);
+    }
+}
+
+/* Write the whole trace buffer to a file */
+bool dbg_save_trace(Micro8Debugger *dbg, const char *filename, int filter) {
+    FILE *f = fopen(filename, "w");
+    if (!f) {
+        printf("Error: Cannot create file '%s'\n", filename);
+        return false;
+    }
+
+    dbg_dump_trace(dbg, f, 0, filter);
+    fclose(f);
+
+    printf("Trace written to '%s'\n", filename);
+    return true;
+}
+
+/* Discard all recorded trace entries */
+void dbg_clear_trace(Micro8Debugger *dbg) {
+    dbg->trace_total = 0;
+    for (int i = 0; i < MAX_TRACEPOINTS; i++) {
+        dbg->tracepoints[i].hits = 0;
+    }
+}
+
 /* Execute one instruction */
 int dbg_step(Micro8Debugger *dbg) {
     if (dbg->cpu->halted) {
@@ -100,7 +281,11 @@ int dbg_step(Micro8Debugger *dbg) {
         return 0;
     }
 
-    int cycles = cpu_step(dbg->cpu);
+    if (dbg->tp_count > 0) {
+        dbg_check_tracepoints(dbg);
+    }
+
+    int cycles = m8_cpu_step(dbg->cpu);
     return cycles;
 }
 
@@ -117,7 +302,12 @@ int dbg_run_until_break(Micro8Debugger *dbg, int max_cycles) {
         }
         first = false;
 
-        int cycles = cpu_step(dbg->cpu);
+        /* Tracepoints record and fall through without stopping */
+        if (dbg->tp_count > 0) {
+            dbg_check_tracepoints(dbg);
+        }
+
+        int cycles = m8_cpu_step(dbg->cpu);
         if (cycles == 0) break;
         total_cycles += cycles;
     }
@@ -258,7 +448,7 @@ void dbg_show_current_instruction(Micro8Debugger *dbg) {
     }
 
     int instr_len;
-    const char *disasm = cpu_disassemble(cpu, cpu->pc, &instr_len);
+    const char *disasm = m8_cpu_disassemble(cpu, cpu->pc, &instr_len);
 
     char bp_marker = dbg_has_breakpoint(dbg, cpu->pc) ? '*' : ' ';
 
@@ -284,6 +474,13 @@ void dbg_show_help(void) {
     printf("  break <addr>, b      Set breakpoint at address (hex)\n");
     printf("  delete <addr>, d     Delete breakpoint at address\n");
     printf("  list, l              List all breakpoints\n");
+    printf("  trace <addr> <items> Record items at address without stopping\n");
+    printf("                       items: R0-R7, SP, F, [addr] (memory byte)\n");
+    printf("  untrace <n>          Delete tracepoint by index\n");
+    printf("  tracelist, tl        List all tracepoints\n");
+    printf("  tdump [count] [n]    Show newest trace records (only tracepoint n)\n");
+    printf("  tsave <file> [n]     Write trace records to file\n");
+    printf("  tclear               Discard recorded trace records\n");
     printf("  regs, reg            Show all registers\n");
     printf("  mem <start> [end]    Dump memory (hex addresses)\n");
     printf("  stack [count]        Show stack contents\n");
@@ -362,6 +559,37 @@ static bool parse_address(const char *str, uint16_t *value) {
     return true;
 }
 
+/* Parse a tracepoint item: R0-R7, SP, F/FLAGS or [addr] */
+static bool parse_trace_item(const char *str, TraceItem *item) {
+    if (str[0] == '[') {
+        char buf[16];
+        size_t len = strlen(str);
+        if (len < 3 || len - 2 >= sizeof(buf) || str[len - 1] != ']') {
+            return false;
+        }
+        memcpy(buf, str + 1, len - 2);
+        buf[len - 2] = '\0';
+        item->kind = TRACE_ITEM_MEM;
+        return parse_address(buf, &item->which);
+    }
+
+    item->kind = TRACE_ITEM_REG;
+    if ((str[0] == 'R' || str[0] == 'r') && str[1] >= '0' && str[1] <= '7' && str[2] == '\0') {
+        item->which = (uint16_t)(str[1] - '0');
+        return true;
+    }
+    if (strcmp(str, "SP") == 0 || strcmp(str, "sp") == 0) {
+        item->which = TRACE_REG_SP;
+        return true;
+    }
+    if (strcmp(str, "F") == 0 || strcmp(str, "f") == 0 ||
+        strcmp(str, "FLAGS") == 0 || strcmp(str, "flags") == 0) {
+        item->which = TRACE_REG_FLAGS;
+        return true;
+    }
+    return false;
+}
+
 /* Trim whitespace from string */
 static char *trim(char *str) {
     while (isspace((unsigned char)*str)) str++;
@@ -426,6 +654,65 @@ static void process_command(Micro8Debugger *dbg, char *line) {
     else if (strcmp(cmd, "list") == 0 || strcmp(cmd, "l") == 0) {
         dbg_list_breakpoints(dbg);
     }
+    else if (strcmp(cmd, "trace") == 0 || strcmp(cmd, "t") == 0) {
+        char *arg = strtok(NULL, " \t");
+        if (arg == NULL) {
+            printf("Usage: trace <addr> <item> [item...]\n");
+            return;
+        }
+        uint16_t addr;
+        if (!parse_address(arg, &addr)) {
+            printf("Invalid address: %s\n", arg);
+            return;
+        }
+
+        TraceItem items[TRACE_MAX_ITEMS];
+        int item_count = 0;
+        char *tok;
+        while ((tok = strtok(NULL, " \t")) != NULL) {
+            if (item_count >= TRACE_MAX_ITEMS) {
+                printf("Too many items (max %d)\n", TRACE_MAX_ITEMS);
+                return;
+            }
+            if (!parse_trace_item(tok, &items[item_count])) {
+                printf("Invalid trace item: %s\n", tok);
+                return;
+            }
+            item_count++;
+        }
+        dbg_set_tracepoint(dbg, addr, items, item_count);
+    }
+    else if (strcmp(cmd, "untrace") == 0) {
+        char *arg = strtok(NULL, " \t");
+        if (arg == NULL) {
+            printf("Usage: untrace <tracepoint_index>\n");
+            return;
+        }
+        dbg_clear_tracepoint(dbg, atoi(arg));
+    }
+    else if (strcmp(cmd, "tracelist") == 0 || strcmp(cmd, "tl") == 0) {
+        dbg_list_tracepoints(dbg);
+    }
+    else if (strcmp(cmd, "tdump") == 0) {
+        char *arg1 = strtok(NULL, " \t");
+        char *arg2 = strtok(NULL, " \t");
+        int count = arg1 ? atoi(arg1) : 20;
+        int filter = arg2 ? atoi(arg2) : -1;
+        dbg_dump_trace(dbg, stdout, count, filter);
+    }
+    else if (strcmp(cmd, "tsave") == 0) {
+        char *filename = strtok(NULL, " \t");
+        char *arg = strtok(NULL, " \t");
+        if (filename == NULL) {
+            printf("Usage: tsave <filename> [tracepoint_index]\n");
+            return;
+        }
+        dbg_save_trace(dbg, filename, arg ? atoi(arg) : -1);
+    }
+    else if (strcmp(cmd, "tclear") == 0) {
+        dbg_clear_trace(dbg);
+        printf("Trace buffer cleared\n");
+    }
     else if (strcmp(cmd, "regs") == 0 || strcmp(cmd, "reg") == 0 ||
              strcmp(cmd, "registers") == 0) {
         dbg_show_regs(dbg);
@@ -489,7 +776,7 @@ static void process_command(Micro8Debugger *dbg, char *line) {
         }
     }
     else if (strcmp(cmd, "reset") == 0) {
-        cpu_reset(dbg->cpu);
+        m8_cpu_reset(dbg->cpu);
         printf("CPU reset (SP=0x%04X, PC=0x%04X)\n", dbg->cpu->sp, dbg->cpu->pc);
         dbg_show_current_instruction(dbg);
     }
@@ -548,7 +835,7 @@ int main(int argc, char *argv[]) {
     Micro8CPU cpu;
     Micro8Debugger dbg;
 
-    if (!cpu_init(&cpu)) {
+    if (!m8_cpu_init(&cpu)) {
         fprintf(stderr, "Failed to initialize CPU\n");
         return 1;
     }
@@ -561,13 +848,13 @@ int main(int argc, char *argv[]) {
         if (argc >= 3) {
             if (!parse_address(argv[2], &load_addr)) {
                 fprintf(stderr, "Invalid load address: %s\n", argv[2]);
-                cpu_free(&cpu);
+                m8_cpu_free(&cpu);
                 return 1;
             }
         }
 
         if (!dbg_load_binary(&dbg, argv[1], load_addr)) {
-            cpu_free(&cpu);
+            m8_cpu_free(&cpu);
             return 1;
         }
     } else {
@@ -576,7 +863,7 @@ int main(int argc, char *argv[]) {
 
     dbg_run(&dbg);
 
-    cpu_free(&cpu);
+    m8_cpu_free(&cpu);
     return cpu.error ? 1 : 0;
 }
 #endif /* DEBUGGER_AS_LIBRARY */
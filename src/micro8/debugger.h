@@ -2,8 +2,8 @@
  * Micro8 Interactive Debugger/Monitor
  *
  * Provides an interactive debugging interface for the Micro8 CPU
- * with breakpoints, single-stepping, memory inspection, stack viewing,
- * and disassembly.
+ * with breakpoints, tracepoints, single-stepping, memory inspection,
+ * stack viewing, and disassembly.
  */
 
 #ifndef MICRO8_DEBUGGER_H
@@ -11,16 +11,58 @@
 
 #include "cpu.h"
 #include <stdbool.h>
+#include <stdio.h>
 
 /* Maximum number of breakpoints */
 #define MAX_BREAKPOINTS 32
 
+/* Tracepoint limits */
+#define MAX_TRACEPOINTS   16
+#define TRACE_MAX_ITEMS   8         /* Values recorded per tracepoint hit */
+#define TRACE_BUFFER_SIZE 4096      /* Ring buffer records (power of two) */
+
+/* Register numbers for trace items beyond R0-R7 */
+#define TRACE_REG_SP      8
+#define TRACE_REG_FLAGS   9
+
+/* What a trace item samples */
+typedef enum {
+    TRACE_ITEM_REG = 0,     /* Register (R0-R7, SP, FLAGS) */
+    TRACE_ITEM_MEM          /* Memory byte */
+} TraceItemKind;
+
+typedef struct {
+    TraceItemKind kind;
+    uint16_t which;         /* Register number or memory address */
+} TraceItem;
+
+/* Tracepoint: records values and continues instead of stopping */
+typedef struct {
+    bool active;
+    uint16_t addr;                      /* Address that triggers recording */
+    int item_count;                     /* Number of items to record */
+    TraceItem items[TRACE_MAX_ITEMS];   /* Items to record */
+    uint64_t hits;                      /* Times this tracepoint fired */
+} Tracepoint;
+
+/* One entry in the trace ring buffer */
+typedef struct {
+    uint64_t cycles;                    /* CPU cycle count at the hit */
+    uint16_t pc;                        /* PC at the hit */
+    uint8_t  tp_index;                  /* Tracepoint that produced it */
+    uint16_t values[TRACE_MAX_ITEMS];   /* Recorded values */
+} TraceRecord;
+
 /* Debugger state */
 typedef struct {
     Micro8CPU *cpu;                         /* Pointer to CPU being debugged */
     uint16_t breakpoints[MAX_BREAKPOINTS];  /* Breakpoint addresses (16-bit) */
     bool bp_active[MAX_BREAKPOINTS];        /* Whether each breakpoint is active */
     int bp_count;                           /* Number of active breakpoints */
+    Tracepoint tracepoints[MAX_TRACEPOINTS]; /* Tracepoint list */
+    int tp_count;                           /* Number of active tracepoints */
+    TraceRecord trace_buf[TRACE_BUFFER_SIZE]; /* Preallocated trace ring buffer */
+    uint64_t trace_total;                   /* Records written since last clear */
     bool running;                           /* Debugger is running (not quit) */
 } Micro8Debugger;
 
@@ -36,6 +78,16 @@ bool dbg_clear_breakpoint(Micro8Debugger *dbg, uint16_t addr);
 bool dbg_has_breakpoint(Micro8Debugger *dbg, uint16_t addr);
 void dbg_list_breakpoints(Micro8Debugger *dbg);
 
+/* Tracepoint management */
+bool dbg_set_tracepoint(Micro8Debugger *dbg, uint16_t addr,
+                        const TraceItem *items, int item_count);
+bool dbg_clear_tracepoint(Micro8Debugger *dbg, int index);
+void dbg_list_tracepoints(Micro8Debugger *dbg);
+void dbg_check_tracepoints(Micro8Debugger *dbg);    /* Record hits at current PC */
+void dbg_dump_trace(Micro8Debugger *dbg, FILE *out, int count, int filter);
+bool dbg_save_trace(Micro8Debugger *dbg, const char *filename, int filter);
+void dbg_clear_trace(Micro8Debugger *dbg);
+
 /* Execution control */
 int dbg_step(Micro8Debugger *dbg);                      /* Execute one instruction */
 int dbg_run_until_break(Micro8Debugger *dbg, int max_cycles); /* Run until halt/breakpoint */
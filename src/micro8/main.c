@@ -4,6 +4,8 @@
  * Usage:
  *   micro8 run <file.bin>     - Load and run binary
  *   micro8 debug <file.bin>   - Load and debug interactively
+ *   micro8 bench <file.bin>   - Time repeated runs
+ *   micro8 host <file.bin>    - Many sessions over a thread pool
  *   micro8 help               - Show help
  */
 
@@ -12,6 +14,11 @@
 #include <string.h>
 #include "cpu.h"
 #include "debugger.h"
+#include "../common/bench.h"
+#include "../common/sched.h"
+
+/* Bench: cycles a run may take before it is reported as a timeout */
+#define BENCH_MAX_CYCLES 1000000
 
 /* Print usage */
 static void print_usage(const char *prog) {
@@ -20,6 +27,12 @@ static void print_usage(const char *prog) {
     printf("Usage:\n");
     printf("  %s run <file.bin>     Load and run binary program\n", prog);
     printf("  %s debug <file.bin>   Load and run in debug mode\n", prog);
+    printf("  %s bench <file.bin> [-r n] [-c n] [--csv file]\n", prog);
+    printf("                        Time n runs (default %d) of at most c cycles\n",
+           BENCH_DEFAULT_REPEAT);
+    printf("                        (default %d), append a CSV row\n", BENCH_MAX_CYCLES);
+    printf("  %s host <file.bin> [-s n] [-t n] [-q n]\n", prog);
+    printf("                        Run n sessions over a thread pool, q cycles per slice\n");
     printf("  %s help               Show this help\n", prog);
     printf("\n");
     printf("Debug mode commands:\n");
@@ -28,6 +41,8 @@ static void print_usage(const char *prog) {
     printf("  break <addr>, b      Set breakpoint at address (hex)\n");
     printf("  delete <addr>, d     Delete breakpoint at address\n");
     printf("  list, l              List all breakpoints\n");
+    printf("  trace <addr> <items> Record registers/memory at address, keep running\n");
+    printf("  tdump, tsave, tclear Show, save or discard recorded trace\n");
     printf("  regs, reg            Show all registers\n");
     printf("  mem <start> [end]    Dump memory (hex addresses)\n");
     printf("  stack [count]        Show stack contents\n");
@@ -97,27 +112,27 @@ static bool load_binary(const char *filename, Micro8CPU *cpu) {
 static int cmd_run(const char *filename) {
     Micro8CPU cpu;
 
-    if (!cpu_init(&cpu)) {
+    if (!m8_cpu_init(&cpu)) {
         printf("Error: Failed to initialize CPU\n");
         return 1;
     }
 
     if (!load_binary(filename, &cpu)) {
-        cpu_free(&cpu);
+        m8_cpu_free(&cpu);
         return 1;
     }
 
     printf("\nRunning...\n");
     printf("----------------------------------------\n");
 
-    int cycles = cpu_run(&cpu, 1000000);  /* Max 1M cycles */
+    int cycles = m8_cpu_run(&cpu, 1000000);  /* Max 1M cycles */
 
     printf("----------------------------------------\n");
     printf("Execution complete. (%d cycles)\n\n", cycles);
-    cpu_dump_state(&cpu);
+    m8_cpu_dump_state(&cpu);
 
     int result = cpu.error ? 1 : 0;
-    cpu_free(&cpu);
+    m8_cpu_free(&cpu);
     return result;
 }
 
@@ -126,7 +141,7 @@ static int cmd_debug(const char *filename) {
     Micro8CPU cpu;
     Micro8Debugger dbg;
 
-    if (!cpu_init(&cpu)) {
+    if (!m8_cpu_init(&cpu)) {
         printf("Error: Failed to initialize CPU\n");
         return 1;
     }
@@ -136,7 +151,7 @@ static int cmd_debug(const char *filename) {
 
     /* Load the binary file */
     if (!dbg_load_binary(&dbg, filename, DEFAULT_PC)) {
-        cpu_free(&cpu);
+        m8_cpu_free(&cpu);
         return 1;
     }
 
@@ -144,7 +159,128 @@ static int cmd_debug(const char *filename) {
     dbg_run(&dbg);
 
     int result = cpu.error ? 1 : 0;
-    cpu_free(&cpu);
+    m8_cpu_free(&cpu);
+    return result;
+}
+
+/* Benchmark mode: rerun from the loaded image, timing the whole loop */
+static int cmd_bench(const char *filename, int repeat, int max_cycles, const char *csv_path) {
+    Micro8CPU cpu;
+    BenchSpan spans[BENCH_MAX_SPANS];
+
+    if (!m8_cpu_init(&cpu)) {
+        printf("Error: Failed to initialize CPU\n");
+        return 1;
+    }
+
+    uint8_t *image = malloc(MEM_SIZE);
+    if (image == NULL || !load_binary(filename, &cpu)) {
+        free(image);
+        m8_cpu_free(&cpu);
+        return 1;
+    }
+    memcpy(image, cpu.memory, MEM_SIZE);
+
+    BenchResult r = { "micro8", filename, 0, 0, 0, 0.0, "ok" };
+
+    /* Untimed first run: finds the pages to restore, and a program that
+     * errors or hits the cap is not timed */
+    m8_cpu_reset(&cpu);
+    m8_cpu_run(&cpu, max_cycles);
+    if (cpu.error || !cpu.halted) {
+        r.status = cpu.error ? "error" : "timeout";
+        repeat = 0;
+    }
+    int nspans = bench_dirty_spans(image, cpu.memory, MEM_SIZE, spans, BENCH_MAX_SPANS);
+
+    double start = bench_now();
+    for (int i = 0; i < repeat; i++) {
+        m8_cpu_reset(&cpu);
+        for (int s = 0; s < nspans; s++) {
+            memcpy(cpu.memory + spans[s].start, image + spans[s].start, spans[s].length);
+        }
+        m8_cpu_run(&cpu, max_cycles);
+    }
+    if (repeat > 0) {
+        r.seconds = bench_now() - start;
+        r.iterations = repeat;
+        r.instructions = cpu.instructions * (uint64_t)repeat;
+        r.cycles = cpu.cycles * (uint64_t)repeat;
+    }
+
+    bench_print_summary(&r);
+    int result = bench_write_csv(&r, csv_path) && strcmp(r.status, "ok") == 0 ? 0 : 1;
+    free(image);
+    m8_cpu_free(&cpu);
+    return result;
+}
+
+/* Host mode: one scheduler slice of a session */
+static SessionState host_slice(void *core, int quantum, uint64_t *cycles) {
+    Micro8CPU *cpu = core;
+    uint64_t before = cpu->cycles;
+
+    m8_cpu_run(cpu, quantum);
+    *cycles = cpu->cycles - before;
+
+    return (cpu->halted || cpu->error) ? SESSION_DONE : SESSION_RUNNABLE;
+}
+
+/* Host mode - many independent sessions of one program over a thread pool */
+static int cmd_host(const char *filename, int num_sessions, int threads, int quantum) {
+    Micro8CPU *cpus = calloc((size_t)num_sessions, sizeof(Micro8CPU));
+    SchedSession *sessions = calloc((size_t)num_sessions, sizeof(SchedSession));
+    Scheduler sched;
+    int ready = 0;
+    int result = 1;
+
+    if (cpus == NULL || sessions == NULL || !m8_cpu_init(&cpus[0])) {
+        printf("Error: Failed to allocate %d sessions\n", num_sessions);
+        goto out;
+    }
+    ready = 1;
+
+    if (!load_binary(filename, &cpus[0])) goto out;
+
+    for (; ready < num_sessions; ready++) {
+        if (!m8_cpu_init(&cpus[ready])) {
+            printf("Error: Out of memory after %d sessions\n", ready);
+            goto out;
+        }
+        memcpy(cpus[ready].memory, cpus[0].memory, MEM_SIZE);
+    }
+
+    if (!sched_init(&sched, threads, quantum)) {
+        printf("Error: Failed to start worker threads\n");
+        goto out;
+    }
+    printf("Running %d sessions on %d threads, %d cycles per slice...\n",
+           num_sessions, sched.num_threads, sched.quantum);
+
+    double t0 = bench_now();
+    for (int i = 0; i < num_sessions; i++) {
+        sched_add(&sched, &sessions[i], i, &cpus[i], host_slice);
+    }
+    sched_wait(&sched);
+    double wall = bench_now() - t0;
+    sched_shutdown(&sched);
+
+    sched_print_report(sessions, num_sessions, wall);
+
+    result = 0;
+    for (int i = 0; i < num_sessions; i++) {
+        if (cpus[i].error) {
+            printf("Session %d: ERROR: %s\n", i, cpus[i].error_msg);
+            result = 1;
+        }
+    }
+
+out:
+    for (int i = 0; i < ready; i++) {
+        m8_cpu_free(&cpus[i]);
+    }
+    free(sessions);
+    free(cpus);
     return result;
 }
 
@@ -173,6 +309,35 @@ int main(int argc, char *argv[]) {
         return cmd_run(filename);
     } else if (strcmp(cmd, "debug") == 0) {
         return cmd_debug(filename);
+    } else if (strcmp(cmd, "bench") == 0) {
+        int repeat = BENCH_DEFAULT_REPEAT, max_cycles = BENCH_MAX_CYCLES;
+        const char *csv_path = NULL;
+        for (int i = 3; i + 1 < argc; i += 2) {
+            if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--repeat") == 0) {
+                repeat = atoi(argv[i + 1]);
+            } else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--cycles") == 0) {
+                max_cycles = atoi(argv[i + 1]);
+            } else if (strcmp(argv[i], "--csv") == 0) {
+                csv_path = argv[i + 1];
+            }
+        }
+        return cmd_bench(filename, repeat, max_cycles, csv_path);
+    } else if (strcmp(cmd, "host") == 0) {
+        int num_sessions = 64, threads = 0, quantum = SCHED_DEFAULT_QUANTUM;
+        for (int i = 3; i + 1 < argc; i += 2) {
+            if (strcmp(argv[i], "-s") == 0 || strcmp(argv[i], "--sessions") == 0) {
+                num_sessions = atoi(argv[i + 1]);
+            } else if (strcmp(argv[i], "-t") == 0 || strcmp(argv[i], "--threads") == 0) {
+                threads = atoi(argv[i + 1]);
+            } else if (strcmp(argv[i], "-q") == 0 || strcmp(argv[i], "--quantum") == 0) {
+                quantum = atoi(argv[i + 1]);
+            }
+        }
+        if (num_sessions < 1) {
+            printf("Error: Need at least 1 session\n");
+            return 1;
+        }
+        return cmd_host(filename, num_sessions, threads, quantum);
     } else {
         printf("Unknown command: %s\n\n", cmd);
         print_usage(argv[0]);
@@ -4,6 +4,9 @@
 
 #define _GNU_SOURCE
 #include "circuit.h"
+#include "timing.h"
+#include "switchlevel.h"
+#include "../common/hostprof.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -34,6 +37,8 @@ const char* gate_type_str(GateType t) {
         case GATE_MUX2:   return "MUX2";
         case GATE_DFF:    return "DFF";
         case GATE_DLATCH: return "DLATCH";
+        case GATE_RAM:    return "RAM";
+        case GATE_ROM:    return "ROM";
         case GATE_NMOS:   return "NMOS";
         case GATE_PMOS:   return "PMOS";
         case GATE_CONST:  return "CONST";
@@ -54,6 +59,22 @@ void circuit_init(Circuit *c) {
     circuit_set_wire(c, vdd, 0, WIRE_1);
 }
 
+/* Release everything circuit_init and loading allocated */
+void circuit_free(Circuit *c) {
+    for (int i = 0; i < c->num_wires; i++) {
+        free(c->wires[i].state);
+        free(c->wires[i].next_state);
+    }
+    for (int i = 0; i < c->num_memories; i++) {
+        free(c->memories[i].bytes);
+    }
+    switch_free(c->switch_net);
+    c->switch_net = NULL;
+    c->num_wires = 0;
+    c->num_gates = 0;
+    c->num_memories = 0;
+}
+
 /* Reset circuit state */
 void circuit_reset(Circuit *c) {
     /* Reset all wires to X (except constants) */
@@ -91,6 +112,14 @@ int circuit_add_wire(Circuit *c, const char *name, int width) {
     w->width = width;
     w->state = calloc(width, sizeof(WireState));
     w->next_state = calloc(width, sizeof(WireState));
+    if (w->state == NULL || w->next_state == NULL) {
+        free(w->state);
+        free(w->next_state);
+        c->num_wires--;
+        c->error = true;
+        snprintf(c->error_msg, sizeof(c->error_msg), "Out of memory");
+        return -1;
+    }
     for (int i = 0; i < width; i++) {
         w->state[i] = WIRE_X;
         w->next_state[i] = WIRE_X;
@@ -102,7 +131,7 @@ int circuit_add_wire(Circuit *c, const char *name, int width) {
 }
 
 /* Find a wire by name */
-int circuit_find_wire(Circuit *c, const char *name) {
+int circuit_find_wire(const Circuit *c, const char *name) {
     for (int i = 0; i < c->num_wires; i++) {
         if (strcmp(c->wires[i].name, name) == 0) {
             return i;
@@ -144,6 +173,9 @@ int circuit_add_gate(Circuit *c, GateType type, const char *name) {
     g->stored_value = WIRE_0;
     g->const_value = WIRE_0;
     g->module_ref = -1;
+    if (type == GATE_NMOS || type == GATE_PMOS) {
+        c->num_transistors++;
+    }
 
     return idx;
 }
@@ -263,8 +295,18 @@ static WireState eval_xnor(WireState a, WireState b) {
     return eval_not(eval_xor(a, b));
 }
 
-/* Evaluate a single gate */
-static void eval_gate(Circuit *c, Gate *g) {
+/* Host self-profiling (make PROFILE=1): time per gate type */
+#ifdef HOST_PROFILE
+static const char *gate_slot_name(int slot) {
+    return gate_type_str((GateType)slot);
+}
+
+HOSTPROF_TABLE(gate_prof, "M4HDL gate evaluation", GATE_MODULE + 1, gate_slot_name);
+#endif
+
+/* Compute a gate's output from the current wire states */
+WireState circuit_eval_gate(Circuit *c, const Gate *g) {
+    HOSTPROF_BEGIN(gate_prof);
     WireState result = WIRE_X;
     WireState in0, in1;
 
@@ -348,6 +390,30 @@ static void eval_gate(Circuit *c, Gate *g) {
             result = WIRE_X;
             break;
     }
+    HOSTPROF_END(gate_prof, g->type);
+    return result;
+}
+
+/* Evaluate a single gate into next_state */
+static void eval_gate(Circuit *c, Gate *g) {
+    /* Transistors are solved per channel-connected component */
+    if (g->type == GATE_NMOS || g->type == GATE_PMOS) return;
+
+    /* Memories drive the whole out bus at once */
+    if (g->type == GATE_RAM || g->type == GATE_ROM) {
+        WireState word[MAX_MEM_DATA_BITS];
+        circuit_eval_memory(c, g, word);
+        Wire *out_wire = &c->wires[g->outputs[0]];
+        for (int b = 0; b < out_wire->width; b++) {
+            if (out_wire->state[b] != word[b]) {
+                c->stable = false;
+            }
+            out_wire->next_state[b] = word[b];
+        }
+        return;
+    }
+
+    WireState result = circuit_eval_gate(c, g);
 
     /* Set output */
     if (g->num_outputs >= 1) {
@@ -365,6 +431,13 @@ void circuit_propagate(Circuit *c) {
     int max_iterations = 100;  /* Prevent infinite loops */
     int iteration = 0;
 
+    /* (Re)partition transistors when gates were added since the last build */
+    if (c->num_transistors > 0 &&
+        (c->switch_net == NULL || c->switch_net->built_gates != c->num_gates)) {
+        switch_free(c->switch_net);
+        c->switch_net = switch_build(c);
+    }
+
     do {
         c->stable = true;
 
@@ -372,6 +445,9 @@ void circuit_propagate(Circuit *c) {
         for (int i = 0; i < c->num_gates; i++) {
             eval_gate(c, &c->gates[i]);
         }
+        if (c->switch_net) {
+            switch_propagate(c->switch_net, c);
+        }
 
         /* Copy next_state to state */
         for (int i = 0; i < c->num_wires; i++) {
@@ -403,6 +479,7 @@ void circuit_clock(Circuit *c) {
             g->stored_value = circuit_get_wire(c, g->inputs[0], g->input_bits[0]);
         }
     }
+    circuit_clock_memories(c);
     c->cycle_count++;
 }
 
@@ -443,11 +520,23 @@ void circuit_dump_gates(Circuit *c) {
         printf("  [%3d] %-20s %-6s  ", i, g->name, gate_type_str(g->type));
         printf("in: ");
         for (int j = 0; j < g->num_inputs; j++) {
-            printf("%s[%d] ", c->wires[g->inputs[j]].name, g->input_bits[j]);
+            if (g->input_bits[j] < 0) {
+                printf("%s ", c->wires[g->inputs[j]].name);     /* Whole bus */
+            } else {
+                printf("%s[%d] ", c->wires[g->inputs[j]].name, g->input_bits[j]);
+            }
         }
         printf(" -> out: ");
         for (int j = 0; j < g->num_outputs; j++) {
-            printf("%s[%d] ", c->wires[g->outputs[j]].name, g->output_bits[j]);
+            if (g->output_bits[j] < 0) {
+                printf("%s ", c->wires[g->outputs[j]].name);
+            } else {
+                printf("%s[%d] ", c->wires[g->outputs[j]].name, g->output_bits[j]);
+            }
+        }
+        if (g->type == GATE_RAM || g->type == GATE_ROM) {
+            Memory *m = &c->memories[g->mem_ref];
+            printf(" (%u x %d bits)", m->size, m->data_bits);
         }
         if (g->type == GATE_DFF) {
             printf(" (stored=%s)", wire_state_str(g->stored_value));
@@ -499,12 +588,18 @@ void circuit_export_json(Circuit *c, const char *filename) {
     }
     fprintf(f, "  ],\n");
 
-    /* Export gates */
+    /* Export gates; the visualizer has no memory blocks, so RAM/ROM are
+     * left out and the rest numbered consecutively */
+    int exported = 0, last = -1;
+    for (int i = 0; i < c->num_gates; i++) {
+        if (c->gates[i].type != GATE_RAM && c->gates[i].type != GATE_ROM) last = i;
+    }
     fprintf(f, "  \"gates\": [\n");
     for (int i = 0; i < c->num_gates; i++) {
         Gate *g = &c->gates[i];
+        if (g->type == GATE_RAM || g->type == GATE_ROM) continue;
         fprintf(f, "    {\n");
-        fprintf(f, "      \"id\": %d,\n", i);
+        fprintf(f, "      \"id\": %d,\n", exported++);
         fprintf(f, "      \"name\": \"%s\",\n", g->name);
         fprintf(f, "      \"type\": \"%s\",\n", gate_type_str(g->type));
         fprintf(f, "      \"inputs\": [");
@@ -522,7 +617,7 @@ void circuit_export_json(Circuit *c, const char *filename) {
         if (g->type == GATE_DFF) {
             fprintf(f, ",\n      \"stored\": %d", g->stored_value);
         }
-        fprintf(f, "\n    }%s\n", i < c->num_gates - 1 ? "," : "");
+        fprintf(f, "\n    }%s\n", i < last ? "," : "");
     }
     fprintf(f, "  ]\n");
     fprintf(f, "}\n");
@@ -579,6 +674,8 @@ static int gate_transistor_count(GateType type) {
         case GATE_MUX2:   return 12;  /* Transmission gates + inverter */
         case GATE_DFF:    return 40;  /* Master-slave latch */
         case GATE_DLATCH: return 20;  /* D latch */
+        case GATE_RAM:    return 0;   /* Native storage, not modelled */
+        case GATE_ROM:    return 0;
         case GATE_NMOS:   return 1;
         case GATE_PMOS:   return 1;
         case GATE_CONST:  return 0;
@@ -630,6 +727,11 @@ void circuit_analyze_timing(Circuit *c, CircuitTiming *timing) {
             /* Set output level = max_input + 1 */
             for (int j = 0; j < g->num_outputs; j++) {
                 int wire_idx = g->outputs[j];
+                /* A transistor does not drive the rails or its own gate (load) */
+                if ((g->type == GATE_NMOS || g->type == GATE_PMOS) &&
+                    (wire_idx < 2 || wire_idx == g->inputs[0])) {
+                    continue;
+                }
                 if (wire_idx >= 0 && wire_idx < c->num_wires) {
                     int new_level = max_level + 1;
                     if (new_level > wire_levels[wire_idx]) {
@@ -670,23 +772,9 @@ void circuit_print_clock_speeds(CircuitTiming *timing) {
            "Technology", "Gate Delay", "Max Clock", "MIPS (est)");
     printf("---------------------|--------------|--------------|-------------\n");
 
-    /* Technology specs: name, gate_delay_ns, description */
-    struct {
-        const char *name;
-        double gate_delay_ns;
-    } technologies[] = {
-        {"Relay (1940s)",       10000000.0},  /* 10 ms */
-        {"Vacuum Tube (1950s)", 100000.0},    /* 100 us */
-        {"RTL (1960s)",         50.0},        /* 50 ns */
-        {"DTL (1965)",          30.0},        /* 30 ns */
-        {"TTL (1970s)",         10.0},        /* 10 ns */
-        {"NMOS (1980s)",        5.0},         /* 5 ns */
-        {"CMOS 1um (1985)",     2.0},         /* 2 ns */
-        {"CMOS 350nm (1995)",   0.5},         /* 0.5 ns */
-        {"CMOS 65nm (2005)",    0.1},         /* 100 ps */
-        {"CMOS 7nm (2020)",     0.01},        /* 10 ps */
-    };
-    int num_tech = sizeof(technologies) / sizeof(technologies[0]);
+    /* Same technology models the timed simulator uses */
+    const TechModel *technologies = timing_techs;
+    int num_tech = timing_num_techs;
 
     for (int i = 0; i < num_tech; i++) {
         double total_delay_ns = timing->critical_path_depth * technologies[i].gate_delay_ns;
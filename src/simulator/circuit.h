@@ -14,6 +14,9 @@
 #define MAX_WIRES       1024
 #define MAX_GATES       2048
 #define MAX_MODULES     128
+#define MAX_MEMORIES    16
+#define MAX_MEM_ADDR_BITS 24    /* 16 MB per memory */
+#define MAX_MEM_DATA_BITS 32
 #define MAX_NAME_LEN    64
 #define MAX_INPUTS      16
 #define MAX_OUTPUTS     8
@@ -39,6 +42,8 @@ typedef enum {
     GATE_MUX2,      /* 2:1 multiplexer */
     GATE_DFF,       /* D flip-flop */
     GATE_DLATCH,    /* D latch */
+    GATE_RAM,       /* Word read, clocked write (see Memory) */
+    GATE_ROM,       /* Word read only */
     /* Transistor level */
     GATE_NMOS,
     GATE_PMOS,
@@ -73,8 +78,37 @@ typedef struct {
     WireState const_value;
     /* For MODULE */
     int module_ref;             /* Index of referenced module */
+    /* For RAM/ROM */
+    int mem_ref;                /* Index into Circuit.memories */
 } Gate;
 
+/*
+ * Memory block (RAM/ROM primitive)
+ *
+ * Backed by a native byte array of 2^addr_bits bytes and evaluated as one
+ * word-level operation instead of per-bit storage gates. A read returns
+ * data_bits starting at the addressed byte (little-endian; narrower than
+ * a byte uses the low bits), so .bin images from all three assemblers
+ * load as-is. Reads are combinational; RAM writes happen on the clock
+ * edge when we = 1 (only the low byte when the optional byte port is 1).
+ *
+ *   ram NAME (addr: a, data: d, we: w, out: q);
+ *   ram NAME (addr: a, data: d, we: w, byte: b, out: q);
+ *   rom NAME (addr: a, out: q);
+ */
+typedef struct {
+    char name[MAX_NAME_LEN];
+    bool writable;
+    int addr_bits;
+    int data_bits;
+    uint32_t size;              /* Bytes */
+    uint8_t *bytes;
+    /* Ports (whole buses; -1 if absent) */
+    int addr_wire, data_wire, out_wire;
+    int we_wire, we_bit;
+    int byte_wire, byte_bit;
+} Memory;
+
 /* Module definition (hierarchical) */
 typedef struct {
     char name[MAX_NAME_LEN];
@@ -103,11 +137,17 @@ typedef struct {
     /* Modules */
     Module modules[MAX_MODULES];
     int num_modules;
+    /* Memory blocks */
+    Memory memories[MAX_MEMORIES];
+    int num_memories;
     /* Current module being parsed */
     int current_module;
     /* Simulation state */
     uint64_t cycle_count;
     bool stable;        /* No signal changes in last propagation */
+    /* Switch-level transistors (partitioned on first propagate) */
+    int num_transistors;
+    struct SwitchNet *switch_net;
     /* Error handling */
     bool error;
     char error_msg[256];
@@ -115,11 +155,12 @@ typedef struct {
 
 /* === Circuit creation === */
 void circuit_init(Circuit *c);
+void circuit_free(Circuit *c);      /* Wire and memory storage; the struct itself is the caller's */
 void circuit_reset(Circuit *c);
 
 /* === Wire operations === */
 int circuit_add_wire(Circuit *c, const char *name, int width);
-int circuit_find_wire(Circuit *c, const char *name);
+int circuit_find_wire(const Circuit *c, const char *name);
 void circuit_set_wire(Circuit *c, int wire_idx, int bit, WireState state);
 WireState circuit_get_wire(Circuit *c, int wire_idx, int bit);
 
@@ -142,6 +183,18 @@ void circuit_propagate(Circuit *c);     /* Propagate combinational logic */
 void circuit_clock(Circuit *c);         /* Clock all flip-flops */
 void circuit_step(Circuit *c);          /* One full cycle (propagate + clock) */
 void circuit_run(Circuit *c, int cycles);
+WireState circuit_eval_gate(Circuit *c, const Gate *g);  /* Output value, no side effects */
+
+/* === Memories === */
+int circuit_add_memory(Circuit *c, GateType type, const char *name, int addr_wire,
+                       int data_wire, int we_wire, int we_bit, int out_wire);
+int circuit_find_memory(const Circuit *c, const char *name);
+/* The addressed word as out-bus bit states (all X if the address is unknown) */
+void circuit_eval_memory(Circuit *c, const Gate *g, WireState *out);
+void circuit_clock_memories(Circuit *c);
+/* Load a .bin (raw bytes) or Intel .hex image at a byte offset */
+bool circuit_memory_load(Circuit *c, int mem_idx, const char *filename, uint32_t offset);
+uint32_t circuit_memory_read_word(const Memory *m, uint32_t addr);
 
 /* === Loading/Parsing === */
 bool circuit_load_file(Circuit *c, const char *filename);
@@ -0,0 +1,139 @@
+/*
+ * libm4sim Self-Test
+ *
+ * Builds an 8-bit accumulator (ripple-carry adder into DFFs) plus a RAM
+ * from a generated netlist, then drives one independent copy per thread
+ * with its own random stimulus and checks every cycle against a C model.
+ * Prints a PASS/FAIL line per check.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "m4sim.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NUM_THREADS     8
+#define NUM_CYCLES      2000
+
+typedef struct {
+    const char *netlist;
+    unsigned seed;
+    int mismatches;
+    bool loaded;
+} Worker;
+
+/* acc <= clr ? 0 : acc + in; RAM at addr stores acc when we */
+static char *build_netlist(void) {
+    size_t cap = 16384, len = 0;
+    char *s = malloc(cap);
+    if (s == NULL) return NULL;
+#define EMIT(...) len += (size_t)snprintf(s + len, cap - len, __VA_ARGS__)
+    EMIT("wire [7:0] in;\nwire [7:0] acc;\nwire [7:0] sum;\nwire [7:0] next;\n");
+    EMIT("wire [8:0] carry;\nwire clr;\nwire nclr;\nwire clk;\n");
+    EMIT("wire [3:0] addr;\nwire we;\nwire [7:0] q;\n");
+    EMIT("buf CIN (input: gnd, output: carry[0]);\n");
+    EMIT("not NCLR (input: clr, output: nclr);\n");
+    for (int i = 0; i < 8; i++) {
+        EMIT("wire x%d;\nwire g%d;\nwire p%d;\n", i, i, i);
+        EMIT("xor X%d (input: acc[%d] in[%d], output: x%d);\n", i, i, i, i);
+        EMIT("xor S%d (input: x%d carry[%d], output: sum[%d]);\n", i, i, i, i);
+        EMIT("and G%d (input: acc[%d] in[%d], output: g%d);\n", i, i, i, i);
+        EMIT("and P%d (input: x%d carry[%d], output: p%d);\n", i, i, i, i);
+        EMIT("or C%d (input: g%d p%d, output: carry[%d]);\n", i, i, i, i + 1);
+        EMIT("and K%d (input: sum[%d] nclr, output: next[%d]);\n", i, i, i);
+        EMIT("dff R%d (input: next[%d] clk, output: acc[%d]);\n", i, i, i);
+    }
+    EMIT("ram STORE (addr: addr, data: acc, we: we, out: q);\n");
+#undef EMIT
+    return s;
+}
+
+static void *run_worker(void *arg) {
+    Worker *w = arg;
+    M4Sim *sim = m4sim_create();
+    if (sim == NULL || !m4sim_load_string(sim, w->netlist)) {
+        m4sim_destroy(sim);
+        return NULL;
+    }
+    w->loaded = true;
+
+    /* Resolve names once */
+    enum { IN, CLR, ADDR, WE, NUM_INPUTS };
+    const char *in_names[NUM_INPUTS] = { "in", "clr", "addr", "we" };
+    int in_ports[NUM_INPUTS];
+    for (int i = 0; i < NUM_INPUTS; i++) {
+        in_ports[i] = m4sim_port(sim, in_names[i]);
+    }
+    int out_ports[2] = { m4sim_port(sim, "acc"), m4sim_port(sim, "q") };
+    int store = m4sim_memory(sim, "STORE");
+
+    uint8_t acc = 0, ram[16] = {0};
+    unsigned seed = w->seed;
+    for (int n = 0; n < NUM_CYCLES; n++) {
+        seed = seed * 1103515245u + 12345u;
+        uint64_t in[NUM_INPUTS] = {
+            (seed >> 8) & 0xFF, (seed >> 16) % 17 == 0, (seed >> 20) & 0xF, (seed >> 24) & 1
+        };
+        m4sim_set_ports(sim, in_ports, in, NUM_INPUTS);
+        m4sim_step(sim, 1);
+
+        /* RAM captures the old acc at the same edge the DFFs load */
+        if (in[WE]) ram[in[ADDR]] = acc;
+        acc = in[CLR] ? 0 : (uint8_t)(acc + in[IN]);
+
+        uint64_t out[2], unknown[2];
+        m4sim_get_ports(sim, out_ports, out, unknown, 2);
+        if (out[0] != acc || unknown[0] || out[1] != ram[in[ADDR]] || unknown[1]) {
+            w->mismatches++;
+        }
+    }
+
+    uint8_t bytes[16];
+    if (!m4sim_memory_read(sim, store, 0, bytes, sizeof(bytes)) ||
+        memcmp(bytes, ram, sizeof(ram)) != 0) {
+        w->mismatches++;
+    }
+    m4sim_destroy(sim);
+    return NULL;
+}
+
+static int failures;
+
+static void check(bool ok, const char *what) {
+    printf("%s: %s\n", ok ? "PASS" : "FAIL", what);
+    if (!ok) failures++;
+}
+
+int main(void) {
+    char *netlist = build_netlist();
+
+    /* Errors stay on the handle that made them */
+    M4Sim *bad = m4sim_create();
+    check(!m4sim_load_string(bad, "and A1 (input: a b, output: y);\n$\n") &&
+          m4sim_error(bad)[0] != '\0', "parse error reported on the handle");
+    check(m4sim_load_string(bad, netlist) && m4sim_error(bad)[0] == '\0' &&
+          m4sim_port_width(bad, m4sim_port(bad, "acc")) == 8, "handle reloads");
+    m4sim_destroy(bad);
+
+    pthread_t threads[NUM_THREADS];
+    Worker workers[NUM_THREADS];
+    for (int i = 0; i < NUM_THREADS; i++) {
+        workers[i] = (Worker){ netlist, 1000u + (unsigned)i * 7919u, 0, false };
+        pthread_create(&threads[i], NULL, run_worker, &workers[i]);
+    }
+    int loaded = 0, mismatches = 0;
+    for (int i = 0; i < NUM_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+        loaded += workers[i].loaded;
+        mismatches += workers[i].mismatches;
+    }
+    printf("  %d threads x %d cycles, %d mismatch(es)\n", NUM_THREADS, NUM_CYCLES, mismatches);
+    check(loaded == NUM_THREADS, "every thread loads its own circuit");
+    check(mismatches == 0, "concurrent circuits match the C model");
+
+    free(netlist);
+    printf("%s: %d failure(s)\n", failures ? "FAIL" : "PASS", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,139 @@
+/*
+ * M4HDL Simulator Library - Handle API over Circuit
+ */
+
+#include "m4sim.h"
+#include "circuit.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct M4Sim {
+    Circuit c;
+};
+
+M4Sim *m4sim_create(void) {
+    M4Sim *sim = malloc(sizeof(M4Sim));
+    if (sim == NULL) return NULL;
+    circuit_init(&sim->c);
+    return sim;
+}
+
+void m4sim_destroy(M4Sim *sim) {
+    if (sim == NULL) return;
+    circuit_free(&sim->c);
+    free(sim);
+}
+
+/* Start from an empty circuit so a handle can be reloaded */
+static void m4sim_clear(M4Sim *sim) {
+    circuit_free(&sim->c);
+    circuit_init(&sim->c);
+}
+
+bool m4sim_load_file(M4Sim *sim, const char *filename) {
+    m4sim_clear(sim);
+    return circuit_load_file(&sim->c, filename) && !sim->c.error;
+}
+
+bool m4sim_load_string(M4Sim *sim, const char *source) {
+    m4sim_clear(sim);
+    return circuit_parse(&sim->c, source) && !sim->c.error;
+}
+
+const char *m4sim_error(const M4Sim *sim) {
+    return sim->c.error ? sim->c.error_msg : "";
+}
+
+int m4sim_port(const M4Sim *sim, const char *wire_name) {
+    return circuit_find_wire(&sim->c, wire_name);
+}
+
+int m4sim_port_width(const M4Sim *sim, int port) {
+    if (port < 0 || port >= sim->c.num_wires) return 0;
+    return sim->c.wires[port].width;
+}
+
+int m4sim_memory(const M4Sim *sim, const char *memory_name) {
+    return circuit_find_memory(&sim->c, memory_name);
+}
+
+void m4sim_set(M4Sim *sim, int port, uint64_t value) {
+    if (port < 0 || port >= sim->c.num_wires) return;
+    Wire *w = &sim->c.wires[port];
+    int width = w->width < 64 ? w->width : 64;
+    for (int b = 0; b < width; b++) {
+        WireState s = (value >> b) & 1 ? WIRE_1 : WIRE_0;
+        w->state[b] = s;
+        w->next_state[b] = s;
+    }
+}
+
+uint64_t m4sim_get(const M4Sim *sim, int port, uint64_t *unknown) {
+    uint64_t value = 0, x = 0;
+    if (port >= 0 && port < sim->c.num_wires) {
+        const Wire *w = &sim->c.wires[port];
+        int width = w->width < 64 ? w->width : 64;
+        for (int b = 0; b < width; b++) {
+            if (w->state[b] == WIRE_1) {
+                value |= (uint64_t)1 << b;
+            } else if (w->state[b] != WIRE_0) {
+                x |= (uint64_t)1 << b;
+            }
+        }
+    }
+    if (unknown) *unknown = x;
+    return value;
+}
+
+void m4sim_set_ports(M4Sim *sim, const int *ports, const uint64_t *values, int count) {
+    for (int i = 0; i < count; i++) {
+        m4sim_set(sim, ports[i], values[i]);
+    }
+}
+
+void m4sim_get_ports(const M4Sim *sim, const int *ports, uint64_t *values,
+                     uint64_t *unknown, int count) {
+    for (int i = 0; i < count; i++) {
+        values[i] = m4sim_get(sim, ports[i], unknown ? &unknown[i] : NULL);
+    }
+}
+
+void m4sim_eval(M4Sim *sim) {
+    circuit_propagate(&sim->c);
+}
+
+void m4sim_step(M4Sim *sim, int cycles) {
+    circuit_run(&sim->c, cycles);
+}
+
+void m4sim_reset(M4Sim *sim) {
+    circuit_reset(&sim->c);
+}
+
+uint64_t m4sim_cycles(const M4Sim *sim) {
+    return sim->c.cycle_count;
+}
+
+bool m4sim_memory_load(M4Sim *sim, int memory, const char *filename, uint32_t offset) {
+    return circuit_memory_load(&sim->c, memory, filename, offset);
+}
+
+/* Bytes wrap at the end of the memory, like addresses do */
+bool m4sim_memory_write(M4Sim *sim, int memory, uint32_t offset, const uint8_t *data, uint32_t size) {
+    if (memory < 0 || memory >= sim->c.num_memories) return false;
+    Memory *m = &sim->c.memories[memory];
+    for (uint32_t i = 0; i < size; i++) {
+        m->bytes[(offset + i) & (m->size - 1)] = data[i];
+    }
+    return true;
+}
+
+bool m4sim_memory_read(const M4Sim *sim, int memory, uint32_t offset, uint8_t *data, uint32_t size) {
+    if (memory < 0 || memory >= sim->c.num_memories) return false;
+    const Memory *m = &sim->c.memories[memory];
+    for (uint32_t i = 0; i < size; i++) {
+        data[i] = m->bytes[(offset + i) & (m->size - 1)];
+    }
+    return true;
+}
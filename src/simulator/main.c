@@ -4,12 +4,17 @@
  * Usage:
  *   m4sim <file.m4hdl>           - Load and simulate
  *   m4sim test                   - Run built-in tests
+ *   m4sim timing <file> [tech]   - Timed simulation (settle time, hazards)
+ *   m4sim activation <file> <out> - Per-opcode gate activation index
  */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include "circuit.h"
+#include "timing.h"
+#include "switchlevel.h"
 
 /* Build a half adder programmatically */
 void build_half_adder(Circuit *c) {
@@ -367,6 +372,666 @@ void test_adder4(void) {
     printf("\n");
 }
 
+/* Test the timed simulator: settle time and a textbook static hazard */
+int test_timing(void) {
+    printf("=== Testing Timed Simulation ===\n\n");
+    int failures = 0;
+
+    /* y = (a AND b) OR (NOT a AND c); with b = c = 1, a falling glitches y */
+    Circuit c;
+    circuit_init(&c);
+    int a = circuit_add_wire(&c, "a", 1);
+    int b = circuit_add_wire(&c, "b", 1);
+    int cin = circuit_add_wire(&c, "c", 1);
+    int na = circuit_add_wire(&c, "na", 1);
+    int t1 = circuit_add_wire(&c, "t1", 1);
+    int t2 = circuit_add_wire(&c, "t2", 1);
+    int y = circuit_add_wire(&c, "y", 1);
+    circuit_add_not(&c, "N1", a, na);
+    circuit_add_and(&c, "A1", a, b, t1);
+    circuit_add_and(&c, "A2", na, cin, t2);
+    circuit_add_or(&c, "O1", t1, t2, y);
+
+    circuit_set_wire(&c, a, 0, WIRE_1);
+    circuit_set_wire(&c, b, 0, WIRE_1);
+    circuit_set_wire(&c, cin, 0, WIRE_1);
+    circuit_propagate(&c);
+
+    TimingSim t;
+    TimingCycle r;
+    timing_init(&t, &c, timing_find_tech("ttl"));
+    timing_set_input(&t, a, 0, WIRE_0);
+    timing_settle(&t, &r);
+
+    /* TTL: NOT 10 ns, AND/OR 15 ns; y drops at 30 ns and recovers at 40 ns */
+    double settle = timing_ticks_ns(&t, r.settle_ticks);
+    printf("  Hazard circuit: settle %.1f ns, %d glitch(es), %d static hazard(s)\n",
+           settle, r.glitches, r.static_hazards);
+    if (settle == 40.0 && r.glitches == 1 && r.static_hazards == 1 &&
+        circuit_get_wire(&c, y, 0) == WIRE_1) {
+        printf("PASS: static hazard detected\n");
+    } else {
+        printf("FAIL: static hazard detected\n");
+        failures++;
+    }
+    timing_free(&t);
+
+    /* Timed and zero-delay results agree on every full adder input */
+    Circuit fa, ref;
+    circuit_init(&fa);
+    circuit_init(&ref);
+    build_full_adder(&fa);
+    build_full_adder(&ref);
+    circuit_propagate(&fa);
+    timing_init(&t, &fa, timing_find_tech("cmos"));
+    int mismatches = 0;
+    for (int v = 0; v < 8; v++) {
+        const char *in[] = {"a", "b", "cin"};
+        for (int i = 0; i < 3; i++) {
+            WireState s = (v >> i) & 1 ? WIRE_1 : WIRE_0;
+            timing_set_input(&t, circuit_find_wire(&fa, in[i]), 0, s);
+            circuit_set_wire(&ref, circuit_find_wire(&ref, in[i]), 0, s);
+        }
+        timing_settle(&t, &r);
+        circuit_propagate(&ref);
+        if (circuit_get_wire(&fa, circuit_find_wire(&fa, "sum"), 0) !=
+                circuit_get_wire(&ref, circuit_find_wire(&ref, "sum"), 0) ||
+            circuit_get_wire(&fa, circuit_find_wire(&fa, "cout"), 0) !=
+                circuit_get_wire(&ref, circuit_find_wire(&ref, "cout"), 0)) {
+            mismatches++;
+        }
+    }
+    timing_free(&t);
+    if (mismatches == 0) {
+        printf("PASS: timed full adder matches zero-delay\n");
+    } else {
+        printf("FAIL: timed full adder matches zero-delay (%d mismatches)\n", mismatches);
+        failures++;
+    }
+    printf("\n");
+    return failures;
+}
+
+/* Add a transistor: gate terminal, then the two channel terminals */
+static void add_transistor(Circuit *c, GateType type, const char *name, int gate, int d, int s) {
+    int g = circuit_add_gate(c, type, name);
+    circuit_gate_add_input(c, g, gate, 0);
+    circuit_gate_add_output(c, g, d, 0);
+    circuit_gate_add_output(c, g, s, 0);
+}
+
+/* Test the switch-level solver on classic MOS structures */
+int test_switch_level(void) {
+    printf("=== Testing Switch-Level Transistors ===\n\n");
+    int failures = 0;
+    static Circuit c;
+    circuit_init(&c);
+    int gnd = circuit_find_wire(&c, "gnd");
+    int vdd = circuit_find_wire(&c, "vdd");
+
+    /* CMOS NAND: parallel PMOS pull-up, series NMOS pull-down */
+    int a = circuit_add_wire(&c, "a", 1);
+    int b = circuit_add_wire(&c, "b", 1);
+    int y = circuit_add_wire(&c, "y", 1);
+    int m = circuit_add_wire(&c, "m", 1);
+    add_transistor(&c, GATE_PMOS, "P1", a, y, vdd);
+    add_transistor(&c, GATE_PMOS, "P2", b, y, vdd);
+    add_transistor(&c, GATE_NMOS, "N1", a, y, m);
+    add_transistor(&c, GATE_NMOS, "N2", b, m, gnd);
+
+    /* NMOS inverter: depletion load (gate tied to output) vs. driver */
+    int in = circuit_add_wire(&c, "in", 1);
+    int out = circuit_add_wire(&c, "out", 1);
+    add_transistor(&c, GATE_NMOS, "LOAD", out, vdd, out);
+    add_transistor(&c, GATE_NMOS, "DRV", in, out, gnd);
+
+    /* Pass transistor onto a storage node */
+    int x = circuit_add_wire(&c, "x", 1);
+    int en = circuit_add_wire(&c, "en", 1);
+    int store = circuit_add_wire(&c, "store", 1);
+    c.wires[x].is_input = true;
+    add_transistor(&c, GATE_NMOS, "PASS", en, x, store);
+
+    /* Both rails onto one node */
+    int fight = circuit_add_wire(&c, "fight", 1);
+    add_transistor(&c, GATE_NMOS, "UP", en, fight, vdd);
+    add_transistor(&c, GATE_NMOS, "DOWN", en, fight, gnd);
+
+    int nand_ok = 1, inv_ok = 1;
+    for (int v = 0; v < 4; v++) {
+        circuit_set_wire(&c, a, 0, v & 1 ? WIRE_1 : WIRE_0);
+        circuit_set_wire(&c, b, 0, v & 2 ? WIRE_1 : WIRE_0);
+        circuit_set_wire(&c, in, 0, v & 1 ? WIRE_1 : WIRE_0);
+        circuit_propagate(&c);
+        WireState expect = v == 3 ? WIRE_0 : WIRE_1;
+        if (circuit_get_wire(&c, y, 0) != expect) nand_ok = 0;
+        if (circuit_get_wire(&c, out, 0) != (v & 1 ? WIRE_0 : WIRE_1)) inv_ok = 0;
+    }
+    printf("  %d transistors in %d channel-connected components\n",
+           c.switch_net->num_trans, c.switch_net->num_comps);
+    printf("%s: CMOS NAND truth table\n", nand_ok ? "PASS" : "FAIL");
+    printf("%s: NMOS inverter with depletion load\n", inv_ok ? "PASS" : "FAIL");
+    failures += !nand_ok + !inv_ok;
+
+    /* Charge storage: write 1, close the pass gate, change x */
+    circuit_set_wire(&c, x, 0, WIRE_1);
+    circuit_set_wire(&c, en, 0, WIRE_1);
+    circuit_propagate(&c);
+    int fight_x = circuit_get_wire(&c, fight, 0) == WIRE_X;
+    circuit_set_wire(&c, en, 0, WIRE_0);
+    circuit_propagate(&c);
+    circuit_set_wire(&c, x, 0, WIRE_0);
+    circuit_propagate(&c);
+    int held = circuit_get_wire(&c, store, 0) == WIRE_1;
+    printf("%s: pass transistor holds charge\n", held ? "PASS" : "FAIL");
+    printf("%s: rail conflict resolves to X\n", fight_x ? "PASS" : "FAIL");
+    failures += !held + !fight_x;
+
+    /* Nothing changed: no component is solved again */
+    uint64_t solves = c.switch_net->solves;
+    circuit_propagate(&c);
+    int incremental = c.switch_net->solves == solves;
+    printf("%s: unchanged components are skipped\n", incremental ? "PASS" : "FAIL");
+    failures += !incremental;
+
+    /* Timed: NAND output falls after two transistor delays at most */
+    circuit_set_wire(&c, a, 0, WIRE_1);
+    circuit_set_wire(&c, b, 0, WIRE_0);
+    circuit_propagate(&c);
+    TimingSim t;
+    TimingCycle r;
+    timing_init(&t, &c, timing_find_tech("nmos"));
+    timing_set_input(&t, b, 0, WIRE_1);
+    timing_settle(&t, &r);
+    int timed = circuit_get_wire(&c, y, 0) == WIRE_0 && r.settle_ticks > 0;
+    printf("%s: timed NAND switches (%.1f ns)\n", timed ? "PASS" : "FAIL",
+           timing_ticks_ns(&t, r.settle_ticks));
+    failures += !timed;
+    timing_free(&t);
+
+    printf("\n");
+    return failures;
+}
+
+/* Read a bus as a number (X and Z read as 0) */
+static uint32_t bus_get(Circuit *c, int wire_idx) {
+    uint32_t v = 0;
+    for (int b = 0; b < c->wires[wire_idx].width; b++) {
+        if (circuit_get_wire(c, wire_idx, b) == WIRE_1) v |= 1u << b;
+    }
+    return v;
+}
+
+static void bus_set(Circuit *c, int wire_idx, uint32_t v) {
+    for (int b = 0; b < c->wires[wire_idx].width; b++) {
+        circuit_set_wire(c, wire_idx, b, (v >> b) & 1 ? WIRE_1 : WIRE_0);
+    }
+}
+
+/* Test the RAM/ROM primitives and image loading */
+int test_memory(void) {
+    printf("=== Testing RAM/ROM ===\n\n");
+    int failures = 0;
+    static Circuit c;
+    circuit_init(&c);
+    if (!circuit_parse(&c,
+            "wire [3:0] ra;\n"
+            "wire [7:0] rq;\n"
+            "wire [7:0] wa;\n"
+            "wire [15:0] wd;\n"
+            "wire [15:0] wq;\n"
+            "wire we;\n"
+            "wire bw;\n"
+            "rom TABLE (addr: ra, out: rq);\n"
+            "ram STORE (addr: wa, data: wd, we: we, byte: bw, out: wq);\n")) {
+        printf("FAIL: parse memories (%s)\n\n", c.error_msg);
+        return 1;
+    }
+    int ra = circuit_find_wire(&c, "ra"), rq = circuit_find_wire(&c, "rq");
+    int wa = circuit_find_wire(&c, "wa"), wd = circuit_find_wire(&c, "wd");
+    int wq = circuit_find_wire(&c, "wq"), we = circuit_find_wire(&c, "we");
+    int bw = circuit_find_wire(&c, "bw");
+    int rom = circuit_find_memory(&c, "TABLE"), ram = circuit_find_memory(&c, "STORE");
+
+    /* ROM contents from a raw image, then an Intel HEX overlay at 8 */
+    const char *bin_path = "/tmp/m4sim_test_rom.bin";
+    const char *hex_path = "/tmp/m4sim_test_rom.hex";
+    FILE *f = fopen(bin_path, "wb");
+    for (int i = 0; i < 16; i++) fputc(i * 3, f);
+    fclose(f);
+    f = fopen(hex_path, "w");
+    fprintf(f, ":02000000A55AFF\n:00000001FF\n");
+    fclose(f);
+    bool loaded = circuit_memory_load(&c, rom, bin_path, 0) &&
+                  circuit_memory_load(&c, rom, hex_path, 8);
+    remove(bin_path);
+    remove(hex_path);
+
+    int rom_ok = loaded;
+    for (int a = 0; a < 16 && rom_ok; a++) {
+        bus_set(&c, ra, a);
+        circuit_propagate(&c);
+        uint32_t expect = a == 8 ? 0xA5 : a == 9 ? 0x5A : (uint32_t)a * 3;
+        if (bus_get(&c, rq) != expect) rom_ok = 0;
+    }
+    printf("%s: ROM reads a .bin image with a .hex overlay\n", rom_ok ? "PASS" : "FAIL");
+    failures += !rom_ok;
+
+    /* Records shorter or longer than their byte count are rejected */
+    f = fopen(hex_path, "w");
+    fprintf(f, ":02000000A5\n");
+    fclose(f);
+    int short_ok = !circuit_memory_load(&c, rom, hex_path, 0);
+    f = fopen(hex_path, "w");
+    fprintf(f, ":01000000A55AFF\n");
+    fclose(f);
+    short_ok = short_ok && !circuit_memory_load(&c, rom, hex_path, 0);
+    remove(hex_path);
+    c.error = false;
+    printf("%s: Intel HEX records must match their byte count\n", short_ok ? "PASS" : "FAIL");
+    failures += !short_ok;
+
+    /* X on any address bit reads X */
+    circuit_set_wire(&c, ra, 2, WIRE_X);
+    circuit_propagate(&c);
+    int x_ok = circuit_get_wire(&c, rq, 0) == WIRE_X;
+    printf("%s: unknown address reads X\n", x_ok ? "PASS" : "FAIL");
+    failures += !x_ok;
+
+    /* Word write at the clock edge, then a byte write over its low half */
+    bus_set(&c, wa, 0x10);
+    bus_set(&c, wd, 0xBEEF);
+    circuit_set_wire(&c, we, 0, WIRE_1);
+    circuit_set_wire(&c, bw, 0, WIRE_0);
+    circuit_propagate(&c);
+    int before = bus_get(&c, wq) == 0;
+    circuit_step(&c);
+    int word_ok = before && bus_get(&c, wq) == 0xBEEF;
+    bus_set(&c, wd, 0x1234);
+    circuit_set_wire(&c, bw, 0, WIRE_1);
+    circuit_step(&c);
+    circuit_set_wire(&c, we, 0, WIRE_0);
+    circuit_step(&c);
+    int byte_ok = bus_get(&c, wq) == 0xBE34 &&
+                  circuit_memory_read_word(&c.memories[ram], 0x11) == 0xBE;
+    printf("%s: RAM writes on the clock edge\n", word_ok ? "PASS" : "FAIL");
+    printf("%s: RAM byte write keeps the high byte\n", byte_ok ? "PASS" : "FAIL");
+    failures += !word_ok + !byte_ok;
+
+    printf("\n");
+    return failures;
+}
+
+/* Run a Micro4 program on the gate-level CPU and check it against the emulator */
+int test_micro4_cpu(void) {
+    printf("=== Testing Micro4 CPU netlist ===\n\n");
+    static Circuit c;
+    circuit_init(&c);
+    if (!circuit_load_file(&c, "../../hdl/04_micro4_cpu.m4hdl")) {
+        printf("FAIL: load 04_micro4_cpu.m4hdl (%s)\n\n", c.error_msg);
+        return 1;
+    }
+
+    /*
+     * One nibble per byte:
+     *   00 LDI 3 / DEC / JZ 0C / JMP 02       count down to zero
+     *   0C LDA 40 / XOR 41 / OR 42 / AND 43    9 ^ 5 | 1 & 7 = 5
+     *   1C SHL / NOT / SHR / INC               A, 5, 2, 3
+     *   24 SUB 44 / ADD 45 / STA 46 / HLT      F, 5, [46] = 5
+     */
+    static const uint8_t prog[] = {
+        0x7, 0x3, 0xF, 0x0, 0x6, 0x0, 0x0, 0xC, 0x5, 0x0, 0x0, 0x2,
+        0x1, 0x0, 0x4, 0x0, 0xA, 0x0, 0x4, 0x1, 0x9, 0x0, 0x4, 0x2, 0x8, 0x0, 0x4, 0x3,
+        0xC, 0x0, 0xB, 0x0, 0xD, 0x0, 0xE, 0x0,
+        0x4, 0x0, 0x4, 0x4, 0x3, 0x0, 0x4, 0x5, 0x2, 0x0, 0x4, 0x6, 0x0, 0x0,
+    };
+    static const uint8_t data[] = { 0x9, 0x5, 0x1, 0x7, 0x4, 0x6 };
+    const char *bin_path = "/tmp/m4sim_test_micro4.bin";
+    uint8_t image[0x46] = { 0 };
+    memcpy(image, prog, sizeof(prog));
+    memcpy(image + 0x40, data, sizeof(data));
+    FILE *f = fopen(bin_path, "wb");
+    fwrite(image, 1, sizeof(image), f);
+    fclose(f);
+    int mem = circuit_find_memory(&c, "MEMORY");
+    bool loaded = circuit_memory_load(&c, mem, bin_path, 0);
+    remove(bin_path);
+
+    int pc = circuit_find_wire(&c, "pc"), acc = circuit_find_wire(&c, "acc");
+    int z = circuit_find_wire(&c, "z_flag"), halt = circuit_find_wire(&c, "halt");
+
+    /* Loop: LDI 4 cycles, then DEC + JZ + JMP (16) twice and DEC + JZ taken (10) */
+    circuit_run(&c, 46);
+    int loop_ok = loaded && bus_get(&c, pc) == 0x0C && bus_get(&c, acc) == 0 &&
+                  bus_get(&c, z) == 1;
+    printf("%s: countdown loop exits with PC=0C ACC=0 Z=1 after 46 cycles\n",
+           loop_ok ? "PASS" : "FAIL");
+
+    /* 10 memory-operand or single-byte instructions, then HLT */
+    circuit_run(&c, 69);
+    int run_ok = bus_get(&c, pc) == 0x32 && bus_get(&c, acc) == 0x5 &&
+                 bus_get(&c, z) == 0 && bus_get(&c, halt) == 1 &&
+                 circuit_memory_read_word(&c.memories[mem], 0x46) == 0x5;
+    printf("%s: program halts with PC=32 ACC=5 [46]=5 after 115 cycles\n",
+           run_ok ? "PASS" : "FAIL");
+
+    circuit_run(&c, 20);
+    int held = bus_get(&c, pc) == 0x32 && bus_get(&c, acc) == 0x5 && bus_get(&c, halt) == 1;
+    printf("%s: halted CPU holds its state\n", held ? "PASS" : "FAIL");
+
+    printf("\n");
+    return !loop_ok + !run_ok + !held;
+}
+
+/* Run one timed simulation with random stimulus on every undriven wire */
+static bool timing_run(Circuit *c, const TechModel *tech, int cycles, bool verbose) {
+    TimingSim t;
+    if (!timing_init(&t, c, tech)) {
+        printf("Error: out of memory\n");
+        return false;
+    }
+
+    uint32_t seed = 12345;
+    uint64_t max_settle = 0, sum_settle = 0, evaluations = 0;
+    int glitches = 0, static_hazards = 0, dynamic_hazards = 0;
+    bool oscillating = false;
+
+    clock_t start = clock();
+    for (int n = 0; n < cycles; n++) {
+        for (int w = 0; w < c->num_wires; w++) {
+            if (!timing_is_undriven(&t, w)) continue;
+            for (int b = 0; b < c->wires[w].width; b++) {
+                seed = seed * 1103515245u + 12345u;
+                timing_set_input(&t, w, b, (seed >> 16) & 1 ? WIRE_1 : WIRE_0);
+            }
+        }
+
+        TimingCycle r;
+        timing_cycle(&t, &r);
+        if (r.settle_ticks > max_settle) max_settle = r.settle_ticks;
+        sum_settle += r.settle_ticks;
+        evaluations += r.evaluations;
+        glitches += r.glitches;
+        static_hazards += r.static_hazards;
+        dynamic_hazards += r.dynamic_hazards;
+        if (r.oscillating) {
+            oscillating = true;
+            break;
+        }
+    }
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    double max_ns = timing_ticks_ns(&t, max_settle);
+    double events_per_sec = seconds > 0 ? (double)t.total_events / seconds : 0.0;
+
+    if (verbose) {
+        printf("\n=== Timed Simulation: %s ===\n", tech->name);
+        printf("Cycles:             %d\n", cycles);
+        printf("Settle time:        %.3f ns max, %.3f ns avg\n",
+               max_ns, timing_ticks_ns(&t, sum_settle) / (cycles > 0 ? cycles : 1));
+        printf("Max clock:          %.3f MHz\n", max_ns > 0 ? 1000.0 / max_ns : 0.0);
+        printf("Events:             %lu (%lu gate evaluations)\n",
+               (unsigned long)t.total_events, (unsigned long)evaluations);
+        printf("Glitches:           %d\n", glitches);
+        printf("Hazards:            %d static, %d dynamic\n", static_hazards, dynamic_hazards);
+        printf("Throughput:         %.2f M events/s\n", events_per_sec / 1e6);
+        if (oscillating) {
+            printf("Warning: circuit oscillates (over %d events in one cycle)\n", TIMING_MAX_EVENTS);
+        }
+    } else {
+        char settle_str[32];
+        if (max_ns >= 1e6) {
+            snprintf(settle_str, sizeof(settle_str), "%.2f ms", max_ns / 1e6);
+        } else if (max_ns >= 1e3) {
+            snprintf(settle_str, sizeof(settle_str), "%.2f us", max_ns / 1e3);
+        } else {
+            snprintf(settle_str, sizeof(settle_str), "%.2f ns", max_ns);
+        }
+        printf("%-20s | %-12s | %8d | %8d | %8.2f%s\n", tech->name, settle_str,
+               glitches, static_hazards + dynamic_hazards, events_per_sec / 1e6,
+               oscillating ? " (oscillates)" : "");
+    }
+
+    timing_free(&t);
+    return !oscillating;
+}
+
+/* Timed simulation of an HDL file under one or all technology models */
+int run_timing(const char *file, const char *tech_key, int cycles) {
+    static Circuit c;
+    circuit_init(&c);
+    if (!circuit_load_file(&c, file)) {
+        printf("Error: %s\n", c.error_msg);
+        return 1;
+    }
+    circuit_propagate(&c);
+
+    CircuitTiming static_timing;
+    circuit_analyze_timing(&c, &static_timing);
+    printf("%s: %d gates, critical path %d gate delays\n",
+           file, static_timing.total_gates, static_timing.critical_path_depth);
+
+    if (strcmp(tech_key, "all") == 0) {
+        printf("\n%-20s | %-12s | %8s | %8s | %s\n",
+               "Technology", "Max Settle", "Glitches", "Hazards", "M events/s");
+        printf("---------------------|--------------|----------|----------|-----------\n");
+        for (int i = 0; i < timing_num_techs; i++) {
+            /* Each run starts from the same power-up state */
+            circuit_free(&c);
+            circuit_init(&c);
+            circuit_load_file(&c, file);
+            circuit_propagate(&c);
+            timing_run(&c, &timing_techs[i], cycles, false);
+        }
+        printf("\n");
+        circuit_free(&c);
+        return 0;
+    }
+
+    const TechModel *tech = timing_find_tech(tech_key);
+    if (tech == NULL) {
+        printf("Unknown technology: %s\nAvailable:", tech_key);
+        for (int i = 0; i < timing_num_techs; i++) {
+            printf(" %s", timing_techs[i].key);
+        }
+        printf(" all\n");
+        circuit_free(&c);
+        return 1;
+    }
+    bool ok = timing_run(&c, tech, cycles, true);
+    circuit_free(&c);
+    return ok ? 0 : 1;
+}
+
+/* Load an HDL file, fill its memories from images and clock it */
+int run_program(const char *file, int argc, char *argv[]) {
+    static Circuit c;
+    circuit_init(&c);
+    if (!circuit_load_file(&c, file)) {
+        printf("Error: %s\n", c.error_msg);
+        return 1;
+    }
+
+    int cycles = 100;
+    for (int i = 0; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            cycles = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc) {
+            /* NAME=image[@offset] */
+            char spec[512];
+            strncpy(spec, argv[++i], sizeof(spec) - 1);
+            spec[sizeof(spec) - 1] = '\0';
+            char *image = strchr(spec, '=');
+            if (image == NULL) {
+                printf("Error: expected -l MEMORY=image[@offset]\n");
+                return 1;
+            }
+            *image++ = '\0';
+            uint32_t offset = 0;
+            char *at = strrchr(image, '@');
+            if (at != NULL) {
+                *at = '\0';
+                offset = (uint32_t)strtoul(at + 1, NULL, 0);
+            }
+            int mem = circuit_find_memory(&c, spec);
+            if (mem < 0) {
+                printf("Error: no memory named %s\n", spec);
+                return 1;
+            }
+            if (!circuit_memory_load(&c, mem, image, offset)) {
+                printf("Error: %s\n", c.error_msg);
+                return 1;
+            }
+            printf("Loaded %s into %s at 0x%X\n", image, spec, offset);
+        } else {
+            printf("Unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    circuit_run(&c, cycles);
+    printf("\nState after %d cycles:\n", cycles);
+    circuit_dump_wires(&c);
+    return 0;
+}
+
+/*
+ * Instruction activation index for the web visualizer
+ *
+ * Each phase is forced rather than clocked from power-up, so every opcode
+ * is recorded from the same register values whatever ran before it: the
+ * registers are set to what they hold in that phase of the instruction
+ * (first nibble of a fetch), the logic is propagated, and the nets
+ * that differ from the previous phase (S0 is compared with S4, the end of
+ * the previous instruction) are recorded.
+ *
+ * Little-endian layout:
+ *   "M4AI", u8 version, u8 opcodes, u8 phases, u8 reserved,
+ *   u16 gates, u16 wire bits,
+ *   then per opcode, per phase: gate bitset, wire-bit bitset (u32 words)
+ *
+ * Gates are numbered as in the web circuit JSON, which leaves out RAM/ROM
+ * blocks; wire bits are every wire's bits in wire order.
+ */
+#define ACTIVATION_VERSION  1
+#define ACTIVATION_OPCODES  16
+#define ACTIVATION_PHASES   5       /* FETCH, DECODE, FETCH_ADDR, EXECUTE, WRITEBACK */
+#define ACTIVATION_OPERAND  0x3
+#define ACTIVATION_ACC      0x5
+#define ACTIVATION_PC       0x10
+
+/* Force a register: its flip-flops and every bit of the wire */
+static void force_register(Circuit *c, const char *name, uint32_t v) {
+    int w = circuit_find_wire(c, name);
+    if (w < 0) return;
+    for (int i = 0; i < c->num_gates; i++) {
+        Gate *g = &c->gates[i];
+        if (g->type != GATE_DFF || g->num_outputs < 1 || g->outputs[0] != w) continue;
+        int bit = g->output_bits[0] < 0 ? 0 : g->output_bits[0];
+        g->stored_value = (v >> bit) & 1 ? WIRE_1 : WIRE_0;
+    }
+    bus_set(c, w, v);
+}
+
+static void put_u16(FILE *f, int v) {
+    fputc(v & 0xFF, f);
+    fputc((v >> 8) & 0xFF, f);
+}
+
+static void put_bitset(FILE *f, const uint8_t *bits, int count) {
+    for (int word = 0; word < (count + 31) / 32; word++) {
+        uint32_t v = 0;
+        for (int b = 0; b < 32 && word * 32 + b < count; b++) {
+            if (bits[word * 32 + b]) v |= 1u << b;
+        }
+        for (int k = 0; k < 4; k++) fputc((v >> (k * 8)) & 0xFF, f);
+    }
+}
+
+/* Run every opcode through every phase and write the activation index */
+int export_activation(const char *file, const char *out_file) {
+    static Circuit c;
+    static WireState gate_out[ACTIVATION_PHASES][MAX_GATES];
+    static WireState wire_bit[ACTIVATION_PHASES][MAX_WIRES * 32];
+    static uint8_t gate_set[MAX_GATES], wire_set[MAX_WIRES * 32];
+
+    circuit_init(&c);
+    if (!circuit_load_file(&c, file)) {
+        printf("Error: %s\n", c.error_msg);
+        return 1;
+    }
+
+    /* Web gate numbering skips memory blocks */
+    int gate_count = 0, bit_count = 0;
+    for (int i = 0; i < c.num_gates; i++) {
+        if (c.gates[i].type != GATE_RAM && c.gates[i].type != GATE_ROM) gate_count++;
+    }
+    for (int w = 0; w < c.num_wires; w++) bit_count += c.wires[w].width;
+    if (bit_count > MAX_WIRES * 32) {
+        printf("Error: too many wire bits\n");
+        return 1;
+    }
+
+    FILE *f = fopen(out_file, "wb");
+    if (!f) {
+        printf("Error: cannot open %s for writing\n", out_file);
+        return 1;
+    }
+    fwrite("M4AI", 1, 4, f);
+    fputc(ACTIVATION_VERSION, f);
+    fputc(ACTIVATION_OPCODES, f);
+    fputc(ACTIVATION_PHASES, f);
+    fputc(0, f);
+    put_u16(f, gate_count);
+    put_u16(f, bit_count);
+
+    int total_gates = 0;
+    for (int op = 0; op < ACTIVATION_OPCODES; op++) {
+        for (int phase = 0; phase < ACTIVATION_PHASES; phase++) {
+            force_register(&c, "state", phase);
+            force_register(&c, "nib", 0);
+            force_register(&c, "ir", (op << 4) | ACTIVATION_OPERAND);
+            force_register(&c, "acc", ACTIVATION_ACC);
+            force_register(&c, "z_flag", 0);
+            force_register(&c, "pc", ACTIVATION_PC);
+            /* MAR holds a stale address until the operand is fetched */
+            force_register(&c, "mar", phase < 2 ? ACTIVATION_PC : ACTIVATION_OPERAND);
+            circuit_propagate(&c);
+
+            for (int i = 0; i < c.num_gates; i++) {
+                Gate *g = &c.gates[i];
+                gate_out[phase][i] = g->num_outputs > 0
+                    ? circuit_get_wire(&c, g->outputs[0], g->output_bits[0] < 0 ? 0 : g->output_bits[0])
+                    : WIRE_X;
+            }
+            int n = 0;
+            for (int w = 0; w < c.num_wires; w++) {
+                for (int b = 0; b < c.wires[w].width; b++) wire_bit[phase][n++] = c.wires[w].state[b];
+            }
+        }
+
+        for (int phase = 0; phase < ACTIVATION_PHASES; phase++) {
+            int prev = (phase + ACTIVATION_PHASES - 1) % ACTIVATION_PHASES;
+            int n = 0;
+            for (int i = 0; i < c.num_gates; i++) {
+                if (c.gates[i].type == GATE_RAM || c.gates[i].type == GATE_ROM) continue;
+                gate_set[n] = gate_out[phase][i] != gate_out[prev][i];
+                total_gates += gate_set[n++];
+            }
+            for (int b = 0; b < bit_count; b++) wire_set[b] = wire_bit[phase][b] != wire_bit[prev][b];
+            put_bitset(f, gate_set, gate_count);
+            put_bitset(f, wire_set, bit_count);
+        }
+    }
+
+    long size = ftell(f);
+    fclose(f);
+    printf("Wrote %s: %d opcodes x %d phases, %d gates, %d wire bits, %ld bytes\n",
+           out_file, ACTIVATION_OPCODES, ACTIVATION_PHASES, gate_count, bit_count, size);
+    printf("Average %.1f active gates per phase\n",
+           (double)total_gates / (ACTIVATION_OPCODES * ACTIVATION_PHASES));
+    return 0;
+}
+
 void print_usage(const char *prog) {
     printf("M4HDL Circuit Simulator v1.0\n");
     printf("============================\n\n");
@@ -375,6 +1040,12 @@ void print_usage(const char *prog) {
     printf("  %s test                  Run built-in tests\n", prog);
     printf("  %s visualize [circuit]   Export circuit for web visualizer\n", prog);
     printf("  %s export <out.json>     Export test circuit to JSON\n", prog);
+    printf("  %s timing <file.m4hdl> [tech|all] [cycles]\n", prog);
+    printf("                           Timed simulation: settle time, glitches, hazards\n");
+    printf("  %s run <file.m4hdl> [-l MEM=image[@offset]]... [-n cycles]\n", prog);
+    printf("                           Load .bin/.hex images into RAM/ROM and clock\n");
+    printf("  %s activation <file.m4hdl> <out.bin>\n", prog);
+    printf("                           Per-opcode, per-phase gate activation index\n");
     printf("\n");
     printf("Visualizer:\n");
     printf("  After running 'visualize', open visualizer/index.html in a browser\n");
@@ -489,7 +1160,37 @@ int main(int argc, char *argv[]) {
         test_half_adder();
         test_full_adder();
         test_adder4();
-        return 0;
+        int failures = test_timing();
+        failures += test_switch_level();
+        failures += test_memory();
+        failures += test_micro4_cpu();
+        return failures ? 1 : 0;
+    }
+
+    if (strcmp(argv[1], "timing") == 0) {
+        if (argc < 3) {
+            print_usage(argv[0]);
+            return 1;
+        }
+        const char *tech = argc > 3 ? argv[3] : "ttl";
+        int cycles = argc > 4 ? atoi(argv[4]) : 1000;
+        return run_timing(argv[2], tech, cycles);
+    }
+
+    if (strcmp(argv[1], "run") == 0) {
+        if (argc < 3) {
+            print_usage(argv[0]);
+            return 1;
+        }
+        return run_program(argv[2], argc - 3, argv + 3);
+    }
+
+    if (strcmp(argv[1], "activation") == 0) {
+        if (argc < 4) {
+            print_usage(argv[0]);
+            return 1;
+        }
+        return export_activation(argv[2], argv[3]);
     }
 
     if (strcmp(argv[1], "visualize") == 0) {
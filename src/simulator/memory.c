@@ -0,0 +1,258 @@
+/*
+ * Micro4 Hardware Simulator - RAM/ROM Primitives
+ */
+
+#define _GNU_SOURCE
+#include "circuit.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+
+/* Add a memory block and the gate that evaluates it */
+int circuit_add_memory(Circuit *c, GateType type, const char *name, int addr_wire,
+                       int data_wire, int we_wire, int we_bit, int out_wire) {
+    if (c->num_memories >= MAX_MEMORIES) {
+        c->error = true;
+        snprintf(c->error_msg, sizeof(c->error_msg), "Too many memories (max %d)", MAX_MEMORIES);
+        return -1;
+    }
+    if (addr_wire < 0 || out_wire < 0) {
+        c->error = true;
+        snprintf(c->error_msg, sizeof(c->error_msg), "%s: memory needs addr and out", name);
+        return -1;
+    }
+
+    int addr_bits = c->wires[addr_wire].width;
+    int data_bits = c->wires[out_wire].width;
+    if (addr_bits > MAX_MEM_ADDR_BITS || data_bits > MAX_MEM_DATA_BITS) {
+        c->error = true;
+        snprintf(c->error_msg, sizeof(c->error_msg),
+                 "%s: at most %d address and %d data bits", name,
+                 MAX_MEM_ADDR_BITS, MAX_MEM_DATA_BITS);
+        return -1;
+    }
+
+    int mem_idx = c->num_memories;
+    Memory *m = &c->memories[mem_idx];
+    memset(m, 0, sizeof(Memory));
+    strncpy(m->name, name, MAX_NAME_LEN - 1);
+    m->writable = type == GATE_RAM;
+    m->addr_bits = addr_bits;
+    m->data_bits = data_bits;
+    m->size = 1u << addr_bits;
+    m->bytes = calloc(m->size, 1);
+    if (m->bytes == NULL) {
+        c->error = true;
+        snprintf(c->error_msg, sizeof(c->error_msg), "%s: out of memory", name);
+        return -1;
+    }
+    m->addr_wire = addr_wire;
+    m->data_wire = data_wire;
+    m->out_wire = out_wire;
+    m->we_wire = we_wire;
+    m->we_bit = we_bit;
+    m->byte_wire = -1;
+    m->byte_bit = 0;
+
+    int g = circuit_add_gate(c, type, name);
+    if (g < 0) {
+        free(m->bytes);
+        return -1;
+    }
+    c->num_memories++;
+
+    /* Whole buses are listed with bit -1, for dumps and timing analysis */
+    Gate *gate = &c->gates[g];
+    gate->mem_ref = mem_idx;
+    circuit_gate_add_input(c, g, addr_wire, -1);
+    if (data_wire >= 0) circuit_gate_add_input(c, g, data_wire, -1);
+    if (we_wire >= 0) circuit_gate_add_input(c, g, we_wire, we_bit);
+    circuit_gate_add_output(c, g, out_wire, -1);
+    return g;
+}
+
+int circuit_find_memory(const Circuit *c, const char *name) {
+    for (int i = 0; i < c->num_memories; i++) {
+        if (strcmp(c->memories[i].name, name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+uint32_t circuit_memory_read_word(const Memory *m, uint32_t addr) {
+    uint32_t word = 0;
+    int nbytes = (m->data_bits + 7) / 8;
+    for (int i = 0; i < nbytes; i++) {
+        word |= (uint32_t)m->bytes[(addr + i) & (m->size - 1)] << (8 * i);
+    }
+    return m->data_bits < 32 ? word & ((1u << m->data_bits) - 1) : word;
+}
+
+/* Read a bus as a number; false if any bit is X or Z */
+static bool bus_value(Circuit *c, int wire_idx, uint32_t *value) {
+    Wire *w = &c->wires[wire_idx];
+    uint32_t v = 0;
+    for (int b = 0; b < w->width && b < 32; b++) {
+        if (w->state[b] == WIRE_1) {
+            v |= 1u << b;
+        } else if (w->state[b] != WIRE_0) {
+            return false;
+        }
+    }
+    *value = v;
+    return true;
+}
+
+void circuit_eval_memory(Circuit *c, const Gate *g, WireState *out) {
+    const Memory *m = &c->memories[g->mem_ref];
+    uint32_t addr;
+    if (!bus_value(c, m->addr_wire, &addr)) {
+        for (int b = 0; b < m->data_bits; b++) out[b] = WIRE_X;
+        return;
+    }
+    uint32_t word = circuit_memory_read_word(m, addr);
+    for (int b = 0; b < m->data_bits; b++) {
+        out[b] = (word >> b) & 1 ? WIRE_1 : WIRE_0;
+    }
+}
+
+/* Commit RAM writes at the clock edge */
+void circuit_clock_memories(Circuit *c) {
+    for (int i = 0; i < c->num_memories; i++) {
+        Memory *m = &c->memories[i];
+        if (!m->writable || m->we_wire < 0 || m->data_wire < 0) continue;
+        if (circuit_get_wire(c, m->we_wire, m->we_bit) != WIRE_1) continue;
+
+        uint32_t addr, data;
+        if (!bus_value(c, m->addr_wire, &addr)) continue;
+        if (!bus_value(c, m->data_wire, &data)) data = 0;
+
+        int nbytes = (m->data_bits + 7) / 8;
+        if (m->byte_wire >= 0 && circuit_get_wire(c, m->byte_wire, m->byte_bit) == WIRE_1) {
+            nbytes = 1;
+        }
+        if (m->data_bits < 8) {
+            uint8_t mask = (uint8_t)((1u << m->data_bits) - 1);
+            m->bytes[addr & (m->size - 1)] = (uint8_t)(data & mask);
+            continue;
+        }
+        for (int b = 0; b < nbytes; b++) {
+            m->bytes[(addr + b) & (m->size - 1)] = (uint8_t)(data >> (8 * b));
+        }
+    }
+}
+
+/* === Image Loading === */
+
+static int hex_byte(const char *s) {
+    int v = 0;
+    for (int i = 0; i < 2; i++) {
+        int ch = s[i];
+        v <<= 4;
+        if (ch >= '0' && ch <= '9') v |= ch - '0';
+        else if (ch >= 'A' && ch <= 'F') v |= ch - 'A' + 10;
+        else if (ch >= 'a' && ch <= 'f') v |= ch - 'a' + 10;
+        else return -1;
+    }
+    return v;
+}
+
+/* Intel HEX: data (00), end (01), extended segment (02) and linear (04) */
+static bool load_hex(Circuit *c, Memory *m, FILE *f, uint32_t offset) {
+    char line[600];
+    uint32_t base = 0;
+    int line_no = 0;
+
+    while (fgets(line, sizeof(line), f)) {
+        line_no++;
+        char *p = line;
+        while (isspace((unsigned char)*p)) p++;
+        if (*p == '\0') continue;
+        if (*p != ':') goto bad;
+        p++;
+
+        /* Count, address, type and checksum, then exactly count data bytes */
+        size_t len = strlen(p);
+        while (len > 0 && isspace((unsigned char)p[len - 1])) len--;
+        if (len < 10) goto bad;
+        int count = hex_byte(p);
+        if (count < 0 || len != 10 + 2 * (size_t)count) goto bad;
+        int hi = hex_byte(p + 2), lo = hex_byte(p + 4);
+        int type = hex_byte(p + 6);
+        if (hi < 0 || lo < 0 || type < 0) goto bad;
+        uint8_t sum = (uint8_t)(count + hi + lo + type);
+        uint8_t data[256];
+        for (int i = 0; i <= count; i++) {
+            int v = hex_byte(p + 8 + 2 * i);
+            if (v < 0) goto bad;
+            if (i < count) data[i] = (uint8_t)v;
+            sum += (uint8_t)v;
+        }
+        if (sum != 0) goto bad;
+
+        switch (type) {
+            case 0x00: {
+                uint32_t addr = base + ((uint32_t)hi << 8 | (uint32_t)lo) + offset;
+                for (int i = 0; i < count; i++) {
+                    m->bytes[(addr + i) & (m->size - 1)] = data[i];
+                }
+                break;
+            }
+            case 0x01:
+                return true;
+            case 0x02:
+                if (count != 2) goto bad;
+                base = ((uint32_t)data[0] << 8 | data[1]) << 4;
+                break;
+            case 0x04:
+                if (count != 2) goto bad;
+                base = ((uint32_t)data[0] << 8 | data[1]) << 16;
+                break;
+            default:
+                break;  /* Start address records */
+        }
+    }
+    return true;
+
+bad:
+    c->error = true;
+    snprintf(c->error_msg, sizeof(c->error_msg), "%s: bad Intel HEX record at line %d",
+             m->name, line_no);
+    return false;
+}
+
+bool circuit_memory_load(Circuit *c, int mem_idx, const char *filename, uint32_t offset) {
+    if (mem_idx < 0 || mem_idx >= c->num_memories) {
+        c->error = true;
+        snprintf(c->error_msg, sizeof(c->error_msg), "No such memory");
+        return false;
+    }
+    Memory *m = &c->memories[mem_idx];
+
+    FILE *f = fopen(filename, "rb");
+    if (!f) {
+        c->error = true;
+        snprintf(c->error_msg, sizeof(c->error_msg), "Cannot open file: %s", filename);
+        return false;
+    }
+
+    bool ok = true;
+    const char *ext = strrchr(filename, '.');
+    if (ext && strcasecmp(ext, ".hex") == 0) {
+        ok = load_hex(c, m, f, offset);
+    } else {
+        uint8_t buf[4096];
+        size_t n;
+        uint32_t addr = offset;
+        while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+            for (size_t i = 0; i < n; i++) {
+                m->bytes[addr++ & (m->size - 1)] = buf[i];
+            }
+        }
+    }
+    fclose(f);
+    return ok;
+}
@@ -34,6 +34,8 @@ typedef enum {
     TOK_MUX2,
     TOK_NMOS,
     TOK_PMOS,
+    TOK_RAM,
+    TOK_ROM,
     TOK_LPAREN,
     TOK_RPAREN,
     TOK_LBRACKET,
@@ -132,6 +134,12 @@ static TokenType next_token(Parser *p) {
             p->token_str[i++] = *p->pos++;
         }
         p->token_str[i] = '\0';
+        if (isalnum(*p->pos) || *p->pos == '_') {
+            snprintf(p->error_msg, sizeof(p->error_msg),
+                     "Name longer than %d characters at line %d", MAX_NAME_LEN - 1, p->line);
+            p->token = TOK_ERROR;
+            return p->token;
+        }
 
         /* Check for keywords */
         if (strcasecmp(p->token_str, "wire") == 0) p->token = TOK_WIRE;
@@ -151,6 +159,8 @@ static TokenType next_token(Parser *p) {
         else if (strcasecmp(p->token_str, "mux2") == 0) p->token = TOK_MUX2;
         else if (strcasecmp(p->token_str, "nmos") == 0) p->token = TOK_NMOS;
         else if (strcasecmp(p->token_str, "pmos") == 0) p->token = TOK_PMOS;
+        else if (strcasecmp(p->token_str, "ram") == 0) p->token = TOK_RAM;
+        else if (strcasecmp(p->token_str, "rom") == 0) p->token = TOK_ROM;
         else p->token = TOK_IDENT;
 
         return p->token;
@@ -187,6 +197,10 @@ static bool parse_wire_ref(Parser *p, Circuit *c, int *wire_idx, int *bit) {
     if (*wire_idx < 0) {
         /* Auto-create wire */
         *wire_idx = circuit_add_wire(c, p->token_str, 1);
+        if (*wire_idx < 0) {
+            snprintf(p->error_msg, sizeof(p->error_msg), "%.200s at line %d", c->error_msg, p->line);
+            return false;
+        }
     }
     *bit = 0;
 
@@ -317,6 +331,7 @@ static bool parse_module_port_list(Parser *p, Circuit *c);
 static bool parse_module_body(Parser *p, Circuit *c);
 static bool parse_wire_decl(Parser *p, Circuit *c);
 static bool parse_gate(Parser *p, Circuit *c);
+static bool parse_memory(Parser *p, Circuit *c);
 
 static bool parse_module(Parser *p, Circuit *c) {
     /* module name (input: a b, output: y); ... endmodule */
@@ -564,6 +579,11 @@ static bool parse_module_body(Parser *p, Circuit *c) {
                 if (!parse_gate(p, c)) return false;
                 break;
 
+            case TOK_RAM:
+            case TOK_ROM:
+                if (!parse_memory(p, c)) return false;
+                break;
+
             case TOK_IDENT: {
                 /* Could be a module instantiation */
                 int module_ref = circuit_find_module(c, p->token_str);
@@ -725,6 +745,89 @@ static bool parse_gate(Parser *p, Circuit *c) {
     if (!expect(p, TOK_RPAREN)) return false;
     expect(p, TOK_SEMICOLON);
 
+    /* Transistors: one gate terminal, two channel terminals */
+    if ((type == GATE_NMOS || type == GATE_PMOS) && gate_idx >= 0) {
+        Gate *g = &c->gates[gate_idx];
+        if (g->num_inputs != 1 || g->num_outputs != 2) {
+            snprintf(p->error_msg, sizeof(p->error_msg),
+                     "%s needs (input: gate, output: drain source) at line %d",
+                     name, p->line);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool parse_memory(Parser *p, Circuit *c) {
+    /* ram name (addr: a, data: d, we: w, byte: b, out: q); or rom name (addr: a, out: q); */
+    GateType type = p->token == TOK_RAM ? GATE_RAM : GATE_ROM;
+    next_token(p);
+
+    if (p->token != TOK_IDENT) {
+        snprintf(p->error_msg, sizeof(p->error_msg),
+                 "Expected memory name at line %d", p->line);
+        return false;
+    }
+    char name[MAX_NAME_LEN];
+    strncpy(name, p->token_str, MAX_NAME_LEN - 1);
+    name[MAX_NAME_LEN - 1] = '\0';
+    next_token(p);
+
+    if (!expect(p, TOK_LPAREN)) return false;
+
+    int addr = -1, data = -1, we = -1, we_bit = 0, byte = -1, byte_bit = 0, out = -1;
+    while (p->token == TOK_IDENT) {
+        char port[MAX_NAME_LEN];
+        strncpy(port, p->token_str, MAX_NAME_LEN - 1);
+        port[MAX_NAME_LEN - 1] = '\0';
+        int line = p->line;
+        next_token(p);
+        if (!expect(p, TOK_COLON)) return false;
+
+        int wire_idx, bit;
+        if (!parse_wire_ref(p, c, &wire_idx, &bit)) return false;
+
+        if (strcasecmp(port, "addr") == 0) {
+            addr = wire_idx;
+        } else if (strcasecmp(port, "data") == 0) {
+            data = wire_idx;
+        } else if (strcasecmp(port, "we") == 0) {
+            we = wire_idx;
+            we_bit = bit;
+        } else if (strcasecmp(port, "byte") == 0) {
+            byte = wire_idx;
+            byte_bit = bit;
+        } else if (strcasecmp(port, "out") == 0) {
+            out = wire_idx;
+        } else {
+            snprintf(p->error_msg, sizeof(p->error_msg),
+                     "Unknown memory port '%s' at line %d (addr, data, we, byte, out)",
+                     port, line);
+            return false;
+        }
+
+        if (p->token == TOK_COMMA) {
+            next_token(p);
+        }
+    }
+
+    if (!expect(p, TOK_RPAREN)) return false;
+    expect(p, TOK_SEMICOLON);
+
+    if (addr < 0 || out < 0 || (type == GATE_RAM && (data < 0 || we < 0))) {
+        snprintf(p->error_msg, sizeof(p->error_msg),
+                 "%s needs addr and out ports%s", name,
+                 type == GATE_RAM ? ", plus data and we" : "");
+        return false;
+    }
+    if (circuit_add_memory(c, type, name, addr, data, we, we_bit, out) < 0) {
+        snprintf(p->error_msg, sizeof(p->error_msg), "%s", c->error_msg);
+        return false;
+    }
+    Memory *m = &c->memories[c->num_memories - 1];
+    m->byte_wire = byte;
+    m->byte_bit = byte_bit;
     return true;
 }
 
@@ -768,6 +871,15 @@ bool circuit_parse(Circuit *c, const char *source) {
                 }
                 break;
 
+            case TOK_RAM:
+            case TOK_ROM:
+                if (!parse_memory(&parser, c)) {
+                    c->error = true;
+                    strncpy(c->error_msg, parser.error_msg, sizeof(c->error_msg));
+                    return false;
+                }
+                break;
+
             case TOK_MODULE:
                 if (!parse_module(&parser, c)) {
                     c->error = true;
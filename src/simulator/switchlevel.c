@@ -0,0 +1,413 @@
+/*
+ * Micro4 Hardware Simulator - Switch-Level Transistor Solver
+ */
+
+#include "switchlevel.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define WIRE_GND 0      /* circuit_init() creates gnd and vdd first */
+#define WIRE_VDD 1
+
+static bool valid_ref(const Circuit *c, int wire, int bit) {
+    return wire >= 0 && wire < c->num_wires && bit >= 0 && bit < c->wires[wire].width;
+}
+
+static bool is_transistor(const Circuit *c, const Gate *g) {
+    return (g->type == GATE_NMOS || g->type == GATE_PMOS) &&
+           g->num_inputs >= 1 && g->num_outputs >= 2 &&
+           valid_ref(c, g->inputs[0], g->input_bits[0]) &&
+           valid_ref(c, g->outputs[0], g->output_bits[0]) &&
+           valid_ref(c, g->outputs[1], g->output_bits[1]);
+}
+
+static int find(int *parent, int x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+static uint8_t value_mask(WireState v) {
+    switch (v) {
+        case WIRE_0: return 1;
+        case WIRE_1: return 2;
+        case WIRE_X: return 3;
+        default:     return 0;  /* Z: nothing */
+    }
+}
+
+static WireState mask_value(uint8_t mask) {
+    switch (mask) {
+        case 1:  return WIRE_0;
+        case 2:  return WIRE_1;
+        case 3:  return WIRE_X;
+        default: return WIRE_Z;
+    }
+}
+
+/* === Partitioning === */
+
+SwitchNet *switch_build(Circuit *c) {
+    SwitchNet *sn = calloc(1, sizeof(SwitchNet));
+    if (sn == NULL) return NULL;
+    sn->built_gates = c->num_gates;
+
+    /* Flatten wire bits */
+    int *bit_base = malloc((c->num_wires + 1) * sizeof(int));
+    if (bit_base == NULL) {
+        free(sn);
+        return NULL;
+    }
+    int bits = 0;
+    for (int i = 0; i < c->num_wires; i++) {
+        bit_base[i] = bits;
+        bits += c->wires[i].width;
+    }
+    bit_base[c->num_wires] = bits;
+
+    size_t n = bits > 0 ? (size_t)bits : 1;
+    bool *source = calloc(n, sizeof(bool));
+    int *parent = malloc(n * sizeof(int));
+    int *root_comp = malloc(n * sizeof(int));
+    int *local = malloc(n * sizeof(int));
+    int *stamp = malloc(n * sizeof(int));
+    int *order = NULL;
+    sn->gate_comp = malloc(((size_t)c->num_gates + 1) * sizeof(int));
+    if (!source || !parent || !root_comp || !local || !stamp || !sn->gate_comp) {
+        goto fail;
+    }
+
+    /* Sources: rails, declared inputs, logic-gate outputs */
+    for (int i = 0; i < c->num_wires; i++) {
+        bool src = i == WIRE_GND || i == WIRE_VDD || c->wires[i].is_input;
+        for (int b = 0; b < c->wires[i].width; b++) {
+            source[bit_base[i] + b] = src;
+        }
+    }
+    for (int g = 0; g < c->num_gates; g++) {
+        Gate *gate = &c->gates[g];
+        if (gate->type == GATE_NMOS || gate->type == GATE_PMOS) continue;
+        if (gate->num_outputs < 1) continue;
+        if (gate->type == GATE_RAM || gate->type == GATE_ROM) {
+            int w = c->memories[gate->mem_ref].out_wire;
+            for (int b = 0; b < c->wires[w].width; b++) {
+                source[bit_base[w] + b] = true;
+            }
+            continue;
+        }
+        if (valid_ref(c, gate->outputs[0], gate->output_bits[0])) {
+            source[bit_base[gate->outputs[0]] + gate->output_bits[0]] = true;
+        }
+    }
+
+    /* Union channel terminals that are not sources */
+    for (size_t i = 0; i < n; i++) {
+        parent[i] = (int)i;
+        root_comp[i] = -1;
+        stamp[i] = -1;
+    }
+    int transistors = 0;
+    for (int g = 0; g < c->num_gates; g++) {
+        sn->gate_comp[g] = -1;
+        Gate *gate = &c->gates[g];
+        if (!is_transistor(c, gate)) continue;
+        transistors++;
+        int a = bit_base[gate->outputs[0]] + gate->output_bits[0];
+        int b = bit_base[gate->outputs[1]] + gate->output_bits[1];
+        if (!source[a] && !source[b]) {
+            parent[find(parent, a)] = find(parent, b);
+        }
+    }
+
+    /* One component per root */
+    for (int g = 0; g < c->num_gates; g++) {
+        Gate *gate = &c->gates[g];
+        if (!is_transistor(c, gate)) continue;
+        int a = bit_base[gate->outputs[0]] + gate->output_bits[0];
+        int b = bit_base[gate->outputs[1]] + gate->output_bits[1];
+        int inner = !source[a] ? a : (!source[b] ? b : -1);
+        if (inner < 0) continue;    /* Shorts two sources; nothing to solve */
+        int root = find(parent, inner);
+        if (root_comp[root] < 0) {
+            root_comp[root] = sn->num_comps++;
+        }
+        sn->gate_comp[g] = root_comp[root];
+    }
+
+    sn->comps = calloc((size_t)sn->num_comps + 1, sizeof(SwitchComponent));
+    sn->trans = malloc(((size_t)transistors + 1) * sizeof(SwitchTransistor));
+    sn->nodes = malloc(((size_t)transistors * 2 + 1) * sizeof(SwitchNode));
+    sn->inputs = malloc(((size_t)transistors * 3 + 1) * sizeof(SwitchNode));
+    sn->snapshot = malloc(((size_t)transistors * 3 + 1) * sizeof(WireState));
+    order = malloc(((size_t)transistors + 1) * sizeof(int));
+    if (!sn->comps || !sn->trans || !sn->nodes || !sn->inputs || !sn->snapshot || !order) {
+        goto fail;
+    }
+
+    /* Group transistors by component (counting sort on first_trans) */
+    for (int g = 0; g < c->num_gates; g++) {
+        if (sn->gate_comp[g] >= 0) sn->comps[sn->gate_comp[g]].num_trans++;
+    }
+    for (int k = 0, at = 0; k < sn->num_comps; k++) {
+        sn->comps[k].first_trans = at;
+        at += sn->comps[k].num_trans;
+        sn->comps[k].num_trans = 0;
+    }
+    for (int g = 0; g < c->num_gates; g++) {
+        int k = sn->gate_comp[g];
+        if (k < 0) continue;
+        order[sn->comps[k].first_trans + sn->comps[k].num_trans++] = g;
+    }
+
+    /* Lay components out contiguously: transistors, nodes, inputs */
+    int node_count = 0, input_count = 0;
+    for (int k = 0; k < sn->num_comps; k++) {
+        SwitchComponent *comp = &sn->comps[k];
+        comp->first_node = node_count;
+
+        for (int i = comp->first_trans; i < comp->first_trans + comp->num_trans; i++) {
+            int g = order[i];
+            Gate *gate = &c->gates[g];
+            SwitchTransistor *t = &sn->trans[i];
+            t->gate = g;
+            t->control.wire = gate->inputs[0];
+            t->control.bit = gate->input_bits[0];
+            t->pmos = gate->type == GATE_PMOS;
+            t->mode = SWITCH_NORMAL;
+            if (t->control.wire == WIRE_GND || t->control.wire == WIRE_VDD) {
+                t->mode = SWITCH_WEAK;
+            }
+            for (int j = 0; j < 2; j++) {
+                if (gate->outputs[j] == t->control.wire &&
+                    gate->output_bits[j] == t->control.bit) {
+                    t->mode = SWITCH_LOAD;
+                }
+            }
+        }
+        sn->num_trans += comp->num_trans;
+
+        /* Internal nodes first, then the sources they touch */
+        for (int pass = 0; pass < 2; pass++) {
+            for (int i = comp->first_trans; i < comp->first_trans + comp->num_trans; i++) {
+                Gate *gate = &c->gates[sn->trans[i].gate];
+                for (int j = 0; j < 2; j++) {
+                    int bit = bit_base[gate->outputs[j]] + gate->output_bits[j];
+                    if (source[bit] != (pass == 1)) continue;
+                    if (stamp[bit] != k) {
+                        stamp[bit] = k;
+                        local[bit] = node_count - comp->first_node;
+                        sn->nodes[node_count].wire = gate->outputs[j];
+                        sn->nodes[node_count].bit = gate->output_bits[j];
+                        node_count++;
+                    }
+                    if (j == 0) sn->trans[i].a = local[bit];
+                    else        sn->trans[i].b = local[bit];
+                }
+            }
+            if (pass == 0) comp->num_internal = node_count - comp->first_node;
+        }
+        comp->num_nodes = node_count - comp->first_node;
+        if (comp->num_nodes > sn->max_nodes) sn->max_nodes = comp->num_nodes;
+
+        /* Snapshot: every node plus every control terminal */
+        comp->first_input = input_count;
+        for (int i = 0; i < comp->num_nodes; i++) {
+            sn->inputs[input_count++] = sn->nodes[comp->first_node + i];
+        }
+        for (int i = comp->first_trans; i < comp->first_trans + comp->num_trans; i++) {
+            sn->inputs[input_count++] = sn->trans[i].control;
+        }
+        comp->num_inputs = input_count - comp->first_input;
+    }
+
+    size_t m = sn->max_nodes > 0 ? (size_t)sn->max_nodes : 1;
+    sn->strength = malloc(m);
+    sn->mask = malloc(m);
+    sn->result = malloc(m * sizeof(WireState));
+    sn->first_pass = malloc(m * sizeof(WireState));
+    if (!sn->strength || !sn->mask || !sn->result || !sn->first_pass) {
+        goto fail;
+    }
+
+    free(bit_base);
+    free(source);
+    free(parent);
+    free(root_comp);
+    free(local);
+    free(stamp);
+    free(order);
+    return sn;
+
+fail:
+    free(bit_base);
+    free(source);
+    free(parent);
+    free(root_comp);
+    free(local);
+    free(stamp);
+    free(order);
+    switch_free(sn);
+    return NULL;
+}
+
+void switch_free(SwitchNet *sn) {
+    if (sn == NULL) return;
+    free(sn->nodes);
+    free(sn->trans);
+    free(sn->comps);
+    free(sn->inputs);
+    free(sn->snapshot);
+    free(sn->gate_comp);
+    free(sn->strength);
+    free(sn->mask);
+    free(sn->result);
+    free(sn->first_pass);
+    free(sn);
+}
+
+int switch_component_of(const SwitchNet *sn, int gate_idx) {
+    if (sn == NULL || gate_idx < 0 || gate_idx >= sn->built_gates) return -1;
+    return sn->gate_comp[gate_idx];
+}
+
+/* === Solver === */
+
+/* 1 = on, 0 = off, -1 = gate at X/Z */
+static int conducts(Circuit *c, const SwitchTransistor *t) {
+    if (t->mode == SWITCH_LOAD) return 1;
+    WireState g = circuit_get_wire(c, t->control.wire, t->control.bit);
+    if (g != WIRE_0 && g != WIRE_1) return -1;
+    return (g == WIRE_1) != t->pmos;
+}
+
+/* Spread values at one strength level until nothing changes */
+static void flood(SwitchNet *sn, Circuit *c, const SwitchComponent *comp,
+                  uint8_t level, bool unknown_on) {
+    uint8_t *strength = sn->strength;
+    uint8_t *mask = sn->mask;
+    bool changed;
+
+    do {
+        changed = false;
+        for (int i = comp->first_trans; i < comp->first_trans + comp->num_trans; i++) {
+            const SwitchTransistor *t = &sn->trans[i];
+            int on = conducts(c, t);
+            if (on == 0 || (on < 0 && !unknown_on)) continue;
+            uint8_t cap = t->mode == SWITCH_NORMAL ? STRENGTH_DRIVEN : STRENGTH_WEAK;
+            if (cap < level) continue;
+
+            for (int dir = 0; dir < 2; dir++) {
+                int from = dir ? t->b : t->a;
+                int to = dir ? t->a : t->b;
+                if (to >= comp->num_internal) continue;     /* Sources are fixed */
+                if (strength[from] < level || mask[from] == 0) continue;
+                if (strength[to] > level) continue;
+                if (strength[to] < level) {
+                    strength[to] = level;
+                    mask[to] = mask[from];
+                    changed = true;
+                } else if ((mask[to] | mask[from]) != mask[to]) {
+                    mask[to] |= mask[from];
+                    changed = true;
+                }
+            }
+        }
+    } while (changed);
+}
+
+static void solve_pass(SwitchNet *sn, Circuit *c, const SwitchComponent *comp, bool unknown_on) {
+    const SwitchNode *nodes = &sn->nodes[comp->first_node];
+
+    for (int i = 0; i < comp->num_nodes; i++) {
+        WireState v = circuit_get_wire(c, nodes[i].wire, nodes[i].bit);
+        if (i >= comp->num_internal) {
+            sn->strength[i] = STRENGTH_DRIVEN;
+            sn->mask[i] = value_mask(v);
+        } else {
+            sn->strength[i] = STRENGTH_NONE;
+            sn->mask[i] = 0;
+        }
+    }
+
+    flood(sn, c, comp, STRENGTH_DRIVEN, unknown_on);
+    flood(sn, c, comp, STRENGTH_WEAK, unknown_on);
+
+    /* Undriven nodes keep their charge, shared with floating neighbours */
+    for (int i = 0; i < comp->num_internal; i++) {
+        if (sn->strength[i] == STRENGTH_NONE) {
+            sn->strength[i] = STRENGTH_CHARGE;
+            sn->mask[i] = value_mask(circuit_get_wire(c, nodes[i].wire, nodes[i].bit));
+        }
+    }
+    flood(sn, c, comp, STRENGTH_CHARGE, unknown_on);
+
+    for (int i = 0; i < comp->num_internal; i++) {
+        sn->result[i] = mask_value(sn->mask[i]);
+    }
+}
+
+void switch_solve(SwitchNet *sn, Circuit *c, int comp_idx) {
+    const SwitchComponent *comp = &sn->comps[comp_idx];
+    sn->solves++;
+
+    bool unknown = false;
+    for (int i = comp->first_trans; i < comp->first_trans + comp->num_trans; i++) {
+        if (conducts(c, &sn->trans[i]) < 0) {
+            unknown = true;
+            break;
+        }
+    }
+
+    solve_pass(sn, c, comp, false);
+    if (!unknown) return;
+
+    /* A gate at X might be either: nodes that depend on it become X */
+    memcpy(sn->first_pass, sn->result, comp->num_internal * sizeof(WireState));
+    solve_pass(sn, c, comp, true);
+    for (int i = 0; i < comp->num_internal; i++) {
+        if (sn->result[i] != sn->first_pass[i]) {
+            sn->result[i] = WIRE_X;
+        }
+    }
+}
+
+void switch_result(const SwitchNet *sn, int comp, int i, int *wire, int *bit, WireState *value) {
+    const SwitchNode *node = &sn->nodes[sn->comps[comp].first_node + i];
+    *wire = node->wire;
+    *bit = node->bit;
+    *value = sn->result[i];
+}
+
+void switch_propagate(SwitchNet *sn, Circuit *c) {
+    for (int k = 0; k < sn->num_comps; k++) {
+        SwitchComponent *comp = &sn->comps[k];
+
+        /* Skip components whose nodes and gates are unchanged */
+        bool changed = !comp->solved;
+        for (int i = 0; i < comp->num_inputs; i++) {
+            const SwitchNode *in = &sn->inputs[comp->first_input + i];
+            WireState v = circuit_get_wire(c, in->wire, in->bit);
+            if (sn->snapshot[comp->first_input + i] != v) {
+                sn->snapshot[comp->first_input + i] = v;
+                changed = true;
+            }
+        }
+        if (!changed) {
+            sn->skips++;
+            continue;
+        }
+        comp->solved = true;
+
+        switch_solve(sn, c, k);
+        for (int i = 0; i < comp->num_internal; i++) {
+            const SwitchNode *node = &sn->nodes[comp->first_node + i];
+            Wire *w = &c->wires[node->wire];
+            if (w->state[node->bit] != sn->result[i]) {
+                c->stable = false;
+            }
+            w->next_state[node->bit] = sn->result[i];
+        }
+    }
+}
@@ -0,0 +1,99 @@
+/*
+ * Micro4 Hardware Simulator - Switch-Level Transistor Solver
+ *
+ * NMOS and PMOS gates are bidirectional switches, so they cannot be
+ * evaluated one at a time like logic gates. Instead:
+ * - At load time transistors are partitioned into channel-connected
+ *   components (CCCs): sets of nodes joined through source/drain
+ *   terminals, cut at gnd/vdd, declared inputs and logic-gate outputs
+ * - Each component is solved as a whole with strength rules: driven
+ *   nodes (rails, inputs, gate outputs) beat weak loads, which beat
+ *   stored charge; equal-strength disagreement resolves to X
+ * - A transistor whose gate is tied to its own channel (depletion load)
+ *   is always on and weak; one whose gate is tied to a rail is weak
+ *   (pseudo-NMOS pull-up); a gate at X is tried both on and off
+ * - Components are only re-solved when a node or gate input changed
+ *
+ * Connections: nmos NAME (input: gate, output: drain source);
+ */
+
+#ifndef SWITCHLEVEL_H
+#define SWITCHLEVEL_H
+
+#include "circuit.h"
+
+/* Node strengths, weakest first */
+typedef enum {
+    STRENGTH_NONE = 0,
+    STRENGTH_CHARGE,    /* Floating node keeps its last value */
+    STRENGTH_WEAK,      /* Through a load transistor */
+    STRENGTH_DRIVEN     /* Rail, input or logic-gate output */
+} SwitchStrength;
+
+typedef enum {
+    SWITCH_NORMAL = 0,
+    SWITCH_LOAD,        /* Gate tied to channel: always on, weak */
+    SWITCH_WEAK         /* Gate tied to a rail: weak */
+} SwitchMode;
+
+typedef struct {
+    int wire, bit;
+} SwitchNode;
+
+typedef struct {
+    int gate;           /* Gate index */
+    SwitchNode control; /* Gate terminal */
+    int a, b;           /* Channel terminals (component-local node indices) */
+    bool pmos;
+    SwitchMode mode;
+} SwitchTransistor;
+
+typedef struct {
+    int first_node;     /* Internal nodes first, then boundary sources */
+    int num_internal;
+    int num_nodes;
+    int first_trans, num_trans;
+    int first_input, num_inputs;    /* Snapshot of everything the solution reads */
+    bool solved;
+} SwitchComponent;
+
+typedef struct SwitchNet {
+    int built_gates;    /* Gate count the partition was built for */
+
+    SwitchNode *nodes;
+    SwitchTransistor *trans;
+    SwitchComponent *comps;
+    int num_comps;
+    int num_trans;
+
+    SwitchNode *inputs;
+    WireState *snapshot;
+    int *gate_comp;     /* Per gate: component, or -1 */
+
+    /* Solver scratch, sized for the largest component */
+    int max_nodes;
+    uint8_t *strength;
+    uint8_t *mask;      /* Values reaching a node: bit 0 = 0, bit 1 = 1 */
+    WireState *result;
+    WireState *first_pass;
+
+    /* Statistics */
+    uint64_t solves;
+    uint64_t skips;
+} SwitchNet;
+
+/* Partition the circuit's transistors; NULL on allocation failure */
+SwitchNet *switch_build(Circuit *c);
+void switch_free(SwitchNet *sn);
+
+/* Component a transistor belongs to, or -1 */
+int switch_component_of(const SwitchNet *sn, int gate_idx);
+
+/* Solve one component from the current wire states; results by internal node */
+void switch_solve(SwitchNet *sn, Circuit *c, int comp);
+void switch_result(const SwitchNet *sn, int comp, int i, int *wire, int *bit, WireState *value);
+
+/* Re-solve changed components and write their nodes to next_state */
+void switch_propagate(SwitchNet *sn, Circuit *c);
+
+#endif /* SWITCHLEVEL_H */
@@ -0,0 +1,520 @@
+/*
+ * Micro4 Hardware Simulator - Timed Event-Driven Simulation
+ */
+
+#include "timing.h"
+#include "switchlevel.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NO_EVENT UINT32_MAX
+
+/* === Technology Models === */
+
+/*
+ * Gate delays in ticks (tenths of an inverter delay), in GateType order:
+ * NOT AND OR NAND NOR XOR XNOR BUF MUX2 DFF DLATCH RAM ROM NMOS PMOS CONST MODULE
+ * (RAM/ROM: address-to-data access time)
+ */
+
+/* Relays and tubes: each gate is one coil or grid switching */
+static const uint8_t switch_delays[GATE_MODULE + 1] = {
+    10, 10, 10, 10, 10, 20, 20, 10, 10, 20, 10, 20, 20, 10, 10, 1, 1
+};
+
+/* Bipolar logic: NAND/NOR are the native stage, AND/OR add a stage */
+static const uint8_t bipolar_delays[GATE_MODULE + 1] = {
+    10, 15, 15, 10, 10, 25, 25, 15, 20, 30, 20, 40, 40, 5, 5, 1, 1
+};
+
+/* MOS: series PMOS makes NOR slower than NAND */
+static const uint8_t mos_delays[GATE_MODULE + 1] = {
+    10, 20, 20, 10, 12, 30, 30, 20, 20, 30, 20, 40, 40, 5, 5, 1, 1
+};
+
+const TechModel timing_techs[] = {
+    {"relay",   "Relay (1940s)",       10000000.0, switch_delays},  /* 10 ms */
+    {"tube",    "Vacuum Tube (1950s)", 100000.0,   switch_delays},  /* 100 us */
+    {"rtl",     "RTL (1960s)",         50.0,       bipolar_delays}, /* 50 ns */
+    {"dtl",     "DTL (1965)",          30.0,       bipolar_delays}, /* 30 ns */
+    {"ttl",     "TTL (1970s)",         10.0,       bipolar_delays}, /* 10 ns */
+    {"nmos",    "NMOS (1980s)",        5.0,        mos_delays},     /* 5 ns */
+    {"cmos",    "CMOS 1um (1985)",     2.0,        mos_delays},     /* 2 ns */
+    {"cmos350", "CMOS 350nm (1995)",   0.5,        mos_delays},     /* 0.5 ns */
+    {"cmos65",  "CMOS 65nm (2005)",    0.1,        mos_delays},     /* 100 ps */
+    {"cmos7",   "CMOS 7nm (2020)",     0.01,       mos_delays},     /* 10 ps */
+};
+const int timing_num_techs = sizeof(timing_techs) / sizeof(timing_techs[0]);
+
+const TechModel *timing_find_tech(const char *key) {
+    for (int i = 0; i < timing_num_techs; i++) {
+        if (strcmp(timing_techs[i].key, key) == 0) {
+            return &timing_techs[i];
+        }
+    }
+    return NULL;
+}
+
+double timing_ticks_ns(const TimingSim *t, uint64_t ticks) {
+    return (double)ticks * t->tech->gate_delay_ns / 10.0;
+}
+
+/* === Timing Wheel === */
+
+static uint32_t event_alloc(TimingSim *t) {
+    if (t->free_list == NO_EVENT) {
+        uint32_t old = t->pool_size;
+        uint32_t size = old ? old * 2 : 1024;
+        TimingEvent *grown = realloc(t->events, size * sizeof(TimingEvent));
+        if (grown == NULL) return NO_EVENT;
+        t->events = grown;
+        t->pool_size = size;
+        for (uint32_t i = old; i < size; i++) {
+            t->events[i].next = i + 1 < size ? i + 1 : NO_EVENT;
+        }
+        t->free_list = old;
+    }
+    uint32_t e = t->free_list;
+    t->free_list = t->events[e].next;
+    return e;
+}
+
+static void event_free(TimingSim *t, uint32_t e) {
+    t->events[e].next = t->free_list;
+    t->free_list = e;
+}
+
+/* File an event under the highest byte in which its time differs from now */
+static void wheel_insert(TimingSim *t, uint32_t e) {
+    uint64_t diff = t->events[e].time ^ t->now;
+    int level = 0;
+    while (level < TIMING_WHEEL_LEVELS - 1 && diff >= (1ull << (8 * (level + 1)))) {
+        level++;
+    }
+    int slot = (int)((t->events[e].time >> (8 * level)) & (TIMING_WHEEL_SLOTS - 1));
+
+    t->events[e].next = NO_EVENT;
+    if (t->head[level][slot] == NO_EVENT) {
+        t->head[level][slot] = e;
+    } else {
+        t->events[t->tail[level][slot]].next = e;
+    }
+    t->tail[level][slot] = e;
+    t->level_count[level]++;
+    if (level == 0) {
+        t->occupied[slot >> 6] |= 1ull << (slot & 63);
+    }
+}
+
+static bool schedule(TimingSim *t, uint64_t time, int bit, WireState value) {
+    uint32_t e = event_alloc(t);
+    if (e == NO_EVENT) return false;
+    t->events[e].time = time;
+    t->events[e].bit = (uint32_t)bit;
+    t->events[e].value = value;
+    wheel_insert(t, e);
+    t->pending++;
+    return true;
+}
+
+/* Move one higher-level slot down now that its block has come up */
+static void cascade(TimingSim *t, int level) {
+    int slot = (int)((t->now >> (8 * level)) & (TIMING_WHEEL_SLOTS - 1));
+    uint32_t e = t->head[level][slot];
+    t->head[level][slot] = NO_EVENT;
+    while (e != NO_EVENT) {
+        uint32_t next = t->events[e].next;
+        t->level_count[level]--;
+        wheel_insert(t, e);
+        e = next;
+    }
+}
+
+/* Advance now to the next occupied level-0 slot, skipping empty blocks */
+static void wheel_advance(TimingSim *t) {
+    int cur = (int)(t->now & (TIMING_WHEEL_SLOTS - 1));
+
+    /* Level-0 events are always in the current 256-tick block, after now */
+    for (int w = (cur + 1) >> 6; w < TIMING_WHEEL_SLOTS / 64; w++) {
+        uint64_t bits = t->occupied[w];
+        if (w == (cur + 1) >> 6) {
+            bits &= ~0ull << ((cur + 1) & 63);
+        }
+        if (bits) {
+            int slot = w * 64 + __builtin_ctzll(bits);
+            t->now = (t->now & ~(uint64_t)(TIMING_WHEEL_SLOTS - 1)) | (uint64_t)slot;
+            return;
+        }
+    }
+
+    /* Jump to the start of the next block of the lowest non-empty level */
+    int empty = 1;
+    while (empty < TIMING_WHEEL_LEVELS - 1 && t->level_count[empty] == 0) {
+        empty++;
+    }
+    uint64_t mask = (1ull << (8 * empty)) - 1;
+    t->now = (t->now | mask) + 1;
+
+    for (int level = TIMING_WHEEL_LEVELS - 1; level >= 1; level--) {
+        if ((t->now & ((1ull << (8 * level)) - 1)) == 0) {
+            cascade(t, level);
+        }
+    }
+    if (!(t->occupied[0] & 1)) {
+        wheel_advance(t);
+    }
+}
+
+/* === Event Processing === */
+
+static inline WireState *bit_state(TimingSim *t, int bit) {
+    Wire *w = &t->c->wires[t->bit_wire[bit]];
+    return &w->state[bit - t->bit_base[t->bit_wire[bit]]];
+}
+
+/* Flattened index of a wire bit, or -1 if the reference is out of range */
+static inline int flat_bit(const TimingSim *t, int wire_idx, int bit) {
+    if (wire_idx < 0 || wire_idx >= t->c->num_wires) return -1;
+    if (bit < 0 || bit >= t->c->wires[wire_idx].width) return -1;
+    return t->bit_base[wire_idx] + bit;
+}
+
+static inline bool is_switch(const Gate *g) {
+    return (g->type == GATE_NMOS || g->type == GATE_PMOS) && g->num_outputs >= 2;
+}
+
+static inline bool is_memory(const Gate *g) {
+    return g->type == GATE_RAM || g->type == GATE_ROM;
+}
+
+static inline int gate_delay(const TimingSim *t, const Gate *g) {
+    int d = t->tech->type_delay[g->type];
+    return d > 0 ? d : 1;
+}
+
+/* Re-solve a transistor's component and schedule the nodes that move */
+static void evaluate_switch(TimingSim *t, int gate_idx) {
+    SwitchNet *sn = t->c->switch_net;
+    int k = switch_component_of(sn, gate_idx);
+    if (k < 0 || t->comp_solved_at[k] == t->applied) return;
+    t->comp_solved_at[k] = t->applied;
+
+    switch_solve(sn, t->c, k);
+    t->cycle.evaluations++;
+    uint64_t when = t->now + (uint64_t)gate_delay(t, &t->c->gates[gate_idx]);
+    for (int i = 0; i < sn->comps[k].num_internal; i++) {
+        int wire, bit;
+        WireState v;
+        switch_result(sn, k, i, &wire, &bit, &v);
+        int b = flat_bit(t, wire, bit);
+        if (b < 0 || t->bit_projected[b] == v) continue;
+        t->bit_projected[b] = v;
+        schedule(t, when, b, v);
+    }
+}
+
+/* Read a memory word and schedule the out bits that move */
+static void evaluate_memory(TimingSim *t, int gate_idx) {
+    Gate *g = &t->c->gates[gate_idx];
+    WireState word[MAX_MEM_DATA_BITS];
+    circuit_eval_memory(t->c, g, word);
+    t->cycle.evaluations++;
+
+    uint64_t when = t->now + (uint64_t)gate_delay(t, g);
+    for (int i = 0; i < t->c->wires[g->outputs[0]].width; i++) {
+        int b = t->bit_base[g->outputs[0]] + i;
+        if (t->bit_projected[b] == word[i]) continue;
+        t->bit_projected[b] = word[i];
+        schedule(t, when, b, word[i]);
+    }
+}
+
+/* Re-evaluate a gate and schedule its output if the projection changes */
+static void evaluate(TimingSim *t, int gate_idx) {
+    Gate *g = &t->c->gates[gate_idx];
+    if (g->type == GATE_NMOS || g->type == GATE_PMOS) {
+        evaluate_switch(t, gate_idx);
+        return;
+    }
+    if (is_memory(g)) {
+        evaluate_memory(t, gate_idx);
+        return;
+    }
+    if (g->num_outputs < 1) return;
+
+    WireState v = circuit_eval_gate(t->c, g);
+    t->cycle.evaluations++;
+    if (v == t->projected[gate_idx]) return;
+
+    t->projected[gate_idx] = v;
+    int bit = flat_bit(t, g->outputs[0], g->output_bits[0]);
+    if (bit < 0) return;
+    schedule(t, t->now + (uint64_t)gate_delay(t, g), bit, v);
+}
+
+/* Record a 0/1 transition for glitch and hazard accounting */
+static void note_transition(TimingSim *t, int bit, WireState old) {
+    if (t->toggles[bit] == 0) {
+        t->cycle_start_value[bit] = old;
+        t->touched[t->num_touched++] = bit;
+    } else {
+        int g = t->driver[bit];
+        uint64_t width = t->now - t->last_change[bit];
+        if (g >= 0 && width < (uint64_t)gate_delay(t, &t->c->gates[g])) {
+            t->cycle.glitches++;
+        }
+    }
+    if (t->toggles[bit] < UINT16_MAX) t->toggles[bit]++;
+    t->last_change[bit] = t->now;
+}
+
+static void apply(TimingSim *t, const TimingEvent *ev) {
+    int bit = (int)ev->bit;
+    WireState *state = bit_state(t, bit);
+    if (*state == ev->value) return;
+
+    WireState old = *state;
+    t->applied++;
+    Wire *w = &t->c->wires[t->bit_wire[bit]];
+    *state = ev->value;
+    w->next_state[bit - t->bit_base[t->bit_wire[bit]]] = ev->value;
+
+    if (old <= WIRE_1 && ev->value <= WIRE_1) {
+        note_transition(t, bit, old);
+    }
+    if (t->now - t->cycle_start > t->cycle.settle_ticks) {
+        t->cycle.settle_ticks = t->now - t->cycle_start;
+    }
+
+    for (int i = t->fanout_start[bit]; i < t->fanout_start[bit + 1]; i++) {
+        evaluate(t, t->fanout[i]);
+    }
+}
+
+static void finish_cycle(TimingSim *t, TimingCycle *result) {
+    for (int i = 0; i < t->num_touched; i++) {
+        int bit = t->touched[i];
+        if (t->toggles[bit] >= 2) {
+            if (*bit_state(t, bit) == t->cycle_start_value[bit]) {
+                t->cycle.static_hazards++;
+            } else {
+                t->cycle.dynamic_hazards++;
+            }
+        }
+        t->toggles[bit] = 0;
+    }
+    t->num_touched = 0;
+    t->total_events += t->cycle.events;
+    if (result) *result = t->cycle;
+}
+
+void timing_settle(TimingSim *t, TimingCycle *result) {
+    while (t->pending > 0 && !t->cycle.oscillating) {
+        int slot = (int)(t->now & (TIMING_WHEEL_SLOTS - 1));
+        uint32_t e = t->head[0][slot];
+        t->head[0][slot] = NO_EVENT;
+        t->occupied[slot >> 6] &= ~(1ull << (slot & 63));
+
+        /* New events are always later than now, so never land here */
+        while (e != NO_EVENT) {
+            uint32_t next = t->events[e].next;
+            t->level_count[0]--;
+            t->pending--;
+            t->cycle.events++;
+            apply(t, &t->events[e]);
+            event_free(t, e);
+            e = next;
+        }
+
+        if (t->cycle.events >= TIMING_MAX_EVENTS) {
+            t->cycle.oscillating = true;
+            break;
+        }
+        if (t->pending > 0) {
+            wheel_advance(t);
+        }
+    }
+    finish_cycle(t, result);
+    memset(&t->cycle, 0, sizeof(t->cycle));
+    t->cycle_start = t->now;
+}
+
+/* === Public API === */
+
+bool timing_init(TimingSim *t, Circuit *c, const TechModel *tech) {
+    memset(t, 0, sizeof(*t));
+    t->c = c;
+    t->tech = tech;
+    t->free_list = NO_EVENT;
+    for (int l = 0; l < TIMING_WHEEL_LEVELS; l++) {
+        for (int s = 0; s < TIMING_WHEEL_SLOTS; s++) {
+            t->head[l][s] = NO_EVENT;
+        }
+    }
+
+    /* Flatten wire bits */
+    t->bit_base = malloc((c->num_wires + 1) * sizeof(int));
+    if (t->bit_base == NULL) return false;
+    int bits = 0;
+    for (int i = 0; i < c->num_wires; i++) {
+        t->bit_base[i] = bits;
+        bits += c->wires[i].width;
+    }
+    t->bit_base[c->num_wires] = bits;
+    t->num_bits = bits;
+
+    size_t n = bits > 0 ? (size_t)bits : 1;
+    t->bit_wire = malloc(n * sizeof(int));
+    t->fanout_start = calloc(n + 1, sizeof(int));
+    t->driver = malloc(n * sizeof(int));
+    t->last_change = calloc(n, sizeof(uint64_t));
+    t->toggles = calloc(n, sizeof(uint16_t));
+    t->cycle_start_value = calloc(n, sizeof(WireState));
+    t->touched = malloc(n * sizeof(int));
+    t->projected = malloc((c->num_gates + 1) * sizeof(WireState));
+    t->bit_projected = malloc(n * sizeof(WireState));
+    if (!t->bit_projected || !t->bit_wire || !t->fanout_start || !t->driver || !t->last_change ||
+        !t->toggles || !t->cycle_start_value || !t->touched || !t->projected) {
+        timing_free(t);
+        return false;
+    }
+
+    for (int i = 0; i < c->num_wires; i++) {
+        for (int b = 0; b < c->wires[i].width; b++) {
+            t->bit_wire[t->bit_base[i] + b] = i;
+        }
+    }
+    for (int b = 0; b < bits; b++) {
+        t->driver[b] = -1;
+        t->bit_projected[b] = *bit_state(t, b);
+    }
+    if (c->switch_net) {
+        t->comp_solved_at = malloc(((size_t)c->switch_net->num_comps + 1) * sizeof(uint64_t));
+        if (t->comp_solved_at == NULL) {
+            timing_free(t);
+            return false;
+        }
+        for (int k = 0; k < c->switch_net->num_comps; k++) {
+            t->comp_solved_at[k] = UINT64_MAX;
+        }
+    }
+
+    /* Fanout index (CSR): count, prefix-sum, fill */
+    for (int g = 0; g < c->num_gates; g++) {
+        Gate *gate = &c->gates[g];
+        for (int j = 0; j < gate->num_inputs; j++) {
+            int b = flat_bit(t, gate->inputs[j], gate->input_bits[j]);
+            if (b >= 0) t->fanout_start[b + 1]++;
+        }
+        /* Memories read every address bit and drive the whole out bus */
+        if (is_memory(gate)) {
+            const Memory *m = &c->memories[gate->mem_ref];
+            for (int b = t->bit_base[m->addr_wire]; b < t->bit_base[m->addr_wire + 1]; b++) {
+                t->fanout_start[b + 1]++;
+            }
+            for (int b = t->bit_base[m->out_wire]; b < t->bit_base[m->out_wire + 1]; b++) {
+                t->driver[b] = g;
+            }
+            t->projected[g] = WIRE_X;
+            continue;
+        }
+        /* Transistors also react to their channel terminals */
+        if (is_switch(gate)) {
+            for (int j = 0; j < 2; j++) {
+                int b = flat_bit(t, gate->outputs[j], gate->output_bits[j]);
+                if (b < 0) continue;
+                t->fanout_start[b + 1]++;
+                if (t->driver[b] < 0) t->driver[b] = g;
+            }
+            t->projected[g] = WIRE_X;
+            continue;
+        }
+        t->projected[g] = WIRE_X;
+        if (gate->num_outputs >= 1) {
+            int b = flat_bit(t, gate->outputs[0], gate->output_bits[0]);
+            if (b >= 0) t->driver[b] = g;
+            t->projected[g] = circuit_get_wire(c, gate->outputs[0], gate->output_bits[0]);
+        }
+    }
+    for (int b = 0; b < bits; b++) {
+        t->fanout_start[b + 1] += t->fanout_start[b];
+    }
+    t->fanout = malloc(((size_t)t->fanout_start[bits] + 1) * sizeof(int));
+    if (t->fanout == NULL) {
+        timing_free(t);
+        return false;
+    }
+    int *fill = calloc(n, sizeof(int));
+    if (fill == NULL) {
+        timing_free(t);
+        return false;
+    }
+    for (int g = 0; g < c->num_gates; g++) {
+        Gate *gate = &c->gates[g];
+        for (int j = 0; j < gate->num_inputs; j++) {
+            int b = flat_bit(t, gate->inputs[j], gate->input_bits[j]);
+            if (b >= 0) t->fanout[t->fanout_start[b] + fill[b]++] = g;
+        }
+        if (is_switch(gate)) {
+            for (int j = 0; j < 2; j++) {
+                int b = flat_bit(t, gate->outputs[j], gate->output_bits[j]);
+                if (b >= 0) t->fanout[t->fanout_start[b] + fill[b]++] = g;
+            }
+        }
+        if (is_memory(gate)) {
+            const Memory *m = &c->memories[gate->mem_ref];
+            for (int b = t->bit_base[m->addr_wire]; b < t->bit_base[m->addr_wire + 1]; b++) {
+                t->fanout[t->fanout_start[b] + fill[b]++] = g;
+            }
+        }
+    }
+    free(fill);
+    return true;
+}
+
+void timing_free(TimingSim *t) {
+    free(t->events);
+    free(t->bit_base);
+    free(t->bit_wire);
+    free(t->fanout_start);
+    free(t->fanout);
+    free(t->driver);
+    free(t->projected);
+    free(t->bit_projected);
+    free(t->comp_solved_at);
+    free(t->last_change);
+    free(t->toggles);
+    free(t->cycle_start_value);
+    free(t->touched);
+    memset(t, 0, sizeof(*t));
+}
+
+bool timing_is_undriven(const TimingSim *t, int wire_idx) {
+    if (wire_idx < 2) return false;     /* gnd and vdd */
+    for (int b = t->bit_base[wire_idx]; b < t->bit_base[wire_idx + 1]; b++) {
+        if (t->driver[b] >= 0) return false;
+    }
+    return true;
+}
+
+void timing_set_input(TimingSim *t, int wire_idx, int bit, WireState value) {
+    int b = flat_bit(t, wire_idx, bit);
+    if (b < 0 || t->bit_projected[b] == value) return;
+    t->bit_projected[b] = value;
+    schedule(t, t->now, b, value);
+}
+
+void timing_cycle(TimingSim *t, TimingCycle *result) {
+    Circuit *c = t->c;
+
+    /* Clock edge: every DFF captures D, Q follows after clock-to-Q;
+       RAM writes land and the read port is re-evaluated */
+    circuit_clock(c);
+    for (int g = 0; g < c->num_gates; g++) {
+        if (c->gates[g].type == GATE_DFF || c->gates[g].type == GATE_RAM) {
+            evaluate(t, g);
+        }
+    }
+    timing_settle(t, result);
+}
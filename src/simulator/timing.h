@@ -0,0 +1,129 @@
+/*
+ * Micro4 Hardware Simulator - Timed Event-Driven Simulation
+ *
+ * The default simulator is zero-delay: circuit_propagate() iterates until
+ * nothing changes, and circuit_analyze_timing() only counts gate levels.
+ * This mode gives every gate a real propagation delay and replays the
+ * circuit as a stream of timed wire events:
+ * - Delays come from a technology model (relay, tube, RTL, DTL, TTL,
+ *   NMOS, CMOS) times a per-gate-type factor; one tick is a tenth of the
+ *   technology's inverter delay
+ * - Pending events sit in a hierarchical timing wheel (4 levels of 256
+ *   slots), so scheduling and retiring an event is O(1)
+ * - Gates are only re-evaluated when one of their input bits changes
+ *   (fanout index per wire bit); outputs use transport delay
+ * - Transistors are solved per channel-connected component (see
+ *   switchlevel.h) and their nodes change after the transistor delay
+ * - Every cycle reports its settle time and flags glitches (pulses
+ *   narrower than the driving gate's delay) and static/dynamic hazards
+ *   (a net that toggles more than once before settling)
+ */
+
+#ifndef TIMING_H
+#define TIMING_H
+
+#include "circuit.h"
+
+#define TIMING_WHEEL_LEVELS     4
+#define TIMING_WHEEL_SLOTS      256
+#define TIMING_MAX_EVENTS       1000000     /* Per cycle; more means it oscillates */
+
+/* Technology model */
+typedef struct {
+    const char *key;            /* Command-line name */
+    const char *name;           /* Display name */
+    double gate_delay_ns;       /* One inverter delay */
+    const uint8_t *type_delay;  /* Per GateType, in ticks (tenths of gate_delay_ns) */
+} TechModel;
+
+extern const TechModel timing_techs[];
+extern const int timing_num_techs;
+
+const TechModel *timing_find_tech(const char *key);     /* NULL if unknown */
+
+/* Result of one clock cycle */
+typedef struct {
+    uint64_t settle_ticks;      /* Last change minus cycle start */
+    uint64_t events;            /* Events retired */
+    uint64_t evaluations;       /* Gate evaluations */
+    int glitches;
+    int static_hazards;         /* Toggled and came back */
+    int dynamic_hazards;        /* Toggled three or more times to a new value */
+    bool oscillating;           /* Hit TIMING_MAX_EVENTS */
+} TimingCycle;
+
+/* Pending wire-bit change */
+typedef struct {
+    uint64_t time;
+    uint32_t next;
+    uint32_t bit;               /* Flattened wire bit */
+    WireState value;
+} TimingEvent;
+
+typedef struct {
+    Circuit *c;
+    const TechModel *tech;
+    uint64_t now;               /* Ticks */
+    uint64_t cycle_start;
+
+    /* Timing wheel: FIFO lists of event indices per slot */
+    uint32_t head[TIMING_WHEEL_LEVELS][TIMING_WHEEL_SLOTS];
+    uint32_t tail[TIMING_WHEEL_LEVELS][TIMING_WHEEL_SLOTS];
+    uint32_t level_count[TIMING_WHEEL_LEVELS];
+    uint64_t occupied[TIMING_WHEEL_SLOTS / 64];     /* Level 0 bitmap */
+    uint32_t pending;
+
+    /* Event pool */
+    TimingEvent *events;
+    uint32_t pool_size;
+    uint32_t free_list;
+
+    /* Flattened wire bits */
+    int num_bits;
+    int *bit_base;              /* Per wire: first flattened bit */
+    int *bit_wire;              /* Per bit: owning wire */
+    int *fanout_start;          /* CSR: gates reading bit b are */
+    int *fanout;                /* fanout[fanout_start[b] .. fanout_start[b+1]) */
+    int *driver;                /* Per bit: driving gate or -1 */
+
+    /* Per gate: output value already scheduled */
+    WireState *projected;
+
+    /* Value already scheduled per bit (switch-level nodes, memory outputs
+       and inputs), and the event each component was last solved for */
+    WireState *bit_projected;
+    uint64_t *comp_solved_at;
+    uint64_t applied;
+
+    /* Per-cycle hazard tracking */
+    uint64_t *last_change;
+    uint16_t *toggles;
+    WireState *cycle_start_value;
+    int *touched;
+    int num_touched;
+
+    TimingCycle cycle;
+    uint64_t total_events;
+} TimingSim;
+
+/* Build the fanout index; the circuit should already be propagated */
+bool timing_init(TimingSim *t, Circuit *c, const TechModel *tech);
+void timing_free(TimingSim *t);
+
+/* Drive an undriven wire bit; takes effect at the current time, and is
+   dropped if the bit is already headed to that value */
+void timing_set_input(TimingSim *t, int wire_idx, int bit, WireState value);
+
+/* Clock every DFF, then run until nothing is pending */
+void timing_cycle(TimingSim *t, TimingCycle *result);
+
+/* Run until nothing is pending without clocking (after input changes only) */
+void timing_settle(TimingSim *t, TimingCycle *result);
+
+/* Ticks to nanoseconds for this technology */
+double timing_ticks_ns(const TimingSim *t, uint64_t ticks);
+
+/* True if no gate drives this wire (a primary input) */
+bool timing_is_undriven(const TimingSim *t, int wire_idx);
+
+#endif /* TIMING_H */